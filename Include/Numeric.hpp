@@ -10,16 +10,25 @@
 #include <complex>
 #include <algorithm>
 #include <stdexcept>
+#include <typeinfo>
+#include <span>
 
-#define DEBUG 0
-#define RUN 1
+#include "NumericKernels.hpp"
 
 // Forward declarations
 class Numeric;
-class IntNumeric;
+class NumericMemoryResource;
+class NumericMask;
+struct NumericSortKey;
 
 template <class T>
-concept FloatingPoint = std::is_floating_point_v<T>;
+concept IntegerValue = isIntegerKind(numericKindOf<T>);
+template <IntegerValue T>
+class IntegerNumeric;
+using IntNumeric = IntegerNumeric<int>;
+
+template <class T>
+concept FloatingPoint = std::is_floating_point_v<T> || isHalfValue<T>;
 template <FloatingPoint T>
 class FloatNumeric;
 
@@ -31,6 +40,11 @@ concept charTemp = std::is_same_v<T, char> || std::is_same_v<T, wchar_t> || std:
 template <charTemp T>
 class charNumeric;
 
+class BigIntNumeric;
+
+template <unsigned Scale, typename Rep = std::int64_t>
+class DecimalNumeric;
+
 
 /**
  * Template classes and their methods must be fully defined in the header file
@@ -41,397 +55,215 @@ class charNumeric;
 class Numeric
 {
     public:
-    Numeric();
+    explicit Numeric(NumericKind kind);
     template <typename T>
     static std::unique_ptr<Numeric> create(T value)
     {
-        if constexpr (std::is_integral_v<T>) {
+        if constexpr (std::is_same_v<T, bool> || charTemp<T>) {
             return std::make_unique<IntNumeric>(value);
-        } else if constexpr (std::is_floating_point_v<T>) {
+        } else if constexpr (std::is_integral_v<T>) {
+            using Stored = NumericIntegerType<T>;
+            return std::make_unique<IntegerNumeric<Stored>>(static_cast<Stored>(value));
+        } else if constexpr (FloatingPoint<T>) {
             return std::make_unique<FloatNumeric<T>>(value);
         } else if constexpr (std::is_same_v<T, std::complex<float>> || std::is_same_v<T, std::complex<double>>) {
             return std::make_unique<ComplexNumeric<typename T::value_type>>(value);
         } else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, wchar_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>) {
             return std::make_unique<charNumeric<T>>(value);
+        } else if constexpr (std::is_same_v<T, NumericBigInt>) {
+            return std::make_unique<BigIntNumeric>(std::move(value));
+        } else if constexpr (isDecimalValue<T>) {
+            return std::make_unique<DecimalNumeric<T::scale, typename T::rep_type>>(value);
         } else {
             throw std::runtime_error("Unsupported type");
         }
     }
 
+    // Type tag used to index the dispatch tables (see src/NumericDispatch.cpp)
+    NumericKind kind() const { return numericKind; }
+
+    /**
+     * Table-driven entry points behind the *Operation methods: one indirect call
+     * on (first.kind(), second.kind(), op), no dynamic_cast and no convertTo temporary.
+     * apply() takes an arithmetic op and compare() a comparison; any other op throws
+     * std::invalid_argument.
+     */
+    static std::unique_ptr<Numeric> apply(NumericOp op, const Numeric& first, const Numeric& second);
+    static bool compare(NumericOp op, const Numeric& first, const Numeric& second);
+    // In-place form of apply(): see addAssign
+    static std::unique_ptr<Numeric> applyAssign(NumericOp op, Numeric& first, const Numeric& second);
+
+    /**
+     * Batch form of apply(): out[i] = first[i] op second[i]. Consecutive elements with the
+     * same (lhs kind, rhs kind) form a run that is dispatched once and evaluated in a
+     * tight loop. A failing element (division by zero, unsupported pair) does not throw:
+     * out[i] is reset to nullptr and bit i of `errors` (resized to the batch size) is set.
+     * Returns the number of failed elements. Pointers must not be null.
+     * An out[i] that already holds an object of the result kind is overwritten in place,
+     * so reusing `out` across batches does not allocate.
+     */
+    static std::size_t applyBatch(NumericOp op, std::span<const Numeric* const> first, std::span<const Numeric* const> second,
+                                  std::span<std::unique_ptr<Numeric>> out, NumericMask& errors);
+    // Same for the comparisons: bit i of `result` is first[i] op second[i]
+    static std::size_t compareBatch(NumericOp op, std::span<const Numeric* const> first, std::span<const Numeric* const> second,
+                                    NumericMask& result, NumericMask& errors);
+
     // Convert the current Numeric object to a specific type
-    virtual std::unique_ptr<Numeric> convertTo(const std::type_info& targetType) const = 0;
-    virtual std::unique_ptr<Numeric> sumOperation(const Numeric& second ) = 0;
-    virtual std::unique_ptr<Numeric> subtractOperation( const Numeric& second ) = 0;
-    virtual std::unique_ptr<Numeric> multiplyOperation(const Numeric& second ) = 0;
-    virtual std::unique_ptr<Numeric> divideOperation(const Numeric& second ) = 0;
-    virtual bool lessThanOperation(const Numeric& second ) =0;
-    virtual bool greaterThanOperation(const Numeric& second ) =0;
-    virtual bool equalOperation(const Numeric& second ) =0;
+    virtual std::unique_ptr<Numeric> convertTo(const std::type_info& targetType) const;
+    std::unique_ptr<Numeric> convertTo(NumericKind targetKind) const;
+    virtual std::unique_ptr<Numeric> sumOperation(const Numeric& second );
+    virtual std::unique_ptr<Numeric> subtractOperation( const Numeric& second );
+    virtual std::unique_ptr<Numeric> multiplyOperation(const Numeric& second );
+    virtual std::unique_ptr<Numeric> divideOperation(const Numeric& second );
+
+    /**
+     * Compound assignment. When the promoted type is the receiver's own type the
+     * receiver is updated in place and nullptr is returned (no allocation); when the
+     * type has to widen (IntNumeric += ComplexNumeric<double>) the receiver is left
+     * untouched and the promoted result is returned instead:
+     *
+     *     if (auto widened = total->addAssign(*value)) total = std::move(widened);
+     *
+     * Errors are the same as for the matching *Operation method.
+     */
+    virtual std::unique_ptr<Numeric> addAssign(const Numeric& second );
+    virtual std::unique_ptr<Numeric> subAssign(const Numeric& second );
+    virtual std::unique_ptr<Numeric> mulAssign(const Numeric& second );
+    virtual std::unique_ptr<Numeric> divAssign(const Numeric& second );
+
+    virtual bool lessThanOperation(const Numeric& second );
+    virtual bool greaterThanOperation(const Numeric& second );
+    virtual bool equalOperation(const Numeric& second );
+
+    // Fixed-width key whose memcmp order is the total order described in NumericSort.hpp
+    NumericSortKey sortKey() const;
+    // Equal for values that are the same number across kinds (int 3, double 3.0, 3+0i); see NumericHash.hpp
+    std::uint64_t hash() const;
+
     virtual std::string toString() const = 0;
+
+    /**
+     * Writes the value into buffer[0, size) without allocating and returns the number of
+     * characters written, or 0 if they do not fit (numericFormatBufferSize always does).
+     * Floating-point parts use the shortest text that reads back to the same value, so
+     * unlike toString() nothing is lost. See NumericFormat.hpp.
+     */
+    std::size_t formatTo(char* buffer, std::size_t size) const;
+
     virtual ~Numeric();
 
+    /**
+     * Class-level allocation: blocks come from the NumericMemoryResource of the active
+     * NumericAllocationScope, or from the global heap when there is none, and go back
+     * to wherever they came from (see NumericMemory.hpp).
+     */
+    static void* operator new(std::size_t size);
+    static void operator delete(void* pointer, std::size_t size);
+    static void* operator new(std::size_t, void* place) noexcept { return place; }
+    static void operator delete(void*, void*) noexcept {}
+
+    private:
+    NumericKind numericKind;
+};
+
+
+/************************ Integer overflow policy ********************************/
+
+/**
+ * Sets the NumericOverflow policy of integer arithmetic on this thread until the scope
+ * ends (scopes nest). Without a scope an out-of-range result throws
+ * "<op>Operation: Integer overflow.". The policy applies to the *Operation / *Assign
+ * methods, apply(), applyBatch(), the column operations and numericEvaluate().
+ */
+class NumericOverflowScope
+{
+    public:
+    explicit NumericOverflowScope(NumericOverflow overflow);
+    ~NumericOverflowScope();
+    NumericOverflowScope(const NumericOverflowScope&) = delete;
+    NumericOverflowScope& operator=(const NumericOverflowScope&) = delete;
+
+    private:
+    NumericOverflow previous;
 };
 
+/**
+ * Sets how decimal multiply and divide round on this thread until the scope ends
+ * (scopes nest); without a scope they round half-even. Applies wherever the overflow
+ * policy does.
+ */
+class NumericRoundingScope
+{
+    public:
+    explicit NumericRoundingScope(NumericRounding rounding);
+    ~NumericRoundingScope();
+    NumericRoundingScope(const NumericRoundingScope&) = delete;
+    NumericRoundingScope& operator=(const NumericRoundingScope&) = delete;
+
+    private:
+    NumericRounding previous;
+};
 
-class IntNumeric : public Numeric
+
+/**
+ * Signed and unsigned integers of 8, 16, 32 and 64 bits. IntNumeric (int) is the one
+ * Numeric::create(int) and the characters produce; the other widths come from the
+ * matching fixed-width types (Numeric::create(std::uint64_t{...}) keeps all 64 bits).
+ */
+template <IntegerValue T>
+class IntegerNumeric : public Numeric
 {
     public:
-        int intValue;
-
-    IntNumeric(int value);
-    
-    std::unique_ptr<Numeric> convertTo(const std::type_info& targetType) const override;
-    std::unique_ptr<Numeric> sumOperation(const Numeric& second ) override;
-    std::unique_ptr<Numeric> subtractOperation(const Numeric& second) override;
-    std::unique_ptr<Numeric> multiplyOperation(const Numeric& second) override;    
-    std::unique_ptr<Numeric> divideOperation(const Numeric& second) override;
-    bool lessThanOperation(const Numeric& second ) override;
-    bool greaterThanOperation(const Numeric& second ) override;
-    bool equalOperation(const Numeric& second ) override;
-    std::string toString() const;
-    ~IntNumeric();
+        T intValue;
+
+    IntegerNumeric(T value) : Numeric(numericKindOf<T>), intValue(value) {}
+
+    std::string toString() const {
+        return std::to_string(intValue); // from std library
+    }
+    ~IntegerNumeric() {}
 };
 
 //secondly, derived class with template parameter for floating and double
 /*We could use concepts (modern c++23) here to limit this class to
 only using float and double with using: std::is_floating_point<T>::value*/
 
-
+// T is float, double, long double or a 16-bit storage format that computes in float (NumericHalf.hpp)
 template <FloatingPoint T>
 class FloatNumeric : public Numeric
 {
     public:
         T floatValue;
 
-    FloatNumeric(T float_val): floatValue(float_val)
-    {
-        #if DEBUG == 1
-        std::cout << "FloatNumeric class constructor is called with value: " << floatValue << std::endl;
-        #endif // DEBUG
-    }
+    FloatNumeric(T float_val): Numeric(numericKindOf<T>), floatValue(float_val) {}
 
-    std::unique_ptr<Numeric> convertTo(const std::type_info& targetType) const {
-        if (targetType == typeid(FloatNumeric<float>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<FloatNumeric<float>>(static_cast<float>(floatValue)));
-        } else if (targetType == typeid(FloatNumeric<double>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<FloatNumeric<double>>(static_cast<double>(floatValue)));
-        } else if (targetType == typeid(ComplexNumeric<float>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<float>>(std::complex<float>(floatValue, 0)));
-        } else if (targetType == typeid(ComplexNumeric<double>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<double>>(std::complex<double>(floatValue, 0)));
-        } else if (targetType == typeid(IntNumeric)) {
-            return std::unique_ptr<Numeric>(std::make_unique<IntNumeric>(static_cast<int>(floatValue)));
+    std::string toString() const {
+        if constexpr (isHalfValue<T>) {
+            return std::to_string(floatValue.toFloat());
         } else {
-            throw std::runtime_error("Unsupported conversion");
-        }
-    }
-    std::unique_ptr<Numeric> sumOperation(const Numeric& second) override {
-        try {
-            const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(second);
-            return std::make_unique<FloatNumeric<T>>(floatValue + secondFloat.floatValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, check if the second operand is a complex number
-            if (typeid(second) == typeid(ComplexNumeric<T>)) {
-                const ComplexNumeric<T>& secondComplex = dynamic_cast<const ComplexNumeric<T>&>(second);
-                return std::make_unique<ComplexNumeric<T>>(std::complex<T>(floatValue + secondComplex.complexNum.real(), secondComplex.complexNum.imag()));
-            } else {
-                // Convert the second operand to the current type and perform the operation
-                auto converted = second.convertTo(typeid(*this));
-                const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(*converted);
-                return std::make_unique<FloatNumeric<T>>(floatValue + secondFloat.floatValue);
-            }
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("sumOperation: Memory allocation failed.");
-        }
-    }
-    std::unique_ptr<Numeric> subtractOperation(const Numeric& second) {
-        try {
-            const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(second);
-            return std::make_unique<FloatNumeric<T>>(floatValue - secondFloat.floatValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, check if the second operand is a complex number
-            if (typeid(second) == typeid(ComplexNumeric<T>)) {
-                const ComplexNumeric<T>& secondComplex = dynamic_cast<const ComplexNumeric<T>&>(second);
-                return std::make_unique<ComplexNumeric<T>>(std::complex<T>(floatValue, 0) - secondComplex.complexNum);
-            } else {
-                // Convert the second operand to FloatNumeric<T> and perform the operation
-                auto converted = second.convertTo(typeid(*this));
-                const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(*converted);
-                return std::make_unique<FloatNumeric<T>>(floatValue - secondFloat.floatValue);
-            }
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("subtractOperation: Memory allocation failed.");
-        }
-    }
-
-    std::unique_ptr<Numeric> multiplyOperation(const Numeric& second) {
-        try {
-            const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(second);
-            return std::make_unique<FloatNumeric<T>>(floatValue * secondFloat.floatValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, check if the second operand is a complex number
-            if (typeid(second) == typeid(ComplexNumeric<T>)) {
-                const ComplexNumeric<T>& secondComplex = dynamic_cast<const ComplexNumeric<T>&>(second);
-                return std::make_unique<ComplexNumeric<T>>(std::complex<T>(floatValue, 0) * secondComplex.complexNum);
-            } else {
-                // Convert the second operand to FloatNumeric<T> and perform the operation
-                auto converted = second.convertTo(typeid(*this));
-                const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(*converted);
-                return std::make_unique<FloatNumeric<T>>(floatValue * secondFloat.floatValue);
-            }
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("multiplyOperation: Memory allocation failed.");
-        }
-    }
-
-    std::unique_ptr<Numeric> divideOperation(const Numeric& second) {
-        try {
-            const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(second);
-
-            if (secondFloat.floatValue == 0) {
-                throw std::runtime_error("divideOperation: Division by zero is not allowed.");
-            }
-
-            return std::make_unique<FloatNumeric<T>>(floatValue / secondFloat.floatValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, check if the second operand is a complex number
-            if (typeid(second) == typeid(ComplexNumeric<T>)) {
-                const ComplexNumeric<T>& secondComplex = dynamic_cast<const ComplexNumeric<T>&>(second);
-
-                if (std::abs(secondComplex.complexNum) == 0) {
-                    throw std::runtime_error("divideOperation: Division by zero is not allowed.");
-                }
-
-                return std::make_unique<ComplexNumeric<T>>(std::complex<T>(floatValue, 0) / secondComplex.complexNum);
-            } else {
-                // Convert the second operand to FloatNumeric<T> and perform the operation
-                auto converted = second.convertTo(typeid(*this));
-                const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(*converted);
-
-                if (secondFloat.floatValue == 0) {
-                    throw std::runtime_error("divideOperation: Division by zero is not allowed.");
-                }
-
-                return std::make_unique<FloatNumeric<T>>(floatValue / secondFloat.floatValue);
-            }
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("divideOperation: Memory allocation failed.");
-        }
-    }
-        
-    bool lessThanOperation(const Numeric& second) {
-        try {
-            const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(second);
-            return (floatValue < secondFloat.floatValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to FloatNumeric<T>
-            auto converted = second.convertTo(typeid(FloatNumeric<T>));
-            const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(*converted);
-            return (floatValue < secondFloat.floatValue);
-        }
-    }
-    
-    bool greaterThanOperation(const Numeric& second) {
-        try {
-            const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(second);
-            return (floatValue > secondFloat.floatValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to FloatNumeric<T>
-            auto converted = second.convertTo(typeid(FloatNumeric<T>));
-            const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(*converted);
-            return (floatValue > secondFloat.floatValue);
-        }
-    }
-    
-    bool equalOperation(const Numeric& second) {
-        try {
-            const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(second);
-            return (floatValue == secondFloat.floatValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to FloatNumeric<T>
-            auto converted = second.convertTo(typeid(FloatNumeric<T>));
-            const FloatNumeric<T>& secondFloat = dynamic_cast<const FloatNumeric<T>&>(*converted);
-            return (floatValue == secondFloat.floatValue);
+            return std::to_string(floatValue); // from std library
         }
     }
-    
-    std::string toString() const {
-        return std::to_string(floatValue); // from std library
-    }
-    ~FloatNumeric()
-    {
-        #if DEBUG == 1
-        std::cout << "FloatNumeric Class destructor with value: " << floatValue << std::endl;
-        #endif // DEBUG
-    }
-    
+    ~FloatNumeric() {}
 };
 
 template <typename T>
 class ComplexNumeric : public Numeric
 {
 
+    static_assert(numericKindOf<std::complex<T>> != NumericKind::Count, "ComplexNumeric<T> needs a floating-point T");
+
     public:
     std::complex<T> complexNum;
 
     ComplexNumeric(std::complex<T> num)
-    : complexNum(num) 
-    {
-        #if DEBUG == 1
-        std::cout<<"ComplexNumeric Constructor is calledwith value: " << complexNum << std::endl;
-        #endif // DEBUG
-    }
+    : Numeric(numericKindOf<std::complex<T>>), complexNum(num) {}
 
-    std::unique_ptr<Numeric> convertTo(const std::type_info& targetType) const {
-        if (targetType == typeid(FloatNumeric<float>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<FloatNumeric<float>>(static_cast<float>(complexNum.real())));
-        } else if (targetType == typeid(FloatNumeric<double>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<FloatNumeric<double>>(static_cast<double>(complexNum.real())));
-        } else if (targetType == typeid(ComplexNumeric<float>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<float>>(std::complex<float>(complexNum.real(), complexNum.imag())));
-        } else if (targetType == typeid(ComplexNumeric<double>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<double>>(std::complex<double>(complexNum.real(), complexNum.imag())));
-        } else if (targetType == typeid(IntNumeric)) {
-            return std::unique_ptr<Numeric>(std::make_unique<IntNumeric>(static_cast<int>(complexNum.real())));
-        } else {
-            throw std::runtime_error("Unsupported conversion");
-        }
-    }
-
-    std::unique_ptr<Numeric> sumOperation(const Numeric& second) {
-        try {
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(second);
-            std::complex<T> result = complexNum + complexValue.complexNum;
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<T>>(result));
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to ComplexNumeric<T>
-            auto converted = second.convertTo(typeid(ComplexNumeric<T>));
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(*converted);
-            std::complex<T> result = complexNum + complexValue.complexNum;
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<T>>(result));
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("sumOperation: Memory allocation failed.");
-        }
-    }
-    
-    std::unique_ptr<Numeric> subtractOperation(const Numeric& second) {
-        try {
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(second);
-            std::complex<T> result = complexNum - complexValue.complexNum;
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<T>>(result));
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to ComplexNumeric<T>
-            auto converted = second.convertTo(typeid(*this));
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(*converted);
-            std::complex<T> result = complexNum - complexValue.complexNum;
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<T>>(result));
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("subtractOperation: Memory allocation failed.");
-        }
-    }
-
-    std::unique_ptr<Numeric> multiplyOperation(const Numeric& second) {
-        try {
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(second);
-            std::complex<T> result = complexNum * complexValue.complexNum;
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<T>>(result));
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to ComplexNumeric<T>
-            auto converted = second.convertTo(typeid(*this));
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(*converted);
-            std::complex<T> result = complexNum * complexValue.complexNum;
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<T>>(result));
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("multiplyOperation: Memory allocation failed.");
-        }
-    }
-
-    std::unique_ptr<Numeric> divideOperation(const Numeric& second) {
-        try {
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(second);
-
-            if (std::abs(complexValue.complexNum) == 0) {
-                throw std::runtime_error("divideOperation: Division by zero is not allowed.");
-            }
-
-            std::complex<T> result = complexNum / complexValue.complexNum;
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<T>>(result));
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to ComplexNumeric<T>
-            auto converted = second.convertTo(typeid(*this));
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(*converted);
-
-            if (std::abs(complexValue.complexNum) == 0) {
-                throw std::runtime_error("divideOperation: Division by zero is not allowed.");
-            }
-
-            std::complex<T> result = complexNum / complexValue.complexNum;
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<T>>(result));
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("divideOperation: Memory allocation failed.");
-        }
-    }
-    
-    bool lessThanOperation(const Numeric& second) {
-        try {
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(second);
-            if (complexNum.real() == complexValue.complexNum.real()) {
-                return complexNum.imag() < complexValue.complexNum.imag();
-            }
-            return complexNum.real() < complexValue.complexNum.real();
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to ComplexNumeric<T>
-            auto converted = second.convertTo(typeid(ComplexNumeric<T>));
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(*converted);
-            if (complexNum.real() == complexValue.complexNum.real()) {
-                return complexNum.imag() < complexValue.complexNum.imag();
-            }
-            return complexNum.real() < complexValue.complexNum.real();
-        }
-    }
-    
-    bool greaterThanOperation(const Numeric& second) {
-        try {
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(second);
-            if (complexNum.real() == complexValue.complexNum.real()) {
-                return complexNum.imag() > complexValue.complexNum.imag();
-            }
-            return complexNum.real() > complexValue.complexNum.real();
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to ComplexNumeric<T>
-            auto converted = second.convertTo(typeid(ComplexNumeric<T>));
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(*converted);
-            if (complexNum.real() == complexValue.complexNum.real()) {
-                return complexNum.imag() > complexValue.complexNum.imag();
-            }
-            return complexNum.real() > complexValue.complexNum.real();
-        }
-    }
-    
-    bool equalOperation(const Numeric& second) {
-        try {
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(second);
-            return (complexNum == complexValue.complexNum);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to ComplexNumeric<T>
-            auto converted = second.convertTo(typeid(ComplexNumeric<T>));
-            const ComplexNumeric<T>& complexValue = dynamic_cast<const ComplexNumeric<T>&>(*converted);
-            return (complexNum == complexValue.complexNum);
-        }
-    }
-    
     std::string toString() const {
         return "(" + std::to_string(complexNum.real()) + " + " + 
             std::to_string(complexNum.imag()) + "i)";
     }
-    ~ComplexNumeric()
-    {
-        #if DEBUG == 1
-        std::cout << "ComplexNumeric Class destructor with Real value: " << complexNum.real()
-        << " And for Img value: "<< complexNum.imag() <<std::endl;
-        #endif // DEBUG
-    
-    }
+    ~ComplexNumeric() {}
 };
 
 template <charTemp T>
@@ -439,104 +271,157 @@ class charNumeric : public Numeric {
 public:
     T charValue;
 
-    charNumeric(T char_val) : charValue(char_val) {
-        #if DEBUG == 1
-        std::cout << "CharNumeric class constructor is called with value: " << charValue << std::endl;
-        #endif // DEBUG
-    }
+    charNumeric(T char_val) : Numeric(numericKindOf<T>), charValue(char_val) {}
 
-    std::unique_ptr<Numeric> convertTo(const std::type_info& targetType) const {
-        if (targetType == typeid(FloatNumeric<float>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<FloatNumeric<float>>(static_cast<float>(static_cast<int>(charValue))));
-        } else if (targetType == typeid(FloatNumeric<double>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<FloatNumeric<double>>(static_cast<double>(static_cast<int>(charValue))));
-        } else if (targetType == typeid(IntNumeric)) {
-            return std::unique_ptr<Numeric>(std::make_unique<IntNumeric>(static_cast<int>(charValue)));
-        } else {
-            throw std::runtime_error("Unsupported conversion");
-        }
+    std::string toString() const {
+        return std::string(1, charValue);
     }
 
-    std::unique_ptr<Numeric> sumOperation(const Numeric& second) {
-        try {
-            const charNumeric<T>& secondChar = dynamic_cast<const charNumeric<T>&>(second);
-            return std::unique_ptr<Numeric>(std::make_unique<charNumeric<T>>(toascii(charValue + secondChar.charValue)));
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to charNumeric<T>
-            auto converted = second.convertTo(typeid(charNumeric<T>));
-            const charNumeric<T>& secondChar = dynamic_cast<const charNumeric<T>&>(*converted);
-            return std::unique_ptr<Numeric>(std::make_unique<charNumeric<T>>(toascii(charValue + secondChar.charValue)));
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("sumOperation: Memory allocation failed.");
-        }
-    }
-    std::unique_ptr<Numeric> subtractOperation(const Numeric& second) {
-        try {
-            const charNumeric<T>& secondChar = dynamic_cast<const charNumeric<T>&>(second);
-            return std::unique_ptr<Numeric>(std::make_unique<charNumeric<T>>(toascii(charValue - secondChar.charValue)));
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to charNumeric<T>
-            auto converted = second.convertTo(typeid(charNumeric<T>));
-            const charNumeric<T>& secondChar = dynamic_cast<const charNumeric<T>&>(*converted);
-            return std::unique_ptr<Numeric>(std::make_unique<charNumeric<T>>(toascii(charValue - secondChar.charValue)));
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("subtractOperation: Memory allocation failed.");
-        }
-    }
-    
-    std::unique_ptr<Numeric> multiplyOperation(const Numeric& second) {
-        throw std::runtime_error("multiplyOperation: Operation not supported for characters.");
-    }
-    
-    std::unique_ptr<Numeric> divideOperation(const Numeric& second) {
-        throw std::runtime_error("divideOperation: Operation not supported for characters.");
-    }
+    ~charNumeric() {}
+};
 
-    bool lessThanOperation(const Numeric& second) {
-        try {
-            const charNumeric<T>& secondChar = dynamic_cast<const charNumeric<T>&>(second);
-            return (charValue < secondChar.charValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to charNumeric<T>
-            auto converted = second.convertTo(typeid(charNumeric<T>));
-            const charNumeric<T>& secondChar = dynamic_cast<const charNumeric<T>&>(*converted);
-            return (charValue < secondChar.charValue);
-        }
-    }
 
-    bool greaterThanOperation(const Numeric& second) {
-        try {
-            const charNumeric<T>& secondChar = dynamic_cast<const charNumeric<T>&>(second);
-            return (charValue > secondChar.charValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to charNumeric<T>
-            auto converted = second.convertTo(typeid(charNumeric<T>));
-            const charNumeric<T>& secondChar = dynamic_cast<const charNumeric<T>&>(*converted);
-            return (charValue > secondChar.charValue);
-        }
-    }
+/**
+ * Exact integer of any size (see NumericBigInt.hpp). Mixed with one of the fixed-width
+ * integer kinds, on either side, the result is a BigIntNumeric; mixed with float,
+ * double or their complex types it follows the IntegerNumeric rules.
+ */
+class BigIntNumeric : public Numeric
+{
+    public:
+        NumericBigInt bigValue;
 
-    bool equalOperation(const Numeric& second) {
-        try {
-            const charNumeric<T>& secondChar = dynamic_cast<const charNumeric<T>&>(second);
-            return (charValue == secondChar.charValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the second operand to charNumeric<T>
-            auto converted = second.convertTo(typeid(charNumeric<T>));
-            const charNumeric<T>& secondChar = dynamic_cast<const charNumeric<T>&>(*converted);
-            return (charValue == secondChar.charValue);
-        }
-    }
+    BigIntNumeric(NumericBigInt value) : Numeric(NumericKind::BigInt), bigValue(std::move(value)) {}
 
     std::string toString() const {
-        return std::string(1, charValue);
+        return bigValue.toString();
     }
+    ~BigIntNumeric() {}
+};
+
 
-    ~charNumeric() {
-        #if DEBUG == 1
-        std::cout << "CharNumeric Class destructor with value: " << charValue << std::endl;
-        #endif // DEBUG
+/**
+ * Exact fixed-point decimal with Scale fraction digits (see NumericDecimal.hpp). The
+ * registered kinds are DecimalNumeric<2> and DecimalNumeric<6>, stored in 64 bits, and
+ * DecimalNumeric<18, NumericInt128>. Two decimals give the one with more fraction
+ * digits and an integer on either side gives the decimal; + and - are exact, * and /
+ * round under the thread's NumericRoundingScope, and results out of range follow the
+ * NumericOverflowScope like an integer. Mixed with float, double or their complex
+ * types a decimal follows the IntegerNumeric rules; BigIntNumeric is rejected.
+ */
+template <unsigned Scale, typename Rep>
+class DecimalNumeric : public Numeric
+{
+    static_assert(numericKindOf<NumericDecimal<Scale, Rep>> != NumericKind::Count, "DecimalNumeric<Scale, Rep> needs a registered decimal kind");
+
+    public:
+        NumericDecimal<Scale, Rep> decimalValue;
+
+    DecimalNumeric(NumericDecimal<Scale, Rep> value) : Numeric(numericKindOf<NumericDecimal<Scale, Rep>>), decimalValue(value) {}
+
+    std::string toString() const {
+        return decimalValue.toString();
     }
+    ~DecimalNumeric() {}
 };
 
+
+/************************ Kind <-> class mapping ********************************/
+
+template <NumericKind K> struct NumericClassOf;
+template <> struct NumericClassOf<NumericKind::Int>               { using type = IntNumeric; };
+template <> struct NumericClassOf<NumericKind::Float>             { using type = FloatNumeric<float>; };
+template <> struct NumericClassOf<NumericKind::Double>            { using type = FloatNumeric<double>; };
+template <> struct NumericClassOf<NumericKind::LongDouble>        { using type = FloatNumeric<long double>; };
+template <> struct NumericClassOf<NumericKind::ComplexFloat>      { using type = ComplexNumeric<float>; };
+template <> struct NumericClassOf<NumericKind::ComplexDouble>     { using type = ComplexNumeric<double>; };
+template <> struct NumericClassOf<NumericKind::ComplexLongDouble> { using type = ComplexNumeric<long double>; };
+template <> struct NumericClassOf<NumericKind::Char>              { using type = charNumeric<char>; };
+template <> struct NumericClassOf<NumericKind::WChar>             { using type = charNumeric<wchar_t>; };
+template <> struct NumericClassOf<NumericKind::Char16>            { using type = charNumeric<char16_t>; };
+template <> struct NumericClassOf<NumericKind::Char32>            { using type = charNumeric<char32_t>; };
+template <> struct NumericClassOf<NumericKind::Int8>              { using type = IntegerNumeric<std::int8_t>; };
+template <> struct NumericClassOf<NumericKind::Int16>             { using type = IntegerNumeric<std::int16_t>; };
+template <> struct NumericClassOf<NumericKind::Int64>             { using type = IntegerNumeric<std::int64_t>; };
+template <> struct NumericClassOf<NumericKind::UInt8>             { using type = IntegerNumeric<std::uint8_t>; };
+template <> struct NumericClassOf<NumericKind::UInt16>            { using type = IntegerNumeric<std::uint16_t>; };
+template <> struct NumericClassOf<NumericKind::UInt32>            { using type = IntegerNumeric<std::uint32_t>; };
+template <> struct NumericClassOf<NumericKind::UInt64>            { using type = IntegerNumeric<std::uint64_t>; };
+template <> struct NumericClassOf<NumericKind::BigInt>            { using type = BigIntNumeric; };
+template <> struct NumericClassOf<NumericKind::Decimal2>          { using type = DecimalNumeric<2>; };
+template <> struct NumericClassOf<NumericKind::Decimal6>          { using type = DecimalNumeric<6>; };
+template <> struct NumericClassOf<NumericKind::Decimal18>         { using type = DecimalNumeric<18, NumericInt128>; };
+template <> struct NumericClassOf<NumericKind::Float16>           { using type = FloatNumeric<NumericFloat16>; };
+template <> struct NumericClassOf<NumericKind::BFloat16>          { using type = FloatNumeric<NumericBFloat16>; };
+
+template <NumericKind K>
+using NumericClass = typename NumericClassOf<K>::type;
+
+// Stored value of an object already known (from its tag) to be of kind K
+template <NumericKind K>
+const NumericKindValue<K>& numericValueOf(const Numeric& numeric)
+{
+    const NumericClass<K>& object = static_cast<const NumericClass<K>&>(numeric);
+    if constexpr (K == NumericKind::BigInt) {
+        return object.bigValue;
+    } else if constexpr (isDecimalKind(K)) {
+        return object.decimalValue;
+    } else if constexpr (isIntegerKind(K)) {
+        return object.intValue;
+    } else if constexpr (isFloatKind(K)) {
+        return object.floatValue;
+    } else if constexpr (isComplexKind(K)) {
+        return object.complexNum;
+    } else {
+        return object.charValue;
+    }
+}
+
+template <NumericKind K>
+NumericKindValue<K>& numericValueOf(Numeric& numeric)
+{
+    return const_cast<NumericKindValue<K>&>(numericValueOf<K>(static_cast<const Numeric&>(numeric)));
+}
+
+// body.template operator()<K>() for the runtime `kind`; any other kind throws "name: Unsupported type."
+template <typename Body>
+decltype(auto) numericVisitKind(NumericKind kind, const Body& body, const char* name)
+{
+    switch (kind) {
+        case NumericKind::Int:               return body.template operator()<NumericKind::Int>();
+        case NumericKind::Float:             return body.template operator()<NumericKind::Float>();
+        case NumericKind::Double:            return body.template operator()<NumericKind::Double>();
+        case NumericKind::LongDouble:        return body.template operator()<NumericKind::LongDouble>();
+        case NumericKind::ComplexFloat:      return body.template operator()<NumericKind::ComplexFloat>();
+        case NumericKind::ComplexDouble:     return body.template operator()<NumericKind::ComplexDouble>();
+        case NumericKind::ComplexLongDouble: return body.template operator()<NumericKind::ComplexLongDouble>();
+        case NumericKind::Char:              return body.template operator()<NumericKind::Char>();
+        case NumericKind::WChar:             return body.template operator()<NumericKind::WChar>();
+        case NumericKind::Char16:            return body.template operator()<NumericKind::Char16>();
+        case NumericKind::Char32:            return body.template operator()<NumericKind::Char32>();
+        case NumericKind::Int8:              return body.template operator()<NumericKind::Int8>();
+        case NumericKind::Int16:             return body.template operator()<NumericKind::Int16>();
+        case NumericKind::Int64:             return body.template operator()<NumericKind::Int64>();
+        case NumericKind::UInt8:             return body.template operator()<NumericKind::UInt8>();
+        case NumericKind::UInt16:            return body.template operator()<NumericKind::UInt16>();
+        case NumericKind::UInt32:            return body.template operator()<NumericKind::UInt32>();
+        case NumericKind::UInt64:            return body.template operator()<NumericKind::UInt64>();
+        case NumericKind::BigInt:            return body.template operator()<NumericKind::BigInt>();
+        case NumericKind::Decimal2:          return body.template operator()<NumericKind::Decimal2>();
+        case NumericKind::Decimal6:          return body.template operator()<NumericKind::Decimal6>();
+        case NumericKind::Decimal18:         return body.template operator()<NumericKind::Decimal18>();
+        case NumericKind::Float16:           return body.template operator()<NumericKind::Float16>();
+        case NumericKind::BFloat16:          return body.template operator()<NumericKind::BFloat16>();
+        default:
+            throw std::runtime_error(std::string(name) + ": Unsupported type.");
+    }
+}
+
+// body(value) with the value `numeric` stores, as its own type
+template <typename Body>
+decltype(auto) numericVisit(const Numeric& numeric, const Body& body, const char* name)
+{
+    return numericVisitKind(numeric.kind(), [&]<NumericKind K>() -> decltype(auto) { return body(numericValueOf<K>(numeric)); }, name);
+}
+
 #endif // __NUMERIC_HPP__
\ No newline at end of file
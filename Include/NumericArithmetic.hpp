@@ -0,0 +1,135 @@
+#ifndef __NUMERIC_ARITHMETIC_HPP__
+#define __NUMERIC_ARITHMETIC_HPP__
+
+#include <complex>
+#include <stdexcept>
+#include <type_traits>
+
+#include "NumericKernels.hpp"
+
+/**
+ * Statically typed arithmetic on the Numeric value types.
+ *
+ * When both operand types are known at compile time there is no need for a Numeric
+ * object, a vtable or a dispatch table: numericAdd(a, b) & co call the same
+ * ArithmeticKernel / ComparisonKernel that the *Operation methods, the dispatch tables
+ * and the expression templates use, so results and errors are identical and the call
+ * inlines down to the arithmetic itself. Everything is constexpr:
+ *
+ *     constexpr auto x = numericAdd(2, 0.5f);                          // float 2.5f
+ *     static_assert(std::is_same_v<NumericPromote<float, std::complex<float>>, std::complex<float>>);
+ *
+ * The rules are those of the left operand's class, so promotion is not symmetric:
+ * numericAdd(1.5, 2.0f) is a double but numericAdd(2.0f, 1.5) is a float, exactly like
+ * FloatNumeric<double>::sumOperation and FloatNumeric<float>::sumOperation. Pairs the
+ * classes reject (int + long double, char * char, char + char16_t, ...) do not compile.
+ * Division by zero throws "divideOperation: Division by zero is not allowed." and an
+ * integer result out of range throws "<op>Operation: Integer overflow." (at run time
+ * the thread's NumericOverflowScope can saturate or wrap instead; constant evaluation
+ * is always checked, so an overflowing constexpr call does not compile).
+ */
+
+template <typename A, typename B>
+concept NumericValuePair = numericKindOf<A> != NumericKind::Count && numericKindOf<B> != NumericKind::Count;
+
+// Op is defined for (A, B): the pair is promotable and, for characters, Op is + or -
+template <NumericOp Op, typename A, typename B>
+concept NumericSupports = NumericValuePair<A, B> &&
+                          arithmeticRule(numericKindOf<A>, numericKindOf<B>, Op).error == NumericError::None;
+
+template <NumericOp Op, typename A, typename B>
+concept NumericComparable = NumericValuePair<A, B> && comparisonError(numericKindOf<A>, numericKindOf<B>) == NumericError::None;
+
+// Type of A + B (also of A - B, A * B, A / B where those are defined)
+template <typename A, typename B>
+    requires NumericSupports<NumericOp::Sum, A, B>
+using NumericPromote = typename ArithmeticKernel<NumericOp::Sum, numericKindOf<A>, numericKindOf<B>>::result_type;
+
+/************************ Arithmetic ********************************/
+
+template <NumericOp Op, typename A, typename B>
+    requires NumericSupports<Op, A, B>
+constexpr auto numericApply(const A& first, const B& second)
+{
+    using Kernel = ArithmeticKernel<Op, numericKindOf<A>, numericKindOf<B>>;
+    typename Kernel::result_type result{};
+    NumericOverflow overflow = NumericOverflow::Checked;
+    if (hasOverflowPolicy(Kernel::resultKind) && !std::is_constant_evaluated()) {
+        overflow = numericOverflowMode();
+    }
+    const NumericError error = Kernel::apply(first, second, result, overflow);
+    if (error != NumericError::None) {
+        throw std::runtime_error(numericErrorMessage(Op, error));
+    }
+    return result;
+}
+
+template <typename A, typename B>
+    requires NumericSupports<NumericOp::Sum, A, B>
+constexpr auto numericAdd(const A& first, const B& second) { return numericApply<NumericOp::Sum>(first, second); }
+
+template <typename A, typename B>
+    requires NumericSupports<NumericOp::Subtract, A, B>
+constexpr auto numericSubtract(const A& first, const B& second) { return numericApply<NumericOp::Subtract>(first, second); }
+
+template <typename A, typename B>
+    requires NumericSupports<NumericOp::Multiply, A, B>
+constexpr auto numericMultiply(const A& first, const B& second) { return numericApply<NumericOp::Multiply>(first, second); }
+
+template <typename A, typename B>
+    requires NumericSupports<NumericOp::Divide, A, B>
+constexpr auto numericDivide(const A& first, const B& second) { return numericApply<NumericOp::Divide>(first, second); }
+
+/************************ Comparison ********************************/
+
+// Like lessThanOperation & co, the right operand is converted to the left operand's type
+template <NumericOp Op, typename A, typename B>
+    requires NumericComparable<Op, A, B>
+constexpr bool numericCompare(const A& first, const B& second)
+{
+    bool result = false;
+    ComparisonKernel<Op, numericKindOf<A>, numericKindOf<B>>::apply(first, second, result);
+    return result;
+}
+
+template <typename A, typename B>
+    requires NumericComparable<NumericOp::LessThan, A, B>
+constexpr bool numericLessThan(const A& first, const B& second) { return numericCompare<NumericOp::LessThan>(first, second); }
+
+template <typename A, typename B>
+    requires NumericComparable<NumericOp::GreaterThan, A, B>
+constexpr bool numericGreaterThan(const A& first, const B& second) { return numericCompare<NumericOp::GreaterThan>(first, second); }
+
+template <typename A, typename B>
+    requires NumericComparable<NumericOp::Equal, A, B>
+constexpr bool numericEqual(const A& first, const B& second) { return numericCompare<NumericOp::Equal>(first, second); }
+
+/************************ Compile-time checks ********************************/
+
+static_assert(std::is_same_v<NumericPromote<int, int>, int>);
+static_assert(std::is_same_v<NumericPromote<int, float>, float>);
+static_assert(std::is_same_v<NumericPromote<float, std::complex<float>>, std::complex<float>>);
+static_assert(std::is_same_v<NumericPromote<std::int16_t, std::int64_t>, std::int64_t>);
+static_assert(std::is_same_v<NumericPromote<int, std::uint32_t>, std::uint32_t>);
+static_assert(std::is_same_v<NumericPromote<std::uint8_t, std::int8_t>, std::uint8_t>);
+static_assert(std::is_same_v<NumericPromote<char, char>, char>);
+static_assert(!NumericSupports<NumericOp::Multiply, char, char>);
+static_assert(!NumericSupports<NumericOp::Sum, int, long double>);
+static_assert(std::is_same_v<NumericPromote<std::uint64_t, NumericBigInt>, NumericBigInt>);
+static_assert(std::is_same_v<NumericPromote<NumericDecimal2, NumericDecimal6>, NumericDecimal6>);
+static_assert(std::is_same_v<NumericPromote<int, NumericDecimal2>, NumericDecimal2>);
+static_assert(std::is_same_v<NumericPromote<NumericDecimal2, double>, double>);
+static_assert(std::is_same_v<NumericPromote<int, NumericFloat16>, NumericFloat16>);
+static_assert(std::is_same_v<NumericPromote<NumericBFloat16, double>, NumericBFloat16>);
+static_assert(numericAdd(2, 0.5f) == 2.5f);
+static_assert(numericDivide(7, 2) == 3);
+static_assert(numericAdd(std::int64_t(1) << 40, 1) == (std::int64_t(1) << 40) + 1);
+static_assert(numericMultiply(std::complex<double>(0, 1), std::complex<double>(0, 1)) == std::complex<double>(-1, 0));
+static_assert(numericAdd('a', 'b') == static_cast<char>(('a' + 'b') & 0x7F));
+static_assert(numericLessThan(std::complex<float>(1, 2), 1.5f) == true);
+static_assert(numericMultiply(NumericDecimal2::fromUnits(125), NumericDecimal2::fromUnits(50)).units == 62);
+static_assert(numericEqual(NumericDecimal2::fromUnits(300), 3));
+static_assert(numericAdd(NumericFloat16(1), NumericFloat16(0.5)).bits == NumericFloat16(1.5).bits);
+static_assert(numericEqual(NumericBFloat16(2049), 2048));
+
+#endif // __NUMERIC_ARITHMETIC_HPP__
@@ -0,0 +1,152 @@
+#ifndef __NUMERIC_BIGINT_HPP__
+#define __NUMERIC_BIGINT_HPP__
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * Arbitrary-precision signed integer, the value BigIntNumeric stores.
+ *
+ * Sign and magnitude, the magnitude in 64-bit limbs (least significant first, no
+ * leading zero limb; zero has no limbs and is never negative). Values up to 128 bits
+ * live inside the object, larger ones on the heap.
+ *
+ * Multiplication is schoolbook below NumericBigIntThresholds::karatsuba limbs, then
+ * Karatsuba, then Toom-3 above ::toom3; operands of very different lengths are cut
+ * into blocks of the shorter one. Division is Knuth's algorithm D, and Burnikel-Ziegler
+ * recursive division once the divisor and the quotient both exceed ::division limbs.
+ * Conversion to and from decimal text splits the number around a power of 10^19 and
+ * recurses above ::decimal limbs, so it costs a few multiplications or divisions.
+ *
+ * Division truncates toward zero and the remainder takes the dividend's sign, as with
+ * the built-in integers. Dividing by zero throws
+ * "divideOperation: Division by zero is not allowed."; parsing invalid text throws too.
+ */
+class NumericBigInt
+{
+    public:
+    using Limb = std::uint64_t;
+
+    NumericBigInt() noexcept {}
+    template <std::integral T>
+    NumericBigInt(T value)
+    {
+        if constexpr (std::is_signed_v<T>) {
+            negative = value < 0;
+            setSmall(negative ? Limb(0) - static_cast<Limb>(value) : static_cast<Limb>(value));
+        } else {
+            setSmall(static_cast<Limb>(value));
+        }
+    }
+    // Truncates toward zero; NaN and the infinities give 0
+    template <std::floating_point T>
+    explicit NumericBigInt(T value) { assignFloating(static_cast<long double>(value)); }
+
+    NumericBigInt(const NumericBigInt& other);
+    NumericBigInt(NumericBigInt&& other) noexcept;
+    NumericBigInt& operator=(const NumericBigInt& other);
+    NumericBigInt& operator=(NumericBigInt&& other) noexcept;
+    ~NumericBigInt();
+
+    // Optional sign followed by decimal digits
+    static NumericBigInt fromString(std::string_view text);
+    std::string toString() const;
+    // Writes toString() into [first, last); nullptr when it does not fit (decimalBound() always does)
+    char* toChars(char* first, char* last) const;
+    // Upper bound on the length of toString()
+    std::size_t decimalBound() const { return static_cast<std::size_t>(count) * 20 + 2; }
+
+    bool isZero() const { return count == 0; }
+    bool isNegative() const { return negative; }
+    // Bits of the magnitude (0 for zero)
+    std::size_t bitLength() const;
+    // The top 64 bits of the magnitude, its top bit set, with a sticky low bit when anything
+    // below them is set: the magnitude is about this * 2^(bitLength() - 64). Not for zero
+    std::uint64_t topBits() const;
+    std::span<const Limb> limbs() const { return {data(), count}; }
+
+    // Integers keep the low bits of the two's complement value (like a narrowing cast);
+    // floating-point types get the nearest value, or +-inf when out of range
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    explicit operator T() const
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return !isZero();
+        } else if constexpr (std::is_integral_v<T>) {
+            const Limb low = count ? data()[0] : 0;
+            return static_cast<T>(negative ? Limb(0) - low : low);
+        } else {
+            return static_cast<T>(toLongDouble());
+        }
+    }
+
+    NumericBigInt operator-() const;
+    NumericBigInt& operator+=(const NumericBigInt& other);
+    NumericBigInt& operator-=(const NumericBigInt& other);
+    NumericBigInt& operator*=(const NumericBigInt& other);
+    NumericBigInt& operator/=(const NumericBigInt& other);
+    NumericBigInt& operator%=(const NumericBigInt& other);
+
+    friend NumericBigInt operator+(const NumericBigInt& first, const NumericBigInt& second);
+    friend NumericBigInt operator-(const NumericBigInt& first, const NumericBigInt& second);
+    friend NumericBigInt operator*(const NumericBigInt& first, const NumericBigInt& second);
+    friend NumericBigInt operator/(const NumericBigInt& first, const NumericBigInt& second);
+    friend NumericBigInt operator%(const NumericBigInt& first, const NumericBigInt& second);
+    // quotient = first / second, remainder = first % second, in one division
+    static void divide(const NumericBigInt& first, const NumericBigInt& second, NumericBigInt& quotient, NumericBigInt& remainder);
+
+    friend bool operator==(const NumericBigInt& first, const NumericBigInt& second);
+    friend std::strong_ordering operator<=>(const NumericBigInt& first, const NumericBigInt& second);
+
+    private:
+    friend struct NumericBigIntAccess;
+
+    static constexpr std::uint32_t inlineLimbs = 2;
+
+    std::uint32_t count = 0;                // limbs in use
+    std::uint32_t capacity = inlineLimbs;   // inline storage while <= inlineLimbs
+    bool negative = false;
+    union
+    {
+        Limb inlineData[inlineLimbs];
+        Limb* heapData;
+    };
+
+    Limb* data() { return capacity > inlineLimbs ? heapData : inlineData; }
+    const Limb* data() const { return capacity > inlineLimbs ? heapData : inlineData; }
+
+    void setSmall(Limb magnitude)
+    {
+        inlineData[0] = magnitude;
+        count = magnitude != 0;
+        negative = negative && count;
+    }
+    void assignFloating(long double value);
+    long double toLongDouble() const;
+};
+
+/**
+ * Limb counts at which multiplication, division and decimal conversion switch to the
+ * faster algorithms. setNumericBigIntThresholds with every field at SIZE_MAX keeps the
+ * quadratic algorithms everywhere, which the benchmarks use as the baseline. Not
+ * synchronized: set them before other threads use NumericBigInt.
+ */
+struct NumericBigIntThresholds
+{
+    std::size_t karatsuba = 40;
+    std::size_t toom3 = 160;
+    std::size_t division = 80;
+    std::size_t decimal = 60;
+};
+
+NumericBigIntThresholds numericBigIntThresholds();
+void setNumericBigIntThresholds(const NumericBigIntThresholds& thresholds);
+
+#endif // __NUMERIC_BIGINT_HPP__
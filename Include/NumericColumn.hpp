@@ -0,0 +1,225 @@
+#ifndef __NUMERIC_COLUMN_HPP__
+#define __NUMERIC_COLUMN_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "Numeric.hpp"
+
+/**
+ * Typed, contiguous storage for a homogeneous run of values.
+ *
+ * std::vector<std::unique_ptr<Numeric>> costs one allocation and one pointer chase per
+ * element; NumericColumn<T> keeps the raw values in a single 64-byte aligned buffer
+ * so the element-wise operations below can run as SIMD loops. T is any value type a
+ * Numeric class stores (int, the fixed-width integers, float, double, long double,
+ * std::complex<float/double/long double>, char, wchar_t, char16_t, char32_t, the
+ * NumericDecimal kinds and NumericFloat16 / NumericBFloat16). Adding or subtracting
+ * 64-bit decimals runs the 64-bit integer kernels on their units; 16-bit float columns
+ * are widened to float block by block and run the float kernels.
+ *
+ * Every operation gives the same result as the matching *Operation call on the
+ * scalar classes, element by element, including the error policy: a zero divisor
+ * anywhere throws "divideOperation: Division by zero is not allowed." before any
+ * output is produced, characters reject multiply/divide, and an integer or decimal
+ * overflow follows the thread's NumericOverflow policy (by default it throws
+ * "<op>Operation: Integer overflow.").
+ */
+
+/************************ Aligned storage ********************************/
+
+constexpr std::size_t numericColumnAlignment = 64;
+
+template <typename T>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(numericColumnAlignment)));
+    }
+
+    void deallocate(T* pointer, std::size_t)
+    {
+        ::operator delete(pointer, std::align_val_t(numericColumnAlignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+};
+
+/************************ Comparison masks ********************************/
+
+// One bit per element, element i lives in bit (i % 64) of word (i / 64)
+class NumericMask
+{
+    public:
+    NumericMask() = default;
+    explicit NumericMask(std::size_t size) : bitCount(size), bits((size + 63) / 64, 0) {}
+
+    std::size_t size() const { return bitCount; }
+    bool test(std::size_t index) const { return (bits[index / 64] >> (index % 64)) & 1u; }
+    void set(std::size_t index) { bits[index / 64] |= std::uint64_t(1) << (index % 64); }
+    std::size_t count() const;
+
+    std::uint64_t* words() { return bits.data(); }
+    const std::uint64_t* words() const { return bits.data(); }
+    std::size_t wordCount() const { return bits.size(); }
+
+    private:
+    std::size_t bitCount = 0;
+    std::vector<std::uint64_t> bits;
+};
+
+/************************ Kernels ********************************/
+
+enum class NumericSimdLevel : std::uint8_t
+{
+    Scalar,
+    Avx2,
+    Avx512
+};
+
+// Best instruction set found by CPUID, or the level forced with setNumericSimdLevel
+NumericSimdLevel numericSimdLevel();
+// Caps the kernels at `level` (never above what the CPU supports); mainly for benchmarks
+void setNumericSimdLevel(NumericSimdLevel level);
+
+/**
+ * Raw column kernels, defined in NumericColumn.cpp for every column value type.
+ * `rhs` has `count` elements, or a single element when `broadcast` is true.
+ * Return NumericError instead of throwing; nothing is written on error, except for
+ * NumericError::Overflow, which leaves the wrapped results in `out`. Integer add,
+ * subtract and multiply detect overflow with vector compares whose lanes are OR-ed
+ * together and tested once for the whole column.
+ */
+template <typename T>
+NumericError columnArithmetic(NumericOp op, const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t count,
+                              NumericOverflow overflow = NumericOverflow::Checked);
+template <typename T>
+NumericError columnCompare(NumericOp op, const T* lhs, const T* rhs, bool broadcast, std::uint64_t* maskWords, std::size_t count);
+
+/************************ NumericColumn Class ********************************/
+
+template <typename T>
+class NumericColumn
+{
+    static_assert(numericKindOf<T> != NumericKind::Count, "NumericColumn<T> needs a value type stored by a Numeric class");
+
+    public:
+    using value_type = T;
+    using Storage = std::vector<T, AlignedAllocator<T>>;
+    static constexpr NumericKind kind = numericKindOf<T>;
+
+    NumericColumn() = default;
+    explicit NumericColumn(std::size_t size, T fill = T{}) : values(size, fill) {}
+    NumericColumn(std::initializer_list<T> init) : values(init) {}
+
+    std::size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    void reserve(std::size_t capacity) { values.reserve(capacity); }
+    void resize(std::size_t size) { values.resize(size); }
+    void clear() { values.clear(); }
+    void push_back(T value) { values.push_back(value); }
+
+    T* data() { return values.data(); }
+    const T* data() const { return values.data(); }
+    T& operator[](std::size_t index) { return values[index]; }
+    const T& operator[](std::size_t index) const { return values[index]; }
+    auto begin() { return values.begin(); }
+    auto end() { return values.end(); }
+    auto begin() const { return values.begin(); }
+    auto end() const { return values.end(); }
+
+    // Boxes one element into the matching Numeric class
+    std::unique_ptr<Numeric> at(std::size_t index) const
+    {
+        return std::make_unique<NumericClass<kind>>(values.at(index));
+    }
+
+    NumericColumn sumOperation(const NumericColumn& second) const { return arithmetic(NumericOp::Sum, second); }
+    NumericColumn subtractOperation(const NumericColumn& second) const { return arithmetic(NumericOp::Subtract, second); }
+    NumericColumn multiplyOperation(const NumericColumn& second) const { return arithmetic(NumericOp::Multiply, second); }
+    NumericColumn divideOperation(const NumericColumn& second) const { return arithmetic(NumericOp::Divide, second); }
+
+    NumericColumn sumOperation(T second) const { return arithmetic(NumericOp::Sum, second); }
+    NumericColumn subtractOperation(T second) const { return arithmetic(NumericOp::Subtract, second); }
+    NumericColumn multiplyOperation(T second) const { return arithmetic(NumericOp::Multiply, second); }
+    NumericColumn divideOperation(T second) const { return arithmetic(NumericOp::Divide, second); }
+
+    NumericMask lessThanOperation(const NumericColumn& second) const { return comparison(NumericOp::LessThan, second); }
+    NumericMask greaterThanOperation(const NumericColumn& second) const { return comparison(NumericOp::GreaterThan, second); }
+    NumericMask equalOperation(const NumericColumn& second) const { return comparison(NumericOp::Equal, second); }
+
+    NumericMask lessThanOperation(T second) const { return comparison(NumericOp::LessThan, second); }
+    NumericMask greaterThanOperation(T second) const { return comparison(NumericOp::GreaterThan, second); }
+    NumericMask equalOperation(T second) const { return comparison(NumericOp::Equal, second); }
+
+    private:
+    Storage values;
+
+    static void checkSizes(NumericOp op, std::size_t first, std::size_t second)
+    {
+        if (first != second) {
+            throw std::runtime_error(std::string(numericOpName(op)) + ": Column sizes do not match.");
+        }
+    }
+
+    static NumericOverflow overflowPolicy()
+    {
+        if constexpr (hasOverflowPolicy(kind)) {
+            return numericOverflowMode();
+        } else {
+            return NumericOverflow::Checked;
+        }
+    }
+
+    static void throwIfFailed(NumericOp op, NumericError error)
+    {
+        if (error != NumericError::None) {
+            throw std::runtime_error(numericErrorMessage(op, error));
+        }
+    }
+
+    NumericColumn arithmetic(NumericOp op, const NumericColumn& second) const
+    {
+        checkSizes(op, size(), second.size());
+        NumericColumn result(size());
+        throwIfFailed(op, columnArithmetic<T>(op, data(), second.data(), false, result.data(), size(), overflowPolicy()));
+        return result;
+    }
+
+    NumericColumn arithmetic(NumericOp op, const T& second) const
+    {
+        NumericColumn result(size());
+        throwIfFailed(op, columnArithmetic<T>(op, data(), &second, true, result.data(), size(), overflowPolicy()));
+        return result;
+    }
+
+    NumericMask comparison(NumericOp op, const NumericColumn& second) const
+    {
+        checkSizes(op, size(), second.size());
+        NumericMask mask(size());
+        throwIfFailed(op, columnCompare<T>(op, data(), second.data(), false, mask.words(), size()));
+        return mask;
+    }
+
+    NumericMask comparison(NumericOp op, const T& second) const
+    {
+        NumericMask mask(size());
+        throwIfFailed(op, columnCompare<T>(op, data(), &second, true, mask.words(), size()));
+        return mask;
+    }
+};
+
+#endif // __NUMERIC_COLUMN_HPP__
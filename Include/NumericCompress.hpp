@@ -0,0 +1,128 @@
+#ifndef __NUMERIC_COMPRESS_HPP__
+#define __NUMERIC_COMPRESS_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+
+/**
+ * Lightweight compression for typed columns that repeat or change slowly.
+ *
+ *     NumericCompressedColumn<std::int64_t> ids(column);            // smallest encoding that fits
+ *     std::int64_t total = ids.sum();                               // without decoding
+ *     NumericMask recent = ids.greaterThanOperation(1700000000);
+ *     NumericColumn<std::int64_t> back = ids.decode();
+ *
+ * Encodings, all lossless (floating-point values keep their bits, NaN payloads included):
+ *  - Plain:            the values as they are
+ *  - Dictionary:       the distinct values, sorted, and a bit-packed code per row
+ *  - RunLength:        one value and the end row of each run of equal values
+ *  - Delta:            per block of 1024 rows the first value and the smallest step, then
+ *                      every step minus that smallest one, bit-packed (integers, characters)
+ *  - FrameOfReference: per block the smallest and largest value, then every value minus
+ *                      the smallest, bit-packed (integers, characters)
+ *  - Xor:              Gorilla: per block the first value, then each value XORed with the
+ *                      previous one, stored as a 0 bit when equal and otherwise as the
+ *                      bits between its leading and trailing zeros (float, double)
+ * Automatic encodes with each encoding T supports and keeps the smallest.
+ *
+ * Bit-packed fields are unpacked with AVX2 / AVX-512 gathers (up to 56 bits wide) into a
+ * block of 1024 values. sum / min / max and the comparisons work on the encoded form
+ * where it allows: a dictionary is compared once per distinct value and summed from a
+ * count per code, runs once per run, a frame-of-reference block is skipped or taken
+ * whole from its smallest and largest value and otherwise compared on the packed
+ * offsets. Delta and Xor blocks are decoded into a buffer that the column comparison
+ * kernels then read.
+ *
+ * Results are those of the decoded column: comparisons give what NumericColumn<T>'s
+ * lessThanOperation / greaterThanOperation / equalOperation give, sum / min / max what
+ * numericSum / numericMin / numericMax give (an integer sum is exact and then follows the
+ * thread's NumericOverflow policy; they throw for an empty column).
+ */
+
+enum class NumericEncoding : std::uint8_t
+{
+    Plain,
+    Dictionary,
+    RunLength,
+    Delta,
+    FrameOfReference,
+    Xor,
+    Automatic       // a request only: the smallest of the encodings above that T supports
+};
+
+const char* numericEncodingName(NumericEncoding encoding);
+
+// Value types a NumericCompressedColumn holds
+template <typename T>
+concept NumericCompressible = IntegerValue<T> || charTemp<T> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <NumericCompressible T>
+class NumericCompressedColumn
+{
+    public:
+    static constexpr std::size_t blockSize = 1024;
+
+    NumericCompressedColumn() = default;
+    explicit NumericCompressedColumn(const NumericColumn<T>& column, NumericEncoding encoding = NumericEncoding::Automatic);
+
+    // Delta and FrameOfReference need integer steps, Xor a floating-point bit pattern
+    static constexpr bool supports(NumericEncoding encoding)
+    {
+        switch (encoding) {
+            case NumericEncoding::Delta:
+            case NumericEncoding::FrameOfReference: return !std::is_floating_point_v<T>;
+            case NumericEncoding::Xor:              return std::is_floating_point_v<T>;
+            default:                                return true;
+        }
+    }
+
+    NumericEncoding encoding() const { return kind; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    // Bytes the encoded data takes, and the raw size over it
+    std::size_t compressedBytes() const;
+    double ratio() const;
+
+    NumericColumn<T> decode() const;
+    // Rows [first, first + rows) into `out`
+    void decode(std::size_t first, std::size_t rows, T* out) const;
+    T at(std::size_t index) const;
+
+    NumericMask lessThanOperation(T value) const { return comparison(NumericOp::LessThan, value); }
+    NumericMask greaterThanOperation(T value) const { return comparison(NumericOp::GreaterThan, value); }
+    NumericMask equalOperation(T value) const { return comparison(NumericOp::Equal, value); }
+
+    T sum() const requires IntegerValue<T>;
+    T min() const requires (!charTemp<T>);
+    T max() const requires (!charTemp<T>);
+
+    private:
+    struct Block
+    {
+        std::uint64_t reference = 0;    // FrameOfReference: smallest key; Delta: smallest step; Xor: bits of the first value
+        std::uint64_t high = 0;         // FrameOfReference: largest key; Delta: key of the first value
+        std::uint64_t bitOffset = 0;    // start of the block in `packed`
+        std::uint8_t bits = 0;          // width of each packed field
+    };
+
+    NumericEncoding kind = NumericEncoding::Plain;
+    std::size_t count = 0;
+    std::vector<T> values;              // Plain: every value; Dictionary: the distinct values; RunLength: one per run
+    std::vector<std::uint64_t> runEnds; // RunLength: row after each run
+    std::vector<std::uint64_t> packed;  // bit-packed fields, with a zero word after the last one
+    std::vector<Block> blocks;          // Delta, FrameOfReference, Xor: one per block of rows
+    std::uint8_t codeBits = 0;          // Dictionary: width of each code
+
+    void encode(const NumericColumn<T>& column, NumericEncoding encoding);
+    void decodeBlock(std::size_t block, T* out) const;
+    NumericMask comparison(NumericOp op, T value) const;
+    template <bool Max>
+    T extreme(const char* name) const;
+};
+
+#endif // __NUMERIC_COMPRESS_HPP__
@@ -0,0 +1,243 @@
+#ifndef __NUMERIC_DECIMAL_HPP__
+#define __NUMERIC_DECIMAL_HPP__
+
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * Fixed-point decimal, the value DecimalNumeric stores: a signed integer count of
+ * 10^-Scale units, so 12.34 at scale 2 is 1234 units and sums are exact integer sums.
+ * Rep is std::int64_t (up to 18 digits in all) or NumericInt128 (up to 38).
+ *
+ * Integers convert exactly, saturating when the value is out of range. Floating-point
+ * values are rounded once, from their exact binary value, to the nearest unit (ties to
+ * even), saturate, and NaN becomes 0.
+ * Converting to an integer truncates toward zero; to float or double gives the nearest
+ * value, and to long double too while the units fit in 64 bits (beyond that, within an
+ * ulp of it). Rescaling to fewer digits rounds half-even.
+ *
+ * The text form is every digit of the scale: "-0.50" at scale 2. fromString accepts an
+ * optional sign, digits and an optional fraction; extra fraction digits are rounded
+ * half-even, and invalid or out-of-range text throws.
+ */
+
+__extension__ typedef __int128 NumericInt128;
+__extension__ typedef unsigned __int128 NumericUInt128;
+
+// How a decimal multiply or divide rounds a result that falls between two units
+enum class NumericRounding : std::uint8_t
+{
+    HalfEven,     // to the nearest, ties to the even neighbour (the default)
+    HalfUp,       // to the nearest, ties away from zero
+    TowardZero,   // truncate
+    Floor,        // toward -inf
+    Ceiling       // toward +inf
+};
+
+// Policy of the current thread, set with NumericRoundingScope (Numeric.hpp)
+NumericRounding numericRoundingMode();
+
+constexpr NumericInt128 numericPowerOf10(unsigned exponent)
+{
+    NumericInt128 power = 1;
+    while (exponent-- > 0) {
+        power *= 10;
+    }
+    return power;
+}
+
+constexpr NumericUInt128 numericMagnitude(NumericInt128 value)
+{
+    return value < 0 ? NumericUInt128(0) - static_cast<NumericUInt128>(value) : static_cast<NumericUInt128>(value);
+}
+
+// Whether a truncated quotient (odd or not) that left `remainder` < divisor moves one unit away from zero
+constexpr bool numericRoundsAway(NumericRounding rounding, bool negative, bool odd, NumericUInt128 remainder, NumericUInt128 divisor)
+{
+    // No short-circuits: on random data the ties and zero remainders are unpredictable branches
+    switch (rounding) {
+        case NumericRounding::TowardZero: return false;
+        case NumericRounding::Floor:      return negative & (remainder != 0);
+        case NumericRounding::Ceiling:    return !negative & (remainder != 0);
+        case NumericRounding::HalfUp:     return remainder >= divisor - remainder;
+        default:                          return remainder + odd > divisor - remainder;
+    }
+}
+
+// Magnitude and sign back to a NumericInt128; false when it does not fit (result keeps the low bits)
+constexpr bool numericSignedResult(bool negative, NumericUInt128 magnitude, NumericInt128& result)
+{
+    result = static_cast<NumericInt128>(negative ? NumericUInt128(0) - magnitude : magnitude);
+    return magnitude <= (NumericUInt128(1) << 127) - !negative;
+}
+
+// Out-of-line part of numericMulDiv for products that need more than 128 bits
+bool numericMulDivWide(NumericUInt128 first, NumericUInt128 second, NumericUInt128 divisor, bool negative,
+                       NumericRounding rounding, NumericInt128& result);
+
+/**
+ * first * second / divisor rounded as `rounding` says, with an exact 256-bit
+ * intermediate; divisor != 0. Returns false when the result does not fit 128 bits.
+ */
+constexpr bool numericMulDiv(NumericInt128 first, NumericInt128 second, NumericInt128 divisor, NumericRounding rounding, NumericInt128& result)
+{
+    const bool negative = ((first < 0) != (second < 0)) != (divisor < 0);
+    const NumericUInt128 a = numericMagnitude(first);
+    const NumericUInt128 b = numericMagnitude(second);
+    const NumericUInt128 d = numericMagnitude(divisor);
+
+    NumericUInt128 product = 0;
+    if (__builtin_mul_overflow(a, b, &product)) [[unlikely]] {
+        return numericMulDivWide(a, b, d, negative, rounding, result);
+    }
+    NumericUInt128 quotient;
+    NumericUInt128 remainder;
+    if ((product >> 64) == 0 && (d >> 64) == 0) {
+        // Most products of 64-bit decimals: one hardware division instead of a 128-bit library call
+        const std::uint64_t narrow = static_cast<std::uint64_t>(product);
+        quotient = narrow / static_cast<std::uint64_t>(d);
+        remainder = narrow % static_cast<std::uint64_t>(d);
+    } else {
+        quotient = product / d;
+        remainder = product % d;
+    }
+    quotient += numericRoundsAway(rounding, negative, quotient & 1, remainder, d);
+    return numericSignedResult(negative && quotient != 0, quotient, result);
+}
+
+// |value| * 10^scale rounded once as `rounding` says, from the exact binary value of `value`;
+// false for NaN, the infinities and magnitudes past 128 bits
+bool numericScaleFloating(long double value, unsigned scale, NumericRounding rounding, NumericUInt128& magnitude);
+
+// magnitude / 10^scale as significand * 2^(returned exponent - 63), the top bit of significand
+// set and its low bit sticky when the quotient has more bits; magnitude must not be 0
+int numericScaleBinary(NumericUInt128 magnitude, unsigned scale, std::uint64_t& significand);
+
+// Text of `units` 10^-scale, and its parse; both used by NumericDecimal for every Rep
+char* numericDecimalToChars(char* first, char* last, NumericInt128 units, unsigned scale);
+NumericInt128 numericDecimalFromString(std::string_view text, unsigned scale, NumericInt128 minUnits, NumericInt128 maxUnits);
+
+template <unsigned Scale, typename Rep = std::int64_t>
+struct NumericDecimal
+{
+    static_assert(std::is_same_v<Rep, std::int64_t> || std::is_same_v<Rep, NumericInt128>, "NumericDecimal is stored in std::int64_t or NumericInt128");
+    static_assert(Scale <= (sizeof(Rep) == 8 ? 18u : 36u), "Scale leaves no integer digit in Rep");
+
+    using rep_type = Rep;
+    static constexpr unsigned scale = Scale;
+    static constexpr Rep unit = static_cast<Rep>(numericPowerOf10(Scale));     // units in 1
+    static constexpr Rep maxUnits = static_cast<Rep>(~std::conditional_t<sizeof(Rep) == 8, std::uint64_t, NumericUInt128>(0) >> 1);
+    static constexpr Rep minUnits = -maxUnits - 1;
+    // Longest text: sign, every digit of the largest Rep, the point and a leading zero
+    static constexpr std::size_t maxChars = (sizeof(Rep) == 8 ? 19 : 39) + 3;
+
+    Rep units = 0;
+
+    constexpr NumericDecimal() = default;
+
+    template <std::integral T>
+    constexpr explicit NumericDecimal(T value)
+    {
+        if (__builtin_mul_overflow(value, unit, &units)) {
+            units = value < 0 ? minUnits : maxUnits;
+        }
+    }
+
+    template <std::floating_point T>
+    explicit NumericDecimal(T value)
+    {
+        // value * unit in long double would round before the half-even rounding does
+        const bool negative = value < 0;
+        NumericUInt128 magnitude = 0;
+        if (value != value) {
+            units = 0;
+        } else if (numericScaleFloating(value, Scale, NumericRounding::HalfEven, magnitude) &&
+                   magnitude <= static_cast<NumericUInt128>(maxUnits) + negative) {
+            units = static_cast<Rep>(negative ? NumericUInt128(0) - magnitude : magnitude);
+        } else {
+            units = negative ? minUnits : maxUnits;
+        }
+    }
+
+    template <unsigned OtherScale, typename OtherRep>
+    constexpr explicit NumericDecimal(const NumericDecimal<OtherScale, OtherRep>& other)
+    {
+        NumericInt128 scaled = 0;
+        bool fits;
+        if constexpr (OtherScale <= Scale) {
+            fits = !__builtin_mul_overflow(static_cast<NumericInt128>(other.units), numericPowerOf10(Scale - OtherScale), &scaled);
+        } else {
+            fits = numericMulDiv(other.units, 1, numericPowerOf10(OtherScale - Scale), NumericRounding::HalfEven, scaled);
+        }
+        if (fits && scaled >= minUnits && scaled <= maxUnits) {
+            units = static_cast<Rep>(scaled);
+        } else {
+            units = other.units < 0 ? minUnits : maxUnits;
+        }
+    }
+
+    static constexpr NumericDecimal fromUnits(Rep units)
+    {
+        NumericDecimal decimal;
+        decimal.units = units;
+        return decimal;
+    }
+
+    static NumericDecimal fromString(std::string_view text)
+    {
+        return fromUnits(static_cast<Rep>(numericDecimalFromString(text, Scale, minUnits, maxUnits)));
+    }
+
+    std::string toString() const
+    {
+        char buffer[maxChars];
+        return std::string(buffer, toChars(buffer, buffer + maxChars));
+    }
+
+    // Writes toString() into [first, last); nullptr when it does not fit (maxChars always does)
+    char* toChars(char* first, char* last) const { return numericDecimalToChars(first, last, units, Scale); }
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    constexpr explicit operator T() const
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return units != 0;
+        } else if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(units / unit);
+        } else if constexpr (std::numeric_limits<T>::digits <= 62) {
+            // Rounded once from the exact quotient: its top 64 bits and a sticky bit round like it
+            if (units == 0) {
+                return T(0);
+            }
+            const bool negative = units < 0;
+            const NumericUInt128 magnitude = static_cast<NumericUInt128>(static_cast<NumericInt128>(units));
+            std::uint64_t significand = 0;
+            const int exponent = numericScaleBinary(negative ? NumericUInt128(0) - magnitude : magnitude, Scale, significand);
+            const T value = std::ldexp(static_cast<T>(significand), exponent - 63);
+            return negative ? -value : value;
+        } else {
+            return static_cast<T>(static_cast<long double>(units) / static_cast<long double>(unit));
+        }
+    }
+
+    friend constexpr bool operator==(const NumericDecimal&, const NumericDecimal&) = default;
+    friend constexpr auto operator<=>(const NumericDecimal& first, const NumericDecimal& second)
+    {
+        return first.units <=> second.units;
+    }
+};
+
+// The registered decimal kinds (NumericKind::Decimal2, Decimal6 and Decimal18)
+using NumericDecimal2 = NumericDecimal<2>;
+using NumericDecimal6 = NumericDecimal<6>;
+using NumericDecimal18 = NumericDecimal<18, NumericInt128>;
+
+#endif // __NUMERIC_DECIMAL_HPP__
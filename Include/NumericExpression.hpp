@@ -0,0 +1,293 @@
+#ifndef __NUMERIC_EXPRESSION_HPP__
+#define __NUMERIC_EXPRESSION_HPP__
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+
+/**
+ * Expression templates over the Numeric value types.
+ *
+ * With a NumericColumn or an expression on at least one side, + - * / build an
+ * expression tree instead of computing anything. The result type of every node comes
+ * from the same constexpr promotion rule (arithmeticRule) that the virtual *Operation
+ * methods use, and a pair those methods reject (for example int + long double) fails
+ * to compile. numericEvaluate() then computes the whole tree in one loop over the
+ * elements, with no intermediate columns or Numeric objects:
+ *
+ *     NumericColumn<int> a = ...;  NumericColumn<double> b = ..., d = ...;
+ *     NumericColumn<double> r = numericEvaluate(a * b + 2.5f / d);   // float / double -> float
+ *
+ * Operands can be columns, raw values (int, float, double, std::complex<...>, chars)
+ * or Numeric objects (IntNumeric, FloatNumeric<T>, ...). Scalars are broadcast. Every
+ * element is computed by the same kernel, in the same order, as the step-by-step
+ * virtual calls, so results are bit-identical. Division by zero or an integer overflow
+ * (see NumericOverflowScope, read when numericEvaluate() starts, as NumericFormula::
+ * evaluate() does) in any element throws after the loop, with the message of the first
+ * failing element, and a size mismatch throws "<op>: Column sizes do not match." when
+ * the expression is built.
+ *
+ * Expressions point into their columns and are meant to be evaluated in the statement
+ * that builds them.
+ */
+
+/************************ Operands ********************************/
+
+template <typename C, std::size_t... I>
+constexpr NumericKind numericClassKindOf(std::index_sequence<I...>)
+{
+    NumericKind kind = NumericKind::Count;
+    ((std::is_same_v<C, NumericClass<NumericKind(I)>> ? (kind = NumericKind(I), true) : false) || ...);
+    return kind;
+}
+
+// Kind of a Numeric class (IntNumeric -> Int), Count for anything else
+template <typename C>
+constexpr NumericKind numericClassKind = numericClassKindOf<C>(std::make_index_sequence<numericKindCount>{});
+
+template <typename T>
+constexpr bool isNumericColumn = false;
+template <typename T>
+constexpr bool isNumericColumn<NumericColumn<T>> = true;
+
+template <typename T>
+class NumericScalarTerminal
+{
+    public:
+    using value_type = T;
+    static constexpr bool hasColumn = false;
+    static constexpr bool isNumericExpression = true;
+
+    explicit NumericScalarTerminal(T value) : value(value) {}
+
+    std::size_t size() const { return 0; }
+    bool at(std::size_t, T& out, NumericOverflow) const
+    {
+        out = value;
+        return true;
+    }
+    const char* errorAt(std::size_t, NumericOverflow) const { return nullptr; }
+
+    private:
+    T value;
+};
+
+template <typename T>
+class NumericColumnTerminal
+{
+    public:
+    using value_type = T;
+    static constexpr bool hasColumn = true;
+    static constexpr bool isNumericExpression = true;
+
+    explicit NumericColumnTerminal(const NumericColumn<T>& column) : values(column.data()), count(column.size()) {}
+
+    std::size_t size() const { return count; }
+    bool at(std::size_t index, T& out, NumericOverflow) const
+    {
+        out = values[index];
+        return true;
+    }
+    const char* errorAt(std::size_t, NumericOverflow) const { return nullptr; }
+
+    private:
+    const T* values;
+    std::size_t count;
+};
+
+template <typename E>
+concept NumericExpressionNode = std::remove_cvref_t<E>::isNumericExpression;
+
+template <typename T>
+concept NumericColumnOperand = isNumericColumn<std::remove_cvref_t<T>>;
+
+template <typename T>
+concept NumericScalarOperand = numericKindOf<std::remove_cvref_t<T>> != NumericKind::Count ||
+                               numericClassKind<std::remove_cvref_t<T>> != NumericKind::Count;
+
+template <typename T>
+concept NumericOperand = NumericExpressionNode<T> || NumericColumnOperand<T> || NumericScalarOperand<T>;
+
+/**
+ * Wraps a column, a value or a Numeric object as an expression node (nodes pass through).
+ * Also the way to start an expression made only of scalars:
+ *     double x = numericEvaluate(numericOperand(IntNumeric(3)) / 2.0);
+ */
+template <NumericOperand T>
+auto numericOperand(const T& operand)
+{
+    if constexpr (NumericExpressionNode<T>) {
+        return operand;
+    } else if constexpr (NumericColumnOperand<T>) {
+        return NumericColumnTerminal<typename T::value_type>(operand);
+    } else if constexpr (numericKindOf<T> != NumericKind::Count) {
+        return NumericScalarTerminal<T>(operand);
+    } else {
+        constexpr NumericKind kind = numericClassKind<T>;
+        return NumericScalarTerminal<NumericKindValue<kind>>(numericValueOf<kind>(operand));
+    }
+}
+
+/************************ Expression nodes ********************************/
+
+template <NumericOp Op, typename L, typename R>
+class NumericBinaryExpression
+{
+    using Kernel = ArithmeticKernel<Op, numericKindOf<typename L::value_type>, numericKindOf<typename R::value_type>>;
+    static_assert(Kernel::rule.error != NumericError::UnsupportedType, "Unsupported type for this operation.");
+    static_assert(Kernel::rule.error != NumericError::UnsupportedConversion, "Unsupported conversion between these operand types.");
+    static_assert(Kernel::rule.error != NumericError::UnsupportedCharOperation, "Operation not supported for characters.");
+
+    public:
+    using value_type = typename Kernel::result_type;
+    static constexpr bool hasColumn = L::hasColumn || R::hasColumn;
+    static constexpr bool isNumericExpression = true;
+
+    NumericBinaryExpression(L left, R right) : left(std::move(left)), right(std::move(right))
+    {
+        const std::size_t first = this->left.size();
+        const std::size_t second = this->right.size();
+        if (first != 0 && second != 0 && first != second) {
+            throw std::runtime_error(std::string(numericOpName(Op)) + ": Column sizes do not match.");
+        }
+        count = first != 0 ? first : second;
+    }
+
+    std::size_t size() const { return count; }
+
+    // Computes element `index` into `out`; false when a division by zero or an overflow happened on the way
+    bool at(std::size_t index, value_type& out, NumericOverflow overflow) const
+    {
+        typename L::value_type a{};
+        typename R::value_type b{};
+        const bool operandsOk = left.at(index, a, overflow) & right.at(index, b, overflow);
+
+        if constexpr (Op == NumericOp::Divide && std::is_floating_point_v<value_type>) {
+            // Same arithmetic as the kernel without the early return, so the loop vectorizes
+            const value_type divisor = promote(b);
+            out = promote(a) / divisor;
+            return operandsOk & (divisor != 0);
+        } else {
+            return operandsOk & (Kernel::apply(a, b, out, overflow) == NumericError::None);
+        }
+    }
+
+    // Message of the first error met while computing element `index`, nullptr if there is none
+    const char* errorAt(std::size_t index, NumericOverflow overflow) const
+    {
+        if (const char* message = left.errorAt(index, overflow)) {
+            return message;
+        }
+        if (const char* message = right.errorAt(index, overflow)) {
+            return message;
+        }
+        typename L::value_type a{};
+        typename R::value_type b{};
+        value_type out{};
+        left.at(index, a, overflow);
+        right.at(index, b, overflow);
+        const NumericError error = Kernel::apply(a, b, out, overflow);
+        return error == NumericError::None ? nullptr : numericErrorMessage(Op, error);
+    }
+
+    private:
+    L left;
+    R right;
+    std::size_t count = 0;
+
+    template <typename V>
+    static value_type promote(const V& value)
+    {
+        if constexpr (std::is_same_v<V, value_type>) {
+            return value;
+        } else {
+            return convertValue<Kernel::resultKind>(value);
+        }
+    }
+};
+
+template <NumericOp Op, typename A, typename B>
+auto makeNumericExpression(const A& first, const B& second)
+{
+    auto left = numericOperand(first);
+    auto right = numericOperand(second);
+    return NumericBinaryExpression<Op, decltype(left), decltype(right)>(std::move(left), std::move(right));
+}
+
+// At least one side must be a column or an expression, so plain value arithmetic is untouched
+template <typename A, typename B>
+concept NumericExpressionOperands = NumericOperand<A> && NumericOperand<B> &&
+    (NumericExpressionNode<A> || NumericColumnOperand<A> || NumericExpressionNode<B> || NumericColumnOperand<B>);
+
+template <typename A, typename B>
+    requires NumericExpressionOperands<A, B>
+auto operator+(const A& first, const B& second) { return makeNumericExpression<NumericOp::Sum>(first, second); }
+
+template <typename A, typename B>
+    requires NumericExpressionOperands<A, B>
+auto operator-(const A& first, const B& second) { return makeNumericExpression<NumericOp::Subtract>(first, second); }
+
+template <typename A, typename B>
+    requires NumericExpressionOperands<A, B>
+auto operator*(const A& first, const B& second) { return makeNumericExpression<NumericOp::Multiply>(first, second); }
+
+template <typename A, typename B>
+    requires NumericExpressionOperands<A, B>
+auto operator/(const A& first, const B& second) { return makeNumericExpression<NumericOp::Divide>(first, second); }
+
+/************************ Evaluation ********************************/
+
+// Error message of the first failing element, once an evaluation loop has seen one fail
+template <NumericExpressionNode E>
+const char* numericExpressionError(const E& expression, std::size_t count, NumericOverflow overflow)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        if (const char* message = expression.errorAt(i, overflow)) {
+            return message;
+        }
+    }
+    return numericErrorMessage(NumericOp::Divide, NumericError::DivisionByZero);
+}
+
+// Evaluates into `out` (resized to the expression size); `out` is unspecified if this throws
+template <NumericExpressionNode E>
+void numericEvaluate(const E& expression, NumericColumn<typename E::value_type>& out)
+{
+    static_assert(E::hasColumn, "numericEvaluate(expression, out) needs a column operand");
+
+    const NumericOverflow overflow = numericOverflowMode();
+    const std::size_t count = expression.size();
+    out.resize(count);
+    typename E::value_type* values = out.data();
+    bool ok = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        ok &= expression.at(i, values[i], overflow);
+    }
+    if (!ok) {
+        throw std::runtime_error(numericExpressionError(expression, count, overflow));
+    }
+}
+
+// A column for expressions over columns, a single value for all-scalar expressions
+template <NumericExpressionNode E>
+auto numericEvaluate(const E& expression)
+{
+    if constexpr (E::hasColumn) {
+        NumericColumn<typename E::value_type> out;
+        numericEvaluate(expression, out);
+        return out;
+    } else {
+        const NumericOverflow overflow = numericOverflowMode();
+        typename E::value_type value{};
+        if (!expression.at(0, value, overflow)) {
+            throw std::runtime_error(numericExpressionError(expression, 1, overflow));
+        }
+        return value;
+    }
+}
+
+#endif // __NUMERIC_EXPRESSION_HPP__
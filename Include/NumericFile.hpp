@@ -0,0 +1,161 @@
+#ifndef __NUMERIC_FILE_HPP__
+#define __NUMERIC_FILE_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+
+/**
+ * Binary column file, little-endian, version 1.
+ *
+ *     offset 0    file header (64 bytes)
+ *                   char     magic[8]        "NUMCOLS\0"
+ *                   uint32   version         1
+ *                   uint32   columnCount
+ *                   uint64   fileSize
+ *                   (zero padding)
+ *     offset 64   one 64-byte column header per column
+ *                   uint32   type            NumericFileType tag
+ *                   uint32   elementSize     bytes per value
+ *                   uint64   count           number of values
+ *                   uint64   offset          start of the values, multiple of 64
+ *                   uint64   reserved        0
+ *                   char     name[32]        zero padded
+ *     then        the raw values of each column, each starting on a 64-byte boundary
+ *
+ * Values are stored exactly as in memory (complex as re, im; the 16-bit floats as their bits;
+ * Decimal2 and Decimal6 as their int64 units). NumericMappedFile maps
+ * the file and hands out std::span views straight into the mapping: opening costs
+ * O(columns), and pages are read when the values are first touched. The spans are
+ * 64-byte aligned, like NumericColumn storage, so the raw column kernels
+ * (columnArithmetic, columnCompare) can run on them directly.
+ *
+ * long double is not stored, because its layout differs between platforms, and neither
+ * are Decimal18 (128-bit units) and BigInt (not a fixed-size value).
+ */
+
+// On-disk type tags; the values are part of the format and never change
+enum class NumericFileType : std::uint32_t
+{
+    Int32 = 1,
+    Float32 = 2,
+    Float64 = 3,
+    ComplexFloat32 = 4,
+    ComplexFloat64 = 5,
+    Char8 = 6,
+    WChar = 7,     // element size records the platform width of wchar_t
+    Char16 = 8,
+    Char32 = 9,
+    Int8 = 10,
+    Int16 = 11,
+    Int64 = 12,
+    UInt8 = 13,
+    UInt16 = 14,
+    UInt32 = 15,
+    UInt64 = 16,
+    Float16 = 17,  // IEEE binary16 bits
+    BFloat16 = 18, // top 16 bits of a float
+    Decimal2 = 19, // int64 count of 10^-2 units
+    Decimal6 = 20  // int64 count of 10^-6 units
+};
+
+constexpr std::uint32_t numericFileVersion = 1;
+constexpr std::size_t numericFileAlignment = 64;
+constexpr std::size_t numericFileNameLength = 32;
+
+// File tag of a kind; throws "Unsupported type" for the long double kinds, Decimal18 and BigInt
+NumericFileType numericFileTypeOf(NumericKind kind);
+NumericKind numericKindOfFileType(NumericFileType type);
+
+/************************ NumericFileWriter Class ********************************/
+
+// Collects columns, then writes them in one go; the columns must outlive write()
+class NumericFileWriter
+{
+    public:
+    template <typename T>
+    void add(std::string_view name, std::span<const T> values)
+    {
+        addColumn(name, numericKindOf<T>, values.data(), sizeof(T), values.size());
+    }
+
+    template <typename T>
+    void add(std::string_view name, const NumericColumn<T>& column)
+    {
+        add<T>(name, std::span<const T>(column.data(), column.size()));
+    }
+
+    void write(const std::string& path) const;
+
+    private:
+    struct PendingColumn
+    {
+        std::string name;
+        NumericFileType type;
+        const void* data;
+        std::size_t elementSize;
+        std::size_t count;
+    };
+
+    std::vector<PendingColumn> columns;
+
+    void addColumn(std::string_view name, NumericKind kind, const void* data, std::size_t elementSize, std::size_t count);
+};
+
+/************************ NumericMappedFile Class ********************************/
+
+struct NumericFileColumn
+{
+    std::string name;
+    NumericKind kind;
+    std::size_t count;
+    std::size_t offset;
+};
+
+class NumericMappedFile
+{
+    public:
+    // Maps the file read-only and checks the headers; throws std::runtime_error if it is not valid
+    explicit NumericMappedFile(const std::string& path);
+    ~NumericMappedFile();
+    NumericMappedFile(const NumericMappedFile&) = delete;
+    NumericMappedFile& operator=(const NumericMappedFile&) = delete;
+
+    std::size_t columnCount() const { return columns.size(); }
+    const NumericFileColumn& column(std::size_t index) const { return columns.at(index); }
+    // Index of the column called `name`; throws if there is none
+    std::size_t find(std::string_view name) const;
+
+    // Zero-copy view of a column; throws if T is not the column's type
+    template <typename T>
+    std::span<const T> view(std::size_t index) const
+    {
+        const NumericFileColumn& info = column(index);
+        if (info.kind != numericKindOf<T>) {
+            throw std::runtime_error("NumericMappedFile: Column type does not match.");
+        }
+        return std::span<const T>(reinterpret_cast<const T*>(base + info.offset), info.count);
+    }
+
+    template <typename T>
+    std::span<const T> view(std::string_view name) const
+    {
+        return view<T>(find(name));
+    }
+
+    private:
+    const std::byte* base = nullptr;
+    std::size_t mappedSize = 0;
+    std::vector<NumericFileColumn> columns;
+
+    void unmap();
+};
+
+#endif // __NUMERIC_FILE_HPP__
@@ -0,0 +1,147 @@
+#ifndef __NUMERIC_FORMAT_HPP__
+#define __NUMERIC_FORMAT_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+
+/**
+ * Allocation-free text output built on std::to_chars.
+ *
+ * Text of one value:
+ *   integers (all widths)  decimal                      -42   18446744073709551615
+ *   BigInt                 decimal, every digit         -340282366920938463463374607431768211456
+ *   decimal kinds          every digit of the scale     12.50   -0.000001
+ *   float / double / long  shortest round-trip form     0.1   1e+300   -inf   nan
+ *   float16 / bfloat16     fewest digits that round back   0.1   65500   -inf
+ *   complex                "(re + imi)" as toString()   (1.5 + -2i)
+ *   char                   the byte itself
+ *   wchar_t/char16/char32  UTF-8 (U+FFFD for values that are not code points)
+ *
+ * Parsing the floating-point text with std::from_chars gives back the exact value (for the
+ * 16-bit kinds, once the parsed float is rounded to the kind).
+ */
+
+// Enough for any single value but a BigInt, which needs NumericBigInt::decimalBound()
+constexpr std::size_t numericFormatBufferSize = 128;
+
+// Same contract as Numeric::formatTo, for a raw value of any Numeric value type
+template <typename T>
+std::size_t numericFormatTo(char* buffer, std::size_t size, T value);
+
+/************************ NumericTextWriter Class ********************************/
+
+enum class NumericTextFormat : std::uint8_t
+{
+    Lines,   // one value per line
+    Csv      // one record per line, values separated by ','; fields with , " or newlines are quoted
+};
+
+/**
+ * Serializes many values into one growing buffer that is reused between calls:
+ *
+ *     NumericTextWriter writer(NumericTextFormat::Csv);
+ *     for (const auto& batch : batches) {
+ *         writer.writeRows(ids, prices);   // one "id,price" line per element
+ *         writer.flush(file);              // empties the buffer, keeps its capacity
+ *     }
+ *
+ * In Lines format every value ends with '\n'. In Csv format write() produces a single
+ * record and writeRows() one record per element of the given columns.
+ */
+class NumericTextWriter
+{
+    public:
+    explicit NumericTextWriter(NumericTextFormat format = NumericTextFormat::Lines) : format(format) {}
+
+    void write(const Numeric& value);
+    void write(const std::vector<std::unique_ptr<Numeric>>& values);
+
+    template <typename T>
+    void write(const NumericColumn<T>& column)
+    {
+        reserveFor(column.size());
+        for (std::size_t i = 0; i < column.size(); ++i) {
+            appendValue(column[i]);
+            appendSeparator(i + 1 == column.size());
+        }
+    }
+
+    // Csv: row i is "columns[0][i],columns[1][i],..."; Lines: all fields of row i, one per line
+    template <typename... T>
+    void writeRows(const NumericColumn<T>&... columns)
+    {
+        static_assert(sizeof...(T) > 0, "writeRows needs at least one column");
+        const std::size_t rows = std::get<0>(std::tie(columns...)).size();
+        if (((columns.size() != rows) || ...)) {
+            throw std::runtime_error("writeRows: Column sizes do not match.");
+        }
+
+        reserveFor(rows * sizeof...(T));
+        for (std::size_t row = 0; row < rows; ++row) {
+            std::size_t field = 0;
+            ((appendValue(columns[row]), appendSeparator(++field == sizeof...(T))), ...);
+        }
+    }
+
+    std::string_view view() const { return std::string_view(buffer.data(), length); }
+    std::size_t size() const { return length; }
+    void clear() { length = 0; }
+
+    // Writes the buffer out and clears it
+    void flush(std::FILE* file);
+    void flush(std::ostream& stream);
+
+    private:
+    NumericTextFormat format;
+    std::vector<char> buffer;
+    std::size_t length = 0;
+
+    void reserveFor(std::size_t values);
+    void appendSeparator(bool endOfRecord)
+    {
+        ensure(1);
+        buffer[length++] = (endOfRecord || format == NumericTextFormat::Lines) ? '\n' : ',';
+    }
+    void ensure(std::size_t bytes)
+    {
+        if (buffer.size() - length < bytes) {
+            grow(bytes);
+        }
+    }
+    void grow(std::size_t bytes);
+
+    template <typename T>
+    void appendValue(const T& value)
+    {
+        std::size_t room = numericFormatBufferSize;
+        if constexpr (std::is_same_v<T, NumericBigInt>) {
+            room = std::max(room, value.decimalBound());
+        }
+        ensure(room);
+        std::size_t written = numericFormatTo(buffer.data() + length, room, value);
+        if (written == 0) {
+            throw std::runtime_error("NumericTextWriter: Value does not fit its field.");
+        }
+        if constexpr (charTemp<T>) {
+            if (format == NumericTextFormat::Csv) {
+                written = quoteCsvField(written);
+            }
+        }
+        length += written;
+    }
+    void appendNumeric(const Numeric& value);
+    std::size_t quoteCsvField(std::size_t written);
+};
+
+#endif // __NUMERIC_FORMAT_HPP__
@@ -0,0 +1,174 @@
+#ifndef __NUMERIC_FORMULA_HPP__
+#define __NUMERIC_FORMULA_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "NumericColumn.hpp"
+#include "NumericValue.hpp"
+
+/**
+ * Formulas given as text, compiled once and run over named columns.
+ *
+ *     NumericFormulaColumns columns;
+ *     columns.add("a", a);  columns.add("b", b);  columns.add("c", c);  columns.add("d", d);
+ *     NumericFormula formula("a*b + c/d - 3", columns);
+ *     NumericColumn<double> r = formula.evaluate<double>(columns);
+ *
+ * The text holds column names, numbers, + - * /, unary minus and parentheses, with
+ * the usual precedence. A number with a '.' or an exponent is a double, any other is
+ * an int, or an int64 when it does not fit (like a C++ literal). -x is computed as
+ * 0 - x in the kind of x.
+ *
+ * Compiling resolves the kind of every node from the kinds of the bound columns, with
+ * the promotion rule of the virtual *Operation methods (arithmeticRule), so a pair
+ * those methods reject, or an unknown name, throws here rather than per row.
+ * Subexpressions over constants only are folded (under the overflow and rounding
+ * policies in force while compiling), and identical subexpressions are computed once:
+ * in "a*b + a*b/c" the product is one instruction. The program that remains is a list
+ * of typed register instructions, out = lhs op rhs; column registers point straight
+ * into the columns and the last instruction writes into the result.
+ *
+ * evaluate() runs the program over chunkRows rows at a time, each instruction as one
+ * call of a kernel picked once for its (op, lhs kind, rhs kind), so the
+ * only per-row work is the arithmetic itself; same-kind operations use the SIMD
+ * column kernels (columnArithmetic). The registers are allocated once per call.
+ * Results are bit-identical to the step-by-step virtual calls. Division by zero or an
+ * integer overflow (see NumericOverflowScope, read when evaluate() starts, as
+ * numericEvaluate() reads it) throws the message of the first failing row, as
+ * numericEvaluate() does; only the folded constants keep the policy of compile time.
+ */
+
+/************************ Column bindings ********************************/
+
+// One named column: its kind and where its values are (not a copy)
+struct NumericFormulaColumn
+{
+    std::string name;
+    NumericKind kind = NumericKind::Count;
+    const void* data = nullptr;
+    std::size_t size = 0;
+};
+
+// The columns a formula can name; they must outlive the evaluate() calls that read them
+class NumericFormulaColumns
+{
+    public:
+    // Binds `name` to the values, replacing an earlier binding of the same name
+    template <typename T>
+    void add(std::string name, std::span<const T> values)
+    {
+        static_assert(numericKindOf<T> != NumericKind::Count, "NumericFormulaColumns::add needs a value type stored by a Numeric class");
+        bind({std::move(name), numericKindOf<T>, values.data(), values.size()});
+    }
+
+    template <typename T>
+    void add(std::string name, const NumericColumn<T>& column)
+    {
+        add(std::move(name), std::span<const T>(column.data(), column.size()));
+    }
+
+    // nullptr when `name` is not bound
+    const NumericFormulaColumn* find(std::string_view name) const;
+    std::size_t size() const { return columns.size(); }
+
+    private:
+    std::vector<NumericFormulaColumn> columns;
+
+    void bind(NumericFormulaColumn column);
+};
+
+/************************ NumericFormula Class ********************************/
+
+class NumericFormula
+{
+    public:
+    // Rows per pass of the program, so the registers of a chunk stay in the L1/L2 cache
+    static constexpr std::size_t chunkRows = 1024;
+
+    NumericFormula(std::string_view text, const NumericFormulaColumns& columns);
+
+    NumericKind resultKind() const { return result; }
+    std::size_t instructionCount() const { return program.size(); }
+    // Scratch registers (chunk buffers for intermediate results and constants)
+    std::size_t registerCount() const { return slots.size(); }
+    // One line per instruction, e.g. "t0 = a * b    ; double"
+    std::string disassemble() const;
+
+    /**
+     * Runs the formula over `columns`, which must bind every name the formula uses with
+     * the kind it was compiled for; all those columns must have the same size, and a
+     * formula that names no column gives one row. T must be the value type of
+     * resultKind(). `out` must not be one of the bound columns.
+     */
+    template <typename T>
+    void evaluate(const NumericFormulaColumns& columns, NumericColumn<T>& out) const
+    {
+        checkResultKind(numericKindOf<T>);
+        std::size_t rows = 0;
+        const std::vector<const void*> inputs = resolve(columns, rows);
+        out.resize(rows);
+        execute(inputs, out.data(), rows);
+    }
+
+    template <typename T>
+    NumericColumn<T> evaluate(const NumericFormulaColumns& columns) const
+    {
+        NumericColumn<T> out;
+        evaluate(columns, out);
+        return out;
+    }
+
+    private:
+    enum class Source : std::uint8_t
+    {
+        Column,      // index: position in `inputs`
+        Constant,    // index: position in `constants`
+        Zero,        // the 0 of -x; index: position in `slots`
+        Temporary,   // index: position in `slots`
+        Result,      // the output column
+    };
+
+    struct Operand
+    {
+        NumericKind kind = NumericKind::Count;
+        Source source = Source::Temporary;
+        std::uint32_t index = 0;
+    };
+
+    struct Instruction
+    {
+        NumericOp op = NumericOp::Sum;
+        Operand lhs;
+        Operand rhs;
+        Operand out;
+    };
+
+    struct Input
+    {
+        std::string name;
+        NumericKind kind = NumericKind::Count;
+    };
+
+    NumericKind result = NumericKind::Count;
+    std::vector<Input> inputs;
+    std::vector<NumericValue> constants;
+    std::vector<std::uint32_t> constantSlots;   // the slot each constant is spread over
+    std::vector<NumericKind> slots;
+    std::vector<Instruction> program;
+    Operand root;   // the result when the program is empty (a column or a constant)
+
+    // Defined in NumericFormula.cpp: the parser and code generator, and the chunk loop
+    struct Compiler;
+    struct Machine;
+
+    void checkResultKind(NumericKind kind) const;
+    std::vector<const void*> resolve(const NumericFormulaColumns& columns, std::size_t& rows) const;
+    void execute(const std::vector<const void*>& columns, void* out, std::size_t rows) const;
+};
+
+#endif // __NUMERIC_FORMULA_HPP__
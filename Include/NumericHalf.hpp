@@ -0,0 +1,202 @@
+#ifndef __NUMERIC_HALF_HPP__
+#define __NUMERIC_HALF_HPP__
+
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * 16-bit floating-point storage, the values FloatNumeric<NumericFloat16> and
+ * FloatNumeric<NumericBFloat16> hold:
+ *  - NumericFloat16:  IEEE binary16, 5 exponent bits and 10 fraction bits (about 3.3
+ *                     digits, finite up to 65504)
+ *  - NumericBFloat16: the top half of a float, 8 exponent bits and 7 fraction bits
+ *                     (about 2.4 digits, the range of float)
+ *
+ * They are storage types: arithmetic converts both operands to float, which holds
+ * every value exactly, computes there and rounds the result back once (to nearest,
+ * ties to even). float has more than twice the precision of either format, so that
+ * result is the correctly rounded one for + - * and /. Comparisons compare the float
+ * values, with the usual NaN rules.
+ *
+ * Converting from any arithmetic type rounds to nearest-even, overflows to infinity and
+ * keeps NaN (quiet, with the top of the payload); converting to float or double is exact.
+ * The scalar conversions below are constexpr bit manipulation. Whole arrays convert
+ * with numericToFloat / numericFromFloat (NumericHalf.cpp), which use F16C / AVX-512
+ * when the CPU has them and give the same bits.
+ */
+
+/**
+ * significand * 2^(exponent - 63), the top bit of significand set, rounded to the nearest
+ * 16-bit float with ExponentBits / FractionBits (ties to even) and given `sign`
+ */
+template <unsigned ExponentBits, unsigned FractionBits>
+constexpr std::uint16_t numericHalfRound(std::uint16_t sign, int exponent, std::uint64_t significand)
+{
+    constexpr int bias = (1 << (ExponentBits - 1)) - 1;
+    constexpr int maxExponent = (1 << ExponentBits) - 1;
+    constexpr std::uint16_t infinity = static_cast<std::uint16_t>(maxExponent << FractionBits);
+
+    // Target exponent; at 0 and below the result is subnormal and loses more fraction bits
+    const int target = exponent + bias;
+    if (target >= maxExponent) {
+        return static_cast<std::uint16_t>(sign | infinity);
+    }
+    const int shift = 63 - static_cast<int>(FractionBits) + (target < 1 ? 1 - target : 0);
+    if (shift > 64) {
+        return sign;    // below half the smallest subnormal
+    }
+    std::uint64_t rounded = shift < 64 ? significand >> shift : 0;
+    const std::uint64_t remainder = shift < 64 ? significand & ((std::uint64_t(1) << shift) - 1) : significand;
+    const std::uint64_t halfway = std::uint64_t(1) << (shift - 1);
+    rounded += remainder > halfway || (remainder == halfway && (rounded & 1) != 0);
+
+    // The implicit bit lands in the exponent field, so a carry out of the fraction bumps the exponent
+    const std::uint64_t magnitude = target < 1 ? rounded : (static_cast<std::uint64_t>(target - 1) << FractionBits) + rounded;
+    return static_cast<std::uint16_t>(sign | (magnitude >= infinity ? infinity : magnitude));
+}
+
+// value rounded to the nearest 16-bit float with ExponentBits / FractionBits, ties to even
+template <unsigned ExponentBits, unsigned FractionBits>
+constexpr std::uint16_t numericHalfFromDouble(double value)
+{
+    constexpr std::uint16_t infinity = static_cast<std::uint16_t>(((1 << ExponentBits) - 1) << FractionBits);
+
+    const std::uint64_t bits = std::bit_cast<std::uint64_t>(value);
+    const std::uint16_t sign = static_cast<std::uint16_t>((bits >> 63) << 15);
+    const int exponent = static_cast<int>((bits >> 52) & 0x7FF);
+    const std::uint64_t fraction = bits & ((std::uint64_t(1) << 52) - 1);
+
+    if (exponent == 0x7FF) {
+        // Infinity, or a NaN made quiet that keeps the top of its payload
+        const std::uint16_t nan = fraction == 0 ? 0 : static_cast<std::uint16_t>((1u << (FractionBits - 1)) | (fraction >> (52 - FractionBits)));
+        return static_cast<std::uint16_t>(sign | infinity | nan);
+    }
+    if (exponent == 0) {
+        return sign;    // double subnormals are far below either format's smallest value
+    }
+    return numericHalfRound<ExponentBits, FractionBits>(sign, exponent - 1023, (fraction | (std::uint64_t(1) << 52)) << 11);
+}
+
+// An integer rounded from all its bits; through double, one above 2^53 would be rounded twice
+template <unsigned ExponentBits, unsigned FractionBits, typename T>
+constexpr std::uint16_t numericHalfFromInteger(T value)
+{
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        negative = value < 0;
+    }
+    const std::uint64_t magnitude = negative ? std::uint64_t(0) - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+    if (magnitude == 0) {
+        return 0;
+    }
+    const int leading = std::countl_zero(magnitude);
+    return numericHalfRound<ExponentBits, FractionBits>(negative ? 0x8000 : 0, 63 - leading, magnitude << leading);
+}
+
+// A long double rounded from its whole significand; through double, one with more than 53 bits would be rounded twice
+template <unsigned ExponentBits, unsigned FractionBits>
+std::uint16_t numericHalfFromLongDouble(long double value)
+{
+    if (!std::isfinite(value) || value == 0) {
+        return numericHalfFromDouble<ExponentBits, FractionBits>(static_cast<double>(value));
+    }
+    // |value| = fraction * 2^exponent with fraction in [0.5, 1); 64 bits of it hold an x87 significand
+    // exactly, and a sticky low bit stands for any wider format's bits below those
+    int exponent = 0;
+    const long double scaled = std::ldexp(std::frexp(std::fabs(value), &exponent), 64);
+    std::uint64_t significand = static_cast<std::uint64_t>(scaled);
+    significand |= static_cast<long double>(significand) != scaled;
+    return numericHalfRound<ExponentBits, FractionBits>(std::signbit(value) ? 0x8000 : 0, exponent - 1, significand);
+}
+
+// Exact float value of the 16 bits
+template <unsigned ExponentBits, unsigned FractionBits>
+constexpr float numericHalfToFloat(std::uint16_t bits)
+{
+    if constexpr (ExponentBits == 8) {
+        return std::bit_cast<float>(static_cast<std::uint32_t>(bits) << 16);
+    } else {
+        // Exponent and fraction moved to float's positions read as a float 2^(127 - bias) too small,
+        // subnormals included; one exact multiply rebiases it. No branches, so loops vectorize
+        constexpr int bias = (1 << (ExponentBits - 1)) - 1;
+        constexpr std::uint32_t special = ((1u << ExponentBits) - 1) << 23;
+        constexpr float rebias = std::bit_cast<float>(static_cast<std::uint32_t>(127 - bias + 127) << 23);
+        const std::uint32_t sign = static_cast<std::uint32_t>(bits & 0x8000) << 16;
+        const std::uint32_t moved = static_cast<std::uint32_t>(bits & 0x7FFF) << (23 - FractionBits);
+        std::uint32_t magnitude = std::bit_cast<std::uint32_t>(std::bit_cast<float>(moved) * rebias);
+        if (moved >= special) {
+            // Infinity or NaN; F16C quiets a signalling NaN, so this does too
+            magnitude = 0x7F800000 | moved | (moved > special ? 0x00400000u : 0u);
+        }
+        return std::bit_cast<float>(sign | magnitude);
+    }
+}
+
+template <unsigned ExponentBits, unsigned FractionBits>
+struct NumericHalfFloat
+{
+    static_assert(1 + ExponentBits + FractionBits == 16, "NumericHalfFloat is a 16-bit format");
+
+    static constexpr unsigned exponentBits = ExponentBits;
+    static constexpr unsigned fractionBits = FractionBits;
+
+    std::uint16_t bits = 0;
+
+    constexpr NumericHalfFloat() = default;
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    constexpr explicit NumericHalfFloat(T value)
+    {
+        if constexpr (std::is_integral_v<T>) {
+            bits = numericHalfFromInteger<ExponentBits, FractionBits>(value);
+        } else if constexpr (std::is_same_v<T, long double>) {
+            bits = numericHalfFromLongDouble<ExponentBits, FractionBits>(value);
+        } else {
+            bits = numericHalfFromDouble<ExponentBits, FractionBits>(static_cast<double>(value));
+        }
+    }
+
+    static constexpr NumericHalfFloat fromBits(std::uint16_t bits)
+    {
+        NumericHalfFloat value;
+        value.bits = bits;
+        return value;
+    }
+
+    constexpr float toFloat() const { return numericHalfToFloat<ExponentBits, FractionBits>(bits); }
+
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    constexpr explicit operator T() const
+    {
+        return static_cast<T>(toFloat());
+    }
+
+    friend constexpr NumericHalfFloat operator+(NumericHalfFloat first, NumericHalfFloat second) { return NumericHalfFloat(first.toFloat() + second.toFloat()); }
+    friend constexpr NumericHalfFloat operator-(NumericHalfFloat first, NumericHalfFloat second) { return NumericHalfFloat(first.toFloat() - second.toFloat()); }
+    friend constexpr NumericHalfFloat operator*(NumericHalfFloat first, NumericHalfFloat second) { return NumericHalfFloat(first.toFloat() * second.toFloat()); }
+    friend constexpr NumericHalfFloat operator/(NumericHalfFloat first, NumericHalfFloat second) { return NumericHalfFloat(first.toFloat() / second.toFloat()); }
+
+    friend constexpr bool operator==(NumericHalfFloat first, NumericHalfFloat second) { return first.toFloat() == second.toFloat(); }
+    friend constexpr std::partial_ordering operator<=>(NumericHalfFloat first, NumericHalfFloat second)
+    {
+        return first.toFloat() <=> second.toFloat();
+    }
+};
+
+// The registered 16-bit kinds (NumericKind::Float16 and BFloat16)
+using NumericFloat16 = NumericHalfFloat<5, 10>;
+using NumericBFloat16 = NumericHalfFloat<8, 7>;
+
+// Array conversions; `out` holds count values. Same results as the scalar conversions
+void numericToFloat(const NumericFloat16* in, float* out, std::size_t count);
+void numericToFloat(const NumericBFloat16* in, float* out, std::size_t count);
+void numericFromFloat(const float* in, NumericFloat16* out, std::size_t count);
+void numericFromFloat(const float* in, NumericBFloat16* out, std::size_t count);
+
+#endif // __NUMERIC_HALF_HPP__
@@ -0,0 +1,377 @@
+#ifndef __NUMERIC_HASH_HPP__
+#define __NUMERIC_HASH_HPP__
+
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Numeric.hpp"
+
+/**
+ * Hashing consistent across kinds, and the open-addressing table built on it.
+ *
+ * Two values are the same key when they are exactly the same number: int 3, float 3.0,
+ * decimal 3.00 and complex 3+0i are one key, float 0.1f and double 0.1 are two (they
+ * differ), and so are decimal 0.10 and double 0.1. That is what equalOperation gives
+ * whenever converting the right operand to the left operand's type is exact; it does not
+ * follow the truncating conversions (IntNumeric(3) == FloatNumeric(3.5) is true, but
+ * 3.5 == 3 is false, so that relation cannot be hashed). In addition -0.0 is the same
+ * key as +0.0, all NaNs are one key, and characters are keyed by code unit, apart from
+ * every number (char 'A' and char32_t U'A' are one key, int 65 another).
+ *
+ * The hash of a number x = n / d (every value here is a fraction whose denominator is
+ * a power of 2 or 10) is n * d^-1 modulo the prime 2^61 - 1, the scheme Python uses:
+ * the residue depends only on the value, so every kind computes it from its own
+ * representation without converting. A complex number combines re + 1000003 * im, so
+ * an imaginary part of 0 leaves the real hash. The residue is then mixed (the MurmurHash3
+ * finalizer), so every bit of the 64-bit hash is usable for table indices and partitions.
+ */
+
+constexpr std::uint64_t numericHashModulus = (std::uint64_t(1) << 61) - 1;
+
+// x modulo 2^61 - 1; 2^61 is 1 in that ring, so the high bits fold onto the low ones
+constexpr std::uint64_t numericHashReduce(std::uint64_t x)
+{
+    x = (x & numericHashModulus) + (x >> 61);
+    return x >= numericHashModulus ? x - numericHashModulus : x;
+}
+
+constexpr std::uint64_t numericHashMultiply(std::uint64_t first, std::uint64_t second)
+{
+    const NumericUInt128 product = static_cast<NumericUInt128>(first) * second;
+    return numericHashReduce(static_cast<std::uint64_t>(product & numericHashModulus) + static_cast<std::uint64_t>(product >> 61));
+}
+
+// 2^exponent for any exponent, negative ones included (2^61 = 1)
+constexpr std::uint64_t numericHashPowerOf2(int exponent)
+{
+    return std::uint64_t(1) << (((exponent % 61) + 61) % 61);
+}
+
+constexpr std::uint64_t numericHashSigned(bool negative, std::uint64_t residue)
+{
+    return negative && residue != 0 ? numericHashModulus - residue : residue;
+}
+
+// Residues of the values that are not numbers; none of them is below the modulus
+constexpr std::uint64_t numericHashNaN = numericHashModulus;
+constexpr std::uint64_t numericHashInfinity = numericHashModulus + 1;
+constexpr std::uint64_t numericHashNegativeInfinity = numericHashModulus + 2;
+constexpr std::uint64_t numericHashCharacter = std::uint64_t(1) << 62;
+
+// Residue of a signed 128-bit integer: hi * 2^64 + lo, and 2^64 = 2^3
+constexpr std::uint64_t numericHashWide(NumericInt128 value)
+{
+    const NumericUInt128 magnitude = numericMagnitude(value);
+    const std::uint64_t high = numericHashMultiply(numericHashReduce(static_cast<std::uint64_t>(magnitude >> 64)), 8);
+    return numericHashSigned(value < 0, numericHashReduce(high + numericHashReduce(static_cast<std::uint64_t>(magnitude))));
+}
+
+// Residue of a double: significand * 2^exponent, read from the bits
+constexpr std::uint64_t numericHashReal(double value)
+{
+    const std::uint64_t bits = std::bit_cast<std::uint64_t>(value);
+    const int field = static_cast<int>((bits >> 52) & 0x7FF);
+    const std::uint64_t fraction = bits & ((std::uint64_t(1) << 52) - 1);
+    const bool negative = (bits >> 63) != 0;
+    if (field == 0x7FF) {
+        return fraction != 0 ? numericHashNaN : negative ? numericHashNegativeInfinity : numericHashInfinity;
+    }
+    const std::uint64_t significand = field == 0 ? fraction : fraction | (std::uint64_t(1) << 52);
+    const int exponent = (field == 0 ? 1 : field) - 1075;
+    return numericHashSigned(negative, numericHashMultiply(numericHashReduce(significand), numericHashPowerOf2(exponent)));
+}
+
+// long double has a 64-bit significand on x86; frexp gives it without depending on the layout
+inline std::uint64_t numericHashReal(long double value)
+{
+    if (std::isnan(value)) {
+        return numericHashNaN;
+    }
+    if (std::isinf(value)) {
+        return value < 0 ? numericHashNegativeInfinity : numericHashInfinity;
+    }
+    int exponent = 0;
+    const long double fraction = std::frexp(std::fabs(value), &exponent);
+    const std::uint64_t significand = static_cast<std::uint64_t>(std::ldexp(fraction, 64));
+    return numericHashSigned(value < 0, numericHashMultiply(numericHashReduce(significand), numericHashPowerOf2(exponent - 64)));
+}
+
+// 10^-scale in the ring, by Fermat: 10^(p - 2) is the inverse of 10
+constexpr std::uint64_t numericHashInversePowerOf10(unsigned scale)
+{
+    std::uint64_t inverse = 1;
+    std::uint64_t base = 10;
+    for (std::uint64_t exponent = numericHashModulus - 2; exponent != 0; exponent >>= 1) {
+        if (exponent & 1) {
+            inverse = numericHashMultiply(inverse, base);
+        }
+        base = numericHashMultiply(base, base);
+    }
+    std::uint64_t result = 1;
+    for (unsigned i = 0; i < scale; ++i) {
+        result = numericHashMultiply(result, inverse);
+    }
+    return result;
+}
+
+// Residue of a value before mixing; complex values and characters are handled by numericHash
+template <typename T>
+constexpr std::uint64_t numericHashResidue(const T& value)
+{
+    if constexpr (std::is_same_v<T, NumericBigInt>) {
+        std::uint64_t residue = 0;
+        const auto limbs = value.limbs();
+        for (std::size_t i = limbs.size(); i-- > 0;) {
+            residue = numericHashReduce(numericHashMultiply(residue, 8) + numericHashReduce(limbs[i]));
+        }
+        return numericHashSigned(value.isNegative(), residue);
+    } else if constexpr (isDecimalValue<T>) {
+        constexpr std::uint64_t inverse = numericHashInversePowerOf10(T::scale);
+        return numericHashMultiply(numericHashWide(value.units), inverse);
+    } else if constexpr (isHalfValue<T>) {
+        return numericHashReal(static_cast<double>(value.toFloat()));
+    } else if constexpr (std::is_same_v<T, long double>) {
+        return numericHashReal(value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return numericHashReal(static_cast<double>(value));
+    } else if constexpr (std::is_signed_v<T>) {
+        const std::uint64_t bits = static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+        return numericHashSigned(value < 0, numericHashReduce(value < 0 ? std::uint64_t(0) - bits : bits));
+    } else {
+        return numericHashReduce(static_cast<std::uint64_t>(value));
+    }
+}
+
+// MurmurHash3's 64-bit finalizer: a bijection, so distinct residues keep distinct hashes
+constexpr std::uint64_t numericHashMix(std::uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+// Hash of a raw value, equal to hash() of the Numeric object that stores it
+template <typename T>
+constexpr std::uint64_t numericHash(const T& value)
+{
+    if constexpr (charTemp<T>) {
+        return numericHashMix(numericHashCharacter | static_cast<std::make_unsigned_t<T>>(value));
+    } else if constexpr (isComplexValue<T>) {
+        const std::uint64_t real = numericHashResidue(value.real());
+        if (value.imag() == 0) {
+            return numericHashMix(real);
+        }
+        return numericHashMix(numericHashReduce(real + numericHashMultiply(numericHashResidue(value.imag()), 1000003)));
+    } else {
+        return numericHashMix(numericHashResidue(value));
+    }
+}
+
+// Same key, for two values of one type: == except that NaNs match each other (and -0.0 matches +0.0)
+template <typename T>
+constexpr bool numericSameValue(const T& first, const T& second)
+{
+    if constexpr (isHalfValue<T>) {
+        return numericSameValue(first.toFloat(), second.toFloat());
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return first == second || (first != first && second != second);
+    } else if constexpr (isComplexValue<T>) {
+        return numericSameValue(first.real(), second.real()) && numericSameValue(first.imag(), second.imag());
+    } else {
+        return first == second;
+    }
+}
+
+// Same key across kinds, in the sense above; exact for every pair of kinds
+bool numericSameValue(const Numeric& first, const Numeric& second);
+
+static_assert(numericHash(3) == numericHash(3.0) && numericHash(3.0f) == numericHash(std::complex<double>(3, 0)));
+static_assert(numericHash(std::int64_t(-7)) == numericHash(NumericDecimal2::fromUnits(-700)));
+static_assert(numericHash(0.5) == numericHash(NumericDecimal6::fromUnits(500000)));
+static_assert(numericHash(-0.0) == numericHash(0u) && numericHash('A') != numericHash(65));
+
+/************************ NumericHashMap Class ********************************/
+
+/**
+ * Open-addressing hash map with linear probing, for the group-by engine and other
+ * hash-based operators.
+ *
+ *     NumericHashMap<std::int64_t, std::size_t> counts;
+ *     for (std::int64_t id : ids) {
+ *         ++counts[id];
+ *     }
+ *
+ * Each slot holds the 64-bit hash next to the key and the value, in one array: a probe
+ * compares hashes before keys, walks consecutive memory, and when it finds the key the
+ * value is in the same cache line. The capacity is a power of two indexed by the low
+ * bits of the hash (partitioned builds use the high bits to pick a partition), and the
+ * table doubles before it is 3/4 full. Slots are never removed.
+ *
+ * Hash and Equal default to numericHash and numericSameValue. The *Hashed members take
+ * a hash computed ahead, which must be the one Hash gives; with them a table can be
+ * keyed by row numbers whose Equal compares the rows. Key and Value must be default
+ * constructible. Pointers to values stay valid until the next insertion.
+ */
+template <typename Key>
+struct NumericHasher
+{
+    std::uint64_t operator()(const Key& key) const { return numericHash(key); }
+};
+
+template <typename Key>
+struct NumericSameValueEqual
+{
+    bool operator()(const Key& first, const Key& second) const { return numericSameValue(first, second); }
+};
+
+template <typename Key, typename Value, typename Hash = NumericHasher<Key>, typename Equal = NumericSameValueEqual<Key>>
+class NumericHashMap
+{
+    public:
+    explicit NumericHashMap(std::size_t expected = 0, Hash hash = Hash(), Equal equal = Equal())
+        : hasher(std::move(hash)), equal(std::move(equal))
+    {
+        reserve(expected);
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::size_t capacity() const { return slots.size(); }
+
+    // Room for `expected` keys without growing
+    void reserve(std::size_t expected)
+    {
+        std::size_t capacity = minCapacity;
+        while (capacity - capacity / 4 < expected) {
+            capacity *= 2;
+        }
+        if (capacity > slots.size()) {
+            rehash(capacity);
+        }
+    }
+
+    void clear()
+    {
+        for (Slot& slot : slots) {
+            slot = Slot();
+        }
+        count = 0;
+    }
+
+    // The value of `key`, default constructed first when the key is new (second = true)
+    std::pair<Value*, bool> insert(const Key& key) { return insertHashed(hasher(key), key); }
+
+    std::pair<Value*, bool> insertHashed(std::uint64_t hash, const Key& key)
+    {
+        if (count + 1 > slots.size() - slots.size() / 4) {
+            rehash(slots.size() * 2);
+        }
+        const std::uint64_t stored = storedHash(hash);
+        const std::size_t mask = slots.size() - 1;
+        for (std::size_t index = stored & mask;; index = (index + 1) & mask) {
+            Slot& slot = slots[index];
+            if (slot.hash == 0) {
+                slot.hash = stored;
+                slot.key = key;
+                ++count;
+                return {&slot.value, true};
+            }
+            if (slot.hash == stored && equal(slot.key, key)) {
+                return {&slot.value, false};
+            }
+        }
+    }
+
+    Value& operator[](const Key& key) { return *insert(key).first; }
+
+    // The value of `key`, or nullptr
+    Value* find(const Key& key) { return findHashed(hasher(key), key); }
+    const Value* find(const Key& key) const { return findHashed(hasher(key), key); }
+
+    Value* findHashed(std::uint64_t hash, const Key& key)
+    {
+        return const_cast<Value*>(std::as_const(*this).findHashed(hash, key));
+    }
+
+    const Value* findHashed(std::uint64_t hash, const Key& key) const
+    {
+        const std::uint64_t stored = storedHash(hash);
+        const std::size_t mask = slots.size() - 1;
+        for (std::size_t index = stored & mask;; index = (index + 1) & mask) {
+            const Slot& slot = slots[index];
+            if (slot.hash == 0) {
+                return nullptr;
+            }
+            if (slot.hash == stored && equal(slot.key, key)) {
+                return &slot.value;
+            }
+        }
+    }
+
+    // body(key, value) for every entry, in slot order
+    template <typename Body>
+    void forEach(const Body& body) const
+    {
+        for (const Slot& slot : slots) {
+            if (slot.hash != 0) {
+                body(slot.key, slot.value);
+            }
+        }
+    }
+
+    template <typename Body>
+    void forEach(const Body& body)
+    {
+        for (Slot& slot : slots) {
+            if (slot.hash != 0) {
+                body(std::as_const(slot.key), slot.value);
+            }
+        }
+    }
+
+    private:
+    static constexpr std::size_t minCapacity = 16;
+
+    struct Slot
+    {
+        std::uint64_t hash = 0;    // 0 marks an empty slot
+        Key key{};
+        Value value{};
+    };
+
+    std::vector<Slot> slots;
+    std::size_t count = 0;
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] Equal equal;
+
+    // Hashes are stored with 0 replaced, so an empty slot needs no separate flag
+    static std::uint64_t storedHash(std::uint64_t hash) { return hash != 0 ? hash : 1; }
+
+    void rehash(std::size_t capacity)
+    {
+        std::vector<Slot> old(capacity);
+        old.swap(slots);
+        const std::size_t mask = capacity - 1;
+        for (Slot& slot : old) {
+            if (slot.hash == 0) {
+                continue;
+            }
+            std::size_t index = slot.hash & mask;
+            while (slots[index].hash != 0) {
+                index = (index + 1) & mask;
+            }
+            slots[index] = std::move(slot);
+        }
+    }
+};
+
+#endif // __NUMERIC_HASH_HPP__
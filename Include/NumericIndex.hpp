@@ -0,0 +1,353 @@
+#ifndef __NUMERIC_INDEX_HPP__
+#define __NUMERIC_INDEX_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+
+/**
+ * Range and point lookups on typed columns, without a comparison per element.
+ *
+ *     NumericZoneMap<double> zones(prices);          // min / max of every block of 4096 rows
+ *     const auto ten = Numeric::create(10);
+ *     const auto twenty = Numeric::create(20.0);
+ *     NumericMask cheap = numericRangeFilter(prices, zones, {ten.get(), twenty.get()});    // 10 < x < 20
+ *
+ *     NumericSortedIndex<double> index(prices);
+ *     for (std::uint32_t row : index.lookup({ten.get(), twenty.get(), true, true})) { ... }  // 10 <= x <= 20
+ *     std::span<const std::uint32_t> tens = index.find(*ten);
+ *
+ * The order is the one lessThanOperation / greaterThanOperation / equalOperation give
+ * on a value of the column's type: a bound of another kind is compared the way
+ * NumericClass<T>(x).lessThanOperation(bound) compares it. An int column is filtered
+ * against double 3.5 as against 3 (the bound converted to int), a decimal or integer
+ * column against a decimal or a BigInt exactly, and complex values are ordered by real
+ * part, then imaginary part. numericBounds turns a NumericRange into that interval of T
+ * once; for integer and decimal columns it finds the first and last values that pass
+ * with a binary search over T, so every kernel rule is followed exactly. Bounds a
+ * lessThanOperation would reject throw its message. NaN (and a complex value with a
+ * NaN part) is in no range.
+ *
+ * NumericZoneMap keeps the smallest and largest value of every block. A filter skips the
+ * blocks that lie outside the range, takes whole the blocks that lie inside it, and runs
+ * the column comparison kernels only on the blocks that straddle a bound, so on sorted or clustered
+ * data (timestamps, ids, anything appended in order) it reads a few blocks. update()
+ * reads only the rows appended since the previous call, refresh() the blocks of rows
+ * written in place.
+ *
+ * NumericSortedIndex is a static B+-tree: the values sorted once, with levels of every
+ * 16th key above them, so a lookup reads a node of 16 keys per level and returns the
+ * matching rows as one span, in value order (equal values by row), in O(log n). It is a
+ * snapshot of the column; rebuild it after the column changes. Row numbers are 32-bit.
+ */
+
+/************************ Bounds ********************************/
+
+// Bounds of any kind; a null bound leaves that side open
+struct NumericRange
+{
+    const Numeric* low = nullptr;
+    const Numeric* high = nullptr;
+    bool lowInclusive = false;
+    bool highInclusive = false;
+};
+
+// lessThanOperation between two values of T: complex numbers by real part, then imaginary part
+template <typename T>
+constexpr bool numericOrderedBefore(const T& first, const T& second)
+{
+    if constexpr (isComplexValue<T>) {
+        return first.real() == second.real() ? first.imag() < second.imag() : first.real() < second.real();
+    } else {
+        return first < second;
+    }
+}
+
+// Values no comparison holds for: NaN, or a complex value with a NaN part
+template <typename T>
+constexpr bool numericUnordered(const T& value)
+{
+    if constexpr (isComplexValue<T>) {
+        return value.real() != value.real() || value.imag() != value.imag();
+    } else {
+        return !(value == value);
+    }
+}
+
+// A range as an interval of T
+template <typename T>
+struct NumericBounds
+{
+    // Not an aggregate, so that {low, high, ...} picks the NumericRange overloads
+    NumericBounds() = default;
+
+    bool empty = false;         // no value of T passes
+    bool hasLow = false;
+    bool hasHigh = false;
+    bool lowInclusive = false;
+    bool highInclusive = false;
+    T low{};
+    T high{};
+
+    bool aboveLow(const T& value) const
+    {
+        return !hasLow || numericOrderedBefore(low, value) || (lowInclusive && value == low);
+    }
+    bool belowHigh(const T& value) const
+    {
+        return !hasHigh || numericOrderedBefore(value, high) || (highInclusive && value == high);
+    }
+    bool contains(const T& value) const
+    {
+        return !empty && !numericUnordered(value) && aboveLow(value) && belowHigh(value);
+    }
+};
+
+template <typename T>
+NumericBounds<T> numericBounds(const NumericRange& range);
+
+/************************ NumericZoneMap Class ********************************/
+
+template <typename T>
+class NumericZoneMap
+{
+    public:
+    struct Zone
+    {
+        T min{};
+        T max{};
+        std::size_t ordered = 0;    // values other than NaN; min and max are set when non-zero
+    };
+
+    static constexpr std::size_t defaultBlockSize = 4096;
+
+    // blockSize is rounded up to a multiple of 64, so blocks start on a NumericMask word
+    explicit NumericZoneMap(std::size_t blockSize = defaultBlockSize) : rowsPerBlock((std::max<std::size_t>(blockSize, 1) + 63) / 64 * 64) {}
+    explicit NumericZoneMap(const NumericColumn<T>& column, std::size_t blockSize = defaultBlockSize) : NumericZoneMap(blockSize)
+    {
+        update(column);
+    }
+
+    std::size_t blockSize() const { return rowsPerBlock; }
+    std::size_t blockCount() const { return zones.size(); }
+    std::size_t rowCount() const { return rows; }
+    const Zone& zone(std::size_t block) const { return zones[block]; }
+
+    // Catches up with `column`: reads the rows appended since the last call (and recomputes the last block if it shrank)
+    void update(const NumericColumn<T>& column)
+    {
+        if (column.size() < rows) {
+            zones.resize(column.size() / rowsPerBlock);
+            rows = zones.size() * rowsPerBlock;
+        }
+        const T* data = column.data();
+        while (rows < column.size()) {
+            if (rows % rowsPerBlock == 0) {
+                zones.emplace_back();
+            }
+            const std::size_t end = std::min(column.size(), (rows / rowsPerBlock + 1) * rowsPerBlock);
+            Zone& zone = zones.back();
+            for (; rows < end; ++rows) {
+                add(zone, data[rows]);
+            }
+        }
+    }
+
+    // Re-reads the blocks of rows [first, last) after they were written in place, then catches up
+    void refresh(const NumericColumn<T>& column, std::size_t first, std::size_t last)
+    {
+        last = std::min({last, rows, column.size()});
+        const T* data = column.data();
+        for (std::size_t block = first / rowsPerBlock; first < last && block <= (last - 1) / rowsPerBlock; ++block) {
+            Zone& zone = zones[block] = Zone();
+            const std::size_t end = std::min(rows, (block + 1) * rowsPerBlock);
+            for (std::size_t row = block * rowsPerBlock; row < end; ++row) {
+                add(zone, data[row]);
+            }
+        }
+        update(column);
+    }
+
+    private:
+    std::size_t rowsPerBlock;
+    std::size_t rows = 0;
+    std::vector<Zone> zones;
+
+    static void add(Zone& zone, const T& value)
+    {
+        if (numericUnordered(value)) {
+            return;
+        }
+        if (zone.ordered++ == 0) {
+            zone.min = value;
+            zone.max = value;
+        } else if (numericOrderedBefore(value, zone.min)) {
+            zone.min = value;
+        } else if (numericOrderedBefore(zone.max, value)) {
+            zone.max = value;
+        }
+    }
+};
+
+// Rows of `column` in range; `zones` must be up to date with it
+template <typename T>
+NumericMask numericRangeFilter(const NumericColumn<T>& column, const NumericZoneMap<T>& zones, const NumericBounds<T>& bounds)
+{
+    if (zones.rowCount() != column.size()) {
+        throw std::runtime_error("numericRangeFilter: Zone map is out of date.");
+    }
+    NumericMask mask(column.size());
+    std::uint64_t* words = mask.words();
+    const T* data = column.data();
+    std::vector<std::uint64_t> below(zones.blockSize() / 64);
+    for (std::size_t block = 0; block < zones.blockCount() && !bounds.empty; ++block) {
+        const auto& zone = zones.zone(block);
+        const std::size_t first = block * zones.blockSize();
+        const std::size_t last = std::min(column.size(), first + zones.blockSize());
+        if (zone.ordered == 0 || !bounds.aboveLow(zone.max) || !bounds.belowHigh(zone.min)) {
+            continue;
+        }
+        if (zone.ordered == last - first && bounds.aboveLow(zone.min) && bounds.belowHigh(zone.max)) {
+            std::fill(words + first / 64, words + last / 64, ~std::uint64_t(0));
+            if (last % 64 != 0) {
+                words[last / 64] = (std::uint64_t(1) << (last % 64)) - 1;
+            }
+            continue;
+        }
+        // A block across a bound: one column comparison kernel per test, the low side into the mask, the high side ANDed in
+        std::uint64_t* blockWords = words + first / 64;
+        if (bounds.hasLow) {
+            columnCompare<T>(NumericOp::GreaterThan, data + first, &bounds.low, true, blockWords, last - first);
+            if (bounds.lowInclusive) {
+                columnCompare<T>(NumericOp::Equal, data + first, &bounds.low, true, blockWords, last - first);
+            }
+        } else {
+            columnCompare<T>(NumericOp::Equal, data + first, data + first, false, blockWords, last - first);
+        }
+        if (bounds.hasHigh) {
+            std::fill(below.begin(), below.end(), 0);
+            columnCompare<T>(NumericOp::LessThan, data + first, &bounds.high, true, below.data(), last - first);
+            if (bounds.highInclusive) {
+                columnCompare<T>(NumericOp::Equal, data + first, &bounds.high, true, below.data(), last - first);
+            }
+            for (std::size_t w = 0; w < (last - first + 63) / 64; ++w) {
+                blockWords[w] &= below[w];
+            }
+        }
+    }
+    return mask;
+}
+
+template <typename T>
+NumericMask numericRangeFilter(const NumericColumn<T>& column, const NumericZoneMap<T>& zones, const NumericRange& range)
+{
+    return numericRangeFilter(column, zones, numericBounds<T>(range));
+}
+
+/************************ NumericSortedIndex Class ********************************/
+
+template <typename T>
+class NumericSortedIndex
+{
+    public:
+    static constexpr std::size_t nodeSize = 16;
+
+    NumericSortedIndex() = default;
+
+    explicit NumericSortedIndex(const NumericColumn<T>& column)
+    {
+        if (column.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::runtime_error("NumericSortedIndex: Too many rows.");
+        }
+        std::vector<std::pair<T, std::uint32_t>> entries;
+        entries.reserve(column.size());
+        for (std::size_t row = 0; row < column.size(); ++row) {
+            if (!numericUnordered(column[row])) {
+                entries.emplace_back(column[row], static_cast<std::uint32_t>(row));
+            }
+        }
+        std::sort(entries.begin(), entries.end(), [](const auto& first, const auto& second) {
+            return numericOrderedBefore(first.first, second.first) ||
+                   (!numericOrderedBefore(second.first, first.first) && first.second < second.second);
+        });
+        keys.reserve(entries.size());
+        rows.reserve(entries.size());
+        for (const auto& [key, row] : entries) {
+            keys.push_back(key);
+            rows.push_back(row);
+        }
+        // levels[l][j] = keys[j * nodeSize^(l + 1)], up to a level that fits in one node
+        for (const std::vector<T>* below = &keys; below->size() > nodeSize; below = &levels.back()) {
+            std::vector<T> level;
+            level.reserve((below->size() + nodeSize - 1) / nodeSize);
+            for (std::size_t j = 0; j < below->size(); j += nodeSize) {
+                level.push_back((*below)[j]);
+            }
+            levels.push_back(std::move(level));
+        }
+    }
+
+    // Rows with an ordered value (every row but the NaNs)
+    std::size_t size() const { return rows.size(); }
+
+    // Rows in range, in value order
+    std::span<const std::uint32_t> lookup(const NumericBounds<T>& bounds) const
+    {
+        if (bounds.empty) {
+            return {};
+        }
+        const std::size_t first = bounds.hasLow ? partitionPoint([&](const T& key) { return bounds.aboveLow(key); }) : 0;
+        const std::size_t last = bounds.hasHigh ? partitionPoint([&](const T& key) { return !bounds.belowHigh(key); }) : keys.size();
+        return first < last ? std::span<const std::uint32_t>(rows.data() + first, last - first) : std::span<const std::uint32_t>();
+    }
+
+    std::span<const std::uint32_t> lookup(const NumericRange& range) const { return lookup(numericBounds<T>(range)); }
+
+    // Rows equalOperation finds equal to `value`
+    std::span<const std::uint32_t> find(const Numeric& value) const { return lookup(NumericRange{&value, &value, true, true}); }
+
+    private:
+    std::vector<T> keys;                    // ordered values, ascending
+    std::vector<std::uint32_t> rows;        // row of each key
+    std::vector<std::vector<T>> levels;
+
+    // First key that passes, for a test that fails on a prefix of the keys and passes on the rest
+    template <typename Pass>
+    std::size_t partitionPoint(const Pass& pass) const
+    {
+        std::size_t first = 0;
+        std::size_t last = keys.size();
+        std::size_t stride = 1;
+        for (std::size_t l = 0; l < levels.size(); ++l) {
+            stride *= nodeSize;
+        }
+        // The answer is in [first, last]; each level narrows it to one node of the level below
+        for (std::size_t l = levels.size(); l-- > 0; stride /= nodeSize) {
+            const std::vector<T>& level = levels[l];
+            const std::size_t start = first / stride;
+            const std::size_t end = std::min(level.size(), (last + stride - 1) / stride);
+            std::size_t j = start;
+            while (j < end && !pass(level[j])) {
+                ++j;
+            }
+            if (j > start) {
+                first = std::max(first, (j - 1) * stride + 1);
+            }
+            last = std::min(last, j * stride);
+        }
+        while (first < last && !pass(keys[first])) {
+            ++first;
+        }
+        return first;
+    }
+};
+
+#endif // __NUMERIC_INDEX_HPP__
@@ -0,0 +1,890 @@
+#ifndef __NUMERIC_KERNELS_HPP__
+#define __NUMERIC_KERNELS_HPP__
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "NumericBigInt.hpp"
+#include "NumericDecimal.hpp"
+#include "NumericHalf.hpp"
+
+/**
+ * Value-level kernels behind the Numeric class hierarchy.
+ *
+ * Every Numeric object carries a NumericKind tag. The mixed-type rules that used to
+ * live in the dynamic_cast / typeid ladders of each class are expressed here once,
+ * on plain values, so a (lhs kind, rhs kind, op) triple can be resolved at compile
+ * time and jumped to from a table without throwing, RTTI or a convertTo temporary.
+ *
+ * Nothing in this file throws: failures are reported as NumericError and turned into
+ * the usual std::runtime_error by the Numeric layer. Only the BigInt kind allocates
+ * (for values beyond 128 bits).
+ */
+
+enum class NumericKind : std::uint8_t
+{
+    Int,
+    Float,
+    Double,
+    LongDouble,
+    ComplexFloat,
+    ComplexDouble,
+    ComplexLongDouble,
+    Char,
+    WChar,
+    Char16,
+    Char32,
+    Int8,
+    Int16,
+    Int64,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64,
+    BigInt,
+    Decimal2,
+    Decimal6,
+    Decimal18,
+    Float16,
+    BFloat16,
+    Count
+};
+
+constexpr std::size_t numericKindCount = static_cast<std::size_t>(NumericKind::Count);
+
+enum class NumericOp : std::uint8_t
+{
+    Sum,
+    Subtract,
+    Multiply,
+    Divide,
+    LessThan,
+    GreaterThan,
+    Equal,
+    Count
+};
+
+constexpr std::size_t numericOpCount = static_cast<std::size_t>(NumericOp::Count);
+constexpr std::size_t numericArithmeticOpCount = 4; // Sum, Subtract, Multiply, Divide
+
+enum class NumericError : std::uint8_t
+{
+    None,
+    DivisionByZero,           // "divideOperation: Division by zero is not allowed."
+    UnsupportedType,          // IntNumeric with an operand it has no rule for
+    UnsupportedConversion,    // the operand cannot be converted to the receiver's type
+    UnsupportedCharOperation, // multiply/divide on charNumeric
+    Overflow                  // integer or decimal result out of range under NumericOverflow::Checked
+};
+
+// What an integer or decimal operation does when the exact result does not fit its type
+enum class NumericOverflow : std::uint8_t
+{
+    Checked,    // fail with NumericError::Overflow (the default)
+    Saturate,   // clamp to the nearest representable value
+    Wrap        // keep the low N bits, two's complement
+};
+
+// Policy of the current thread, set with NumericOverflowScope (Numeric.hpp)
+NumericOverflow numericOverflowMode();
+
+// Name of the Numeric method implementing `op`, used in messages and reports
+constexpr const char* numericOpName(NumericOp op)
+{
+    switch (op) {
+        case NumericOp::Sum:         return "sumOperation";
+        case NumericOp::Subtract:    return "subtractOperation";
+        case NumericOp::Multiply:    return "multiplyOperation";
+        case NumericOp::Divide:      return "divideOperation";
+        case NumericOp::LessThan:    return "lessThanOperation";
+        case NumericOp::GreaterThan: return "greaterThanOperation";
+        case NumericOp::Equal:       return "equalOperation";
+        default:                     return "unknownOperation";
+    }
+}
+
+// Message of the std::runtime_error the Numeric classes throw for a given failure
+constexpr const char* numericErrorMessage(NumericOp op, NumericError error)
+{
+    switch (error) {
+        case NumericError::None:
+            return "";
+        case NumericError::DivisionByZero:
+            return "divideOperation: Division by zero is not allowed.";
+        case NumericError::UnsupportedType:
+            switch (op) {
+                case NumericOp::Sum:      return "Unsupported type for addition.";
+                case NumericOp::Subtract: return "Unsupported type for subtraction.";
+                case NumericOp::Multiply: return "Unsupported type for multiplication.";
+                default:                  return "Unsupported type for division.";
+            }
+        case NumericError::UnsupportedConversion:
+            return "Unsupported conversion";
+        case NumericError::UnsupportedCharOperation:
+            return (op == NumericOp::Multiply) ? "multiplyOperation: Operation not supported for characters."
+                                               : "divideOperation: Operation not supported for characters.";
+        case NumericError::Overflow:
+            switch (op) {
+                case NumericOp::Sum:      return "sumOperation: Integer overflow.";
+                case NumericOp::Subtract: return "subtractOperation: Integer overflow.";
+                case NumericOp::Multiply: return "multiplyOperation: Integer overflow.";
+                default:                  return "divideOperation: Integer overflow.";
+            }
+    }
+    return "";
+}
+
+/************************ Kind <-> value type ********************************/
+
+template <NumericKind K> struct NumericKindTraits;
+template <> struct NumericKindTraits<NumericKind::Int>               { using value_type = int; };
+template <> struct NumericKindTraits<NumericKind::Float>             { using value_type = float; };
+template <> struct NumericKindTraits<NumericKind::Double>            { using value_type = double; };
+template <> struct NumericKindTraits<NumericKind::LongDouble>        { using value_type = long double; };
+template <> struct NumericKindTraits<NumericKind::ComplexFloat>      { using value_type = std::complex<float>; };
+template <> struct NumericKindTraits<NumericKind::ComplexDouble>     { using value_type = std::complex<double>; };
+template <> struct NumericKindTraits<NumericKind::ComplexLongDouble> { using value_type = std::complex<long double>; };
+template <> struct NumericKindTraits<NumericKind::Char>              { using value_type = char; };
+template <> struct NumericKindTraits<NumericKind::WChar>             { using value_type = wchar_t; };
+template <> struct NumericKindTraits<NumericKind::Char16>            { using value_type = char16_t; };
+template <> struct NumericKindTraits<NumericKind::Char32>            { using value_type = char32_t; };
+template <> struct NumericKindTraits<NumericKind::Int8>              { using value_type = std::int8_t; };
+template <> struct NumericKindTraits<NumericKind::Int16>             { using value_type = std::int16_t; };
+template <> struct NumericKindTraits<NumericKind::Int64>             { using value_type = std::int64_t; };
+template <> struct NumericKindTraits<NumericKind::UInt8>             { using value_type = std::uint8_t; };
+template <> struct NumericKindTraits<NumericKind::UInt16>            { using value_type = std::uint16_t; };
+template <> struct NumericKindTraits<NumericKind::UInt32>            { using value_type = std::uint32_t; };
+template <> struct NumericKindTraits<NumericKind::UInt64>            { using value_type = std::uint64_t; };
+template <> struct NumericKindTraits<NumericKind::BigInt>            { using value_type = NumericBigInt; };
+template <> struct NumericKindTraits<NumericKind::Decimal2>          { using value_type = NumericDecimal2; };
+template <> struct NumericKindTraits<NumericKind::Decimal6>          { using value_type = NumericDecimal6; };
+template <> struct NumericKindTraits<NumericKind::Decimal18>         { using value_type = NumericDecimal18; };
+template <> struct NumericKindTraits<NumericKind::Float16>           { using value_type = NumericFloat16; };
+template <> struct NumericKindTraits<NumericKind::BFloat16>          { using value_type = NumericBFloat16; };
+
+template <NumericKind K>
+using NumericKindValue = typename NumericKindTraits<K>::value_type;
+
+// Kind stored by the class that holds a value of type V (IntNumeric holds int, charNumeric<char> holds char, ...)
+template <typename V> inline constexpr NumericKind numericKindOf = NumericKind::Count;
+template <> inline constexpr NumericKind numericKindOf<int>                       = NumericKind::Int;
+template <> inline constexpr NumericKind numericKindOf<float>                     = NumericKind::Float;
+template <> inline constexpr NumericKind numericKindOf<double>                    = NumericKind::Double;
+template <> inline constexpr NumericKind numericKindOf<long double>               = NumericKind::LongDouble;
+template <> inline constexpr NumericKind numericKindOf<std::complex<float>>       = NumericKind::ComplexFloat;
+template <> inline constexpr NumericKind numericKindOf<std::complex<double>>      = NumericKind::ComplexDouble;
+template <> inline constexpr NumericKind numericKindOf<std::complex<long double>> = NumericKind::ComplexLongDouble;
+template <> inline constexpr NumericKind numericKindOf<char>                      = NumericKind::Char;
+template <> inline constexpr NumericKind numericKindOf<wchar_t>                   = NumericKind::WChar;
+template <> inline constexpr NumericKind numericKindOf<char16_t>                  = NumericKind::Char16;
+template <> inline constexpr NumericKind numericKindOf<char32_t>                  = NumericKind::Char32;
+template <> inline constexpr NumericKind numericKindOf<std::int8_t>               = NumericKind::Int8;
+template <> inline constexpr NumericKind numericKindOf<std::int16_t>              = NumericKind::Int16;
+template <> inline constexpr NumericKind numericKindOf<std::int64_t>              = NumericKind::Int64;
+template <> inline constexpr NumericKind numericKindOf<std::uint8_t>              = NumericKind::UInt8;
+template <> inline constexpr NumericKind numericKindOf<std::uint16_t>             = NumericKind::UInt16;
+template <> inline constexpr NumericKind numericKindOf<std::uint32_t>             = NumericKind::UInt32;
+template <> inline constexpr NumericKind numericKindOf<std::uint64_t>             = NumericKind::UInt64;
+template <> inline constexpr NumericKind numericKindOf<NumericBigInt>             = NumericKind::BigInt;
+template <> inline constexpr NumericKind numericKindOf<NumericDecimal2>           = NumericKind::Decimal2;
+template <> inline constexpr NumericKind numericKindOf<NumericDecimal6>           = NumericKind::Decimal6;
+template <> inline constexpr NumericKind numericKindOf<NumericDecimal18>          = NumericKind::Decimal18;
+template <> inline constexpr NumericKind numericKindOf<NumericFloat16>            = NumericKind::Float16;
+template <> inline constexpr NumericKind numericKindOf<NumericBFloat16>           = NumericKind::BFloat16;
+
+// Type IntegerNumeric stores for an integral T: same size and signedness (int stays int, long long -> int64)
+template <typename T>
+using NumericIntegerType = std::conditional_t<std::is_signed_v<T>,
+    std::conditional_t<sizeof(T) == 1, std::int8_t, std::conditional_t<sizeof(T) == 2, std::int16_t, std::conditional_t<sizeof(T) == 4, int, std::int64_t>>>,
+    std::conditional_t<sizeof(T) == 1, std::uint8_t, std::conditional_t<sizeof(T) == 2, std::uint16_t, std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>>;
+
+constexpr const char* numericKindName(NumericKind kind)
+{
+    switch (kind) {
+        case NumericKind::Int:               return "int";
+        case NumericKind::Float:             return "float";
+        case NumericKind::Double:            return "double";
+        case NumericKind::LongDouble:        return "long double";
+        case NumericKind::ComplexFloat:      return "complex<float>";
+        case NumericKind::ComplexDouble:     return "complex<double>";
+        case NumericKind::ComplexLongDouble: return "complex<long double>";
+        case NumericKind::Char:              return "char";
+        case NumericKind::WChar:             return "wchar_t";
+        case NumericKind::Char16:            return "char16_t";
+        case NumericKind::Char32:            return "char32_t";
+        case NumericKind::Int8:              return "int8";
+        case NumericKind::Int16:             return "int16";
+        case NumericKind::Int64:             return "int64";
+        case NumericKind::UInt8:             return "uint8";
+        case NumericKind::UInt16:            return "uint16";
+        case NumericKind::UInt32:            return "uint32";
+        case NumericKind::UInt64:            return "uint64";
+        case NumericKind::BigInt:            return "bigint";
+        case NumericKind::Decimal2:          return "decimal2";
+        case NumericKind::Decimal6:          return "decimal6";
+        case NumericKind::Decimal18:         return "decimal18";
+        case NumericKind::Float16:           return "float16";
+        case NumericKind::BFloat16:          return "bfloat16";
+        default:                             return "unknown";
+    }
+}
+
+// FloatNumeric<T>, including the 16-bit storage kinds
+constexpr bool isFloatKind(NumericKind kind)
+{
+    return kind == NumericKind::Float || kind == NumericKind::Double || kind == NumericKind::LongDouble ||
+           kind == NumericKind::Float16 || kind == NumericKind::BFloat16;
+}
+
+// FloatNumeric<NumericFloat16> and FloatNumeric<NumericBFloat16>, which compute in float
+constexpr bool isHalfKind(NumericKind kind)
+{
+    return kind == NumericKind::Float16 || kind == NumericKind::BFloat16;
+}
+
+constexpr bool isComplexKind(NumericKind kind)
+{
+    return kind == NumericKind::ComplexFloat || kind == NumericKind::ComplexDouble || kind == NumericKind::ComplexLongDouble;
+}
+
+constexpr bool isCharKind(NumericKind kind)
+{
+    return kind == NumericKind::Char || kind == NumericKind::WChar || kind == NumericKind::Char16 || kind == NumericKind::Char32;
+}
+
+// IntegerNumeric<T>: int and the fixed-width signed / unsigned kinds (not the characters)
+constexpr bool isIntegerKind(NumericKind kind)
+{
+    return kind == NumericKind::Int || (kind >= NumericKind::Int8 && kind <= NumericKind::UInt64);
+}
+
+constexpr bool isUnsignedKind(NumericKind kind)
+{
+    return kind >= NumericKind::UInt8 && kind <= NumericKind::UInt64;
+}
+
+// DecimalNumeric<Scale, Rep>, in order of increasing scale
+constexpr bool isDecimalKind(NumericKind kind)
+{
+    return kind >= NumericKind::Decimal2 && kind <= NumericKind::Decimal18;
+}
+
+// Result kinds whose out-of-range results follow the thread's NumericOverflow policy
+constexpr bool hasOverflowPolicy(NumericKind kind)
+{
+    return isIntegerKind(kind) || isDecimalKind(kind);
+}
+
+// Bytes of an integer kind
+constexpr std::size_t integerKindWidth(NumericKind kind)
+{
+    switch (kind) {
+        case NumericKind::Int8:
+        case NumericKind::UInt8:  return 1;
+        case NumericKind::Int16:
+        case NumericKind::UInt16: return 2;
+        case NumericKind::Int64:
+        case NumericKind::UInt64: return 8;
+        default:                  return 4;
+    }
+}
+
+// FloatNumeric<T> -> ComplexNumeric<T>
+constexpr NumericKind complexKindOf(NumericKind floatKind)
+{
+    switch (floatKind) {
+        case NumericKind::Float:      return NumericKind::ComplexFloat;
+        case NumericKind::Double:     return NumericKind::ComplexDouble;
+        case NumericKind::LongDouble: return NumericKind::ComplexLongDouble;
+        default:                      return NumericKind::Count;
+    }
+}
+
+/************************ Conversions ********************************/
+
+/**
+ * Mirrors what convertTo() has always accepted: everything converts to the integer
+ * kinds, BigIntNumeric, FloatNumeric<float>, FloatNumeric<double> and the 16-bit float
+ * kinds; everything but characters converts to ComplexNumeric<float> and
+ * ComplexNumeric<double>; nothing converts to a character or to the long double kinds.
+ * The decimal kinds take every kind but BigInt, and do not convert to BigInt either.
+ */
+constexpr bool isConvertible(NumericKind from, NumericKind to)
+{
+    if (isDecimalKind(to) || to == NumericKind::BigInt) {
+        return isDecimalKind(to) ? from != NumericKind::BigInt : !isDecimalKind(from);
+    }
+    if (isIntegerKind(to) || to == NumericKind::Float || to == NumericKind::Double || isHalfKind(to)) {
+        return true;
+    }
+    if (to == NumericKind::ComplexFloat || to == NumericKind::ComplexDouble) {
+        return !isCharKind(from);
+    }
+    return false;
+}
+
+template <typename V>
+inline constexpr bool isComplexValue = false;
+template <typename T>
+inline constexpr bool isComplexValue<std::complex<T>> = true;
+
+template <typename V>
+inline constexpr bool isDecimalValue = false;
+template <unsigned Scale, typename Rep>
+inline constexpr bool isDecimalValue<NumericDecimal<Scale, Rep>> = true;
+
+template <typename V>
+inline constexpr bool isHalfValue = false;
+template <unsigned ExponentBits, unsigned FractionBits>
+inline constexpr bool isHalfValue<NumericHalfFloat<ExponentBits, FractionBits>> = true;
+
+// A decimal or BigInt rounded to a 16-bit float once, from its exact magnitude
+template <typename Target, typename From>
+Target numericHalfFromExact(const From& value)
+{
+    std::uint64_t significand = 0;
+    int exponent = 0;
+    bool negative = false;
+    if constexpr (std::is_same_v<From, NumericBigInt>) {
+        if (value.isZero()) {
+            return Target();
+        }
+        significand = value.topBits();
+        exponent = static_cast<int>(std::min<std::size_t>(value.bitLength() - 1, 1 << 20));
+        negative = value.isNegative();
+    } else {
+        if (value.units == 0) {
+            return Target();
+        }
+        negative = value.units < 0;
+        const NumericUInt128 units = static_cast<NumericUInt128>(static_cast<NumericInt128>(value.units));
+        exponent = numericScaleBinary(negative ? NumericUInt128(0) - units : units, From::scale, significand);
+    }
+    return Target::fromBits(numericHalfRound<Target::exponentBits, Target::fractionBits>(negative ? 0x8000 : 0, exponent, significand));
+}
+
+// Value conversion with exactly the casts convertTo() performs (complex -> real part, char -> via int)
+template <NumericKind To, typename From>
+constexpr NumericKindValue<To> convertValue(const From& value)
+{
+    using Target = NumericKindValue<To>;
+
+    if constexpr (isHalfValue<From> && !std::is_same_v<From, Target>) {
+        // A 16-bit float converts like the float that holds it exactly
+        return convertValue<To>(value.toFloat());
+    } else if constexpr (isIntegerKind(To) || To == NumericKind::BigInt) {
+        if constexpr (isComplexValue<From>) {
+            return static_cast<Target>(value.real());
+        } else {
+            return static_cast<Target>(value);
+        }
+    } else if constexpr (isFloatKind(To)) {
+        if constexpr (isComplexValue<From>) {
+            return static_cast<Target>(value.real());
+        } else if constexpr (isCharKind(numericKindOf<From>)) {
+            return static_cast<Target>(static_cast<int>(value));
+        } else if constexpr (isHalfKind(To) && (isDecimalValue<From> || std::is_same_v<From, NumericBigInt>)) {
+            return numericHalfFromExact<Target>(value);
+        } else if constexpr (isHalfKind(To) && !std::is_arithmetic_v<From>) {
+            return Target(static_cast<double>(value));
+        } else {
+            return static_cast<Target>(value);
+        }
+    } else if constexpr (isDecimalKind(To)) {
+        if constexpr (isComplexValue<From>) {
+            return Target(value.real());
+        } else if constexpr (isCharKind(numericKindOf<From>)) {
+            return Target(static_cast<int>(value));
+        } else {
+            return Target(value);
+        }
+    } else if constexpr (isComplexKind(To)) {
+        using Part = typename Target::value_type;
+        if constexpr (isComplexValue<From>) {
+            return Target(static_cast<Part>(value.real()), static_cast<Part>(value.imag()));
+        } else {
+            return Target(static_cast<Part>(value), 0);
+        }
+    } else {
+        return static_cast<Target>(value);
+    }
+}
+
+/************************ Arithmetic ********************************/
+
+struct NumericRule
+{
+    NumericKind result;   // kind of the produced value (meaningful only when error == None)
+    NumericError error;   // error known from the operand kinds alone
+};
+
+// Kinds an integer, BigInt or decimal operand promotes to when it meets them
+constexpr bool isIntegerPromotionKind(NumericKind kind)
+{
+    return kind == NumericKind::Float || kind == NumericKind::Double || isHalfKind(kind) ||
+           kind == NumericKind::ComplexFloat || kind == NumericKind::ComplexDouble;
+}
+
+/**
+ * Result kind of (lhs op rhs), following the rules of the receiver's class:
+ *  - IntegerNumeric<T>: integer op integer -> the wider of the two, the unsigned one at
+ *                       equal width (the usual arithmetic conversions, without the
+ *                       promotion of small types to int); integer op float/double/
+ *                       float16/bfloat16 -> that float, integer op complex -> that
+ *                       complex
+ *  - BigIntNumeric:     like an integer wider than all the others, so integer op
+ *                       BigInt -> BigInt (from either side), computed exactly
+ *  - DecimalNumeric:    decimal op decimal -> the one with more fraction digits,
+ *                       integer op decimal -> the decimal (from either side); with
+ *                       float/double/complex like an integer; BigInt is rejected
+ *  - FloatNumeric<T>:   T op complex<T> -> complex<T>, anything else is converted to T
+ *                       (float16 and bfloat16 have no complex counterpart)
+ *  - ComplexNumeric<T>: the operand is converted to complex<T>
+ *  - charNumeric<T>:    only + and - with the same character type
+ */
+constexpr NumericRule arithmeticRule(NumericKind lhs, NumericKind rhs, NumericOp op)
+{
+    if (lhs == NumericKind::BigInt || (isIntegerKind(lhs) && rhs == NumericKind::BigInt)) {
+        if (isIntegerKind(rhs) || rhs == NumericKind::BigInt) {
+            return {NumericKind::BigInt, NumericError::None};
+        }
+        if (isIntegerPromotionKind(rhs)) {
+            return {rhs, NumericError::None};
+        }
+        return {lhs, NumericError::UnsupportedType};
+    }
+    if (isDecimalKind(lhs) || (isIntegerKind(lhs) && isDecimalKind(rhs))) {
+        if (isDecimalKind(rhs) || isIntegerKind(rhs)) {
+            // Decimal kinds are declared in order of scale
+            const NumericKind result = !isDecimalKind(rhs) ? lhs : (!isDecimalKind(lhs) || rhs > lhs ? rhs : lhs);
+            return {result, NumericError::None};
+        }
+        if (isIntegerPromotionKind(rhs)) {
+            return {rhs, NumericError::None};
+        }
+        return {lhs, NumericError::UnsupportedType};
+    }
+    if (isIntegerKind(lhs)) {
+        if (isIntegerKind(rhs)) {
+            const std::size_t lhsWidth = integerKindWidth(lhs);
+            const std::size_t rhsWidth = integerKindWidth(rhs);
+            if (lhsWidth != rhsWidth) {
+                return {lhsWidth > rhsWidth ? lhs : rhs, NumericError::None};
+            }
+            return {isUnsignedKind(rhs) ? rhs : lhs, NumericError::None};
+        }
+        if (isIntegerPromotionKind(rhs)) {
+            return {rhs, NumericError::None};
+        }
+        return {lhs, NumericError::UnsupportedType};
+    }
+    if (isFloatKind(lhs)) {
+        if (rhs == lhs) {
+            return {lhs, NumericError::None};
+        }
+        if (rhs == complexKindOf(lhs)) {
+            return {rhs, NumericError::None};
+        }
+        return {lhs, isConvertible(rhs, lhs) ? NumericError::None : NumericError::UnsupportedConversion};
+    }
+    if (isComplexKind(lhs)) {
+        if (rhs == lhs) {
+            return {lhs, NumericError::None};
+        }
+        return {lhs, isConvertible(rhs, lhs) ? NumericError::None : NumericError::UnsupportedConversion};
+    }
+    // characters
+    if (op == NumericOp::Multiply || op == NumericOp::Divide) {
+        return {lhs, NumericError::UnsupportedCharOperation};
+    }
+    return {lhs, rhs == lhs ? NumericError::None : NumericError::UnsupportedConversion};
+}
+
+// |divisor| == 0 exactly when both parts are zero; comparing the parts also works in constant expressions
+template <typename V>
+constexpr bool isZeroDivisor(const V& divisor)
+{
+    if constexpr (isComplexValue<V>) {
+        return divisor.real() == 0 && divisor.imag() == 0;
+    } else if constexpr (isDecimalValue<V>) {
+        return divisor.units == 0;
+    } else if constexpr (isHalfValue<V>) {
+        return (divisor.bits & 0x7FFF) == 0;
+    } else {
+        return divisor == 0;
+    }
+}
+
+// Value a saturating a op b takes when the exact result is out of range
+template <NumericOp Op, typename T>
+constexpr T integerSaturated(T a, T b)
+{
+    using Limits = std::numeric_limits<T>;
+
+    if constexpr (std::is_unsigned_v<T>) {
+        return (Op == NumericOp::Subtract) ? Limits::min() : Limits::max();
+    } else if constexpr (Op == NumericOp::Sum) {
+        return (b < 0) ? Limits::min() : Limits::max();
+    } else if constexpr (Op == NumericOp::Subtract) {
+        return (b < 0) ? Limits::max() : Limits::min();
+    } else if constexpr (Op == NumericOp::Multiply) {
+        return ((a < 0) != (b < 0)) ? Limits::min() : Limits::max();
+    } else {
+        return Limits::max();   // MIN / -1
+    }
+}
+
+/**
+ * a op b on one integer type. The __builtin_*_overflow calls compute the exact result,
+ * store its low bits and report whether it fit; the policy only matters when it did not.
+ * A zero divisor is DivisionByZero under every policy.
+ */
+template <NumericOp Op, typename T>
+constexpr NumericError integerArithmetic(T a, T b, T& result, NumericOverflow overflow)
+{
+    bool overflowed = false;
+    if constexpr (Op == NumericOp::Sum) {
+        overflowed = __builtin_add_overflow(a, b, &result);
+    } else if constexpr (Op == NumericOp::Subtract) {
+        overflowed = __builtin_sub_overflow(a, b, &result);
+    } else if constexpr (Op == NumericOp::Multiply) {
+        overflowed = __builtin_mul_overflow(a, b, &result);
+    } else {
+        if (b == 0) {
+            return NumericError::DivisionByZero;
+        }
+        if constexpr (std::is_signed_v<T>) {
+            overflowed = (a == std::numeric_limits<T>::min() && b == -1);
+            result = overflowed ? a : static_cast<T>(a / b);
+        } else {
+            result = static_cast<T>(a / b);
+        }
+    }
+
+    if (!overflowed) [[likely]] {
+        return NumericError::None;
+    }
+    switch (overflow) {
+        case NumericOverflow::Wrap:
+            return NumericError::None;
+        case NumericOverflow::Saturate:
+            result = integerSaturated<Op>(a, b);
+            return NumericError::None;
+        default:
+            return NumericError::Overflow;
+    }
+}
+
+/**
+ * a op b for a signed and an unsigned operand with an unsigned result T. Converting the
+ * signed operand to T first would turn -1 + 5u into an overflow, so the exact result is
+ * computed in 128 bits (it always fits) and range-checked against T instead.
+ */
+template <NumericOp Op, typename T>
+constexpr NumericError mixedSignArithmetic(NumericInt128 a, NumericInt128 b, T& result, NumericOverflow overflow)
+{
+    NumericInt128 exact = 0;
+    if constexpr (Op == NumericOp::Sum) {
+        exact = a + b;
+    } else if constexpr (Op == NumericOp::Subtract) {
+        exact = a - b;
+    } else if constexpr (Op == NumericOp::Multiply) {
+        exact = a * b;
+    } else {
+        if (b == 0) {
+            return NumericError::DivisionByZero;
+        }
+        exact = a / b;
+    }
+
+    if (exact >= 0 && exact <= static_cast<NumericInt128>(std::numeric_limits<T>::max())) [[likely]] {
+        result = static_cast<T>(exact);
+        return NumericError::None;
+    }
+    switch (overflow) {
+        case NumericOverflow::Wrap:
+            result = static_cast<T>(exact);
+            return NumericError::None;
+        case NumericOverflow::Saturate:
+            result = exact < 0 ? T(0) : std::numeric_limits<T>::max();
+            return NumericError::None;
+        default:
+            return NumericError::Overflow;
+    }
+}
+
+// a op b on BigIntNumeric values; only the operand that is not already a NumericBigInt is converted
+template <NumericOp Op, typename A, typename B>
+NumericError bigIntArithmetic(const A& a, const B& b, NumericBigInt& result)
+{
+    if constexpr (!std::is_same_v<A, NumericBigInt>) {
+        return bigIntArithmetic<Op>(NumericBigInt(a), b, result);
+    } else if constexpr (!std::is_same_v<B, NumericBigInt>) {
+        return bigIntArithmetic<Op>(a, NumericBigInt(b), result);
+    } else if constexpr (Op == NumericOp::Sum) {
+        result = a + b;
+    } else if constexpr (Op == NumericOp::Subtract) {
+        result = a - b;
+    } else if constexpr (Op == NumericOp::Multiply) {
+        result = a * b;
+    } else {
+        if (b.isZero()) {
+            return NumericError::DivisionByZero;
+        }
+        result = a / b;
+    }
+    return NumericError::None;
+}
+
+// Scale and raw units of a decimal arithmetic operand; an integer is its own units at scale 0
+template <typename V>
+inline constexpr unsigned decimalScaleOf = 0;
+template <unsigned Scale, typename Rep>
+inline constexpr unsigned decimalScaleOf<NumericDecimal<Scale, Rep>> = Scale;
+
+template <typename V>
+constexpr NumericInt128 decimalUnitsOf(const V& value)
+{
+    if constexpr (isDecimalValue<V>) {
+        return value.units;
+    } else {
+        return static_cast<NumericInt128>(value);
+    }
+}
+
+/**
+ * a op b for a decimal result D. Operands are exact integers of units, so + and - line
+ * the scales up, * divides the product by the operands' smaller scale and / scales the
+ * dividend up: both are computed exactly in up to 256 bits and rounded once as
+ * `rounding` says. A result outside D follows the overflow policy like an integer,
+ * saturating toward the exact sign.
+ */
+template <NumericOp Op, typename D, typename A, typename B>
+constexpr NumericError decimalArithmetic(const A& a, const B& b, D& result, NumericOverflow overflow, NumericRounding rounding)
+{
+    using Rep = typename D::rep_type;
+    constexpr unsigned scale = D::scale;
+    constexpr unsigned scaleA = decimalScaleOf<A>;
+    constexpr unsigned scaleB = decimalScaleOf<B>;
+    const NumericInt128 x = decimalUnitsOf(a);
+    const NumericInt128 y = decimalUnitsOf(b);
+
+    NumericInt128 exact = 0;
+    bool fits = true;
+    bool negative = false;
+    if constexpr (Op == NumericOp::Sum || Op == NumericOp::Subtract) {
+        // Operands never overflow 128 bits once scaled: 64-bit values are at most 10^18 units wide
+        const NumericInt128 first = x * numericPowerOf10(scale - scaleA);
+        const NumericInt128 second = y * numericPowerOf10(scale - scaleB);
+        fits = Op == NumericOp::Sum ? !__builtin_add_overflow(first, second, &exact) : !__builtin_sub_overflow(first, second, &exact);
+        negative = fits ? exact < 0 : (Op == NumericOp::Sum) == (second < 0);
+    } else {
+        negative = (x < 0) != (y < 0);
+        if constexpr (Op == NumericOp::Multiply) {
+            constexpr std::uint64_t divisor = static_cast<std::uint64_t>(numericPowerOf10(scaleA < scaleB ? scaleA : scaleB));
+            std::int64_t product = 0;
+            if (x == static_cast<std::int64_t>(x) && y == static_cast<std::int64_t>(y) &&
+                !__builtin_mul_overflow(static_cast<std::int64_t>(x), static_cast<std::int64_t>(y), &product)) [[likely]] {
+                // 64-bit operands with a 64-bit product: the constant divisor becomes a multiply
+                const std::uint64_t magnitude = static_cast<std::uint64_t>(numericMagnitude(product));
+                std::uint64_t quotient = magnitude / divisor;
+                quotient += numericRoundsAway(rounding, negative, quotient & 1, magnitude % divisor, divisor);
+                exact = negative ? -static_cast<NumericInt128>(quotient) : static_cast<NumericInt128>(quotient);
+            } else {
+                fits = numericMulDiv(x, y, divisor, rounding, exact);
+            }
+        } else {
+            if (y == 0) {
+                return NumericError::DivisionByZero;
+            }
+            fits = numericMulDiv(x, numericPowerOf10(scale - scaleA + scaleB), y, rounding, exact);
+        }
+    }
+
+    if (fits && exact >= D::minUnits && exact <= D::maxUnits) [[likely]] {
+        result.units = static_cast<Rep>(exact);
+        return NumericError::None;
+    }
+    switch (overflow) {
+        case NumericOverflow::Wrap:
+            result.units = static_cast<Rep>(exact);
+            return NumericError::None;
+        case NumericOverflow::Saturate:
+            result.units = negative ? D::minUnits : D::maxUnits;
+            return NumericError::None;
+        default:
+            return NumericError::Overflow;
+    }
+}
+
+template <NumericOp Op, NumericKind L, NumericKind R>
+struct ArithmeticKernel
+{
+    static constexpr NumericRule rule = arithmeticRule(L, R, Op);
+    static constexpr NumericKind resultKind = rule.result;
+    using result_type = NumericKindValue<resultKind>;
+
+    // `overflow` only applies when the result kind is an integer or decimal kind
+    static constexpr NumericError apply(const NumericKindValue<L>& lhs, const NumericKindValue<R>& rhs, result_type& result,
+                                        NumericOverflow overflow = NumericOverflow::Checked)
+    {
+        static_assert(Op == NumericOp::Sum || Op == NumericOp::Subtract || Op == NumericOp::Multiply || Op == NumericOp::Divide);
+
+        if constexpr (rule.error != NumericError::None) {
+            return rule.error;
+        } else if constexpr (isIntegerKind(resultKind) && isUnsignedKind(resultKind) && (!isUnsignedKind(L) || !isUnsignedKind(R))) {
+            return mixedSignArithmetic<Op>(static_cast<NumericInt128>(lhs), static_cast<NumericInt128>(rhs), result, overflow);
+        } else if constexpr (isIntegerKind(resultKind)) {
+            return integerArithmetic<Op>(promoteOperand(lhs), promoteOperand(rhs), result, overflow);
+        } else if constexpr (resultKind == NumericKind::BigInt) {
+            return bigIntArithmetic<Op>(lhs, rhs, result);
+        } else if constexpr (isDecimalKind(resultKind)) {
+            // The thread's NumericRounding; constant evaluation always rounds half-even
+            NumericRounding rounding = NumericRounding::HalfEven;
+            if ((Op == NumericOp::Multiply || Op == NumericOp::Divide) && !std::is_constant_evaluated()) {
+                rounding = numericRoundingMode();
+            }
+            return decimalArithmetic<Op>(lhs, rhs, result, overflow, rounding);
+        } else if constexpr (isCharKind(L)) {
+            // charNumeric keeps the result in the ASCII range: c & 0x7F is toascii(c), usable in constexpr
+            if constexpr (Op == NumericOp::Sum) {
+                result = static_cast<result_type>(static_cast<int>(lhs + rhs) & 0x7F);
+            } else {
+                result = static_cast<result_type>(static_cast<int>(lhs - rhs) & 0x7F);
+            }
+            return NumericError::None;
+        } else if constexpr (Op == NumericOp::Sum && isFloatKind(L) && R == complexKindOf(L)) {
+            // FloatNumeric<T> + ComplexNumeric<T> only touches the real part
+            result = result_type(lhs + rhs.real(), rhs.imag());
+            return NumericError::None;
+        } else {
+            const result_type a = promoteOperand(lhs);
+            const result_type b = promoteOperand(rhs);
+
+            if constexpr (Op == NumericOp::Sum) {
+                result = a + b;
+            } else if constexpr (Op == NumericOp::Subtract) {
+                result = a - b;
+            } else if constexpr (Op == NumericOp::Multiply) {
+                result = a * b;
+            } else {
+                if (isZeroDivisor(b)) {
+                    return NumericError::DivisionByZero;
+                }
+                result = a / b;
+            }
+            return NumericError::None;
+        }
+    }
+
+private:
+    template <typename V>
+    static constexpr result_type promoteOperand(const V& value)
+    {
+        if constexpr (std::is_same_v<V, result_type>) {
+            return value;
+        } else {
+            return convertValue<resultKind>(value);
+        }
+    }
+};
+
+/************************ Comparison ********************************/
+
+// Comparisons convert the right operand to the receiver's type, as the classes always did;
+// integers of another width or signedness, decimals and BigInts are compared exactly instead
+constexpr NumericError comparisonError(NumericKind lhs, NumericKind rhs)
+{
+    return (rhs == lhs || isConvertible(rhs, lhs)) ? NumericError::None : NumericError::UnsupportedConversion;
+}
+
+// A decimal or integer as (whole part, fraction in 10^-18): these pairs order like the values
+struct DecimalParts
+{
+    NumericInt128 whole;
+    std::int64_t fraction;
+};
+
+template <typename V>
+constexpr DecimalParts decimalPartsOf(const V& value)
+{
+    constexpr NumericInt128 unit = numericPowerOf10(decimalScaleOf<V>);
+    const NumericInt128 units = decimalUnitsOf(value);
+    return {units / unit, static_cast<std::int64_t>((units % unit) * numericPowerOf10(18 - decimalScaleOf<V>))};
+}
+
+template <NumericOp Op, NumericKind L, NumericKind R>
+struct ComparisonKernel
+{
+    static constexpr NumericError error = comparisonError(L, R);
+
+    static constexpr NumericError apply(const NumericKindValue<L>& lhs, const NumericKindValue<R>& rhs, bool& result)
+    {
+        static_assert(Op == NumericOp::LessThan || Op == NumericOp::GreaterThan || Op == NumericOp::Equal);
+
+        if constexpr (error != NumericError::None) {
+            return error;
+        } else if constexpr (L != R && (L == NumericKind::BigInt || R == NumericKind::BigInt) &&
+                             (isIntegerKind(L) || isIntegerKind(R))) {
+            // An integer and a BigInt are compared exactly rather than after narrowing the BigInt
+            const std::strong_ordering order = NumericBigInt(lhs) <=> NumericBigInt(rhs);
+            if constexpr (Op == NumericOp::Equal) {
+                result = (order == 0);
+            } else {
+                result = (Op == NumericOp::LessThan) ? (order < 0) : (order > 0);
+            }
+            return NumericError::None;
+        } else if constexpr (L != R && (isDecimalKind(L) || isDecimalKind(R)) &&
+                             (isDecimalKind(L) || isIntegerKind(L)) && (isDecimalKind(R) || isIntegerKind(R))) {
+            // Decimals of another scale and integers are compared exactly, with no rescaling
+            const DecimalParts a = decimalPartsOf(lhs);
+            const DecimalParts b = decimalPartsOf(rhs);
+            if constexpr (Op == NumericOp::Equal) {
+                result = a.whole == b.whole && a.fraction == b.fraction;
+            } else if constexpr (Op == NumericOp::LessThan) {
+                result = a.whole < b.whole || (a.whole == b.whole && a.fraction < b.fraction);
+            } else {
+                result = a.whole > b.whole || (a.whole == b.whole && a.fraction > b.fraction);
+            }
+            return NumericError::None;
+        } else if constexpr (L != R && isIntegerKind(L) && isIntegerKind(R)) {
+            // Every integer kind fits in 128 bits, so int8(1) < int64(1000) and int(-1) < uint32(5) hold
+            const NumericInt128 a = static_cast<NumericInt128>(lhs);
+            const NumericInt128 b = static_cast<NumericInt128>(rhs);
+            if constexpr (Op == NumericOp::Equal) {
+                result = (a == b);
+            } else {
+                result = (Op == NumericOp::LessThan) ? (a < b) : (a > b);
+            }
+            return NumericError::None;
+        } else {
+            const NumericKindValue<L>& a = lhs;
+            NumericKindValue<L> b{};
+            if constexpr (L == R) {
+                b = rhs;
+            } else {
+                b = convertValue<L>(rhs);
+            }
+
+            if constexpr (Op == NumericOp::Equal) {
+                result = (a == b);
+            } else if constexpr (isComplexKind(L)) {
+                // Complex numbers are ordered by real part, then imaginary part
+                if (a.real() == b.real()) {
+                    result = (Op == NumericOp::LessThan) ? (a.imag() < b.imag()) : (a.imag() > b.imag());
+                } else {
+                    result = (Op == NumericOp::LessThan) ? (a.real() < b.real()) : (a.real() > b.real());
+                }
+            } else {
+                result = (Op == NumericOp::LessThan) ? (a < b) : (a > b);
+            }
+            return NumericError::None;
+        }
+    }
+};
+
+#endif // __NUMERIC_KERNELS_HPP__
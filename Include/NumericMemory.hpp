@@ -0,0 +1,142 @@
+#ifndef __NUMERIC_MEMORY_HPP__
+#define __NUMERIC_MEMORY_HPP__
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "Numeric.hpp"
+
+/**
+ * Pluggable storage for Numeric objects.
+ *
+ * Numeric has class-level operator new/delete, so every std::make_unique inside
+ * Numeric::create, convertTo and the *Operation methods goes through them. While a
+ * NumericAllocationScope is active on the current thread, those allocations come from
+ * its NumericMemoryResource instead of the global heap. Each block remembers the
+ * resource it came from, so the returned std::unique_ptr<Numeric> stays an ordinary
+ * owning handle: destroying it hands the memory back to the right place, even after
+ * the scope has ended.
+ *
+ *     NumericPool pool;
+ *     {
+ *         NumericAllocationScope scope(pool);
+ *         auto total = Numeric::create(0);
+ *         for (const auto& value : values) {
+ *             total = total->sumOperation(*value);   // recycled blocks, no malloc
+ *         }
+ *     }
+ *
+ * Resources are not thread-safe: use one per thread and destroy the objects on the
+ * thread that owns their resource. A resource must outlive its objects: destroying
+ * one while liveCount() is not zero aborts, like reset() throws.
+ *
+ * The owner is kept in a 16-byte header before each block, heap blocks included, so
+ * a heap IntNumeric takes a 48-byte malloc chunk instead of 32.
+ */
+
+class NumericMemoryResource
+{
+    public:
+    virtual ~NumericMemoryResource();
+
+    // Blocks are aligned to __STDCPP_DEFAULT_NEW_ALIGNMENT__
+    virtual void* allocate(std::size_t bytes) = 0;
+    virtual void deallocate(void* block, std::size_t bytes) = 0;
+};
+
+/**
+ * Bump allocator: allocation is a pointer increment, deallocation only updates the
+ * live count, and reset() rewinds all chunks at once for the next evaluation round.
+ */
+class NumericArena : public NumericMemoryResource
+{
+    public:
+    explicit NumericArena(std::size_t chunkBytes = 64 * 1024);
+    ~NumericArena();
+    NumericArena(const NumericArena&) = delete;
+    NumericArena& operator=(const NumericArena&) = delete;
+
+    void* allocate(std::size_t bytes) override;
+    void deallocate(void* block, std::size_t bytes) override;
+
+    // Reuses every chunk from the start; throws if objects allocated here are still alive
+    // (and the destructor aborts in that case)
+    void reset();
+    // Same as reset() but also returns the chunks to the system
+    void release();
+
+    std::size_t liveCount() const { return live; }
+    std::size_t bytesUsed() const;
+    std::size_t chunkCount() const { return chunks.size(); }
+
+    private:
+    struct Chunk
+    {
+        std::byte* memory;
+        std::size_t size;
+    };
+
+    std::size_t chunkBytes;
+    std::vector<Chunk> chunks;
+    std::size_t current = 0;   // index of the chunk being filled
+    std::size_t offset = 0;    // bytes used in chunks[current]
+    std::size_t live = 0;
+
+    void freeChunks();
+};
+
+/**
+ * Free-list pool with one list per 16-byte size class, so every Numeric type gets
+ * its own recycled blocks (IntNumeric, FloatNumeric<double>, ComplexNumeric<double>
+ * all land in different classes). Freed blocks are reused immediately; memory goes
+ * back to the system when the pool is destroyed.
+ */
+class NumericPool : public NumericMemoryResource
+{
+    public:
+    static constexpr std::size_t granularity = 16;
+    static constexpr std::size_t sizeClassCount = 8;   // blocks up to 128 bytes, larger ones use the heap
+
+    explicit NumericPool(std::size_t blocksPerChunk = 256);
+    ~NumericPool();
+    NumericPool(const NumericPool&) = delete;
+    NumericPool& operator=(const NumericPool&) = delete;
+
+    void* allocate(std::size_t bytes) override;
+    void deallocate(void* block, std::size_t bytes) override;
+
+    std::size_t liveCount() const { return live; }
+    std::size_t chunkCount() const { return chunks.size(); }
+
+    private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    std::size_t blocksPerChunk;
+    std::array<FreeBlock*, sizeClassCount> freeLists{};
+    std::vector<std::byte*> chunks;
+    std::size_t live = 0;
+
+    void refill(std::size_t sizeClass);
+};
+
+// Routes Numeric allocations on this thread to `resource` until the scope ends (scopes nest)
+class NumericAllocationScope
+{
+    public:
+    explicit NumericAllocationScope(NumericMemoryResource& resource);
+    ~NumericAllocationScope();
+    NumericAllocationScope(const NumericAllocationScope&) = delete;
+    NumericAllocationScope& operator=(const NumericAllocationScope&) = delete;
+
+    private:
+    NumericMemoryResource* previous;
+};
+
+// Resource used by the current thread, nullptr for the global heap
+NumericMemoryResource* currentNumericMemoryResource();
+
+#endif // __NUMERIC_MEMORY_HPP__
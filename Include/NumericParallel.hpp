@@ -0,0 +1,36 @@
+#ifndef __NUMERIC_PARALLEL_HPP__
+#define __NUMERIC_PARALLEL_HPP__
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * The small amount of threading shared by the sort and reduction engines: plain
+ * std::thread fork/join, no pool. Bodies must not throw.
+ */
+
+// `requested` threads (hardware_concurrency() when 0), but no more than `tasks` and at least one
+inline std::size_t numericThreadCount(std::size_t requested, std::size_t tasks)
+{
+    const std::size_t threads = requested ? requested : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    return std::max<std::size_t>(1, std::min(threads, tasks));
+}
+
+// Runs body(0) .. body(threads - 1), body(0) on the calling thread
+template <typename Body>
+void numericParallelFor(std::size_t threads, const Body& body)
+{
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(body, t);
+    }
+    body(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+#endif // __NUMERIC_PARALLEL_HPP__
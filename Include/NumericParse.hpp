@@ -0,0 +1,126 @@
+#ifndef __NUMERIC_PARSE_HPP__
+#define __NUMERIC_PARSE_HPP__
+
+#include <complex>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+#include "NumericValue.hpp"
+
+/**
+ * Streaming text parser built on std::from_chars.
+ *
+ * Input is a sequence of fields separated by a delimiter (',' by default) or by newlines,
+ * which is what NumericTextWriter produces in both formats. Spaces, tabs and '\r' around
+ * a field are ignored, and empty fields are skipped. Every field gets the narrowest type
+ * that holds it, by the parser's own table below. It is not Numeric::create's mapping:
+ * a one-character field is a char, where Numeric::create(char) makes an IntNumeric.
+ *
+ *   "42"  "-7"                       int
+ *   "2147483648"  "-9000000000"      int64, for integers outside the int range
+ *   "18446744073709551615"           uint64, for integers above the int64 range
+ *   "1.5"  "1e10"  "inf"             float, when float holds the value exactly
+ *   "0.1"  "1e300"                   double
+ *   "1+2i"  "-3.5i"  "(1.5 + -2i)"   complex<float> / complex<double>, by the same rule per part
+ *   "A"  "\"\"\"\""  "\",\""         char (a single byte; quote it if it is a delimiter or '"')
+ *   "é"  "😀"                        char16_t / char32_t (one UTF-8 encoded code point)
+ *
+ * With delimiter '\n' (input written in NumericTextFormat::Lines) every line is one field
+ * and quotes are ordinary characters, so "," and "\"" come back as chars (a '\n' char
+ * cannot be told apart from the line break and is lost).
+ *
+ * Delimiters are found 64 bytes at a time with SIMD compares. A field cut at the end of a
+ * chunk is carried into the next one, so memory stays bounded by the chunk size plus
+ * numericParseMaxField.
+ */
+
+// Longest field accepted; also the most that is carried between chunks
+constexpr std::size_t numericParseMaxField = 256;
+
+struct NumericParseOptions
+{
+    char delimiter = ',';               // fields are also separated by newlines; '\n' for Lines input
+    bool narrowFloats = true;           // false: every decimal becomes a double
+    bool skipInvalid = false;           // count invalid fields instead of throwing
+    std::size_t chunkSize = 1 << 20;    // bytes read at a time by numericParseStream
+};
+
+struct NumericParseStats
+{
+    std::size_t bytes = 0;      // input bytes seen
+    std::size_t fields = 0;     // values appended
+    std::size_t invalid = 0;    // fields skipped with skipInvalid
+};
+
+// One column per type the parser can infer; order is kept within each column
+struct NumericParsedColumns
+{
+    NumericColumn<int> ints;
+    NumericColumn<std::int64_t> int64s;
+    NumericColumn<std::uint64_t> uint64s;
+    NumericColumn<float> floats;
+    NumericColumn<double> doubles;
+    NumericColumn<std::complex<float>> complexFloats;
+    NumericColumn<std::complex<double>> complexDoubles;
+    NumericColumn<char> chars;
+    NumericColumn<char16_t> char16s;
+    NumericColumn<char32_t> char32s;
+
+    std::size_t size() const;
+    void clear();
+};
+
+/************************ NumericTextParser Class ********************************/
+
+class NumericTextParser
+{
+    public:
+    explicit NumericTextParser(NumericParseOptions options = {}) : options(options) {}
+
+    // Parses every complete field of `chunk`; a field cut at the end is kept for the next call
+    void parse(std::string_view chunk, NumericParsedColumns& out);
+    void parse(std::string_view chunk, std::vector<NumericValue>& out);
+
+    // End of input: parses the field kept from the last chunk, if any
+    void finish(NumericParsedColumns& out);
+    void finish(std::vector<NumericValue>& out);
+
+    const NumericParseStats& stats() const { return counters; }
+
+    private:
+    NumericParseOptions options;
+    NumericParseStats counters;
+    std::string pending;
+
+    template <typename Out>
+    void parseChunk(std::string_view chunk, Out& out);
+    template <typename Out>
+    void finishInput(Out& out);
+    template <typename Out>
+    std::size_t scan(const char* data, std::size_t size, bool final, Out& out);
+    template <typename Out>
+    void parseField(const char* first, const char* last, Out& out);
+    void keep(const char* first, const char* last);
+    bool quoting() const { return options.delimiter != '\n'; }
+};
+
+/**
+ * Parses a whole file or stream options.chunkSize bytes at a time. After each chunk
+ * `onBatch` receives the values parsed so far, which are cleared afterwards, so inputs
+ * larger than memory can be processed:
+ *
+ *     numericParseStream(file, [&](NumericParsedColumns& batch) { total += sum(batch.doubles); });
+ */
+NumericParseStats numericParseStream(std::FILE* file, const std::function<void(NumericParsedColumns&)>& onBatch,
+                                     NumericParseOptions options = {});
+NumericParseStats numericParseStream(std::istream& stream, const std::function<void(NumericParsedColumns&)>& onBatch,
+                                     NumericParseOptions options = {});
+
+#endif // __NUMERIC_PARSE_HPP__
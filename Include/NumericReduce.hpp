@@ -0,0 +1,199 @@
+#ifndef __NUMERIC_REDUCE_HPP__
+#define __NUMERIC_REDUCE_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+
+/**
+ * Multi-threaded reductions: sum, product, min, max and mean.
+ *
+ * The input is cut into chunks of options.chunkSize elements. Each chunk is reduced on
+ * its own into a partial result, the threads share out the chunks, and the partials are
+ * combined in chunk order on the calling thread. The order of every floating-point
+ * operation therefore depends only on the chunk size, and results are bit-identical for
+ * any thread count.
+ *
+ * Over a std::vector<std::unique_ptr<Numeric>>:
+ *  - Sum / product: the result has the kind a sumOperation (multiplyOperation) loop
+ *    over the elements would end with, and every element is converted to that kind
+ *    and accumulated in it, so unlike the loop no imaginary part is dropped by an
+ *    earlier real-valued accumulator. A pair the loop would reject throws the same
+ *    message.
+ *    Integer sums and products are computed exactly, then brought into the result
+ *    type under the thread's NumericOverflow policy, as one kernel call would be: by
+ *    default an out-of-range result throws "sumOperation: Integer overflow." (or
+ *    multiplyOperation), NumericOverflow::Wrap gives the result modulo 2^N. Character
+ *    sums keep only the low 7 bits, as charNumeric does.
+ *  - Min / max: a copy of the smallest / largest element in the NumericSortKey order
+ *    (exact across kinds, NaN after +inf); ties go to the first element.
+ *  - Mean: the sum divided by the count; an integer sum gives a FloatNumeric<double>.
+ *  - BigIntNumeric values are summed exactly; their products are built as a product
+ *    tree within each chunk, so the large multiplications get balanced operands.
+ *  - Decimal sums are exact integer sums of the units, under the overflow policy like
+ *    an integer sum; products round after every factor (chunk by chunk, in order) under
+ *    the thread's NumericRounding, and the mean is the sum divided by the count,
+ *    rounded once, in the decimal type.
+ *  - float16 and bfloat16 values are widened and reduced in float, with the chosen
+ *    NumericSummation, and the result is rounded to the 16-bit type once.
+ *
+ * Over a NumericColumn<T> the same rules apply to T; numericMean of an integer column
+ * is a double.
+ *
+ * Floating-point sums (and means) use eight interleaved running sums per chunk by
+ * default, which vectorizes. NumericSummation::Kahan (Neumaier's variant) and ::Pairwise
+ * trade speed for accuracy, which matters mostly for FloatNumeric<float>.
+ * All functions throw std::runtime_error for an empty input.
+ *
+ * Grouped reductions (below) compute count, sum, min and max per distinct key.
+ */
+
+enum class NumericSummation : std::uint8_t
+{
+    Plain,      // eight running sums per chunk
+    Kahan,      // compensated summation within and across chunks
+    Pairwise    // recursive halving within chunks, a balanced tree across chunks
+};
+
+struct NumericReduceOptions
+{
+    std::size_t threads = 0;              // 0 = std::thread::hardware_concurrency()
+    std::size_t chunkSize = 1 << 16;      // elements per chunk; fixes the evaluation order
+    NumericSummation summation = NumericSummation::Plain;
+};
+
+// An exact integer result brought into T under the thread's overflow policy, like a single kernel call
+template <typename T>
+T numericIntegerResult(NumericOp op, NumericInt128 exact)
+{
+    using Limits = std::numeric_limits<T>;
+    if (exact >= static_cast<NumericInt128>(Limits::min()) && exact <= static_cast<NumericInt128>(Limits::max())) {
+        return static_cast<T>(exact);
+    }
+    switch (numericOverflowMode()) {
+        case NumericOverflow::Wrap:     return static_cast<T>(exact);
+        case NumericOverflow::Saturate: return exact < 0 ? Limits::min() : Limits::max();
+        default:
+            throw std::runtime_error(numericErrorMessage(op, NumericError::Overflow));
+    }
+}
+
+// Result type of numericMean over a column of T
+template <typename T>
+using NumericMeanType = std::conditional_t<IntegerValue<T> || std::is_same_v<T, NumericBigInt>, double, T>;
+
+std::unique_ptr<Numeric> numericSum(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options = {});
+std::unique_ptr<Numeric> numericProduct(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options = {});
+std::unique_ptr<Numeric> numericMin(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options = {});
+std::unique_ptr<Numeric> numericMax(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options = {});
+std::unique_ptr<Numeric> numericMean(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options = {});
+
+template <typename T>
+T numericSum(const NumericColumn<T>& column, const NumericReduceOptions& options = {});
+template <typename T>
+T numericProduct(const NumericColumn<T>& column, const NumericReduceOptions& options = {});
+template <typename T>
+T numericMin(const NumericColumn<T>& column, const NumericReduceOptions& options = {});
+template <typename T>
+T numericMax(const NumericColumn<T>& column, const NumericReduceOptions& options = {});
+template <typename T>
+NumericMeanType<T> numericMean(const NumericColumn<T>& column, const NumericReduceOptions& options = {});
+
+/************************ Grouped reductions ********************************/
+
+/**
+ * Hash aggregation in two steps: numericGroupKeys numbers the distinct keys of a column,
+ * and numericAggregate reduces a value column over those groups. One grouping serves
+ * any number of value columns; numericGroupBy does both and attaches the keys.
+ *
+ *     const NumericGrouping byCustomer = numericGroupKeys(customers);
+ *     const auto spent = numericAggregate(byCustomer, amounts);      // spent[g].sum, .count, ...
+ *     const auto bought = numericAggregate(byCustomer, quantities);
+ *     // group g is customer customers[byCustomer.firstRows[g]]
+ *
+ * Two keys are the same group when numericSameValue says so (NumericHash.hpp): -0.0 and
+ * +0.0 are one group, as are all NaNs. In a vector of Numeric keys this holds across
+ * kinds, so int 3, double 3.0 and 3+0i are one group. Groups are numbered in order of
+ * first appearance.
+ *
+ * With more than one thread the rows are partitioned by the top bits of their key hash:
+ * each thread hashes a slice of the rows and counts them per partition, the row numbers
+ * are scattered so that every partition lists its rows in order, and the threads then
+ * build one NumericHashMap per partition, with no locks and no shared table. Aggregation
+ * walks the same partitions, so every group is reduced by one thread, in row order, and
+ * the results do not depend on the thread count.
+ *
+ * Per group, sum / min / max follow numericSum / numericMin / numericMax on the group's
+ * values: exact integer and decimal sums brought into V under the thread's
+ * NumericOverflow policy (checked when the results are collected), float16 / bfloat16
+ * sums in float, NaN after +inf with ties to the first row. Floating-point sums add the
+ * values in row order. Row numbers are 32-bit, so a key column holds at most 2^32 - 1
+ * rows; numericAggregate throws when the value column is not as long as the keys.
+ * An empty input gives no groups.
+ */
+struct NumericGrouping
+{
+    std::size_t rowCount = 0;
+    std::vector<std::uint32_t> firstRows;       // row where each group first appears; its key stands for the group
+
+    // Build layout, read by numericAggregate: the row numbers partition by partition (empty when
+    // there is a single partition of all rows in order), the group of each of those rows, and
+    // where every partition starts
+    std::vector<std::uint32_t> rows;
+    std::vector<std::uint32_t> groups;
+    std::vector<std::size_t> partitionBegin;
+
+    std::size_t groupCount() const { return firstRows.size(); }
+};
+
+template <typename V>
+struct NumericAggregate
+{
+    std::size_t count = 0;
+    V sum{};
+    V min{};
+    V max{};
+};
+
+template <typename K, typename V>
+struct NumericGroup : NumericAggregate<V>
+{
+    K key{};
+};
+
+template <typename K>
+NumericGrouping numericGroupKeys(const NumericColumn<K>& keys, const NumericReduceOptions& options = {});
+NumericGrouping numericGroupKeys(const std::vector<std::unique_ptr<Numeric>>& keys, const NumericReduceOptions& options = {});
+
+template <typename V>
+std::vector<NumericAggregate<V>> numericAggregate(const NumericGrouping& grouping, const NumericColumn<V>& values,
+                                                  const NumericReduceOptions& options = {});
+
+// Groups with a copy of the key of their first row
+template <typename V>
+std::vector<NumericGroup<std::unique_ptr<Numeric>, V>> numericGroupBy(const std::vector<std::unique_ptr<Numeric>>& keys,
+                                                                      const NumericColumn<V>& values,
+                                                                      const NumericReduceOptions& options = {});
+
+template <typename K, typename V>
+std::vector<NumericGroup<K, V>> numericGroupBy(const NumericColumn<K>& keys, const NumericColumn<V>& values,
+                                               const NumericReduceOptions& options = {})
+{
+    const NumericGrouping grouping = numericGroupKeys(keys, options);
+    const std::vector<NumericAggregate<V>> aggregates = numericAggregate(grouping, values, options);
+    std::vector<NumericGroup<K, V>> groups(aggregates.size());
+    for (std::size_t group = 0; group < groups.size(); ++group) {
+        static_cast<NumericAggregate<V>&>(groups[group]) = aggregates[group];
+        groups[group].key = keys[grouping.firstRows[group]];
+    }
+    return groups;
+}
+
+#endif // __NUMERIC_REDUCE_HPP__
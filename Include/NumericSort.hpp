@@ -0,0 +1,99 @@
+#ifndef __NUMERIC_SORT_HPP__
+#define __NUMERIC_SORT_HPP__
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+
+/**
+ * Sorting heterogeneous values without virtual calls in the comparison loop.
+ *
+ * Every value maps to a 24-byte NumericSortKey, and comparing two keys with memcmp
+ * gives the following total order:
+ *
+ *   1. Numbers (the integer kinds, BigInt, the decimals, float16, bfloat16, float, double,
+ *      long double and the complex types) come before characters.
+ *   2. Numbers are ordered by real part, then by imaginary part (0 for real types).
+ *      The values are compared exactly, with no truncation: int 3 < float 3.5 < double 4,
+ *      and every 64-bit integer keeps all its bits. A BigInt beyond 64 bits and a
+ *      decimal are keyed on their exact value rounded to odd at 64 bits, so their keys
+ *      can tie for different values but never come out in the wrong order; numericSort(),
+ *      numericSortOrder() and numericMin/Max break those ties on the exact values,
+ *      comparing keys alone does not.
+ *      Each part is ordered -inf < negative < -0.0 == +0.0 < positive < +inf < NaN.
+ *      All NaNs are equal, whatever their sign and payload.
+ *   3. Characters are ordered by code unit, read as unsigned (char 0xE9 > char 'z').
+ *   4. Values that are still equal are ordered by kind, in NumericKind order
+ *      (int 3 < float 3 < double 3 < complex<float> (3,0)).
+ *
+ * This is not the order of lessThanOperation: that one converts the right operand to
+ * the left operand's type, so it truncates (IntNumeric(3) < FloatNumeric(3.5) is
+ * false) and is not transitive across kinds.
+ *
+ * numericSort() builds the keys once and sorts them with an LSD radix sort. The sort
+ * skips every byte position that holds the same value in all keys, so narrow or
+ * uniform data costs only a few passes. A merge sort is the fallback. Both sorts are
+ * stable and split their work across threads.
+ */
+
+/************************ Sort keys ********************************/
+
+struct NumericSortKey
+{
+    static constexpr std::size_t size = 24;
+    // The bytes before this one encode the value, this one the kind (the last tie-break)
+    static constexpr std::size_t kindByte = 22;
+    std::array<std::uint8_t, size> bytes{};
+
+    friend bool operator==(const NumericSortKey& first, const NumericSortKey& second)
+    {
+        return std::memcmp(first.bytes.data(), second.bytes.data(), size) == 0;
+    }
+
+    friend std::strong_ordering operator<=>(const NumericSortKey& first, const NumericSortKey& second)
+    {
+        return std::memcmp(first.bytes.data(), second.bytes.data(), size) <=> 0;
+    }
+};
+
+// Key of a raw value, equal to the sortKey() of the Numeric object that stores it
+template <typename T>
+NumericSortKey numericSortKey(T value);
+
+// Exact three-way comparison in the order above (defined in NumericHash.cpp, with the exact arithmetic)
+std::strong_ordering numericSortOrder(const Numeric& first, const Numeric& second);
+
+/************************ Sorting ********************************/
+
+enum class NumericSortAlgorithm : std::uint8_t
+{
+    Automatic,   // radix sort, or merge sort for small inputs
+    Radix,
+    Merge
+};
+
+struct NumericSortOptions
+{
+    NumericSortAlgorithm algorithm = NumericSortAlgorithm::Automatic;
+    std::size_t threads = 0;   // 0 = std::thread::hardware_concurrency()
+};
+
+// Stable ascending sort in the order above; elements must not be null
+void numericSort(std::vector<std::unique_ptr<Numeric>>& values, const NumericSortOptions& options = {});
+
+/**
+ * Stable ascending sort of a column in the same order. Integer, float, double and
+ * character columns sort on 8-byte keys; long double and complex columns use the
+ * full NumericSortKey.
+ */
+template <typename T>
+void numericSort(NumericColumn<T>& column, const NumericSortOptions& options = {});
+
+#endif // __NUMERIC_SORT_HPP__
@@ -0,0 +1,272 @@
+#ifndef __NUMERIC_STATS_HPP__
+#define __NUMERIC_STATS_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "NumericKernels.hpp"
+
+/**
+ * Optional instrumentation of the dispatch layer, replacing the old DEBUG tracing.
+ *
+ * Built only when NUMERIC_STATS is 1 (CMake option NUMERIC_ENABLE_STATS). Otherwise
+ * every hook below is an empty inline function, the timer an empty object, and the
+ * snapshot functions return zeros: no code is left on the hot path.
+ *
+ * When enabled it records:
+ *  - operations: one counter per (op, lhs kind, rhs kind, NumericPath), i.e. which
+ *    path the dispatch took (boxed result, in-place update, widened result, batch run,
+ *    conversion) and which error it threw;
+ *  - allocations: Numeric::operator new / delete calls and bytes requested;
+ *  - latency: one call in setNumericStatsSampling() (default 64) of apply, applyAssign,
+ *    compare and convertTo is timed with steady_clock into an HDR-style histogram of
+ *    16 sub-buckets per power of two (error below 6.25 %).
+ *
+ * Each thread writes only its own block of counters with relaxed load + store, so no
+ * locked instruction is executed and no cache line is shared. numericStatsSnapshot()
+ * sums the blocks of the live threads and the counts of the exited ones. Operations
+ * done by a thread after its thread_local storage has been torn down go to a shared
+ * block where concurrent increments may be lost.
+ *
+ *     std::fputs(numericStatsPrometheus(numericStatsSnapshot()).c_str(), stdout);
+ */
+
+#ifndef NUMERIC_STATS
+#define NUMERIC_STATS 0
+#endif
+
+constexpr bool numericStatsEnabled = NUMERIC_STATS != 0;
+
+enum class NumericPath : std::uint8_t
+{
+    Boxed,                      // result built in a new object of the promoted kind
+    InPlace,                    // applyAssign wrote into the left operand
+    Widened,                    // applyAssign had to return a new object of a wider kind
+    Compared,                   // comparison
+    Batched,                    // element of an applyBatch / compareBatch run
+    Converted,                  // convertTo built the target object
+    DivisionByZero,             // the NumericError values that end in an exception
+    UnsupportedType,
+    UnsupportedConversion,
+    UnsupportedCharOperation,
+    Overflow,
+    Count
+};
+
+constexpr std::size_t numericPathCount = static_cast<std::size_t>(NumericPath::Count);
+
+// Operations are counted per NumericOp, plus this extra slot for convertTo
+constexpr NumericOp numericConvertStatsOp = NumericOp::Count;
+constexpr std::size_t numericStatsOpCount = numericOpCount + 1;
+
+// 16 linear buckets for 0..15 ns, then 16 per power of two from 2^4 up to 2^37 ns (~137 s)
+constexpr std::size_t numericLatencySubBuckets = 16;
+constexpr std::size_t numericLatencyBucketCount = numericLatencySubBuckets * (1 + 36 - 4 + 1);
+constexpr std::size_t numericStatsOperationCounters = numericStatsOpCount * numericKindCount * numericKindCount * numericPathCount;
+
+constexpr NumericPath numericPathOf(NumericError error)
+{
+    switch (error) {
+        case NumericError::DivisionByZero:           return NumericPath::DivisionByZero;
+        case NumericError::UnsupportedType:          return NumericPath::UnsupportedType;
+        case NumericError::UnsupportedConversion:    return NumericPath::UnsupportedConversion;
+        case NumericError::UnsupportedCharOperation: return NumericPath::UnsupportedCharOperation;
+        case NumericError::Overflow:                 return NumericPath::Overflow;
+        default:                                     return NumericPath::Boxed;
+    }
+}
+
+constexpr const char* numericPathName(NumericPath path)
+{
+    switch (path) {
+        case NumericPath::Boxed:                    return "boxed";
+        case NumericPath::InPlace:                  return "in_place";
+        case NumericPath::Widened:                  return "widened";
+        case NumericPath::Compared:                 return "compared";
+        case NumericPath::Batched:                  return "batched";
+        case NumericPath::Converted:                return "converted";
+        case NumericPath::DivisionByZero:           return "division_by_zero";
+        case NumericPath::UnsupportedType:          return "unsupported_type";
+        case NumericPath::UnsupportedConversion:    return "unsupported_conversion";
+        case NumericPath::UnsupportedCharOperation: return "unsupported_char_operation";
+        case NumericPath::Overflow:                 return "overflow";
+        default:                                    return "unknown";
+    }
+}
+
+constexpr const char* numericStatsOpName(NumericOp op)
+{
+    return (op == numericConvertStatsOp) ? "convertTo" : numericOpName(op);
+}
+
+constexpr std::size_t numericStatsOperationIndex(NumericOp op, NumericKind lhs, NumericKind rhs, NumericPath path)
+{
+    return ((static_cast<std::size_t>(op) * numericKindCount + static_cast<std::size_t>(lhs)) * numericKindCount
+            + static_cast<std::size_t>(rhs)) * numericPathCount + static_cast<std::size_t>(path);
+}
+
+constexpr std::size_t numericLatencyBucket(std::uint64_t nanoseconds)
+{
+    if (nanoseconds < numericLatencySubBuckets) {
+        return static_cast<std::size_t>(nanoseconds);
+    }
+    const std::size_t exponent = 63 - static_cast<std::size_t>(__builtin_clzll(nanoseconds));   // >= 4
+    if (exponent > 36) {
+        return numericLatencyBucketCount - 1;
+    }
+    const std::size_t sub = static_cast<std::size_t>(nanoseconds >> (exponent - 4)) & (numericLatencySubBuckets - 1);
+    return numericLatencySubBuckets * (exponent - 3) + sub;
+}
+
+// Largest latency (ns) that falls into `bucket`
+constexpr std::uint64_t numericLatencyBucketBound(std::size_t bucket)
+{
+    if (bucket < numericLatencySubBuckets) {
+        return bucket;
+    }
+    const std::size_t exponent = bucket / numericLatencySubBuckets + 3;
+    const std::uint64_t sub = bucket % numericLatencySubBuckets;
+    return ((numericLatencySubBuckets + sub + 1) << (exponent - 4)) - 1;
+}
+
+/************************ Snapshot ********************************/
+
+struct NumericLatencyHistogram
+{
+    std::vector<std::uint64_t> buckets = std::vector<std::uint64_t>(numericLatencyBucketCount);
+    std::uint64_t count = 0;              // sampled calls, not all calls
+    std::uint64_t sumNanoseconds = 0;
+
+    // Upper bound (ns) of the bucket holding the `fraction` quantile (0..1); 0 when empty
+    std::uint64_t percentile(double fraction) const;
+    double meanNanoseconds() const { return count ? static_cast<double>(sumNanoseconds) / static_cast<double>(count) : 0.0; }
+};
+
+struct NumericStatsSnapshot
+{
+    std::vector<std::uint64_t> operations = std::vector<std::uint64_t>(numericStatsOperationCounters);
+    std::vector<NumericLatencyHistogram> latency = std::vector<NumericLatencyHistogram>(numericStatsOpCount);
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t allocatedBytes = 0;
+
+    std::uint64_t count(NumericOp op, NumericKind lhs, NumericKind rhs, NumericPath path) const
+    {
+        return operations[numericStatsOperationIndex(op, lhs, rhs, path)];
+    }
+    // Over every op and kind pair
+    std::uint64_t count(NumericPath path) const;
+    const NumericLatencyHistogram& latencyOf(NumericOp op) const { return latency[static_cast<std::size_t>(op)]; }
+};
+
+// Counts since start-up or the last numericStatsReset(); all zero when NUMERIC_STATS is 0
+NumericStatsSnapshot numericStatsSnapshot();
+void numericStatsReset();
+// Time one call in `period` (0 stops timing); applies to each thread from its next sample
+void setNumericStatsSampling(std::uint32_t period);
+std::uint32_t numericStatsSampling();
+
+// Prometheus text exposition format (version 0.0.4); only non-zero series are written
+std::string numericStatsPrometheus(const NumericStatsSnapshot& snapshot);
+
+/************************ Hooks ********************************/
+
+#if NUMERIC_STATS
+
+struct NumericThreadStats
+{
+    std::atomic<std::uint64_t> operations[numericStatsOperationCounters];
+    std::atomic<std::uint64_t> latency[numericStatsOpCount * numericLatencyBucketCount];
+    std::atomic<std::uint64_t> latencySum[numericStatsOpCount];
+    std::atomic<std::uint64_t> allocations;
+    std::atomic<std::uint64_t> deallocations;
+    std::atomic<std::uint64_t> allocatedBytes;
+    std::atomic<std::uint32_t> untilSample{1};   // calls left before the next timed one
+};
+
+extern thread_local constinit NumericThreadStats* numericLocalStats;
+NumericThreadStats& numericAttachThreadStats();
+// Restarts the countdown of the calling thread; returns now, or the epoch when timing is off
+std::chrono::steady_clock::time_point numericStatsStartSample();
+void numericStatsRecordLatency(NumericOp op, std::chrono::steady_clock::duration elapsed);
+
+inline NumericThreadStats& numericStatsBlock()
+{
+    NumericThreadStats* block = numericLocalStats;
+    return block ? *block : numericAttachThreadStats();
+}
+
+inline void numericStatsBump(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+#endif // NUMERIC_STATS
+
+inline void numericStatsCount([[maybe_unused]] NumericOp op, [[maybe_unused]] NumericKind lhs, [[maybe_unused]] NumericKind rhs,
+                              [[maybe_unused]] NumericPath path, [[maybe_unused]] std::uint64_t count = 1)
+{
+#if NUMERIC_STATS
+    numericStatsBump(numericStatsBlock().operations[numericStatsOperationIndex(op, lhs, rhs, path)], count);
+#endif
+}
+
+inline void numericStatsAllocation([[maybe_unused]] std::size_t bytes)
+{
+#if NUMERIC_STATS
+    NumericThreadStats& block = numericStatsBlock();
+    numericStatsBump(block.allocations, 1);
+    numericStatsBump(block.allocatedBytes, bytes);
+#endif
+}
+
+inline void numericStatsDeallocation()
+{
+#if NUMERIC_STATS
+    numericStatsBump(numericStatsBlock().deallocations, 1);
+#endif
+}
+
+// True for one call per sampling period, which the caller then runs under a NumericStatsTimer
+inline bool numericStatsSampleDue()
+{
+#if NUMERIC_STATS
+    NumericThreadStats& block = numericStatsBlock();
+    const std::uint32_t left = block.untilSample.load(std::memory_order_relaxed) - 1;
+    block.untilSample.store(left, std::memory_order_relaxed);
+    return left == 0;
+#else
+    return false;
+#endif
+}
+
+// Records the latency of the enclosing scope. Only constructed for sampled calls, so the
+// unsampled ones keep their tail call into the dispatch table.
+class NumericStatsTimer
+{
+    public:
+    NumericStatsTimer(const NumericStatsTimer&) = delete;
+    NumericStatsTimer& operator=(const NumericStatsTimer&) = delete;
+
+#if NUMERIC_STATS
+    explicit NumericStatsTimer(NumericOp op) : op(op), start(numericStatsStartSample()) {}
+    ~NumericStatsTimer()
+    {
+        if (start != std::chrono::steady_clock::time_point{}) {
+            numericStatsRecordLatency(op, std::chrono::steady_clock::now() - start);
+        }
+    }
+
+    private:
+    NumericOp op;
+    std::chrono::steady_clock::time_point start;
+#else
+    explicit NumericStatsTimer(NumericOp) {}
+#endif
+};
+
+#endif // __NUMERIC_STATS_HPP__
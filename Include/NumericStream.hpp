@@ -0,0 +1,570 @@
+#ifndef __NUMERIC_STREAM_HPP__
+#define __NUMERIC_STREAM_HPP__
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <istream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+#include "NumericParallel.hpp"
+#include "NumericParse.hpp"
+
+/**
+ * Streaming pipelines over input of any length, built on C++20 coroutines.
+ *
+ *     std::size_t bytes = numericReadChunks(input)                        // 1 MiB of text at a time
+ *                       | numericParse()                                  // NumericParsedColumns per chunk
+ *                       | numericThreaded()                               // read and parse on their own thread
+ *                       | numericParallelMap([](NumericParsedColumns batch) {
+ *                             NumericTextWriter writer;                   // compute and serialize on every core
+ *                             writer.write(batch.doubles.multiplyOperation(2.0));
+ *                             return std::string(writer.view());
+ *                         })
+ *                       | numericWrite(output);
+ *
+ * A source is a NumericGenerator<T>: any coroutine that co_yields values of T, such as
+ * numericReadChunks or a feed of std::unique_ptr<Numeric>. Each `| stage` takes the
+ * generator before it and gives a new one; values are pulled one at a time from the end
+ * of the pipeline, so nothing is read before it is needed:
+ *  - numericMap(f), numericFilter(p): f(value) for every value / the values p accepts
+ *  - numericChunk(rows): values gathered into NumericColumn<T> chunks of `rows` (a
+ *    std::vector<T> for T that is no column type, e.g. boxed Numerics)
+ *  - numericParse(options): text chunks parsed into NumericParsedColumns, a field cut
+ *    between two chunks included
+ *  - numericThreaded(capacity): the stages before it run on a thread of their own, at
+ *    most `capacity` values ahead of the consumer
+ *  - numericParallelMap(f, threads, capacity): f on `threads` threads (all cores by
+ *    default), with at most `capacity` values in flight; results keep the input order.
+ *    f is called concurrently and must be safe to call so.
+ * and the pipeline ends in a range-for loop or in
+ *  - numericReduce(init, op): init = op(init, value) over every value, on the calling thread
+ *  - numericWrite(file): every value (text convertible to std::string_view) written out
+ *
+ * The threaded stages hand values over through NumericBoundedQueue: a producer that
+ * gets `capacity` values ahead blocks until the consumer catches up, so peak memory is
+ * the queue capacities times the size of a value (a chunk), whatever the input size.
+ * Their threads run under the NumericOverflow and NumericRounding policies of the thread
+ * that first pulls from the stage. An exception in any stage ends the pipeline and is
+ * rethrown to the consumer; destroying a pipeline part way through stops and joins its
+ * threads.
+ */
+
+/************************ NumericGenerator Class ********************************/
+
+// Single-pass coroutine generator: the body runs up to each co_yield as the values are pulled
+template <typename T>
+class NumericGenerator
+{
+    public:
+    struct promise_type
+    {
+        std::optional<T> current;
+        std::exception_ptr error;
+
+        NumericGenerator get_return_object() { return NumericGenerator(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(T value)
+        {
+            current.emplace(std::move(value));
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    class iterator
+    {
+        public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+
+        iterator() = default;
+        explicit iterator(Handle handle) : handle(handle) {}
+
+        T& operator*() const { return *handle.promise().current; }
+        iterator& operator++()
+        {
+            advance(handle);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return !handle || handle.done(); }
+
+        private:
+        Handle handle;
+    };
+
+    NumericGenerator() = default;
+    NumericGenerator(NumericGenerator&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    NumericGenerator& operator=(NumericGenerator&& other) noexcept
+    {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    ~NumericGenerator()
+    {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    // Runs the body to its first co_yield; a generator is iterated once
+    iterator begin()
+    {
+        advance(handle);
+        return iterator(handle);
+    }
+    std::default_sentinel_t end() const { return {}; }
+
+    // The next value, or nullopt once the body has returned
+    std::optional<T> next()
+    {
+        advance(handle);
+        if (!handle || handle.done()) {
+            return std::nullopt;
+        }
+        return std::move(handle.promise().current);
+    }
+
+    private:
+    Handle handle;
+
+    explicit NumericGenerator(Handle handle) : handle(handle) {}
+
+    // Drops the previous value, resumes the body and rethrows what it threw
+    static void advance(Handle handle)
+    {
+        if (!handle || handle.done()) {
+            return;
+        }
+        handle.promise().current.reset();
+        handle.resume();
+        if (handle.promise().error) {
+            std::rethrow_exception(std::exchange(handle.promise().error, nullptr));
+        }
+    }
+};
+
+/************************ NumericBoundedQueue Class ********************************/
+
+/**
+ * Blocking FIFO of at most `capacity` values between two threads. push() waits while the
+ * queue is full, pop() while it is empty. close() ends the input: pushes fail, and pop()
+ * returns the values left, then nullopt. cancel() also drops the values left.
+ */
+template <typename T>
+class NumericBoundedQueue
+{
+    public:
+    explicit NumericBoundedQueue(std::size_t capacity) : limit(capacity)
+    {
+        if (capacity == 0) {
+            throw std::runtime_error("NumericBoundedQueue: Capacity must be positive.");
+        }
+    }
+
+    std::size_t capacity() const { return limit; }
+
+    // false when the queue was closed; the value is then dropped
+    bool push(T value)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [&] { return closed || values.size() < limit; });
+        if (closed) {
+            return false;
+        }
+        values.push_back(std::move(value));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    std::optional<T> pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&] { return closed || !values.empty(); });
+        if (values.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(values.front()));
+        values.pop_front();
+        notFull.notify_one();
+        return value;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+    void cancel()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        values.clear();
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+    private:
+    std::size_t limit;
+    bool closed = false;
+    std::deque<T> values;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+};
+
+/************************ Stages ********************************/
+
+// Threads of one pipeline stage; `stop` unblocks them (cancels their queues) before they are joined
+class NumericStageThreads
+{
+    public:
+    explicit NumericStageThreads(std::function<void()> stop)
+        : stop(std::move(stop)), overflow(numericOverflowMode()), rounding(numericRoundingMode()) {}
+    NumericStageThreads(const NumericStageThreads&) = delete;
+    NumericStageThreads& operator=(const NumericStageThreads&) = delete;
+    ~NumericStageThreads()
+    {
+        stop();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Runs body() on a new thread under the policies of the thread that created this object
+    template <typename Body>
+    void start(Body body)
+    {
+        threads.emplace_back([body = std::move(body), overflow = overflow, rounding = rounding]() mutable {
+            const NumericOverflowScope overflowScope(overflow);
+            const NumericRoundingScope roundingScope(rounding);
+            body();
+        });
+    }
+
+    private:
+    std::function<void()> stop;
+    NumericOverflow overflow;
+    NumericRounding rounding;
+    std::vector<std::thread> threads;
+};
+
+// What numericChunk gathers values of T into
+template <typename T>
+using NumericChunk = std::conditional_t<numericKindOf<T> != NumericKind::Count, NumericColumn<T>, std::vector<T>>;
+
+template <typename F>
+struct NumericMapStage
+{
+    F function;
+};
+
+template <typename P>
+struct NumericFilterStage
+{
+    P predicate;
+};
+
+struct NumericChunkStage
+{
+    std::size_t rows;
+};
+
+struct NumericParseStage
+{
+    NumericParseOptions options;
+};
+
+struct NumericThreadStage
+{
+    std::size_t capacity;
+};
+
+template <typename F>
+struct NumericParallelMapStage
+{
+    F function;
+    std::size_t threads;
+    std::size_t capacity;
+};
+
+template <typename V, typename Op>
+struct NumericReduceStage
+{
+    V init;
+    Op op;
+};
+
+struct NumericWriteStage
+{
+    std::FILE* file;
+};
+
+template <typename F>
+NumericMapStage<F> numericMap(F function)
+{
+    return {std::move(function)};
+}
+
+template <typename P>
+NumericFilterStage<P> numericFilter(P predicate)
+{
+    return {std::move(predicate)};
+}
+
+inline NumericChunkStage numericChunk(std::size_t rows)
+{
+    if (rows == 0) {
+        throw std::runtime_error("numericChunk: Chunk size must be positive.");
+    }
+    return {rows};
+}
+
+inline NumericParseStage numericParse(NumericParseOptions options = {})
+{
+    return {options};
+}
+
+inline NumericThreadStage numericThreaded(std::size_t capacity = 4)
+{
+    if (capacity == 0) {
+        throw std::runtime_error("numericThreaded: Capacity must be positive.");
+    }
+    return {capacity};
+}
+
+// threads = 0: hardware_concurrency(); capacity = 0: twice the thread count
+template <typename F>
+NumericParallelMapStage<F> numericParallelMap(F function, std::size_t threads = 0, std::size_t capacity = 0)
+{
+    threads = numericThreadCount(threads, static_cast<std::size_t>(-1));
+    return {std::move(function), threads, capacity ? capacity : 2 * threads};
+}
+
+template <typename V, typename Op>
+NumericReduceStage<V, Op> numericReduce(V init, Op op)
+{
+    return {std::move(init), std::move(op)};
+}
+
+inline NumericWriteStage numericWrite(std::FILE* file)
+{
+    return {file};
+}
+
+/************************ Stage coroutines ********************************/
+
+template <typename T, typename F>
+NumericGenerator<std::decay_t<std::invoke_result_t<F&, T&&>>> numericMapStream(NumericGenerator<T> input, F function)
+{
+    for (T& value : input) {
+        co_yield std::invoke(function, std::move(value));
+    }
+}
+
+template <typename T, typename P>
+NumericGenerator<T> numericFilterStream(NumericGenerator<T> input, P predicate)
+{
+    for (T& value : input) {
+        if (std::invoke(predicate, std::as_const(value))) {
+            co_yield std::move(value);
+        }
+    }
+}
+
+template <typename T>
+NumericGenerator<NumericChunk<T>> numericChunkStream(NumericGenerator<T> input, std::size_t rows)
+{
+    NumericChunk<T> chunk;
+    chunk.reserve(rows);
+    for (T& value : input) {
+        chunk.push_back(std::move(value));
+        if (chunk.size() == rows) {
+            co_yield std::move(chunk);
+            chunk = NumericChunk<T>();
+            chunk.reserve(rows);
+        }
+    }
+    if (!chunk.empty()) {
+        co_yield std::move(chunk);
+    }
+}
+
+template <typename T>
+NumericGenerator<T> numericThreadedStream(NumericGenerator<T> input, std::size_t capacity)
+{
+    NumericBoundedQueue<T> queue(capacity);
+    std::exception_ptr error;
+    NumericStageThreads threads([&queue] { queue.cancel(); });
+    threads.start([&queue, &error, input = std::move(input)]() mutable {
+        try {
+            for (T& value : input) {
+                if (!queue.push(std::move(value))) {
+                    break;
+                }
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        queue.close();
+    });
+
+    while (std::optional<T> value = queue.pop()) {
+        co_yield std::move(*value);
+    }
+    // close() happened after `error` was set, and pop() saw it under the queue's lock
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * A feeder thread pulls the input and queues, in input order, a future per value for the
+ * consumer and the value with its promise for the workers. The consumer waits on the
+ * futures in order, so at most `capacity` results are pending or done ahead of it.
+ */
+template <typename T, typename F>
+NumericGenerator<std::decay_t<std::invoke_result_t<const F&, T&&>>> numericParallelMapStream(NumericGenerator<T> input, F function,
+                                                                                            std::size_t threads, std::size_t capacity)
+{
+    using R = std::decay_t<std::invoke_result_t<const F&, T&&>>;
+    NumericBoundedQueue<std::future<R>> results(capacity);
+    NumericBoundedQueue<std::pair<std::promise<R>, T>> work(threads);
+    NumericStageThreads workers([&results, &work] {
+        results.cancel();
+        work.cancel();
+    });
+
+    workers.start([&results, &work, input = std::move(input)]() mutable {
+        try {
+            for (T& value : input) {
+                std::promise<R> promise;
+                if (!results.push(promise.get_future()) || !work.push({std::move(promise), std::move(value)})) {
+                    break;
+                }
+            }
+        } catch (...) {
+            std::promise<R> failed;
+            failed.set_exception(std::current_exception());
+            results.push(failed.get_future());
+        }
+        results.close();
+        work.close();
+    });
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.start([&work, &function] {
+            while (std::optional<std::pair<std::promise<R>, T>> item = work.pop()) {
+                try {
+                    item->first.set_value(std::invoke(std::as_const(function), std::move(item->second)));
+                } catch (...) {
+                    item->first.set_exception(std::current_exception());
+                }
+            }
+        });
+    }
+
+    while (std::optional<std::future<R>> result = results.pop()) {
+        co_yield result->get();
+    }
+}
+
+// The values of each text chunk, a field cut between two chunks going with the second
+NumericGenerator<NumericParsedColumns> numericParseChunks(NumericGenerator<std::string> chunks, NumericParseOptions options = {});
+
+template <typename T, typename F>
+auto operator|(NumericGenerator<T> input, NumericMapStage<F> stage)
+{
+    return numericMapStream(std::move(input), std::move(stage.function));
+}
+
+template <typename T, typename P>
+NumericGenerator<T> operator|(NumericGenerator<T> input, NumericFilterStage<P> stage)
+{
+    return numericFilterStream(std::move(input), std::move(stage.predicate));
+}
+
+template <typename T>
+NumericGenerator<NumericChunk<T>> operator|(NumericGenerator<T> input, NumericChunkStage stage)
+{
+    return numericChunkStream(std::move(input), stage.rows);
+}
+
+inline NumericGenerator<NumericParsedColumns> operator|(NumericGenerator<std::string> input, NumericParseStage stage)
+{
+    return numericParseChunks(std::move(input), stage.options);
+}
+
+template <typename T>
+NumericGenerator<T> operator|(NumericGenerator<T> input, NumericThreadStage stage)
+{
+    return numericThreadedStream(std::move(input), stage.capacity);
+}
+
+template <typename T, typename F>
+auto operator|(NumericGenerator<T> input, NumericParallelMapStage<F> stage)
+{
+    return numericParallelMapStream(std::move(input), std::move(stage.function), stage.threads, stage.capacity);
+}
+
+template <typename T, typename V, typename Op>
+V operator|(NumericGenerator<T> input, NumericReduceStage<V, Op> stage)
+{
+    V total = std::move(stage.init);
+    for (T& value : input) {
+        total = std::invoke(stage.op, std::move(total), std::move(value));
+    }
+    return total;
+}
+
+// Bytes written
+template <typename T>
+std::size_t operator|(NumericGenerator<T> input, NumericWriteStage stage)
+{
+    std::size_t bytes = 0;
+    for (T& value : input) {
+        const std::string_view text = value;
+        if (std::fwrite(text.data(), 1, text.size(), stage.file) != text.size()) {
+            throw std::runtime_error("numericWrite: Write failed.");
+        }
+        bytes += text.size();
+    }
+    return bytes;
+}
+
+/************************ Sources ********************************/
+
+// `chunkSize` bytes at a time (the last chunk may be shorter); the file or stream must outlive the generator
+NumericGenerator<std::string> numericReadChunks(std::FILE* file, std::size_t chunkSize = std::size_t(1) << 20);
+NumericGenerator<std::string> numericReadChunks(std::istream& stream, std::size_t chunkSize = std::size_t(1) << 20);
+
+#endif // __NUMERIC_STREAM_HPP__
@@ -0,0 +1,98 @@
+#ifndef __NUMERIC_VALUE_HPP__
+#define __NUMERIC_VALUE_HPP__
+
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+#include "Numeric.hpp"
+
+/**
+ * Value-semantic counterpart of the Numeric hierarchy.
+ *
+ * A NumericValue holds one of the value types the Numeric classes store, inline, with
+ * no vptr and no heap allocation, so millions of them can sit contiguously in a
+ * std::vector<NumericValue>. Arithmetic and comparisons run the same kernels as the
+ * Numeric classes (NumericKernels.hpp), so promotion rules, results and error messages
+ * are identical: a NumericValue holding an int behaves like an IntNumeric, one holding
+ * a char behaves like a charNumeric<char>, and so on.
+ *
+ * FloatNumeric<long double>, ComplexNumeric<long double>, BigIntNumeric (which
+ * allocates), DecimalNumeric and the 16-bit FloatNumeric kinds have no NumericValue
+ * counterpart; converting them throws "Unsupported conversion".
+ */
+class NumericValue
+{
+    public:
+    using Storage = std::variant<int, float, double, std::complex<float>, std::complex<double>,
+                                 char, wchar_t, char16_t, char32_t,
+                                 std::int8_t, std::int16_t, std::int64_t, std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t>;
+
+    template <typename T>
+    static constexpr bool holds = IntegerValue<T> || std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                                  std::is_same_v<T, std::complex<float>> || std::is_same_v<T, std::complex<double>> ||
+                                  charTemp<T>;
+
+    NumericValue() : storage(std::in_place_type<int>, 0) {}
+
+    // Stores exactly T: NumericValue('A') behaves like charNumeric<char>, NumericValue(65) like IntNumeric
+    template <typename T>
+        requires holds<T>
+    NumericValue(T value) : storage(std::in_place_type<T>, value) {}
+
+    // Same dispatch as Numeric::create (bool and the characters become an int, other integers keep their width)
+    template <typename T>
+    static NumericValue create(T value)
+    {
+        if constexpr (std::is_same_v<T, bool> || charTemp<T>) {
+            return NumericValue(static_cast<int>(value));
+        } else if constexpr (std::is_integral_v<T>) {
+            return NumericValue(static_cast<NumericIntegerType<T>>(value));
+        } else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+            return NumericValue(value);
+        } else if constexpr (std::is_same_v<T, std::complex<float>> || std::is_same_v<T, std::complex<double>>) {
+            return NumericValue(value);
+        } else {
+            throw std::runtime_error("Unsupported type");
+        }
+    }
+
+    static NumericValue fromNumeric(const Numeric& numeric);
+    std::unique_ptr<Numeric> toNumeric() const;
+
+    NumericKind kind() const;
+    const Storage& value() const { return storage; }
+
+    template <typename T>
+    const T& get() const { return std::get<T>(storage); }
+
+    /**
+     * Non-throwing forms of the operators: the result is written only when the
+     * returned error is NumericError::None.
+     */
+    static NumericError apply(NumericOp op, const NumericValue& first, const NumericValue& second, NumericValue& result);
+    static NumericError compare(NumericOp op, const NumericValue& first, const NumericValue& second, bool& result);
+
+    NumericValue operator+(const NumericValue& second) const { return applyOrThrow(NumericOp::Sum, second); }
+    NumericValue operator-(const NumericValue& second) const { return applyOrThrow(NumericOp::Subtract, second); }
+    NumericValue operator*(const NumericValue& second) const { return applyOrThrow(NumericOp::Multiply, second); }
+    NumericValue operator/(const NumericValue& second) const { return applyOrThrow(NumericOp::Divide, second); }
+
+    // Like lessThanOperation & co, the right operand is converted to the left operand's type
+    bool operator<(const NumericValue& second) const { return compareOrThrow(NumericOp::LessThan, second); }
+    bool operator>(const NumericValue& second) const { return compareOrThrow(NumericOp::GreaterThan, second); }
+    bool operator==(const NumericValue& second) const { return compareOrThrow(NumericOp::Equal, second); }
+
+    std::string toString() const;
+
+    private:
+    Storage storage;
+
+    NumericValue applyOrThrow(NumericOp op, const NumericValue& second) const;
+    bool compareOrThrow(NumericOp op, const NumericValue& second) const;
+};
+
+#endif // __NUMERIC_VALUE_HPP__
@@ -0,0 +1,130 @@
+#include "NumericMemory.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Allocations per operation and throughput of an accumulation loop, with results
+ * allocated by the default make_unique path, a NumericPool and a NumericArena, and
+ * with the in-place addAssign that only allocates when the total has to widen.
+ *
+ * Build target: numeric_allocation_bench (see CMakeLists.txt)
+ */
+
+namespace {
+
+std::size_t heapAllocations = 0;
+
+} // namespace
+
+// Count every trip to the global heap made by the process
+void* operator new(std::size_t size)
+{
+    ++heapAllocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t valueCount = 4096;
+constexpr int rounds = 200;
+
+std::vector<std::unique_ptr<Numeric>> makeValues()
+{
+    std::vector<std::unique_ptr<Numeric>> values;
+    values.reserve(valueCount);
+    for (std::size_t i = 0; i < valueCount; ++i) {
+        switch (i % 4) {
+            case 0: values.push_back(Numeric::create(static_cast<int>(i % 100 + 1))); break;
+            case 1: values.push_back(Numeric::create(static_cast<float>(i % 50) + 0.5f)); break;
+            case 2: values.push_back(Numeric::create(static_cast<double>(i % 70) + 0.25)); break;
+            default: values.push_back(Numeric::create(std::complex<double>(1.0, static_cast<double>(i % 3)))); break;
+        }
+    }
+    return values;
+}
+
+// One round: fold every value into a running total, converting each operand to double on the way
+std::size_t evaluate(const std::vector<std::unique_ptr<Numeric>>& values)
+{
+    std::unique_ptr<Numeric> total = Numeric::create(0.0);
+    for (const auto& value : values) {
+        auto promoted = value->convertTo(NumericKind::ComplexDouble);
+        total = total->sumOperation(*promoted);
+    }
+    return total->toString().size();
+}
+
+// Same fold with addAssign: the double total widens to complex<double> once, then stays in place
+std::size_t evaluateInPlace(const std::vector<std::unique_ptr<Numeric>>& values)
+{
+    std::unique_ptr<Numeric> total = Numeric::create(0.0);
+    for (const auto& value : values) {
+        if (auto widened = total->addAssign(*value)) {
+            total = std::move(widened);
+        }
+    }
+    return total->toString().size();
+}
+
+// The convertTo + sumOperation fold does two operations per value, the addAssign fold one
+void report(const char* name, double operationsPerValue, std::size_t allocations, double seconds)
+{
+    const double operations = operationsPerValue * valueCount * rounds;
+    std::printf("%-10s %8.3f heap allocations/op %10.1f M ops/sec\n", name, allocations / operations, operations / seconds / 1e6);
+}
+
+} // namespace
+
+int main()
+{
+    auto values = makeValues();
+    std::size_t sink = 0;
+
+    std::size_t before = heapAllocations;
+    auto start = Clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        sink += evaluate(values);
+    }
+    report("make_unique", 2, heapAllocations - before, std::chrono::duration<double>(Clock::now() - start).count());
+
+    NumericPool pool;
+    before = heapAllocations;
+    start = Clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        NumericAllocationScope scope(pool);
+        sink += evaluate(values);
+    }
+    report("pool", 2, heapAllocations - before, std::chrono::duration<double>(Clock::now() - start).count());
+
+    NumericArena arena;
+    before = heapAllocations;
+    start = Clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        {
+            NumericAllocationScope scope(arena);
+            sink += evaluate(values);
+        }
+        arena.reset();
+    }
+    report("arena", 2, heapAllocations - before, std::chrono::duration<double>(Clock::now() - start).count());
+
+    before = heapAllocations;
+    start = Clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        sink += evaluateInPlace(values);
+    }
+    report("addAssign", 1, heapAllocations - before, std::chrono::duration<double>(Clock::now() - start).count());
+
+    return sink == 0;
+}
@@ -0,0 +1,84 @@
+#include "NumericColumn.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * Element-wise throughput: std::vector<std::unique_ptr<Numeric>> versus NumericColumn<T>
+ * at every instruction set level the CPU supports.
+ *
+ * Build target: numeric_column_bench (see CMakeLists.txt)
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t elements = 1 << 20;
+constexpr int rounds = 20;
+
+const char* levelNames[] = {"scalar", "avx2", "avx512"};
+
+template <typename T>
+void runType(const char* name)
+{
+    NumericColumn<T> lhs(elements), rhs(elements);
+    std::vector<std::unique_ptr<Numeric>> boxedLhs, boxedRhs;
+    for (std::size_t i = 0; i < elements; ++i) {
+        lhs[i] = static_cast<T>(i % 1000 + 1);
+        rhs[i] = static_cast<T>(i % 97 + 1);
+        boxedLhs.push_back(lhs.at(i));
+        boxedRhs.push_back(rhs.at(i));
+    }
+
+    const NumericOp ops[] = {NumericOp::Sum, NumericOp::Multiply, NumericOp::Divide, NumericOp::LessThan};
+    for (NumericOp op : ops) {
+        // Boxed baseline: one virtual call and one allocation per element
+        auto start = Clock::now();
+        std::size_t sink = 0;
+        for (std::size_t i = 0; i < elements; ++i) {
+            if (op == NumericOp::LessThan) {
+                sink += boxedLhs[i]->lessThanOperation(*boxedRhs[i]);
+            } else {
+                sink += Numeric::apply(op, *boxedLhs[i], *boxedRhs[i]) != nullptr;
+            }
+        }
+        double boxedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::printf("%-8s %-18s %-8s %10.1f M elements/sec\n", name, numericOpName(op), "boxed", elements / boxedSeconds / 1e6);
+
+        for (int level = 0; level <= static_cast<int>(NumericSimdLevel::Avx512); ++level) {
+            setNumericSimdLevel(static_cast<NumericSimdLevel>(level));
+            if (numericSimdLevel() != static_cast<NumericSimdLevel>(level)) {
+                continue;
+            }
+            start = Clock::now();
+            for (int round = 0; round < rounds; ++round) {
+                if (op == NumericOp::LessThan) {
+                    sink += lhs.lessThanOperation(rhs).count();
+                } else if (op == NumericOp::Sum) {
+                    sink += lhs.sumOperation(rhs).size();
+                } else if (op == NumericOp::Multiply) {
+                    sink += lhs.multiplyOperation(rhs).size();
+                } else {
+                    sink += lhs.divideOperation(rhs).size();
+                }
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            std::printf("%-8s %-18s %-8s %10.1f M elements/sec\n", name, numericOpName(op), levelNames[level],
+                        double(elements) * rounds / seconds / 1e6);
+        }
+        if (sink == 0) {
+            std::printf("unexpected empty result\n");
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    runType<int>("int");
+    runType<float>("float");
+    runType<double>("double");
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "Numeric.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * Mixed-pair throughput of the *Operation methods.
+ *
+ * Build target: numeric_dispatch_bench (see CMakeLists.txt)
+ *
+ * Every supported (lhs, rhs, op) combination of the sample values below is run in a
+ * tight loop; pairs the library rejects (e.g. int + char) are skipped. Only the public
+ * API is used so the same file can be built against older revisions for comparison.
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr long iterations = 200000;
+
+struct Sample
+{
+    const char* name;
+    std::unique_ptr<Numeric> value;
+};
+
+std::vector<Sample> samples()
+{
+    std::vector<Sample> values;
+    values.push_back({"int", std::make_unique<IntNumeric>(7)});
+    values.push_back({"float", std::make_unique<FloatNumeric<float>>(2.5f)});
+    values.push_back({"double", std::make_unique<FloatNumeric<double>>(3.25)});
+    values.push_back({"complex<float>", std::make_unique<ComplexNumeric<float>>(std::complex<float>(1, 2))});
+    values.push_back({"complex<double>", std::make_unique<ComplexNumeric<double>>(std::complex<double>(-3, 0.5))});
+    values.push_back({"char", std::make_unique<charNumeric<char>>('A')});
+    return values;
+}
+
+const char* opNames[] = {"sum", "subtract", "multiply", "divide", "lessThan", "greaterThan", "equal"};
+
+// Returns a value derived from the result so the loop cannot be optimised away
+long runOnce(int op, Numeric& lhs, const Numeric& rhs)
+{
+    switch (op) {
+        case 0: return lhs.sumOperation(rhs) != nullptr;
+        case 1: return lhs.subtractOperation(rhs) != nullptr;
+        case 2: return lhs.multiplyOperation(rhs) != nullptr;
+        case 3: return lhs.divideOperation(rhs) != nullptr;
+        case 4: return lhs.lessThanOperation(rhs);
+        case 5: return lhs.greaterThanOperation(rhs);
+        default: return lhs.equalOperation(rhs);
+    }
+}
+
+bool supported(int op, Numeric& lhs, const Numeric& rhs)
+{
+    try {
+        runOnce(op, lhs, rhs);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // namespace
+
+int main()
+{
+    auto values = samples();
+
+    double mixedOps = 0, mixedSeconds = 0;
+    double sameOps = 0, sameSeconds = 0;
+    long sink = 0;
+
+    std::printf("%-16s %-16s %-12s %14s\n", "lhs", "rhs", "op", "ops/sec");
+    for (auto& lhs : values) {
+        for (auto& rhs : values) {
+            for (int op = 0; op < 7; ++op) {
+                if (!supported(op, *lhs.value, *rhs.value)) {
+                    continue;
+                }
+
+                auto start = Clock::now();
+                for (long i = 0; i < iterations; ++i) {
+                    sink += runOnce(op, *lhs.value, *rhs.value);
+                }
+                double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+                std::printf("%-16s %-16s %-12s %14.0f\n", lhs.name, rhs.name, opNames[op], iterations / seconds);
+                if (&lhs == &rhs) {
+                    sameOps += iterations;
+                    sameSeconds += seconds;
+                } else {
+                    mixedOps += iterations;
+                    mixedSeconds += seconds;
+                }
+            }
+        }
+    }
+
+    std::printf("\nsame-type pairs:  %14.0f ops/sec\n", sameOps / sameSeconds);
+    std::printf("mixed-type pairs: %14.0f ops/sec\n", mixedOps / mixedSeconds);
+    return sink == 0;
+}
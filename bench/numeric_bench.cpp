@@ -0,0 +1,1689 @@
+#include "Numeric.hpp"
+#include "NumericArithmetic.hpp"
+#include "NumericColumn.hpp"
+#include "NumericComplex.hpp"
+#include "NumericCompress.hpp"
+#include "NumericExpression.hpp"
+#include "NumericFile.hpp"
+#include "NumericFormat.hpp"
+#include "NumericFormula.hpp"
+#include "NumericHash.hpp"
+#include "NumericIndex.hpp"
+#include "NumericParse.hpp"
+#include "NumericReduce.hpp"
+#include "NumericSort.hpp"
+#include "NumericStats.hpp"
+#include "NumericStream.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Benchmark suite for the Numeric API, reported as JSON so a pipeline can gate on it.
+ *
+ * Groups (the first part of the "group/name" that --filter matches):
+ *  - sumOperation ... equalOperation: every (lhs kind, rhs kind) pair for each operation
+ *  - applyBatch, expression, static: batches, expression templates, numericAdd/...
+ *  - create, convertTo, toString, formatTo, bulkFormat, parse: construction and text
+ *  - sort: numericSort, and the std::sort with lessThanOperation pattern of main.cpp
+ *  - file, reduce, complex: mapped columns, threaded reductions, split complex columns
+ *  - integer, bigint, decimal, half: overflow policies, NumericBigInt against the
+ *    quadratic algorithms, decimals against int64 / double, float16 / bfloat16
+ *  - groupBy, index: NumericHashMap and group-by, zone maps and the sorted index
+ *  - compress: each column encoding, decoded and operated on while encoded
+ *  - stream, formula, stats: coroutine pipelines, compiled formulas, NumericStats
+ * Pairs the library rejects are still measured (the cost of the error path) and flagged
+ * with "supported": false.
+ *
+ * Build target: numeric_bench (see CMakeLists.txt)
+ * Usage: numeric_bench [--min-time-ms N] [--filter SUBSTRING] [--out FILE]
+ *
+ * Each entry reports ns_per_op, allocs_per_op (calls to the global operator new, aligned
+ * forms included) and ops_per_sec (null when ns_per_op is 0). Entries that process bytes
+ * (parsing) also report gb_per_sec, and the decode entries of the compression group
+ * report compression_ratio.
+ * "stats" in the context tells whether the library was built with NUMERIC_ENABLE_STATS,
+ * so the overhead of the instrumentation is the difference between two such runs.
+ */
+
+#ifndef NUMERIC_BUILD_TYPE
+#define NUMERIC_BUILD_TYPE "unknown"
+#endif
+
+namespace {
+
+// Atomic because the threaded benches (reduce, groupBy, the stream pipeline) allocate on several threads at once
+std::atomic<std::size_t> heapAllocations = 0;
+
+// Every replaced operator new counts here; both kinds of block are released with std::free
+void* countedAllocation(std::size_t size, std::size_t alignment)
+{
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    size = size ? size : 1;
+    void* p = alignment > alignof(std::max_align_t) ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+                                                    : std::malloc(size);
+    if (p) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+// The array and nothrow forms call these, so replacing them covers every allocation
+void* operator new(std::size_t size) { return countedAllocation(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAllocation(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchmarkResult
+{
+    std::string group;
+    std::string name;
+    bool supported;
+    long iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    double gbPerSec;   // 0 unless the benchmark reports bytes
+    double compressionRatio;   // 0 unless the benchmark reports one
+};
+
+class Suite
+{
+    public:
+    double minSeconds = 0.01;
+    std::string filter;
+    std::vector<BenchmarkResult> results;
+
+    // `body(n)` runs n iterations of `opsPerIteration` operations and returns something derived from the results;
+    // with `bytesPerIteration` the entry also reports gb_per_sec, with `compressionRatio` compression_ratio
+    void run(const std::string& group, const std::string& name, bool supported, const std::function<std::size_t(long)>& body,
+             std::size_t opsPerIteration = 1, std::size_t bytesPerIteration = 0, double compressionRatio = 0)
+    {
+        const std::string fullName = group + "/" + name;
+        if (!filter.empty() && fullName.find(filter) == std::string::npos) {
+            return;
+        }
+
+        long iterations = 1;
+        for (;;) {
+            std::size_t allocationsBefore = heapAllocations.load();
+            auto start = Clock::now();
+            sink += body(iterations);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            std::size_t allocations = heapAllocations.load() - allocationsBefore;
+
+            if (seconds >= minSeconds || iterations >= (1L << 30)) {
+                double operations = static_cast<double>(iterations) * opsPerIteration;
+                double gigabytes = static_cast<double>(iterations) * bytesPerIteration / 1e9;
+                results.push_back({group, name, supported, iterations, seconds * 1e9 / operations, allocations / operations,
+                                   seconds > 0 ? gigabytes / seconds : 0, compressionRatio});
+                return;
+            }
+            double scale = seconds > 0 ? (minSeconds / seconds) * 1.2 : 10.0;
+            iterations = static_cast<long>(iterations * std::clamp(scale, 2.0, 100.0));
+        }
+    }
+
+    void writeJson(std::FILE* out) const
+    {
+        static const char* levels[] = {"scalar", "avx2", "avx512"};
+        std::fprintf(out, "{\n  \"context\": {\n");
+        std::fprintf(out, "    \"build_type\": \"%s\",\n", NUMERIC_BUILD_TYPE);
+        std::fprintf(out, "    \"compiler\": \"%s\",\n", __VERSION__);
+        std::fprintf(out, "    \"simd_level\": \"%s\",\n", levels[static_cast<int>(numericSimdLevel())]);
+        std::fprintf(out, "    \"stats\": %s,\n", numericStatsEnabled ? "true" : "false");
+        std::fprintf(out, "    \"min_time_ms\": %.3f\n  },\n  \"benchmarks\": [\n", minSeconds * 1e3);
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult& r = results[i];
+            char throughput[96] = "";
+            if (r.gbPerSec > 0) {
+                std::snprintf(throughput, sizeof(throughput), ", \"gb_per_sec\": %.3f", r.gbPerSec);
+            }
+            if (r.compressionRatio > 0) {
+                const std::size_t used = std::strlen(throughput);
+                std::snprintf(throughput + used, sizeof(throughput) - used, ", \"compression_ratio\": %.2f", r.compressionRatio);
+            }
+            // A body faster than the clock measures 0 ns, and JSON has no inf
+            char opsPerSec[32] = "null";
+            if (r.nsPerOp > 0) {
+                std::snprintf(opsPerSec, sizeof(opsPerSec), "%.1f", 1e9 / r.nsPerOp);
+            }
+            std::fprintf(out,
+                         "    {\"group\": \"%s\", \"name\": \"%s\", \"supported\": %s, \"iterations\": %ld, "
+                         "\"ns_per_op\": %.3f, \"allocs_per_op\": %.3f, \"ops_per_sec\": %s%s}%s\n",
+                         r.group.c_str(), r.name.c_str(), r.supported ? "true" : "false", r.iterations, r.nsPerOp,
+                         r.allocsPerOp, opsPerSec, throughput, i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(out, "  ],\n  \"checksum\": %zu\n}\n", sink);
+    }
+
+    private:
+    std::size_t sink = 0;
+};
+
+std::unique_ptr<Numeric> sample(NumericKind kind)
+{
+    switch (kind) {
+        case NumericKind::Int:               return std::make_unique<IntNumeric>(7);
+        case NumericKind::Float:             return std::make_unique<FloatNumeric<float>>(2.5f);
+        case NumericKind::Double:            return std::make_unique<FloatNumeric<double>>(3.25);
+        case NumericKind::LongDouble:        return std::make_unique<FloatNumeric<long double>>(1.5L);
+        case NumericKind::ComplexFloat:      return std::make_unique<ComplexNumeric<float>>(std::complex<float>(1, 2));
+        case NumericKind::ComplexDouble:     return std::make_unique<ComplexNumeric<double>>(std::complex<double>(-3, 0.5));
+        case NumericKind::ComplexLongDouble: return std::make_unique<ComplexNumeric<long double>>(std::complex<long double>(2, -1));
+        case NumericKind::Char:              return std::make_unique<charNumeric<char>>('A');
+        case NumericKind::WChar:             return std::make_unique<charNumeric<wchar_t>>(L'B');
+        case NumericKind::Char16:            return std::make_unique<charNumeric<char16_t>>(u'C');
+        case NumericKind::Char32:            return std::make_unique<charNumeric<char32_t>>(U'D');
+        case NumericKind::Int8:              return std::make_unique<IntegerNumeric<std::int8_t>>(7);
+        case NumericKind::Int16:             return std::make_unique<IntegerNumeric<std::int16_t>>(7);
+        case NumericKind::Int64:             return std::make_unique<IntegerNumeric<std::int64_t>>(7);
+        case NumericKind::UInt8:             return std::make_unique<IntegerNumeric<std::uint8_t>>(7);
+        case NumericKind::UInt16:            return std::make_unique<IntegerNumeric<std::uint16_t>>(7);
+        case NumericKind::UInt32:            return std::make_unique<IntegerNumeric<std::uint32_t>>(7);
+        case NumericKind::UInt64:            return std::make_unique<IntegerNumeric<std::uint64_t>>(7);
+        case NumericKind::Decimal2:          return std::make_unique<DecimalNumeric<2>>(NumericDecimal2::fromUnits(725));
+        case NumericKind::Decimal6:          return std::make_unique<DecimalNumeric<6>>(NumericDecimal6::fromUnits(7250000));
+        case NumericKind::Decimal18:         return std::make_unique<DecimalNumeric<18, NumericInt128>>(NumericDecimal18(7));
+        case NumericKind::Float16:           return std::make_unique<FloatNumeric<NumericFloat16>>(NumericFloat16(2.5));
+        case NumericKind::BFloat16:          return std::make_unique<FloatNumeric<NumericBFloat16>>(NumericBFloat16(2.5));
+        default:                             return std::make_unique<BigIntNumeric>(NumericBigInt(7));
+    }
+}
+
+std::size_t runOperation(NumericOp op, Numeric& lhs, const Numeric& rhs)
+{
+    switch (op) {
+        case NumericOp::Sum:         return lhs.sumOperation(rhs) != nullptr;
+        case NumericOp::Subtract:    return lhs.subtractOperation(rhs) != nullptr;
+        case NumericOp::Multiply:    return lhs.multiplyOperation(rhs) != nullptr;
+        case NumericOp::Divide:      return lhs.divideOperation(rhs) != nullptr;
+        case NumericOp::LessThan:    return lhs.lessThanOperation(rhs);
+        case NumericOp::GreaterThan: return lhs.greaterThanOperation(rhs);
+        default:                     return lhs.equalOperation(rhs);
+    }
+}
+
+void benchOperations(Suite& suite)
+{
+    for (std::size_t op = 0; op < numericOpCount; ++op) {
+        for (std::size_t l = 0; l < numericKindCount; ++l) {
+            for (std::size_t r = 0; r < numericKindCount; ++r) {
+                auto lhs = sample(NumericKind(l));
+                auto rhs = sample(NumericKind(r));
+                bool supported = true;
+                try {
+                    runOperation(NumericOp(op), *lhs, *rhs);
+                } catch (const std::exception&) {
+                    supported = false;
+                }
+
+                std::string name = std::string(numericKindName(NumericKind(l))) + "/" + numericKindName(NumericKind(r));
+                suite.run(numericOpName(NumericOp(op)), name, supported, [&](long n) {
+                    std::size_t sink = 0;
+                    for (long i = 0; i < n; ++i) {
+                        try {
+                            sink += runOperation(NumericOp(op), *lhs, *rhs);
+                        } catch (const std::exception&) {
+                            ++sink;
+                        }
+                    }
+                    return sink;
+                });
+            }
+        }
+    }
+}
+
+/**
+ * Numeric::applyBatch over 1024 elements, uniform pairs and runs of 16 alternating pairs,
+ * next to the same work done with one apply() per element. One op = one element.
+ */
+void benchBatch(Suite& suite)
+{
+    constexpr std::size_t count = 1024;
+    const std::pair<NumericKind, NumericKind> pairs[] = {
+        {NumericKind::Int, NumericKind::Int},
+        {NumericKind::Double, NumericKind::Double},
+        {NumericKind::Int, NumericKind::Double},
+        {NumericKind::ComplexFloat, NumericKind::ComplexFloat},
+    };
+
+    auto runBatch = [&](const std::string& name, NumericOp op, auto kindsAt) {
+        std::vector<std::unique_ptr<Numeric>> owned;
+        std::vector<const Numeric*> first, second;
+        for (std::size_t i = 0; i < count; ++i) {
+            auto [lhs, rhs] = kindsAt(i);
+            owned.push_back(sample(lhs));
+            first.push_back(owned.back().get());
+            owned.push_back(sample(rhs));
+            second.push_back(owned.back().get());
+        }
+        std::vector<std::unique_ptr<Numeric>> out(count);
+        NumericMask errors;
+
+        suite.run("applyBatch", std::string(numericOpName(op)) + "/" + name + "/batch", true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += Numeric::applyBatch(op, first, second, out, errors);
+            }
+            return sink;
+        }, count);
+        suite.run("applyBatch", std::string(numericOpName(op)) + "/" + name + "/apply", true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                for (std::size_t j = 0; j < count; ++j) {
+                    out[j] = Numeric::apply(op, *first[j], *second[j]);
+                }
+                sink += out[0] != nullptr;
+            }
+            return sink;
+        }, count);
+    };
+
+    for (NumericOp op : {NumericOp::Sum, NumericOp::Divide}) {
+        for (auto [lhs, rhs] : pairs) {
+            std::string name = std::string(numericKindName(lhs)) + "/" + numericKindName(rhs);
+            runBatch(name, op, [lhs = lhs, rhs = rhs](std::size_t) { return std::pair(lhs, rhs); });
+        }
+        runBatch("mixed-runs-16", op, [&pairs](std::size_t i) { return pairs[(i / 16) % 4]; });
+    }
+}
+
+/**
+ * a * b + c / d over 4096-element double columns: fused expression template, one column
+ * operation per step (three temporary columns), and the boxed virtual path. One op = one element.
+ */
+void benchExpression(Suite& suite)
+{
+    constexpr std::size_t count = 4096;
+    NumericColumn<double> a, b, c, d, out;
+    std::vector<std::unique_ptr<Numeric>> boxedA, boxedB, boxedC, boxedD;
+    for (std::size_t i = 0; i < count; ++i) {
+        a.push_back(1.0 + i);
+        b.push_back(0.5 * i);
+        c.push_back(3.0 - i);
+        d.push_back(1.0 + i % 7);
+        boxedA.push_back(Numeric::create(a[i]));
+        boxedB.push_back(Numeric::create(b[i]));
+        boxedC.push_back(Numeric::create(c[i]));
+        boxedD.push_back(Numeric::create(d[i]));
+    }
+
+    suite.run("expression", "a*b+c/d/double/fused", true, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            numericEvaluate(a * b + c / d, out);
+        }
+        return static_cast<std::size_t>(out[1]);
+    }, count);
+    suite.run("expression", "a*b+c/d/double/column-steps", true, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            out = a.multiplyOperation(b).sumOperation(c.divideOperation(d));
+        }
+        return static_cast<std::size_t>(out[1]);
+    }, count);
+    suite.run("expression", "a*b+c/d/double/virtual", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < count; ++j) {
+                auto product = boxedA[j]->multiplyOperation(*boxedB[j]);
+                auto quotient = boxedC[j]->divideOperation(*boxedD[j]);
+                sink += product->sumOperation(*quotient) != nullptr;
+            }
+        }
+        return sink;
+    }, count);
+}
+
+// One mixed-type add (int + double) per op: static call vs dispatch table vs virtual call
+void benchStatic(Suite& suite)
+{
+    constexpr std::size_t count = 4096;
+    std::vector<int> ints;
+    std::vector<double> doubles;
+    std::vector<std::unique_ptr<Numeric>> boxedInts, boxedDoubles;
+    for (std::size_t i = 0; i < count; ++i) {
+        ints.push_back(static_cast<int>(i));
+        doubles.push_back(0.5 * i);
+        boxedInts.push_back(Numeric::create(ints[i]));
+        boxedDoubles.push_back(Numeric::create(doubles[i]));
+    }
+
+    suite.run("static", "int+double/numericAdd", true, [&](long n) {
+        double sum = 0;
+        for (long i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < count; ++j) {
+                sum += numericAdd(ints[j], doubles[j]);
+            }
+        }
+        return static_cast<std::size_t>(sum);
+    }, count);
+    suite.run("static", "int+double/Numeric::apply", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < count; ++j) {
+                sink += Numeric::apply(NumericOp::Sum, *boxedInts[j], *boxedDoubles[j]) != nullptr;
+            }
+        }
+        return sink;
+    }, count);
+    suite.run("static", "int+double/sumOperation", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < count; ++j) {
+                sink += boxedInts[j]->sumOperation(*boxedDoubles[j]) != nullptr;
+            }
+        }
+        return sink;
+    }, count);
+}
+
+template <typename T>
+void benchCreate(Suite& suite, const char* name, T value)
+{
+    suite.run("create", name, true, [value](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += Numeric::create(value) != nullptr;
+        }
+        return sink;
+    });
+}
+
+void benchConversions(Suite& suite)
+{
+    for (std::size_t from = 0; from < numericKindCount; ++from) {
+        auto source = sample(NumericKind(from));
+        for (std::size_t to = 0; to < numericKindCount; ++to) {
+            auto target = sample(NumericKind(to));
+            const std::type_info& targetType = typeid(*target);
+            bool supported = true;
+            try {
+                source->convertTo(targetType);
+            } catch (const std::exception&) {
+                supported = false;
+            }
+
+            std::string name = std::string(numericKindName(NumericKind(from))) + "/" + numericKindName(NumericKind(to));
+            suite.run("convertTo", name, supported, [&](long n) {
+                std::size_t sink = 0;
+                for (long i = 0; i < n; ++i) {
+                    try {
+                        sink += source->convertTo(targetType) != nullptr;
+                    } catch (const std::exception&) {
+                        ++sink;
+                    }
+                }
+                return sink;
+            });
+        }
+    }
+}
+
+void benchToString(Suite& suite)
+{
+    for (std::size_t kind = 0; kind < numericKindCount; ++kind) {
+        auto value = sample(NumericKind(kind));
+        suite.run("toString", numericKindName(NumericKind(kind)), true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += value->toString().size();
+            }
+            return sink;
+        });
+        suite.run("formatTo", numericKindName(NumericKind(kind)), true, [&](long n) {
+            char buffer[numericFormatBufferSize];
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += value->formatTo(buffer, sizeof(buffer));
+            }
+            return sink;
+        });
+    }
+
+    // Bulk export of 100000 doubles with full precision; one op = one value
+    constexpr std::size_t count = 100000;
+    std::mt19937_64 random(11);
+    std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+    NumericColumn<double> column;
+    std::vector<std::unique_ptr<Numeric>> boxed;
+    for (std::size_t i = 0; i < count; ++i) {
+        column.push_back(distribution(random));
+        boxed.push_back(Numeric::create(column[i]));
+    }
+
+    NumericTextWriter writer;
+    suite.run("bulkFormat", "NumericTextWriter/column<double>", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            writer.clear();
+            writer.write(column);
+            sink += writer.size();
+        }
+        return sink;
+    }, count);
+    suite.run("bulkFormat", "NumericTextWriter/vector<double>", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            writer.clear();
+            writer.write(boxed);
+            sink += writer.size();
+        }
+        return sink;
+    }, count);
+    suite.run("bulkFormat", "toString/vector<double>", true, [&](long n) {
+        std::string text;
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            text.clear();
+            for (const auto& value : boxed) {
+                text += value->toString();
+                text += '\n';
+            }
+            sink += text.size();
+        }
+        return sink;
+    }, count);
+}
+
+/**
+ * The sort of main.cpp on a larger mixed vector (int, float, double, complex<float>),
+ * against numericSort on the same data and on a double column. Values are integral so
+ * the lessThanOperation ordering is a strict weak order across kinds, which std::sort
+ * requires. One op = one sorted element.
+ */
+void benchSort(Suite& suite)
+{
+    for (std::size_t count : {1000, 100000}) {
+        std::vector<std::unique_ptr<Numeric>> values;
+        for (std::size_t i = 0; i < count; ++i) {
+            int v = static_cast<int>(i);
+            switch (i % 4) {
+                case 0: values.push_back(Numeric::create(v)); break;
+                case 1: values.push_back(Numeric::create(static_cast<float>(v))); break;
+                case 2: values.push_back(Numeric::create(static_cast<double>(v))); break;
+                default: values.push_back(Numeric::create(std::complex<float>(static_cast<float>(v), 0))); break;
+            }
+        }
+        std::shuffle(values.begin(), values.end(), std::mt19937(42));
+
+        std::vector<Numeric*> order;
+        for (const auto& value : values) {
+            order.push_back(value.get());
+        }
+
+        suite.run("sort", "std::sort/lessThanOperation/" + std::to_string(count), true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                std::vector<Numeric*> work = order;
+                std::sort(work.begin(), work.end(), [](Numeric* a, Numeric* b) {
+                    return a->lessThanOperation(*b);
+                });
+                sink += work.front()->kind() == NumericKind::Int;
+            }
+            return sink;
+        }, count);
+
+        for (auto algorithm : {NumericSortAlgorithm::Radix, NumericSortAlgorithm::Merge}) {
+            const char* algorithmName = algorithm == NumericSortAlgorithm::Radix ? "radix" : "merge";
+            suite.run("sort", std::string("numericSort/") + algorithmName + "/" + std::to_string(count), true, [&](long n) {
+                std::size_t sink = 0;
+                for (long i = 0; i < n; ++i) {
+                    std::vector<std::unique_ptr<Numeric>> work;
+                    work.reserve(count);
+                    for (Numeric* value : order) {
+                        work.emplace_back(value);
+                    }
+                    numericSort(work, {algorithm});
+                    sink += work.front()->kind() == NumericKind::Int;
+                    for (auto& value : work) {
+                        value.release();   // still owned by `values`
+                    }
+                }
+                return sink;
+            }, count);
+        }
+
+        NumericColumn<double> column;
+        std::mt19937_64 random(7);
+        std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+        for (std::size_t i = 0; i < count; ++i) {
+            column.push_back(distribution(random));
+        }
+        suite.run("sort", "numericSort/column<double>/" + std::to_string(count), true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                NumericColumn<double> work = column;
+                numericSort(work);
+                sink += work[0] < work[count - 1];
+            }
+            return sink;
+        }, count);
+    }
+}
+
+
+// Mixed CSV text (int, decimal, complex, char fields): one op is one field
+void benchParse(Suite& suite)
+{
+    constexpr std::size_t rows = 250000;
+    NumericColumn<int> ints;
+    NumericColumn<double> doubles;
+    NumericColumn<std::complex<float>> complexes;
+    NumericColumn<char> chars;
+    std::mt19937 random(11);
+    std::uniform_int_distribution<int> integers(-1000000, 1000000);
+    for (std::size_t i = 0; i < rows; ++i) {
+        ints.push_back(integers(random));
+        doubles.push_back(integers(random) / 64.0);
+        complexes.push_back(std::complex<float>(static_cast<float>(integers(random)) / 4, static_cast<float>(i)));
+        chars.push_back(static_cast<char>('A' + i % 26));
+    }
+    NumericTextWriter writer(NumericTextFormat::Csv);
+    writer.writeRows(ints, doubles, complexes, chars);
+    const std::string text(writer.view());
+    const std::size_t fields = rows * 4;
+
+    suite.run("parse", "NumericTextParser/columns", true, [&](long n) {
+        std::size_t sink = 0;
+        NumericParsedColumns columns;
+        for (long i = 0; i < n; ++i) {
+            columns.clear();
+            NumericTextParser parser;
+            parser.parse(text, columns);
+            parser.finish(columns);
+            sink += columns.size();
+        }
+        return sink;
+    }, fields, text.size());
+
+    suite.run("parse", "NumericTextParser/NumericValue", true, [&](long n) {
+        std::size_t sink = 0;
+        std::vector<NumericValue> values;
+        for (long i = 0; i < n; ++i) {
+            values.clear();
+            NumericTextParser parser;
+            parser.parse(text, values);
+            parser.finish(values);
+            sink += values.size();
+        }
+        return sink;
+    }, fields, text.size());
+
+    suite.run("parse", "numericParseStream/64KiB-chunks", true, [&](long n) {
+        std::size_t sink = 0;
+        NumericParseOptions options;
+        options.chunkSize = 1 << 16;
+        for (long i = 0; i < n; ++i) {
+            std::istringstream stream(text);
+            sink += numericParseStream(stream, [&](NumericParsedColumns& batch) { sink += batch.ints.size(); }, options).fields;
+        }
+        return sink;
+    }, fields, text.size());
+
+    // What a hand-written reader does today: strtod every field, box it with Numeric::create
+    suite.run("parse", "strtod+Numeric::create", true, [&](long n) {
+        std::size_t sink = 0;
+        std::vector<std::unique_ptr<Numeric>> values;
+        for (long i = 0; i < n; ++i) {
+            values.clear();
+            const char* p = text.c_str();
+            const char* end = p + text.size();
+            while (p < end) {
+                const char* stop = p;
+                while (stop < end && *stop != ',' && *stop != '\n') {
+                    ++stop;
+                }
+                char* parsed = nullptr;
+                const double value = std::strtod(p, &parsed);
+                if (parsed == stop) {
+                    values.push_back(Numeric::create(value));
+                } else {
+                    values.push_back(Numeric::create(*p));
+                }
+                p = stop + 1;
+            }
+            sink += values.size();
+        }
+        return sink;
+    }, fields, text.size());
+}
+
+// Getting 1M doubles from disk into something summable: mapped view vs fread vs Numeric::create
+void benchFile(Suite& suite)
+{
+    constexpr std::size_t count = 1000000;
+    NumericColumn<double> column;
+    for (std::size_t i = 0; i < count; ++i) {
+        column.push_back(static_cast<double>(i) * 0.5);
+    }
+    const std::string path = (std::filesystem::temp_directory_path() / "numeric_bench.ncol").string();
+    NumericFileWriter writer;
+    writer.add("values", column);
+    writer.write(path);
+
+    suite.run("file", "NumericMappedFile/open", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            NumericMappedFile file(path);
+            sink += file.view<double>(0).size();
+        }
+        return sink;
+    });
+
+    suite.run("file", "NumericMappedFile/open+sum", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            NumericMappedFile file(path);
+            double sum = 0;
+            for (double value : file.view<double>("values")) {
+                sum += value;
+            }
+            sink += sum > 0;
+        }
+        return sink;
+    }, count);
+
+    suite.run("file", "fread/column+sum", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            NumericMappedFile header(path);   // only to find the offset
+            const std::size_t offset = header.column(0).offset;
+            NumericColumn<double> work(count);
+            std::FILE* file = std::fopen(path.c_str(), "rb");
+            std::fseek(file, static_cast<long>(offset), SEEK_SET);
+            sink += std::fread(work.data(), sizeof(double), count, file);
+            std::fclose(file);
+            double sum = 0;
+            for (std::size_t j = 0; j < count; ++j) {
+                sum += work[j];
+            }
+            sink += sum > 0;
+        }
+        return sink;
+    }, count);
+
+    suite.run("file", "Numeric::create/vector+sum", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            NumericMappedFile file(path);
+            std::vector<std::unique_ptr<Numeric>> values;
+            values.reserve(count);
+            for (double value : file.view<double>(0)) {
+                values.push_back(Numeric::create(value));
+            }
+            double sum = 0;
+            for (const auto& value : values) {
+                sum += numericValueOf<NumericKind::Double>(*value);
+            }
+            sink += sum > 0;
+        }
+        return sink;
+    }, count);
+
+    std::filesystem::remove(path);
+}
+
+/**
+ * Summing 4M doubles (a column and a boxed vector) at 1, 2, 4 and 8 threads, the Kahan
+ * and pairwise modes on a float column, and the sumOperation loop a caller would
+ * otherwise write. One op = one element.
+ */
+void benchReduce(Suite& suite)
+{
+    constexpr std::size_t count = 1 << 22;
+    NumericColumn<double> column;
+    NumericColumn<float> floats;
+    std::vector<std::unique_ptr<Numeric>> values;
+    values.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        column.push_back(static_cast<double>(i % 1000) * 0.25);
+        floats.push_back(static_cast<float>(i % 1000) * 0.25f);
+        values.push_back(Numeric::create(column[i]));
+    }
+
+    for (std::size_t threads : {1, 2, 4, 8}) {
+        NumericReduceOptions options;
+        options.threads = threads;
+        const std::string suffix = "/threads=" + std::to_string(threads);
+        suite.run("reduce", "numericSum/column<double>" + suffix, true, [&](long n) {
+            double sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += numericSum(column, options);
+            }
+            return static_cast<std::size_t>(sink);
+        }, count, count * sizeof(double));
+        suite.run("reduce", "numericSum/vector<double>" + suffix, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += numericSum(values, options) != nullptr;
+            }
+            return sink;
+        }, count);
+    }
+
+    for (NumericSummation summation : {NumericSummation::Plain, NumericSummation::Kahan, NumericSummation::Pairwise}) {
+        static const char* names[] = {"plain", "kahan", "pairwise"};
+        NumericReduceOptions options;
+        options.threads = 1;
+        options.summation = summation;
+        suite.run("reduce", std::string("numericSum/column<float>/") + names[static_cast<int>(summation)], true, [&](long n) {
+            float sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += numericSum(floats, options);
+            }
+            return static_cast<std::size_t>(sink);
+        }, count, count * sizeof(float));
+    }
+
+    suite.run("reduce", "sumOperation/vector<double>", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            std::unique_ptr<Numeric> total = Numeric::create(0.0);
+            for (const auto& value : values) {
+                total = total->sumOperation(*value);
+            }
+            sink += total != nullptr;
+        }
+        return sink;
+    }, count);
+}
+
+
+/**
+ * Complex multiply / divide over 4096 elements: interleaved NumericColumn<std::complex<F>>
+ * (scalar std::complex) against the split NumericComplexColumn<F> in strict and fast
+ * mode, plus multiply-accumulate and magnitude. One op = one element.
+ */
+template <typename F>
+void benchComplex(Suite& suite, const char* type)
+{
+    constexpr std::size_t count = 4096;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<F> values(F(-100), F(100));
+    NumericColumn<std::complex<F>> first, second;
+    for (std::size_t i = 0; i < count; ++i) {
+        first.push_back(std::complex<F>(values(rng), values(rng)));
+        second.push_back(std::complex<F>(values(rng), values(rng)));
+    }
+    const NumericComplexColumn<F> splitFirst(first), splitSecond(second);
+    NumericComplexColumn<F> accumulator(count);
+    const std::string prefix = std::string(type) + "/";
+    constexpr auto Strict = NumericComplexMath::Strict;
+    constexpr auto Fast = NumericComplexMath::Fast;
+
+    suite.run("complex", prefix + "multiply/interleaved", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += first.multiplyOperation(second).size();
+        }
+        return sink;
+    }, count);
+    for (auto math : {Strict, Fast}) {
+        const std::string mode = math == Strict ? "strict" : "fast";
+        suite.run("complex", prefix + "multiply/split/" + mode, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += splitFirst.multiplyOperation(splitSecond, math).size();
+            }
+            return sink;
+        }, count);
+    }
+
+    suite.run("complex", prefix + "divide/interleaved", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += first.divideOperation(second).size();
+        }
+        return sink;
+    }, count);
+    for (auto math : {Strict, Fast}) {
+        const std::string mode = math == Strict ? "strict" : "fast";
+        suite.run("complex", prefix + "divide/split/" + mode, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += splitFirst.divideOperation(splitSecond, math).size();
+            }
+            return sink;
+        }, count);
+        suite.run("complex", prefix + "multiplyAccumulate/" + mode, true, [&](long n) {
+            for (long i = 0; i < n; ++i) {
+                accumulator.multiplyAccumulate(splitFirst, splitSecond, math);
+            }
+            return accumulator.size();
+        }, count);
+        suite.run("complex", prefix + "magnitude/" + mode, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += splitFirst.magnitude(math).size();
+            }
+            return sink;
+        }, count);
+    }
+}
+
+/**
+ * Integer column arithmetic over 4096 elements for each width, under the three overflow
+ * policies. Checked and Saturate compute an overflow mask per vector; Wrap is the bare
+ * instruction, so the gap between them is the cost of the check. One op = one element.
+ */
+template <typename T>
+void benchInteger(Suite& suite, const char* type)
+{
+    constexpr std::size_t count = 4096;
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<int> values(0, 9);
+    NumericColumn<T> first, second;
+    for (std::size_t i = 0; i < count; ++i) {
+        first.push_back(static_cast<T>(values(rng)));
+        second.push_back(static_cast<T>(values(rng)));
+    }
+    const std::pair<NumericOverflow, const char*> modes[] = {
+        {NumericOverflow::Checked, "checked"}, {NumericOverflow::Saturate, "saturate"}, {NumericOverflow::Wrap, "wrap"}};
+
+    for (const auto& [mode, modeName] : modes) {
+        NumericOverflowScope scope(mode);
+        suite.run("integer", std::string(type) + "/sum/" + modeName, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += first.sumOperation(second).size();
+            }
+            return sink;
+        }, count);
+        suite.run("integer", std::string(type) + "/multiply/" + modeName, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += first.multiplyOperation(second).size();
+            }
+            return sink;
+        }, count);
+    }
+}
+
+/**
+ * NumericBigInt at 1K, 10K and 100K decimal digits, with the default thresholds ("fast":
+ * Karatsuba / Toom-3, Burnikel-Ziegler, divide-and-conquer decimal conversion) and with
+ * every threshold at SIZE_MAX ("naive": the O(n^2) algorithms). Division divides a
+ * 2n-digit number by an n-digit one; toString / fromString use the 2n-digit number.
+ */
+void benchBigInt(Suite& suite)
+{
+    const NumericBigIntThresholds fast = numericBigIntThresholds();
+    NumericBigIntThresholds naive;
+    naive.karatsuba = naive.toom3 = naive.division = naive.decimal = SIZE_MAX;
+
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> digit(0, 9);
+    const auto randomDigits = [&](std::size_t count) {
+        std::string text(1, static_cast<char>('1' + digit(rng) % 9));
+        while (text.size() < count) {
+            text += static_cast<char>('0' + digit(rng));
+        }
+        return text;
+    };
+
+    for (std::size_t digits : {std::size_t(1000), std::size_t(10000), std::size_t(100000)}) {
+        const NumericBigInt first = NumericBigInt::fromString(randomDigits(digits));
+        const NumericBigInt second = NumericBigInt::fromString(randomDigits(digits));
+        const std::string wideText = randomDigits(2 * digits);
+        const NumericBigInt wide = NumericBigInt::fromString(wideText);
+
+        for (const auto& [thresholds, mode] : {std::pair(fast, "fast"), std::pair(naive, "naive")}) {
+            setNumericBigIntThresholds(thresholds);
+            const std::string suffix = std::to_string(digits) + "/" + mode;
+            suite.run("bigint", "multiply/" + suffix, true, [&](long n) {
+                std::size_t sink = 0;
+                for (long i = 0; i < n; ++i) {
+                    sink += (first * second).limbs().size();
+                }
+                return sink;
+            });
+            suite.run("bigint", "divide/" + suffix, true, [&](long n) {
+                std::size_t sink = 0;
+                for (long i = 0; i < n; ++i) {
+                    sink += (wide / second).limbs().size();
+                }
+                return sink;
+            });
+            suite.run("bigint", "toString/" + suffix, true, [&](long n) {
+                std::size_t sink = 0;
+                for (long i = 0; i < n; ++i) {
+                    sink += wide.toString().size();
+                }
+                return sink;
+            });
+            suite.run("bigint", "fromString/" + suffix, true, [&](long n) {
+                std::size_t sink = 0;
+                for (long i = 0; i < n; ++i) {
+                    sink += NumericBigInt::fromString(wideText).limbs().size();
+                }
+                return sink;
+            }, 1, wideText.size());
+        }
+    }
+    setNumericBigIntThresholds(fast);
+}
+
+/**
+ * Decimal columns of 4096 elements against int64 and double columns of the same values:
+ * add (the int64 kernels on the units), multiply under two rounding modes, and a
+ * numericSum reduction. One op = one element.
+ */
+void benchDecimal(Suite& suite)
+{
+    constexpr std::size_t count = 4096;
+    std::mt19937 rng(19);
+    std::uniform_int_distribution<std::int64_t> units(-100000, 100000);
+    NumericColumn<NumericDecimal2> first, second;
+    NumericColumn<NumericDecimal18> wideFirst, wideSecond;
+    NumericColumn<std::int64_t> integerFirst, integerSecond;
+    NumericColumn<double> realFirst, realSecond;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::int64_t a = units(rng), b = units(rng);
+        first.push_back(NumericDecimal2::fromUnits(a));
+        second.push_back(NumericDecimal2::fromUnits(b));
+        wideFirst.push_back(NumericDecimal18(first[i]));
+        wideSecond.push_back(NumericDecimal18(second[i]));
+        integerFirst.push_back(a);
+        integerSecond.push_back(b);
+        realFirst.push_back(a / 100.0);
+        realSecond.push_back(b / 100.0);
+    }
+
+    const auto columnOps = [&](const std::string& type, const auto& lhs, const auto& rhs) {
+        suite.run("decimal", type + "/sum", true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += lhs.sumOperation(rhs).size();
+            }
+            return sink;
+        }, count);
+        suite.run("decimal", type + "/multiply", true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += lhs.multiplyOperation(rhs).size();
+            }
+            return sink;
+        }, count);
+        suite.run("decimal", type + "/reduce", true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += static_cast<std::size_t>(static_cast<double>(numericSum(lhs)) != 0);
+            }
+            return sink;
+        }, count);
+    };
+    columnOps("decimal2", first, second);
+    columnOps("decimal18", wideFirst, wideSecond);
+    columnOps("int64", integerFirst, integerSecond);
+    columnOps("double", realFirst, realSecond);
+
+    NumericRoundingScope scope(NumericRounding::TowardZero);
+    suite.run("decimal", "decimal2/multiply/towardZero", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += first.multiplyOperation(second).size();
+        }
+        return sink;
+    }, count);
+}
+
+/**
+ * float16 and bfloat16 columns of 4096 elements against float: add, multiply (both
+ * widen to float block by block and narrow back) and numericSum, then the array
+ * conversions alone, each at every SIMD level the CPU has. One op = one element;
+ * the conversions report the bytes read and written.
+ */
+void benchHalf(Suite& suite)
+{
+    constexpr std::size_t count = 4096;
+    std::mt19937 rng(20);
+    std::uniform_real_distribution<float> values(-100.0f, 100.0f);
+    NumericColumn<NumericFloat16> first, second;
+    NumericColumn<NumericBFloat16> brainFirst, brainSecond;
+    NumericColumn<float> realFirst, realSecond;
+    for (std::size_t i = 0; i < count; ++i) {
+        const float a = values(rng), b = values(rng);
+        first.push_back(NumericFloat16(a));
+        second.push_back(NumericFloat16(b));
+        brainFirst.push_back(NumericBFloat16(a));
+        brainSecond.push_back(NumericBFloat16(b));
+        realFirst.push_back(a);
+        realSecond.push_back(b);
+    }
+    std::vector<float> widened(count);
+    std::vector<NumericFloat16> narrowed(count);
+    std::vector<NumericBFloat16> brainNarrowed(count);
+
+    const auto columnOps = [&](const std::string& type, const auto& lhs, const auto& rhs) {
+        suite.run("half", type + "/sum", true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += lhs.sumOperation(rhs).size();
+            }
+            return sink;
+        }, count);
+        suite.run("half", type + "/multiply", true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += lhs.multiplyOperation(rhs).size();
+            }
+            return sink;
+        }, count);
+        suite.run("half", type + "/reduce", true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += static_cast<std::size_t>(static_cast<float>(numericSum(lhs)) != 0);
+            }
+            return sink;
+        }, count);
+    };
+
+    const NumericSimdLevel best = numericSimdLevel();
+    const char* levels[] = {"scalar", "avx2", "avx512"};
+    for (NumericSimdLevel level : {NumericSimdLevel::Scalar, NumericSimdLevel::Avx2, NumericSimdLevel::Avx512}) {
+        if (level > best) {
+            break;
+        }
+        setNumericSimdLevel(level);
+        const std::string suffix = std::string("/") + levels[static_cast<int>(level)];
+        columnOps("float16" + suffix, first, second);
+        columnOps("bfloat16" + suffix, brainFirst, brainSecond);
+        columnOps("float" + suffix, realFirst, realSecond);
+
+        const std::size_t bytes = count * (sizeof(float) + sizeof(NumericFloat16));
+        suite.run("half", "float16/widen" + suffix, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                numericToFloat(first.data(), widened.data(), count);
+                sink += widened[i % count] != 0;
+            }
+            return sink;
+        }, count, bytes);
+        suite.run("half", "float16/narrow" + suffix, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                numericFromFloat(realFirst.data(), narrowed.data(), count);
+                sink += narrowed[i % count].bits;
+            }
+            return sink;
+        }, count, bytes);
+        suite.run("half", "bfloat16/widen" + suffix, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                numericToFloat(brainFirst.data(), widened.data(), count);
+                sink += widened[i % count] != 0;
+            }
+            return sink;
+        }, count, bytes);
+        suite.run("half", "bfloat16/narrow" + suffix, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                numericFromFloat(realFirst.data(), brainNarrowed.data(), count);
+                sink += brainNarrowed[i % count].bits;
+            }
+            return sink;
+        }, count, bytes);
+    }
+    setNumericSimdLevel(best);
+}
+
+/**
+ * Hashing and group-by: NumericHashMap against std::unordered_map counting 2^20 int64
+ * keys, then numericGroupBy over 2^22 rows with few (1000) and many (2^20) distinct
+ * int64 keys and double values at 1, 2, 4 and 8 threads, and over boxed keys mixing int
+ * and double. One op = one row.
+ */
+void benchGroupBy(Suite& suite)
+{
+    constexpr std::size_t count = 1 << 22;
+    std::mt19937_64 random(21);
+    NumericColumn<std::int64_t> fewKeys(count);
+    NumericColumn<std::int64_t> manyKeys(count);
+    NumericColumn<double> values(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        fewKeys[i] = static_cast<std::int64_t>(random() % 1000);
+        manyKeys[i] = static_cast<std::int64_t>(random() % (1 << 20));
+        values[i] = static_cast<double>(random() % 10000) * 0.25;
+    }
+
+    constexpr std::size_t mapKeys = 1 << 20;
+    suite.run("groupBy", "NumericHashMap<int64,size_t>/count", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            NumericHashMap<std::int64_t, std::size_t> counts;
+            for (std::size_t row = 0; row < mapKeys; ++row) {
+                ++counts[manyKeys[row]];
+            }
+            sink += counts.size();
+        }
+        return sink;
+    }, mapKeys);
+    suite.run("groupBy", "std::unordered_map<int64,size_t>/count", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            std::unordered_map<std::int64_t, std::size_t> counts;
+            for (std::size_t row = 0; row < mapKeys; ++row) {
+                ++counts[manyKeys[row]];
+            }
+            sink += counts.size();
+        }
+        return sink;
+    }, mapKeys);
+
+    for (std::size_t threads : {1, 2, 4, 8}) {
+        NumericReduceOptions options;
+        options.threads = threads;
+        const std::string suffix = "/threads=" + std::to_string(threads);
+        suite.run("groupBy", "numericGroupBy/int64 x double/keys=1000" + suffix, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += numericGroupBy(fewKeys, values, options).size();
+            }
+            return sink;
+        }, count, count * (sizeof(std::int64_t) + sizeof(double)));
+        suite.run("groupBy", "numericGroupBy/int64 x double/keys=2^20" + suffix, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += numericGroupBy(manyKeys, values, options).size();
+            }
+            return sink;
+        }, count, count * (sizeof(std::int64_t) + sizeof(double)));
+    }
+
+    constexpr std::size_t boxedCount = 1 << 20;
+    std::vector<std::unique_ptr<Numeric>> boxedKeys;
+    boxedKeys.reserve(boxedCount);
+    for (std::size_t i = 0; i < boxedCount; ++i) {
+        const std::int64_t key = fewKeys[i];
+        boxedKeys.push_back(i % 2 ? Numeric::create(static_cast<double>(key)) : Numeric::create(static_cast<int>(key)));
+    }
+    NumericColumn<double> boxedValues(boxedCount);
+    std::copy_n(values.data(), boxedCount, boxedValues.data());
+    for (std::size_t threads : {1, 4}) {
+        NumericReduceOptions options;
+        options.threads = threads;
+        suite.run("groupBy", "numericGroupBy/boxed int|double x double/threads=" + std::to_string(threads), true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += numericGroupBy(boxedKeys, boxedValues, options).size();
+            }
+            return sink;
+        }, boxedCount);
+    }
+}
+
+/**
+ * Range queries for 1% of 2^22 doubles (1000 <= x < 11000): a lessThanOperation /
+ * greaterThanOperation loop over boxed values, the two column comparison kernels, and
+ * numericRangeFilter through a zone map over clustered data (ascending with noise) and
+ * over uniform data, where no block can be skipped. One op = one row. Then
+ * NumericSortedIndex: building it (one op = one row) and a range lookup (one op = one
+ * lookup).
+ */
+void benchIndex(Suite& suite)
+{
+    constexpr std::size_t count = 1 << 22;
+    std::mt19937_64 random(22);
+    NumericColumn<double> clustered(count);
+    NumericColumn<double> uniform(count);
+    std::vector<std::unique_ptr<Numeric>> boxed;
+    boxed.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        clustered[i] = static_cast<double>(i) * 0.25 + static_cast<double>(random() % 64);
+        uniform[i] = static_cast<double>(random() % (count / 4));
+        boxed.push_back(Numeric::create(clustered[i]));
+    }
+    const auto low = Numeric::create(1000);
+    const auto high = Numeric::create(11000.0);
+    const NumericRange range{low.get(), high.get(), true, false};
+
+    suite.run("index", "lessThanOperation/vector<double>/scan", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            for (const auto& value : boxed) {
+                sink += !value->lessThanOperation(*low) && value->lessThanOperation(*high);
+            }
+        }
+        return sink;
+    }, count);
+    suite.run("index", "lessThanOperation/column<double>/scan", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            const NumericMask below = clustered.lessThanOperation(1000.0);
+            const NumericMask above = clustered.lessThanOperation(11000.0);
+            for (std::size_t w = 0; w < above.wordCount(); ++w) {
+                sink += std::popcount(above.words()[w] & ~below.words()[w]);
+            }
+        }
+        return sink;
+    }, count, count * sizeof(double));
+    const NumericZoneMap<double> clusteredZones(clustered);
+    const NumericZoneMap<double> uniformZones(uniform);
+    suite.run("index", "numericRangeFilter/clustered", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += numericRangeFilter(clustered, clusteredZones, range).count();
+        }
+        return sink;
+    }, count, count * sizeof(double));
+    suite.run("index", "numericRangeFilter/uniform", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += numericRangeFilter(uniform, uniformZones, range).count();
+        }
+        return sink;
+    }, count, count * sizeof(double));
+    suite.run("index", "NumericZoneMap/build", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += NumericZoneMap<double>(uniform).blockCount();
+        }
+        return sink;
+    }, count, count * sizeof(double));
+
+    suite.run("index", "NumericSortedIndex/build", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += NumericSortedIndex<double>(uniform).size();
+        }
+        return sink;
+    }, count);
+    const NumericSortedIndex<double> index(uniform);
+    std::vector<std::unique_ptr<Numeric>> starts;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        starts.push_back(Numeric::create(static_cast<double>(random() % (count / 4))));
+    }
+    suite.run("index", "NumericSortedIndex/lookup", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += index.lookup({starts[i % starts.size()].get(), starts[(i + 1) % starts.size()].get(), true, false}).size();
+        }
+        return sink;
+    });
+}
+
+/**
+ * Column compression, one data set per encoding: increasing int64 timestamps (delta),
+ * int64 ids drawn from 16 values (dictionary), int status codes in long runs
+ * (run-length), int64 values in a narrow range (frame-of-reference), text in a char
+ * column (dictionary) and a double random walk (xor). Per data set: encoding and
+ * decoding (one op = one row; the decode entry reports the compression ratio and the
+ * decoded bytes per second), then sum (integers), min (double) and greaterThanOperation
+ * on the encoded data against the same call on the raw column.
+ */
+template <typename T>
+void benchCompressed(Suite& suite, const std::string& name, const NumericColumn<T>& column, NumericEncoding encoding, T threshold)
+{
+    const std::size_t count = column.size();
+    const std::size_t bytes = count * sizeof(T);
+    suite.run("compress", "encode/" + name, true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += NumericCompressedColumn<T>(column, encoding).compressedBytes();
+        }
+        return sink;
+    }, count, bytes);
+    const NumericCompressedColumn<T> compressed(column, encoding);
+    NumericColumn<T> decoded(count);
+    suite.run("compress", "decode/" + name, true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            compressed.decode(0, count, decoded.data());
+            sink += static_cast<std::size_t>(decoded[i % count]);
+        }
+        return sink;
+    }, count, bytes, compressed.ratio());
+
+    if constexpr (IntegerValue<T>) {
+        suite.run("compress", "sum/" + name, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += static_cast<std::size_t>(compressed.sum());
+            }
+            return sink;
+        }, count);
+        suite.run("compress", "sum/" + name + "/raw", true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += static_cast<std::size_t>(numericSum(column, {1}));
+            }
+            return sink;
+        }, count, bytes);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        suite.run("compress", "min/" + name, true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += static_cast<std::size_t>(compressed.min());
+            }
+            return sink;
+        }, count);
+        suite.run("compress", "min/" + name + "/raw", true, [&](long n) {
+            std::size_t sink = 0;
+            for (long i = 0; i < n; ++i) {
+                sink += static_cast<std::size_t>(numericMin(column, {1}));
+            }
+            return sink;
+        }, count, bytes);
+    }
+    suite.run("compress", "greaterThanOperation/" + name, true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += compressed.greaterThanOperation(threshold).count();
+        }
+        return sink;
+    }, count);
+    suite.run("compress", "greaterThanOperation/" + name + "/raw", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += column.greaterThanOperation(threshold).count();
+        }
+        return sink;
+    }, count, bytes);
+}
+
+void benchCompress(Suite& suite)
+{
+    constexpr std::size_t count = 1 << 22;
+    std::mt19937_64 random(23);
+    NumericColumn<std::int64_t> timestamps(count);
+    NumericColumn<std::int64_t> ids(count);
+    NumericColumn<int> statuses(count);
+    NumericColumn<std::int64_t> readings(count);
+    NumericColumn<char> text(count);
+    NumericColumn<double> walk(count);
+    static const char words[] = "the quick brown fox jumps over the lazy dog ";
+    double level = 20.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        timestamps[i] = 1700000000000 + static_cast<std::int64_t>(i) * 1000 + static_cast<std::int64_t>(random() % 8);
+        ids[i] = 100000 + static_cast<std::int64_t>(random() % 16) * 7919;
+        statuses[i] = static_cast<int>((i / 5000) % 4) * 100 + 200;
+        readings[i] = 1000000 + static_cast<std::int64_t>(random() % 4096);
+        text[i] = words[(i + random() % 2) % (sizeof(words) - 1)];
+        level += random() % 4 == 0 ? 0.125 * (static_cast<double>(random() % 3) - 1.0) : 0.0;
+        walk[i] = level;
+    }
+
+    benchCompressed(suite, "delta/int64", timestamps, NumericEncoding::Delta, timestamps[count / 2]);
+    benchCompressed(suite, "dictionary/int64", ids, NumericEncoding::Dictionary, std::int64_t(100000 + 8 * 7919));
+    benchCompressed(suite, "run-length/int", statuses, NumericEncoding::RunLength, 300);
+    benchCompressed(suite, "frame-of-reference/int64", readings, NumericEncoding::FrameOfReference, std::int64_t(1002048));
+    benchCompressed(suite, "dictionary/char", text, NumericEncoding::Dictionary, 'n');
+    benchCompressed(suite, "xor/double", walk, NumericEncoding::Xor, 20.0);
+}
+
+/**
+ * Streaming pipelines. Per-value cost of the coroutine stages (a map / filter / reduce
+ * chain against the same plain loop) and of handing values between threads through
+ * numericThreaded (one op = one value). Then 8 MB of CSV parsed and summed: with
+ * numericParseStream on one thread, and as a pipeline that reads and parses on one
+ * thread while numericParallelMap sums the chunks on 1-8 threads (GB/s of text).
+ */
+NumericGenerator<std::int64_t> benchCounter(std::int64_t count)
+{
+    for (std::int64_t i = 0; i < count; ++i) {
+        co_yield i;
+    }
+}
+
+double benchBatchTotal(const NumericParsedColumns& batch)
+{
+    double total = 0;
+    for (int value : batch.ints) {
+        total += value;
+    }
+    for (float value : batch.floats) {
+        total += value;
+    }
+    for (double value : batch.doubles) {
+        total += value;
+    }
+    return total;
+}
+
+void benchStream(Suite& suite)
+{
+    constexpr std::int64_t count = 1 << 20;
+    suite.run("stream", "map|filter|reduce/loop", true, [&](long n) {
+        std::int64_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            for (std::int64_t value = 0; value < count; ++value) {
+                const std::int64_t doubled = value * 2;
+                sink += doubled % 3 == 0 ? doubled : 0;
+            }
+        }
+        return static_cast<std::size_t>(sink);
+    }, count);
+    suite.run("stream", "map|filter|reduce/generator", true, [&](long n) {
+        std::int64_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += benchCounter(count) | numericMap([](std::int64_t value) { return value * 2; }) |
+                    numericFilter([](std::int64_t value) { return value % 3 == 0; }) | numericReduce(std::int64_t(0), std::plus<>());
+        }
+        return static_cast<std::size_t>(sink);
+    }, count);
+    suite.run("stream", "numericThreaded/handoff", true, [&](long n) {
+        std::int64_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += benchCounter(count) | numericThreaded(256) | numericReduce(std::int64_t(0), std::plus<>());
+        }
+        return static_cast<std::size_t>(sink);
+    }, count);
+
+    std::mt19937_64 random(24);
+    std::string text;
+    while (text.size() < (8u << 20)) {
+        text += std::to_string(random() % 100000);
+        text += '.';
+        text += std::to_string(random() % 1000);
+        text += random() % 8 == 0 ? '\n' : ',';
+    }
+    suite.run("stream", "numericParseStream", true, [&](long n) {
+        double sink = 0;
+        for (long i = 0; i < n; ++i) {
+            std::istringstream input(text);
+            numericParseStream(input, [&](NumericParsedColumns& batch) { sink += benchBatchTotal(batch); });
+        }
+        return static_cast<std::size_t>(sink);
+    }, 1, text.size());
+    for (std::size_t threads : {1, 2, 4, 8}) {
+        suite.run("stream", "pipeline/threads=" + std::to_string(threads), true, [&](long n) {
+            double sink = 0;
+            for (long i = 0; i < n; ++i) {
+                std::istringstream input(text);
+                sink += numericReadChunks(input, 1 << 18) | numericParse() | numericThreaded() |
+                        numericParallelMap([](NumericParsedColumns batch) { return benchBatchTotal(batch); }, threads) |
+                        numericReduce(0.0, std::plus<>());
+            }
+            return static_cast<std::size_t>(sink);
+        }, 1, text.size());
+    }
+}
+
+// The same formula compiled from text, as expression templates and as per-row virtual calls
+void benchFormula(Suite& suite)
+{
+    constexpr std::size_t count = 1 << 16;
+    NumericColumn<double> a(count), b(count), c(count), d(count), out;
+    NumericColumn<int> k(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        a[i] = 1.0 + i;
+        b[i] = 0.5 * i;
+        c[i] = 3.0 - i;
+        d[i] = 1.0 + i % 7;
+        k[i] = static_cast<int>(i % 100);
+    }
+    NumericFormulaColumns columns;
+    columns.add("a", a);
+    columns.add("b", b);
+    columns.add("c", c);
+    columns.add("d", d);
+    columns.add("k", k);
+
+    suite.run("formula", "compile", true, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += NumericFormula("a*b + c/d - 3", columns).instructionCount();
+        }
+        return sink;
+    }, 1);
+
+    const NumericFormula formula("a*b + c/d - 3", columns);
+    suite.run("formula", "a*b+c/d-3/compiled", true, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            formula.evaluate(columns, out);
+        }
+        return static_cast<std::size_t>(out[1]);
+    }, count);
+    suite.run("formula", "a*b+c/d-3/expression", true, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            numericEvaluate(a * b + c / d - 3, out);
+        }
+        return static_cast<std::size_t>(out[1]);
+    }, count);
+    suite.run("formula", "a*b+c/d-3/virtual", true, [&](long n) {
+        std::size_t sink = 0;
+        const auto three = Numeric::create(3);
+        for (long i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < count; ++j) {
+                auto product = a.at(j)->multiplyOperation(*b.at(j));
+                auto quotient = c.at(j)->divideOperation(*d.at(j));
+                sink += product->sumOperation(*quotient)->subtractOperation(*three) != nullptr;
+            }
+        }
+        return sink;
+    }, count);
+
+    // Mixed kinds, and a repeated subexpression computed once
+    const NumericFormula mixed("k*a + k*a/d", columns);
+    suite.run("formula", "k*a+k*a/d/compiled", true, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            mixed.evaluate(columns, out);
+        }
+        return static_cast<std::size_t>(out[1]);
+    }, count);
+    suite.run("formula", "k*a+k*a/d/expression", true, [&](long n) {
+        for (long i = 0; i < n; ++i) {
+            numericEvaluate(k * a + k * a / d, out);
+        }
+        return static_cast<std::size_t>(out[1]);
+    }, count);
+}
+
+/**
+ * Cost of reading the instrumentation: a snapshot merges every thread's counters, the
+ * export formats the non-zero series. Unsupported when the library is built without it.
+ */
+void benchStats(Suite& suite)
+{
+    auto first = Numeric::create(7);
+    auto second = Numeric::create(2.5);
+    for (int i = 0; i < 1000; ++i) {
+        first->sumOperation(*second);
+        first->lessThanOperation(*second);
+    }
+
+    suite.run("stats", "snapshot", numericStatsEnabled, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += numericStatsSnapshot().allocations;
+        }
+        return sink;
+    });
+    const NumericStatsSnapshot snapshot = numericStatsSnapshot();
+    suite.run("stats", "prometheus", numericStatsEnabled, [&](long n) {
+        std::size_t sink = 0;
+        for (long i = 0; i < n; ++i) {
+            sink += numericStatsPrometheus(snapshot).size();
+        }
+        return sink;
+    });
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Suite suite;
+    const char* outPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+            suite.minSeconds = std::atof(argv[++i]) / 1e3;
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            suite.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--min-time-ms N] [--filter SUBSTRING] [--out FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    benchOperations(suite);
+    benchBatch(suite);
+    benchExpression(suite);
+    benchStatic(suite);
+    benchCreate(suite, "int", 10);
+    benchCreate(suite, "float", 5.5f);
+    benchCreate(suite, "double", 3.14159);
+    benchCreate(suite, "long double", 2.5L);
+    benchCreate(suite, "complex<float>", std::complex<float>(1, 2));
+    benchCreate(suite, "complex<double>", std::complex<double>(1, 2));
+    benchCreate(suite, "char", 'A');
+    benchCreate(suite, "int64", std::int64_t(10));
+    benchConversions(suite);
+    benchToString(suite);
+    benchSort(suite);
+    benchParse(suite);
+    benchFile(suite);
+    benchReduce(suite);
+    benchComplex<float>(suite, "complex<float>");
+    benchComplex<double>(suite, "complex<double>");
+    benchInteger<std::int8_t>(suite, "int8");
+    benchInteger<std::int16_t>(suite, "int16");
+    benchInteger<int>(suite, "int");
+    benchInteger<std::int64_t>(suite, "int64");
+    benchInteger<std::uint32_t>(suite, "uint32");
+    benchBigInt(suite);
+    benchDecimal(suite);
+    benchHalf(suite);
+    benchGroupBy(suite);
+    benchIndex(suite);
+    benchCompress(suite);
+    benchStream(suite);
+    benchFormula(suite);
+    benchStats(suite);
+
+    std::FILE* out = outPath ? std::fopen(outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot open %s\n", outPath);
+        return 1;
+    }
+    suite.writeJson(out);
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return 0;
+}
@@ -1,245 +1,112 @@
-#include "../include/Numeric.hpp"
+#include "Numeric.hpp"
 
 
 /************************ Numeric Class ********************************/
 
-Numeric::Numeric()
+Numeric::Numeric(NumericKind kind) : numericKind(kind)
 {
-    #if DEBUG == 1
-    std::cout << "Numeric Class constructor is called" << std::endl;
-    #endif // DEBUG
-
 }
 
 
 Numeric::~Numeric()
-    {
-        #if DEBUG == 1
-        std::cout << "Numeric Class destructor is called" << std::endl;
-        #endif // DEBUG
-    }
-
-
-
-/* When to Use dynamic_cast?
-When working with polymorphic base classes (Numeric has virtual functions).
-When you need to convert a base class reference/pointer to a derived class safely.
-When there’s a possibility that the object is not the expected type.*/
-
-/**Templates do not allow me to use runtime polymorphism as easily.
- * So, if i want to have different types (e.g., integer vs. floating-point vs. complex)
- *  in the same container, a base class with polymorphism (like my current design) becomes more useful */
-
-
-
+{
+}
 
- /************************ IntNumeric Class ********************************/
 
- //firstly a derived class with polymorphism
 
-IntNumeric::IntNumeric(int value) : intValue(value)
-    {
-        #if DEBUG == 1
-        std::cout << "IntNumeric Class constructor with value: " << value << std::endl;
-        #endif // DEBUG
-    }
-    
-    std::unique_ptr<Numeric> IntNumeric::convertTo(const std::type_info& targetType) const {
-        if (targetType == typeid(FloatNumeric<float>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<FloatNumeric<float>>(static_cast<float>(intValue)));
-        } else if (targetType == typeid(FloatNumeric<double>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<FloatNumeric<double>>(static_cast<double>(intValue)));
-        } else if (targetType == typeid(ComplexNumeric<float>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<float>>(std::complex<float>(intValue, 0)));
-        } else if (targetType == typeid(ComplexNumeric<double>)) {
-            return std::unique_ptr<Numeric>(std::make_unique<ComplexNumeric<double>>(std::complex<double>(intValue, 0)));
-        } else if (targetType == typeid(IntNumeric)) {
-            return std::unique_ptr<Numeric>(std::make_unique<IntNumeric>(intValue));
-        } else {
-            throw std::runtime_error("Unsupported conversion");
-        }
+std::unique_ptr<Numeric> Numeric::sumOperation(const Numeric& second) {
+    try {
+        return apply(NumericOp::Sum, *this, second);
+    } catch (const std::bad_alloc& e) {
+        throw std::runtime_error("sumOperation: Memory allocation failed.");
     }
+}
 
-    std::unique_ptr<Numeric> IntNumeric::sumOperation(const Numeric& second) {
-        try {
-            const IntNumeric& secondInt = dynamic_cast<const IntNumeric&>(second);
-            return std::make_unique<IntNumeric>(intValue + secondInt.intValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the current object to the type of the second operand
-            if (typeid(second) == typeid(FloatNumeric<float>)) {
-                const FloatNumeric<float>& secondFloat = dynamic_cast<const FloatNumeric<float>&>(second);
-                return std::make_unique<FloatNumeric<float>>(static_cast<float>(intValue) + secondFloat.floatValue);
-            } else if (typeid(second) == typeid(FloatNumeric<double>)) {
-                const FloatNumeric<double>& secondDouble = dynamic_cast<const FloatNumeric<double>&>(second);
-                return std::make_unique<FloatNumeric<double>>(static_cast<double>(intValue) + secondDouble.floatValue);
-            } else if (typeid(second) == typeid(ComplexNumeric<float>)) {
-                const ComplexNumeric<float>& secondComplex = dynamic_cast<const ComplexNumeric<float>&>(second);
-                return std::make_unique<ComplexNumeric<float>>(std::complex<float>(intValue, 0) + secondComplex.complexNum);
-            } else if (typeid(second) == typeid(ComplexNumeric<double>)) {
-                const ComplexNumeric<double>& secondComplex = dynamic_cast<const ComplexNumeric<double>&>(second);
-                return std::make_unique<ComplexNumeric<double>>(std::complex<double>(intValue, 0) + secondComplex.complexNum);
-            } else {
-                // If the type is not supported, throw an exception
-                throw std::runtime_error("Unsupported type for addition.");
-            }
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("sumOperation: Memory allocation failed.");
-        }
+std::unique_ptr<Numeric> Numeric::subtractOperation(const Numeric& second) {
+    try {
+        return apply(NumericOp::Subtract, *this, second);
+    } catch (const std::bad_alloc& e) {
+        throw std::runtime_error("subtractOperation: Memory allocation failed.");
     }
-    std::unique_ptr<Numeric> IntNumeric::subtractOperation(const Numeric& second) {
-        try {
-            const IntNumeric& secondInt = dynamic_cast<const IntNumeric&>(second);
-            return std::make_unique<IntNumeric>(intValue - secondInt.intValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the current object to the type of the second operand
-            if (typeid(second) == typeid(FloatNumeric<float>)) {
-                const FloatNumeric<float>& secondFloat = dynamic_cast<const FloatNumeric<float>&>(second);
-                return std::make_unique<FloatNumeric<float>>(static_cast<float>(intValue) - secondFloat.floatValue);
-            } else if (typeid(second) == typeid(FloatNumeric<double>)) {
-                const FloatNumeric<double>& secondDouble = dynamic_cast<const FloatNumeric<double>&>(second);
-                return std::make_unique<FloatNumeric<double>>(static_cast<double>(intValue) - secondDouble.floatValue);
-            } else if (typeid(second) == typeid(ComplexNumeric<float>)) {
-                const ComplexNumeric<float>& secondComplex = dynamic_cast<const ComplexNumeric<float>&>(second);
-                return std::make_unique<ComplexNumeric<float>>(std::complex<float>(intValue, 0) - secondComplex.complexNum);
-            } else if (typeid(second) == typeid(ComplexNumeric<double>)) {
-                const ComplexNumeric<double>& secondComplex = dynamic_cast<const ComplexNumeric<double>&>(second);
-                return std::make_unique<ComplexNumeric<double>>(std::complex<double>(intValue, 0) - secondComplex.complexNum);
-            } else {
-                // If the type is not supported, throw an exception
-                throw std::runtime_error("Unsupported type for subtraction.");
-            }
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("subtractOperation: Memory allocation failed.");
-        }
+}
+
+std::unique_ptr<Numeric> Numeric::multiplyOperation(const Numeric& second) {
+    try {
+        return apply(NumericOp::Multiply, *this, second);
+    } catch (const std::bad_alloc& e) {
+        throw std::runtime_error("multiplyOperation: Memory allocation failed.");
     }
-    
-    std::unique_ptr<Numeric> IntNumeric::multiplyOperation(const Numeric& second) {
-        try {
-            const IntNumeric& secondInt = dynamic_cast<const IntNumeric&>(second);
-            return std::make_unique<IntNumeric>(intValue * secondInt.intValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the current object to the type of the second operand
-            if (typeid(second) == typeid(FloatNumeric<float>)) {
-                const FloatNumeric<float>& secondFloat = dynamic_cast<const FloatNumeric<float>&>(second);
-                return std::make_unique<FloatNumeric<float>>(static_cast<float>(intValue) * secondFloat.floatValue);
-            } else if (typeid(second) == typeid(FloatNumeric<double>)) {
-                const FloatNumeric<double>& secondDouble = dynamic_cast<const FloatNumeric<double>&>(second);
-                return std::make_unique<FloatNumeric<double>>(static_cast<double>(intValue) * secondDouble.floatValue);
-            } else if (typeid(second) == typeid(ComplexNumeric<float>)) {
-                const ComplexNumeric<float>& secondComplex = dynamic_cast<const ComplexNumeric<float>&>(second);
-                return std::make_unique<ComplexNumeric<float>>(std::complex<float>(intValue, 0) * secondComplex.complexNum);
-            } else if (typeid(second) == typeid(ComplexNumeric<double>)) {
-                const ComplexNumeric<double>& secondComplex = dynamic_cast<const ComplexNumeric<double>&>(second);
-                return std::make_unique<ComplexNumeric<double>>(std::complex<double>(intValue, 0) * secondComplex.complexNum);
-            } else {
-                // If the type is not supported, throw an exception
-                throw std::runtime_error("Unsupported type for multiplication.");
-            }
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("multiplyOperation: Memory allocation failed.");
-        }
+}
+
+std::unique_ptr<Numeric> Numeric::divideOperation(const Numeric& second) {
+    try {
+        return apply(NumericOp::Divide, *this, second);
+    } catch (const std::bad_alloc& e) {
+        throw std::runtime_error("divideOperation: Memory allocation failed.");
     }
-    
-    std::unique_ptr<Numeric> IntNumeric::divideOperation(const Numeric& second) {
-        try {
-            const IntNumeric& secondInt = dynamic_cast<const IntNumeric&>(second);
-    
-            if (secondInt.intValue == 0) {
-                throw std::runtime_error("divideOperation: Division by zero is not allowed.");
-            }
-    
-            return std::make_unique<IntNumeric>(intValue / secondInt.intValue);
-        } catch (const std::bad_cast&) {
-            // If the types don't match, convert the current object to the type of the second operand
-            if (typeid(second) == typeid(FloatNumeric<float>)) {
-                const FloatNumeric<float>& secondFloat = dynamic_cast<const FloatNumeric<float>&>(second);
-    
-                if (secondFloat.floatValue == 0) {
-                    throw std::runtime_error("divideOperation: Division by zero is not allowed.");
-                }
-    
-                return std::make_unique<FloatNumeric<float>>(static_cast<float>(intValue) / secondFloat.floatValue);
-            } else if (typeid(second) == typeid(FloatNumeric<double>)) {
-                const FloatNumeric<double>& secondDouble = dynamic_cast<const FloatNumeric<double>&>(second);
-    
-                if (secondDouble.floatValue == 0) {
-                    throw std::runtime_error("divideOperation: Division by zero is not allowed.");
-                }
-    
-                return std::make_unique<FloatNumeric<double>>(static_cast<double>(intValue) / secondDouble.floatValue);
-            } else if (typeid(second) == typeid(ComplexNumeric<float>)) {
-                const ComplexNumeric<float>& secondComplex = dynamic_cast<const ComplexNumeric<float>&>(second);
-    
-                if (std::abs(secondComplex.complexNum) == 0) {
-                    throw std::runtime_error("divideOperation: Division by zero is not allowed.");
-                }
-    
-                return std::make_unique<ComplexNumeric<float>>(std::complex<float>(intValue, 0) / secondComplex.complexNum);
-            } else if (typeid(second) == typeid(ComplexNumeric<double>)) {
-                const ComplexNumeric<double>& secondComplex = dynamic_cast<const ComplexNumeric<double>&>(second);
-    
-                if (std::abs(secondComplex.complexNum) == 0) {
-                    throw std::runtime_error("divideOperation: Division by zero is not allowed.");
-                }
-    
-                return std::make_unique<ComplexNumeric<double>>(std::complex<double>(intValue, 0) / secondComplex.complexNum);
-            } else {
-                // If the type is not supported, throw an exception
-                throw std::runtime_error("Unsupported type for division.");
-            }
-        } catch (const std::bad_alloc& e) {
-            throw std::runtime_error("divideOperation: Memory allocation failed.");
-        }
+}
+
+std::unique_ptr<Numeric> Numeric::addAssign(const Numeric& second) {
+    try {
+        return applyAssign(NumericOp::Sum, *this, second);
+    } catch (const std::bad_alloc& e) {
+        throw std::runtime_error("addAssign: Memory allocation failed.");
     }
+}
 
-bool IntNumeric::lessThanOperation(const Numeric& second) {
+std::unique_ptr<Numeric> Numeric::subAssign(const Numeric& second) {
     try {
-        const IntNumeric& secondInt = dynamic_cast<const IntNumeric&>(second);
-        return (intValue < secondInt.intValue);
-    } catch (const std::bad_cast&) {
-        // If the types don't match, convert the second operand to IntNumeric
-        auto converted = second.convertTo(typeid(IntNumeric));
-        const IntNumeric& secondInt = dynamic_cast<const IntNumeric&>(*converted);
-        return (intValue < secondInt.intValue);
+        return applyAssign(NumericOp::Subtract, *this, second);
+    } catch (const std::bad_alloc& e) {
+        throw std::runtime_error("subAssign: Memory allocation failed.");
     }
 }
 
-bool IntNumeric::greaterThanOperation(const Numeric& second) {
+std::unique_ptr<Numeric> Numeric::mulAssign(const Numeric& second) {
     try {
-        const IntNumeric& secondInt = dynamic_cast<const IntNumeric&>(second);
-        return (intValue > secondInt.intValue);
-    } catch (const std::bad_cast&) {
-        // If the types don't match, convert the second operand to IntNumeric
-        auto converted = second.convertTo(typeid(IntNumeric));
-        const IntNumeric& secondInt = dynamic_cast<const IntNumeric&>(*converted);
-        return (intValue > secondInt.intValue);
+        return applyAssign(NumericOp::Multiply, *this, second);
+    } catch (const std::bad_alloc& e) {
+        throw std::runtime_error("mulAssign: Memory allocation failed.");
     }
 }
 
-bool IntNumeric::equalOperation(const Numeric& second) {
+std::unique_ptr<Numeric> Numeric::divAssign(const Numeric& second) {
     try {
-        const IntNumeric& secondInt = dynamic_cast<const IntNumeric&>(second);
-        return (intValue == secondInt.intValue);
-    } catch (const std::bad_cast&) {
-        // If the types don't match, convert the second operand to IntNumeric
-        auto converted = second.convertTo(typeid(IntNumeric));
-        const IntNumeric& secondInt = dynamic_cast<const IntNumeric&>(*converted);
-        return (intValue == secondInt.intValue);
+        return applyAssign(NumericOp::Divide, *this, second);
+    } catch (const std::bad_alloc& e) {
+        throw std::runtime_error("divAssign: Memory allocation failed.");
     }
 }
-std::string IntNumeric::toString() const
-{
-    return std::to_string(intValue); // from std library 
+
+bool Numeric::lessThanOperation(const Numeric& second) {
+    return compare(NumericOp::LessThan, *this, second);
 }
 
-IntNumeric::~IntNumeric()
-{
-    #if DEBUG == 1
-    std::cout << "IntNumeric Class destructor with value: " << intValue << std::endl;
-    #endif // DEBUG
+bool Numeric::greaterThanOperation(const Numeric& second) {
+    return compare(NumericOp::GreaterThan, *this, second);
+}
+
+bool Numeric::equalOperation(const Numeric& second) {
+    return compare(NumericOp::Equal, *this, second);
 }
 
 
+/* The mixed-type rules used to be written out in every class as a dynamic_cast
+ * attempt followed by typeid checks in the std::bad_cast handler. They now live in
+ * NumericKernels.hpp and are reached through the tables in NumericDispatch.cpp. */
+
+/**Templates do not allow me to use runtime polymorphism as easily.
+ * So, if i want to have different types (e.g., integer vs. floating-point vs. complex)
+ *  in the same container, a base class with polymorphism (like my current design) becomes more useful */
+
+
+
+
+ /************************ IntegerNumeric Class ********************************/
+
+ /**Also this class will be defined in the .hpp as it is a template class (IntNumeric is IntegerNumeric<int>) */
+
+
 /************************ FloatNumeric Class ********************************/
 
 //secondly, derived class with template parameter for floating and double
@@ -0,0 +1,962 @@
+#include "NumericBigInt.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+/************************ Thresholds ********************************/
+
+namespace {
+
+NumericBigIntThresholds& activeThresholds()
+{
+    static NumericBigIntThresholds thresholds;
+    return thresholds;
+}
+
+} // namespace
+
+NumericBigIntThresholds numericBigIntThresholds()
+{
+    return activeThresholds();
+}
+
+// Below these sizes the split algorithms would recurse forever on one-limb pieces
+void setNumericBigIntThresholds(const NumericBigIntThresholds& thresholds)
+{
+    NumericBigIntThresholds& active = activeThresholds();
+    active = thresholds;
+    active.karatsuba = std::max<std::size_t>(active.karatsuba, 4);
+    active.toom3 = std::max<std::size_t>(active.toom3, 9);
+    active.division = std::max<std::size_t>(active.division, 2);
+    active.decimal = std::max<std::size_t>(active.decimal, 2);
+}
+
+
+/************************ Limb kernels ********************************/
+
+/**
+ * Unsigned magnitudes as (pointer, limb count), least significant limb first. Outputs
+ * never overlap inputs unless stated otherwise.
+ */
+
+namespace {
+
+using Limb = NumericBigInt::Limb;
+__extension__ using WideLimb = unsigned __int128;
+
+constexpr Limb decimalBase = 10000000000000000000ull;   // 10^19, the largest power of 10 in a limb
+constexpr std::size_t decimalBaseDigits = 19;
+
+std::size_t trimmed(const Limb* a, std::size_t n)
+{
+    while (n != 0 && a[n - 1] == 0) {
+        --n;
+    }
+    return n;
+}
+
+int compareLimbs(const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    if (na != nb) {
+        return na < nb ? -1 : 1;
+    }
+    for (std::size_t i = na; i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// acc[0, n) += b[0, nb), nb <= n; returns the carry out of the top limb
+Limb addInto(Limb* acc, std::size_t n, const Limb* b, std::size_t nb)
+{
+    Limb carry = 0;
+    std::size_t i = 0;
+    for (; i < nb; ++i) {
+        const WideLimb sum = WideLimb(acc[i]) + b[i] + carry;
+        acc[i] = static_cast<Limb>(sum);
+        carry = static_cast<Limb>(sum >> 64);
+    }
+    for (; carry != 0 && i < n; ++i) {
+        carry = ++acc[i] == 0;
+    }
+    return carry;
+}
+
+// acc[0, n) -= b[0, nb), nb <= n; returns the borrow out of the top limb
+Limb subtractFrom(Limb* acc, std::size_t n, const Limb* b, std::size_t nb)
+{
+    Limb borrow = 0;
+    std::size_t i = 0;
+    for (; i < nb; ++i) {
+        const Limb x = acc[i];
+        const Limb difference = x - b[i];
+        acc[i] = difference - borrow;
+        borrow = (x < b[i]) | (difference < borrow);
+    }
+    for (; borrow != 0 && i < n; ++i) {
+        borrow = acc[i]-- == 0;
+    }
+    return borrow;
+}
+
+// a[0, n) = a * factor + addend (in place); returns the limb carried out
+Limb multiplyAddSmall(Limb* a, std::size_t n, Limb factor, Limb addend)
+{
+    Limb carry = addend;
+    for (std::size_t i = 0; i < n; ++i) {
+        const WideLimb product = WideLimb(a[i]) * factor + carry;
+        a[i] = static_cast<Limb>(product);
+        carry = static_cast<Limb>(product >> 64);
+    }
+    return carry;
+}
+
+// quotient[0, n) = a / divisor (quotient may be a); returns the remainder
+Limb divideSmall(Limb* quotient, const Limb* a, std::size_t n, Limb divisor)
+{
+    Limb remainder = 0;
+    for (std::size_t i = n; i-- > 0;) {
+        const WideLimb numerator = (WideLimb(remainder) << 64) | a[i];
+        quotient[i] = static_cast<Limb>(numerator / divisor);
+        remainder = static_cast<Limb>(numerator % divisor);
+    }
+    return remainder;
+}
+
+// out[0, n + 1) = a[0, n) << shift, 0 <= shift < 64
+void shiftLeftLimbs(Limb* out, const Limb* a, std::size_t n, int shift)
+{
+    Limb carry = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = (a[i] << shift) | carry;
+        carry = shift ? a[i] >> (64 - shift) : 0;
+    }
+    out[n] = carry;
+}
+
+/************************ Multiplication ********************************/
+
+void multiplyLimbs(Limb* out, const Limb* a, std::size_t na, const Limb* b, std::size_t nb);
+
+// out[0, na + nb) = a * b in O(na * nb)
+void schoolbookMultiply(Limb* out, const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    std::fill(out, out + na, Limb(0));
+    for (std::size_t j = 0; j < nb; ++j) {
+        const Limb factor = b[j];
+        Limb carry = 0;
+        for (std::size_t i = 0; i < na; ++i) {
+            const WideLimb product = WideLimb(a[i]) * factor + out[i + j] + carry;
+            out[i + j] = static_cast<Limb>(product);
+            carry = static_cast<Limb>(product >> 64);
+        }
+        out[j + na] = carry;
+    }
+}
+
+// na >= 2 * nb: a is cut into blocks of nb limbs, each multiplied by b with the balanced algorithms
+void unbalancedMultiply(Limb* out, const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    std::fill(out, out + na + nb, Limb(0));
+    std::vector<Limb> partial(2 * nb);
+    for (std::size_t offset = 0; offset < na; offset += nb) {
+        const std::size_t block = std::min(nb, na - offset);
+        multiplyLimbs(partial.data(), a + offset, block, b, nb);
+        addInto(out + offset, na + nb - offset, partial.data(), block + nb);
+    }
+}
+
+/**
+ * nb <= na < 2 * nb. With a = a1 x + a0, b = b1 x + b0 and x = 2^(64 * half):
+ * a b = a1 b1 x^2 + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) x + a0 b0, three products of
+ * half the size instead of four.
+ */
+void karatsubaMultiply(Limb* out, const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    const std::size_t half = na / 2;   // < nb, so both high halves are non-empty
+    const std::size_t highA = na - half;
+    const std::size_t highB = nb - half;
+
+    multiplyLimbs(out, a, half, b, half);
+    multiplyLimbs(out + 2 * half, a + half, highA, b + half, highB);
+
+    std::vector<Limb> sumA(highA + 1), sumB(std::max(half, highB) + 1);
+    std::copy(a + half, a + na, sumA.begin());
+    sumA[highA] = addInto(sumA.data(), highA, a, half);
+    if (highB >= half) {
+        std::copy(b + half, b + nb, sumB.begin());
+        sumB[highB] = addInto(sumB.data(), highB, b, half);
+    } else {
+        std::copy(b, b + half, sumB.begin());
+        sumB[half] = addInto(sumB.data(), half, b + half, highB);
+    }
+
+    const std::size_t sizeA = trimmed(sumA.data(), sumA.size());
+    const std::size_t sizeB = trimmed(sumB.data(), sumB.size());
+    std::vector<Limb> middle(sumA.size() + sumB.size(), 0);
+    multiplyLimbs(middle.data(), sumA.data(), sizeA, sumB.data(), sizeB);
+    subtractFrom(middle.data(), middle.size(), out, 2 * half);
+    subtractFrom(middle.data(), middle.size(), out + 2 * half, highA + highB);
+    addInto(out + half, na + nb - half, middle.data(), trimmed(middle.data(), middle.size()));
+}
+
+} // namespace
+
+struct NumericBigIntAccess
+{
+    // Sets the limb count to n, keeping the current limbs and zeroing the new ones
+    static Limb* resize(NumericBigInt& x, std::size_t n)
+    {
+        if (n > x.capacity) {
+            Limb* grown = new Limb[n]();
+            std::copy(x.data(), x.data() + x.count, grown);
+            if (x.capacity > NumericBigInt::inlineLimbs) {
+                delete[] x.heapData;
+            }
+            x.heapData = grown;
+            x.capacity = static_cast<std::uint32_t>(n);
+        } else if (n > x.count) {
+            std::fill(x.data() + x.count, x.data() + n, Limb(0));
+        }
+        x.count = static_cast<std::uint32_t>(n);
+        return x.data();
+    }
+
+    // Drops the leading zero limbs; zero is never negative
+    static void normalize(NumericBigInt& x)
+    {
+        x.count = static_cast<std::uint32_t>(trimmed(x.data(), x.count));
+        x.negative = x.negative && x.count != 0;
+    }
+
+    static void setNegative(NumericBigInt& x, bool negative)
+    {
+        x.negative = negative && x.count != 0;
+    }
+
+    static Limb* limbs(NumericBigInt& x)
+    {
+        return x.data();
+    }
+
+    static NumericBigInt fromLimbs(const Limb* limbs, std::size_t n)
+    {
+        NumericBigInt x;
+        std::copy(limbs, limbs + n, resize(x, n));
+        normalize(x);
+        return x;
+    }
+
+    static NumericBigInt shiftLeft(const NumericBigInt& x, std::size_t bits)
+    {
+        if (x.isZero()) {
+            return x;
+        }
+        NumericBigInt result;
+        Limb* out = resize(result, x.count + bits / 64 + 1);
+        shiftLeftLimbs(out + bits / 64, x.data(), x.count, static_cast<int>(bits % 64));
+        result.negative = x.negative;
+        normalize(result);
+        return result;
+    }
+
+    // Magnitude >> bits, sign kept
+    static NumericBigInt shiftRight(const NumericBigInt& x, std::size_t bits)
+    {
+        const std::size_t skip = bits / 64;
+        if (skip >= x.count) {
+            return NumericBigInt();
+        }
+        const int shift = static_cast<int>(bits % 64);
+        const Limb* in = x.data();
+        const std::size_t n = x.count - skip;
+        NumericBigInt result;
+        Limb* out = resize(result, n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const Limb high = (shift != 0 && i + 1 < n) ? in[skip + i + 1] << (64 - shift) : 0;
+            out[i] = (in[skip + i] >> shift) | high;
+        }
+        result.negative = x.negative;
+        normalize(result);
+        return result;
+    }
+
+    // Magnitude mod 2^bits
+    static NumericBigInt lowBits(const NumericBigInt& x, std::size_t bits)
+    {
+        const std::size_t n = std::min<std::size_t>(x.count, (bits + 63) / 64);
+        NumericBigInt result = fromLimbs(x.data(), n);
+        if (bits % 64 != 0 && n == (bits + 63) / 64) {
+            result.data()[n - 1] &= (Limb(1) << (bits % 64)) - 1;
+            normalize(result);
+        }
+        return result;
+    }
+
+    // |x| as a new value, or x itself when it is not negative
+    static const NumericBigInt& magnitude(const NumericBigInt& x, NumericBigInt& storage)
+    {
+        if (!x.negative) {
+            return x;
+        }
+        storage = x;
+        storage.negative = false;
+        return storage;
+    }
+};
+
+namespace {
+
+using Access = NumericBigIntAccess;
+
+/**
+ * nb <= na < 2 * nb, above the Toom-3 threshold. a and b are split into three pieces
+ * of k limbs, evaluated at 0, 1, -1, -2 and infinity, multiplied pointwise (five
+ * products of a third of the size) and interpolated with Bodrato's sequence. The
+ * pieces and the signed intermediates are NumericBigInt values.
+ */
+void toom3Multiply(Limb* out, const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    const std::size_t k = (na + 2) / 3;
+    const auto piece = [k](const Limb* x, std::size_t n, std::size_t index) {
+        const std::size_t begin = std::min(n, index * k);
+        const std::size_t end = std::min(n, begin + k);
+        return Access::fromLimbs(x + begin, end - begin);
+    };
+    const NumericBigInt a0 = piece(a, na, 0), a1 = piece(a, na, 1), a2 = piece(a, na, 2);
+    const NumericBigInt b0 = piece(b, nb, 0), b1 = piece(b, nb, 1), b2 = piece(b, nb, 2);
+
+    const NumericBigInt evenA = a0 + a2, evenB = b0 + b2;
+    const NumericBigInt oneA = evenA + a1, oneB = evenB + b1;
+    const NumericBigInt minusOneA = evenA - a1, minusOneB = evenB - b1;
+    const NumericBigInt minusTwoA = Access::shiftLeft(minusOneA + a2, 1) - a0;
+    const NumericBigInt minusTwoB = Access::shiftLeft(minusOneB + b2, 1) - b0;
+
+    const NumericBigInt r0 = a0 * b0;
+    const NumericBigInt rInfinity = a2 * b2;
+    NumericBigInt r1 = oneA * oneB;
+    const NumericBigInt rMinusOne = minusOneA * minusOneB;
+    NumericBigInt r3 = minusTwoA * minusTwoB;
+
+    // Exact divisions: the differences are multiples of 3 and of 2
+    const auto divideExact = [](NumericBigInt value, Limb divisor) {
+        Limb* limbs = Access::limbs(value);
+        divideSmall(limbs, limbs, value.limbs().size(), divisor);
+        Access::normalize(value);
+        return value;
+    };
+    r3 = divideExact(r3 - r1, 3);
+    r1 = divideExact(r1 - rMinusOne, 2);
+    NumericBigInt r2 = rMinusOne - r0;
+    r3 = divideExact(r2 - r3, 2) + Access::shiftLeft(rInfinity, 1);
+    r2 = r2 + r1 - rInfinity;
+    r1 = r1 - r3;
+
+    // The coefficients of a product of non-negative polynomials are non-negative
+    std::fill(out, out + na + nb, Limb(0));
+    const NumericBigInt* coefficients[] = {&r0, &r1, &r2, &r3, &rInfinity};
+    for (std::size_t i = 0; i < 5; ++i) {
+        const std::span<const Limb> limbs = coefficients[i]->limbs();
+        if (!limbs.empty()) {
+            addInto(out + i * k, na + nb - i * k, limbs.data(), limbs.size());
+        }
+    }
+}
+
+void multiplyLimbs(Limb* out, const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb == 0) {
+        std::fill(out, out + na, Limb(0));
+        return;
+    }
+    const NumericBigIntThresholds& thresholds = activeThresholds();
+    if (nb < thresholds.karatsuba) {
+        schoolbookMultiply(out, a, na, b, nb);
+    } else if (na >= 2 * nb) {
+        unbalancedMultiply(out, a, na, b, nb);
+    } else if (nb < thresholds.toom3) {
+        karatsubaMultiply(out, a, na, b, nb);
+    } else {
+        toom3Multiply(out, a, na, b, nb);
+    }
+}
+
+/************************ Division ********************************/
+
+/**
+ * Knuth's algorithm D: quotient[0, na - nb + 1) = a / b, remainder[0, nb) = a % b, for
+ * na >= nb >= 2 and b[nb - 1] != 0. The divisor is shifted so its top bit is set, which
+ * makes each estimated quotient limb at most 2 too large.
+ */
+void knuthDivide(Limb* quotient, Limb* remainder, const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    const int shift = std::countl_zero(b[nb - 1]);
+    std::vector<Limb> v(nb + 1), u(na + 1);
+    shiftLeftLimbs(v.data(), b, nb, shift);
+    shiftLeftLimbs(u.data(), a, na, shift);
+    const Limb top = v[nb - 1];
+    const Limb next = v[nb - 2];
+
+    for (std::size_t j = na - nb + 1; j-- > 0;) {
+        const WideLimb numerator = (WideLimb(u[j + nb]) << 64) | u[j + nb - 1];
+        WideLimb estimate = numerator / top;
+        WideLimb rest = numerator % top;
+        while ((estimate >> 64) != 0 || estimate * next > ((rest << 64) | u[j + nb - 2])) {
+            --estimate;
+            rest += top;
+            if ((rest >> 64) != 0) {
+                break;
+            }
+        }
+
+        Limb carry = 0;
+        Limb borrow = 0;
+        for (std::size_t i = 0; i < nb; ++i) {
+            const WideLimb product = estimate * v[i] + carry;
+            carry = static_cast<Limb>(product >> 64);
+            const Limb low = static_cast<Limb>(product);
+            const Limb x = u[i + j];
+            const Limb difference = x - low;
+            u[i + j] = difference - borrow;
+            borrow = (x < low) | (difference < borrow);
+        }
+        const Limb x = u[j + nb];
+        const Limb difference = x - carry;
+        u[j + nb] = difference - borrow;
+        if ((x < carry) | (difference < borrow)) {
+            // The estimate was one too large: add the divisor back
+            --estimate;
+            u[j + nb] += addInto(u.data() + j, nb, v.data(), nb);
+        }
+        quotient[j] = static_cast<Limb>(estimate);
+    }
+
+    for (std::size_t i = 0; i < nb; ++i) {
+        remainder[i] = shift ? (u[i] >> shift) | (u[i + 1] << (64 - shift)) : u[i];
+    }
+}
+
+// Non-negative a and b != 0, without recursion
+void divideBasic(const NumericBigInt& a, const NumericBigInt& b, NumericBigInt& quotient, NumericBigInt& remainder)
+{
+    const std::span<const Limb> x = a.limbs();
+    const std::span<const Limb> y = b.limbs();
+    if (compareLimbs(x.data(), x.size(), y.data(), y.size()) < 0) {
+        quotient = NumericBigInt();
+        remainder = a;
+        return;
+    }
+    NumericBigInt q, r;
+    if (y.size() == 1) {
+        r = divideSmall(Access::resize(q, x.size()), x.data(), x.size(), y[0]);
+    } else {
+        knuthDivide(Access::resize(q, x.size() - y.size() + 1), Access::resize(r, y.size()), x.data(), x.size(), y.data(), y.size());
+        Access::normalize(r);
+    }
+    Access::normalize(q);
+    quotient = std::move(q);
+    remainder = std::move(r);
+}
+
+/**
+ * Burnikel-Ziegler recursive division, on non-negative values and bit counts: a < b 2^n
+ * and 2^(n-1) <= b < 2^n. The top 3n/2 bits of a are divided by the top n bits of b
+ * recursively, the estimate is corrected with one multiplication by the low half of b,
+ * and the same is repeated for the rest of a.
+ */
+void divideTwoByOne(NumericBigInt a, NumericBigInt b, std::size_t n, NumericBigInt& quotient, NumericBigInt& remainder);
+
+void divideThreeByTwo(const NumericBigInt& high, const NumericBigInt& low, const NumericBigInt& b, const NumericBigInt& bHigh,
+                      const NumericBigInt& bLow, std::size_t n, NumericBigInt& quotient, NumericBigInt& remainder)
+{
+    NumericBigInt q, r;
+    if (Access::shiftRight(high, n) == bHigh) {
+        q = Access::shiftLeft(NumericBigInt(1), n) - 1;
+        r = high - Access::shiftLeft(bHigh, n) + bHigh;
+    } else {
+        divideTwoByOne(high, bHigh, n, q, r);
+    }
+    r = Access::shiftLeft(r, n) + low - q * bLow;
+    while (r.isNegative()) {
+        q -= 1;
+        r += b;
+    }
+    quotient = std::move(q);
+    remainder = std::move(r);
+}
+
+void divideTwoByOne(NumericBigInt a, NumericBigInt b, std::size_t n, NumericBigInt& quotient, NumericBigInt& remainder)
+{
+    const std::size_t limit = 64 * activeThresholds().division;
+    if (a.bitLength() <= n + limit) {
+        divideBasic(a, b, quotient, remainder);
+        return;
+    }
+    const bool pad = n & 1;
+    if (pad) {
+        a = Access::shiftLeft(a, 1);
+        b = Access::shiftLeft(b, 1);
+        ++n;
+    }
+    const std::size_t half = n / 2;
+    const NumericBigInt bHigh = Access::shiftRight(b, half);
+    const NumericBigInt bLow = Access::lowBits(b, half);
+
+    NumericBigInt high, low, r;
+    divideThreeByTwo(Access::shiftRight(a, n), Access::lowBits(Access::shiftRight(a, half), half), b, bHigh, bLow, half, high, r);
+    divideThreeByTwo(r, Access::lowBits(a, half), b, bHigh, bLow, half, low, r);
+    if (pad) {
+        r = Access::shiftRight(r, 1);
+    }
+    quotient = Access::shiftLeft(high, half) + low;
+    remainder = std::move(r);
+}
+
+// Non-negative a and b != 0
+void divideMagnitude(const NumericBigInt& a, const NumericBigInt& b, NumericBigInt& quotient, NumericBigInt& remainder)
+{
+    const std::size_t threshold = activeThresholds().division;
+    const std::size_t na = a.limbs().size();
+    const std::size_t nb = b.limbs().size();
+    if (nb < threshold || na < nb + threshold) {
+        divideBasic(a, b, quotient, remainder);
+        return;
+    }
+
+    // Schoolbook division in base 2^n, n = bits of b, with one recursive step per digit
+    const std::size_t n = b.bitLength();
+    const std::size_t digits = (a.bitLength() + n - 1) / n;
+    NumericBigInt q, r;
+    for (std::size_t i = digits; i-- > 0;) {
+        NumericBigInt digit;
+        divideTwoByOne(Access::shiftLeft(r, n) + Access::lowBits(Access::shiftRight(a, i * n), n), b, n, digit, r);
+        q = Access::shiftLeft(q, n) + digit;
+    }
+    quotient = std::move(q);
+    remainder = std::move(r);
+}
+
+/************************ Decimal conversion ********************************/
+
+// powers[k] = 10^(19 * 2^k), while its limb count stays below `limbs`
+std::vector<NumericBigInt> decimalPowers(std::size_t limbs)
+{
+    std::vector<NumericBigInt> powers{NumericBigInt(decimalBase)};
+    while (powers.back().limbs().size() * 2 <= limbs) {
+        powers.push_back(powers.back() * powers.back());
+    }
+    return powers;
+}
+
+// Digits of the magnitude by repeated division by 10^19, left-padded with zeros to `width`
+void appendDecimalSchoolbook(std::string& out, const NumericBigInt& x, std::size_t width)
+{
+    std::vector<Limb> work(x.limbs().begin(), x.limbs().end());
+    std::vector<Limb> groups;
+    for (std::size_t n = work.size(); n != 0; n = trimmed(work.data(), n)) {
+        groups.push_back(divideSmall(work.data(), work.data(), n, decimalBase));
+    }
+
+    std::string text;
+    text.reserve(groups.size() * decimalBaseDigits);
+    char digits[decimalBaseDigits + 1];
+    for (std::size_t i = groups.size(); i-- > 0;) {
+        const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), groups[i]);
+        const std::size_t length = static_cast<std::size_t>(result.ptr - digits);
+        if (i + 1 != groups.size()) {
+            text.append(decimalBaseDigits - length, '0');
+        }
+        text.append(digits, length);
+    }
+    if (text.size() < width) {
+        out.append(width - text.size(), '0');
+    }
+    out += text;
+}
+
+// Splits at the largest power that has at most half the limbs of x: high digits, then exactly 19 * 2^k low digits
+void appendDecimal(std::string& out, const NumericBigInt& x, std::size_t width, const std::vector<NumericBigInt>& powers)
+{
+    const std::size_t n = x.limbs().size();
+    std::size_t k = powers.size();
+    while (k > 0 && powers[k - 1].limbs().size() * 2 > n + 1) {
+        --k;
+    }
+    if (n <= activeThresholds().decimal || k == 0) {
+        appendDecimalSchoolbook(out, x, width);
+        return;
+    }
+    --k;
+    const std::size_t lowDigits = decimalBaseDigits << k;
+    NumericBigInt high, low;
+    divideMagnitude(x, powers[k], high, low);
+    appendDecimal(out, high, width ? width - lowDigits : 0, powers);
+    appendDecimal(out, low, lowDigits, powers);
+}
+
+// Groups of 19 digits, most significant first, folded in with one multiply-add each
+NumericBigInt parseDecimalSchoolbook(std::string_view digits)
+{
+    NumericBigInt x;
+    std::size_t used = 0;
+    std::size_t first = digits.size() % decimalBaseDigits;
+    if (first == 0) {
+        first = decimalBaseDigits;
+    }
+    for (std::size_t begin = 0; begin < digits.size();) {
+        const std::size_t length = begin == 0 ? first : decimalBaseDigits;
+        Limb group = 0;
+        std::from_chars(digits.data() + begin, digits.data() + begin + length, group);
+        const Limb factor = begin == 0 ? 1 : decimalBase;
+        Limb* limbs = Access::resize(x, used + 1);
+        limbs[used] = multiplyAddSmall(limbs, used, factor, group);
+        used = trimmed(limbs, used + 1);
+        Access::resize(x, used);
+        begin += length;
+    }
+    return x;
+}
+
+NumericBigInt parseDecimal(std::string_view digits, const std::vector<NumericBigInt>& powers)
+{
+    std::size_t k = powers.size();
+    while (k > 0 && (decimalBaseDigits << (k - 1)) >= digits.size()) {
+        --k;
+    }
+    if (digits.size() <= activeThresholds().decimal * decimalBaseDigits || k == 0) {
+        return parseDecimalSchoolbook(digits);
+    }
+    --k;
+    const std::size_t split = digits.size() - (decimalBaseDigits << k);
+    return parseDecimal(digits.substr(0, split), powers) * powers[k] + parseDecimal(digits.substr(split), powers);
+}
+
+} // namespace
+
+
+/************************ NumericBigInt Class ********************************/
+
+NumericBigInt::NumericBigInt(const NumericBigInt& other) : negative(other.negative)
+{
+    std::copy(other.data(), other.data() + other.count, Access::resize(*this, other.count));
+}
+
+NumericBigInt::NumericBigInt(NumericBigInt&& other) noexcept : count(other.count), capacity(other.capacity), negative(other.negative)
+{
+    if (other.capacity > inlineLimbs) {
+        heapData = other.heapData;
+        other.capacity = inlineLimbs;
+    } else {
+        // Only the used limbs: the rest of the inline storage may never have been written
+        std::copy(other.inlineData, other.inlineData + other.count, inlineData);
+    }
+    other.count = 0;
+    other.negative = false;
+}
+
+NumericBigInt& NumericBigInt::operator=(const NumericBigInt& other)
+{
+    if (this != &other) {
+        count = 0;
+        std::copy(other.data(), other.data() + other.count, Access::resize(*this, other.count));
+        negative = other.negative;
+    }
+    return *this;
+}
+
+NumericBigInt& NumericBigInt::operator=(NumericBigInt&& other) noexcept
+{
+    if (this != &other) {
+        if (capacity > inlineLimbs) {
+            delete[] heapData;
+        }
+        count = other.count;
+        capacity = other.capacity;
+        negative = other.negative;
+        if (other.capacity > inlineLimbs) {
+            heapData = other.heapData;
+            other.capacity = inlineLimbs;
+        } else {
+            std::copy(other.inlineData, other.inlineData + other.count, inlineData);
+        }
+        other.count = 0;
+        other.negative = false;
+    }
+    return *this;
+}
+
+NumericBigInt::~NumericBigInt()
+{
+    if (capacity > inlineLimbs) {
+        delete[] heapData;
+    }
+}
+
+std::size_t NumericBigInt::bitLength() const
+{
+    return count ? 64 * count - static_cast<std::size_t>(std::countl_zero(data()[count - 1])) : 0;
+}
+
+void NumericBigInt::assignFloating(long double value)
+{
+    if (!std::isfinite(value)) {
+        return;
+    }
+    const bool minus = value < 0;
+    value = std::fabs(std::trunc(value));
+    if (value < 0x1p64L) {
+        setSmall(static_cast<Limb>(value));
+    } else {
+        // value = significand * 2^(exponent - 64) with a 64-bit significand, which holds any long double exactly
+        int exponent = 0;
+        const Limb significand = static_cast<Limb>(std::ldexp(std::frexp(value, &exponent), 64));
+        *this = Access::shiftLeft(NumericBigInt(significand), static_cast<std::size_t>(exponent - 64));
+    }
+    Access::setNegative(*this, minus);
+}
+
+std::uint64_t NumericBigInt::topBits() const
+{
+    const std::size_t bits = bitLength();
+    if (bits <= 64) {
+        return data()[0] << (64 - bits);
+    }
+    const std::size_t shift = bits - 64;
+    const NumericBigInt top = Access::shiftRight(*this, shift);
+    const Limb significand = top.data()[0];
+    const Limb* limbs = data();
+    bool sticky = (shift % 64 != 0) && (limbs[shift / 64] & ((Limb(1) << (shift % 64)) - 1)) != 0;
+    for (std::size_t i = 0; !sticky && i < shift / 64; ++i) {
+        sticky = limbs[i] != 0;
+    }
+    return significand | sticky;
+}
+
+// The top 64 bits with their sticky bit, so float and double round correctly
+long double NumericBigInt::toLongDouble() const
+{
+    const std::size_t bits = bitLength();
+    if (bits <= 64) {
+        const long double magnitude = count ? static_cast<long double>(data()[0]) : 0.0L;
+        return negative ? -magnitude : magnitude;
+    }
+    const std::size_t shift = bits - 64;
+    const long double magnitude = std::ldexp(static_cast<long double>(topBits()), static_cast<int>(std::min<std::size_t>(shift, 1 << 20)));
+    return negative ? -magnitude : magnitude;
+}
+
+NumericBigInt NumericBigInt::fromString(std::string_view text)
+{
+    std::string_view digits = text;
+    const bool minus = !digits.empty() && digits[0] == '-';
+    if (!digits.empty() && (digits[0] == '-' || digits[0] == '+')) {
+        digits.remove_prefix(1);
+    }
+    if (digits.empty() || !std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        throw std::runtime_error("fromString: Invalid number \"" + std::string(text) + "\".");
+    }
+    const std::size_t firstDigit = std::min(digits.find_first_not_of('0'), digits.size());
+    digits.remove_prefix(firstDigit);
+
+    NumericBigInt result;
+    if (digits.size() <= activeThresholds().decimal * decimalBaseDigits) {
+        result = parseDecimalSchoolbook(digits);
+    } else {
+        // Limbs needed for half the digits: log2(10) / 64 < 0.052
+        result = parseDecimal(digits, decimalPowers(digits.size() / 19 + 2));
+    }
+    Access::setNegative(result, minus);
+    return result;
+}
+
+std::string NumericBigInt::toString() const
+{
+    if (isZero()) {
+        return "0";
+    }
+    std::string out;
+    out.reserve(decimalBound());
+    if (negative) {
+        out += '-';
+    }
+    NumericBigInt storage;
+    const NumericBigInt& magnitude = Access::magnitude(*this, storage);
+    if (count <= activeThresholds().decimal) {
+        appendDecimalSchoolbook(out, magnitude, 0);
+    } else {
+        appendDecimal(out, magnitude, 0, decimalPowers(count));
+    }
+    return out;
+}
+
+char* NumericBigInt::toChars(char* first, char* last) const
+{
+    if (count <= 1) {
+        if (negative && first != last) {
+            *first++ = '-';
+        }
+        const std::to_chars_result result = std::to_chars(first, last, count ? data()[0] : Limb(0));
+        return result.ec == std::errc() ? result.ptr : nullptr;
+    }
+    const std::string text = toString();
+    if (static_cast<std::size_t>(last - first) < text.size()) {
+        return nullptr;
+    }
+    std::memcpy(first, text.data(), text.size());
+    return first + text.size();
+}
+
+namespace {
+
+// a + b when subtract is false, a - b otherwise
+NumericBigInt addSigned(const NumericBigInt& a, const NumericBigInt& b, bool subtract)
+{
+    const bool negativeA = a.isNegative();
+    const bool negativeB = b.isNegative() != subtract;
+    const std::span<const Limb> x = a.limbs();
+    const std::span<const Limb> y = b.limbs();
+
+    NumericBigInt result;
+    if (negativeA == negativeB) {
+        const std::span<const Limb> larger = x.size() >= y.size() ? x : y;
+        const std::span<const Limb> smaller = x.size() >= y.size() ? y : x;
+        Limb* out = Access::resize(result, larger.size() + 1);
+        std::copy(larger.begin(), larger.end(), out);
+        out[larger.size()] = addInto(out, larger.size(), smaller.data(), smaller.size());
+        Access::normalize(result);
+        Access::setNegative(result, negativeA);
+        return result;
+    }
+    const int order = compareLimbs(x.data(), x.size(), y.data(), y.size());
+    if (order == 0) {
+        return result;
+    }
+    const std::span<const Limb> larger = order > 0 ? x : y;
+    const std::span<const Limb> smaller = order > 0 ? y : x;
+    Limb* out = Access::resize(result, larger.size());
+    std::copy(larger.begin(), larger.end(), out);
+    subtractFrom(out, larger.size(), smaller.data(), smaller.size());
+    Access::normalize(result);
+    Access::setNegative(result, order > 0 ? negativeA : negativeB);
+    return result;
+}
+
+} // namespace
+
+NumericBigInt NumericBigInt::operator-() const
+{
+    NumericBigInt result = *this;
+    Access::setNegative(result, !negative);
+    return result;
+}
+
+NumericBigInt operator+(const NumericBigInt& first, const NumericBigInt& second)
+{
+    return addSigned(first, second, false);
+}
+
+NumericBigInt operator-(const NumericBigInt& first, const NumericBigInt& second)
+{
+    return addSigned(first, second, true);
+}
+
+NumericBigInt operator*(const NumericBigInt& first, const NumericBigInt& second)
+{
+    NumericBigInt result;
+    if (first.isZero() || second.isZero()) {
+        return result;
+    }
+    const std::span<const Limb> x = first.limbs();
+    const std::span<const Limb> y = second.limbs();
+    Limb* out = Access::resize(result, x.size() + y.size());
+    if (x.size() == 1 && y.size() == 1) {
+        const WideLimb product = WideLimb(x[0]) * y[0];
+        out[0] = static_cast<Limb>(product);
+        out[1] = static_cast<Limb>(product >> 64);
+    } else {
+        multiplyLimbs(out, x.data(), x.size(), y.data(), y.size());
+    }
+    Access::normalize(result);
+    Access::setNegative(result, first.isNegative() != second.isNegative());
+    return result;
+}
+
+void NumericBigInt::divide(const NumericBigInt& first, const NumericBigInt& second, NumericBigInt& quotient, NumericBigInt& remainder)
+{
+    if (second.isZero()) {
+        throw std::runtime_error("divideOperation: Division by zero is not allowed.");
+    }
+    NumericBigInt firstStorage, secondStorage, q, r;
+    divideMagnitude(Access::magnitude(first, firstStorage), Access::magnitude(second, secondStorage), q, r);
+    Access::setNegative(q, first.isNegative() != second.isNegative());
+    Access::setNegative(r, first.isNegative());
+    quotient = std::move(q);
+    remainder = std::move(r);
+}
+
+NumericBigInt operator/(const NumericBigInt& first, const NumericBigInt& second)
+{
+    NumericBigInt quotient, remainder;
+    NumericBigInt::divide(first, second, quotient, remainder);
+    return quotient;
+}
+
+NumericBigInt operator%(const NumericBigInt& first, const NumericBigInt& second)
+{
+    NumericBigInt quotient, remainder;
+    NumericBigInt::divide(first, second, quotient, remainder);
+    return remainder;
+}
+
+NumericBigInt& NumericBigInt::operator+=(const NumericBigInt& other)
+{
+    return *this = *this + other;
+}
+
+NumericBigInt& NumericBigInt::operator-=(const NumericBigInt& other)
+{
+    return *this = *this - other;
+}
+
+NumericBigInt& NumericBigInt::operator*=(const NumericBigInt& other)
+{
+    return *this = *this * other;
+}
+
+NumericBigInt& NumericBigInt::operator/=(const NumericBigInt& other)
+{
+    return *this = *this / other;
+}
+
+NumericBigInt& NumericBigInt::operator%=(const NumericBigInt& other)
+{
+    return *this = *this % other;
+}
+
+bool operator==(const NumericBigInt& first, const NumericBigInt& second)
+{
+    return first.negative == second.negative &&
+           compareLimbs(first.data(), first.count, second.data(), second.count) == 0;
+}
+
+std::strong_ordering operator<=>(const NumericBigInt& first, const NumericBigInt& second)
+{
+    if (first.negative != second.negative) {
+        return first.negative ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+    const int order = compareLimbs(first.data(), first.count, second.data(), second.count);
+    return (first.negative ? -order : order) <=> 0;
+}
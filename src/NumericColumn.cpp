@@ -0,0 +1,905 @@
+#include "NumericColumn.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NUMERIC_COLUMN_X86 1
+#include <immintrin.h>
+#else
+#define NUMERIC_COLUMN_X86 0
+#endif
+
+
+/************************ NumericMask Class ********************************/
+
+std::size_t NumericMask::count() const
+{
+    std::size_t total = 0;
+    for (std::uint64_t word : bits) {
+        total += static_cast<std::size_t>(std::popcount(word));
+    }
+    return total;
+}
+
+
+/************************ Instruction set selection ********************************/
+
+namespace {
+
+NumericSimdLevel detectSimdLevel()
+{
+#if NUMERIC_COLUMN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return NumericSimdLevel::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return NumericSimdLevel::Avx2;
+    }
+#endif
+    return NumericSimdLevel::Scalar;
+}
+
+NumericSimdLevel supportedSimdLevel()
+{
+    static const NumericSimdLevel level = detectSimdLevel();
+    return level;
+}
+
+NumericSimdLevel& activeSimdLevel()
+{
+    static NumericSimdLevel level = supportedSimdLevel();
+    return level;
+}
+
+} // namespace
+
+NumericSimdLevel numericSimdLevel()
+{
+    return activeSimdLevel();
+}
+
+void setNumericSimdLevel(NumericSimdLevel level)
+{
+    activeSimdLevel() = (level < supportedSimdLevel()) ? level : supportedSimdLevel();
+}
+
+
+/************************ Scalar kernels ********************************/
+
+/**
+ * The reference path: the very same ArithmeticKernel / ComparisonKernel the Numeric
+ * classes use, applied element by element. Every type goes through here when no SIMD
+ * kernel exists for it (long double, complex, characters, integer division, 8- and
+ * 64-bit integer multiply, 128-bit decimals, decimal multiply and divide) and for the
+ * tail that does not fill a whole vector.
+ */
+
+namespace {
+
+// True when an element overflowed: zero divisors are rejected before, so that is the only failure left
+template <NumericOp Op, typename T>
+bool scalarArithmetic(const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t begin, std::size_t count,
+                      NumericOverflow overflow)
+{
+    using Kernel = ArithmeticKernel<Op, numericKindOf<T>, numericKindOf<T>>;
+    bool failed = false;
+    if constexpr (isDecimalValue<T> && (Op == NumericOp::Multiply || Op == NumericOp::Divide)) {
+        // What the kernel does, with the rounding mode read once instead of per element
+        const NumericRounding rounding = numericRoundingMode();
+        for (std::size_t i = begin; i < count; ++i) {
+            failed |= decimalArithmetic<Op>(lhs[i], broadcast ? rhs[0] : rhs[i], out[i], overflow, rounding) != NumericError::None;
+        }
+        return failed;
+    }
+    for (std::size_t i = begin; i < count; ++i) {
+        failed |= Kernel::apply(lhs[i], broadcast ? rhs[0] : rhs[i], out[i], overflow) != NumericError::None;
+    }
+    return failed;
+}
+
+template <NumericOp Op, typename T>
+void scalarCompare(const T* lhs, const T* rhs, bool broadcast, std::uint64_t* maskWords, std::size_t begin, std::size_t count)
+{
+    using Kernel = ComparisonKernel<Op, numericKindOf<T>, numericKindOf<T>>;
+    for (std::size_t i = begin; i < count; ++i) {
+        bool result = false;
+        Kernel::apply(lhs[i], broadcast ? rhs[0] : rhs[i], result);
+        maskWords[i / 64] |= std::uint64_t(result) << (i % 64);
+    }
+}
+
+template <typename T>
+bool scalarHasZero(const T* values, std::size_t count)
+{
+    bool zero = false;
+    for (std::size_t i = 0; i < count; ++i) {
+        zero |= isZeroDivisor(values[i]);
+    }
+    return zero;
+}
+
+} // namespace
+
+
+#if NUMERIC_COLUMN_X86
+
+/************************ AVX2 kernels ********************************/
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace avx2 {
+
+inline __m256 load(const float* p) { return _mm256_loadu_ps(p); }
+inline __m256d load(const double* p) { return _mm256_loadu_pd(p); }
+inline __m256i load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+inline __m256 splat(float v) { return _mm256_set1_ps(v); }
+inline __m256d splat(double v) { return _mm256_set1_pd(v); }
+inline __m256i splat(int v) { return _mm256_set1_epi32(v); }
+
+inline void store(float* p, __m256 v) { _mm256_storeu_ps(p, v); }
+inline void store(double* p, __m256d v) { _mm256_storeu_pd(p, v); }
+inline void store(int* p, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+template <NumericOp Op>
+inline __m256 compute(__m256 a, __m256 b)
+{
+    if constexpr (Op == NumericOp::Sum) return _mm256_add_ps(a, b);
+    else if constexpr (Op == NumericOp::Subtract) return _mm256_sub_ps(a, b);
+    else if constexpr (Op == NumericOp::Multiply) return _mm256_mul_ps(a, b);
+    else return _mm256_div_ps(a, b);
+}
+
+template <NumericOp Op>
+inline __m256d compute(__m256d a, __m256d b)
+{
+    if constexpr (Op == NumericOp::Sum) return _mm256_add_pd(a, b);
+    else if constexpr (Op == NumericOp::Subtract) return _mm256_sub_pd(a, b);
+    else if constexpr (Op == NumericOp::Multiply) return _mm256_mul_pd(a, b);
+    else return _mm256_div_pd(a, b);
+}
+
+// Ordered, non-signalling predicates: NaN compares false, exactly like the scalar operators
+template <NumericOp Op>
+inline unsigned compareBits(__m256 a, __m256 b)
+{
+    constexpr int predicate = (Op == NumericOp::LessThan) ? _CMP_LT_OQ : (Op == NumericOp::GreaterThan) ? _CMP_GT_OQ : _CMP_EQ_OQ;
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, predicate)));
+}
+
+template <NumericOp Op>
+inline unsigned compareBits(__m256d a, __m256d b)
+{
+    constexpr int predicate = (Op == NumericOp::LessThan) ? _CMP_LT_OQ : (Op == NumericOp::GreaterThan) ? _CMP_GT_OQ : _CMP_EQ_OQ;
+    return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, predicate)));
+}
+
+template <NumericOp Op>
+inline unsigned compareBits(__m256i a, __m256i b)
+{
+    __m256i result;
+    if constexpr (Op == NumericOp::LessThan) result = _mm256_cmpgt_epi32(b, a);
+    else if constexpr (Op == NumericOp::GreaterThan) result = _mm256_cmpgt_epi32(a, b);
+    else result = _mm256_cmpeq_epi32(a, b);
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(result)));
+}
+
+template <NumericOp Op, typename T>
+std::size_t arithmetic(const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t count)
+{
+    constexpr std::size_t width = 32 / sizeof(T);
+    const auto scalar = splat(rhs[0]);
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        store(out + i, compute<Op>(load(lhs + i), broadcast ? scalar : load(rhs + i)));
+    }
+    return i;
+}
+
+template <NumericOp Op, typename T>
+std::size_t compare(const T* lhs, const T* rhs, bool broadcast, std::uint64_t* maskWords, std::size_t count)
+{
+    constexpr std::size_t width = 32 / sizeof(T);
+    const auto scalar = splat(rhs[0]);
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        std::uint64_t bits = compareBits<Op>(load(lhs + i), broadcast ? scalar : load(rhs + i));
+        maskWords[i / 64] |= bits << (i % 64);
+    }
+    return i;
+}
+
+template <typename T>
+bool hasZero(const T* values, std::size_t count)
+{
+    constexpr std::size_t width = 32 / sizeof(T);
+    const auto zero = splat(T(0));
+    unsigned found = 0;
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        found |= compareBits<NumericOp::Equal>(load(values + i), zero);
+    }
+    return found != 0 || scalarHasZero(values + i, count - i);
+}
+
+/**
+ * Integer add, subtract and multiply for every width. Each step computes the wrapped
+ * result and a lane mask of the elements whose exact result does not fit; the masks
+ * are OR-ed together and tested once at the end (Checked), or used to blend in the
+ * saturated values (Saturate). Wrap skips the masks altogether. There is no integer
+ * division instruction, nor an 8- or 64-bit multiply whose overflow is cheap to see:
+ * those stay on the scalar path.
+ */
+
+template <typename T>
+inline __m256i loadLanes(const T* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+template <typename T>
+inline void storeLanes(T* p, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+template <typename T>
+inline __m256i splatLanes(T v)
+{
+    if constexpr (sizeof(T) == 1) return _mm256_set1_epi8(static_cast<char>(v));
+    else if constexpr (sizeof(T) == 2) return _mm256_set1_epi16(static_cast<short>(v));
+    else if constexpr (sizeof(T) == 4) return _mm256_set1_epi32(static_cast<int>(v));
+    else return _mm256_set1_epi64x(static_cast<long long>(v));
+}
+
+template <typename T>
+inline __m256i addLanes(__m256i a, __m256i b)
+{
+    if constexpr (sizeof(T) == 1) return _mm256_add_epi8(a, b);
+    else if constexpr (sizeof(T) == 2) return _mm256_add_epi16(a, b);
+    else if constexpr (sizeof(T) == 4) return _mm256_add_epi32(a, b);
+    else return _mm256_add_epi64(a, b);
+}
+
+template <typename T>
+inline __m256i subLanes(__m256i a, __m256i b)
+{
+    if constexpr (sizeof(T) == 1) return _mm256_sub_epi8(a, b);
+    else if constexpr (sizeof(T) == 2) return _mm256_sub_epi16(a, b);
+    else if constexpr (sizeof(T) == 4) return _mm256_sub_epi32(a, b);
+    else return _mm256_sub_epi64(a, b);
+}
+
+template <typename T>
+inline __m256i equalLanes(__m256i a, __m256i b)
+{
+    if constexpr (sizeof(T) == 1) return _mm256_cmpeq_epi8(a, b);
+    else if constexpr (sizeof(T) == 2) return _mm256_cmpeq_epi16(a, b);
+    else if constexpr (sizeof(T) == 4) return _mm256_cmpeq_epi32(a, b);
+    else return _mm256_cmpeq_epi64(a, b);
+}
+
+// Signed a > b
+template <typename T>
+inline __m256i greaterLanes(__m256i a, __m256i b)
+{
+    if constexpr (sizeof(T) == 1) return _mm256_cmpgt_epi8(a, b);
+    else if constexpr (sizeof(T) == 2) return _mm256_cmpgt_epi16(a, b);
+    else if constexpr (sizeof(T) == 4) return _mm256_cmpgt_epi32(a, b);
+    else return _mm256_cmpgt_epi64(a, b);
+}
+
+inline __m256i notLanes(__m256i v) { return _mm256_xor_si256(v, _mm256_set1_epi32(-1)); }
+
+template <typename T>
+inline __m256i negativeLanes(__m256i v) { return greaterLanes<T>(_mm256_setzero_si256(), v); }
+
+// Unsigned a > b: flipping the sign bits turns it into a signed compare
+template <typename T>
+inline __m256i unsignedGreaterLanes(__m256i a, __m256i b)
+{
+    const __m256i bias = splatLanes(static_cast<T>(T(1) << (8 * sizeof(T) - 1)));
+    return greaterLanes<T>(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+}
+
+template <NumericOp Op, typename T>
+inline __m256i wrappedLanes(__m256i a, __m256i b)
+{
+    if constexpr (Op == NumericOp::Sum) return addLanes<T>(a, b);
+    else if constexpr (Op == NumericOp::Subtract) return subLanes<T>(a, b);
+    else if constexpr (sizeof(T) == 2) return _mm256_mullo_epi16(a, b);
+    else return _mm256_mullo_epi32(a, b);
+}
+
+// The adds / subs instructions of the 8- and 16-bit lanes, which equal the exact result whenever it fits
+template <NumericOp Op, typename T>
+inline __m256i saturatingLanes(__m256i a, __m256i b)
+{
+    constexpr bool isSigned = std::is_signed_v<T>;
+    if constexpr (sizeof(T) == 1 && Op == NumericOp::Sum) return isSigned ? _mm256_adds_epi8(a, b) : _mm256_adds_epu8(a, b);
+    else if constexpr (sizeof(T) == 1) return isSigned ? _mm256_subs_epi8(a, b) : _mm256_subs_epu8(a, b);
+    else if constexpr (Op == NumericOp::Sum) return isSigned ? _mm256_adds_epi16(a, b) : _mm256_adds_epu16(a, b);
+    else return isSigned ? _mm256_subs_epi16(a, b) : _mm256_subs_epu16(a, b);
+}
+
+// Wrapped a op b; `overflow` gets all ones in the lanes whose exact result does not fit T
+template <NumericOp Op, typename T>
+inline __m256i checkedLanes(__m256i a, __m256i b, __m256i& overflow)
+{
+    constexpr bool isSigned = std::is_signed_v<T>;
+    const __m256i zero = _mm256_setzero_si256();
+
+    if constexpr (Op == NumericOp::Multiply && sizeof(T) == 2) {
+        // The product fits when its high half is the sign extension of the low half
+        const __m256i low = _mm256_mullo_epi16(a, b);
+        const __m256i high = isSigned ? _mm256_mulhi_epi16(a, b) : _mm256_mulhi_epu16(a, b);
+        overflow = notLanes(_mm256_cmpeq_epi16(high, isSigned ? _mm256_srai_epi16(low, 15) : zero));
+        return low;
+    } else if constexpr (Op == NumericOp::Multiply) {
+        // Full 64-bit products of the even and the odd lanes, high halves gathered back into place
+        const __m256i low = _mm256_mullo_epi32(a, b);
+        const __m256i oddA = _mm256_srli_epi64(a, 32);
+        const __m256i oddB = _mm256_srli_epi64(b, 32);
+        const __m256i even = isSigned ? _mm256_mul_epi32(a, b) : _mm256_mul_epu32(a, b);
+        const __m256i odd = isSigned ? _mm256_mul_epi32(oddA, oddB) : _mm256_mul_epu32(oddA, oddB);
+        const __m256i high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+        overflow = notLanes(_mm256_cmpeq_epi32(high, isSigned ? _mm256_srai_epi32(low, 31) : zero));
+        return low;
+    } else if constexpr (sizeof(T) <= 2) {
+        const __m256i wrapped = wrappedLanes<Op, T>(a, b);
+        overflow = notLanes(equalLanes<T>(wrapped, saturatingLanes<Op, T>(a, b)));
+        return wrapped;
+    } else if constexpr (Op == NumericOp::Sum) {
+        // Signed: both operands have the sign the result lacks. Unsigned: the result wrapped below a
+        const __m256i result = addLanes<T>(a, b);
+        overflow = isSigned ? negativeLanes<T>(_mm256_and_si256(_mm256_xor_si256(a, result), _mm256_xor_si256(b, result)))
+                            : unsignedGreaterLanes<T>(a, result);
+        return result;
+    } else {
+        // Signed: the operands differ in sign and the result lost a's sign. Unsigned: b > a
+        const __m256i result = subLanes<T>(a, b);
+        overflow = isSigned ? negativeLanes<T>(_mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, result)))
+                            : unsignedGreaterLanes<T>(b, a);
+        return result;
+    }
+}
+
+// integerSaturated() for whole vectors: MIN is ~MAX, so each case flips MAX by a sign mask
+template <NumericOp Op, typename T>
+inline __m256i saturatedLanes(__m256i a, __m256i b)
+{
+    if constexpr (std::is_unsigned_v<T>) {
+        return (Op == NumericOp::Subtract) ? _mm256_setzero_si256() : _mm256_set1_epi32(-1);
+    } else {
+        const __m256i max = splatLanes(std::numeric_limits<T>::max());
+        if constexpr (Op == NumericOp::Sum) return _mm256_xor_si256(max, negativeLanes<T>(b));
+        else if constexpr (Op == NumericOp::Subtract) return _mm256_xor_si256(max, notLanes(negativeLanes<T>(b)));
+        else return _mm256_xor_si256(max, negativeLanes<T>(_mm256_xor_si256(a, b)));
+    }
+}
+
+template <NumericOp Op, typename T, NumericOverflow Overflow>
+std::size_t integerLoop(const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t count, bool& overflowed)
+{
+    constexpr std::size_t width = 32 / sizeof(T);
+    const __m256i scalar = splatLanes(rhs[0]);
+    __m256i flags = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        const __m256i a = loadLanes(lhs + i);
+        const __m256i b = broadcast ? scalar : loadLanes(rhs + i);
+        if constexpr (Overflow == NumericOverflow::Wrap) {
+            storeLanes(out + i, wrappedLanes<Op, T>(a, b));
+        } else {
+            __m256i lanes;
+            __m256i result = checkedLanes<Op, T>(a, b, lanes);
+            if constexpr (Overflow == NumericOverflow::Saturate) {
+                result = _mm256_blendv_epi8(result, saturatedLanes<Op, T>(a, b), lanes);
+            } else {
+                flags = _mm256_or_si256(flags, lanes);
+            }
+            storeLanes(out + i, result);
+        }
+    }
+    overflowed = !_mm256_testz_si256(flags, flags);
+    return i;
+}
+
+template <NumericOp Op, typename T>
+std::size_t integerArithmetic(const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t count, NumericOverflow overflow, bool& overflowed)
+{
+    switch (overflow) {
+        case NumericOverflow::Wrap:     return integerLoop<Op, T, NumericOverflow::Wrap>(lhs, rhs, broadcast, out, count, overflowed);
+        case NumericOverflow::Saturate: return integerLoop<Op, T, NumericOverflow::Saturate>(lhs, rhs, broadcast, out, count, overflowed);
+        default:                        return integerLoop<Op, T, NumericOverflow::Checked>(lhs, rhs, broadcast, out, count, overflowed);
+    }
+}
+
+} // namespace avx2
+
+#pragma GCC pop_options
+
+
+/************************ AVX-512 kernels ********************************/
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+namespace avx512 {
+
+inline __m512 load(const float* p) { return _mm512_loadu_ps(p); }
+inline __m512d load(const double* p) { return _mm512_loadu_pd(p); }
+inline __m512i load(const int* p) { return _mm512_loadu_si512(p); }
+
+inline __m512 splat(float v) { return _mm512_set1_ps(v); }
+inline __m512d splat(double v) { return _mm512_set1_pd(v); }
+inline __m512i splat(int v) { return _mm512_set1_epi32(v); }
+
+inline void store(float* p, __m512 v) { _mm512_storeu_ps(p, v); }
+inline void store(double* p, __m512d v) { _mm512_storeu_pd(p, v); }
+inline void store(int* p, __m512i v) { _mm512_storeu_si512(p, v); }
+
+template <NumericOp Op>
+inline __m512 compute(__m512 a, __m512 b)
+{
+    if constexpr (Op == NumericOp::Sum) return _mm512_add_ps(a, b);
+    else if constexpr (Op == NumericOp::Subtract) return _mm512_sub_ps(a, b);
+    else if constexpr (Op == NumericOp::Multiply) return _mm512_mul_ps(a, b);
+    else return _mm512_div_ps(a, b);
+}
+
+template <NumericOp Op>
+inline __m512d compute(__m512d a, __m512d b)
+{
+    if constexpr (Op == NumericOp::Sum) return _mm512_add_pd(a, b);
+    else if constexpr (Op == NumericOp::Subtract) return _mm512_sub_pd(a, b);
+    else if constexpr (Op == NumericOp::Multiply) return _mm512_mul_pd(a, b);
+    else return _mm512_div_pd(a, b);
+}
+
+template <NumericOp Op>
+inline unsigned compareBits(__m512 a, __m512 b)
+{
+    constexpr int predicate = (Op == NumericOp::LessThan) ? _CMP_LT_OQ : (Op == NumericOp::GreaterThan) ? _CMP_GT_OQ : _CMP_EQ_OQ;
+    return _mm512_cmp_ps_mask(a, b, predicate);
+}
+
+template <NumericOp Op>
+inline unsigned compareBits(__m512d a, __m512d b)
+{
+    constexpr int predicate = (Op == NumericOp::LessThan) ? _CMP_LT_OQ : (Op == NumericOp::GreaterThan) ? _CMP_GT_OQ : _CMP_EQ_OQ;
+    return _mm512_cmp_pd_mask(a, b, predicate);
+}
+
+template <NumericOp Op>
+inline unsigned compareBits(__m512i a, __m512i b)
+{
+    constexpr int predicate = (Op == NumericOp::LessThan) ? _MM_CMPINT_LT : (Op == NumericOp::GreaterThan) ? _MM_CMPINT_NLE : _MM_CMPINT_EQ;
+    return _mm512_cmp_epi32_mask(a, b, predicate);
+}
+
+template <NumericOp Op, typename T>
+std::size_t arithmetic(const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t count)
+{
+    constexpr std::size_t width = 64 / sizeof(T);
+    const auto scalar = splat(rhs[0]);
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        store(out + i, compute<Op>(load(lhs + i), broadcast ? scalar : load(rhs + i)));
+    }
+    return i;
+}
+
+template <NumericOp Op, typename T>
+std::size_t compare(const T* lhs, const T* rhs, bool broadcast, std::uint64_t* maskWords, std::size_t count)
+{
+    constexpr std::size_t width = 64 / sizeof(T);
+    const auto scalar = splat(rhs[0]);
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        std::uint64_t bits = compareBits<Op>(load(lhs + i), broadcast ? scalar : load(rhs + i));
+        maskWords[i / 64] |= bits << (i % 64);
+    }
+    return i;
+}
+
+template <typename T>
+bool hasZero(const T* values, std::size_t count)
+{
+    constexpr std::size_t width = 64 / sizeof(T);
+    const auto zero = splat(T(0));
+    unsigned found = 0;
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        found |= compareBits<NumericOp::Equal>(load(values + i), zero);
+    }
+    return found != 0 || scalarHasZero(values + i, count - i);
+}
+
+/**
+ * 32- and 64-bit integer add, subtract and 32-bit multiply, as in the AVX2 kernels but
+ * with the overflow lanes kept in mask registers. The 8- and 16-bit widths need
+ * AVX-512BW and use the AVX2 kernels instead.
+ */
+
+template <typename T>
+inline __m512i loadLanes(const T* p) { return _mm512_loadu_si512(p); }
+
+template <typename T>
+inline void storeLanes(T* p, __m512i v) { _mm512_storeu_si512(p, v); }
+
+template <typename T>
+inline __m512i splatLanes(T v)
+{
+    if constexpr (sizeof(T) == 4) return _mm512_set1_epi32(static_cast<int>(v));
+    else return _mm512_set1_epi64(static_cast<long long>(v));
+}
+
+template <typename T>
+inline __m512i addLanes(__m512i a, __m512i b) { if constexpr (sizeof(T) == 4) return _mm512_add_epi32(a, b); else return _mm512_add_epi64(a, b); }
+
+template <typename T>
+inline __m512i subLanes(__m512i a, __m512i b) { if constexpr (sizeof(T) == 4) return _mm512_sub_epi32(a, b); else return _mm512_sub_epi64(a, b); }
+
+// Arithmetic shift that spreads the sign bit over the lane
+template <typename T>
+inline __m512i signLanes(__m512i v) { if constexpr (sizeof(T) == 4) return _mm512_srai_epi32(v, 31); else return _mm512_srai_epi64(v, 63); }
+
+template <typename T>
+inline unsigned negativeMask(__m512i v)
+{
+    if constexpr (sizeof(T) == 4) return _mm512_cmplt_epi32_mask(v, _mm512_setzero_si512());
+    else return _mm512_cmplt_epi64_mask(v, _mm512_setzero_si512());
+}
+
+template <typename T>
+inline unsigned unsignedLessMask(__m512i a, __m512i b)
+{
+    if constexpr (sizeof(T) == 4) return _mm512_cmplt_epu32_mask(a, b);
+    else return _mm512_cmplt_epu64_mask(a, b);
+}
+
+template <typename T>
+inline __m512i blendLanes(unsigned mask, __m512i a, __m512i b)
+{
+    if constexpr (sizeof(T) == 4) return _mm512_mask_blend_epi32(static_cast<__mmask16>(mask), a, b);
+    else return _mm512_mask_blend_epi64(static_cast<__mmask8>(mask), a, b);
+}
+
+template <NumericOp Op, typename T>
+inline __m512i wrappedLanes(__m512i a, __m512i b)
+{
+    if constexpr (Op == NumericOp::Sum) return addLanes<T>(a, b);
+    else if constexpr (Op == NumericOp::Subtract) return subLanes<T>(a, b);
+    else return _mm512_mullo_epi32(a, b);
+}
+
+template <NumericOp Op, typename T>
+inline __m512i checkedLanes(__m512i a, __m512i b, unsigned& overflow)
+{
+    constexpr bool isSigned = std::is_signed_v<T>;
+
+    if constexpr (Op == NumericOp::Multiply) {
+        const __m512i low = _mm512_mullo_epi32(a, b);
+        const __m512i oddA = _mm512_srli_epi64(a, 32);
+        const __m512i oddB = _mm512_srli_epi64(b, 32);
+        const __m512i even = isSigned ? _mm512_mul_epi32(a, b) : _mm512_mul_epu32(a, b);
+        const __m512i odd = isSigned ? _mm512_mul_epi32(oddA, oddB) : _mm512_mul_epu32(oddA, oddB);
+        const __m512i high = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+        overflow = _mm512_cmpneq_epi32_mask(high, isSigned ? _mm512_srai_epi32(low, 31) : _mm512_setzero_si512());
+        return low;
+    } else if constexpr (Op == NumericOp::Sum) {
+        const __m512i result = addLanes<T>(a, b);
+        overflow = isSigned ? negativeMask<T>(_mm512_and_si512(_mm512_xor_si512(a, result), _mm512_xor_si512(b, result)))
+                            : unsignedLessMask<T>(result, a);
+        return result;
+    } else {
+        const __m512i result = subLanes<T>(a, b);
+        overflow = isSigned ? negativeMask<T>(_mm512_and_si512(_mm512_xor_si512(a, b), _mm512_xor_si512(a, result)))
+                            : unsignedLessMask<T>(a, b);
+        return result;
+    }
+}
+
+template <NumericOp Op, typename T>
+inline __m512i saturatedLanes(__m512i a, __m512i b)
+{
+    if constexpr (std::is_unsigned_v<T>) {
+        return (Op == NumericOp::Subtract) ? _mm512_setzero_si512() : _mm512_set1_epi32(-1);
+    } else {
+        const __m512i max = splatLanes(std::numeric_limits<T>::max());
+        const __m512i ones = _mm512_set1_epi32(-1);
+        if constexpr (Op == NumericOp::Sum) return _mm512_xor_si512(max, signLanes<T>(b));
+        else if constexpr (Op == NumericOp::Subtract) return _mm512_xor_si512(max, _mm512_xor_si512(signLanes<T>(b), ones));
+        else return _mm512_xor_si512(max, signLanes<T>(_mm512_xor_si512(a, b)));
+    }
+}
+
+template <NumericOp Op, typename T, NumericOverflow Overflow>
+std::size_t integerLoop(const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t count, bool& overflowed)
+{
+    constexpr std::size_t width = 64 / sizeof(T);
+    const __m512i scalar = splatLanes(rhs[0]);
+    unsigned flags = 0;
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        const __m512i a = loadLanes(lhs + i);
+        const __m512i b = broadcast ? scalar : loadLanes(rhs + i);
+        if constexpr (Overflow == NumericOverflow::Wrap) {
+            storeLanes(out + i, wrappedLanes<Op, T>(a, b));
+        } else {
+            unsigned lanes;
+            __m512i result = checkedLanes<Op, T>(a, b, lanes);
+            if constexpr (Overflow == NumericOverflow::Saturate) {
+                result = blendLanes<T>(lanes, result, saturatedLanes<Op, T>(a, b));
+            } else {
+                flags |= lanes;
+            }
+            storeLanes(out + i, result);
+        }
+    }
+    overflowed = flags != 0;
+    return i;
+}
+
+template <NumericOp Op, typename T>
+std::size_t integerArithmetic(const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t count, NumericOverflow overflow, bool& overflowed)
+{
+    switch (overflow) {
+        case NumericOverflow::Wrap:     return integerLoop<Op, T, NumericOverflow::Wrap>(lhs, rhs, broadcast, out, count, overflowed);
+        case NumericOverflow::Saturate: return integerLoop<Op, T, NumericOverflow::Saturate>(lhs, rhs, broadcast, out, count, overflowed);
+        default:                        return integerLoop<Op, T, NumericOverflow::Checked>(lhs, rhs, broadcast, out, count, overflowed);
+    }
+}
+
+} // namespace avx512
+
+#pragma GCC pop_options
+
+#endif // NUMERIC_COLUMN_X86
+
+
+/************************ Dispatch ********************************/
+
+namespace {
+
+template <typename T>
+constexpr bool hasSimdKernels = std::is_same_v<T, int> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// Integer add / subtract / multiply with vector overflow checks; wider lanes also have AVX-512 kernels
+template <NumericOp Op, typename T>
+constexpr bool hasIntegerLanes = IntegerValue<T> && Op != NumericOp::Divide &&
+                                 !(Op == NumericOp::Multiply && (sizeof(T) == 1 || sizeof(T) == 8));
+
+template <typename T>
+constexpr bool hasAvx512IntegerLanes = sizeof(T) >= 4;
+
+// Same-scale decimal add / subtract is 64-bit integer add / subtract on the units, overflow included
+template <NumericOp Op, typename T>
+constexpr bool hasDecimalLanes = isDecimalValue<T> && sizeof(T) == 8 && (Op == NumericOp::Sum || Op == NumericOp::Subtract);
+
+// float kernels on one block whose divisors are already known to be non-zero
+template <NumericOp Op>
+void floatBlock(const float* lhs, const float* rhs, bool broadcast, float* out, std::size_t count)
+{
+    std::size_t done = 0;
+#if NUMERIC_COLUMN_X86
+    switch (numericSimdLevel()) {
+        case NumericSimdLevel::Avx512: done = avx512::arithmetic<Op>(lhs, rhs, broadcast, out, count); break;
+        case NumericSimdLevel::Avx2:   done = avx2::arithmetic<Op>(lhs, rhs, broadcast, out, count); break;
+        default: break;
+    }
+#endif
+    scalarArithmetic<Op>(lhs, rhs, broadcast, out, done, count, NumericOverflow::Checked);
+}
+
+template <NumericOp Op>
+void floatCompareBlock(const float* lhs, const float* rhs, bool broadcast, std::uint64_t* maskWords, std::size_t count)
+{
+    std::size_t done = 0;
+#if NUMERIC_COLUMN_X86
+    switch (numericSimdLevel()) {
+        case NumericSimdLevel::Avx512: done = avx512::compare<Op>(lhs, rhs, broadcast, maskWords, count); break;
+        case NumericSimdLevel::Avx2:   done = avx2::compare<Op>(lhs, rhs, broadcast, maskWords, count); break;
+        default: break;
+    }
+#endif
+    scalarCompare<Op>(lhs, rhs, broadcast, maskWords, done, count);
+}
+
+/**
+ * 16-bit float columns compute in float, like their scalar operators: each block is
+ * widened with numericToFloat, run through the float kernels and rounded back with
+ * numericFromFloat, so the results are the same bits. A block is a multiple of 64
+ * elements, which keeps its comparison bits in whole mask words.
+ */
+constexpr std::size_t halfBlock = 1024;
+
+template <NumericOp Op, typename T>
+void halfArithmetic(const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t count)
+{
+    alignas(64) float first[halfBlock];
+    alignas(64) float second[halfBlock];
+    const float scalar = rhs[0].toFloat();
+    for (std::size_t begin = 0; begin < count; begin += halfBlock) {
+        const std::size_t size = std::min(halfBlock, count - begin);
+        numericToFloat(lhs + begin, first, size);
+        if (!broadcast) {
+            numericToFloat(rhs + begin, second, size);
+        }
+        floatBlock<Op>(first, broadcast ? &scalar : second, broadcast, first, size);
+        numericFromFloat(first, out + begin, size);
+    }
+}
+
+template <NumericOp Op, typename T>
+void halfCompare(const T* lhs, const T* rhs, bool broadcast, std::uint64_t* maskWords, std::size_t count)
+{
+    alignas(64) float first[halfBlock];
+    alignas(64) float second[halfBlock];
+    const float scalar = rhs[0].toFloat();
+    for (std::size_t begin = 0; begin < count; begin += halfBlock) {
+        const std::size_t size = std::min(halfBlock, count - begin);
+        numericToFloat(lhs + begin, first, size);
+        if (!broadcast) {
+            numericToFloat(rhs + begin, second, size);
+        }
+        floatCompareBlock<Op>(first, broadcast ? &scalar : second, broadcast, maskWords + begin / 64, size);
+    }
+}
+
+template <typename T>
+bool hasZeroDivisor(const T* values, std::size_t count)
+{
+#if NUMERIC_COLUMN_X86
+    if constexpr (hasSimdKernels<T>) {
+        switch (numericSimdLevel()) {
+            case NumericSimdLevel::Avx512: return avx512::hasZero(values, count);
+            case NumericSimdLevel::Avx2:   return avx2::hasZero(values, count);
+            default: break;
+        }
+    }
+#endif
+    return scalarHasZero(values, count);
+}
+
+template <NumericOp Op, typename T>
+NumericError arithmeticFor(const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t count, NumericOverflow overflow)
+{
+    constexpr NumericRule rule = arithmeticRule(numericKindOf<T>, numericKindOf<T>, Op);
+
+    if constexpr (rule.error != NumericError::None) {
+        return rule.error;
+    } else {
+        if (count == 0) {
+            return NumericError::None;
+        }
+        if constexpr (Op == NumericOp::Divide) {
+            if (hasZeroDivisor(rhs, broadcast ? 1 : count)) {
+                return NumericError::DivisionByZero;
+            }
+        }
+
+        if constexpr (isHalfValue<T>) {
+            halfArithmetic<Op>(lhs, rhs, broadcast, out, count);
+            return NumericError::None;
+        }
+
+        std::size_t done = 0;
+        bool overflowed = false;
+#if NUMERIC_COLUMN_X86
+        if constexpr (hasSimdKernels<T> && std::is_floating_point_v<T>) {
+            switch (numericSimdLevel()) {
+                case NumericSimdLevel::Avx512: done = avx512::arithmetic<Op>(lhs, rhs, broadcast, out, count); break;
+                case NumericSimdLevel::Avx2:   done = avx2::arithmetic<Op>(lhs, rhs, broadcast, out, count); break;
+                default: break;
+            }
+        } else if constexpr (hasIntegerLanes<Op, T>) {
+            switch (numericSimdLevel()) {
+                case NumericSimdLevel::Avx512:
+                    if constexpr (hasAvx512IntegerLanes<T>) {
+                        done = avx512::integerArithmetic<Op>(lhs, rhs, broadcast, out, count, overflow, overflowed);
+                        break;
+                    }
+                    [[fallthrough]];
+                case NumericSimdLevel::Avx2:
+                    done = avx2::integerArithmetic<Op>(lhs, rhs, broadcast, out, count, overflow, overflowed);
+                    break;
+                default: break;
+            }
+        } else if constexpr (hasDecimalLanes<Op, T>) {
+            const auto* a = reinterpret_cast<const std::int64_t*>(lhs);
+            const auto* b = reinterpret_cast<const std::int64_t*>(rhs);
+            auto* result = reinterpret_cast<std::int64_t*>(out);
+            switch (numericSimdLevel()) {
+                case NumericSimdLevel::Avx512: done = avx512::integerArithmetic<Op>(a, b, broadcast, result, count, overflow, overflowed); break;
+                case NumericSimdLevel::Avx2:   done = avx2::integerArithmetic<Op>(a, b, broadcast, result, count, overflow, overflowed); break;
+                default: break;
+            }
+        }
+#endif
+        overflowed |= scalarArithmetic<Op>(lhs, rhs, broadcast, out, done, count, overflow);
+        return overflowed ? NumericError::Overflow : NumericError::None;
+    }
+}
+
+template <NumericOp Op, typename T>
+NumericError compareFor(const T* lhs, const T* rhs, bool broadcast, std::uint64_t* maskWords, std::size_t count)
+{
+    if (count == 0) {
+        return NumericError::None;
+    }
+    if constexpr (isHalfValue<T>) {
+        halfCompare<Op>(lhs, rhs, broadcast, maskWords, count);
+        return NumericError::None;
+    }
+
+    std::size_t done = 0;
+#if NUMERIC_COLUMN_X86
+    if constexpr (hasSimdKernels<T>) {
+        switch (numericSimdLevel()) {
+            case NumericSimdLevel::Avx512: done = avx512::compare<Op>(lhs, rhs, broadcast, maskWords, count); break;
+            case NumericSimdLevel::Avx2:   done = avx2::compare<Op>(lhs, rhs, broadcast, maskWords, count); break;
+            default: break;
+        }
+    }
+#endif
+    scalarCompare<Op>(lhs, rhs, broadcast, maskWords, done, count);
+    return NumericError::None;
+}
+
+} // namespace
+
+
+template <typename T>
+NumericError columnArithmetic(NumericOp op, const T* lhs, const T* rhs, bool broadcast, T* out, std::size_t count, NumericOverflow overflow)
+{
+    switch (op) {
+        case NumericOp::Sum:      return arithmeticFor<NumericOp::Sum>(lhs, rhs, broadcast, out, count, overflow);
+        case NumericOp::Subtract: return arithmeticFor<NumericOp::Subtract>(lhs, rhs, broadcast, out, count, overflow);
+        case NumericOp::Multiply: return arithmeticFor<NumericOp::Multiply>(lhs, rhs, broadcast, out, count, overflow);
+        case NumericOp::Divide:   return arithmeticFor<NumericOp::Divide>(lhs, rhs, broadcast, out, count, overflow);
+        default:
+            throw std::invalid_argument("columnArithmetic: not an arithmetic operation.");
+    }
+}
+
+template <typename T>
+NumericError columnCompare(NumericOp op, const T* lhs, const T* rhs, bool broadcast, std::uint64_t* maskWords, std::size_t count)
+{
+    switch (op) {
+        case NumericOp::LessThan:    return compareFor<NumericOp::LessThan>(lhs, rhs, broadcast, maskWords, count);
+        case NumericOp::GreaterThan: return compareFor<NumericOp::GreaterThan>(lhs, rhs, broadcast, maskWords, count);
+        case NumericOp::Equal:       return compareFor<NumericOp::Equal>(lhs, rhs, broadcast, maskWords, count);
+        default:
+            throw std::invalid_argument("columnCompare: not a comparison operation.");
+    }
+}
+
+#define NUMERIC_COLUMN_INSTANTIATE(T) \
+    template NumericError columnArithmetic<T>(NumericOp, const T*, const T*, bool, T*, std::size_t, NumericOverflow); \
+    template NumericError columnCompare<T>(NumericOp, const T*, const T*, bool, std::uint64_t*, std::size_t);
+
+NUMERIC_COLUMN_INSTANTIATE(int)
+NUMERIC_COLUMN_INSTANTIATE(float)
+NUMERIC_COLUMN_INSTANTIATE(double)
+NUMERIC_COLUMN_INSTANTIATE(long double)
+NUMERIC_COLUMN_INSTANTIATE(std::complex<float>)
+NUMERIC_COLUMN_INSTANTIATE(std::complex<double>)
+NUMERIC_COLUMN_INSTANTIATE(std::complex<long double>)
+NUMERIC_COLUMN_INSTANTIATE(char)
+NUMERIC_COLUMN_INSTANTIATE(wchar_t)
+NUMERIC_COLUMN_INSTANTIATE(char16_t)
+NUMERIC_COLUMN_INSTANTIATE(char32_t)
+NUMERIC_COLUMN_INSTANTIATE(std::int8_t)
+NUMERIC_COLUMN_INSTANTIATE(std::int16_t)
+NUMERIC_COLUMN_INSTANTIATE(std::int64_t)
+NUMERIC_COLUMN_INSTANTIATE(std::uint8_t)
+NUMERIC_COLUMN_INSTANTIATE(std::uint16_t)
+NUMERIC_COLUMN_INSTANTIATE(std::uint32_t)
+NUMERIC_COLUMN_INSTANTIATE(std::uint64_t)
+NUMERIC_COLUMN_INSTANTIATE(NumericDecimal2)
+NUMERIC_COLUMN_INSTANTIATE(NumericDecimal6)
+NUMERIC_COLUMN_INSTANTIATE(NumericDecimal18)
+NUMERIC_COLUMN_INSTANTIATE(NumericFloat16)
+NUMERIC_COLUMN_INSTANTIATE(NumericBFloat16)
+
+#undef NUMERIC_COLUMN_INSTANTIATE
@@ -0,0 +1,760 @@
+#include "NumericComplex.hpp"
+
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NUMERIC_COMPLEX_X86 1
+#include <immintrin.h>
+#else
+#define NUMERIC_COMPLEX_X86 0
+#endif
+
+
+/************************ Scalar kernels ********************************/
+
+/**
+ * Strict is std::complex itself; the vector kernels must match it bit for bit, so this
+ * file is built with -ffp-contract=off (see CMakeLists.txt): with FMA enabled by the
+ * target pragmas, GCC would otherwise fuse a * c - b * d and change the last bit.
+ * Fast is the plain formula.
+ */
+
+namespace {
+
+template <NumericOp Op, NumericComplexMath Math, typename F>
+void applyScalar(F a, F b, F c, F d, F& x, F& y)
+{
+    if constexpr (Op == NumericOp::Sum) {
+        x = a + c;
+        y = b + d;
+    } else if constexpr (Op == NumericOp::Subtract) {
+        x = a - c;
+        y = b - d;
+    } else if constexpr (Math == NumericComplexMath::Strict) {
+        const std::complex<F> result = Op == NumericOp::Multiply ? std::complex<F>(a, b) * std::complex<F>(c, d)
+                                                                  : std::complex<F>(a, b) / std::complex<F>(c, d);
+        x = result.real();
+        y = result.imag();
+    } else if constexpr (Op == NumericOp::Multiply) {
+        x = a * c - b * d;
+        y = a * d + b * c;
+    } else {
+        const F inverse = F(1) / (c * c + d * d);
+        x = (a * c + b * d) * inverse;
+        y = (b * c - a * d) * inverse;
+    }
+}
+
+template <NumericOp Op, NumericComplexMath Math, typename F>
+void scalarArithmetic(const F* lhsRe, const F* lhsIm, const F* rhsRe, const F* rhsIm, bool broadcast, F* outRe, F* outIm,
+                      std::size_t begin, std::size_t count)
+{
+    for (std::size_t i = begin; i < count; ++i) {
+        const std::size_t j = broadcast ? 0 : i;
+        applyScalar<Op, Math>(lhsRe[i], lhsIm[i], rhsRe[j], rhsIm[j], outRe[i], outIm[i]);
+    }
+}
+
+template <NumericComplexMath Math, typename F>
+void scalarMultiplyAccumulate(const F* lhsRe, const F* lhsIm, const F* rhsRe, const F* rhsIm, bool broadcast, F* accRe, F* accIm,
+                              std::size_t begin, std::size_t count)
+{
+    for (std::size_t i = begin; i < count; ++i) {
+        const std::size_t j = broadcast ? 0 : i;
+        F x, y;
+        applyScalar<NumericOp::Multiply, Math>(lhsRe[i], lhsIm[i], rhsRe[j], rhsIm[j], x, y);
+        accRe[i] += x;
+        accIm[i] += y;
+    }
+}
+
+template <NumericComplexMath Math, typename F>
+void scalarMagnitude(const F* re, const F* im, F* out, std::size_t begin, std::size_t count)
+{
+    for (std::size_t i = begin; i < count; ++i) {
+        if constexpr (Math == NumericComplexMath::Strict) {
+            out[i] = std::abs(std::complex<F>(re[i], im[i]));
+        } else {
+            out[i] = std::sqrt(re[i] * re[i] + im[i] * im[i]);
+        }
+    }
+}
+
+// Redoes the lanes set in `lanes` (bit k = element first + k) with the scalar strict kernel
+template <NumericOp Op, typename F>
+void recoverLanes(const F* lhsRe, const F* lhsIm, const F* rhsRe, const F* rhsIm, bool broadcast, F* outRe, F* outIm,
+                  std::size_t first, unsigned lanes)
+{
+    for (; lanes != 0; lanes &= lanes - 1) {
+        const std::size_t i = first + static_cast<std::size_t>(std::countr_zero(lanes));
+        const std::size_t j = broadcast ? 0 : i;
+        applyScalar<Op, NumericComplexMath::Strict>(lhsRe[i], lhsIm[i], rhsRe[j], rhsIm[j], outRe[i - first], outIm[i - first]);
+    }
+}
+
+// Libgcc's thresholds for the scaled Smith division of __divdc3
+constexpr double smithBig = DBL_MAX / 2;
+constexpr double smithMin = DBL_MIN;
+constexpr double smithMin2 = DBL_EPSILON;
+constexpr double smithScale = 1 / DBL_EPSILON;
+constexpr double smithMax2 = smithBig * smithMin2;
+
+} // namespace
+
+
+#if NUMERIC_COMPLEX_X86
+
+/************************ AVX2 kernels ********************************/
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+namespace {
+namespace avx2 {
+
+inline __m256 load(const float* p) { return _mm256_loadu_ps(p); }
+inline __m256d load(const double* p) { return _mm256_loadu_pd(p); }
+inline __m256 splat(float v) { return _mm256_set1_ps(v); }
+inline __m256d splat(double v) { return _mm256_set1_pd(v); }
+inline void store(float* p, __m256 v) { _mm256_storeu_ps(p, v); }
+inline void store(double* p, __m256d v) { _mm256_storeu_pd(p, v); }
+
+inline __m256 add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+inline __m256d add(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+inline __m256 sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+inline __m256d sub(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+inline __m256 mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+inline __m256d mul(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
+inline __m256 div(__m256 a, __m256 b) { return _mm256_div_ps(a, b); }
+inline __m256d div(__m256d a, __m256d b) { return _mm256_div_pd(a, b); }
+inline __m256 sqrt(__m256 a) { return _mm256_sqrt_ps(a); }
+inline __m256d sqrt(__m256d a) { return _mm256_sqrt_pd(a); }
+// a * b + c and a * b - c, one rounding
+inline __m256 fmadd(__m256 a, __m256 b, __m256 c) { return _mm256_fmadd_ps(a, b, c); }
+inline __m256d fmadd(__m256d a, __m256d b, __m256d c) { return _mm256_fmadd_pd(a, b, c); }
+inline __m256 fmsub(__m256 a, __m256 b, __m256 c) { return _mm256_fmsub_ps(a, b, c); }
+inline __m256d fmsub(__m256d a, __m256d b, __m256d c) { return _mm256_fmsub_pd(a, b, c); }
+inline __m256 negate(__m256 a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+inline __m256d negate(__m256d a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+inline __m256d abs(__m256d a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+
+// Masks are all-ones lanes; the ordered predicates are false for NaN, like the C operators
+inline __m256 isNan(__m256 a) { return _mm256_cmp_ps(a, a, _CMP_UNORD_Q); }
+inline __m256d isNan(__m256d a) { return _mm256_cmp_pd(a, a, _CMP_UNORD_Q); }
+inline __m256d less(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+inline __m256d greater(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+inline __m256d greaterEqual(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+inline __m256 both(__m256 a, __m256 b) { return _mm256_and_ps(a, b); }
+inline __m256d both(__m256d a, __m256d b) { return _mm256_and_pd(a, b); }
+inline __m256d either(__m256d a, __m256d b) { return _mm256_or_pd(a, b); }
+inline __m256d select(__m256d mask, __m256d ifTrue, __m256d ifFalse) { return _mm256_blendv_pd(ifFalse, ifTrue, mask); }
+inline unsigned bits(__m256 mask) { return static_cast<unsigned>(_mm256_movemask_ps(mask)); }
+inline unsigned bits(__m256d mask) { return static_cast<unsigned>(_mm256_movemask_pd(mask)); }
+
+// float lanes 0-3 / 4-7 as doubles, and back
+inline __m256d widenLow(__m256 a) { return _mm256_cvtps_pd(_mm256_castps256_ps128(a)); }
+inline __m256d widenHigh(__m256 a) { return _mm256_cvtps_pd(_mm256_extractf128_ps(a, 1)); }
+inline __m256 narrow(__m256d low, __m256d high) { return _mm256_set_m128(_mm256_cvtpd_ps(high), _mm256_cvtpd_ps(low)); }
+
+} // namespace avx2
+} // namespace
+
+#pragma GCC pop_options
+
+
+/************************ AVX-512 kernels ********************************/
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+namespace {
+namespace avx512 {
+
+inline __m512 load(const float* p) { return _mm512_loadu_ps(p); }
+inline __m512d load(const double* p) { return _mm512_loadu_pd(p); }
+inline __m512 splat(float v) { return _mm512_set1_ps(v); }
+inline __m512d splat(double v) { return _mm512_set1_pd(v); }
+inline void store(float* p, __m512 v) { _mm512_storeu_ps(p, v); }
+inline void store(double* p, __m512d v) { _mm512_storeu_pd(p, v); }
+
+inline __m512 add(__m512 a, __m512 b) { return _mm512_add_ps(a, b); }
+inline __m512d add(__m512d a, __m512d b) { return _mm512_add_pd(a, b); }
+inline __m512 sub(__m512 a, __m512 b) { return _mm512_sub_ps(a, b); }
+inline __m512d sub(__m512d a, __m512d b) { return _mm512_sub_pd(a, b); }
+inline __m512 mul(__m512 a, __m512 b) { return _mm512_mul_ps(a, b); }
+inline __m512d mul(__m512d a, __m512d b) { return _mm512_mul_pd(a, b); }
+inline __m512 div(__m512 a, __m512 b) { return _mm512_div_ps(a, b); }
+inline __m512d div(__m512d a, __m512d b) { return _mm512_div_pd(a, b); }
+inline __m512 sqrt(__m512 a) { return _mm512_sqrt_ps(a); }
+inline __m512d sqrt(__m512d a) { return _mm512_sqrt_pd(a); }
+inline __m512 fmadd(__m512 a, __m512 b, __m512 c) { return _mm512_fmadd_ps(a, b, c); }
+inline __m512d fmadd(__m512d a, __m512d b, __m512d c) { return _mm512_fmadd_pd(a, b, c); }
+inline __m512 fmsub(__m512 a, __m512 b, __m512 c) { return _mm512_fmsub_ps(a, b, c); }
+inline __m512d fmsub(__m512d a, __m512d b, __m512d c) { return _mm512_fmsub_pd(a, b, c); }
+inline __m512 negate(__m512 a) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(INT32_MIN))); }
+inline __m512d negate(__m512d a) { return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(INT64_MIN))); }
+inline __m512d abs(__m512d a) { return _mm512_abs_pd(a); }
+
+inline __mmask16 isNan(__m512 a) { return _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q); }
+inline __mmask8 isNan(__m512d a) { return _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q); }
+inline __mmask8 less(__m512d a, __m512d b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+inline __mmask8 greater(__m512d a, __m512d b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+inline __mmask8 greaterEqual(__m512d a, __m512d b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+inline __mmask16 both(__mmask16 a, __mmask16 b) { return a & b; }
+inline __mmask8 both(__mmask8 a, __mmask8 b) { return a & b; }
+inline __mmask8 either(__mmask8 a, __mmask8 b) { return a | b; }
+inline __m512d select(__mmask8 mask, __m512d ifTrue, __m512d ifFalse) { return _mm512_mask_blend_pd(mask, ifFalse, ifTrue); }
+inline unsigned bits(__mmask16 mask) { return mask; }
+inline unsigned bits(__mmask8 mask) { return mask; }
+
+inline __m512d widenLow(__m512 a) { return _mm512_cvtps_pd(_mm512_castps512_ps256(a)); }
+inline __m512d widenHigh(__m512 a) { return _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a), 1))); }
+inline __m512 narrow(__m512d low, __m512d high)
+{
+    const __m512d packed = _mm512_insertf64x4(_mm512_castpd256_pd512(_mm256_castps_pd(_mm512_cvtpd_ps(low))),
+                                              _mm256_castps_pd(_mm512_cvtpd_ps(high)), 1);
+    return _mm512_castpd_ps(packed);
+}
+
+} // namespace avx512
+} // namespace
+
+#pragma GCC pop_options
+
+
+/************************ Vector algorithms ********************************/
+
+/**
+ * The same algorithms for both instruction sets, on top of the helpers above.
+ *  - Strict multiply: (ac - bd) + (ad + bc)i, exactly what the compiler emits inline.
+ *  - Strict double divide: libgcc's __divdc3 (Smith's method with power-of-two scaling
+ *    of tiny / huge operands and an alternate order for a subnormal ratio), with the
+ *    branches turned into per-lane selects.
+ *  - Strict float divide and magnitude: the textbook formulas in double precision, as
+ *    __divsc3 and hypotf compute them.
+ * Lanes that end up NaN + NaN i (an infinite or NaN operand) are redone by the scalar
+ * kernel, which applies the C99 Annex G recovery.
+ */
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+namespace {
+namespace avx2 {
+
+template <typename V>
+inline void multiplyExact(V a, V b, V c, V d, V& x, V& y)
+{
+    x = sub(mul(a, c), mul(b, d));
+    y = add(mul(a, d), mul(b, c));
+}
+
+template <typename V>
+inline void divideWide(V a, V b, V c, V d, V& x, V& y)
+{
+    const V denominator = add(mul(c, c), mul(d, d));
+    x = div(add(mul(a, c), mul(b, d)), denominator);
+    y = div(sub(mul(b, c), mul(a, d)), denominator);
+}
+
+template <typename V>
+inline void divideSmith(V a, V b, V c, V d, V& x, V& y)
+{
+    const auto first = less(abs(c), abs(d));  // libgcc's |c| < |d| branch: divide by d
+    const auto big = greaterEqual(abs(select(first, d, c)), splat(smithBig));
+    a = select(big, mul(a, splat(0.5)), a);
+    b = select(big, mul(b, splat(0.5)), b);
+    c = select(big, mul(c, splat(0.5)), c);
+    d = select(big, mul(d, splat(0.5)), d);
+    const V absA = abs(a), absB = abs(b), absP = abs(select(first, d, c));
+    const auto tinyA = both(less(absA, splat(smithMin)), less(absB, splat(smithMax2)));
+    const auto tinyB = both(less(absB, splat(smithMin)), less(absA, splat(smithMax2)));
+    const auto tiny = either(less(absP, splat(smithMin2)), both(less(absP, splat(smithMax2)), either(tinyA, tinyB)));
+    a = select(tiny, mul(a, splat(smithScale)), a);
+    b = select(tiny, mul(b, splat(smithScale)), b);
+    c = select(tiny, mul(c, splat(smithScale)), c);
+    d = select(tiny, mul(d, splat(smithScale)), d);
+
+    const V p = select(first, d, c), q = select(first, c, d);
+    const V u = select(first, a, b), v = select(first, b, a);
+    const V ratio = div(q, p);
+    const V denominator = add(mul(q, ratio), p);
+    const auto normal = greater(abs(ratio), splat(smithMin));
+    const V s = select(normal, mul(u, ratio), mul(q, div(u, p)));
+    const V t = select(normal, mul(v, ratio), mul(q, div(v, p)));
+    x = div(add(s, v), denominator);
+    y = div(select(first, sub(t, u), sub(u, t)), denominator);
+}
+
+template <NumericOp Op, NumericComplexMath Math, typename T, typename V>
+inline void compute(V a, V b, V c, V d, V& x, V& y)
+{
+    if constexpr (Op == NumericOp::Sum) {
+        x = add(a, c);
+        y = add(b, d);
+    } else if constexpr (Op == NumericOp::Subtract) {
+        x = sub(a, c);
+        y = sub(b, d);
+    } else if constexpr (Math == NumericComplexMath::Fast) {
+        if constexpr (Op == NumericOp::Multiply) {
+            x = fmsub(a, c, mul(b, d));
+            y = fmadd(a, d, mul(b, c));
+        } else {
+            const V inverse = div(splat(T(1)), fmadd(c, c, mul(d, d)));
+            x = mul(fmadd(a, c, mul(b, d)), inverse);
+            y = mul(fmsub(b, c, mul(a, d)), inverse);
+        }
+    } else if constexpr (Op == NumericOp::Multiply) {
+        multiplyExact(a, b, c, d, x, y);
+    } else if constexpr (std::is_same_v<T, double>) {
+        divideSmith(a, b, c, d, x, y);
+    } else {
+        decltype(widenLow(a)) lowX, lowY, highX, highY;
+        divideWide(widenLow(a), widenLow(b), widenLow(c), widenLow(d), lowX, lowY);
+        divideWide(widenHigh(a), widenHigh(b), widenHigh(c), widenHigh(d), highX, highY);
+        x = narrow(lowX, highX);
+        y = narrow(lowY, highY);
+    }
+}
+
+template <NumericOp Op, NumericComplexMath Math, typename T>
+std::size_t arithmetic(const T* lhsRe, const T* lhsIm, const T* rhsRe, const T* rhsIm, bool broadcast,
+                       T* outRe, T* outIm, std::size_t count)
+{
+    constexpr std::size_t width = sizeof(load(lhsRe)) / sizeof(T);
+    const auto scalarRe = splat(rhsRe[0]), scalarIm = splat(rhsIm[0]);
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        decltype(load(lhsRe)) x, y;
+        compute<Op, Math, T>(load(lhsRe + i), load(lhsIm + i), broadcast ? scalarRe : load(rhsRe + i),
+                             broadcast ? scalarIm : load(rhsIm + i), x, y);
+        store(outRe + i, x);
+        store(outIm + i, y);
+        if constexpr (Math == NumericComplexMath::Strict && (Op == NumericOp::Multiply || Op == NumericOp::Divide)) {
+            if (const unsigned lanes = bits(both(isNan(x), isNan(y)))) {
+                recoverLanes<Op>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe + i, outIm + i, i, lanes);
+            }
+        }
+    }
+    return i;
+}
+
+template <NumericComplexMath Math, typename T>
+std::size_t multiplyAccumulate(const T* lhsRe, const T* lhsIm, const T* rhsRe, const T* rhsIm, bool broadcast,
+                               T* accRe, T* accIm, std::size_t count)
+{
+    constexpr std::size_t width = sizeof(load(lhsRe)) / sizeof(T);
+    const auto scalarRe = splat(rhsRe[0]), scalarIm = splat(rhsIm[0]);
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        const auto a = load(lhsRe + i), b = load(lhsIm + i);
+        const auto c = broadcast ? scalarRe : load(rhsRe + i), d = broadcast ? scalarIm : load(rhsIm + i);
+        if constexpr (Math == NumericComplexMath::Fast) {
+            store(accRe + i, fmadd(negate(b), d, fmadd(a, c, load(accRe + i))));
+            store(accIm + i, fmadd(b, c, fmadd(a, d, load(accIm + i))));
+        } else {
+            decltype(load(lhsRe)) x, y;
+            multiplyExact(a, b, c, d, x, y);
+            if (const unsigned lanes = bits(both(isNan(x), isNan(y)))) {
+                alignas(64) T productRe[width], productIm[width];
+                store(productRe, x);
+                store(productIm, y);
+                recoverLanes<NumericOp::Multiply>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, productRe, productIm, i, lanes);
+                x = load(productRe);
+                y = load(productIm);
+            }
+            store(accRe + i, add(load(accRe + i), x));
+            store(accIm + i, add(load(accIm + i), y));
+        }
+    }
+    return i;
+}
+
+template <typename T>
+std::size_t negate(const T* values, T* out, std::size_t count)
+{
+    constexpr std::size_t width = sizeof(load(values)) / sizeof(T);
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        store(out + i, negate(load(values + i)));
+    }
+    return i;
+}
+
+template <NumericComplexMath Math, typename T>
+std::size_t magnitude(const T* re, const T* im, T* out, std::size_t count)
+{
+    constexpr std::size_t width = sizeof(load(re)) / sizeof(T);
+    if constexpr (Math == NumericComplexMath::Strict && std::is_same_v<T, double>) {
+        return 0;   // no vector hypot that rounds like glibc's
+    } else {
+        std::size_t i = 0;
+        for (; i + width <= count; i += width) {
+            const auto a = load(re + i), b = load(im + i);
+            if constexpr (Math == NumericComplexMath::Fast) {
+                store(out + i, sqrt(fmadd(a, a, mul(b, b))));
+            } else {
+                const auto low = sqrt(add(mul(widenLow(a), widenLow(a)), mul(widenLow(b), widenLow(b))));
+                const auto high = sqrt(add(mul(widenHigh(a), widenHigh(a)), mul(widenHigh(b), widenHigh(b))));
+                const auto result = narrow(low, high);
+                store(out + i, result);
+                for (unsigned lanes = bits(isNan(result)); lanes != 0; lanes &= lanes - 1) {
+                    const std::size_t j = i + static_cast<std::size_t>(std::countr_zero(lanes));
+                    out[j] = std::abs(std::complex<T>(re[j], im[j]));   // hypot(inf, NaN) is inf
+                }
+            }
+        }
+        return i;
+    }
+}
+
+} // namespace avx2
+} // namespace
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+namespace {
+namespace avx512 {
+
+template <typename V>
+inline void multiplyExact(V a, V b, V c, V d, V& x, V& y)
+{
+    x = sub(mul(a, c), mul(b, d));
+    y = add(mul(a, d), mul(b, c));
+}
+
+template <typename V>
+inline void divideWide(V a, V b, V c, V d, V& x, V& y)
+{
+    const V denominator = add(mul(c, c), mul(d, d));
+    x = div(add(mul(a, c), mul(b, d)), denominator);
+    y = div(sub(mul(b, c), mul(a, d)), denominator);
+}
+
+template <typename V>
+inline void divideSmith(V a, V b, V c, V d, V& x, V& y)
+{
+    const auto first = less(abs(c), abs(d));  // libgcc's |c| < |d| branch: divide by d
+    const auto big = greaterEqual(abs(select(first, d, c)), splat(smithBig));
+    a = select(big, mul(a, splat(0.5)), a);
+    b = select(big, mul(b, splat(0.5)), b);
+    c = select(big, mul(c, splat(0.5)), c);
+    d = select(big, mul(d, splat(0.5)), d);
+    const V absA = abs(a), absB = abs(b), absP = abs(select(first, d, c));
+    const auto tinyA = both(less(absA, splat(smithMin)), less(absB, splat(smithMax2)));
+    const auto tinyB = both(less(absB, splat(smithMin)), less(absA, splat(smithMax2)));
+    const auto tiny = either(less(absP, splat(smithMin2)), both(less(absP, splat(smithMax2)), either(tinyA, tinyB)));
+    a = select(tiny, mul(a, splat(smithScale)), a);
+    b = select(tiny, mul(b, splat(smithScale)), b);
+    c = select(tiny, mul(c, splat(smithScale)), c);
+    d = select(tiny, mul(d, splat(smithScale)), d);
+
+    const V p = select(first, d, c), q = select(first, c, d);
+    const V u = select(first, a, b), v = select(first, b, a);
+    const V ratio = div(q, p);
+    const V denominator = add(mul(q, ratio), p);
+    const auto normal = greater(abs(ratio), splat(smithMin));
+    const V s = select(normal, mul(u, ratio), mul(q, div(u, p)));
+    const V t = select(normal, mul(v, ratio), mul(q, div(v, p)));
+    x = div(add(s, v), denominator);
+    y = div(select(first, sub(t, u), sub(u, t)), denominator);
+}
+
+template <NumericOp Op, NumericComplexMath Math, typename T, typename V>
+inline void compute(V a, V b, V c, V d, V& x, V& y)
+{
+    if constexpr (Op == NumericOp::Sum) {
+        x = add(a, c);
+        y = add(b, d);
+    } else if constexpr (Op == NumericOp::Subtract) {
+        x = sub(a, c);
+        y = sub(b, d);
+    } else if constexpr (Math == NumericComplexMath::Fast) {
+        if constexpr (Op == NumericOp::Multiply) {
+            x = fmsub(a, c, mul(b, d));
+            y = fmadd(a, d, mul(b, c));
+        } else {
+            const V inverse = div(splat(T(1)), fmadd(c, c, mul(d, d)));
+            x = mul(fmadd(a, c, mul(b, d)), inverse);
+            y = mul(fmsub(b, c, mul(a, d)), inverse);
+        }
+    } else if constexpr (Op == NumericOp::Multiply) {
+        multiplyExact(a, b, c, d, x, y);
+    } else if constexpr (std::is_same_v<T, double>) {
+        divideSmith(a, b, c, d, x, y);
+    } else {
+        decltype(widenLow(a)) lowX, lowY, highX, highY;
+        divideWide(widenLow(a), widenLow(b), widenLow(c), widenLow(d), lowX, lowY);
+        divideWide(widenHigh(a), widenHigh(b), widenHigh(c), widenHigh(d), highX, highY);
+        x = narrow(lowX, highX);
+        y = narrow(lowY, highY);
+    }
+}
+
+template <NumericOp Op, NumericComplexMath Math, typename T>
+std::size_t arithmetic(const T* lhsRe, const T* lhsIm, const T* rhsRe, const T* rhsIm, bool broadcast,
+                       T* outRe, T* outIm, std::size_t count)
+{
+    constexpr std::size_t width = sizeof(load(lhsRe)) / sizeof(T);
+    const auto scalarRe = splat(rhsRe[0]), scalarIm = splat(rhsIm[0]);
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        decltype(load(lhsRe)) x, y;
+        compute<Op, Math, T>(load(lhsRe + i), load(lhsIm + i), broadcast ? scalarRe : load(rhsRe + i),
+                             broadcast ? scalarIm : load(rhsIm + i), x, y);
+        store(outRe + i, x);
+        store(outIm + i, y);
+        if constexpr (Math == NumericComplexMath::Strict && (Op == NumericOp::Multiply || Op == NumericOp::Divide)) {
+            if (const unsigned lanes = bits(both(isNan(x), isNan(y)))) {
+                recoverLanes<Op>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe + i, outIm + i, i, lanes);
+            }
+        }
+    }
+    return i;
+}
+
+template <NumericComplexMath Math, typename T>
+std::size_t multiplyAccumulate(const T* lhsRe, const T* lhsIm, const T* rhsRe, const T* rhsIm, bool broadcast,
+                               T* accRe, T* accIm, std::size_t count)
+{
+    constexpr std::size_t width = sizeof(load(lhsRe)) / sizeof(T);
+    const auto scalarRe = splat(rhsRe[0]), scalarIm = splat(rhsIm[0]);
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        const auto a = load(lhsRe + i), b = load(lhsIm + i);
+        const auto c = broadcast ? scalarRe : load(rhsRe + i), d = broadcast ? scalarIm : load(rhsIm + i);
+        if constexpr (Math == NumericComplexMath::Fast) {
+            store(accRe + i, fmadd(negate(b), d, fmadd(a, c, load(accRe + i))));
+            store(accIm + i, fmadd(b, c, fmadd(a, d, load(accIm + i))));
+        } else {
+            decltype(load(lhsRe)) x, y;
+            multiplyExact(a, b, c, d, x, y);
+            if (const unsigned lanes = bits(both(isNan(x), isNan(y)))) {
+                alignas(64) T productRe[width], productIm[width];
+                store(productRe, x);
+                store(productIm, y);
+                recoverLanes<NumericOp::Multiply>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, productRe, productIm, i, lanes);
+                x = load(productRe);
+                y = load(productIm);
+            }
+            store(accRe + i, add(load(accRe + i), x));
+            store(accIm + i, add(load(accIm + i), y));
+        }
+    }
+    return i;
+}
+
+template <typename T>
+std::size_t negate(const T* values, T* out, std::size_t count)
+{
+    constexpr std::size_t width = sizeof(load(values)) / sizeof(T);
+    std::size_t i = 0;
+    for (; i + width <= count; i += width) {
+        store(out + i, negate(load(values + i)));
+    }
+    return i;
+}
+
+template <NumericComplexMath Math, typename T>
+std::size_t magnitude(const T* re, const T* im, T* out, std::size_t count)
+{
+    constexpr std::size_t width = sizeof(load(re)) / sizeof(T);
+    if constexpr (Math == NumericComplexMath::Strict && std::is_same_v<T, double>) {
+        return 0;   // no vector hypot that rounds like glibc's
+    } else {
+        std::size_t i = 0;
+        for (; i + width <= count; i += width) {
+            const auto a = load(re + i), b = load(im + i);
+            if constexpr (Math == NumericComplexMath::Fast) {
+                store(out + i, sqrt(fmadd(a, a, mul(b, b))));
+            } else {
+                const auto low = sqrt(add(mul(widenLow(a), widenLow(a)), mul(widenLow(b), widenLow(b))));
+                const auto high = sqrt(add(mul(widenHigh(a), widenHigh(a)), mul(widenHigh(b), widenHigh(b))));
+                const auto result = narrow(low, high);
+                store(out + i, result);
+                for (unsigned lanes = bits(isNan(result)); lanes != 0; lanes &= lanes - 1) {
+                    const std::size_t j = i + static_cast<std::size_t>(std::countr_zero(lanes));
+                    out[j] = std::abs(std::complex<T>(re[j], im[j]));   // hypot(inf, NaN) is inf
+                }
+            }
+        }
+        return i;
+    }
+}
+
+} // namespace avx512
+} // namespace
+
+#pragma GCC pop_options
+
+#endif // NUMERIC_COMPLEX_X86
+
+
+/************************ Dispatch ********************************/
+
+namespace {
+
+enum class ComplexPath : std::uint8_t
+{
+    Scalar,
+    Avx2,
+    Avx512
+};
+
+// The AVX2 kernels also need FMA, which a few AVX2 processors lack
+ComplexPath complexPath()
+{
+#if NUMERIC_COMPLEX_X86
+    static const bool fma = __builtin_cpu_supports("fma");
+    switch (numericSimdLevel()) {
+        case NumericSimdLevel::Avx512: return ComplexPath::Avx512;
+        case NumericSimdLevel::Avx2:   return fma ? ComplexPath::Avx2 : ComplexPath::Scalar;
+        default: break;
+    }
+#endif
+    return ComplexPath::Scalar;
+}
+
+template <typename F>
+bool hasZeroDivisor(const F* re, const F* im, std::size_t count)
+{
+    bool zero = false;
+    for (std::size_t i = 0; i < count; ++i) {
+        zero |= (re[i] == 0) & (im[i] == 0);
+    }
+    return zero;
+}
+
+template <NumericOp Op, NumericComplexMath Math, typename F>
+NumericError arithmeticFor(const F* lhsRe, const F* lhsIm, const F* rhsRe, const F* rhsIm, bool broadcast, F* outRe, F* outIm,
+                           std::size_t count)
+{
+    if (count == 0) {
+        return NumericError::None;
+    }
+    if constexpr (Op == NumericOp::Divide) {
+        if (hasZeroDivisor(rhsRe, rhsIm, broadcast ? 1 : count)) {
+            return NumericError::DivisionByZero;
+        }
+    }
+
+    std::size_t done = 0;
+#if NUMERIC_COMPLEX_X86
+    switch (complexPath()) {
+        case ComplexPath::Avx512: done = avx512::arithmetic<Op, Math>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe, outIm, count); break;
+        case ComplexPath::Avx2:   done = avx2::arithmetic<Op, Math>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe, outIm, count); break;
+        default: break;
+    }
+#endif
+    scalarArithmetic<Op, Math>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe, outIm, done, count);
+    return NumericError::None;
+}
+
+template <NumericComplexMath Math, typename F>
+void multiplyAccumulateFor(const F* lhsRe, const F* lhsIm, const F* rhsRe, const F* rhsIm, bool broadcast, F* accRe, F* accIm,
+                           std::size_t count)
+{
+    std::size_t done = 0;
+#if NUMERIC_COMPLEX_X86
+    switch (complexPath()) {
+        case ComplexPath::Avx512: done = avx512::multiplyAccumulate<Math>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, accRe, accIm, count); break;
+        case ComplexPath::Avx2:   done = avx2::multiplyAccumulate<Math>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, accRe, accIm, count); break;
+        default: break;
+    }
+#endif
+    scalarMultiplyAccumulate<Math>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, accRe, accIm, done, count);
+}
+
+template <NumericComplexMath Math, typename F>
+void magnitudeFor(const F* re, const F* im, F* out, std::size_t count)
+{
+    std::size_t done = 0;
+#if NUMERIC_COMPLEX_X86
+    switch (complexPath()) {
+        case ComplexPath::Avx512: done = avx512::magnitude<Math>(re, im, out, count); break;
+        case ComplexPath::Avx2:   done = avx2::magnitude<Math>(re, im, out, count); break;
+        default: break;
+    }
+#endif
+    scalarMagnitude<Math>(re, im, out, done, count);
+}
+
+} // namespace
+
+
+template <typename F>
+NumericError complexColumnArithmetic(NumericOp op, NumericComplexMath math, const F* lhsRe, const F* lhsIm,
+                                     const F* rhsRe, const F* rhsIm, bool broadcast, F* outRe, F* outIm, std::size_t count)
+{
+    constexpr auto Strict = NumericComplexMath::Strict;
+    constexpr auto Fast = NumericComplexMath::Fast;
+    const bool fast = math == Fast;
+    switch (op) {
+        case NumericOp::Sum:
+            return arithmeticFor<NumericOp::Sum, Strict>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe, outIm, count);
+        case NumericOp::Subtract:
+            return arithmeticFor<NumericOp::Subtract, Strict>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe, outIm, count);
+        case NumericOp::Multiply:
+            return fast ? arithmeticFor<NumericOp::Multiply, Fast>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe, outIm, count)
+                        : arithmeticFor<NumericOp::Multiply, Strict>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe, outIm, count);
+        case NumericOp::Divide:
+            return fast ? arithmeticFor<NumericOp::Divide, Fast>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe, outIm, count)
+                        : arithmeticFor<NumericOp::Divide, Strict>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, outRe, outIm, count);
+        default:
+            throw std::invalid_argument("complexColumnArithmetic: not an arithmetic operation.");
+    }
+}
+
+template <typename F>
+void complexColumnMultiplyAccumulate(NumericComplexMath math, const F* lhsRe, const F* lhsIm, const F* rhsRe, const F* rhsIm,
+                                     bool broadcast, F* accRe, F* accIm, std::size_t count)
+{
+    if (math == NumericComplexMath::Fast) {
+        multiplyAccumulateFor<NumericComplexMath::Fast>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, accRe, accIm, count);
+    } else {
+        multiplyAccumulateFor<NumericComplexMath::Strict>(lhsRe, lhsIm, rhsRe, rhsIm, broadcast, accRe, accIm, count);
+    }
+}
+
+template <typename F>
+void complexColumnNegate(const F* values, F* out, std::size_t count)
+{
+    std::size_t done = 0;
+#if NUMERIC_COMPLEX_X86
+    switch (complexPath()) {
+        case ComplexPath::Avx512: done = avx512::negate(values, out, count); break;
+        case ComplexPath::Avx2:   done = avx2::negate(values, out, count); break;
+        default: break;
+    }
+#endif
+    for (std::size_t i = done; i < count; ++i) {
+        out[i] = -values[i];
+    }
+}
+
+template <typename F>
+void complexColumnMagnitude(NumericComplexMath math, const F* re, const F* im, F* out, std::size_t count)
+{
+    if (math == NumericComplexMath::Fast) {
+        magnitudeFor<NumericComplexMath::Fast>(re, im, out, count);
+    } else {
+        magnitudeFor<NumericComplexMath::Strict>(re, im, out, count);
+    }
+}
+
+#define NUMERIC_COMPLEX_INSTANTIATE(F) \
+    template NumericError complexColumnArithmetic<F>(NumericOp, NumericComplexMath, const F*, const F*, const F*, const F*, bool, F*, F*, std::size_t); \
+    template void complexColumnMultiplyAccumulate<F>(NumericComplexMath, const F*, const F*, const F*, const F*, bool, F*, F*, std::size_t); \
+    template void complexColumnNegate<F>(const F*, F*, std::size_t); \
+    template void complexColumnMagnitude<F>(NumericComplexMath, const F*, const F*, F*, std::size_t);
+
+NUMERIC_COMPLEX_INSTANTIATE(float)
+NUMERIC_COMPLEX_INSTANTIATE(double)
+
+#undef NUMERIC_COMPLEX_INSTANTIATE
@@ -0,0 +1,909 @@
+#include "NumericCompress.hpp"
+#include "NumericHash.hpp"
+#include "NumericReduce.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NUMERIC_COMPRESS_X86 1
+#include <immintrin.h>
+#else
+#define NUMERIC_COMPRESS_X86 0
+#endif
+
+
+const char* numericEncodingName(NumericEncoding encoding)
+{
+    switch (encoding) {
+        case NumericEncoding::Plain:            return "plain";
+        case NumericEncoding::Dictionary:       return "dictionary";
+        case NumericEncoding::RunLength:        return "run-length";
+        case NumericEncoding::Delta:            return "delta";
+        case NumericEncoding::FrameOfReference: return "frame-of-reference";
+        case NumericEncoding::Xor:              return "xor";
+        case NumericEncoding::Automatic:        return "automatic";
+        default:
+            throw std::runtime_error("numericEncodingName: Unsupported encoding.");
+    }
+}
+
+
+/************************ Keys and bit fields ********************************/
+
+namespace {
+
+constexpr std::uint64_t signBit = std::uint64_t(1) << 63;
+
+template <typename T>
+using FloatBits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+/**
+ * 64-bit key of a value. For integers and characters the keys are in the order the
+ * column comparisons use (signed values have their sign bit flipped), so a smallest key
+ * and offsets from it keep that order; for float and double the key is the bit pattern.
+ */
+template <typename T>
+std::uint64_t keyOf(T value)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        return std::bit_cast<FloatBits<T>>(value);
+    } else if constexpr (std::is_signed_v<T>) {
+        return static_cast<std::uint64_t>(static_cast<std::int64_t>(value)) ^ signBit;
+    } else {
+        return static_cast<std::uint64_t>(value);
+    }
+}
+
+template <typename T>
+T valueOfKey(std::uint64_t key)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        return std::bit_cast<T>(static_cast<FloatBits<T>>(key));
+    } else if constexpr (std::is_signed_v<T>) {
+        return static_cast<T>(static_cast<std::int64_t>(key ^ signBit));
+    } else {
+        return static_cast<T>(key);
+    }
+}
+
+// The value of a key as an integer, for exact sums
+template <typename T>
+NumericInt128 ordinalOfKey(std::uint64_t key)
+{
+    if constexpr (std::is_signed_v<T>) {
+        return static_cast<std::int64_t>(key ^ signBit);
+    } else {
+        return key;
+    }
+}
+
+std::uint64_t lowBits(unsigned width)
+{
+    return width >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+}
+
+// Appends fields of up to 64 bits, lowest bit first, keeping a zero word after the last one
+class BitWriter
+{
+    public:
+    explicit BitWriter(std::vector<std::uint64_t>& target) : words(target) {}
+
+    std::uint64_t position() const { return bits; }
+
+    void put(std::uint64_t value, unsigned width)
+    {
+        if (width == 0) {
+            return;
+        }
+        value &= lowBits(width);
+        const std::size_t word = bits / 64;
+        const unsigned shift = bits % 64;
+        if (words.size() < word + 2) {
+            words.resize(word + 2, 0);
+        }
+        words[word] |= value << shift;
+        if (shift != 0 && shift + width > 64) {
+            words[word + 1] |= value >> (64 - shift);
+        }
+        bits += width;
+    }
+
+    void finish()
+    {
+        words.resize((bits + 63) / 64 + 1, 0);
+    }
+
+    private:
+    std::vector<std::uint64_t>& words;
+    std::uint64_t bits = 0;
+};
+
+std::uint64_t readBits(const std::uint64_t* words, std::uint64_t position, unsigned width)
+{
+    if (width == 0) {
+        return 0;
+    }
+    const std::size_t word = position / 64;
+    const unsigned shift = position % 64;
+    std::uint64_t value = words[word] >> shift;
+    if (shift != 0 && shift + width > 64) {
+        value |= words[word + 1] << (64 - shift);
+    }
+    return value & lowBits(width);
+}
+
+// Reads consecutive fields, as BitWriter wrote them
+class BitReader
+{
+    public:
+    BitReader(const std::uint64_t* words, std::uint64_t position) : words(words), bits(position) {}
+
+    std::uint64_t get(unsigned width)
+    {
+        const std::uint64_t value = readBits(words, bits, width);
+        bits += width;
+        return value;
+    }
+
+    private:
+    const std::uint64_t* words;
+    std::uint64_t bits;
+};
+
+} // namespace
+
+
+#if NUMERIC_COMPRESS_X86
+
+/**
+ * Unpacking gathers the eight bytes holding each field (a field of up to 56 bits starts
+ * at most 7 bits into its first byte, so it fits), shifts each lane right by the bit
+ * offset within that byte and masks it. The zero word after the packed data keeps the
+ * last gathers in bounds.
+ */
+
+/************************ AVX2 kernels ********************************/
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace avx2 {
+
+std::size_t unpack(const std::uint64_t* words, std::uint64_t position, unsigned width, std::size_t count, std::uint64_t* out)
+{
+    const long long* bytes = reinterpret_cast<const long long*>(words);
+    const long long step = width;
+    const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(lowBits(width)));
+    const __m256i seven = _mm256_set1_epi64x(7);
+    const __m256i advance = _mm256_set1_epi64x(4 * step);
+    __m256i at = _mm256_add_epi64(_mm256_set1_epi64x(static_cast<long long>(position)),
+                                  _mm256_set_epi64x(3 * step, 2 * step, step, 0));
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256i field = _mm256_i64gather_epi64(bytes, _mm256_srli_epi64(at, 3), 1);
+        const __m256i value = _mm256_and_si256(_mm256_srlv_epi64(field, _mm256_and_si256(at, seven)), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), value);
+        at = _mm256_add_epi64(at, advance);
+    }
+    return i;
+}
+
+} // namespace avx2
+
+#pragma GCC pop_options
+
+
+/************************ AVX-512 kernels ********************************/
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+namespace avx512 {
+
+std::size_t unpack(const std::uint64_t* words, std::uint64_t position, unsigned width, std::size_t count, std::uint64_t* out)
+{
+    const long long step = width;
+    const __m512i mask = _mm512_set1_epi64(static_cast<long long>(lowBits(width)));
+    const __m512i seven = _mm512_set1_epi64(7);
+    const __m512i advance = _mm512_set1_epi64(8 * step);
+    __m512i at = _mm512_add_epi64(_mm512_set1_epi64(static_cast<long long>(position)),
+                                  _mm512_set_epi64(7 * step, 6 * step, 5 * step, 4 * step, 3 * step, 2 * step, step, 0));
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512i field = _mm512_i64gather_epi64(_mm512_srli_epi64(at, 3), words, 1);
+        const __m512i value = _mm512_and_si512(_mm512_srlv_epi64(field, _mm512_and_si512(at, seven)), mask);
+        _mm512_storeu_si512(out + i, value);
+        at = _mm512_add_epi64(at, advance);
+    }
+    return i;
+}
+
+} // namespace avx512
+
+#pragma GCC pop_options
+
+#endif // NUMERIC_COMPRESS_X86
+
+
+/************************ Helpers ********************************/
+
+namespace {
+
+// out[i] = the width-bit field at position + i * width
+void unpack(const std::uint64_t* words, std::uint64_t position, unsigned width, std::size_t count, std::uint64_t* out)
+{
+    if (width == 0) {
+        std::fill(out, out + count, 0);
+        return;
+    }
+    std::size_t done = 0;
+#if NUMERIC_COMPRESS_X86
+    if (width <= 56) {
+        switch (numericSimdLevel()) {
+            case NumericSimdLevel::Avx512: done = avx512::unpack(words, position, width, count, out); break;
+            case NumericSimdLevel::Avx2:   done = avx2::unpack(words, position, width, count, out); break;
+            default: break;
+        }
+    }
+#endif
+    for (std::size_t i = done; i < count; ++i) {
+        out[i] = readBits(words, position + i * width, width);
+    }
+}
+
+// ORs pass(i) into bit i for i < rows; `words` starts at a row that is a multiple of 64
+template <typename Pass>
+void maskRows(std::uint64_t* words, std::size_t rows, const Pass& pass)
+{
+    for (std::size_t first = 0; first < rows; first += 64) {
+        const std::size_t last = std::min(rows, first + 64);
+        std::uint64_t word = 0;
+        for (std::size_t i = first; i < last; ++i) {
+            word |= static_cast<std::uint64_t>(pass(i)) << (i - first);
+        }
+        words[first / 64] |= word;
+    }
+}
+
+// Sets bits [first, last)
+void setRows(std::uint64_t* words, std::size_t first, std::size_t last)
+{
+    while (first < last) {
+        const std::size_t word = first / 64;
+        const unsigned shift = first % 64;
+        const std::size_t span = std::min<std::size_t>(64 - shift, last - first);
+        words[word] |= lowBits(static_cast<unsigned>(span)) << shift;
+        first += span;
+    }
+}
+
+// Exact total of integer values
+template <typename T>
+NumericInt128 exactTotal(const T* values, std::size_t count)
+{
+    if constexpr (sizeof(T) < 8) {
+        long long total = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            total += static_cast<long long>(values[i]);
+        }
+        return total;
+    } else {
+        NumericInt128 total = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            total += values[i];
+        }
+        return total;
+    }
+}
+
+void throwIfFailed(NumericOp op, NumericError error)
+{
+    if (error != NumericError::None) {
+        throw std::runtime_error(numericErrorMessage(op, error));
+    }
+}
+
+} // namespace
+
+
+/************************ Encoding ********************************/
+
+template <NumericCompressible T>
+NumericCompressedColumn<T>::NumericCompressedColumn(const NumericColumn<T>& column, NumericEncoding encoding)
+{
+    if (encoding != NumericEncoding::Automatic) {
+        if (!supports(encoding)) {
+            throw std::runtime_error(std::string("NumericCompressedColumn: The ") + numericEncodingName(encoding) +
+                                     " encoding does not support this type.");
+        }
+        encode(column, encoding);
+        return;
+    }
+
+    encode(column, NumericEncoding::Plain);
+    for (NumericEncoding candidate : {NumericEncoding::Dictionary, NumericEncoding::RunLength, NumericEncoding::Delta,
+                                      NumericEncoding::FrameOfReference, NumericEncoding::Xor}) {
+        if (supports(candidate)) {
+            NumericCompressedColumn encoded;
+            encoded.encode(column, candidate);
+            if (encoded.compressedBytes() < compressedBytes()) {
+                *this = std::move(encoded);
+            }
+        }
+    }
+}
+
+template <NumericCompressible T>
+void NumericCompressedColumn<T>::encode(const NumericColumn<T>& column, NumericEncoding encoding)
+{
+    kind = encoding;
+    count = column.size();
+    const T* data = column.data();
+    BitWriter writer(packed);
+
+    switch (encoding) {
+        case NumericEncoding::Plain:
+            values.assign(data, data + count);
+            return;
+
+        case NumericEncoding::RunLength:
+            for (std::size_t i = 0; i < count; ++i) {
+                if (i == 0 || keyOf(data[i]) != keyOf(values.back())) {
+                    if (i != 0) {
+                        runEnds.push_back(i);
+                    }
+                    values.push_back(data[i]);
+                }
+            }
+            if (count != 0) {
+                runEnds.push_back(count);
+            }
+            return;
+
+        case NumericEncoding::Dictionary: {
+            // Codes in order of first appearance, then renumbered by key
+            NumericHashMap<std::uint64_t, std::size_t> firstCodes;
+            std::vector<std::uint64_t> keys;
+            std::vector<std::size_t> codes(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const std::uint64_t key = keyOf(data[i]);
+                const auto [code, added] = firstCodes.insert(key);
+                if (added) {
+                    *code = keys.size();
+                    keys.push_back(key);
+                }
+                codes[i] = *code;
+            }
+            std::vector<std::size_t> order(keys.size());
+            std::iota(order.begin(), order.end(), std::size_t(0));
+            std::sort(order.begin(), order.end(), [&](std::size_t first, std::size_t second) { return keys[first] < keys[second]; });
+            std::vector<std::size_t> ranks(keys.size());
+            values.resize(keys.size());
+            for (std::size_t rank = 0; rank < order.size(); ++rank) {
+                ranks[order[rank]] = rank;
+                values[rank] = valueOfKey<T>(keys[order[rank]]);
+            }
+            codeBits = keys.size() > 1 ? static_cast<std::uint8_t>(std::bit_width(keys.size() - 1)) : 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                writer.put(ranks[codes[i]], codeBits);
+            }
+            writer.finish();
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    for (std::size_t first = 0; first < count; first += blockSize) {
+        const std::size_t rows = std::min(blockSize, count - first);
+        const T* block = data + first;
+        Block header;
+        header.bitOffset = writer.position();
+
+        if (encoding == NumericEncoding::FrameOfReference) {
+            std::uint64_t low = keyOf(block[0]);
+            std::uint64_t high = low;
+            for (std::size_t i = 1; i < rows; ++i) {
+                low = std::min(low, keyOf(block[i]));
+                high = std::max(high, keyOf(block[i]));
+            }
+            header.reference = low;
+            header.high = high;
+            header.bits = static_cast<std::uint8_t>(std::bit_width(high - low));
+            for (std::size_t i = 0; i < rows; ++i) {
+                writer.put(keyOf(block[i]) - low, header.bits);
+            }
+        } else if (encoding == NumericEncoding::Delta) {
+            // Steps wrap modulo 2^64; step - smallest step is exact in 64 unsigned bits
+            std::int64_t smallest = 0;
+            std::int64_t largest = 0;
+            for (std::size_t i = 1; i < rows; ++i) {
+                const std::int64_t step = static_cast<std::int64_t>(keyOf(block[i]) - keyOf(block[i - 1]));
+                smallest = i == 1 ? step : std::min(smallest, step);
+                largest = i == 1 ? step : std::max(largest, step);
+            }
+            header.reference = static_cast<std::uint64_t>(smallest);
+            header.high = keyOf(block[0]);
+            header.bits = static_cast<std::uint8_t>(std::bit_width(static_cast<std::uint64_t>(largest) - header.reference));
+            for (std::size_t i = 1; i < rows; ++i) {
+                writer.put(keyOf(block[i]) - keyOf(block[i - 1]) - header.reference, header.bits);
+            }
+        } else {
+            // Gorilla XOR: 0 = same value; 10 = the previous window of meaningful bits;
+            // 11 = 6 bits of leading zeros, 6 bits of length - 1, then the meaningful bits
+            constexpr unsigned width = sizeof(T) * 8;
+            header.reference = keyOf(block[0]);
+            std::uint64_t previous = header.reference;
+            unsigned leading = 0;
+            unsigned trailing = 0;
+            bool window = false;
+            for (std::size_t i = 1; i < rows; ++i) {
+                const std::uint64_t key = keyOf(block[i]);
+                const std::uint64_t change = key ^ previous;
+                previous = key;
+                if (change == 0) {
+                    writer.put(0, 1);
+                    continue;
+                }
+                writer.put(1, 1);
+                const unsigned lead = static_cast<unsigned>(std::countl_zero(change)) - (64 - width);
+                const unsigned trail = static_cast<unsigned>(std::countr_zero(change));
+                if (window && lead >= leading && trail >= trailing) {
+                    writer.put(0, 1);
+                    writer.put(change >> trailing, width - leading - trailing);
+                } else {
+                    const unsigned length = width - lead - trail;
+                    writer.put(1, 1);
+                    writer.put(lead, 6);
+                    writer.put(length - 1, 6);
+                    writer.put(change >> trail, length);
+                    leading = lead;
+                    trailing = trail;
+                    window = true;
+                }
+            }
+        }
+        blocks.push_back(header);
+    }
+    writer.finish();
+}
+
+
+/************************ Decoding ********************************/
+
+template <NumericCompressible T>
+std::size_t NumericCompressedColumn<T>::compressedBytes() const
+{
+    return values.size() * sizeof(T) + runEnds.size() * sizeof(std::uint64_t) + packed.size() * sizeof(std::uint64_t) +
+           blocks.size() * sizeof(Block);
+}
+
+template <NumericCompressible T>
+double NumericCompressedColumn<T>::ratio() const
+{
+    const std::size_t bytes = compressedBytes();
+    return bytes == 0 ? 1.0 : static_cast<double>(count * sizeof(T)) / static_cast<double>(bytes);
+}
+
+template <NumericCompressible T>
+void NumericCompressedColumn<T>::decodeBlock(std::size_t block, T* out) const
+{
+    const Block& header = blocks[block];
+    const std::size_t rows = std::min(blockSize, count - block * blockSize);
+
+    if (kind == NumericEncoding::FrameOfReference) {
+        std::array<std::uint64_t, blockSize> offsets;
+        unpack(packed.data(), header.bitOffset, header.bits, rows, offsets.data());
+        for (std::size_t i = 0; i < rows; ++i) {
+            out[i] = valueOfKey<T>(header.reference + offsets[i]);
+        }
+    } else if (kind == NumericEncoding::Delta) {
+        std::array<std::uint64_t, blockSize> steps;
+        unpack(packed.data(), header.bitOffset, header.bits, rows - 1, steps.data());
+        std::uint64_t key = header.high;
+        out[0] = valueOfKey<T>(key);
+        for (std::size_t i = 1; i < rows; ++i) {
+            key += header.reference + steps[i - 1];
+            out[i] = valueOfKey<T>(key);
+        }
+    } else {
+        constexpr unsigned width = sizeof(T) * 8;
+        BitReader reader(packed.data(), header.bitOffset);
+        std::uint64_t key = header.reference;
+        unsigned trailing = 0;
+        unsigned length = 0;
+        out[0] = valueOfKey<T>(key);
+        for (std::size_t i = 1; i < rows; ++i) {
+            if (reader.get(1) != 0) {
+                if (reader.get(1) != 0) {
+                    const unsigned lead = static_cast<unsigned>(reader.get(6));
+                    length = static_cast<unsigned>(reader.get(6)) + 1;
+                    trailing = width - lead - length;
+                }
+                key ^= reader.get(length) << trailing;
+            }
+            out[i] = valueOfKey<T>(key);
+        }
+    }
+}
+
+template <NumericCompressible T>
+void NumericCompressedColumn<T>::decode(std::size_t first, std::size_t rows, T* out) const
+{
+    if (first > count || rows > count - first) {
+        throw std::runtime_error("decode: Rows out of range.");
+    }
+    const std::size_t last = first + rows;
+
+    switch (kind) {
+        case NumericEncoding::Plain:
+            std::copy(values.begin() + first, values.begin() + last, out);
+            return;
+
+        case NumericEncoding::Dictionary: {
+            std::array<std::uint64_t, blockSize> codes;
+            for (std::size_t row = first; row < last; row += blockSize) {
+                const std::size_t chunk = std::min(blockSize, last - row);
+                unpack(packed.data(), std::uint64_t(row) * codeBits, codeBits, chunk, codes.data());
+                for (std::size_t i = 0; i < chunk; ++i) {
+                    out[row - first + i] = values[codes[i]];
+                }
+            }
+            return;
+        }
+
+        case NumericEncoding::RunLength: {
+            std::size_t run = std::upper_bound(runEnds.begin(), runEnds.end(), first) - runEnds.begin();
+            for (std::size_t row = first; row < last; ++run) {
+                const std::size_t end = std::min<std::size_t>(runEnds[run], last);
+                std::fill(out + (row - first), out + (end - first), values[run]);
+                row = end;
+            }
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    std::array<T, blockSize> scratch;
+    for (std::size_t row = first; row < last;) {
+        const std::size_t block = row / blockSize;
+        const std::size_t start = block * blockSize;
+        const std::size_t end = std::min(start + blockSize, count);
+        if (row == start && last >= end) {
+            decodeBlock(block, out + (row - first));
+        } else {
+            decodeBlock(block, scratch.data());
+            const std::size_t stop = std::min(end, last);
+            std::copy(scratch.begin() + (row - start), scratch.begin() + (stop - start), out + (row - first));
+        }
+        row = end;
+    }
+}
+
+template <NumericCompressible T>
+NumericColumn<T> NumericCompressedColumn<T>::decode() const
+{
+    NumericColumn<T> column(count);
+    decode(0, count, column.data());
+    return column;
+}
+
+template <NumericCompressible T>
+T NumericCompressedColumn<T>::at(std::size_t index) const
+{
+    if (index >= count) {
+        throw std::runtime_error("at: Index out of range.");
+    }
+    T value{};
+    decode(index, 1, &value);
+    return value;
+}
+
+
+/************************ Operations ********************************/
+
+template <NumericCompressible T>
+NumericMask NumericCompressedColumn<T>::comparison(NumericOp op, T value) const
+{
+    NumericMask mask(count);
+    std::uint64_t* words = mask.words();
+
+    switch (kind) {
+        case NumericEncoding::Plain:
+            throwIfFailed(op, columnCompare<T>(op, values.data(), &value, true, words, count));
+            return mask;
+
+        case NumericEncoding::Dictionary: {
+            // Compare each distinct value once; codes that pass are usually one range of the sorted dictionary
+            NumericMask passes(values.size());
+            throwIfFailed(op, columnCompare<T>(op, values.data(), &value, true, passes.words(), values.size()));
+            std::size_t low = 0;
+            while (low < values.size() && !passes.test(low)) {
+                ++low;
+            }
+            std::size_t high = values.size();
+            while (high > low && !passes.test(high - 1)) {
+                --high;
+            }
+            if (low == high) {
+                return mask;
+            }
+            const bool range = passes.count() == high - low;
+            std::vector<std::uint8_t> table;
+            if (!range) {
+                table.resize(values.size());
+                for (std::size_t code = 0; code < values.size(); ++code) {
+                    table[code] = passes.test(code);
+                }
+            }
+            std::array<std::uint64_t, blockSize> codes;
+            for (std::size_t row = 0; row < count; row += blockSize) {
+                const std::size_t rows = std::min(blockSize, count - row);
+                if (range && low == 0 && high == values.size()) {
+                    setRows(words, row, row + rows);
+                    continue;
+                }
+                unpack(packed.data(), std::uint64_t(row) * codeBits, codeBits, rows, codes.data());
+                if (range) {
+                    const std::uint64_t span = high - low;
+                    maskRows(words + row / 64, rows, [&](std::size_t i) { return codes[i] - low < span; });
+                } else {
+                    maskRows(words + row / 64, rows, [&](std::size_t i) { return table[codes[i]] != 0; });
+                }
+            }
+            return mask;
+        }
+
+        case NumericEncoding::RunLength: {
+            NumericMask passes(values.size());
+            throwIfFailed(op, columnCompare<T>(op, values.data(), &value, true, passes.words(), values.size()));
+            for (std::size_t run = 0; run < values.size(); ++run) {
+                if (passes.test(run)) {
+                    setRows(words, run == 0 ? 0 : runEnds[run - 1], runEnds[run]);
+                }
+            }
+            return mask;
+        }
+
+        case NumericEncoding::FrameOfReference:
+            if constexpr (!std::is_floating_point_v<T>) {
+                // Keys keep the comparison order, so a block is decided by its smallest and
+                // largest key or else compared offset by offset
+                const std::uint64_t key = keyOf(value);
+                std::array<std::uint64_t, blockSize> offsets;
+                for (std::size_t block = 0; block < blocks.size(); ++block) {
+                    const Block& header = blocks[block];
+                    const std::size_t row = block * blockSize;
+                    const std::size_t rows = std::min(blockSize, count - row);
+                    std::uint64_t* blockWords = words + row / 64;
+                    bool all = false;
+                    bool none = false;
+                    switch (op) {
+                        case NumericOp::LessThan:
+                            all = header.high < key;
+                            none = header.reference >= key;
+                            break;
+                        case NumericOp::GreaterThan:
+                            all = header.reference > key;
+                            none = header.high <= key;
+                            break;
+                        default:
+                            all = header.reference == key && header.high == key;
+                            none = key < header.reference || key > header.high;
+                            break;
+                    }
+                    if (all) {
+                        setRows(blockWords, 0, rows);
+                    }
+                    if (all || none) {
+                        continue;
+                    }
+                    const std::uint64_t limit = key - header.reference;
+                    unpack(packed.data(), header.bitOffset, header.bits, rows, offsets.data());
+                    switch (op) {
+                        case NumericOp::LessThan:
+                            maskRows(blockWords, rows, [&](std::size_t i) { return offsets[i] < limit; });
+                            break;
+                        case NumericOp::GreaterThan:
+                            maskRows(blockWords, rows, [&](std::size_t i) { return offsets[i] > limit; });
+                            break;
+                        default:
+                            maskRows(blockWords, rows, [&](std::size_t i) { return offsets[i] == limit; });
+                            break;
+                    }
+                }
+                return mask;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    // Delta and Xor: decode each block and run the column kernel on it
+    std::array<T, blockSize> scratch;
+    for (std::size_t block = 0; block < blocks.size(); ++block) {
+        const std::size_t row = block * blockSize;
+        const std::size_t rows = std::min(blockSize, count - row);
+        decodeBlock(block, scratch.data());
+        throwIfFailed(op, columnCompare<T>(op, scratch.data(), &value, true, words + row / 64, rows));
+    }
+    return mask;
+}
+
+template <NumericCompressible T>
+T NumericCompressedColumn<T>::sum() const requires IntegerValue<T>
+{
+    if (count == 0) {
+        throw std::runtime_error("numericSum: No values to reduce.");
+    }
+    NumericInt128 total = 0;
+
+    switch (kind) {
+        case NumericEncoding::Plain:
+            total = exactTotal(values.data(), count);
+            break;
+
+        case NumericEncoding::Dictionary: {
+            // A count per code, then each distinct value times its count
+            std::vector<std::uint64_t> counts(values.size(), 0);
+            std::array<std::uint64_t, blockSize> codes;
+            for (std::size_t row = 0; row < count; row += blockSize) {
+                const std::size_t rows = std::min(blockSize, count - row);
+                unpack(packed.data(), std::uint64_t(row) * codeBits, codeBits, rows, codes.data());
+                for (std::size_t i = 0; i < rows; ++i) {
+                    ++counts[codes[i]];
+                }
+            }
+            for (std::size_t code = 0; code < values.size(); ++code) {
+                total += static_cast<NumericInt128>(values[code]) * static_cast<NumericInt128>(counts[code]);
+            }
+            break;
+        }
+
+        case NumericEncoding::RunLength:
+            for (std::size_t run = 0; run < values.size(); ++run) {
+                const std::uint64_t length = runEnds[run] - (run == 0 ? 0 : runEnds[run - 1]);
+                total += static_cast<NumericInt128>(values[run]) * static_cast<NumericInt128>(length);
+            }
+            break;
+
+        case NumericEncoding::FrameOfReference: {
+            // rows * smallest value + the sum of the offsets
+            std::array<std::uint64_t, blockSize> offsets;
+            for (std::size_t block = 0; block < blocks.size(); ++block) {
+                const Block& header = blocks[block];
+                const std::size_t rows = std::min(blockSize, count - block * blockSize);
+                total += ordinalOfKey<T>(header.reference) * static_cast<NumericInt128>(rows);
+                if (header.bits == 0) {
+                    continue;
+                }
+                unpack(packed.data(), header.bitOffset, header.bits, rows, offsets.data());
+                if (header.bits <= 53) {
+                    std::uint64_t offsetTotal = 0;
+                    for (std::size_t i = 0; i < rows; ++i) {
+                        offsetTotal += offsets[i];
+                    }
+                    total += offsetTotal;
+                } else {
+                    for (std::size_t i = 0; i < rows; ++i) {
+                        total += offsets[i];
+                    }
+                }
+            }
+            break;
+        }
+
+        default: {
+            std::array<T, blockSize> scratch;
+            for (std::size_t block = 0; block < blocks.size(); ++block) {
+                const std::size_t rows = std::min(blockSize, count - block * blockSize);
+                decodeBlock(block, scratch.data());
+                total += exactTotal(scratch.data(), rows);
+            }
+            break;
+        }
+    }
+    return numericIntegerResult<T>(NumericOp::Sum, total);
+}
+
+template <NumericCompressible T>
+template <bool Max>
+T NumericCompressedColumn<T>::extreme(const char* name) const
+{
+    if (count == 0) {
+        throw std::runtime_error(std::string(name) + ": No values to reduce.");
+    }
+
+    if constexpr (IntegerValue<T>) {
+        if (kind == NumericEncoding::Dictionary) {
+            return Max ? values.back() : values.front();
+        }
+        if (kind == NumericEncoding::FrameOfReference) {
+            std::uint64_t best = Max ? blocks[0].high : blocks[0].reference;
+            for (const Block& header : blocks) {
+                best = Max ? std::max(best, header.high) : std::min(best, header.reference);
+            }
+            return valueOfKey<T>(best);
+        }
+    }
+
+    // NaN after everything and ties to the first value, as numericMin / numericMax order them
+    const auto before = [](T first, T second) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return first < second || (std::isnan(second) && !std::isnan(first));
+        } else {
+            return first < second;
+        }
+    };
+    T best{};
+    bool found = false;
+    const auto scan = [&](const T* data, std::size_t rows) {
+        std::size_t i = 0;
+        if (!found) {
+            best = data[0];
+            found = true;
+            i = 1;
+        }
+        for (; i < rows; ++i) {
+            if (Max ? before(best, data[i]) : before(data[i], best)) {
+                best = data[i];
+            }
+        }
+    };
+
+    if (kind == NumericEncoding::Plain || kind == NumericEncoding::RunLength) {
+        scan(values.data(), values.size());
+        return best;
+    }
+    std::array<T, blockSize> scratch;
+    for (std::size_t row = 0; row < count; row += blockSize) {
+        const std::size_t rows = std::min(blockSize, count - row);
+        decode(row, rows, scratch.data());
+        scan(scratch.data(), rows);
+    }
+    return best;
+}
+
+template <NumericCompressible T>
+T NumericCompressedColumn<T>::min() const requires (!charTemp<T>)
+{
+    return extreme<false>("numericMin");
+}
+
+template <NumericCompressible T>
+T NumericCompressedColumn<T>::max() const requires (!charTemp<T>)
+{
+    return extreme<true>("numericMax");
+}
+
+
+#define NUMERIC_COMPRESS_INSTANTIATE(T) \
+    template class NumericCompressedColumn<T>;
+
+NUMERIC_COMPRESS_INSTANTIATE(int)
+NUMERIC_COMPRESS_INSTANTIATE(float)
+NUMERIC_COMPRESS_INSTANTIATE(double)
+NUMERIC_COMPRESS_INSTANTIATE(char)
+NUMERIC_COMPRESS_INSTANTIATE(wchar_t)
+NUMERIC_COMPRESS_INSTANTIATE(char16_t)
+NUMERIC_COMPRESS_INSTANTIATE(char32_t)
+NUMERIC_COMPRESS_INSTANTIATE(std::int8_t)
+NUMERIC_COMPRESS_INSTANTIATE(std::int16_t)
+NUMERIC_COMPRESS_INSTANTIATE(std::int64_t)
+NUMERIC_COMPRESS_INSTANTIATE(std::uint8_t)
+NUMERIC_COMPRESS_INSTANTIATE(std::uint16_t)
+NUMERIC_COMPRESS_INSTANTIATE(std::uint32_t)
+NUMERIC_COMPRESS_INSTANTIATE(std::uint64_t)
+
+#undef NUMERIC_COMPRESS_INSTANTIATE
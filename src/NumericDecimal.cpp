@@ -0,0 +1,312 @@
+#include "NumericDecimal.hpp"
+
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+
+/************************ 256-bit products ********************************/
+
+namespace {
+
+using Limb = std::uint64_t;
+
+// first * second as four limbs, least significant first
+void multiplyWide(NumericUInt128 first, NumericUInt128 second, Limb product[4])
+{
+    const Limb a0 = static_cast<Limb>(first);
+    const Limb a1 = static_cast<Limb>(first >> 64);
+    const Limb b0 = static_cast<Limb>(second);
+    const Limb b1 = static_cast<Limb>(second >> 64);
+
+    const NumericUInt128 low = NumericUInt128(a0) * b0;
+    const NumericUInt128 cross1 = NumericUInt128(a0) * b1;
+    const NumericUInt128 cross2 = NumericUInt128(a1) * b0;
+    const NumericUInt128 high = NumericUInt128(a1) * b1;
+
+    const NumericUInt128 middle = (low >> 64) + static_cast<Limb>(cross1) + static_cast<Limb>(cross2);
+    const NumericUInt128 upper = (middle >> 64) + (cross1 >> 64) + (cross2 >> 64) + static_cast<Limb>(high);
+    product[0] = static_cast<Limb>(low);
+    product[1] = static_cast<Limb>(middle);
+    product[2] = static_cast<Limb>(upper);
+    product[3] = static_cast<Limb>((upper >> 64) + (high >> 64));
+}
+
+// quotient = number / divisor (four limbs each), returns the remainder
+NumericUInt128 divideWide(const Limb number[4], NumericUInt128 divisor, Limb quotient[4])
+{
+    if ((divisor >> 64) == 0) {
+        // Schoolbook division by one limb: each step divides a two-limb value
+        const Limb d = static_cast<Limb>(divisor);
+        NumericUInt128 remainder = 0;
+        for (int i = 3; i >= 0; --i) {
+            const NumericUInt128 current = (remainder << 64) | number[i];
+            quotient[i] = static_cast<Limb>(current / d);
+            remainder = current % d;
+        }
+        return remainder;
+    }
+
+    // Two-limb divisors only come from dividing by a decimal above 2^64 units: shift and subtract
+    NumericUInt128 remainder = 0;
+    for (int i = 3; i >= 0; --i) {
+        quotient[i] = 0;
+        for (int bit = 63; bit >= 0; --bit) {
+            const bool carry = (remainder >> 127) != 0;
+            remainder = (remainder << 1) | ((number[i] >> bit) & 1);
+            if (carry || remainder >= divisor) {
+                remainder -= divisor;
+                quotient[i] |= Limb(1) << bit;
+            }
+        }
+    }
+    return remainder;
+}
+
+// Bits [from, from + 128) of a four-limb number; bits past its top are 0
+NumericUInt128 wideBits(const Limb number[4], int from)
+{
+    auto limb = [&](int index) { return index < 4 ? number[index] : Limb(0); };
+    const int index = from / 64;
+    const int offset = from % 64;
+    Limb parts[2];
+    for (int i = 0; i < 2; ++i) {
+        parts[i] = limb(index + i) >> offset;
+        if (offset != 0) {
+            parts[i] |= limb(index + i + 1) << (64 - offset);
+        }
+    }
+    return (NumericUInt128(parts[1]) << 64) | parts[0];
+}
+
+int bitWidth(NumericUInt128 value)
+{
+    const Limb high = static_cast<Limb>(value >> 64);
+    return high != 0 ? 128 - std::countl_zero(high) : 64 - std::countl_zero(static_cast<Limb>(value));
+}
+
+// Whether any of the lowest `count` bits of a four-limb number is set
+bool anyBitBelow(const Limb number[4], int count)
+{
+    for (int i = 0; i < 4 && count > 0; ++i, count -= 64) {
+        const Limb mask = count >= 64 ? ~Limb(0) : (Limb(1) << count) - 1;
+        if ((number[i] & mask) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool numericMulDivWide(NumericUInt128 first, NumericUInt128 second, NumericUInt128 divisor, bool negative,
+                       NumericRounding rounding, NumericInt128& result)
+{
+    Limb product[4];
+    Limb quotient[4];
+    multiplyWide(first, second, product);
+    const NumericUInt128 remainder = divideWide(product, divisor, quotient);
+
+    if (numericRoundsAway(rounding, negative, quotient[0] & 1, remainder, divisor)) {
+        for (Limb& limb : quotient) {
+            if (++limb != 0) {
+                break;
+            }
+        }
+    }
+    const NumericUInt128 low = (NumericUInt128(quotient[1]) << 64) | quotient[0];
+    const bool fits = numericSignedResult(negative && low != 0, low, result);
+    return fits && quotient[2] == 0 && quotient[3] == 0;
+}
+
+bool numericScaleFloating(long double value, unsigned scale, NumericRounding rounding, NumericUInt128& magnitude)
+{
+    if (!std::isfinite(value)) {
+        return false;
+    }
+    // |value| = significand * 2^(exponent - 64) exactly, so |value| * 10^scale = product * 2^shift
+    int exponent = 0;
+    const long double fraction = std::frexp(std::fabs(value), &exponent);
+    Limb product[4];
+    multiplyWide(static_cast<Limb>(std::ldexp(fraction, 64)), static_cast<NumericUInt128>(numericPowerOf10(scale)), product);
+    const int shift = exponent - 64;
+
+    if (shift >= 128) {
+        return false;
+    }
+    if (shift >= 0) {
+        magnitude = wideBits(product, 0) << shift;
+        return wideBits(product, 128 - shift) == 0;
+    }
+    // The bits shifted out are the remainder: 2 * (its top bit) + (any bit below), out of 4
+    const int dropped = -shift;
+    magnitude = wideBits(product, dropped);
+    const NumericUInt128 remainder = 2 * (wideBits(product, dropped - 1) & 1) + anyBitBelow(product, dropped - 1);
+    const bool away = numericRoundsAway(rounding, value < 0, magnitude & 1, remainder, 4);
+    magnitude += away;
+    return wideBits(product, dropped + 128) == 0 && !(away && magnitude == 0);
+}
+
+
+int numericScaleBinary(NumericUInt128 magnitude, unsigned scale, std::uint64_t& significand)
+{
+    // magnitude * 2^shift / 10^scale lies in [2^63, 2^65): at least 64 bits before the point
+    const NumericUInt128 divisor = static_cast<NumericUInt128>(numericPowerOf10(scale));
+    const int shift = 64 + bitWidth(divisor) - bitWidth(magnitude);
+    Limb number[4] = {};
+    bool sticky = false;
+    if (shift >= 0) {
+        // At most 64 + 120 bits: 10^36 is below 2^120
+        const Limb parts[2] = {static_cast<Limb>(magnitude), static_cast<Limb>(magnitude >> 64)};
+        for (int i = 0; i < 4; ++i) {
+            const int source = i - shift / 64;
+            if (source >= 0 && source < 2) {
+                number[i] |= parts[source] << (shift % 64);
+            }
+            if (shift % 64 != 0 && source >= 1 && source <= 2) {
+                number[i] |= parts[source - 1] >> (64 - shift % 64);
+            }
+        }
+    } else {
+        number[0] = static_cast<Limb>(magnitude >> -shift);
+        number[1] = static_cast<Limb>(magnitude >> -shift >> 64);
+        sticky = (magnitude & ((NumericUInt128(1) << -shift) - 1)) != 0;
+    }
+
+    Limb quotient[4];
+    sticky |= divideWide(number, divisor, quotient) != 0;
+    int exponent = 63 - shift;
+    Limb top = quotient[0];
+    if (quotient[1] != 0) {
+        sticky |= (top & 1) != 0;
+        top = (top >> 1) | (quotient[1] << 63);
+        ++exponent;
+    }
+    significand = top | sticky;
+    return exponent;
+}
+
+
+/************************ Text ********************************/
+
+namespace {
+
+constexpr Limb power19 = 10000000000000000000ull;
+
+// Decimal digits of `magnitude`, most significant first; returns the end
+char* writeDigits(char* out, NumericUInt128 magnitude)
+{
+    if ((magnitude >> 64) == 0) {
+        return std::to_chars(out, out + 20, static_cast<Limb>(magnitude)).ptr;
+    }
+    // At most three groups of 19 digits; the lower groups keep their leading zeros
+    Limb groups[3];
+    int count = 0;
+    while (magnitude >= power19) {
+        groups[count++] = static_cast<Limb>(magnitude % power19);
+        magnitude /= power19;
+    }
+    out = std::to_chars(out, out + 20, static_cast<Limb>(magnitude)).ptr;
+    while (count-- > 0) {
+        char group[19];
+        const char* end = std::to_chars(group, group + 19, groups[count]).ptr;
+        const std::size_t length = static_cast<std::size_t>(end - group);
+        std::memset(out, '0', 19 - length);
+        std::memcpy(out + 19 - length, group, length);
+        out += 19;
+    }
+    return out;
+}
+
+[[noreturn]] void throwInvalid(std::string_view text)
+{
+    throw std::runtime_error("fromString: Invalid decimal \"" + std::string(text) + "\".");
+}
+
+} // namespace
+
+char* numericDecimalToChars(char* first, char* last, NumericInt128 units, unsigned scale)
+{
+    char digits[48];
+    char* end = writeDigits(digits, numericMagnitude(units));
+    std::size_t length = static_cast<std::size_t>(end - digits);
+
+    // At least one digit before the point
+    const std::size_t padding = length <= scale ? scale + 1 - length : 0;
+    const std::size_t size = (units < 0) + padding + length + (scale > 0);
+    if (static_cast<std::size_t>(last - first) < size) {
+        return nullptr;
+    }
+
+    char* out = first;
+    if (units < 0) {
+        *out++ = '-';
+    }
+    std::memset(out, '0', padding);
+    std::memcpy(out + padding, digits, length);
+    length += padding;
+    out += length;
+    if (scale > 0) {
+        std::memmove(out - scale + 1, out - scale, scale);
+        out[-static_cast<std::ptrdiff_t>(scale)] = '.';
+        ++out;
+    }
+    return out;
+}
+
+NumericInt128 numericDecimalFromString(std::string_view text, unsigned scale, NumericInt128 minUnits, NumericInt128 maxUnits)
+{
+    std::size_t i = 0;
+    const bool negative = !text.empty() && text[0] == '-';
+    if (!text.empty() && (text[0] == '-' || text[0] == '+')) {
+        ++i;
+    }
+
+    NumericUInt128 magnitude = 0;
+    bool overflow = false;
+    std::size_t digits = 0;
+    unsigned fractionDigits = 0;
+    bool point = false;
+    int roundDigit = -1;      // first digit beyond the scale
+    bool sticky = false;      // a nonzero digit after that one
+
+    for (; i < text.size(); ++i) {
+        const char c = text[i];
+        if (c == '.' && !point) {
+            point = true;
+            continue;
+        }
+        if (c < '0' || c > '9') {
+            throwInvalid(text);
+        }
+        ++digits;
+        if (point && fractionDigits == scale) {
+            if (roundDigit < 0) {
+                roundDigit = c - '0';
+            } else {
+                sticky |= c != '0';
+            }
+            continue;
+        }
+        fractionDigits += point;
+        overflow |= __builtin_mul_overflow(magnitude, NumericUInt128(10), &magnitude);
+        overflow |= __builtin_add_overflow(magnitude, NumericUInt128(c - '0'), &magnitude);
+    }
+    if (digits == 0) {
+        throwInvalid(text);
+    }
+    for (; fractionDigits < scale; ++fractionDigits) {
+        overflow |= __builtin_mul_overflow(magnitude, NumericUInt128(10), &magnitude);
+    }
+    if (roundDigit > 5 || (roundDigit == 5 && (sticky || (magnitude & 1)))) {
+        overflow |= __builtin_add_overflow(magnitude, NumericUInt128(1), &magnitude);
+    }
+
+    const NumericUInt128 limit = negative ? numericMagnitude(minUnits) : static_cast<NumericUInt128>(maxUnits);
+    if (overflow || magnitude > limit) {
+        throw std::runtime_error("fromString: Decimal \"" + std::string(text) + "\" is out of range.");
+    }
+    return negative ? static_cast<NumericInt128>(NumericUInt128(0) - magnitude) : static_cast<NumericInt128>(magnitude);
+}
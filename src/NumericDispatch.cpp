@@ -0,0 +1,443 @@
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+#include "NumericStats.hpp"
+
+#include <array>
+#include <utility>
+
+
+/************************ Dispatch tables ********************************/
+
+/**
+ * One entry per (lhs kind, rhs kind) for every operation, generated from the kernels
+ * in NumericKernels.hpp. An entry knows both concrete classes statically, so it reads
+ * the operands with a static_cast and builds the result directly in the promoted type.
+ * Entries also report the path they took to NumericStats.hpp; with NUMERIC_STATS off
+ * those calls compile to nothing.
+ */
+
+namespace {
+
+using ArithmeticEntry = std::unique_ptr<Numeric> (*)(const Numeric&, const Numeric&);
+using AssignEntry = std::unique_ptr<Numeric> (*)(Numeric&, const Numeric&);
+using ComparisonEntry = bool (*)(const Numeric&, const Numeric&);
+using ConversionEntry = std::unique_ptr<Numeric> (*)(const Numeric&);
+// (first, second, out, count, errors, offset of the run in the batch) -> failed elements
+using ArithmeticBatchEntry = std::size_t (*)(const Numeric* const*, const Numeric* const*, std::unique_ptr<Numeric>*, std::size_t, NumericMask&, std::size_t);
+using ComparisonBatchEntry = std::size_t (*)(const Numeric* const*, const Numeric* const*, std::size_t, NumericMask&, NumericMask&, std::size_t);
+
+// Batch runs are evaluated this many elements at a time: kernel loop first, then boxing
+constexpr std::size_t batchBlock = 64;
+
+thread_local constinit NumericOverflow currentOverflow = NumericOverflow::Checked;
+thread_local constinit NumericRounding currentRounding = NumericRounding::HalfEven;
+
+// The thread's overflow policy, only read when the entry produces an integer or a decimal
+template <typename Kernel>
+NumericOverflow overflowPolicy()
+{
+    if constexpr (hasOverflowPolicy(Kernel::resultKind)) {
+        return currentOverflow;
+    } else {
+        return NumericOverflow::Checked;
+    }
+}
+
+[[noreturn]] void throwNumericError(NumericOp op, NumericError error)
+{
+    throw std::runtime_error(numericErrorMessage(op, error));
+}
+
+template <NumericOp Op, NumericKind L, NumericKind R>
+[[noreturn]] void throwEntryError(NumericError error)
+{
+    numericStatsCount(Op, L, R, numericPathOf(error));
+    throwNumericError(Op, error);
+}
+
+// `Path` is what a successful call counts as: Boxed, or Widened when reached from assignEntry
+template <NumericOp Op, NumericKind L, NumericKind R, NumericPath Path = NumericPath::Boxed>
+std::unique_ptr<Numeric> arithmeticEntry(const Numeric& first, const Numeric& second)
+{
+    using Kernel = ArithmeticKernel<Op, L, R>;
+
+    if constexpr (Kernel::rule.error != NumericError::None) {
+        throwEntryError<Op, L, R>(Kernel::rule.error);
+    } else {
+        typename Kernel::result_type result{};
+        NumericError error = Kernel::apply(numericValueOf<L>(first), numericValueOf<R>(second), result, overflowPolicy<Kernel>());
+        if (error != NumericError::None) {
+            throwEntryError<Op, L, R>(error);
+        }
+        numericStatsCount(Op, L, R, Path);
+        return std::make_unique<NumericClass<Kernel::resultKind>>(std::move(result));
+    }
+}
+
+// Writes into `first` when the result keeps its kind, otherwise returns the widened result
+template <NumericOp Op, NumericKind L, NumericKind R>
+std::unique_ptr<Numeric> assignEntry(Numeric& first, const Numeric& second)
+{
+    using Kernel = ArithmeticKernel<Op, L, R>;
+
+    if constexpr (Kernel::rule.error != NumericError::None || Kernel::resultKind != L) {
+        return arithmeticEntry<Op, L, R, NumericPath::Widened>(first, second);
+    } else {
+        typename Kernel::result_type result{};
+        NumericError error = Kernel::apply(numericValueOf<L>(first), numericValueOf<R>(second), result, overflowPolicy<Kernel>());
+        if (error != NumericError::None) {
+            throwEntryError<Op, L, R>(error);
+        }
+        numericStatsCount(Op, L, R, NumericPath::InPlace);
+        numericValueOf<L>(first) = std::move(result);
+        return nullptr;
+    }
+}
+
+template <NumericOp Op, NumericKind L, NumericKind R>
+bool comparisonEntry(const Numeric& first, const Numeric& second)
+{
+    using Kernel = ComparisonKernel<Op, L, R>;
+
+    if constexpr (Kernel::error != NumericError::None) {
+        throwEntryError<Op, L, R>(Kernel::error);
+    } else {
+        bool result = false;
+        Kernel::apply(numericValueOf<L>(first), numericValueOf<R>(second), result);
+        numericStatsCount(Op, L, R, NumericPath::Compared);
+        return result;
+    }
+}
+
+template <NumericOp Op, NumericKind L, NumericKind R>
+std::size_t arithmeticBatchEntry(const Numeric* const* first, const Numeric* const* second, std::unique_ptr<Numeric>* out,
+                                 std::size_t count, NumericMask& errors, std::size_t offset)
+{
+    using Kernel = ArithmeticKernel<Op, L, R>;
+
+    if constexpr (Kernel::rule.error != NumericError::None) {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i].reset();
+            errors.set(offset + i);
+        }
+        numericStatsCount(Op, L, R, numericPathOf(Kernel::rule.error), count);
+        return count;
+    } else {
+        typename Kernel::result_type results[batchBlock];
+        NumericError failed[batchBlock];
+        std::size_t failures = 0;
+        std::size_t overflows = 0;
+        const NumericOverflow overflow = overflowPolicy<Kernel>();
+
+        for (std::size_t begin = 0; begin < count; begin += batchBlock) {
+            const std::size_t size = std::min(batchBlock, count - begin);
+            for (std::size_t i = 0; i < size; ++i) {
+                failed[i] = Kernel::apply(numericValueOf<L>(*first[begin + i]), numericValueOf<R>(*second[begin + i]), results[i], overflow);
+            }
+            for (std::size_t i = 0; i < size; ++i) {
+                if (failed[i] != NumericError::None) {
+                    out[begin + i].reset();
+                    errors.set(offset + begin + i);
+                    ++failures;
+                    overflows += failed[i] == NumericError::Overflow;
+                } else if (out[begin + i] && out[begin + i]->kind() == Kernel::resultKind) {
+                    numericValueOf<Kernel::resultKind>(*out[begin + i]) = std::move(results[i]);
+                } else {
+                    out[begin + i] = std::make_unique<NumericClass<Kernel::resultKind>>(std::move(results[i]));
+                }
+            }
+        }
+        // The only errors a kernel can report at run time are a zero divisor and an integer overflow
+        numericStatsCount(Op, L, R, NumericPath::Batched, count - failures);
+        numericStatsCount(Op, L, R, NumericPath::DivisionByZero, failures - overflows);
+        numericStatsCount(Op, L, R, NumericPath::Overflow, overflows);
+        return failures;
+    }
+}
+
+template <NumericOp Op, NumericKind L, NumericKind R>
+std::size_t comparisonBatchEntry(const Numeric* const* first, const Numeric* const* second, std::size_t count,
+                                 NumericMask& result, NumericMask& errors, std::size_t offset)
+{
+    using Kernel = ComparisonKernel<Op, L, R>;
+
+    if constexpr (Kernel::error != NumericError::None) {
+        for (std::size_t i = 0; i < count; ++i) {
+            errors.set(offset + i);
+        }
+        numericStatsCount(Op, L, R, numericPathOf(Kernel::error), count);
+        return count;
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            bool value = false;
+            Kernel::apply(numericValueOf<L>(*first[i]), numericValueOf<R>(*second[i]), value);
+            if (value) {
+                result.set(offset + i);
+            }
+        }
+        numericStatsCount(Op, L, R, NumericPath::Batched, count);
+        return 0;
+    }
+}
+
+template <NumericKind From, NumericKind To>
+std::unique_ptr<Numeric> conversionEntry(const Numeric& source)
+{
+    if constexpr (!isConvertible(From, To)) {
+        numericStatsCount(numericConvertStatsOp, From, To, NumericPath::UnsupportedConversion);
+        throw std::runtime_error("Unsupported conversion");
+    } else {
+        numericStatsCount(numericConvertStatsOp, From, To, NumericPath::Converted);
+        return std::make_unique<NumericClass<To>>(convertValue<To>(numericValueOf<From>(source)));
+    }
+}
+
+constexpr std::size_t tableIndex(NumericKind lhs, NumericKind rhs)
+{
+    return static_cast<std::size_t>(lhs) * numericKindCount + static_cast<std::size_t>(rhs);
+}
+
+template <NumericOp Op, std::size_t... I>
+constexpr std::array<ArithmeticEntry, sizeof...(I)> makeArithmeticRow(std::index_sequence<I...>)
+{
+    return {&arithmeticEntry<Op, NumericKind(I / numericKindCount), NumericKind(I % numericKindCount)>...};
+}
+
+template <NumericOp Op, std::size_t... I>
+constexpr std::array<AssignEntry, sizeof...(I)> makeAssignRow(std::index_sequence<I...>)
+{
+    return {&assignEntry<Op, NumericKind(I / numericKindCount), NumericKind(I % numericKindCount)>...};
+}
+
+template <NumericOp Op, std::size_t... I>
+constexpr std::array<ComparisonEntry, sizeof...(I)> makeComparisonRow(std::index_sequence<I...>)
+{
+    return {&comparisonEntry<Op, NumericKind(I / numericKindCount), NumericKind(I % numericKindCount)>...};
+}
+
+template <NumericOp Op, std::size_t... I>
+constexpr std::array<ArithmeticBatchEntry, sizeof...(I)> makeArithmeticBatchRow(std::index_sequence<I...>)
+{
+    return {&arithmeticBatchEntry<Op, NumericKind(I / numericKindCount), NumericKind(I % numericKindCount)>...};
+}
+
+template <NumericOp Op, std::size_t... I>
+constexpr std::array<ComparisonBatchEntry, sizeof...(I)> makeComparisonBatchRow(std::index_sequence<I...>)
+{
+    return {&comparisonBatchEntry<Op, NumericKind(I / numericKindCount), NumericKind(I % numericKindCount)>...};
+}
+
+template <std::size_t... I>
+constexpr std::array<ConversionEntry, sizeof...(I)> makeConversionTable(std::index_sequence<I...>)
+{
+    return {&conversionEntry<NumericKind(I / numericKindCount), NumericKind(I % numericKindCount)>...};
+}
+
+using PairSequence = std::make_index_sequence<numericKindCount * numericKindCount>;
+
+// [op][lhs * numericKindCount + rhs]
+constexpr std::array<std::array<ArithmeticEntry, numericKindCount * numericKindCount>, numericArithmeticOpCount> arithmeticTable = {
+    makeArithmeticRow<NumericOp::Sum>(PairSequence{}),
+    makeArithmeticRow<NumericOp::Subtract>(PairSequence{}),
+    makeArithmeticRow<NumericOp::Multiply>(PairSequence{}),
+    makeArithmeticRow<NumericOp::Divide>(PairSequence{}),
+};
+
+constexpr std::array<std::array<AssignEntry, numericKindCount * numericKindCount>, numericArithmeticOpCount> assignTable = {
+    makeAssignRow<NumericOp::Sum>(PairSequence{}),
+    makeAssignRow<NumericOp::Subtract>(PairSequence{}),
+    makeAssignRow<NumericOp::Multiply>(PairSequence{}),
+    makeAssignRow<NumericOp::Divide>(PairSequence{}),
+};
+
+constexpr std::array<std::array<ComparisonEntry, numericKindCount * numericKindCount>, numericOpCount - numericArithmeticOpCount> comparisonTable = {
+    makeComparisonRow<NumericOp::LessThan>(PairSequence{}),
+    makeComparisonRow<NumericOp::GreaterThan>(PairSequence{}),
+    makeComparisonRow<NumericOp::Equal>(PairSequence{}),
+};
+
+constexpr std::array<std::array<ArithmeticBatchEntry, numericKindCount * numericKindCount>, numericArithmeticOpCount> arithmeticBatchTable = {
+    makeArithmeticBatchRow<NumericOp::Sum>(PairSequence{}),
+    makeArithmeticBatchRow<NumericOp::Subtract>(PairSequence{}),
+    makeArithmeticBatchRow<NumericOp::Multiply>(PairSequence{}),
+    makeArithmeticBatchRow<NumericOp::Divide>(PairSequence{}),
+};
+
+constexpr std::array<std::array<ComparisonBatchEntry, numericKindCount * numericKindCount>, numericOpCount - numericArithmeticOpCount> comparisonBatchTable = {
+    makeComparisonBatchRow<NumericOp::LessThan>(PairSequence{}),
+    makeComparisonBatchRow<NumericOp::GreaterThan>(PairSequence{}),
+    makeComparisonBatchRow<NumericOp::Equal>(PairSequence{}),
+};
+
+// [from * numericKindCount + to]
+constexpr std::array<ConversionEntry, numericKindCount * numericKindCount> conversionTable = makeConversionTable(PairSequence{});
+
+// Length of the run of elements starting at `begin` that share the kinds of element `begin`
+std::size_t pairRunLength(std::span<const Numeric* const> first, std::span<const Numeric* const> second, std::size_t begin)
+{
+    const NumericKind lhs = first[begin]->kind();
+    const NumericKind rhs = second[begin]->kind();
+    std::size_t end = begin + 1;
+    while (end < first.size() && first[end]->kind() == lhs && second[end]->kind() == rhs) {
+        ++end;
+    }
+    return end - begin;
+}
+
+void checkBatchSizes(const char* name, std::size_t first, std::size_t second)
+{
+    if (first != second) {
+        throw std::runtime_error(std::string(name) + ": Batch sizes do not match.");
+    }
+}
+
+template <std::size_t... I>
+NumericKind kindOfTypeInfo(const std::type_info& type, std::index_sequence<I...>)
+{
+    NumericKind found = NumericKind::Count;
+    ((type == typeid(NumericClass<NumericKind(I)>) ? (found = NumericKind(I), true) : false) || ...);
+    return found;
+}
+
+// The sampled calls of the entry points, kept out of line so the others stay a plain jump
+template <typename Entry, typename First, typename... Rest>
+[[gnu::noinline]] auto timedCall(NumericOp op, Entry entry, First& first, const Rest&... rest)
+{
+    NumericStatsTimer timer(op);
+    return entry(first, rest...);
+}
+
+} // namespace
+
+
+/************************ Overflow policy ********************************/
+
+NumericOverflowScope::NumericOverflowScope(NumericOverflow overflow) : previous(currentOverflow)
+{
+    currentOverflow = overflow;
+}
+
+NumericOverflowScope::~NumericOverflowScope()
+{
+    currentOverflow = previous;
+}
+
+NumericOverflow numericOverflowMode()
+{
+    return currentOverflow;
+}
+
+
+/************************ Rounding policy ********************************/
+
+NumericRoundingScope::NumericRoundingScope(NumericRounding rounding) : previous(currentRounding)
+{
+    currentRounding = rounding;
+}
+
+NumericRoundingScope::~NumericRoundingScope()
+{
+    currentRounding = previous;
+}
+
+NumericRounding numericRoundingMode()
+{
+    return currentRounding;
+}
+
+
+/************************ Entry points ********************************/
+
+std::unique_ptr<Numeric> Numeric::apply(NumericOp op, const Numeric& first, const Numeric& second)
+{
+    if (static_cast<std::size_t>(op) >= numericArithmeticOpCount) {
+        throw std::invalid_argument("Numeric::apply: not an arithmetic operation.");
+    }
+    const ArithmeticEntry entry = arithmeticTable[static_cast<std::size_t>(op)][tableIndex(first.kind(), second.kind())];
+    if (numericStatsSampleDue()) {
+        return timedCall(op, entry, first, second);
+    }
+    return entry(first, second);
+}
+
+std::unique_ptr<Numeric> Numeric::applyAssign(NumericOp op, Numeric& first, const Numeric& second)
+{
+    if (static_cast<std::size_t>(op) >= numericArithmeticOpCount) {
+        throw std::invalid_argument("Numeric::applyAssign: not an arithmetic operation.");
+    }
+    const AssignEntry entry = assignTable[static_cast<std::size_t>(op)][tableIndex(first.kind(), second.kind())];
+    if (numericStatsSampleDue()) {
+        return timedCall(op, entry, first, second);
+    }
+    return entry(first, second);
+}
+
+std::size_t Numeric::applyBatch(NumericOp op, std::span<const Numeric* const> first, std::span<const Numeric* const> second,
+                                std::span<std::unique_ptr<Numeric>> out, NumericMask& errors)
+{
+    if (static_cast<std::size_t>(op) >= numericArithmeticOpCount) {
+        throw std::invalid_argument("Numeric::applyBatch: not an arithmetic operation.");
+    }
+    checkBatchSizes("applyBatch", first.size(), second.size());
+    checkBatchSizes("applyBatch", first.size(), out.size());
+
+    errors = NumericMask(first.size());
+    const auto& row = arithmeticBatchTable[static_cast<std::size_t>(op)];
+    std::size_t failures = 0;
+    for (std::size_t begin = 0; begin < first.size();) {
+        const std::size_t length = pairRunLength(first, second, begin);
+        failures += row[tableIndex(first[begin]->kind(), second[begin]->kind())](&first[begin], &second[begin], &out[begin], length, errors, begin);
+        begin += length;
+    }
+    return failures;
+}
+
+std::size_t Numeric::compareBatch(NumericOp op, std::span<const Numeric* const> first, std::span<const Numeric* const> second,
+                                  NumericMask& result, NumericMask& errors)
+{
+    if (static_cast<std::size_t>(op) < numericArithmeticOpCount || static_cast<std::size_t>(op) >= numericOpCount) {
+        throw std::invalid_argument("Numeric::compareBatch: not a comparison operation.");
+    }
+    checkBatchSizes("compareBatch", first.size(), second.size());
+
+    result = NumericMask(first.size());
+    errors = NumericMask(first.size());
+    const auto& row = comparisonBatchTable[static_cast<std::size_t>(op) - numericArithmeticOpCount];
+    std::size_t failures = 0;
+    for (std::size_t begin = 0; begin < first.size();) {
+        const std::size_t length = pairRunLength(first, second, begin);
+        failures += row[tableIndex(first[begin]->kind(), second[begin]->kind())](&first[begin], &second[begin], length, result, errors, begin);
+        begin += length;
+    }
+    return failures;
+}
+
+bool Numeric::compare(NumericOp op, const Numeric& first, const Numeric& second)
+{
+    if (static_cast<std::size_t>(op) < numericArithmeticOpCount || static_cast<std::size_t>(op) >= numericOpCount) {
+        throw std::invalid_argument("Numeric::compare: not a comparison operation.");
+    }
+    const std::size_t row = static_cast<std::size_t>(op) - numericArithmeticOpCount;
+    const ComparisonEntry entry = comparisonTable[row][tableIndex(first.kind(), second.kind())];
+    if (numericStatsSampleDue()) {
+        return timedCall(op, entry, first, second);
+    }
+    return entry(first, second);
+}
+
+std::unique_ptr<Numeric> Numeric::convertTo(NumericKind targetKind) const
+{
+    if (static_cast<std::size_t>(targetKind) >= static_cast<std::size_t>(NumericKind::Count)) {
+        throw std::runtime_error("Unsupported conversion");
+    }
+    const ConversionEntry entry = conversionTable[tableIndex(kind(), targetKind)];
+    if (numericStatsSampleDue()) {
+        return timedCall(numericConvertStatsOp, entry, *this);
+    }
+    return entry(*this);
+}
+
+std::unique_ptr<Numeric> Numeric::convertTo(const std::type_info& targetType) const
+{
+    return convertTo(kindOfTypeInfo(targetType, std::make_index_sequence<numericKindCount>{}));
+}
@@ -0,0 +1,324 @@
+#include "NumericFile.hpp"
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace {
+
+constexpr char fileMagic[8] = {'N', 'U', 'M', 'C', 'O', 'L', 'S', '\0'};
+
+struct FileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t columnCount;
+    std::uint64_t fileSize;
+    std::uint8_t padding[40];
+};
+
+struct ColumnHeader
+{
+    std::uint32_t type;
+    std::uint32_t elementSize;
+    std::uint64_t count;
+    std::uint64_t offset;
+    std::uint64_t reserved;
+    char name[numericFileNameLength];
+};
+
+static_assert(sizeof(FileHeader) == numericFileAlignment, "FileHeader must be 64 bytes");
+static_assert(sizeof(ColumnHeader) == numericFileAlignment, "ColumnHeader must be 64 bytes");
+
+// Values are stored as in memory, which matches the format only on little-endian hosts
+void requireLittleEndian(const char* opName)
+{
+    if constexpr (std::endian::native != std::endian::little) {
+        throw std::runtime_error(std::string(opName) + ": Only little-endian hosts are supported.");
+    }
+}
+
+std::size_t alignUp(std::size_t value)
+{
+    return (value + numericFileAlignment - 1) & ~(numericFileAlignment - 1);
+}
+
+std::size_t elementSizeOf(NumericFileType type)
+{
+    switch (type) {
+        case NumericFileType::Int32:          return sizeof(int);
+        case NumericFileType::Float32:        return sizeof(float);
+        case NumericFileType::Float64:        return sizeof(double);
+        case NumericFileType::ComplexFloat32: return sizeof(std::complex<float>);
+        case NumericFileType::ComplexFloat64: return sizeof(std::complex<double>);
+        case NumericFileType::Char8:          return sizeof(char);
+        case NumericFileType::WChar:          return sizeof(wchar_t);
+        case NumericFileType::Char16:         return sizeof(char16_t);
+        case NumericFileType::Char32:         return sizeof(char32_t);
+        case NumericFileType::Int8:           return sizeof(std::int8_t);
+        case NumericFileType::Int16:          return sizeof(std::int16_t);
+        case NumericFileType::Int64:          return sizeof(std::int64_t);
+        case NumericFileType::UInt8:          return sizeof(std::uint8_t);
+        case NumericFileType::UInt16:         return sizeof(std::uint16_t);
+        case NumericFileType::UInt32:         return sizeof(std::uint32_t);
+        case NumericFileType::UInt64:         return sizeof(std::uint64_t);
+        case NumericFileType::Float16:        return sizeof(NumericFloat16);
+        case NumericFileType::BFloat16:       return sizeof(NumericBFloat16);
+        case NumericFileType::Decimal2:       return sizeof(NumericDecimal2);
+        case NumericFileType::Decimal6:       return sizeof(NumericDecimal6);
+        default:                              return 0;
+    }
+}
+
+void writeBytes(std::FILE* file, const void* data, std::size_t size)
+{
+    if (size != 0 && std::fwrite(data, 1, size, file) != size) {
+        throw std::runtime_error("write: Write failed.");
+    }
+}
+
+} // namespace
+
+
+NumericFileType numericFileTypeOf(NumericKind kind)
+{
+    switch (kind) {
+        case NumericKind::Int:           return NumericFileType::Int32;
+        case NumericKind::Float:         return NumericFileType::Float32;
+        case NumericKind::Double:        return NumericFileType::Float64;
+        case NumericKind::ComplexFloat:  return NumericFileType::ComplexFloat32;
+        case NumericKind::ComplexDouble: return NumericFileType::ComplexFloat64;
+        case NumericKind::Char:          return NumericFileType::Char8;
+        case NumericKind::WChar:         return NumericFileType::WChar;
+        case NumericKind::Char16:        return NumericFileType::Char16;
+        case NumericKind::Char32:        return NumericFileType::Char32;
+        case NumericKind::Int8:          return NumericFileType::Int8;
+        case NumericKind::Int16:         return NumericFileType::Int16;
+        case NumericKind::Int64:         return NumericFileType::Int64;
+        case NumericKind::UInt8:         return NumericFileType::UInt8;
+        case NumericKind::UInt16:        return NumericFileType::UInt16;
+        case NumericKind::UInt32:        return NumericFileType::UInt32;
+        case NumericKind::UInt64:        return NumericFileType::UInt64;
+        case NumericKind::Float16:       return NumericFileType::Float16;
+        case NumericKind::BFloat16:      return NumericFileType::BFloat16;
+        case NumericKind::Decimal2:      return NumericFileType::Decimal2;
+        case NumericKind::Decimal6:      return NumericFileType::Decimal6;
+        default:
+            throw std::runtime_error("numericFileTypeOf: Unsupported type.");
+    }
+}
+
+NumericKind numericKindOfFileType(NumericFileType type)
+{
+    switch (type) {
+        case NumericFileType::Int32:          return NumericKind::Int;
+        case NumericFileType::Float32:        return NumericKind::Float;
+        case NumericFileType::Float64:        return NumericKind::Double;
+        case NumericFileType::ComplexFloat32: return NumericKind::ComplexFloat;
+        case NumericFileType::ComplexFloat64: return NumericKind::ComplexDouble;
+        case NumericFileType::Char8:          return NumericKind::Char;
+        case NumericFileType::WChar:          return NumericKind::WChar;
+        case NumericFileType::Char16:         return NumericKind::Char16;
+        case NumericFileType::Char32:         return NumericKind::Char32;
+        case NumericFileType::Int8:           return NumericKind::Int8;
+        case NumericFileType::Int16:          return NumericKind::Int16;
+        case NumericFileType::Int64:          return NumericKind::Int64;
+        case NumericFileType::UInt8:          return NumericKind::UInt8;
+        case NumericFileType::UInt16:         return NumericKind::UInt16;
+        case NumericFileType::UInt32:         return NumericKind::UInt32;
+        case NumericFileType::UInt64:         return NumericKind::UInt64;
+        case NumericFileType::Float16:        return NumericKind::Float16;
+        case NumericFileType::BFloat16:       return NumericKind::BFloat16;
+        case NumericFileType::Decimal2:       return NumericKind::Decimal2;
+        case NumericFileType::Decimal6:       return NumericKind::Decimal6;
+        default:
+            throw std::runtime_error("numericKindOfFileType: Unsupported type.");
+    }
+}
+
+/************************ NumericFileWriter Class ********************************/
+
+void NumericFileWriter::addColumn(std::string_view name, NumericKind kind, const void* data, std::size_t elementSize, std::size_t count)
+{
+    if (name.size() >= numericFileNameLength) {
+        throw std::runtime_error("add: Column name is too long.");
+    }
+    columns.push_back(PendingColumn{std::string(name), numericFileTypeOf(kind), data, elementSize, count});
+}
+
+void NumericFileWriter::write(const std::string& path) const
+{
+    requireLittleEndian("write");
+
+    // Lay out the file first so the header can carry the final size
+    std::vector<ColumnHeader> headers(columns.size());
+    std::size_t offset = alignUp(sizeof(FileHeader) + columns.size() * sizeof(ColumnHeader));
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        ColumnHeader& header = headers[i];
+        std::memset(&header, 0, sizeof(header));
+        header.type = static_cast<std::uint32_t>(columns[i].type);
+        header.elementSize = static_cast<std::uint32_t>(columns[i].elementSize);
+        header.count = columns[i].count;
+        header.offset = offset;
+        std::memcpy(header.name, columns[i].name.data(), columns[i].name.size());
+        offset = alignUp(offset + columns[i].count * columns[i].elementSize);
+    }
+
+    FileHeader fileHeader;
+    std::memset(&fileHeader, 0, sizeof(fileHeader));
+    std::memcpy(fileHeader.magic, fileMagic, sizeof(fileMagic));
+    fileHeader.version = numericFileVersion;
+    fileHeader.columnCount = static_cast<std::uint32_t>(columns.size());
+    fileHeader.fileSize = offset;
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("write: Cannot open " + path + ".");
+    }
+    try {
+        static const std::byte zeros[numericFileAlignment] = {};
+        std::size_t position = 0;
+        auto padTo = [&](std::size_t target) {
+            writeBytes(file, zeros, target - position);
+            position = target;
+        };
+
+        writeBytes(file, &fileHeader, sizeof(fileHeader));
+        writeBytes(file, headers.data(), headers.size() * sizeof(ColumnHeader));
+        position = sizeof(fileHeader) + headers.size() * sizeof(ColumnHeader);
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            padTo(headers[i].offset);
+            const std::size_t bytes = columns[i].count * columns[i].elementSize;
+            writeBytes(file, columns[i].data, bytes);
+            position += bytes;
+        }
+        padTo(offset);
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+    if (std::fclose(file) != 0) {
+        throw std::runtime_error("write: Write failed.");
+    }
+}
+
+/************************ NumericMappedFile Class ********************************/
+
+NumericMappedFile::NumericMappedFile(const std::string& path)
+{
+    requireLittleEndian("NumericMappedFile");
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("NumericMappedFile: Cannot open " + path + ".");
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart >= static_cast<LONGLONG>(sizeof(FileHeader))) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    if (mapping) {
+        base = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        mappedSize = static_cast<std::size_t>(size.QuadPart);
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+#else
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error("NumericMappedFile: Cannot open " + path + ".");
+    }
+    struct stat status;
+    if (::fstat(file, &status) == 0 && static_cast<std::size_t>(status.st_size) >= sizeof(FileHeader)) {
+        void* mapped = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+        if (mapped != MAP_FAILED) {
+            base = static_cast<const std::byte*>(mapped);
+            mappedSize = static_cast<std::size_t>(status.st_size);
+        }
+    }
+    ::close(file);   // the mapping stays valid
+#endif
+    if (!base) {
+        throw std::runtime_error("NumericMappedFile: Cannot map " + path + ".");
+    }
+
+    try {
+        FileHeader fileHeader;
+        std::memcpy(&fileHeader, base, sizeof(fileHeader));
+        if (std::memcmp(fileHeader.magic, fileMagic, sizeof(fileMagic)) != 0) {
+            throw std::runtime_error("NumericMappedFile: Not a Numeric column file.");
+        }
+        if (fileHeader.version != numericFileVersion) {
+            throw std::runtime_error("NumericMappedFile: Unsupported file version.");
+        }
+        const std::size_t directoryEnd = sizeof(FileHeader) + std::size_t{fileHeader.columnCount} * sizeof(ColumnHeader);
+        if (fileHeader.fileSize != mappedSize || directoryEnd > mappedSize) {
+            throw std::runtime_error("NumericMappedFile: File is truncated.");
+        }
+
+        columns.reserve(fileHeader.columnCount);
+        for (std::size_t i = 0; i < fileHeader.columnCount; ++i) {
+            ColumnHeader header;
+            std::memcpy(&header, base + sizeof(FileHeader) + i * sizeof(ColumnHeader), sizeof(header));
+
+            const NumericKind kind = numericKindOfFileType(static_cast<NumericFileType>(header.type));
+            if (header.elementSize != elementSizeOf(static_cast<NumericFileType>(header.type))) {
+                throw std::runtime_error("NumericMappedFile: Element size does not match this platform.");
+            }
+            if (header.offset % numericFileAlignment != 0 || header.offset < directoryEnd || header.offset > mappedSize ||
+                header.count > (mappedSize - header.offset) / header.elementSize) {
+                throw std::runtime_error("NumericMappedFile: Column is out of bounds.");
+            }
+            const char* nameEnd = static_cast<const char*>(std::memchr(header.name, '\0', numericFileNameLength));
+            if (!nameEnd) {
+                throw std::runtime_error("NumericMappedFile: Column name is not terminated.");
+            }
+            const std::size_t nameLength = static_cast<std::size_t>(nameEnd - header.name);
+            columns.push_back(NumericFileColumn{std::string(header.name, nameLength), kind,
+                                                static_cast<std::size_t>(header.count), static_cast<std::size_t>(header.offset)});
+        }
+    } catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+NumericMappedFile::~NumericMappedFile()
+{
+    unmap();
+}
+
+std::size_t NumericMappedFile::find(std::string_view name) const
+{
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        if (columns[i].name == name) {
+            return i;
+        }
+    }
+    throw std::runtime_error("find: No column named " + std::string(name) + ".");
+}
+
+void NumericMappedFile::unmap()
+{
+    if (!base) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+#else
+    ::munmap(const_cast<std::byte*>(base), mappedSize);
+#endif
+    base = nullptr;
+    mappedSize = 0;
+}
@@ -0,0 +1,225 @@
+#include "NumericFormat.hpp"
+
+#include <charconv>
+#include <cstring>
+
+
+/************************ Value formatting ********************************/
+
+namespace {
+
+// Appends the value to [first, last); nullptr when it does not fit
+template <typename T>
+char* formatScalar(char* first, char* last, T value)
+{
+    std::to_chars_result result = std::to_chars(first, last, value);
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+char* formatText(char* first, char* last, std::string_view text)
+{
+    if (static_cast<std::size_t>(last - first) < text.size()) {
+        return nullptr;
+    }
+    std::memcpy(first, text.data(), text.size());
+    return first + text.size();
+}
+
+char* formatCodePoint(char* first, char* last, char32_t code)
+{
+    if (code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+        code = 0xFFFD;
+    }
+    char bytes[4];
+    std::size_t count;
+    if (code < 0x80) {
+        bytes[0] = static_cast<char>(code);
+        count = 1;
+    } else if (code < 0x800) {
+        bytes[0] = static_cast<char>(0xC0 | (code >> 6));
+        bytes[1] = static_cast<char>(0x80 | (code & 0x3F));
+        count = 2;
+    } else if (code < 0x10000) {
+        bytes[0] = static_cast<char>(0xE0 | (code >> 12));
+        bytes[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        bytes[2] = static_cast<char>(0x80 | (code & 0x3F));
+        count = 3;
+    } else {
+        bytes[0] = static_cast<char>(0xF0 | (code >> 18));
+        bytes[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        bytes[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        bytes[3] = static_cast<char>(0x80 | (code & 0x3F));
+        count = 4;
+    }
+    return formatText(first, last, std::string_view(bytes, count));
+}
+
+/**
+ * Fewest significant digits (at most 5 for float16, 4 for bfloat16) that read back as
+ * the same bits. The float nearest those digits has them as its own shortest form, so
+ * printing it lets to_chars pick fixed or scientific notation as it does for float.
+ */
+template <typename T>
+char* formatHalf(char* first, char* last, T value)
+{
+    const float exact = value.toFloat();
+    float shortest = exact;
+    for (int precision = 1; precision <= 5 && exact == exact; ++precision) {
+        char buffer[32];
+        const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), exact, std::chars_format::general, precision);
+        float parsed = 0;
+        std::from_chars(buffer, result.ptr, parsed);
+        if (T(parsed).bits == value.bits) {
+            shortest = parsed;
+            break;
+        }
+    }
+    return formatScalar(first, last, shortest);
+}
+
+template <typename T>
+char* formatValue(char* first, char* last, const T& value)
+{
+    if constexpr (std::is_same_v<T, char>) {
+        return formatText(first, last, std::string_view(&value, 1));
+    } else if constexpr (charTemp<T>) {
+        return formatCodePoint(first, last, static_cast<char32_t>(static_cast<std::make_unsigned_t<T>>(value)));
+    } else if constexpr (isComplexValue<T>) {
+        char* out = formatText(first, last, "(");
+        out = out ? formatScalar(out, last, value.real()) : nullptr;
+        out = out ? formatText(out, last, " + ") : nullptr;
+        out = out ? formatScalar(out, last, value.imag()) : nullptr;
+        return out ? formatText(out, last, "i)") : nullptr;
+    } else if constexpr (std::is_same_v<T, NumericBigInt> || isDecimalValue<T>) {
+        return value.toChars(first, last);
+    } else if constexpr (isHalfValue<T>) {
+        return formatHalf(first, last, value);
+    } else {
+        return formatScalar(first, last, value);
+    }
+}
+
+} // namespace
+
+
+template <typename T>
+std::size_t numericFormatTo(char* buffer, std::size_t size, T value)
+{
+    char* end = formatValue(buffer, buffer + size, value);
+    return end ? static_cast<std::size_t>(end - buffer) : 0;
+}
+
+std::size_t Numeric::formatTo(char* buffer, std::size_t size) const
+{
+    return numericVisit(*this, [&](const auto& value) { return numericFormatTo(buffer, size, value); }, "formatTo");
+}
+
+/************************ NumericTextWriter Class ********************************/
+
+void NumericTextWriter::write(const Numeric& value)
+{
+    appendNumeric(value);
+    appendSeparator(true);
+}
+
+void NumericTextWriter::write(const std::vector<std::unique_ptr<Numeric>>& values)
+{
+    reserveFor(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        appendNumeric(*values[i]);
+        appendSeparator(i + 1 == values.size());
+    }
+}
+
+void NumericTextWriter::flush(std::FILE* file)
+{
+    if (std::fwrite(buffer.data(), 1, length, file) != length) {
+        throw std::runtime_error("flush: Write failed.");
+    }
+    clear();
+}
+
+void NumericTextWriter::flush(std::ostream& stream)
+{
+    if (!stream.write(buffer.data(), static_cast<std::streamsize>(length))) {
+        throw std::runtime_error("flush: Write failed.");
+    }
+    clear();
+}
+
+// Typical values are far shorter than numericFormatBufferSize, so reserve ~24 bytes each
+void NumericTextWriter::reserveFor(std::size_t values)
+{
+    ensure(values * 24 + numericFormatBufferSize);
+}
+
+void NumericTextWriter::grow(std::size_t bytes)
+{
+    buffer.resize(std::max(buffer.size() * 2, length + bytes));
+}
+
+void NumericTextWriter::appendNumeric(const Numeric& value)
+{
+    std::size_t room = numericFormatBufferSize;
+    if (value.kind() == NumericKind::BigInt) {
+        room = std::max(room, numericValueOf<NumericKind::BigInt>(value).decimalBound());
+    }
+    ensure(room);
+    std::size_t written = value.formatTo(buffer.data() + length, room);
+    if (written == 0) {
+        throw std::runtime_error("NumericTextWriter: Value does not fit its field.");
+    }
+    if (format == NumericTextFormat::Csv && isCharKind(value.kind())) {
+        written = quoteCsvField(written);
+    }
+    length += written;
+}
+
+// The field was just written at buffer[length]; wraps it in quotes if CSV requires it
+std::size_t NumericTextWriter::quoteCsvField(std::size_t written)
+{
+    char* field = buffer.data() + length;
+    if (written != 1 || (field[0] != ',' && field[0] != '"' && field[0] != '\n' && field[0] != '\r')) {
+        return written;   // only single ASCII bytes can be special
+    }
+    const char special = field[0];
+    std::size_t quoted = 0;
+    field[quoted++] = '"';
+    field[quoted++] = special;
+    if (special == '"') {
+        field[quoted++] = '"';
+    }
+    field[quoted++] = '"';
+    return quoted;
+}
+
+
+#define NUMERIC_FORMAT_INSTANTIATE(T) \
+    template std::size_t numericFormatTo<T>(char*, std::size_t, T);
+
+NUMERIC_FORMAT_INSTANTIATE(int)
+NUMERIC_FORMAT_INSTANTIATE(float)
+NUMERIC_FORMAT_INSTANTIATE(double)
+NUMERIC_FORMAT_INSTANTIATE(long double)
+NUMERIC_FORMAT_INSTANTIATE(std::complex<float>)
+NUMERIC_FORMAT_INSTANTIATE(std::complex<double>)
+NUMERIC_FORMAT_INSTANTIATE(std::complex<long double>)
+NUMERIC_FORMAT_INSTANTIATE(char)
+NUMERIC_FORMAT_INSTANTIATE(wchar_t)
+NUMERIC_FORMAT_INSTANTIATE(char16_t)
+NUMERIC_FORMAT_INSTANTIATE(char32_t)
+NUMERIC_FORMAT_INSTANTIATE(std::int8_t)
+NUMERIC_FORMAT_INSTANTIATE(std::int16_t)
+NUMERIC_FORMAT_INSTANTIATE(std::int64_t)
+NUMERIC_FORMAT_INSTANTIATE(std::uint8_t)
+NUMERIC_FORMAT_INSTANTIATE(std::uint16_t)
+NUMERIC_FORMAT_INSTANTIATE(std::uint32_t)
+NUMERIC_FORMAT_INSTANTIATE(std::uint64_t)
+NUMERIC_FORMAT_INSTANTIATE(NumericBigInt)
+NUMERIC_FORMAT_INSTANTIATE(NumericDecimal2)
+NUMERIC_FORMAT_INSTANTIATE(NumericDecimal6)
+NUMERIC_FORMAT_INSTANTIATE(NumericDecimal18)
+NUMERIC_FORMAT_INSTANTIATE(NumericFloat16)
+NUMERIC_FORMAT_INSTANTIATE(NumericBFloat16)
+
+#undef NUMERIC_FORMAT_INSTANTIATE
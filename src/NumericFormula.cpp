@@ -0,0 +1,705 @@
+#include "NumericFormula.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+
+/************************ Kernels ********************************/
+
+/**
+ * One kernel per (op, lhs kind, rhs kind), generated like the dispatch tables of
+ * NumericDispatch.cpp: out[i] = lhs[i] op rhs[i] over a run of rows. A kernel returns
+ * some error of the run when any row fails and may leave `out` partly written; the
+ * machine then finds the failing row one row at a time.
+ */
+
+namespace {
+
+using FormulaKernel = NumericError (*)(const void*, const void*, void*, std::size_t, NumericOverflow);
+
+template <NumericOp Op, NumericKind L, NumericKind R>
+NumericError formulaKernel(const void* first, const void* second, void* result, std::size_t count, NumericOverflow overflow)
+{
+    using Kernel = ArithmeticKernel<Op, L, R>;
+    using Result = typename Kernel::result_type;
+
+    if constexpr (Kernel::rule.error != NumericError::None) {
+        return Kernel::rule.error;
+    } else {
+        const auto* lhs = static_cast<const NumericKindValue<L>*>(first);
+        const auto* rhs = static_cast<const NumericKindValue<R>*>(second);
+        Result* out = static_cast<Result*>(result);
+        if constexpr (!hasOverflowPolicy(Kernel::resultKind)) {
+            overflow = NumericOverflow::Checked;
+        }
+
+        if constexpr (L == R && L != NumericKind::BigInt) {
+            return columnArithmetic<Result>(Op, lhs, rhs, false, out, count, overflow);
+        } else {
+            bool ok = true;
+            for (std::size_t i = 0; i < count; ++i) {
+                if constexpr (Op == NumericOp::Divide && std::is_floating_point_v<Result>) {
+                    // Same arithmetic as the kernel without the early return, so the loop vectorizes
+                    const Result divisor = convertValue<Kernel::resultKind>(rhs[i]);
+                    out[i] = convertValue<Kernel::resultKind>(lhs[i]) / divisor;
+                    ok &= divisor != 0;
+                } else {
+                    ok &= Kernel::apply(lhs[i], rhs[i], out[i], overflow) == NumericError::None;
+                }
+            }
+            return ok ? NumericError::None : NumericError::DivisionByZero;
+        }
+    }
+}
+
+constexpr std::size_t tableIndex(NumericKind lhs, NumericKind rhs)
+{
+    return static_cast<std::size_t>(lhs) * numericKindCount + static_cast<std::size_t>(rhs);
+}
+
+template <NumericOp Op, std::size_t... I>
+constexpr std::array<FormulaKernel, sizeof...(I)> makeKernelRow(std::index_sequence<I...>)
+{
+    return {&formulaKernel<Op, NumericKind(I / numericKindCount), NumericKind(I % numericKindCount)>...};
+}
+
+using PairSequence = std::make_index_sequence<numericKindCount * numericKindCount>;
+
+// [op][lhs * numericKindCount + rhs]
+constexpr std::array<std::array<FormulaKernel, numericKindCount * numericKindCount>, numericArithmeticOpCount> kernelTable = {
+    makeKernelRow<NumericOp::Sum>(PairSequence{}),
+    makeKernelRow<NumericOp::Subtract>(PairSequence{}),
+    makeKernelRow<NumericOp::Multiply>(PairSequence{}),
+    makeKernelRow<NumericOp::Divide>(PairSequence{}),
+};
+
+/************************ Registers ********************************/
+
+// A chunk buffer of one kind; value-initialized, so a fresh one holds zeros
+struct Scratch
+{
+    virtual ~Scratch() = default;
+    virtual void* data() = 0;
+};
+
+template <NumericKind K>
+struct ScratchOf final : Scratch
+{
+    using Value = NumericKindValue<K>;
+
+    std::vector<Value, AlignedAllocator<Value>> values;
+
+    explicit ScratchOf(std::size_t count) : values(count) {}
+    void* data() override { return values.data(); }
+};
+
+struct KindEntry
+{
+    std::size_t size;
+    std::unique_ptr<Scratch> (*scratch)(std::size_t);
+    void (*copy)(const void*, void*, std::size_t);
+};
+
+template <NumericKind K>
+std::unique_ptr<Scratch> makeScratch(std::size_t count)
+{
+    return std::make_unique<ScratchOf<K>>(count);
+}
+
+template <NumericKind K>
+void copyValues(const void* from, void* to, std::size_t count)
+{
+    using Value = NumericKindValue<K>;
+    std::copy_n(static_cast<const Value*>(from), count, static_cast<Value*>(to));
+}
+
+template <std::size_t... I>
+constexpr std::array<KindEntry, sizeof...(I)> makeKindTable(std::index_sequence<I...>)
+{
+    return {KindEntry{sizeof(NumericKindValue<NumericKind(I)>), &makeScratch<NumericKind(I)>, &copyValues<NumericKind(I)>}...};
+}
+
+constexpr std::array<KindEntry, numericKindCount> kindTable = makeKindTable(std::make_index_sequence<numericKindCount>{});
+
+const KindEntry& kindEntry(NumericKind kind)
+{
+    return kindTable[static_cast<std::size_t>(kind)];
+}
+
+// Writes `value` to the `count` elements at `out`, which hold values of its kind
+void fillValues(const NumericValue& value, void* out, std::size_t count)
+{
+    std::visit([&](const auto& element) {
+        using Value = std::decay_t<decltype(element)>;
+        std::fill_n(static_cast<Value*>(out), count, element);
+    }, value.value());
+}
+
+const char* opSymbol(NumericOp op)
+{
+    switch (op) {
+        case NumericOp::Sum:      return "+";
+        case NumericOp::Subtract: return "-";
+        case NumericOp::Multiply: return "*";
+        case NumericOp::Divide:   return "/";
+        default:                  return "?";
+    }
+}
+
+} // namespace
+
+
+/************************ NumericFormulaColumns Class ********************************/
+
+const NumericFormulaColumn* NumericFormulaColumns::find(std::string_view name) const
+{
+    for (const NumericFormulaColumn& column : columns) {
+        if (column.name == name) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
+void NumericFormulaColumns::bind(NumericFormulaColumn column)
+{
+    for (NumericFormulaColumn& bound : columns) {
+        if (bound.name == column.name) {
+            bound = std::move(column);
+            return;
+        }
+    }
+    columns.push_back(std::move(column));
+}
+
+
+/************************ Compiler ********************************/
+
+/**
+ * Recursive descent over
+ *     expression: term (('+' | '-') term)*
+ *     term:       unary (('*' | '/') unary)*
+ *     unary:      ('-' | '+') unary | primary
+ *     primary:    number | name | '(' expression ')'
+ * building a graph of hash-consed nodes, so a column, a constant or an operation on
+ * the same operands is one node however often it is written. Nodes are created after
+ * their operands, so their order is already an order to compute them in.
+ */
+struct NumericFormula::Compiler
+{
+    struct Node
+    {
+        NumericKind kind = NumericKind::Count;
+        Source source = Source::Temporary;   // Temporary for an operation
+        std::uint32_t index = 0;             // position in `names` or `values`, or unused
+        NumericOp op = NumericOp::Sum;
+        std::uint32_t lhs = 0;
+        std::uint32_t rhs = 0;
+    };
+
+    static constexpr std::uint32_t noSlot = std::numeric_limits<std::uint32_t>::max();
+
+    NumericFormula& formula;
+    const NumericFormulaColumns& columns;
+    std::string_view text;
+    std::size_t position = 0;
+
+    std::vector<Node> nodes;
+    std::map<std::string, std::uint32_t, std::less<>> columnNodes;
+    std::map<std::pair<NumericKind, std::string>, std::uint32_t> constantNodes;   // by kind and bytes
+    std::map<NumericKind, std::uint32_t> zeroNodes;
+    std::map<std::tuple<NumericOp, std::uint32_t, std::uint32_t>, std::uint32_t> operationNodes;
+    std::vector<std::string> names;     // of the Column nodes, by Node::index
+    std::vector<NumericValue> values;   // of the Constant nodes, by Node::index
+
+    Compiler(NumericFormula& formula, const NumericFormulaColumns& columns, std::string_view text)
+        : formula(formula), columns(columns), text(text)
+    {
+    }
+
+    void compile()
+    {
+        const std::uint32_t root = expression();
+        skipSpaces();
+        if (position != text.size()) {
+            unexpected();
+        }
+        generate(root);
+    }
+
+    /************************ Parsing ********************************/
+
+    [[noreturn]] void unexpected() const
+    {
+        if (position >= text.size()) {
+            throw std::runtime_error("NumericFormula: Unexpected end of formula.");
+        }
+        throw std::runtime_error("NumericFormula: Unexpected '" + std::string(1, text[position]) + "' at offset " +
+                                 std::to_string(position) + ".");
+    }
+
+    void skipSpaces()
+    {
+        while (position < text.size() && (text[position] == ' ' || text[position] == '\t' || text[position] == '\n' || text[position] == '\r')) {
+            ++position;
+        }
+    }
+
+    // Consumes `c` if it is the next character after the spaces
+    bool accept(char c)
+    {
+        skipSpaces();
+        if (position < text.size() && text[position] == c) {
+            ++position;
+            return true;
+        }
+        return false;
+    }
+
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+    static bool isNameStart(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+    static bool isNameChar(char c) { return isNameStart(c) || isDigit(c); }
+
+    std::uint32_t expression()
+    {
+        std::uint32_t node = term();
+        for (;;) {
+            if (accept('+')) {
+                node = operation(NumericOp::Sum, node, term());
+            } else if (accept('-')) {
+                node = operation(NumericOp::Subtract, node, term());
+            } else {
+                return node;
+            }
+        }
+    }
+
+    std::uint32_t term()
+    {
+        std::uint32_t node = unary();
+        for (;;) {
+            if (accept('*')) {
+                node = operation(NumericOp::Multiply, node, unary());
+            } else if (accept('/')) {
+                node = operation(NumericOp::Divide, node, unary());
+            } else {
+                return node;
+            }
+        }
+    }
+
+    std::uint32_t unary()
+    {
+        if (accept('-')) {
+            const std::uint32_t operand = unary();
+            return operation(NumericOp::Subtract, zero(operand), operand);
+        }
+        if (accept('+')) {
+            return unary();
+        }
+        return primary();
+    }
+
+    std::uint32_t primary()
+    {
+        skipSpaces();
+        if (accept('(')) {
+            const std::uint32_t node = expression();
+            if (!accept(')')) {
+                unexpected();
+            }
+            return node;
+        }
+        if (position < text.size() && (isDigit(text[position]) || text[position] == '.')) {
+            return number();
+        }
+        if (position < text.size() && isNameStart(text[position])) {
+            const std::size_t begin = position;
+            while (position < text.size() && isNameChar(text[position])) {
+                ++position;
+            }
+            return column(text.substr(begin, position - begin));
+        }
+        unexpected();
+    }
+
+    std::uint32_t number()
+    {
+        const std::size_t begin = position;
+        bool floating = false;
+        while (position < text.size() && isDigit(text[position])) {
+            ++position;
+        }
+        if (position < text.size() && text[position] == '.') {
+            floating = true;
+            ++position;
+            while (position < text.size() && isDigit(text[position])) {
+                ++position;
+            }
+        }
+        if (position < text.size() && (text[position] == 'e' || text[position] == 'E')) {
+            std::size_t end = position + 1;
+            if (end < text.size() && (text[end] == '+' || text[end] == '-')) {
+                ++end;
+            }
+            if (end < text.size() && isDigit(text[end])) {
+                floating = true;
+                position = end;
+                while (position < text.size() && isDigit(text[position])) {
+                    ++position;
+                }
+            }
+        }
+
+        const char* first = text.data() + begin;
+        const char* last = text.data() + position;
+        if (floating) {
+            double value = 0;
+            const auto [end, error] = std::from_chars(first, last, value);
+            if (error != std::errc() || end != last) {
+                position = begin;
+                unexpected();
+            }
+            return constant(NumericValue(value));
+        }
+        std::int64_t value = 0;
+        const auto [end, error] = std::from_chars(first, last, value);
+        if (error != std::errc() || end != last) {
+            throw std::runtime_error("NumericFormula: Integer literal " + std::string(first, last) + " is out of range.");
+        }
+        if (value <= std::numeric_limits<int>::max()) {
+            return constant(NumericValue(static_cast<int>(value)));
+        }
+        return constant(NumericValue(value));
+    }
+
+    /************************ Nodes ********************************/
+
+    std::uint32_t add(const Node& node)
+    {
+        nodes.push_back(node);
+        return static_cast<std::uint32_t>(nodes.size() - 1);
+    }
+
+    std::uint32_t column(std::string_view name)
+    {
+        if (const auto found = columnNodes.find(name); found != columnNodes.end()) {
+            return found->second;
+        }
+        const NumericFormulaColumn* bound = columns.find(name);
+        if (bound == nullptr) {
+            throw std::runtime_error("NumericFormula: Unknown column \"" + std::string(name) + "\".");
+        }
+        names.emplace_back(name);
+        const std::uint32_t node = add({bound->kind, Source::Column, static_cast<std::uint32_t>(names.size() - 1)});
+        columnNodes.emplace(std::string(name), node);
+        return node;
+    }
+
+    std::uint32_t constant(const NumericValue& value)
+    {
+        std::string bytes = std::visit([](const auto& element) {
+            return std::string(reinterpret_cast<const char*>(&element), sizeof(element));
+        }, value.value());
+        const auto key = std::make_pair(value.kind(), std::move(bytes));
+        if (const auto found = constantNodes.find(key); found != constantNodes.end()) {
+            return found->second;
+        }
+        values.push_back(value);
+        const std::uint32_t node = add({value.kind(), Source::Constant, static_cast<std::uint32_t>(values.size() - 1)});
+        constantNodes.emplace(key, node);
+        return node;
+    }
+
+    // The 0 that -x subtracts from, in the kind of x
+    std::uint32_t zero(std::uint32_t operand)
+    {
+        const NumericKind kind = nodes[operand].kind;
+        if (nodes[operand].source == Source::Constant) {
+            return constant(std::visit([](const auto& element) {
+                return NumericValue(std::decay_t<decltype(element)>{});
+            }, values[nodes[operand].index].value()));
+        }
+        if (const auto found = zeroNodes.find(kind); found != zeroNodes.end()) {
+            return found->second;
+        }
+        const std::uint32_t node = add({kind, Source::Zero});
+        zeroNodes.emplace(kind, node);
+        return node;
+    }
+
+    std::uint32_t operation(NumericOp op, std::uint32_t lhs, std::uint32_t rhs)
+    {
+        const NumericKind lhsKind = nodes[lhs].kind;
+        const NumericKind rhsKind = nodes[rhs].kind;
+        const NumericRule rule = arithmeticRule(lhsKind, rhsKind, op);
+        if (rule.error != NumericError::None) {
+            throw std::runtime_error(numericErrorMessage(op, rule.error));
+        }
+
+        if (nodes[lhs].source == Source::Constant && nodes[rhs].source == Source::Constant) {
+            NumericValue folded;
+            const NumericError error = NumericValue::apply(op, values[nodes[lhs].index], values[nodes[rhs].index], folded);
+            if (error != NumericError::None) {
+                throw std::runtime_error(numericErrorMessage(op, error));
+            }
+            return constant(folded);
+        }
+
+        // a + b and b + a are one node, except for floating kinds, where the NaN that
+        // comes out of NaN + NaN depends on the order
+        const bool commutes = op == NumericOp::Sum || op == NumericOp::Multiply;
+        if (commutes && lhsKind == rhsKind && !isFloatKind(lhsKind) && !isComplexKind(lhsKind) && rhs < lhs) {
+            std::swap(lhs, rhs);
+        }
+        const auto key = std::make_tuple(op, lhs, rhs);
+        if (const auto found = operationNodes.find(key); found != operationNodes.end()) {
+            return found->second;
+        }
+        const std::uint32_t node = add({rule.result, Source::Temporary, 0, op, lhs, rhs});
+        operationNodes.emplace(key, node);
+        return node;
+    }
+
+    /************************ Code generation ********************************/
+
+    /**
+     * Emits the operations `root` depends on, in node order. Each result gets a
+     * scratch slot of its kind, taken back once its last reader has run (after that
+     * reader's own slot is taken, so no instruction writes over its operands); the
+     * root writes into the output.
+     */
+    void generate(std::uint32_t root)
+    {
+        std::vector<bool> reachable(nodes.size(), false);
+        std::vector<std::uint32_t> lastUse(nodes.size(), 0);
+        reachable[root] = true;
+        for (std::uint32_t node = root + 1; node-- > 0;) {
+            if (reachable[node] && nodes[node].source == Source::Temporary) {
+                for (const std::uint32_t operand : {nodes[node].lhs, nodes[node].rhs}) {
+                    reachable[operand] = true;
+                    lastUse[operand] = std::max(lastUse[operand], node);
+                }
+            }
+        }
+
+        std::vector<Operand> operands(nodes.size());
+        std::map<NumericKind, std::vector<std::uint32_t>> freeSlots;
+        const auto newSlot = [this](NumericKind kind) {
+            formula.slots.push_back(kind);
+            return static_cast<std::uint32_t>(formula.slots.size() - 1);
+        };
+        const auto release = [&](std::uint32_t used, std::uint32_t reader) {
+            if (lastUse[used] == reader && nodes[used].source == Source::Temporary) {
+                freeSlots[nodes[used].kind].push_back(operands[used].index);
+            }
+        };
+
+        for (std::uint32_t node = 0; node <= root; ++node) {
+            if (!reachable[node]) {
+                continue;
+            }
+            const Node& current = nodes[node];
+            Operand& operand = operands[node];
+            operand.kind = current.kind;
+            operand.source = current.source;
+
+            switch (current.source) {
+                case Source::Column:
+                    operand.index = static_cast<std::uint32_t>(formula.inputs.size());
+                    formula.inputs.push_back({names[current.index], current.kind});
+                    break;
+                case Source::Constant:
+                    operand.index = static_cast<std::uint32_t>(formula.constants.size());
+                    formula.constants.push_back(values[current.index]);
+                    formula.constantSlots.push_back(node == root ? noSlot : newSlot(current.kind));
+                    break;
+                case Source::Zero:
+                    operand.index = newSlot(current.kind);
+                    break;
+                default: {
+                    if (node == root) {
+                        operand.source = Source::Result;
+                    } else if (auto& slots = freeSlots[current.kind]; !slots.empty()) {
+                        operand.index = slots.back();
+                        slots.pop_back();
+                    } else {
+                        operand.index = newSlot(current.kind);
+                    }
+                    formula.program.push_back({current.op, operands[current.lhs], operands[current.rhs], operand});
+                    release(current.lhs, node);
+                    if (current.rhs != current.lhs) {
+                        release(current.rhs, node);
+                    }
+                    break;
+                }
+            }
+        }
+
+        formula.result = nodes[root].kind;
+        formula.root = operands[root];
+    }
+};
+
+NumericFormula::NumericFormula(std::string_view text, const NumericFormulaColumns& columns)
+{
+    Compiler(*this, columns, text).compile();
+}
+
+std::string NumericFormula::disassemble() const
+{
+    const auto name = [this](const Operand& operand) -> std::string {
+        switch (operand.source) {
+            case Source::Column:    return inputs[operand.index].name;
+            case Source::Constant:  return constants[operand.index].toString();
+            case Source::Zero:      return "0";
+            case Source::Temporary: return "t" + std::to_string(operand.index);
+            default:                return "result";
+        }
+    };
+    const auto kind = [](const Operand& operand) {
+        return std::string("    ; ") + numericKindName(operand.kind) + "\n";
+    };
+
+    if (program.empty()) {
+        return "result = " + name(root) + kind(root);
+    }
+    std::string text;
+    for (const Instruction& instruction : program) {
+        text += name(instruction.out) + " = " + name(instruction.lhs) + " " + opSymbol(instruction.op) + " " +
+                name(instruction.rhs) + kind(instruction.out);
+    }
+    return text;
+}
+
+
+/************************ Evaluation ********************************/
+
+void NumericFormula::checkResultKind(NumericKind kind) const
+{
+    if (kind != result) {
+        throw std::runtime_error(std::string("NumericFormula: The formula gives ") + numericKindName(result) +
+                                 " values, not " + numericKindName(kind) + ".");
+    }
+}
+
+std::vector<const void*> NumericFormula::resolve(const NumericFormulaColumns& columns, std::size_t& rows) const
+{
+    std::vector<const void*> data;
+    data.reserve(inputs.size());
+    rows = 1;
+    for (const Input& input : inputs) {
+        const NumericFormulaColumn* column = columns.find(input.name);
+        if (column == nullptr) {
+            throw std::runtime_error("NumericFormula: Unknown column \"" + input.name + "\".");
+        }
+        if (column->kind != input.kind) {
+            throw std::runtime_error("NumericFormula: Column \"" + input.name + "\" holds " + numericKindName(column->kind) +
+                                     " values, the formula was compiled for " + numericKindName(input.kind) + ".");
+        }
+        if (data.empty()) {
+            rows = column->size;
+        } else if (column->size != rows) {
+            throw std::runtime_error("NumericFormula: Column sizes do not match.");
+        }
+        data.push_back(column->data);
+    }
+    return data;
+}
+
+// The state of one evaluate() call: the operands' kernels and the scratch registers
+struct NumericFormula::Machine
+{
+    const NumericFormula& formula;
+    const std::vector<const void*>& columns;
+    void* out;
+    NumericOverflow overflow = numericOverflowMode();
+    std::vector<FormulaKernel> kernels;
+    std::vector<std::unique_ptr<Scratch>> scratch;
+
+    Machine(const NumericFormula& formula, const std::vector<const void*>& columns, void* out)
+        : formula(formula), columns(columns), out(out)
+    {
+        kernels.reserve(formula.program.size());
+        for (const Instruction& instruction : formula.program) {
+            const std::size_t op = static_cast<std::size_t>(instruction.op);
+            kernels.push_back(kernelTable[op][tableIndex(instruction.lhs.kind, instruction.rhs.kind)]);
+        }
+        scratch.reserve(formula.slots.size());
+        for (const NumericKind kind : formula.slots) {
+            scratch.push_back(kindEntry(kind).scratch(chunkRows));
+        }
+        for (std::size_t constant = 0; constant < formula.constants.size(); ++constant) {
+            if (formula.constantSlots[constant] != Compiler::noSlot) {
+                fillValues(formula.constants[constant], scratch[formula.constantSlots[constant]]->data(), chunkRows);
+            }
+        }
+    }
+
+    // Where `operand` holds row `row` of the chunk starting at row `chunk`
+    void* address(const Operand& operand, std::size_t row, std::size_t chunk) const
+    {
+        const std::size_t size = kindEntry(operand.kind).size;
+        switch (operand.source) {
+            case Source::Column:    return static_cast<char*>(const_cast<void*>(columns[operand.index])) + row * size;
+            case Source::Constant:  return scratch[formula.constantSlots[operand.index]]->data();
+            case Source::Zero:      return scratch[operand.index]->data();
+            case Source::Temporary: return static_cast<char*>(scratch[operand.index]->data()) + (row - chunk) * size;
+            default:                return static_cast<char*>(out) + row * size;
+        }
+    }
+
+    NumericError step(std::size_t instruction, std::size_t row, std::size_t chunk, std::size_t count) const
+    {
+        const Instruction& current = formula.program[instruction];
+        return kernels[instruction](address(current.lhs, row, chunk), address(current.rhs, row, chunk),
+                                    address(current.out, row, chunk), count, overflow);
+    }
+
+    // Reruns the chunk row by row, in program order, for the first error of the first failing row
+    [[noreturn]] void throwFirstError(std::size_t chunk, std::size_t count) const
+    {
+        for (std::size_t row = chunk; row < chunk + count; ++row) {
+            for (std::size_t instruction = 0; instruction < formula.program.size(); ++instruction) {
+                const NumericError error = step(instruction, row, chunk, 1);
+                if (error != NumericError::None) {
+                    throw std::runtime_error(numericErrorMessage(formula.program[instruction].op, error));
+                }
+            }
+        }
+        throw std::runtime_error(numericErrorMessage(NumericOp::Divide, NumericError::DivisionByZero));
+    }
+
+    void run(std::size_t rows) const
+    {
+        if (formula.program.empty()) {
+            if (formula.root.source == Source::Column) {
+                kindEntry(formula.result).copy(columns[formula.root.index], out, rows);
+            } else {
+                fillValues(formula.constants[formula.root.index], out, rows);
+            }
+            return;
+        }
+        for (std::size_t chunk = 0; chunk < rows; chunk += chunkRows) {
+            const std::size_t count = std::min(chunkRows, rows - chunk);
+            for (std::size_t instruction = 0; instruction < formula.program.size(); ++instruction) {
+                if (step(instruction, chunk, chunk, count) != NumericError::None) {
+                    throwFirstError(chunk, count);
+                }
+            }
+        }
+    }
+};
+
+void NumericFormula::execute(const std::vector<const void*>& columns, void* out, std::size_t rows) const
+{
+    Machine(*this, columns, out).run(rows);
+}
@@ -0,0 +1,228 @@
+#include "NumericHalf.hpp"
+#include "NumericColumn.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NUMERIC_HALF_X86 1
+#include <immintrin.h>
+#else
+#define NUMERIC_HALF_X86 0
+#endif
+
+
+/************************ Scalar conversions ********************************/
+
+namespace {
+
+template <typename H>
+void scalarToFloat(const H* in, float* out, std::size_t begin, std::size_t count)
+{
+    for (std::size_t i = begin; i < count; ++i) {
+        out[i] = in[i].toFloat();
+    }
+}
+
+template <typename H>
+void scalarFromFloat(const float* in, H* out, std::size_t begin, std::size_t count)
+{
+    for (std::size_t i = begin; i < count; ++i) {
+        out[i] = H(in[i]);
+    }
+}
+
+} // namespace
+
+
+#if NUMERIC_HALF_X86
+
+/**
+ * float16 uses the F16C / AVX-512 conversions, which round to nearest-even and quiet a
+ * NaN the way numericHalfFromDouble does. bfloat16 is the top half of a float, so the
+ * conversion is integer work: widening is a shift, and narrowing adds 0x7FFF plus the
+ * lowest kept bit before shifting, which rounds to nearest-even and carries into the
+ * exponent (up to infinity). VCVTNEPS2BF16 is not used: it flushes subnormal inputs to
+ * zero, and the results would then depend on the CPU.
+ */
+
+/************************ AVX2 + F16C kernels ********************************/
+
+#pragma GCC push_options
+#pragma GCC target("avx2,f16c")
+
+namespace avx2 {
+
+std::size_t toFloat(const NumericFloat16* in, float* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(half));
+    }
+    return i;
+}
+
+std::size_t fromFloat(const float* in, NumericFloat16* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), half);
+    }
+    return i;
+}
+
+std::size_t toFloat(const NumericBFloat16* in, float* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_slli_epi32(wide, 16));
+    }
+    return i;
+}
+
+std::size_t fromFloat(const float* in, NumericBFloat16* out, std::size_t count)
+{
+    const __m256i magnitudeMask = _mm256_set1_epi32(0x7FFFFFFF);
+    const __m256i infinity = _mm256_set1_epi32(0x7F800000);
+    const __m256i roundingBias = _mm256_set1_epi32(0x7FFF);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i quiet = _mm256_set1_epi32(0x40);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const __m256i high = _mm256_srli_epi32(bits, 16);
+        const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, roundingBias), _mm256_and_si256(high, one)), 16);
+        const __m256i isNan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, magnitudeMask), infinity);
+        const __m256i result = _mm256_blendv_epi8(rounded, _mm256_or_si256(high, quiet), isNan);
+        // Every lane is below 0x10000, so the unsigned-saturating pack keeps it; then gather the two halves
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(result, result), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(packed));
+    }
+    return i;
+}
+
+} // namespace avx2
+
+#pragma GCC pop_options
+
+
+/************************ AVX-512 kernels ********************************/
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+namespace avx512 {
+
+std::size_t toFloat(const NumericFloat16* in, float* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i half = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        _mm512_storeu_ps(out + i, _mm512_cvtph_ps(half));
+    }
+    return i;
+}
+
+std::size_t fromFloat(const float* in, NumericFloat16* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i half = _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), half);
+    }
+    return i;
+}
+
+std::size_t toFloat(const NumericBFloat16* in, float* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512i wide = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+        _mm512_storeu_si512(out + i, _mm512_slli_epi32(wide, 16));
+    }
+    return i;
+}
+
+std::size_t fromFloat(const float* in, NumericBFloat16* out, std::size_t count)
+{
+    const __m512i magnitudeMask = _mm512_set1_epi32(0x7FFFFFFF);
+    const __m512i infinity = _mm512_set1_epi32(0x7F800000);
+    const __m512i roundingBias = _mm512_set1_epi32(0x7FFF);
+    const __m512i one = _mm512_set1_epi32(1);
+    const __m512i quiet = _mm512_set1_epi32(0x40);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512i bits = _mm512_loadu_si512(in + i);
+        const __m512i high = _mm512_srli_epi32(bits, 16);
+        const __m512i rounded = _mm512_srli_epi32(_mm512_add_epi32(_mm512_add_epi32(bits, roundingBias), _mm512_and_si512(high, one)), 16);
+        const __mmask16 isNan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(bits, magnitudeMask), infinity);
+        const __m512i result = _mm512_mask_blend_epi32(isNan, rounded, _mm512_or_si512(high, quiet));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_cvtepi32_epi16(result));
+    }
+    return i;
+}
+
+} // namespace avx512
+
+#pragma GCC pop_options
+
+#endif // NUMERIC_HALF_X86
+
+
+/************************ Dispatch ********************************/
+
+namespace {
+
+// The AVX2 float16 kernels also need F16C; AVX-512F has the conversions itself
+bool hasF16c()
+{
+#if NUMERIC_HALF_X86
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("f16c") != 0);
+    return supported;
+#else
+    return false;
+#endif
+}
+
+template <typename H>
+void toFloatFor(const H* in, float* out, std::size_t count)
+{
+    std::size_t done = 0;
+#if NUMERIC_HALF_X86
+    switch (numericSimdLevel()) {
+        case NumericSimdLevel::Avx512: done = avx512::toFloat(in, out, count); break;
+        case NumericSimdLevel::Avx2:
+            if (std::is_same_v<H, NumericBFloat16> || hasF16c()) {
+                done = avx2::toFloat(in, out, count);
+            }
+            break;
+        default: break;
+    }
+#endif
+    scalarToFloat(in, out, done, count);
+}
+
+template <typename H>
+void fromFloatFor(const float* in, H* out, std::size_t count)
+{
+    std::size_t done = 0;
+#if NUMERIC_HALF_X86
+    switch (numericSimdLevel()) {
+        case NumericSimdLevel::Avx512: done = avx512::fromFloat(in, out, count); break;
+        case NumericSimdLevel::Avx2:
+            if (std::is_same_v<H, NumericBFloat16> || hasF16c()) {
+                done = avx2::fromFloat(in, out, count);
+            }
+            break;
+        default: break;
+    }
+#endif
+    scalarFromFloat(in, out, done, count);
+}
+
+} // namespace
+
+void numericToFloat(const NumericFloat16* in, float* out, std::size_t count) { toFloatFor(in, out, count); }
+void numericToFloat(const NumericBFloat16* in, float* out, std::size_t count) { toFloatFor(in, out, count); }
+void numericFromFloat(const float* in, NumericFloat16* out, std::size_t count) { fromFloatFor(in, out, count); }
+void numericFromFloat(const float* in, NumericBFloat16* out, std::size_t count) { fromFloatFor(in, out, count); }
@@ -0,0 +1,151 @@
+#include "NumericHash.hpp"
+#include "NumericSort.hpp"
+
+#include <cstring>
+
+
+/************************ Values of any kind ********************************/
+
+namespace {
+
+/**
+ * A finite real part as numerator * 2^binaryExponent / 10^scale. Only the comparisons
+ * the sort keys cannot decide (a decimal, or a BigInt beyond 64 bits) come here, so
+ * they are done exactly in NumericBigInt, allocations and all.
+ */
+struct ExactReal
+{
+    NumericBigInt numerator;
+    int binaryExponent = 0;
+    unsigned scale = 0;
+};
+
+NumericBigInt powerOf2(int exponent)
+{
+    NumericBigInt power = 1;
+    for (; exponent >= 32; exponent -= 32) {
+        power *= NumericBigInt(std::uint64_t(1) << 32);
+    }
+    return power * NumericBigInt(std::uint64_t(1) << exponent);
+}
+
+NumericBigInt bigIntOf(NumericInt128 value)
+{
+    const NumericBigInt high(static_cast<std::int64_t>(value >> 64));
+    return high * powerOf2(64) + NumericBigInt(static_cast<std::uint64_t>(value));
+}
+
+// false for NaN, the infinities and characters, which never equal a decimal or a BigInt
+template <typename T>
+bool exactReal(const T& value, ExactReal& exact)
+{
+    if constexpr (charTemp<T> || isComplexValue<T>) {
+        return false;
+    } else if constexpr (isHalfValue<T>) {
+        return exactReal(value.toFloat(), exact);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (!std::isfinite(value)) {
+            return false;
+        }
+        int exponent = 0;
+        const long double fraction = std::frexp(std::fabs(static_cast<long double>(value)), &exponent);
+        const NumericBigInt significand(static_cast<std::uint64_t>(std::ldexp(fraction, 64)));
+        exact.numerator = value < 0 ? -significand : significand;
+        exact.binaryExponent = exponent - 64;
+        return true;
+    } else if constexpr (isDecimalValue<T>) {
+        exact.numerator = bigIntOf(value.units);
+        exact.scale = T::scale;
+        return true;
+    } else if constexpr (std::is_same_v<T, NumericBigInt>) {
+        exact.numerator = value;
+        return true;
+    } else {
+        exact.numerator = NumericBigInt(value);
+        return true;
+    }
+}
+
+std::strong_ordering compareReal(const ExactReal& first, const ExactReal& second)
+{
+    NumericBigInt left = first.numerator * NumericBigInt(static_cast<std::uint64_t>(numericPowerOf10(second.scale)));
+    NumericBigInt right = second.numerator * NumericBigInt(static_cast<std::uint64_t>(numericPowerOf10(first.scale)));
+    const int shift = first.binaryExponent - second.binaryExponent;
+    if (shift > 0) {
+        left *= powerOf2(shift);
+    } else if (shift < 0) {
+        right *= powerOf2(-shift);
+    }
+    return left <=> right;
+}
+
+// Real and imaginary part of a number; false when it is not a finite number
+bool exactParts(const Numeric& numeric, ExactReal& real, ExactReal& imag)
+{
+    return numericVisit(numeric, [&](const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (isComplexValue<T>) {
+            return exactReal(value.real(), real) && exactReal(value.imag(), imag);
+        } else {
+            imag.numerator = NumericBigInt();
+            return exactReal(value, real);
+        }
+    }, "numericSameValue");
+}
+
+// Whether the sort key of `numeric` can stand for its exact value
+bool hasExactSortKey(const Numeric& numeric)
+{
+    if (numeric.kind() == NumericKind::BigInt) {
+        return numericValueOf<NumericKind::BigInt>(numeric).bitLength() <= 64;
+    }
+    return !isDecimalKind(numeric.kind());
+}
+
+} // namespace
+
+
+std::uint64_t Numeric::hash() const
+{
+    return numericVisit(*this, [](const auto& value) { return numericHash(value); }, "hash");
+}
+
+bool numericSameValue(const Numeric& first, const Numeric& second)
+{
+    if (first.kind() == second.kind()) {
+        return numericVisit(first, [&](const auto& value) {
+            using T = std::decay_t<decltype(value)>;
+            return numericSameValue(value, numericValueOf<numericKindOf<T>>(second));
+        }, "numericSameValue");
+    }
+    if (hasExactSortKey(first) && hasExactSortKey(second)) {
+        // Exact keys of equal values differ only in the kind byte
+        const NumericSortKey firstKey = first.sortKey();
+        const NumericSortKey secondKey = second.sortKey();
+        return std::memcmp(firstKey.bytes.data(), secondKey.bytes.data(), NumericSortKey::kindByte) == 0;
+    }
+    ExactReal firstReal, firstImag, secondReal, secondImag;
+    return exactParts(first, firstReal, firstImag) && exactParts(second, secondReal, secondImag) &&
+           compareReal(firstReal, secondReal) == 0 && compareReal(firstImag, secondImag) == 0;
+}
+
+std::strong_ordering numericSortOrder(const Numeric& first, const Numeric& second)
+{
+    const NumericSortKey firstKey = first.sortKey();
+    const NumericSortKey secondKey = second.sortKey();
+    if (std::memcmp(firstKey.bytes.data(), secondKey.bytes.data(), NumericSortKey::kindByte) != 0 ||
+        (hasExactSortKey(first) && hasExactSortKey(second))) {
+        return firstKey <=> secondKey;
+    }
+    // Keys that tie on the value bytes hold two finite numbers, one of them a decimal or a BigInt beyond 64 bits
+    ExactReal firstReal, firstImag, secondReal, secondImag;
+    if (exactParts(first, firstReal, firstImag) && exactParts(second, secondReal, secondImag)) {
+        if (const std::strong_ordering order = compareReal(firstReal, secondReal); order != 0) {
+            return order;
+        }
+        if (const std::strong_ordering order = compareReal(firstImag, secondImag); order != 0) {
+            return order;
+        }
+    }
+    return firstKey <=> secondKey;
+}
@@ -0,0 +1,161 @@
+#include "NumericIndex.hpp"
+
+
+/************************ Bounds ********************************/
+
+namespace {
+
+// Integers and decimals as their position in T's order: the value, or the count of units
+template <typename T>
+NumericInt128 ordinalOf(const T& value)
+{
+    if constexpr (isDecimalValue<T>) {
+        return value.units;
+    } else {
+        return value;
+    }
+}
+
+template <typename T>
+T valueAt(NumericInt128 ordinal)
+{
+    if constexpr (isDecimalValue<T>) {
+        return T::fromUnits(static_cast<typename T::rep_type>(ordinal));
+    } else {
+        return static_cast<T>(ordinal);
+    }
+}
+
+// First value of T in [first, last] that passes, for a test that passes on a suffix and passes at `last`
+template <typename T, typename Pass>
+T firstPassing(T first, T last, const Pass& pass)
+{
+    NumericInt128 low = ordinalOf(first);
+    NumericInt128 high = ordinalOf(last);
+    while (low < high) {
+        const NumericInt128 middle = low + static_cast<NumericInt128>((static_cast<NumericUInt128>(high) - static_cast<NumericUInt128>(low)) / 2);
+        if (pass(valueAt<T>(middle))) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return valueAt<T>(low);
+}
+
+/**
+ * Narrows `bounds` to the values x of T for which NumericClass<T>(x).greaterThanOperation(bound)
+ * (Low) or lessThanOperation(bound) holds, or with `inclusive` that or equalOperation(bound).
+ */
+template <bool Low, typename T, typename B>
+void limit(NumericBounds<T>& bounds, const B& bound, bool inclusive)
+{
+    constexpr NumericKind L = numericKindOf<T>;
+    constexpr NumericKind R = numericKindOf<B>;
+    constexpr NumericOp op = Low ? NumericOp::GreaterThan : NumericOp::LessThan;
+    using Strict = ComparisonKernel<op, L, R>;
+    using Equal = ComparisonKernel<NumericOp::Equal, L, R>;
+
+    if constexpr (Strict::error != NumericError::None) {
+        throw std::runtime_error(numericErrorMessage(op, Strict::error));
+    } else if constexpr (IntegerValue<T> || isDecimalValue<T>) {
+        // The kernels may compare exactly (a decimal, a BigInt), so search for the first and last values that pass
+        const auto pass = [&](const T& value) {
+            bool strict = false;
+            bool equal = false;
+            Strict::apply(value, bound, strict);
+            if (inclusive) {
+                Equal::apply(value, bound, equal);
+            }
+            return strict || equal;
+        };
+        T first;
+        T last;
+        if constexpr (isDecimalValue<T>) {
+            first = T::fromUnits(T::minUnits);
+            last = T::fromUnits(T::maxUnits);
+        } else {
+            first = std::numeric_limits<T>::min();
+            last = std::numeric_limits<T>::max();
+        }
+        if (!pass(Low ? last : first)) {
+            bounds.empty = true;
+            return;
+        }
+        if constexpr (Low) {
+            const T value = firstPassing(first, last, pass);
+            bounds.hasLow = ordinalOf(value) != ordinalOf(first);
+            bounds.low = value;
+            bounds.lowInclusive = true;
+        } else {
+            // The last value that passes is the one before the first that fails
+            const T value = pass(last) ? last : valueAt<T>(ordinalOf(firstPassing(first, last, [&](const T& x) { return !pass(x); })) - 1);
+            bounds.hasHigh = ordinalOf(value) != ordinalOf(last);
+            bounds.high = value;
+            bounds.highInclusive = true;
+        }
+    } else {
+        // The kernels convert the bound to T and compare there
+        T value{};
+        if constexpr (L == R) {
+            value = bound;
+        } else {
+            value = convertValue<L>(bound);
+        }
+        if constexpr (Low) {
+            bounds.hasLow = true;
+            bounds.low = value;
+            bounds.lowInclusive = inclusive;
+        } else {
+            bounds.hasHigh = true;
+            bounds.high = value;
+            bounds.highInclusive = inclusive;
+        }
+    }
+}
+
+} // namespace
+
+
+template <typename T>
+NumericBounds<T> numericBounds(const NumericRange& range)
+{
+    NumericBounds<T> bounds;
+    if (range.low != nullptr) {
+        numericVisit(*range.low, [&](const auto& bound) { limit<true>(bounds, bound, range.lowInclusive); }, "numericBounds");
+    }
+    if (range.high != nullptr) {
+        numericVisit(*range.high, [&](const auto& bound) { limit<false>(bounds, bound, range.highInclusive); }, "numericBounds");
+    }
+    return bounds;
+}
+
+
+#define NUMERIC_INDEX_INSTANTIATE(T) \
+    template NumericBounds<T> numericBounds<T>(const NumericRange&);
+
+NUMERIC_INDEX_INSTANTIATE(int)
+NUMERIC_INDEX_INSTANTIATE(float)
+NUMERIC_INDEX_INSTANTIATE(double)
+NUMERIC_INDEX_INSTANTIATE(long double)
+NUMERIC_INDEX_INSTANTIATE(std::complex<float>)
+NUMERIC_INDEX_INSTANTIATE(std::complex<double>)
+NUMERIC_INDEX_INSTANTIATE(std::complex<long double>)
+NUMERIC_INDEX_INSTANTIATE(char)
+NUMERIC_INDEX_INSTANTIATE(wchar_t)
+NUMERIC_INDEX_INSTANTIATE(char16_t)
+NUMERIC_INDEX_INSTANTIATE(char32_t)
+NUMERIC_INDEX_INSTANTIATE(std::int8_t)
+NUMERIC_INDEX_INSTANTIATE(std::int16_t)
+NUMERIC_INDEX_INSTANTIATE(std::int64_t)
+NUMERIC_INDEX_INSTANTIATE(std::uint8_t)
+NUMERIC_INDEX_INSTANTIATE(std::uint16_t)
+NUMERIC_INDEX_INSTANTIATE(std::uint32_t)
+NUMERIC_INDEX_INSTANTIATE(std::uint64_t)
+NUMERIC_INDEX_INSTANTIATE(NumericDecimal2)
+NUMERIC_INDEX_INSTANTIATE(NumericDecimal6)
+NUMERIC_INDEX_INSTANTIATE(NumericDecimal18)
+NUMERIC_INDEX_INSTANTIATE(NumericFloat16)
+NUMERIC_INDEX_INSTANTIATE(NumericBFloat16)
+
+#undef NUMERIC_INDEX_INSTANTIATE
@@ -0,0 +1,549 @@
+#include "NumericParse.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NUMERIC_PARSE_X86 1
+#include <immintrin.h>
+#else
+#define NUMERIC_PARSE_X86 0
+#endif
+
+
+/************************ NumericParsedColumns ********************************/
+
+std::size_t NumericParsedColumns::size() const
+{
+    return ints.size() + int64s.size() + uint64s.size() + floats.size() + doubles.size() + complexFloats.size() +
+           complexDoubles.size() + chars.size() + char16s.size() + char32s.size();
+}
+
+void NumericParsedColumns::clear()
+{
+    ints.clear();
+    int64s.clear();
+    uint64s.clear();
+    floats.clear();
+    doubles.clear();
+    complexFloats.clear();
+    complexDoubles.clear();
+    chars.clear();
+    char16s.clear();
+    char32s.clear();
+}
+
+/************************ Delimiter scanning ********************************/
+
+namespace {
+
+constexpr std::size_t scanBlock = 64;
+
+// Bit i set when p[i] is the delimiter, '\n' or the quote character
+std::uint64_t scalarStructuralMask(const char* p, std::size_t count, char delimiter, char quote)
+{
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const char c = p[i];
+        mask |= static_cast<std::uint64_t>(c == delimiter || c == '\n' || c == quote) << i;
+    }
+    return mask;
+}
+
+} // namespace
+
+#if NUMERIC_PARSE_X86
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace avx2 {
+
+std::uint64_t structuralMask(const char* p, char delimiter, char quote)
+{
+    const __m256i delimiters = _mm256_set1_epi8(delimiter);
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    const __m256i quotes = _mm256_set1_epi8(quote);
+    auto half = [&](const char* q) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q));
+        const __m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, delimiters), _mm256_cmpeq_epi8(bytes, newlines)),
+                                             _mm256_cmpeq_epi8(bytes, quotes));
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+    };
+    return half(p) | (static_cast<std::uint64_t>(half(p + 32)) << 32);
+}
+
+} // namespace avx2
+
+#pragma GCC pop_options
+
+#endif // NUMERIC_PARSE_X86
+
+namespace {
+
+std::uint64_t structuralMask(const char* p, std::size_t count, char delimiter, char quote, bool simd)
+{
+#if NUMERIC_PARSE_X86
+    if (simd && count == scanBlock) {
+        return avx2::structuralMask(p, delimiter, quote);
+    }
+#else
+    (void)simd;
+#endif
+    return scalarStructuralMask(p, count, delimiter, quote);
+}
+
+/************************ Field parsing ********************************/
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* skipSpaces(const char* first, const char* last)
+{
+    while (first != last && isSpace(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+const char* trimSpaces(const char* first, const char* last)
+{
+    while (last != first && isSpace(last[-1])) {
+        --last;
+    }
+    return last;
+}
+
+// The whole of [first, last) must be the number; from_chars rejects a leading '+', so skip one
+template <typename T>
+bool parseWhole(const char* first, const char* last, T& value)
+{
+    if (last - first > 1 && *first == '+' && first[1] != '-' && first[1] != '+') {
+        ++first;
+    }
+    const std::from_chars_result result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+bool fitsFloat(double value)
+{
+    if (std::isnan(value) || std::isinf(value)) {
+        return true;
+    }
+    return std::fabs(value) <= std::numeric_limits<float>::max() &&
+           static_cast<double>(static_cast<float>(value)) == value;
+}
+
+// Imaginary part text after the sign: "" or "+" -> 1, "-" -> -1
+bool parseImaginary(const char* first, const char* last, double& value)
+{
+    if (first == last || (last - first == 1 && *first == '+')) {
+        value = 1;
+        return true;
+    }
+    if (last - first == 1 && *first == '-') {
+        value = -1;
+        return true;
+    }
+    return parseWhole(first, last, value);
+}
+
+// "a+bi", "a-bi", "bi" and the toString form "(a + bi)"
+bool parseComplex(const char* first, const char* last, std::complex<double>& value)
+{
+    if (*first == '(') {
+        if (last[-1] != ')') {
+            return false;
+        }
+        first = skipSpaces(first + 1, last - 1);
+        last = trimSpaces(first, last - 1);
+    }
+    if (first == last || last[-1] != 'i') {
+        return false;
+    }
+    last = trimSpaces(first, last - 1);
+    if (first == last) {
+        return false;   // a lone "i" is a character
+    }
+
+    // The sign between the parts: not the leading one and not an exponent sign
+    const char* split = nullptr;
+    for (const char* p = first + 1; p < last && !split; ++p) {
+        if (*p != '+' && *p != '-') {
+            continue;
+        }
+        const char* previous = p - 1;
+        while (previous > first && isSpace(*previous)) {
+            --previous;
+        }
+        if (*previous != 'e' && *previous != 'E' && *previous != '+' && *previous != '-') {
+            split = p;
+        }
+    }
+
+    double real = 0;
+    double imaginary = 0;
+    if (!split) {
+        if (!parseImaginary(first, last, imaginary)) {
+            return false;
+        }
+    } else {
+        if (!parseWhole(first, trimSpaces(first, split), real) ||
+            !parseImaginary(skipSpaces(split + 1, last), last, imaginary)) {
+            return false;
+        }
+        if (*split == '-') {
+            imaginary = -imaginary;
+        }
+    }
+    value = std::complex<double>(real, imaginary);
+    return true;
+}
+
+// Exactly one UTF-8 encoded code point of two to four bytes
+bool decodeCodePoint(const char* first, const char* last, char32_t& code)
+{
+    const std::size_t length = static_cast<std::size_t>(last - first);
+    const auto byte = [&](std::size_t i) { return static_cast<unsigned char>(first[i]); };
+    std::size_t expected;
+    if ((byte(0) & 0xE0) == 0xC0) {
+        expected = 2;
+        code = byte(0) & 0x1F;
+    } else if ((byte(0) & 0xF0) == 0xE0) {
+        expected = 3;
+        code = byte(0) & 0x0F;
+    } else if ((byte(0) & 0xF8) == 0xF0) {
+        expected = 4;
+        code = byte(0) & 0x07;
+    } else {
+        return false;
+    }
+    if (length != expected) {
+        return false;
+    }
+    for (std::size_t i = 1; i < length; ++i) {
+        if ((byte(i) & 0xC0) != 0x80) {
+            return false;
+        }
+        code = (code << 6) | (byte(i) & 0x3F);
+    }
+    const char32_t minimum = expected == 2 ? 0x80 : expected == 3 ? 0x800 : 0x10000;
+    return code >= minimum && code <= 0x10FFFF && !(code >= 0xD800 && code <= 0xDFFF);
+}
+
+void append(NumericParsedColumns& out, int value) { out.ints.push_back(value); }
+void append(NumericParsedColumns& out, std::int64_t value) { out.int64s.push_back(value); }
+void append(NumericParsedColumns& out, std::uint64_t value) { out.uint64s.push_back(value); }
+void append(NumericParsedColumns& out, float value) { out.floats.push_back(value); }
+void append(NumericParsedColumns& out, double value) { out.doubles.push_back(value); }
+void append(NumericParsedColumns& out, std::complex<float> value) { out.complexFloats.push_back(value); }
+void append(NumericParsedColumns& out, std::complex<double> value) { out.complexDoubles.push_back(value); }
+void append(NumericParsedColumns& out, char value) { out.chars.push_back(value); }
+void append(NumericParsedColumns& out, char16_t value) { out.char16s.push_back(value); }
+void append(NumericParsedColumns& out, char32_t value) { out.char32s.push_back(value); }
+
+template <typename T>
+void append(std::vector<NumericValue>& out, T value)
+{
+    out.emplace_back(value);
+}
+
+template <typename Out>
+bool appendCharacter(const char* first, const char* last, Out& out)
+{
+    if (last - first == 1) {
+        append(out, *first);
+        return true;
+    }
+    char32_t code;
+    if (!decodeCodePoint(first, last, code)) {
+        return false;
+    }
+    if (code <= 0xFFFF) {
+        append(out, static_cast<char16_t>(code));
+    } else {
+        append(out, code);
+    }
+    return true;
+}
+
+// `field` is trimmed and not empty
+template <typename Out>
+bool appendField(const char* first, const char* last, bool narrowFloats, bool quoting, Out& out)
+{
+    if (quoting && *first == '"') {
+        // Quoted character: "" inside stands for one '"'
+        if (last - first < 3 || last[-1] != '"') {
+            return false;
+        }
+        char text[4];
+        std::size_t length = 0;
+        for (const char* p = first + 1; p < last - 1; ++p) {
+            if (*p == '"' && (++p == last - 1 || *p != '"')) {
+                return false;
+            }
+            if (length == sizeof(text)) {
+                return false;
+            }
+            text[length++] = *p;
+        }
+        return appendCharacter(text, text + length, out);
+    }
+
+    // Cheap classification first: single characters and plain integers skip the other parsers
+    if (last - first == 1 && !isDigit(*first)) {
+        append(out, *first);
+        return true;
+    }
+    const char* digits = first + (*first == '-' || *first == '+');
+    if (digits != last && std::all_of(digits, last, isDigit)) {
+        int integer;
+        if (parseWhole(first, last, integer)) {
+            append(out, integer);
+            return true;
+        }
+        std::int64_t wide;
+        if (parseWhole(first, last, wide)) {
+            append(out, wide);
+            return true;
+        }
+        std::uint64_t unsignedWide;
+        if (*first != '-' && parseWhole(first, last, unsignedWide)) {
+            append(out, unsignedWide);
+            return true;
+        }
+    }
+    double real;
+    if (last[-1] != 'i' && last[-1] != ')' && parseWhole(first, last, real)) {
+        if (narrowFloats && fitsFloat(real)) {
+            append(out, static_cast<float>(real));
+        } else {
+            append(out, real);
+        }
+        return true;
+    }
+    std::complex<double> complex;
+    if (parseComplex(first, last, complex)) {
+        if (narrowFloats && fitsFloat(complex.real()) && fitsFloat(complex.imag())) {
+            append(out, std::complex<float>(complex));
+        } else {
+            append(out, complex);
+        }
+        return true;
+    }
+    return appendCharacter(first, last, out);
+}
+
+// Index of the quote closing a quoted field opened before `from`; npos if the data ends first
+std::size_t closingQuote(const char* data, std::size_t from, std::size_t size, bool final)
+{
+    for (std::size_t i = from; i < size; ++i) {
+        if (data[i] != '"') {
+            continue;
+        }
+        if (i + 1 == size && !final) {
+            return std::string::npos;   // could still be the first half of ""
+        }
+        if (i + 1 < size && data[i + 1] == '"') {
+            ++i;
+            continue;
+        }
+        return i;
+    }
+    return std::string::npos;
+}
+
+} // namespace
+
+/************************ NumericTextParser Class ********************************/
+
+template <typename Out>
+void NumericTextParser::parseField(const char* first, const char* last, Out& out)
+{
+    first = skipSpaces(first, last);
+    last = trimSpaces(first, last);
+    if (first == last) {
+        return;
+    }
+    if (static_cast<std::size_t>(last - first) <= numericParseMaxField && appendField(first, last, options.narrowFloats, quoting(), out)) {
+        ++counters.fields;
+        return;
+    }
+    if (!options.skipInvalid) {
+        throw std::runtime_error("parse: Invalid field \"" + std::string(first, std::min(last, first + 32)) + "\".");
+    }
+    ++counters.invalid;
+}
+
+// Parses the fields of [data, data + size); returns where the unfinished last field starts
+template <typename Out>
+std::size_t NumericTextParser::scan(const char* data, std::size_t size, bool final, Out& out)
+{
+    const bool simd = numericSimdLevel() != NumericSimdLevel::Scalar;
+    const char quote = quoting() ? '"' : '\n';
+    std::size_t fieldStart = 0;
+    std::size_t skipUntil = 0;
+
+    for (std::size_t block = 0; block < size; block += scanBlock) {
+        std::uint64_t mask = structuralMask(data + block, std::min(scanBlock, size - block), options.delimiter, quote, simd);
+        while (mask != 0) {
+            const std::size_t position = block + static_cast<std::size_t>(std::countr_zero(mask));
+            mask &= mask - 1;
+            if (position < skipUntil) {
+                continue;
+            }
+            if (data[position] == '"') {
+                // Only a quote that opens the field starts a quoted field
+                if (skipSpaces(data + fieldStart, data + position) != data + position) {
+                    continue;
+                }
+                const std::size_t close = closingQuote(data, position + 1, size, final);
+                if (close == std::string::npos) {
+                    if (!final) {
+                        return fieldStart;
+                    }
+                    skipUntil = size;
+                    continue;
+                }
+                skipUntil = close + 1;
+                continue;
+            }
+            parseField(data + fieldStart, data + position, out);
+            fieldStart = position + 1;
+        }
+    }
+
+    if (final && fieldStart < size) {
+        parseField(data + fieldStart, data + size, out);
+        fieldStart = size;
+    }
+    return fieldStart;
+}
+
+void NumericTextParser::keep(const char* first, const char* last)
+{
+    if (static_cast<std::size_t>(last - first) > numericParseMaxField) {
+        throw std::runtime_error("parse: Field is too long.");
+    }
+    pending.assign(first, last);
+}
+
+template <typename Out>
+void NumericTextParser::parseChunk(std::string_view chunk, Out& out)
+{
+    counters.bytes += chunk.size();
+    std::size_t start = 0;
+
+    if (!pending.empty()) {
+        // Finish the carried field with the start of this chunk; the field ends within
+        // numericParseMaxField + 1 bytes or is too long anyway
+        const std::size_t carried = pending.size();
+        const std::size_t take = std::min(chunk.size(), numericParseMaxField + 1);
+        pending.append(chunk.data(), take);
+        const std::size_t consumed = scan(pending.data(), pending.size(), false, out);
+        if (consumed <= carried) {
+            if (take < chunk.size()) {
+                throw std::runtime_error("parse: Field is too long.");
+            }
+            std::string rest = pending.substr(consumed);
+            keep(rest.data(), rest.data() + rest.size());
+            return;
+        }
+        start = consumed - carried;
+        pending.clear();
+    }
+
+    const std::size_t consumed = start + scan(chunk.data() + start, chunk.size() - start, false, out);
+    keep(chunk.data() + consumed, chunk.data() + chunk.size());
+}
+
+template <typename Out>
+void NumericTextParser::finishInput(Out& out)
+{
+    if (!pending.empty()) {
+        scan(pending.data(), pending.size(), true, out);
+        pending.clear();
+    }
+}
+
+void NumericTextParser::parse(std::string_view chunk, NumericParsedColumns& out)
+{
+    parseChunk(chunk, out);
+}
+
+void NumericTextParser::parse(std::string_view chunk, std::vector<NumericValue>& out)
+{
+    parseChunk(chunk, out);
+}
+
+void NumericTextParser::finish(NumericParsedColumns& out)
+{
+    finishInput(out);
+}
+
+void NumericTextParser::finish(std::vector<NumericValue>& out)
+{
+    finishInput(out);
+}
+
+/************************ Streams ********************************/
+
+NumericParseStats numericParseStream(std::FILE* file, const std::function<void(NumericParsedColumns&)>& onBatch,
+                                     NumericParseOptions options)
+{
+    NumericTextParser parser(options);
+    NumericParsedColumns columns;
+    std::vector<char> buffer(std::max<std::size_t>(options.chunkSize, 1));
+
+    std::size_t read;
+    while ((read = std::fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+        parser.parse(std::string_view(buffer.data(), read), columns);
+        if (columns.size() != 0) {
+            onBatch(columns);
+            columns.clear();
+        }
+    }
+    if (std::ferror(file)) {
+        throw std::runtime_error("numericParseStream: Read failed.");
+    }
+    parser.finish(columns);
+    if (columns.size() != 0) {
+        onBatch(columns);
+    }
+    return parser.stats();
+}
+
+NumericParseStats numericParseStream(std::istream& stream, const std::function<void(NumericParsedColumns&)>& onBatch,
+                                     NumericParseOptions options)
+{
+    NumericTextParser parser(options);
+    NumericParsedColumns columns;
+    std::vector<char> buffer(std::max<std::size_t>(options.chunkSize, 1));
+
+    while (stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || stream.gcount() > 0) {
+        parser.parse(std::string_view(buffer.data(), static_cast<std::size_t>(stream.gcount())), columns);
+        if (columns.size() != 0) {
+            onBatch(columns);
+            columns.clear();
+        }
+    }
+    if (stream.bad()) {
+        throw std::runtime_error("numericParseStream: Read failed.");
+    }
+    parser.finish(columns);
+    if (columns.size() != 0) {
+        onBatch(columns);
+    }
+    return parser.stats();
+}
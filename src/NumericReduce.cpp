@@ -0,0 +1,1146 @@
+#include "NumericReduce.hpp"
+#include "NumericHash.hpp"
+#include "NumericParallel.hpp"
+#include "NumericSort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+
+/************************ Chunked evaluation ********************************/
+
+namespace {
+
+// Interleaved running sums per chunk in Plain mode, and leaf size of the pairwise recursion
+constexpr std::size_t lanes = 8;
+constexpr std::size_t pairwiseBlock = 128;
+
+// Exact integer totals: wide enough for any count of 64-bit values that fits in memory
+__extension__ using IntegerTotal = __int128;
+
+/**
+ * Reduces [0, count) one chunk at a time; partials[c] = chunk(first, last) of chunk c.
+ * Threads take contiguous runs of chunks, so the partials (and everything computed
+ * from them in chunk order) do not depend on the thread count.
+ */
+template <typename Partial, typename Chunk>
+std::vector<Partial> reduceChunks(std::size_t count, const NumericReduceOptions& options, const Chunk& chunk)
+{
+    const std::size_t chunkSize = std::max<std::size_t>(options.chunkSize, 1);
+    const std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+    std::vector<Partial> partials(chunks);
+    const std::size_t threads = numericThreadCount(options.threads, chunks);
+    numericParallelFor(threads, [&](std::size_t t) {
+        for (std::size_t c = chunks * t / threads; c < chunks * (t + 1) / threads; ++c) {
+            partials[c] = chunk(c * chunkSize, std::min(count, (c + 1) * chunkSize));
+        }
+    });
+    return partials;
+}
+
+/************************ Sums and products ********************************/
+
+// -0.0 is the identity of IEEE addition (+0.0 would turn a sum of -0.0 into +0.0)
+template <typename T>
+T zero()
+{
+    if constexpr (isComplexValue<T>) {
+        using Part = typename T::value_type;
+        return T(Part(-0.0), Part(-0.0));
+    } else {
+        return T(-0.0);
+    }
+}
+
+template <typename T, typename Load>
+T plainSum(const Load& load, std::size_t first, std::size_t last)
+{
+    std::array<T, lanes> partial;
+    partial.fill(zero<T>());
+    std::size_t i = first;
+    for (; i + lanes <= last; i += lanes) {
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            partial[lane] += load(i + lane);
+        }
+    }
+    for (std::size_t lane = 0; i < last; ++i, ++lane) {
+        partial[lane] += load(i);
+    }
+    T total = zero<T>();
+    for (const T& value : partial) {
+        total += value;
+    }
+    return total;
+}
+
+template <typename T, typename Load>
+T pairwiseSum(const Load& load, std::size_t first, std::size_t last)
+{
+    if (last - first <= pairwiseBlock) {
+        T total = zero<T>();
+        for (std::size_t i = first; i < last; ++i) {
+            total += load(i);
+        }
+        return total;
+    }
+    const std::size_t middle = first + (last - first) / 2;
+    return pairwiseSum<T>(load, first, middle) + pairwiseSum<T>(load, middle, last);
+}
+
+// Neumaier's variant of Kahan summation: also exact when an addend is larger than the sum
+template <typename F>
+struct CompensatedReal
+{
+    F sum = F(-0.0);
+    F correction = 0;
+
+    void add(F value)
+    {
+        const F next = sum + value;
+        correction += std::abs(sum) >= std::abs(value) ? (sum - next) + value : (value - next) + sum;
+        sum = next;
+    }
+    F value() const
+    {
+        return (correction == 0 || !std::isfinite(sum)) ? sum : sum + correction;
+    }
+};
+
+template <typename T>
+struct CompensatedSum
+{
+    CompensatedReal<T> part;
+
+    void add(T value) { part.add(value); }
+    void merge(const CompensatedSum& other)
+    {
+        part.add(other.part.sum);
+        part.add(other.part.correction);
+    }
+    T value() const { return part.value(); }
+};
+
+template <typename F>
+struct CompensatedSum<std::complex<F>>
+{
+    CompensatedReal<F> real;
+    CompensatedReal<F> imag;
+
+    void add(std::complex<F> value)
+    {
+        real.add(value.real());
+        imag.add(value.imag());
+    }
+    void merge(const CompensatedSum& other)
+    {
+        real.add(other.real.sum);
+        real.add(other.real.correction);
+        imag.add(other.imag.sum);
+        imag.add(other.imag.correction);
+    }
+    std::complex<F> value() const { return std::complex<F>(real.value(), imag.value()); }
+};
+
+template <typename T>
+T pairwiseCombine(const std::vector<T>& partials, std::size_t first, std::size_t last)
+{
+    if (last - first == 1) {
+        return partials[first];
+    }
+    const std::size_t middle = first + (last - first) / 2;
+    return pairwiseCombine(partials, first, middle) + pairwiseCombine(partials, middle, last);
+}
+
+/**
+ * Exact total of integer values (any width, characters). Values narrower than 64 bits add
+ * up in a long long, which 2^31 of them cannot overflow. 64-bit values are added as two
+ * unsigned 32-bit halves plus a count of negative values, all in 64-bit lanes the loop
+ * vectorizes, instead of one 128-bit add with carry per value.
+ */
+template <typename T, typename Load>
+IntegerTotal integerTotal(std::size_t count, const Load& load, const NumericReduceOptions& options)
+{
+    constexpr std::size_t runningBlock = std::size_t(1) << 31;
+
+    const auto partials = reduceChunks<IntegerTotal>(count, options, [&](std::size_t first, std::size_t last) {
+        IntegerTotal total = 0;
+        for (std::size_t block = first; block < last; block += runningBlock) {
+            const std::size_t end = block + std::min(runningBlock, last - block);
+            if constexpr (sizeof(T) < 8) {
+                long long running = 0;
+                for (std::size_t i = block; i < end; ++i) {
+                    running += static_cast<long long>(load(i));
+                }
+                total += running;
+            } else {
+                std::uint64_t low = 0;
+                std::uint64_t high = 0;
+                std::uint64_t negatives = 0;
+                for (std::size_t i = block; i < end; ++i) {
+                    const std::uint64_t bits = static_cast<std::uint64_t>(load(i));
+                    low += bits & 0xFFFFFFFF;
+                    high += bits >> 32;
+                    negatives += std::is_signed_v<T> ? bits >> 63 : 0;
+                }
+                total += static_cast<IntegerTotal>(high) * (IntegerTotal(1) << 32) + static_cast<IntegerTotal>(low) -
+                         static_cast<IntegerTotal>(negatives) * (static_cast<IntegerTotal>(1) << 64);
+            }
+        }
+        return total;
+    });
+    IntegerTotal total = 0;
+    for (IntegerTotal partial : partials) {
+        total += partial;
+    }
+    return total;
+}
+
+// Exact sum of 128-bit decimal units, high * 2^128 + low, which no count of them can overflow
+struct WideTotal
+{
+    NumericUInt128 low = 0;
+    std::int64_t high = 0;
+
+    void add(NumericInt128 value)
+    {
+        const NumericUInt128 next = low + static_cast<NumericUInt128>(value);
+        high += static_cast<std::int64_t>(next < low) - static_cast<std::int64_t>(value < 0);
+        low = next;
+    }
+    void merge(const WideTotal& other)
+    {
+        const NumericUInt128 next = low + other.low;
+        high += static_cast<std::int64_t>(next < low) + other.high;
+        low = next;
+    }
+    bool fits() const { return high == -static_cast<std::int64_t>(low >> 127); }
+};
+
+// An exact decimal result (exact fits in 128 bits) brought into T under the thread's overflow policy
+template <typename T>
+T decimalResult(NumericOp op, NumericInt128 exact, bool fits, bool negative)
+{
+    using Rep = typename T::rep_type;
+    if (fits && exact >= T::minUnits && exact <= T::maxUnits) {
+        return T::fromUnits(static_cast<Rep>(exact));
+    }
+    switch (numericOverflowMode()) {
+        case NumericOverflow::Wrap:     return T::fromUnits(static_cast<Rep>(exact));
+        case NumericOverflow::Saturate: return T::fromUnits(negative ? T::minUnits : T::maxUnits);
+        default:
+            throw std::runtime_error(numericErrorMessage(op, NumericError::Overflow));
+    }
+}
+
+template <typename T, typename Load>
+T decimalSum(std::size_t count, const Load& load, const NumericReduceOptions& options)
+{
+    if constexpr (sizeof(typename T::rep_type) == 8) {
+        const IntegerTotal exact = integerTotal<std::int64_t>(count, [&](std::size_t i) { return load(i).units; }, options);
+        return decimalResult<T>(NumericOp::Sum, exact, true, exact < 0);
+    } else {
+        const auto partials = reduceChunks<WideTotal>(count, options, [&](std::size_t first, std::size_t last) {
+            WideTotal total;
+            for (std::size_t i = first; i < last; ++i) {
+                total.add(load(i).units);
+            }
+            return total;
+        });
+        WideTotal total;
+        for (const WideTotal& partial : partials) {
+            total.merge(partial);
+        }
+        return decimalResult<T>(NumericOp::Sum, static_cast<NumericInt128>(total.low), total.fits(), total.high < 0);
+    }
+}
+
+// Decimal product of a chunk; kernels report errors instead of throwing, so workers keep the first one
+template <typename T>
+struct DecimalProduct
+{
+    T value;
+    NumericError error = NumericError::None;
+
+    void multiply(const T& factor, NumericOverflow overflow)
+    {
+        if (error == NumericError::None) {
+            error = ArithmeticKernel<NumericOp::Multiply, numericKindOf<T>, numericKindOf<T>>::apply(value, factor, value, overflow);
+        }
+    }
+    void merge(const DecimalProduct& other, NumericOverflow overflow)
+    {
+        if (other.error != NumericError::None) {
+            error = error != NumericError::None ? error : other.error;
+        }
+        multiply(other.value, overflow);
+    }
+};
+
+/**
+ * Integer product of a chunk: the low 64 bits of the exact product, plus its sign and
+ * magnitude. Magnitudes never shrink (every factor is 0 or at least 1 in absolute value),
+ * so once one no longer fits 64 bits, only a zero factor can bring the product back.
+ */
+struct IntegerProduct
+{
+    std::uint64_t wrapped = 1;
+    std::uint64_t magnitude = 1;
+    bool huge = false;
+    bool negative = false;
+    bool zero = false;
+
+    void multiply(std::uint64_t bits, std::uint64_t factorMagnitude, bool factorNegative, bool factorHuge = false)
+    {
+        wrapped *= bits;
+        huge |= factorHuge | __builtin_mul_overflow(magnitude, factorMagnitude, &magnitude);
+        negative ^= factorNegative;
+        zero |= factorMagnitude == 0;
+    }
+    void merge(const IntegerProduct& other) { multiply(other.wrapped, other.magnitude, other.negative, other.huge); }
+};
+
+template <typename T>
+T integerProductResult(const IntegerProduct& product)
+{
+    using Limits = std::numeric_limits<T>;
+    if (product.zero) {
+        return T(0);
+    }
+    const std::uint64_t limit = product.negative ? std::uint64_t(0) - static_cast<std::uint64_t>(static_cast<std::int64_t>(Limits::min()))
+                                                 : static_cast<std::uint64_t>(Limits::max());
+    if (!product.huge && product.magnitude <= limit) {
+        return static_cast<T>(product.wrapped);
+    }
+    switch (numericOverflowMode()) {
+        case NumericOverflow::Wrap:     return static_cast<T>(product.wrapped);
+        case NumericOverflow::Saturate: return product.negative ? Limits::min() : Limits::max();
+        default:
+            throw std::runtime_error(numericErrorMessage(NumericOp::Multiply, NumericError::Overflow));
+    }
+}
+
+template <typename T, typename Load>
+T floatingSum(std::size_t count, const Load& load, const NumericReduceOptions& options)
+{
+    switch (options.summation) {
+        case NumericSummation::Kahan: {
+            const auto partials = reduceChunks<CompensatedSum<T>>(count, options, [&](std::size_t first, std::size_t last) {
+                CompensatedSum<T> sum;
+                for (std::size_t i = first; i < last; ++i) {
+                    sum.add(load(i));
+                }
+                return sum;
+            });
+            CompensatedSum<T> total;
+            for (const auto& partial : partials) {
+                total.merge(partial);
+            }
+            return total.value();
+        }
+        case NumericSummation::Pairwise: {
+            const auto partials = reduceChunks<T>(count, options, [&](std::size_t first, std::size_t last) {
+                return pairwiseSum<T>(load, first, last);
+            });
+            return pairwiseCombine(partials, 0, partials.size());
+        }
+        default: {
+            const auto partials = reduceChunks<T>(count, options, [&](std::size_t first, std::size_t last) {
+                return plainSum<T>(load, first, last);
+            });
+            T total = zero<T>();
+            for (const T& partial : partials) {
+                total += partial;
+            }
+            return total;
+        }
+    }
+}
+
+// Exact sum of BigInt values, chunk partials added in chunk order
+template <typename Load>
+NumericBigInt bigIntTotal(std::size_t count, const Load& load, const NumericReduceOptions& options)
+{
+    const auto partials = reduceChunks<NumericBigInt>(count, options, [&](std::size_t first, std::size_t last) {
+        NumericBigInt total;
+        for (std::size_t i = first; i < last; ++i) {
+            total += load(i);
+        }
+        return total;
+    });
+    NumericBigInt total;
+    for (const NumericBigInt& partial : partials) {
+        total += partial;
+    }
+    return total;
+}
+
+// Product tree: factors of similar size meet at every level, which is where Karatsuba and Toom-3 pay off
+template <typename Load>
+NumericBigInt bigIntProduct(const Load& load, std::size_t first, std::size_t last)
+{
+    if (last - first <= lanes) {
+        NumericBigInt product = 1;
+        for (std::size_t i = first; i < last; ++i) {
+            product *= load(i);
+        }
+        return product;
+    }
+    const std::size_t middle = first + (last - first) / 2;
+    return bigIntProduct(load, first, middle) * bigIntProduct(load, middle, last);
+}
+
+// Sum with the semantics of the T + T kernel; `count` > 0
+template <typename T, typename Load>
+T sumValues(std::size_t count, const Load& load, const NumericReduceOptions& options)
+{
+    if constexpr (std::is_same_v<T, NumericBigInt>) {
+        return bigIntTotal(count, load, options);
+    } else if constexpr (isDecimalValue<T>) {
+        return decimalSum<T>(count, load, options);
+    } else if constexpr (isHalfValue<T>) {
+        return T(floatingSum<float>(count, [&](std::size_t i) { return load(i).toFloat(); }, options));
+    } else if constexpr (IntegerValue<T>) {
+        return numericIntegerResult<T>(NumericOp::Sum, integerTotal<T>(count, load, options));
+    } else if constexpr (charTemp<T>) {
+        // charNumeric keeps each partial sum in the ASCII range; a single value is left untouched
+        return count == 1 ? load(0) : static_cast<T>(integerTotal<T>(count, load, options) & 0x7F);
+    } else {
+        return floatingSum<T>(count, load, options);
+    }
+}
+
+template <typename T, typename Load>
+T productValues(std::size_t count, const Load& load, const NumericReduceOptions& options)
+{
+    if constexpr (charTemp<T>) {
+        throw std::runtime_error(numericErrorMessage(NumericOp::Multiply, NumericError::UnsupportedCharOperation));
+    } else if constexpr (std::is_same_v<T, NumericBigInt>) {
+        const auto partials = reduceChunks<NumericBigInt>(count, options, [&](std::size_t first, std::size_t last) {
+            return bigIntProduct(load, first, last);
+        });
+        return bigIntProduct([&](std::size_t c) -> const NumericBigInt& { return partials[c]; }, 0, partials.size());
+    } else if constexpr (isDecimalValue<T>) {
+        // Rounded after every factor, in chunk order; the workers take the calling thread's policies
+        const NumericOverflow overflow = numericOverflowMode();
+        const NumericRounding rounding = numericRoundingMode();
+        const auto partials = reduceChunks<DecimalProduct<T>>(count, options, [&](std::size_t first, std::size_t last) {
+            NumericRoundingScope scope(rounding);
+            DecimalProduct<T> product{load(first)};
+            for (std::size_t i = first + 1; i < last; ++i) {
+                product.multiply(load(i), overflow);
+            }
+            return product;
+        });
+        DecimalProduct<T> product = partials[0];
+        for (std::size_t c = 1; c < partials.size(); ++c) {
+            product.merge(partials[c], overflow);
+        }
+        if (product.error != NumericError::None) {
+            throw std::runtime_error(numericErrorMessage(NumericOp::Multiply, product.error));
+        }
+        return product.value;
+    } else if constexpr (isHalfValue<T>) {
+        return T(productValues<float>(count, [&](std::size_t i) { return load(i).toFloat(); }, options));
+    } else if constexpr (IntegerValue<T>) {
+        const auto partials = reduceChunks<IntegerProduct>(count, options, [&](std::size_t first, std::size_t last) {
+            IntegerProduct product;
+            for (std::size_t i = first; i < last; ++i) {
+                const T value = load(i);
+                const bool negative = value < 0;
+                const std::uint64_t bits = static_cast<std::uint64_t>(value);
+                product.multiply(bits, negative ? std::uint64_t(0) - bits : bits, negative);
+            }
+            return product;
+        });
+        IntegerProduct product;
+        for (const IntegerProduct& partial : partials) {
+            product.merge(partial);
+        }
+        return integerProductResult<T>(product);
+    } else {
+        const auto partials = reduceChunks<T>(count, options, [&](std::size_t first, std::size_t last) {
+            std::array<T, lanes> partial;
+            partial.fill(T(1));
+            std::size_t i = first;
+            for (; i + lanes <= last; i += lanes) {
+                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                    partial[lane] *= load(i + lane);
+                }
+            }
+            for (std::size_t lane = 0; i < last; ++i, ++lane) {
+                partial[lane] *= load(i);
+            }
+            T product(1);
+            for (const T& value : partial) {
+                product *= value;
+            }
+            return product;
+        });
+        T product(1);
+        for (const T& partial : partials) {
+            product *= partial;
+        }
+        return product;
+    }
+}
+
+template <typename T, typename Load>
+NumericMeanType<T> meanValues(std::size_t count, const Load& load, const NumericReduceOptions& options)
+{
+    if constexpr (charTemp<T>) {
+        throw std::runtime_error(numericErrorMessage(NumericOp::Divide, NumericError::UnsupportedCharOperation));
+    } else if constexpr (std::is_same_v<T, NumericBigInt>) {
+        return static_cast<double>(static_cast<long double>(bigIntTotal(count, load, options)) / static_cast<long double>(count));
+    } else if constexpr (isDecimalValue<T>) {
+        T mean;
+        decimalArithmetic<NumericOp::Divide>(decimalSum<T>(count, load, options), static_cast<std::uint64_t>(count), mean,
+                                             NumericOverflow::Checked, numericRoundingMode());
+        return mean;
+    } else if constexpr (isHalfValue<T>) {
+        return T(floatingSum<float>(count, [&](std::size_t i) { return load(i).toFloat(); }, options) / static_cast<float>(count));
+    } else if constexpr (IntegerValue<T>) {
+        return static_cast<double>(integerTotal<T>(count, load, options)) / static_cast<double>(count);
+    } else if constexpr (isComplexValue<T>) {
+        return floatingSum<T>(count, load, options) / static_cast<typename T::value_type>(count);
+    } else {
+        return floatingSum<T>(count, load, options) / static_cast<T>(count);
+    }
+}
+
+/************************ Min / max ********************************/
+
+// NaN after everything, all NaNs equal, -0.0 == +0.0: the NumericSortKey order
+template <typename F>
+bool realBefore(F first, F second)
+{
+    return first < second || (std::isnan(second) && !std::isnan(first));
+}
+
+template <typename F>
+bool realSame(F first, F second)
+{
+    return first == second || (std::isnan(first) && std::isnan(second));
+}
+
+template <typename T>
+bool valueBefore(const T& first, const T& second)
+{
+    if constexpr (charTemp<T>) {
+        return static_cast<std::make_unsigned_t<T>>(first) < static_cast<std::make_unsigned_t<T>>(second);
+    } else if constexpr (isComplexValue<T>) {
+        return realBefore(first.real(), second.real()) ||
+               (realSame(first.real(), second.real()) && realBefore(first.imag(), second.imag()));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return realBefore(first, second);
+    } else if constexpr (isHalfValue<T>) {
+        return realBefore(first.toFloat(), second.toFloat());
+    } else {
+        return first < second;
+    }
+}
+
+// Index of the first minimum (Max = false) or maximum (Max = true) under `before`
+template <bool Max, typename Before>
+std::size_t extremeIndex(std::size_t count, const NumericReduceOptions& options, const Before& before)
+{
+    const auto partials = reduceChunks<std::size_t>(count, options, [&](std::size_t first, std::size_t last) {
+        std::size_t best = first;
+        for (std::size_t i = first + 1; i < last; ++i) {
+            if (Max ? before(best, i) : before(i, best)) {
+                best = i;
+            }
+        }
+        return best;
+    });
+    std::size_t best = partials[0];
+    for (std::size_t partial : partials) {
+        if (Max ? before(best, partial) : before(partial, best)) {
+            best = partial;
+        }
+    }
+    return best;
+}
+
+/************************ Numeric collections ********************************/
+
+// A state is a kind, "nothing yet", or one of the NumericError values (sticky)
+constexpr std::size_t emptyState = numericKindCount;
+constexpr std::size_t foldStateCount = numericKindCount + 6;
+
+constexpr std::size_t errorState(NumericError error)
+{
+    return emptyState + 1 + static_cast<std::size_t>(error);
+}
+
+using FoldTable = std::array<std::array<std::uint8_t, numericKindCount>, foldStateCount>;
+using FoldMap = std::array<std::uint8_t, foldStateCount>;
+
+// Kind of acc after acc = acc op value, for every (kind of acc, kind of value)
+constexpr FoldTable makeFoldTable(NumericOp op)
+{
+    FoldTable table{};
+    for (std::size_t state = 0; state < foldStateCount; ++state) {
+        for (std::size_t kind = 0; kind < numericKindCount; ++kind) {
+            std::size_t next = state;
+            if (state == emptyState) {
+                next = kind;
+            } else if (state < emptyState) {
+                const NumericRule rule = arithmeticRule(NumericKind(state), NumericKind(kind), op);
+                next = rule.error == NumericError::None ? static_cast<std::size_t>(rule.result) : errorState(rule.error);
+            }
+            table[state][kind] = static_cast<std::uint8_t>(next);
+        }
+    }
+    return table;
+}
+
+// Once something is accumulated, folding the same kind again changes nothing more
+constexpr bool isIdempotent(const FoldTable& table)
+{
+    for (std::size_t state = 0; state < foldStateCount; ++state) {
+        if (state == emptyState) {
+            continue;
+        }
+        for (std::size_t kind = 0; kind < numericKindCount; ++kind) {
+            if (table[table[state][kind]][kind] != table[state][kind]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+constexpr FoldTable sumFold = makeFoldTable(NumericOp::Sum);
+constexpr FoldTable productFold = makeFoldTable(NumericOp::Multiply);
+static_assert(isIdempotent(sumFold) && isIdempotent(productFold), "runs of one kind must fold in two steps");
+
+/**
+ * Kind an op loop over `values` ends with. Each chunk computes where it sends every
+ * possible incoming state, so the chunks are scanned in parallel and composed in order.
+ * Only the first two values of a run of one kind can change the state (the second one
+ * matters when the run starts from nothing: char * char).
+ */
+NumericKind foldKind(const std::vector<std::unique_ptr<Numeric>>& values, NumericOp op, const NumericReduceOptions& options)
+{
+    const FoldTable& table = op == NumericOp::Sum ? sumFold : productFold;
+    const auto maps = reduceChunks<FoldMap>(values.size(), options, [&](std::size_t first, std::size_t last) {
+        FoldMap map;
+        for (std::size_t state = 0; state < foldStateCount; ++state) {
+            map[state] = static_cast<std::uint8_t>(state);
+        }
+        NumericKind previous = NumericKind::Count;
+        std::size_t run = 0;
+        for (std::size_t i = first; i < last; ++i) {
+            const NumericKind kind = values[i]->kind();
+            run = kind == previous ? run + 1 : 0;
+            previous = kind;
+            if (run > 1) {
+                continue;
+            }
+            for (auto& state : map) {
+                state = table[state][static_cast<std::size_t>(kind)];
+            }
+        }
+        return map;
+    });
+
+    std::size_t state = emptyState;
+    for (const FoldMap& map : maps) {
+        state = map[state];
+    }
+    if (state > emptyState) {
+        throw std::runtime_error(numericErrorMessage(op, static_cast<NumericError>(state - emptyState - 1)));
+    }
+    return NumericKind(state);
+}
+
+template <NumericKind To>
+using Loader = NumericKindValue<To> (*)(const Numeric&);
+
+template <NumericKind To, NumericKind From>
+NumericKindValue<To> loadAs(const Numeric& value)
+{
+    return convertValue<To>(numericValueOf<From>(value));
+}
+
+// Characters only ever accumulate with their own kind and BigInt never meets a decimal (the fold rejects the rest)
+template <NumericKind To, NumericKind From>
+constexpr Loader<To> loaderOf()
+{
+    constexpr bool bigIntAndDecimal = (To == NumericKind::BigInt && isDecimalKind(From)) || (isDecimalKind(To) && From == NumericKind::BigInt);
+    if constexpr ((!isCharKind(To) || To == From) && !bigIntAndDecimal) {
+        return &loadAs<To, From>;
+    } else {
+        return nullptr;
+    }
+}
+
+template <NumericKind To, std::size_t... From>
+constexpr std::array<Loader<To>, numericKindCount> makeLoaders(std::index_sequence<From...>)
+{
+    return {loaderOf<To, NumericKind(From)>()...};
+}
+
+template <typename T>
+std::unique_ptr<Numeric> box(const T& value)
+{
+    return std::make_unique<NumericClass<numericKindOf<T>>>(value);
+}
+
+std::unique_ptr<Numeric> copyOf(const Numeric& value)
+{
+    return numericVisit(value, [](const auto& stored) { return box(stored); }, "reduce");
+}
+
+void requireValues(std::size_t count, const char* name)
+{
+    if (count == 0) {
+        throw std::runtime_error(std::string(name) + ": No values to reduce.");
+    }
+}
+
+enum class Reduction : std::uint8_t { Sum, Product, Mean };
+
+std::unique_ptr<Numeric> reduceValues(const std::vector<std::unique_ptr<Numeric>>& values, Reduction reduction,
+                                      const NumericReduceOptions& options)
+{
+    const NumericOp op = reduction == Reduction::Product ? NumericOp::Multiply : NumericOp::Sum;
+    const NumericKind kind = foldKind(values, op, options);
+    if (values.size() == 1 && reduction != Reduction::Mean) {
+        return copyOf(*values[0]);
+    }
+
+    return numericVisitKind(kind, [&]<NumericKind K>() -> std::unique_ptr<Numeric> {
+        using T = NumericKindValue<K>;
+        static constexpr std::array<Loader<K>, numericKindCount> loaders = makeLoaders<K>(std::make_index_sequence<numericKindCount>{});
+        const auto load = [&](std::size_t i) {
+            const Numeric& value = *values[i];
+            return loaders[static_cast<std::size_t>(value.kind())](value);
+        };
+        switch (reduction) {
+            case Reduction::Sum:     return box(sumValues<T>(values.size(), load, options));
+            case Reduction::Product: return box(productValues<T>(values.size(), load, options));
+            default:                 return box(meanValues<T>(values.size(), load, options));
+        }
+    }, "reduce");
+}
+
+template <bool Max>
+std::unique_ptr<Numeric> extremeValue(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options)
+{
+    const std::size_t best = extremeIndex<Max>(values.size(), options, [&](std::size_t first, std::size_t second) {
+        return numericSortOrder(*values[first], *values[second]) < 0;
+    });
+    return copyOf(*values[best]);
+}
+
+} // namespace
+
+
+std::unique_ptr<Numeric> numericSum(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options)
+{
+    requireValues(values.size(), "numericSum");
+    return reduceValues(values, Reduction::Sum, options);
+}
+
+std::unique_ptr<Numeric> numericProduct(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options)
+{
+    requireValues(values.size(), "numericProduct");
+    return reduceValues(values, Reduction::Product, options);
+}
+
+std::unique_ptr<Numeric> numericMean(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options)
+{
+    requireValues(values.size(), "numericMean");
+    return reduceValues(values, Reduction::Mean, options);
+}
+
+std::unique_ptr<Numeric> numericMin(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options)
+{
+    requireValues(values.size(), "numericMin");
+    return extremeValue<false>(values, options);
+}
+
+std::unique_ptr<Numeric> numericMax(const std::vector<std::unique_ptr<Numeric>>& values, const NumericReduceOptions& options)
+{
+    requireValues(values.size(), "numericMax");
+    return extremeValue<true>(values, options);
+}
+
+/************************ Columns ********************************/
+
+template <typename T>
+T numericSum(const NumericColumn<T>& column, const NumericReduceOptions& options)
+{
+    requireValues(column.size(), "numericSum");
+    const T* data = column.data();
+    return sumValues<T>(column.size(), [data](std::size_t i) { return data[i]; }, options);
+}
+
+template <typename T>
+T numericProduct(const NumericColumn<T>& column, const NumericReduceOptions& options)
+{
+    requireValues(column.size(), "numericProduct");
+    if (column.size() == 1) {
+        return column[0];
+    }
+    const T* data = column.data();
+    return productValues<T>(column.size(), [data](std::size_t i) { return data[i]; }, options);
+}
+
+template <typename T>
+NumericMeanType<T> numericMean(const NumericColumn<T>& column, const NumericReduceOptions& options)
+{
+    requireValues(column.size(), "numericMean");
+    const T* data = column.data();
+    return meanValues<T>(column.size(), [data](std::size_t i) { return data[i]; }, options);
+}
+
+template <typename T>
+T numericMin(const NumericColumn<T>& column, const NumericReduceOptions& options)
+{
+    requireValues(column.size(), "numericMin");
+    const T* data = column.data();
+    return data[extremeIndex<false>(column.size(), options, [data](std::size_t first, std::size_t second) {
+        return valueBefore(data[first], data[second]);
+    })];
+}
+
+template <typename T>
+T numericMax(const NumericColumn<T>& column, const NumericReduceOptions& options)
+{
+    requireValues(column.size(), "numericMax");
+    const T* data = column.data();
+    return data[extremeIndex<true>(column.size(), options, [data](std::size_t first, std::size_t second) {
+        return valueBefore(data[first], data[second]);
+    })];
+}
+
+/************************ Grouped reductions ********************************/
+
+namespace {
+
+// Rows per thread before a grouping is split into partitions, and the most partitions (one byte per row)
+constexpr std::size_t groupRowsPerThread = 1 << 16;
+constexpr unsigned maxPartitionBits = 8;
+
+/**
+ * Numbers the distinct keys of rows [0, count). hashOf(row) is the hash of the row's key,
+ * keyOf(row) what the table stores for it, and makeMap() an empty NumericHashMap from
+ * those keys to group numbers using the same hash.
+ */
+template <typename HashOf, typename KeyOf, typename MakeMap>
+NumericGrouping groupRows(std::size_t count, const HashOf& hashOf, const KeyOf& keyOf, const MakeMap& makeMap,
+                          const NumericReduceOptions& options)
+{
+    if (count > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("numericGroupKeys: Too many rows.");
+    }
+    NumericGrouping grouping;
+    grouping.rowCount = count;
+    grouping.groups.resize(count);
+
+    const std::size_t threads = numericThreadCount(options.threads, count / groupRowsPerThread);
+    if (threads == 1) {
+        auto map = makeMap();
+        for (std::size_t row = 0; row < count; ++row) {
+            const auto [group, inserted] = map.insertHashed(hashOf(row), keyOf(row));
+            if (inserted) {
+                *group = static_cast<std::uint32_t>(grouping.firstRows.size());
+                grouping.firstRows.push_back(static_cast<std::uint32_t>(row));
+            }
+            grouping.groups[row] = *group;
+        }
+        grouping.partitionBegin = {0, count};
+        return grouping;
+    }
+
+    // A few partitions per thread, so that a large one does not hold up the rest
+    const unsigned bits = std::min<unsigned>(maxPartitionBits, std::bit_width(threads * 4 - 1));
+    const std::size_t partitions = std::size_t(1) << bits;
+    std::vector<std::uint8_t> partitionOf(count);
+    std::vector<std::size_t> offsets(threads * partitions);
+    numericParallelFor(threads, [&](std::size_t t) {
+        std::size_t* histogram = &offsets[t * partitions];
+        for (std::size_t row = count * t / threads; row < count * (t + 1) / threads; ++row) {
+            const auto partition = static_cast<std::uint8_t>(hashOf(row) >> (64 - bits));
+            partitionOf[row] = partition;
+            ++histogram[partition];
+        }
+    });
+
+    // Histograms to scatter positions: partition by partition, each thread's slice after the previous one's
+    grouping.partitionBegin.resize(partitions + 1);
+    std::size_t position = 0;
+    for (std::size_t p = 0; p < partitions; ++p) {
+        grouping.partitionBegin[p] = position;
+        for (std::size_t t = 0; t < threads; ++t) {
+            const std::size_t rows = offsets[t * partitions + p];
+            offsets[t * partitions + p] = position;
+            position += rows;
+        }
+    }
+    grouping.partitionBegin[partitions] = count;
+    grouping.rows.resize(count);
+    numericParallelFor(threads, [&](std::size_t t) {
+        std::size_t* next = &offsets[t * partitions];
+        for (std::size_t row = count * t / threads; row < count * (t + 1) / threads; ++row) {
+            grouping.rows[next[partitionOf[row]]++] = static_cast<std::uint32_t>(row);
+        }
+    });
+    partitionOf = {};
+
+    // One table per partition; the threads take the next partition until none is left
+    std::vector<std::vector<std::uint32_t>> firstRows(partitions);
+    std::atomic<std::size_t> nextPartition = 0;
+    const auto eachPartition = [&](const auto& body) {
+        numericParallelFor(threads, [&](std::size_t) {
+            for (std::size_t p = nextPartition++; p < partitions; p = nextPartition++) {
+                body(p);
+            }
+        });
+        nextPartition = 0;
+    };
+    eachPartition([&](std::size_t p) {
+        auto map = makeMap();
+        for (std::size_t i = grouping.partitionBegin[p]; i < grouping.partitionBegin[p + 1]; ++i) {
+            const std::uint32_t row = grouping.rows[i];
+            const auto [group, inserted] = map.insertHashed(hashOf(row), keyOf(row));
+            if (inserted) {
+                *group = static_cast<std::uint32_t>(firstRows[p].size());
+                firstRows[p].push_back(row);
+            }
+            grouping.groups[i] = *group;
+        }
+    });
+
+    // Renumber the groups in order of first appearance
+    std::vector<std::size_t> groupBegin(partitions + 1);
+    for (std::size_t p = 0; p < partitions; ++p) {
+        groupBegin[p + 1] = groupBegin[p] + firstRows[p].size();
+    }
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> order;    // (first row, group numbered by partition)
+    order.reserve(groupBegin[partitions]);
+    for (std::size_t p = 0; p < partitions; ++p) {
+        for (std::size_t local = 0; local < firstRows[p].size(); ++local) {
+            order.emplace_back(firstRows[p][local], static_cast<std::uint32_t>(groupBegin[p] + local));
+        }
+    }
+    firstRows = {};
+    std::sort(order.begin(), order.end());
+    std::vector<std::uint32_t> renumber(order.size());
+    grouping.firstRows.resize(order.size());
+    for (std::size_t group = 0; group < order.size(); ++group) {
+        grouping.firstRows[group] = order[group].first;
+        renumber[order[group].second] = static_cast<std::uint32_t>(group);
+    }
+    eachPartition([&](std::size_t p) {
+        for (std::size_t i = grouping.partitionBegin[p]; i < grouping.partitionBegin[p + 1]; ++i) {
+            grouping.groups[i] = renumber[groupBegin[p] + grouping.groups[i]];
+        }
+    });
+    return grouping;
+}
+
+// Running sum of a group: exact for integers and decimal units, float for the 16-bit floats
+template <typename V>
+auto groupTotal()
+{
+    if constexpr (IntegerValue<V>) {
+        return IntegerTotal(0);
+    } else if constexpr (isDecimalValue<V>) {
+        if constexpr (sizeof(typename V::rep_type) == 8) {
+            return IntegerTotal(0);
+        } else {
+            return WideTotal();
+        }
+    } else if constexpr (isHalfValue<V>) {
+        return -0.0f;
+    } else {
+        return zero<V>();
+    }
+}
+
+template <typename V>
+struct GroupState
+{
+    using Total = decltype(groupTotal<V>());
+
+    std::size_t count = 0;
+    Total total = groupTotal<V>();
+    V min{};
+    V max{};
+
+    void add(const V& value)
+    {
+        if (count++ == 0) {
+            min = value;
+            max = value;
+        } else if (valueBefore(value, min)) {
+            min = value;
+        } else if (valueBefore(max, value)) {
+            max = value;
+        }
+        if constexpr (std::is_same_v<Total, WideTotal>) {
+            total.add(value.units);
+        } else if constexpr (isDecimalValue<V>) {
+            total += value.units;
+        } else if constexpr (isHalfValue<V>) {
+            total += value.toFloat();
+        } else {
+            total += value;
+        }
+    }
+
+    // May throw under NumericOverflow::Checked, so it runs on the calling thread
+    V sum() const
+    {
+        if constexpr (IntegerValue<V>) {
+            return numericIntegerResult<V>(NumericOp::Sum, total);
+        } else if constexpr (std::is_same_v<Total, WideTotal>) {
+            return decimalResult<V>(NumericOp::Sum, static_cast<NumericInt128>(total.low), total.fits(), total.high < 0);
+        } else if constexpr (isDecimalValue<V>) {
+            return decimalResult<V>(NumericOp::Sum, total, true, total < 0);
+        } else {
+            return V(total);
+        }
+    }
+};
+
+} // namespace
+
+
+template <typename K>
+NumericGrouping numericGroupKeys(const NumericColumn<K>& keys, const NumericReduceOptions& options)
+{
+    const K* data = keys.data();
+    return groupRows(
+        keys.size(), [data](std::size_t row) { return numericHash(data[row]); }, [data](std::size_t row) { return data[row]; },
+        [] { return NumericHashMap<K, std::uint32_t>(); }, options);
+}
+
+NumericGrouping numericGroupKeys(const std::vector<std::unique_ptr<Numeric>>& keys, const NumericReduceOptions& options)
+{
+    // Kinds differ from row to row, so the tables hold row numbers and compare the rows' values
+    const auto hashOf = [&keys](std::uint32_t row) { return keys[row]->hash(); };
+    const auto sameRows = [&keys](std::uint32_t first, std::uint32_t second) { return numericSameValue(*keys[first], *keys[second]); };
+    return groupRows(
+        keys.size(), hashOf, [](std::size_t row) { return static_cast<std::uint32_t>(row); },
+        [&] { return NumericHashMap<std::uint32_t, std::uint32_t, decltype(hashOf), decltype(sameRows)>(0, hashOf, sameRows); },
+        options);
+}
+
+template <typename V>
+std::vector<NumericAggregate<V>> numericAggregate(const NumericGrouping& grouping, const NumericColumn<V>& values,
+                                                  const NumericReduceOptions& options)
+{
+    if (values.size() != grouping.rowCount) {
+        throw std::runtime_error("numericAggregate: Column sizes do not match.");
+    }
+    const V* data = values.data();
+    std::vector<GroupState<V>> states(grouping.groupCount());
+    if (grouping.rows.empty()) {
+        for (std::size_t row = 0; row < grouping.rowCount; ++row) {
+            states[grouping.groups[row]].add(data[row]);
+        }
+    } else {
+        // A group's rows are all in one partition, so the threads never share a state
+        const std::size_t partitions = grouping.partitionBegin.size() - 1;
+        std::atomic<std::size_t> nextPartition = 0;
+        numericParallelFor(numericThreadCount(options.threads, partitions), [&](std::size_t) {
+            for (std::size_t p = nextPartition++; p < partitions; p = nextPartition++) {
+                for (std::size_t i = grouping.partitionBegin[p]; i < grouping.partitionBegin[p + 1]; ++i) {
+                    states[grouping.groups[i]].add(data[grouping.rows[i]]);
+                }
+            }
+        });
+    }
+
+    std::vector<NumericAggregate<V>> aggregates(states.size());
+    for (std::size_t group = 0; group < states.size(); ++group) {
+        aggregates[group] = {states[group].count, states[group].sum(), states[group].min, states[group].max};
+    }
+    return aggregates;
+}
+
+template <typename V>
+std::vector<NumericGroup<std::unique_ptr<Numeric>, V>> numericGroupBy(const std::vector<std::unique_ptr<Numeric>>& keys,
+                                                                      const NumericColumn<V>& values,
+                                                                      const NumericReduceOptions& options)
+{
+    const NumericGrouping grouping = numericGroupKeys(keys, options);
+    std::vector<NumericAggregate<V>> aggregates = numericAggregate(grouping, values, options);
+    std::vector<NumericGroup<std::unique_ptr<Numeric>, V>> groups(aggregates.size());
+    for (std::size_t group = 0; group < groups.size(); ++group) {
+        static_cast<NumericAggregate<V>&>(groups[group]) = aggregates[group];
+        groups[group].key = copyOf(*keys[grouping.firstRows[group]]);
+    }
+    return groups;
+}
+
+
+#define NUMERIC_REDUCE_INSTANTIATE(T) \
+    template T numericSum<T>(const NumericColumn<T>&, const NumericReduceOptions&); \
+    template T numericProduct<T>(const NumericColumn<T>&, const NumericReduceOptions&); \
+    template T numericMin<T>(const NumericColumn<T>&, const NumericReduceOptions&); \
+    template T numericMax<T>(const NumericColumn<T>&, const NumericReduceOptions&); \
+    template NumericMeanType<T> numericMean<T>(const NumericColumn<T>&, const NumericReduceOptions&); \
+    template NumericGrouping numericGroupKeys<T>(const NumericColumn<T>&, const NumericReduceOptions&);
+
+NUMERIC_REDUCE_INSTANTIATE(int)
+NUMERIC_REDUCE_INSTANTIATE(float)
+NUMERIC_REDUCE_INSTANTIATE(double)
+NUMERIC_REDUCE_INSTANTIATE(long double)
+NUMERIC_REDUCE_INSTANTIATE(std::complex<float>)
+NUMERIC_REDUCE_INSTANTIATE(std::complex<double>)
+NUMERIC_REDUCE_INSTANTIATE(std::complex<long double>)
+NUMERIC_REDUCE_INSTANTIATE(char)
+NUMERIC_REDUCE_INSTANTIATE(wchar_t)
+NUMERIC_REDUCE_INSTANTIATE(char16_t)
+NUMERIC_REDUCE_INSTANTIATE(char32_t)
+NUMERIC_REDUCE_INSTANTIATE(std::int8_t)
+NUMERIC_REDUCE_INSTANTIATE(std::int16_t)
+NUMERIC_REDUCE_INSTANTIATE(std::int64_t)
+NUMERIC_REDUCE_INSTANTIATE(std::uint8_t)
+NUMERIC_REDUCE_INSTANTIATE(std::uint16_t)
+NUMERIC_REDUCE_INSTANTIATE(std::uint32_t)
+NUMERIC_REDUCE_INSTANTIATE(std::uint64_t)
+NUMERIC_REDUCE_INSTANTIATE(NumericDecimal2)
+NUMERIC_REDUCE_INSTANTIATE(NumericDecimal6)
+NUMERIC_REDUCE_INSTANTIATE(NumericDecimal18)
+NUMERIC_REDUCE_INSTANTIATE(NumericFloat16)
+NUMERIC_REDUCE_INSTANTIATE(NumericBFloat16)
+
+#undef NUMERIC_REDUCE_INSTANTIATE
+
+// Characters have no meaningful sum to group
+#define NUMERIC_AGGREGATE_INSTANTIATE(V) \
+    template std::vector<NumericAggregate<V>> numericAggregate<V>(const NumericGrouping&, const NumericColumn<V>&, const NumericReduceOptions&); \
+    template std::vector<NumericGroup<std::unique_ptr<Numeric>, V>> numericGroupBy<V>(const std::vector<std::unique_ptr<Numeric>>&, const NumericColumn<V>&, const NumericReduceOptions&);
+
+NUMERIC_AGGREGATE_INSTANTIATE(int)
+NUMERIC_AGGREGATE_INSTANTIATE(float)
+NUMERIC_AGGREGATE_INSTANTIATE(double)
+NUMERIC_AGGREGATE_INSTANTIATE(long double)
+NUMERIC_AGGREGATE_INSTANTIATE(std::complex<float>)
+NUMERIC_AGGREGATE_INSTANTIATE(std::complex<double>)
+NUMERIC_AGGREGATE_INSTANTIATE(std::complex<long double>)
+NUMERIC_AGGREGATE_INSTANTIATE(std::int8_t)
+NUMERIC_AGGREGATE_INSTANTIATE(std::int16_t)
+NUMERIC_AGGREGATE_INSTANTIATE(std::int64_t)
+NUMERIC_AGGREGATE_INSTANTIATE(std::uint8_t)
+NUMERIC_AGGREGATE_INSTANTIATE(std::uint16_t)
+NUMERIC_AGGREGATE_INSTANTIATE(std::uint32_t)
+NUMERIC_AGGREGATE_INSTANTIATE(std::uint64_t)
+NUMERIC_AGGREGATE_INSTANTIATE(NumericDecimal2)
+NUMERIC_AGGREGATE_INSTANTIATE(NumericDecimal6)
+NUMERIC_AGGREGATE_INSTANTIATE(NumericDecimal18)
+NUMERIC_AGGREGATE_INSTANTIATE(NumericFloat16)
+NUMERIC_AGGREGATE_INSTANTIATE(NumericBFloat16)
+
+#undef NUMERIC_AGGREGATE_INSTANTIATE
@@ -0,0 +1,526 @@
+#include "NumericSort.hpp"
+#include "NumericParallel.hpp"
+
+#include <bit>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+
+/************************ Sort keys ********************************/
+
+namespace {
+
+// First byte of each 11-byte part; the order of these values is the order of the categories
+constexpr std::uint8_t categoryNegative = 1;
+constexpr std::uint8_t categoryZero = 2;
+constexpr std::uint8_t categoryPositive = 3;
+constexpr std::uint8_t categoryNaN = 4;
+constexpr std::uint8_t categoryCharacter = 5;
+
+constexpr std::size_t imagOffset = 11;
+constexpr std::size_t kindOffset = NumericSortKey::kindByte;
+constexpr int exponentBias = 0x8000;
+
+static_assert(std::numeric_limits<long double>::digits <= 64, "long double significands must fit the 64-bit key field");
+
+void putBigEndian(std::uint8_t* out, std::uint64_t value, std::size_t bytes)
+{
+    for (std::size_t i = 0; i < bytes; ++i) {
+        out[i] = static_cast<std::uint8_t>(value >> (8 * (bytes - 1 - i)));
+    }
+}
+
+/**
+ * An 11-byte part is the category, then the biased binary exponent (2 bytes) and the
+ * normalized significand (8 bytes, leading bit set) of |x|. Negative values invert the
+ * last 10 bytes, so larger magnitudes sort first.
+ */
+void encodeMagnitude(std::uint8_t* out, bool negative, std::uint16_t exponent, std::uint64_t significand)
+{
+    if (negative) {
+        exponent = static_cast<std::uint16_t>(~exponent);
+        significand = ~significand;
+    }
+    out[0] = negative ? categoryNegative : categoryPositive;
+    if constexpr (std::endian::native == std::endian::little) {
+        exponent = __builtin_bswap16(exponent);
+        significand = __builtin_bswap64(significand);
+    }
+    std::memcpy(out + 1, &exponent, sizeof(exponent));
+    std::memcpy(out + 3, &significand, sizeof(significand));
+}
+
+// Zero and NaN leave the last 10 bytes at 0; infinity gets the largest exponent and significand
+bool encodeSpecial(std::uint8_t* out, bool isNaN, bool isZero, bool isInf, bool negative)
+{
+    if (isNaN) {
+        out[0] = categoryNaN;
+    } else if (isZero) {
+        out[0] = categoryZero;
+    } else if (isInf) {
+        encodeMagnitude(out, negative, 0xFFFF, ~std::uint64_t(0));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Reads the fields from the bits, which is much cheaper than ilogb/scalbn
+void encodeReal(std::uint8_t* out, double x)
+{
+    bool negative = std::signbit(x);
+    if (encodeSpecial(out, std::isnan(x), x == 0, std::isinf(x), negative)) {
+        return;
+    }
+
+    std::uint64_t bits = std::bit_cast<std::uint64_t>(x);
+    int biased = static_cast<int>((bits >> 52) & 0x7FF);
+    std::uint64_t fraction = bits & ((std::uint64_t(1) << 52) - 1);
+    int exponent;
+    std::uint64_t significand;
+    if (biased != 0) {
+        exponent = biased - 1023;
+        significand = (std::uint64_t(1) << 63) | (fraction << 11);
+    } else {
+        int top = 63 - std::countl_zero(fraction);   // subnormal: renormalize
+        exponent = top - 1074;
+        significand = fraction << (63 - top);
+    }
+    encodeMagnitude(out, negative, static_cast<std::uint16_t>(exponent + exponentBias), significand);
+}
+
+// Same encoding as above for every value a double can hold, so 3.0 and 3.0L share a key
+void encodeReal(std::uint8_t* out, long double x)
+{
+    if constexpr (std::numeric_limits<long double>::digits <= std::numeric_limits<double>::digits) {
+        encodeReal(out, static_cast<double>(x));
+    } else {
+        bool negative = std::signbit(x);
+        if (encodeSpecial(out, std::isnan(x), x == 0, std::isinf(x), negative)) {
+            return;
+        }
+
+        int exponent = std::ilogb(x);
+        long double scaled = std::scalbn(std::fabs(x), 63 - exponent);
+        encodeMagnitude(out, negative, static_cast<std::uint16_t>(exponent + exponentBias), static_cast<std::uint64_t>(scaled));
+    }
+}
+
+// Exact for every 64-bit magnitude, and the same bytes encodeReal gives a double holding it
+void encodeInteger(std::uint8_t* out, bool negative, std::uint64_t magnitude)
+{
+    if (magnitude == 0) {
+        out[0] = categoryZero;
+        return;
+    }
+    const int top = 63 - std::countl_zero(magnitude);
+    encodeMagnitude(out, negative, static_cast<std::uint16_t>(top + exponentBias), magnitude << (63 - top));
+}
+
+/**
+ * BigInts and decimals are keyed on their magnitude rounded to odd at 64 bits: the top
+ * 64 bits with the lowest one set when any bit below was. That keeps every value of 64
+ * significant bits or less (every integer, float and double) exact and is monotone, so
+ * an inexact key can tie with another value's key but never order before or after it
+ * the wrong way. Magnitudes of 2^32767 and more all take the largest finite exponent.
+ */
+void encodeBigInt(std::uint8_t* out, const NumericBigInt& value)
+{
+    if (value.isZero()) {
+        out[0] = categoryZero;
+        return;
+    }
+    const std::size_t top = value.bitLength() - 1;
+    if (top > 0x7FFE) {
+        encodeMagnitude(out, value.isNegative(), 0x7FFE + exponentBias, ~std::uint64_t(0));
+        return;
+    }
+    encodeMagnitude(out, value.isNegative(), static_cast<std::uint16_t>(top + exponentBias), value.topBits());
+}
+
+template <typename T>
+void encodeDecimal(std::uint8_t* out, const T& value)
+{
+    if (value.units == 0) {
+        out[0] = categoryZero;
+        return;
+    }
+    const bool negative = value.units < 0;
+    const NumericUInt128 units = static_cast<NumericUInt128>(static_cast<NumericInt128>(value.units));
+    std::uint64_t significand = 0;
+    const int exponent = numericScaleBinary(negative ? NumericUInt128(0) - units : units, T::scale, significand);
+    encodeMagnitude(out, negative, static_cast<std::uint16_t>(exponent + exponentBias), significand);
+}
+
+} // namespace
+
+
+template <typename T>
+NumericSortKey numericSortKey(T value)
+{
+    NumericSortKey key;
+    if constexpr (charTemp<T>) {
+        key.bytes[0] = categoryCharacter;
+        putBigEndian(&key.bytes[1], static_cast<std::make_unsigned_t<T>>(value), 4);
+    } else if constexpr (std::is_same_v<T, NumericBigInt>) {
+        encodeBigInt(&key.bytes[0], value);
+        key.bytes[imagOffset] = categoryZero;
+    } else if constexpr (isDecimalValue<T>) {
+        encodeDecimal(&key.bytes[0], value);
+        key.bytes[imagOffset] = categoryZero;
+    } else if constexpr (IntegerValue<T>) {
+        const bool negative = value < 0;
+        const std::uint64_t bits = static_cast<std::uint64_t>(value);
+        encodeInteger(&key.bytes[0], negative, negative ? std::uint64_t(0) - bits : bits);
+        key.bytes[imagOffset] = categoryZero;
+    } else if constexpr (isComplexValue<T>) {
+        encodeReal(&key.bytes[0], value.real());
+        encodeReal(&key.bytes[imagOffset], value.imag());
+    } else {
+        if constexpr (std::is_same_v<T, long double>) {
+            encodeReal(&key.bytes[0], value);
+        } else {
+            encodeReal(&key.bytes[0], static_cast<double>(value));
+        }
+        key.bytes[imagOffset] = categoryZero;
+    }
+    key.bytes[kindOffset] = static_cast<std::uint8_t>(numericKindOf<T>);
+    return key;
+}
+
+NumericSortKey Numeric::sortKey() const
+{
+    return numericVisit(*this, [](const auto& value) { return numericSortKey(value); }, "sortKey");
+}
+
+/************************ Radix / merge sort ********************************/
+
+namespace {
+
+// Below this many records per thread, spawning threads costs more than it saves
+constexpr std::size_t minRecordsPerThread = 1 << 16;
+// Automatic picks the merge sort below this size
+constexpr std::size_t radixThreshold = 1 << 12;
+
+template <typename Key, typename Payload>
+struct SortRecord
+{
+    Key key;
+    Payload payload;
+};
+
+/**
+ * Column keys for the types that fit in 8 bytes. Within one type they order exactly
+ * like numericSortKey: the sign-flip trick for floating point (after mapping -0.0 to
+ * +0.0 and every NaN to one positive NaN, which lands after +inf), a biased value for
+ * signed integers, the value itself for unsigned ones and the unsigned code unit for
+ * characters. Narrow integers leave the high key bytes equal, so the radix sort skips them;
+ * 16-bit floats take their double's key, whose low bytes are all zero and skipped the same way.
+ */
+template <typename T>
+constexpr bool hasNarrowColumnKey = IntegerValue<T> || std::is_same_v<T, float> || std::is_same_v<T, double> || charTemp<T> ||
+                                    std::is_same_v<T, NumericDecimal2> || std::is_same_v<T, NumericDecimal6> || isHalfValue<T>;
+
+template <typename T>
+using ColumnSortKey = std::conditional_t<hasNarrowColumnKey<T>, std::uint64_t, NumericSortKey>;
+
+template <typename T>
+ColumnSortKey<T> columnSortKey(T value)
+{
+    if constexpr (IntegerValue<T> && std::is_signed_v<T>) {
+        using Unsigned = std::make_unsigned_t<T>;
+        return static_cast<Unsigned>(static_cast<Unsigned>(value) ^ (Unsigned(1) << (8 * sizeof(T) - 1)));
+    } else if constexpr (IntegerValue<T>) {
+        return value;
+    } else if constexpr (isDecimalValue<T> && hasNarrowColumnKey<T>) {
+        return columnSortKey(value.units);
+    } else if constexpr ((std::is_floating_point_v<T> || isHalfValue<T>) && hasNarrowColumnKey<T>) {
+        double x = static_cast<double>(value);
+        if (std::isnan(x)) {
+            x = std::numeric_limits<double>::quiet_NaN();
+        } else if (x == 0) {
+            x = 0.0;
+        }
+        std::uint64_t bits = std::bit_cast<std::uint64_t>(x);
+        return (bits >> 63) ? ~bits : bits | (std::uint64_t(1) << 63);
+    } else if constexpr (charTemp<T>) {
+        return static_cast<std::make_unsigned_t<T>>(value);
+    } else {
+        return numericSortKey(value);
+    }
+}
+
+// Byte `index` of a key, most significant first
+std::size_t keyByte(std::uint64_t key, std::size_t index) { return (key >> (56 - 8 * index)) & 0xFF; }
+std::size_t keyByte(const NumericSortKey& key, std::size_t index) { return key.bytes[index]; }
+
+template <typename Key>
+constexpr std::size_t keyBytes = std::is_same_v<Key, std::uint64_t> ? 8 : NumericSortKey::size;
+
+std::size_t threadCount(const NumericSortOptions& options, std::size_t count)
+{
+    return numericThreadCount(options.threads, count / minRecordsPerThread);
+}
+
+/**
+ * Parallel LSD radix sort, one byte per pass. Each thread owns a contiguous slice:
+ * it counts its slice, the counts are turned into per-thread bucket offsets, and
+ * each thread scatters its slice to its own offsets. Slices are scattered in order,
+ * so every pass (and the whole sort) is stable.
+ */
+template <typename Record>
+void radixSort(std::vector<Record>& records, std::size_t threads)
+{
+    using Histogram = std::array<std::size_t, 256>;
+    constexpr std::size_t passes = keyBytes<decltype(Record::key)>;
+    const std::size_t count = records.size();
+    auto sliceBegin = [count, threads](std::size_t t) { return count * t / threads; };
+
+    // One read for the histograms of every byte position, to find the positions worth a pass
+    std::vector<std::array<Histogram, passes>> perThread(threads);
+    numericParallelFor(threads, [&](std::size_t t) {
+        auto& histograms = perThread[t];
+        for (auto& histogram : histograms) {
+            histogram.fill(0);
+        }
+        for (std::size_t i = sliceBegin(t); i < sliceBegin(t + 1); ++i) {
+            for (std::size_t byte = 0; byte < passes; ++byte) {
+                ++histograms[byte][keyByte(records[i].key, byte)];
+            }
+        }
+    });
+
+    std::vector<std::size_t> activePasses;
+    for (std::size_t byte = passes; byte-- > 0;) {
+        std::size_t first = 0;
+        for (std::size_t t = 0; t < threads; ++t) {
+            first += perThread[t][byte][keyByte(records[0].key, byte)];
+        }
+        if (first != count) {
+            activePasses.push_back(byte);
+        }
+    }
+    if (activePasses.empty()) {
+        return;
+    }
+
+    std::vector<Record> scratch(count);
+    Record* from = records.data();
+    Record* to = scratch.data();
+    std::vector<Histogram> offsets(threads);
+
+    for (std::size_t pass = 0; pass < activePasses.size(); ++pass) {
+        const std::size_t byte = activePasses[pass];
+
+        // The slices hold different records after the first scatter, so count them again
+        if (pass == 0 || threads == 1) {
+            for (std::size_t t = 0; t < threads; ++t) {
+                offsets[t] = perThread[t][byte];
+            }
+        } else {
+            numericParallelFor(threads, [&](std::size_t t) {
+                offsets[t].fill(0);
+                for (std::size_t i = sliceBegin(t); i < sliceBegin(t + 1); ++i) {
+                    ++offsets[t][keyByte(from[i].key, byte)];
+                }
+            });
+        }
+
+        std::size_t offset = 0;
+        for (std::size_t bucket = 0; bucket < 256; ++bucket) {
+            for (std::size_t t = 0; t < threads; ++t) {
+                std::size_t size = offsets[t][bucket];
+                offsets[t][bucket] = offset;
+                offset += size;
+            }
+        }
+
+        numericParallelFor(threads, [&](std::size_t t) {
+            Histogram& next = offsets[t];
+            for (std::size_t i = sliceBegin(t); i < sliceBegin(t + 1); ++i) {
+                to[next[keyByte(from[i].key, byte)]++] = from[i];
+            }
+        });
+        std::swap(from, to);
+    }
+
+    if (from != records.data()) {
+        std::copy(from, from + count, records.data());
+    }
+}
+
+// Stable-sorts one slice per thread, then merges neighbouring runs pairwise in parallel
+template <typename Record>
+void mergeSort(std::vector<Record>& records, std::size_t threads)
+{
+    auto less = [](const Record& first, const Record& second) { return first.key < second.key; };
+    const std::size_t count = records.size();
+
+    std::vector<std::size_t> runs;
+    for (std::size_t t = 0; t <= threads; ++t) {
+        runs.push_back(count * t / threads);
+    }
+    numericParallelFor(threads, [&](std::size_t t) {
+        std::stable_sort(records.begin() + runs[t], records.begin() + runs[t + 1], less);
+    });
+
+    std::vector<Record> scratch(threads > 1 ? count : 0);
+    while (runs.size() > 2) {
+        const std::size_t runCount = runs.size() - 1;
+        numericParallelFor((runCount + 1) / 2, [&](std::size_t pair) {
+            auto begin = records.begin() + runs[2 * pair];
+            auto end = records.begin() + runs[std::min(2 * pair + 2, runCount)];
+            auto out = scratch.begin() + runs[2 * pair];
+            if (2 * pair + 1 < runCount) {
+                std::merge(begin, records.begin() + runs[2 * pair + 1], records.begin() + runs[2 * pair + 1], end, out, less);
+            } else {
+                std::copy(begin, end, out);
+            }
+        });
+        records.swap(scratch);
+
+        std::vector<std::size_t> merged;
+        for (std::size_t i = 0; i < runs.size(); i += 2) {
+            merged.push_back(runs[i]);
+        }
+        if (merged.back() != count) {
+            merged.push_back(count);
+        }
+        runs.swap(merged);
+    }
+}
+
+template <typename Record>
+void sortRecords(std::vector<Record>& records, const NumericSortOptions& options)
+{
+    if (records.size() < 2) {
+        return;
+    }
+
+    std::size_t threads = threadCount(options, records.size());
+    bool radix = options.algorithm == NumericSortAlgorithm::Radix ||
+                 (options.algorithm == NumericSortAlgorithm::Automatic && records.size() >= radixThreshold);
+    if (radix) {
+        radixSort(records, threads);
+    } else {
+        mergeSort(records, threads);
+    }
+}
+
+/**
+ * Keys only tie for different values when one of them is a decimal or a BigInt beyond
+ * 64 bits. Each run of records with tied keys (`tied`) that holds such a value
+ * (`inexact`) is stable-sorted again with the exact comparison `less`.
+ */
+template <typename Record, typename Tied, typename Inexact, typename Less>
+void sortTies(std::vector<Record>& records, const Tied& tied, const Inexact& inexact, const Less& less)
+{
+    for (std::size_t begin = 0; begin < records.size();) {
+        std::size_t end = begin + 1;
+        bool exact = !inexact(records[begin]);
+        for (; end < records.size() && tied(records[begin], records[end]); ++end) {
+            exact = exact && !inexact(records[end]);
+        }
+        if (!exact && end - begin > 1) {
+            std::stable_sort(records.begin() + begin, records.begin() + end, less);
+        }
+        begin = end;
+    }
+}
+
+} // namespace
+
+
+void numericSort(std::vector<std::unique_ptr<Numeric>>& values, const NumericSortOptions& options)
+{
+    using Record = SortRecord<NumericSortKey, std::size_t>;
+    const std::size_t count = values.size();
+    const std::size_t threads = threadCount(options, count);
+
+    std::vector<Record> records(count);
+    numericParallelFor(threads, [&](std::size_t t) {
+        for (std::size_t i = count * t / threads; i < count * (t + 1) / threads; ++i) {
+            records[i] = {values[i]->sortKey(), i};
+        }
+    });
+
+    sortRecords(records, options);
+    sortTies(
+        records,
+        [](const Record& first, const Record& second) {
+            return std::memcmp(first.key.bytes.data(), second.key.bytes.data(), NumericSortKey::kindByte) == 0;
+        },
+        [](const Record& record) {
+            const NumericKind kind = static_cast<NumericKind>(record.key.bytes[kindOffset]);
+            return kind == NumericKind::BigInt || isDecimalKind(kind);
+        },
+        [&](const Record& first, const Record& second) { return numericSortOrder(*values[first.payload], *values[second.payload]) < 0; });
+
+    std::vector<std::unique_ptr<Numeric>> sorted(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        sorted[i] = std::move(values[records[i].payload]);
+    }
+    values.swap(sorted);
+}
+
+template <typename T>
+void numericSort(NumericColumn<T>& column, const NumericSortOptions& options)
+{
+    using Record = SortRecord<ColumnSortKey<T>, T>;
+    const std::size_t count = column.size();
+    const std::size_t threads = threadCount(options, count);
+    T* data = column.data();
+
+    std::vector<Record> records(count);
+    numericParallelFor(threads, [&](std::size_t t) {
+        for (std::size_t i = count * t / threads; i < count * (t + 1) / threads; ++i) {
+            records[i] = {columnSortKey(data[i]), data[i]};
+        }
+    });
+
+    sortRecords(records, options);
+    if constexpr (isDecimalValue<T> && !hasNarrowColumnKey<T>) {
+        sortTies(
+            records, [](const Record& first, const Record& second) { return first.key == second.key; }, [](const Record&) { return true; },
+            [](const Record& first, const Record& second) { return first.payload.units < second.payload.units; });
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        data[i] = records[i].payload;
+    }
+}
+
+
+#define NUMERIC_SORT_INSTANTIATE(T) \
+    template NumericSortKey numericSortKey<T>(T); \
+    template void numericSort<T>(NumericColumn<T>&, const NumericSortOptions&);
+
+NUMERIC_SORT_INSTANTIATE(int)
+NUMERIC_SORT_INSTANTIATE(float)
+NUMERIC_SORT_INSTANTIATE(double)
+NUMERIC_SORT_INSTANTIATE(long double)
+NUMERIC_SORT_INSTANTIATE(std::complex<float>)
+NUMERIC_SORT_INSTANTIATE(std::complex<double>)
+NUMERIC_SORT_INSTANTIATE(std::complex<long double>)
+NUMERIC_SORT_INSTANTIATE(char)
+NUMERIC_SORT_INSTANTIATE(wchar_t)
+NUMERIC_SORT_INSTANTIATE(char16_t)
+NUMERIC_SORT_INSTANTIATE(char32_t)
+NUMERIC_SORT_INSTANTIATE(std::int8_t)
+NUMERIC_SORT_INSTANTIATE(std::int16_t)
+NUMERIC_SORT_INSTANTIATE(std::int64_t)
+NUMERIC_SORT_INSTANTIATE(std::uint8_t)
+NUMERIC_SORT_INSTANTIATE(std::uint16_t)
+NUMERIC_SORT_INSTANTIATE(std::uint32_t)
+NUMERIC_SORT_INSTANTIATE(std::uint64_t)
+
+NUMERIC_SORT_INSTANTIATE(NumericDecimal2)
+NUMERIC_SORT_INSTANTIATE(NumericDecimal6)
+NUMERIC_SORT_INSTANTIATE(NumericDecimal18)
+NUMERIC_SORT_INSTANTIATE(NumericFloat16)
+NUMERIC_SORT_INSTANTIATE(NumericBFloat16)
+
+#undef NUMERIC_SORT_INSTANTIATE
+
+template NumericSortKey numericSortKey<NumericBigInt>(NumericBigInt);
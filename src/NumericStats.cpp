@@ -0,0 +1,296 @@
+#include "NumericStats.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <mutex>
+
+
+/************************ Histogram and snapshot ********************************/
+
+std::uint64_t NumericLatencyHistogram::percentile(double fraction) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    const double clamped = std::clamp(fraction, 0.0, 1.0);
+    const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(clamped * static_cast<double>(count) + 0.5));
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank) {
+            return numericLatencyBucketBound(bucket);
+        }
+    }
+    return numericLatencyBucketBound(buckets.size() - 1);
+}
+
+std::uint64_t NumericStatsSnapshot::count(NumericPath path) const
+{
+    std::uint64_t total = 0;
+    for (std::size_t i = static_cast<std::size_t>(path); i < operations.size(); i += numericPathCount) {
+        total += operations[i];
+    }
+    return total;
+}
+
+
+/************************ Per-thread blocks ********************************/
+
+#if NUMERIC_STATS
+
+/**
+ * A thread gets its block on its first counted event. The registry lists the blocks of
+ * the live threads; when a thread exits, its counts are moved into `retired` and the
+ * block is freed. Totals therefore only grow, and numericStatsReset() just records the
+ * current totals as the baseline that later snapshots subtract.
+ */
+
+thread_local constinit NumericThreadStats* numericLocalStats = nullptr;
+
+namespace {
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<NumericThreadStats*> live;
+    NumericStatsSnapshot retired;
+    NumericStatsSnapshot baseline;
+    std::atomic<std::uint32_t> samplingPeriod{64};
+};
+
+// Never destroyed: threads may still exit after static destructors have run
+Registry& registry()
+{
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+// Used by a thread once its own block has been retired
+constinit NumericThreadStats orphanStats{};
+
+void addCounts(NumericStatsSnapshot& totals, const NumericThreadStats& block)
+{
+    for (std::size_t i = 0; i < numericStatsOperationCounters; ++i) {
+        totals.operations[i] += block.operations[i].load(std::memory_order_relaxed);
+    }
+    for (std::size_t op = 0; op < numericStatsOpCount; ++op) {
+        NumericLatencyHistogram& histogram = totals.latency[op];
+        for (std::size_t bucket = 0; bucket < numericLatencyBucketCount; ++bucket) {
+            const std::uint64_t samples = block.latency[op * numericLatencyBucketCount + bucket].load(std::memory_order_relaxed);
+            histogram.buckets[bucket] += samples;
+            histogram.count += samples;
+        }
+        histogram.sumNanoseconds += block.latencySum[op].load(std::memory_order_relaxed);
+    }
+    totals.allocations += block.allocations.load(std::memory_order_relaxed);
+    totals.deallocations += block.deallocations.load(std::memory_order_relaxed);
+    totals.allocatedBytes += block.allocatedBytes.load(std::memory_order_relaxed);
+}
+
+void addCounts(NumericStatsSnapshot& totals, const NumericStatsSnapshot& other, bool subtract)
+{
+    auto combine = [subtract](std::uint64_t& to, std::uint64_t from) { to = subtract ? to - from : to + from; };
+    for (std::size_t i = 0; i < numericStatsOperationCounters; ++i) {
+        combine(totals.operations[i], other.operations[i]);
+    }
+    for (std::size_t op = 0; op < numericStatsOpCount; ++op) {
+        for (std::size_t bucket = 0; bucket < numericLatencyBucketCount; ++bucket) {
+            combine(totals.latency[op].buckets[bucket], other.latency[op].buckets[bucket]);
+        }
+        combine(totals.latency[op].count, other.latency[op].count);
+        combine(totals.latency[op].sumNanoseconds, other.latency[op].sumNanoseconds);
+    }
+    combine(totals.allocations, other.allocations);
+    combine(totals.deallocations, other.deallocations);
+    combine(totals.allocatedBytes, other.allocatedBytes);
+}
+
+// Caller holds the registry mutex
+NumericStatsSnapshot totalsLocked(Registry& stats)
+{
+    NumericStatsSnapshot totals = stats.retired;
+    for (const NumericThreadStats* block : stats.live) {
+        addCounts(totals, *block);
+    }
+    addCounts(totals, orphanStats);
+    return totals;
+}
+
+struct ThreadBlockOwner
+{
+    NumericThreadStats* block = nullptr;
+
+    ~ThreadBlockOwner()
+    {
+        if (!block) {
+            return;
+        }
+        Registry& stats = registry();
+        {
+            std::lock_guard<std::mutex> lock(stats.mutex);
+            addCounts(stats.retired, *block);
+            stats.live.erase(std::find(stats.live.begin(), stats.live.end(), block));
+        }
+        numericLocalStats = &orphanStats;
+        delete block;
+    }
+};
+
+thread_local ThreadBlockOwner threadBlockOwner;
+
+std::uint32_t nextSample(std::uint32_t period)
+{
+    return period ? period : std::numeric_limits<std::uint32_t>::max();
+}
+
+} // namespace
+
+NumericThreadStats& numericAttachThreadStats()
+{
+    Registry& stats = registry();
+    NumericThreadStats* block = new NumericThreadStats{};
+    block->untilSample.store(nextSample(stats.samplingPeriod.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(stats.mutex);
+        stats.live.push_back(block);
+    }
+    threadBlockOwner.block = block;
+    numericLocalStats = block;
+    return *block;
+}
+
+std::chrono::steady_clock::time_point numericStatsStartSample()
+{
+    const std::uint32_t period = registry().samplingPeriod.load(std::memory_order_relaxed);
+    numericStatsBlock().untilSample.store(nextSample(period), std::memory_order_relaxed);
+    return period ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+}
+
+void numericStatsRecordLatency(NumericOp op, std::chrono::steady_clock::duration elapsed)
+{
+    const std::uint64_t nanoseconds = static_cast<std::uint64_t>(
+        std::max<std::int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    NumericThreadStats& block = numericStatsBlock();
+    const std::size_t row = static_cast<std::size_t>(op);
+    numericStatsBump(block.latency[row * numericLatencyBucketCount + numericLatencyBucket(nanoseconds)], 1);
+    numericStatsBump(block.latencySum[row], nanoseconds);
+}
+
+NumericStatsSnapshot numericStatsSnapshot()
+{
+    Registry& stats = registry();
+    std::lock_guard<std::mutex> lock(stats.mutex);
+    NumericStatsSnapshot totals = totalsLocked(stats);
+    addCounts(totals, stats.baseline, true);
+    return totals;
+}
+
+void numericStatsReset()
+{
+    Registry& stats = registry();
+    std::lock_guard<std::mutex> lock(stats.mutex);
+    stats.baseline = totalsLocked(stats);
+}
+
+void setNumericStatsSampling(std::uint32_t period)
+{
+    registry().samplingPeriod.store(period, std::memory_order_relaxed);
+}
+
+std::uint32_t numericStatsSampling()
+{
+    return registry().samplingPeriod.load(std::memory_order_relaxed);
+}
+
+#else // NUMERIC_STATS
+
+NumericStatsSnapshot numericStatsSnapshot()
+{
+    return {};
+}
+
+void numericStatsReset()
+{
+}
+
+void setNumericStatsSampling(std::uint32_t)
+{
+}
+
+std::uint32_t numericStatsSampling()
+{
+    return 0;
+}
+
+#endif // NUMERIC_STATS
+
+
+/************************ Prometheus export ********************************/
+
+namespace {
+
+void appendLine(std::string& out, const char* format, auto... arguments)
+{
+    char line[256];
+    const int length = std::snprintf(line, sizeof(line), format, arguments...);
+    out.append(line, static_cast<std::size_t>(std::min<int>(length, sizeof(line) - 1)));
+}
+
+void appendCounter(std::string& out, const char* name, const char* help, std::uint64_t value)
+{
+    appendLine(out, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n", name, help, name, name, static_cast<unsigned long long>(value));
+}
+
+} // namespace
+
+std::string numericStatsPrometheus(const NumericStatsSnapshot& snapshot)
+{
+    std::string out;
+
+    out += "# HELP numeric_operations_total Numeric operations by operand kinds and dispatch path.\n"
+           "# TYPE numeric_operations_total counter\n";
+    for (std::size_t op = 0; op < numericStatsOpCount; ++op) {
+        for (std::size_t lhs = 0; lhs < numericKindCount; ++lhs) {
+            for (std::size_t rhs = 0; rhs < numericKindCount; ++rhs) {
+                for (std::size_t path = 0; path < numericPathCount; ++path) {
+                    const std::uint64_t value = snapshot.count(NumericOp(op), NumericKind(lhs), NumericKind(rhs), NumericPath(path));
+                    if (value != 0) {
+                        appendLine(out, "numeric_operations_total{op=\"%s\",lhs=\"%s\",rhs=\"%s\",path=\"%s\"} %llu\n",
+                                   numericStatsOpName(NumericOp(op)), numericKindName(NumericKind(lhs)), numericKindName(NumericKind(rhs)),
+                                   numericPathName(NumericPath(path)), static_cast<unsigned long long>(value));
+                    }
+                }
+            }
+        }
+    }
+
+    appendCounter(out, "numeric_allocations_total", "Numeric objects allocated.", snapshot.allocations);
+    appendCounter(out, "numeric_deallocations_total", "Numeric objects freed.", snapshot.deallocations);
+    appendCounter(out, "numeric_allocated_bytes_total", "Bytes requested by Numeric allocations.", snapshot.allocatedBytes);
+
+    // The histogram buckets are cut at powers of two: le=2^k ns counts the samples below 2^k ns
+    out += "# HELP numeric_operation_latency_seconds Sampled latency of single Numeric operations.\n"
+           "# TYPE numeric_operation_latency_seconds histogram\n";
+    for (std::size_t op = 0; op < numericStatsOpCount; ++op) {
+        const NumericLatencyHistogram& histogram = snapshot.latency[op];
+        if (histogram.count == 0) {
+            continue;
+        }
+        const char* name = numericStatsOpName(NumericOp(op));
+        std::uint64_t cumulative = 0;
+        std::size_t bucket = 0;
+        for (std::size_t exponent = 4; exponent <= 37; ++exponent) {
+            for (; bucket < numericLatencyBucketCount && numericLatencyBucketBound(bucket) < (std::uint64_t(1) << exponent); ++bucket) {
+                cumulative += histogram.buckets[bucket];
+            }
+            appendLine(out, "numeric_operation_latency_seconds_bucket{op=\"%s\",le=\"%.9g\"} %llu\n", name,
+                       static_cast<double>(std::uint64_t(1) << exponent) * 1e-9, static_cast<unsigned long long>(cumulative));
+        }
+        appendLine(out, "numeric_operation_latency_seconds_bucket{op=\"%s\",le=\"+Inf\"} %llu\n", name,
+                   static_cast<unsigned long long>(histogram.count));
+        appendLine(out, "numeric_operation_latency_seconds_sum{op=\"%s\"} %.9g\n", name, static_cast<double>(histogram.sumNanoseconds) * 1e-9);
+        appendLine(out, "numeric_operation_latency_seconds_count{op=\"%s\"} %llu\n", name, static_cast<unsigned long long>(histogram.count));
+    }
+    return out;
+}
@@ -0,0 +1,59 @@
+#include "NumericStream.hpp"
+
+
+/************************ Sources ********************************/
+
+NumericGenerator<std::string> numericReadChunks(std::FILE* file, std::size_t chunkSize)
+{
+    chunkSize = std::max<std::size_t>(chunkSize, 1);
+    for (;;) {
+        std::string chunk(chunkSize, '\0');
+        const std::size_t read = std::fread(chunk.data(), 1, chunkSize, file);
+        if (read == 0) {
+            break;
+        }
+        chunk.resize(read);
+        co_yield std::move(chunk);
+    }
+    if (std::ferror(file)) {
+        throw std::runtime_error("numericReadChunks: Read failed.");
+    }
+}
+
+NumericGenerator<std::string> numericReadChunks(std::istream& stream, std::size_t chunkSize)
+{
+    chunkSize = std::max<std::size_t>(chunkSize, 1);
+    for (;;) {
+        std::string chunk(chunkSize, '\0');
+        stream.read(chunk.data(), static_cast<std::streamsize>(chunkSize));
+        const std::size_t read = static_cast<std::size_t>(stream.gcount());
+        if (read == 0) {
+            break;
+        }
+        chunk.resize(read);
+        co_yield std::move(chunk);
+    }
+    if (stream.bad()) {
+        throw std::runtime_error("numericReadChunks: Read failed.");
+    }
+}
+
+
+/************************ Parsing ********************************/
+
+NumericGenerator<NumericParsedColumns> numericParseChunks(NumericGenerator<std::string> chunks, NumericParseOptions options)
+{
+    NumericTextParser parser(options);
+    for (std::string& chunk : chunks) {
+        NumericParsedColumns columns;
+        parser.parse(chunk, columns);
+        if (columns.size() != 0) {
+            co_yield std::move(columns);
+        }
+    }
+    NumericParsedColumns last;
+    parser.finish(last);
+    if (last.size() != 0) {
+        co_yield std::move(last);
+    }
+}
@@ -0,0 +1,135 @@
+#include "NumericValue.hpp"
+
+
+/************************ NumericValue Class ********************************/
+
+namespace {
+
+template <NumericOp Op>
+NumericError applyArithmetic(const NumericValue& first, const NumericValue& second, NumericValue& result)
+{
+    return std::visit([&result](const auto& lhs, const auto& rhs) -> NumericError {
+        using Kernel = ArithmeticKernel<Op, numericKindOf<std::decay_t<decltype(lhs)>>, numericKindOf<std::decay_t<decltype(rhs)>>>;
+
+        if constexpr (Kernel::rule.error != NumericError::None) {
+            return Kernel::rule.error;
+        } else {
+            typename Kernel::result_type value{};
+            const NumericOverflow overflow = hasOverflowPolicy(Kernel::resultKind) ? numericOverflowMode() : NumericOverflow::Checked;
+            NumericError error = Kernel::apply(lhs, rhs, value, overflow);
+            if (error == NumericError::None) {
+                result = NumericValue(value);
+            }
+            return error;
+        }
+    }, first.value(), second.value());
+}
+
+template <NumericOp Op>
+NumericError applyComparison(const NumericValue& first, const NumericValue& second, bool& result)
+{
+    return std::visit([&result](const auto& lhs, const auto& rhs) -> NumericError {
+        using Kernel = ComparisonKernel<Op, numericKindOf<std::decay_t<decltype(lhs)>>, numericKindOf<std::decay_t<decltype(rhs)>>>;
+        return Kernel::apply(lhs, rhs, result);
+    }, first.value(), second.value());
+}
+
+} // namespace
+
+
+NumericValue NumericValue::fromNumeric(const Numeric& numeric)
+{
+    switch (numeric.kind()) {
+        case NumericKind::Int:           return NumericValue(numericValueOf<NumericKind::Int>(numeric));
+        case NumericKind::Float:         return NumericValue(numericValueOf<NumericKind::Float>(numeric));
+        case NumericKind::Double:        return NumericValue(numericValueOf<NumericKind::Double>(numeric));
+        case NumericKind::ComplexFloat:  return NumericValue(numericValueOf<NumericKind::ComplexFloat>(numeric));
+        case NumericKind::ComplexDouble: return NumericValue(numericValueOf<NumericKind::ComplexDouble>(numeric));
+        case NumericKind::Char:          return NumericValue(numericValueOf<NumericKind::Char>(numeric));
+        case NumericKind::WChar:         return NumericValue(numericValueOf<NumericKind::WChar>(numeric));
+        case NumericKind::Char16:        return NumericValue(numericValueOf<NumericKind::Char16>(numeric));
+        case NumericKind::Char32:        return NumericValue(numericValueOf<NumericKind::Char32>(numeric));
+        case NumericKind::Int8:          return NumericValue(numericValueOf<NumericKind::Int8>(numeric));
+        case NumericKind::Int16:         return NumericValue(numericValueOf<NumericKind::Int16>(numeric));
+        case NumericKind::Int64:         return NumericValue(numericValueOf<NumericKind::Int64>(numeric));
+        case NumericKind::UInt8:         return NumericValue(numericValueOf<NumericKind::UInt8>(numeric));
+        case NumericKind::UInt16:        return NumericValue(numericValueOf<NumericKind::UInt16>(numeric));
+        case NumericKind::UInt32:        return NumericValue(numericValueOf<NumericKind::UInt32>(numeric));
+        case NumericKind::UInt64:        return NumericValue(numericValueOf<NumericKind::UInt64>(numeric));
+        default:
+            throw std::runtime_error("Unsupported conversion");
+    }
+}
+
+std::unique_ptr<Numeric> NumericValue::toNumeric() const
+{
+    return std::visit([](const auto& value) -> std::unique_ptr<Numeric> {
+        using T = std::decay_t<decltype(value)>;
+        return std::make_unique<NumericClass<numericKindOf<T>>>(value);
+    }, storage);
+}
+
+NumericKind NumericValue::kind() const
+{
+    return std::visit([](const auto& value) {
+        return numericKindOf<std::decay_t<decltype(value)>>;
+    }, storage);
+}
+
+NumericError NumericValue::apply(NumericOp op, const NumericValue& first, const NumericValue& second, NumericValue& result)
+{
+    switch (op) {
+        case NumericOp::Sum:      return applyArithmetic<NumericOp::Sum>(first, second, result);
+        case NumericOp::Subtract: return applyArithmetic<NumericOp::Subtract>(first, second, result);
+        case NumericOp::Multiply: return applyArithmetic<NumericOp::Multiply>(first, second, result);
+        case NumericOp::Divide:   return applyArithmetic<NumericOp::Divide>(first, second, result);
+        default:
+            throw std::invalid_argument("NumericValue::apply: not an arithmetic operation.");
+    }
+}
+
+NumericError NumericValue::compare(NumericOp op, const NumericValue& first, const NumericValue& second, bool& result)
+{
+    switch (op) {
+        case NumericOp::LessThan:    return applyComparison<NumericOp::LessThan>(first, second, result);
+        case NumericOp::GreaterThan: return applyComparison<NumericOp::GreaterThan>(first, second, result);
+        case NumericOp::Equal:       return applyComparison<NumericOp::Equal>(first, second, result);
+        default:
+            throw std::invalid_argument("NumericValue::compare: not a comparison operation.");
+    }
+}
+
+NumericValue NumericValue::applyOrThrow(NumericOp op, const NumericValue& second) const
+{
+    NumericValue result;
+    NumericError error = apply(op, *this, second, result);
+    if (error != NumericError::None) {
+        throw std::runtime_error(numericErrorMessage(op, error));
+    }
+    return result;
+}
+
+bool NumericValue::compareOrThrow(NumericOp op, const NumericValue& second) const
+{
+    bool result = false;
+    NumericError error = compare(op, *this, second, result);
+    if (error != NumericError::None) {
+        throw std::runtime_error(numericErrorMessage(op, error));
+    }
+    return result;
+}
+
+// Same text as the toString() of the matching Numeric class
+std::string NumericValue::toString() const
+{
+    return std::visit([](const auto& value) -> std::string {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (isComplexValue<T>) {
+            return "(" + std::to_string(value.real()) + " + " + std::to_string(value.imag()) + "i)";
+        } else if constexpr (charTemp<T>) {
+            return std::string(1, value);
+        } else {
+            return std::to_string(value);
+        }
+    }, storage);
+}
@@ -1,4 +1,5 @@
-#include "../include/Numeric.hpp"
+#include "Numeric.hpp"
+#include "NumericSort.hpp"
 
 
 int main() {
@@ -85,10 +86,8 @@ int main() {
         }
     }
 
-    // Sort the vector in ascending order using lessThanOperation
-    std::sort(vec.begin(), vec.end(), [](const std::unique_ptr<Numeric>& a, const std::unique_ptr<Numeric>& b) {
-        return a->lessThanOperation(*b);
-    });
+    // Sort the vector in ascending order (total order of NumericSort.hpp, no virtual calls per comparison)
+    numericSort(vec);
 
     // Display sorted values in the vector
     std::cout << "\nSorted values in the vector (ascending order):\n";
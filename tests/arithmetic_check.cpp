@@ -0,0 +1,173 @@
+#include "NumericArithmetic.hpp"
+#include "NumericFormat.hpp"
+#include "check.hpp"
+
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/**
+ * The run-time path of numericApply / numericCompare against Numeric::apply / compare on
+ * the matching classes, for pairs of a set of types, accepted by the concepts or not:
+ * the same result type and bits, the same error messages for division by zero and
+ * overflow, and overflow under each NumericOverflowScope policy. Scopes nest and are
+ * per thread.
+ */
+namespace {
+
+using Types = std::tuple<int, std::int8_t, std::int16_t, std::int64_t, std::uint8_t, std::uint32_t, std::uint64_t, float, double,
+                         std::complex<double>, char, char32_t, NumericDecimal2, NumericDecimal6, NumericFloat16, NumericBigInt>;
+
+// Ordinary values, zero, and each type's extremes
+template <typename T>
+std::vector<T> samples()
+{
+    if constexpr (IntegerValue<T>) {
+        return {T(7), T(2), T(0), static_cast<T>(-1), std::numeric_limits<T>::max(), std::numeric_limits<T>::min()};
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return {T(7), T(-0.5), T(0), std::numeric_limits<T>::max()};
+    } else if constexpr (isComplexKind(numericKindOf<T>)) {
+        return {T(7, 1), T(2, -1), T(0, 0)};
+    } else if constexpr (charTemp<T>) {
+        return {T('A'), T('z'), T(0)};
+    } else if constexpr (isDecimalValue<T>) {
+        return {T(7), T::fromUnits(-5), T(0), T::fromUnits(T::maxUnits), T::fromUnits(T::minUnits)};
+    } else if constexpr (isHalfValue<T>) {
+        return {T(7.0f), T(-0.5f), T(0.0f), T(65504.0f)};
+    } else {
+        return {T(7), T(0), T::fromString("-" + std::string(40, '9'))};
+    }
+}
+
+// Kind and exact text, so two values are the same only when they are bit for bit
+std::string describe(const Numeric& value)
+{
+    std::string text(value.kind() == NumericKind::BigInt ? 1000 : numericFormatBufferSize, '\0');
+    text.resize(value.formatTo(text.data(), text.size()));
+    return std::string(numericKindName(value.kind())) + " " + text;
+}
+
+template <typename Body>
+std::string thrownMessage(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+template <typename T>
+std::unique_ptr<Numeric> box(const T& value)
+{
+    return std::make_unique<NumericClass<numericKindOf<T>>>(value);
+}
+
+template <NumericOp Op, typename A, typename B>
+int arithmeticMismatches(const std::vector<A>& firsts, const std::vector<B>& seconds)
+{
+    int mismatches = 0;
+    if constexpr (NumericSupports<Op, A, B>) {
+        for (const A& a : firsts) {
+            for (const B& b : seconds) {
+                std::unique_ptr<Numeric> expected;
+                const std::string expectedError = thrownMessage([&] { expected = Numeric::apply(Op, *box(a), *box(b)); });
+                std::unique_ptr<Numeric> actual;
+                const std::string error = thrownMessage([&] { actual = box(numericApply<Op>(a, b)); });
+                mismatches += expectedError.empty() && error.empty() ? describe(*actual) != describe(*expected) : error != expectedError;
+            }
+        }
+    } else {
+        // A pair the concepts reject is one the classes reject at run time
+        mismatches += thrownMessage([&] { Numeric::apply(Op, *box(firsts[0]), *box(seconds[0])); }).empty();
+    }
+    return mismatches;
+}
+
+template <NumericOp Op, typename A, typename B>
+int comparisonMismatches(const std::vector<A>& firsts, const std::vector<B>& seconds)
+{
+    int mismatches = 0;
+    if constexpr (NumericComparable<Op, A, B>) {
+        for (const A& a : firsts) {
+            for (const B& b : seconds) {
+                mismatches += numericCompare<Op>(a, b) != Numeric::compare(Op, *box(a), *box(b));
+            }
+        }
+    } else {
+        mismatches += thrownMessage([&] { Numeric::compare(Op, *box(firsts[0]), *box(seconds[0])); }).empty();
+    }
+    return mismatches;
+}
+
+template <typename A, typename B>
+void checkPair()
+{
+    const std::string name = std::string(numericKindName(numericKindOf<A>)) + " and " + numericKindName(numericKindOf<B>);
+    const std::vector<A> firsts = samples<A>();
+    const std::vector<B> seconds = samples<B>();
+    for (const NumericOverflow overflow : {NumericOverflow::Checked, NumericOverflow::Saturate, NumericOverflow::Wrap}) {
+        NumericOverflowScope scope(overflow);
+        const int mismatches = arithmeticMismatches<NumericOp::Sum>(firsts, seconds) + arithmeticMismatches<NumericOp::Subtract>(firsts, seconds) +
+                               arithmeticMismatches<NumericOp::Multiply>(firsts, seconds) + arithmeticMismatches<NumericOp::Divide>(firsts, seconds);
+        check(mismatches == 0, name + " under overflow " + std::to_string(static_cast<int>(overflow)));
+    }
+    check(comparisonMismatches<NumericOp::LessThan>(firsts, seconds) + comparisonMismatches<NumericOp::GreaterThan>(firsts, seconds) +
+                  comparisonMismatches<NumericOp::Equal>(firsts, seconds) == 0,
+          name + " comparisons");
+}
+
+template <std::size_t... I>
+void checkAllPairs(std::index_sequence<I...>)
+{
+    // Each type with itself, with int, uint64_t and double, and after int; all pairs take minutes to compile
+    ((checkPair<std::tuple_element_t<I, Types>, std::tuple_element_t<I, Types>>(), checkPair<std::tuple_element_t<I, Types>, int>(),
+      checkPair<std::tuple_element_t<I, Types>, std::uint64_t>(), checkPair<std::tuple_element_t<I, Types>, double>(),
+      checkPair<int, std::tuple_element_t<I, Types>>()),
+     ...);
+}
+
+} // namespace
+
+int main()
+{
+    checkAllPairs(std::make_index_sequence<std::tuple_size_v<Types>>{});
+
+    // The policy is read on every call, scopes nest and restore, and each thread has its own
+    const int max = std::numeric_limits<int>::max();
+    check(numericOverflowMode() == NumericOverflow::Checked, "checked by default");
+    {
+        NumericOverflowScope wrap(NumericOverflow::Wrap);
+        check(numericAdd(max, 1) == std::numeric_limits<int>::min(), "wrapped");
+        {
+            NumericOverflowScope saturate(NumericOverflow::Saturate);
+            check(numericAdd(max, 1) == max && numericMultiply(std::int8_t(-100), std::int8_t(2)) == -128, "saturated in a nested scope");
+
+            NumericOverflow other = NumericOverflow::Wrap;
+            std::string otherError;
+            std::thread([&] {
+                other = numericOverflowMode();
+                otherError = thrownMessage([&] { numericAdd(max, 1); });
+            }).join();
+            check(other == NumericOverflow::Checked && otherError == "sumOperation: Integer overflow.", "another thread is not affected");
+        }
+        check(numericOverflowMode() == NumericOverflow::Wrap && numericSubtract(std::uint8_t(0), std::uint8_t(1)) == 255,
+              "the outer scope is restored");
+    }
+    check(thrownMessage([&] { numericAdd(max, 1); }) == "sumOperation: Integer overflow." &&
+              thrownMessage([] { numericDivide(1.0, 0.0); }) == "divideOperation: Division by zero is not allowed.",
+          "checked again after the scopes");
+
+    // Constant evaluation is checked whatever the scope
+    NumericOverflowScope wrap(NumericOverflow::Wrap);
+    constexpr int folded = numericAdd(max - 1, 1);
+    check(folded == max, "constant evaluation");
+
+    return checkResult();
+}
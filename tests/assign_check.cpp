@@ -0,0 +1,148 @@
+#include "NumericFormat.hpp"
+#include "check.hpp"
+
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+/**
+ * addAssign / subAssign / mulAssign / divAssign and Numeric::applyAssign against
+ * Numeric::apply for every pair of kinds: a result of the receiver's kind updates the
+ * receiver in place (same object, nullptr returned), a wider result is returned and
+ * leaves the receiver untouched, and an error throws the apply() message without
+ * touching the receiver. Integer overflow follows the NumericOverflow policy in place.
+ */
+namespace {
+
+// A Numeric of kind `kind` holding `n` (as a character code for the character kinds)
+std::unique_ptr<Numeric> make(NumericKind kind, int n)
+{
+    return numericVisitKind(kind, [&]<NumericKind K>() -> std::unique_ptr<Numeric> {
+        using T = NumericKindValue<K>;
+        if constexpr (isComplexKind(K)) {
+            return std::make_unique<NumericClass<K>>(T(n, 1));
+        } else if constexpr (isCharKind(K)) {
+            return std::make_unique<NumericClass<K>>(static_cast<T>(n == 0 ? 0 : 'A' + n));
+        } else {
+            return std::make_unique<NumericClass<K>>(T(n));
+        }
+    }, "assign_check");
+}
+
+// Kind and exact text, so two values are the same only when they are bit for bit
+std::string describe(const Numeric& value)
+{
+    std::string text(value.kind() == NumericKind::BigInt ? 1000 : numericFormatBufferSize, '\0');
+    text.resize(value.formatTo(text.data(), text.size()));
+    return std::string(numericKindName(value.kind())) + " " + text;
+}
+
+template <typename Body>
+std::string thrownMessage(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+std::unique_ptr<Numeric> assign(NumericOp op, Numeric& first, const Numeric& second, bool virtualCall)
+{
+    if (!virtualCall) {
+        return Numeric::applyAssign(op, first, second);
+    }
+    switch (op) {
+        case NumericOp::Sum:      return first.addAssign(second);
+        case NumericOp::Subtract: return first.subAssign(second);
+        case NumericOp::Multiply: return first.mulAssign(second);
+        default:                  return first.divAssign(second);
+    }
+}
+
+// One assignment of `second` into a fresh `first`, checked against apply()
+bool matchesApply(NumericOp op, NumericKind firstKind, int firstValue, const Numeric& second, bool virtualCall)
+{
+    const auto original = make(firstKind, firstValue);
+    std::unique_ptr<Numeric> expected;
+    const std::string expectedError = thrownMessage([&] { expected = Numeric::apply(op, *original, second); });
+
+    const auto receiver = make(firstKind, firstValue);
+    const Numeric* identity = receiver.get();
+    std::unique_ptr<Numeric> widened;
+    const std::string error = thrownMessage([&] { widened = assign(op, *receiver, second, virtualCall); });
+    if (!expectedError.empty() || !error.empty()) {
+        return error == expectedError && describe(*receiver) == describe(*original);
+    }
+    if (expected->kind() == firstKind) {
+        return widened == nullptr && receiver.get() == identity && describe(*receiver) == describe(*expected);
+    }
+    return widened != nullptr && describe(*widened) == describe(*expected) && describe(*receiver) == describe(*original);
+}
+
+} // namespace
+
+int main()
+{
+    // Every pair of kinds and every op, through applyAssign and the virtual methods
+    int computed = 0;
+    int wider = 0;
+    for (std::size_t first = 0; first < numericKindCount; ++first) {
+        for (std::size_t second = 0; second < numericKindCount; ++second) {
+            const auto firstKind = static_cast<NumericKind>(first);
+            const auto secondKind = static_cast<NumericKind>(second);
+            for (std::size_t op = 0; op < numericArithmeticOpCount; ++op) {
+                for (const int divisor : {2, 0}) {
+                    const auto value = make(secondKind, divisor);
+                    for (const bool virtualCall : {false, true}) {
+                        check(matchesApply(static_cast<NumericOp>(op), firstKind, 7, *value, virtualCall),
+                              std::string(numericKindName(firstKind)) + " " + numericOpName(static_cast<NumericOp>(op)) + " " +
+                                  numericKindName(secondKind) + " " + std::to_string(divisor) +
+                                  (virtualCall ? " through the virtual method" : " through applyAssign"));
+                    }
+                }
+                const auto sample = make(firstKind, 7);
+                try {
+                    wider += Numeric::apply(static_cast<NumericOp>(op), *sample, *make(secondKind, 2))->kind() != firstKind;
+                    ++computed;
+                } catch (const std::runtime_error&) {
+                }
+            }
+        }
+    }
+    check(computed > wider && wider > 0, "both in-place and widened results were covered");
+
+    // Overflow in place: the receiver keeps its value when it throws, and takes the policy's result otherwise
+    const int max = std::numeric_limits<int>::max();
+    IntNumeric total(max);
+    check(thrownMessage([&] { total.addAssign(IntNumeric(1)); }) == "sumOperation: Integer overflow." && total.toString() == std::to_string(max),
+          "a checked overflow leaves the receiver as it was");
+    {
+        NumericOverflowScope wrap(NumericOverflow::Wrap);
+        check(total.addAssign(IntNumeric(1)) == nullptr && total.toString() == std::to_string(std::numeric_limits<int>::min()),
+              "a wrapped overflow updates in place");
+    }
+    {
+        NumericOverflowScope saturate(NumericOverflow::Saturate);
+        check(total.subAssign(IntNumeric(1)) == nullptr && total.toString() == std::to_string(std::numeric_limits<int>::min()),
+              "a saturated overflow updates in place");
+    }
+
+    // The usage pattern from the header: accumulate, replacing the receiver only when it widens
+    std::unique_ptr<Numeric> sum = Numeric::create(0);
+    const Numeric* first = sum.get();
+    for (int i = 1; i <= 10; ++i) {
+        if (auto widened = sum->addAssign(IntNumeric(i))) {
+            sum = std::move(widened);
+        }
+    }
+    check(sum.get() == first && sum->toString() == "55", "int += int stays in the same object");
+    if (auto widened = sum->addAssign(FloatNumeric<double>(0.5))) {
+        sum = std::move(widened);
+    }
+    check(sum.get() != first && sum->kind() == NumericKind::Double && describe(*sum) == "double 55.5", "int += double widens");
+
+    return checkResult();
+}
@@ -0,0 +1,176 @@
+#include "NumericFormat.hpp"
+#include "check.hpp"
+
+#include <complex>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Numeric::applyBatch and compareBatch against apply() and compare() element by element,
+ * over runs of mixed kinds: a failing element (division by zero, overflow under the
+ * Checked policy, an unsupported pair) only sets its own bit of the error mask and
+ * leaves a nullptr, every other element gets its exact result, the failure count
+ * matches the mask, and results of the same kind are overwritten in place on reuse.
+ */
+namespace {
+
+// A Numeric of kind `kind` holding `n`, or the largest value of an integer kind when `extreme`
+std::unique_ptr<Numeric> make(NumericKind kind, int n, bool extreme)
+{
+    return numericVisitKind(kind, [&]<NumericKind K>() -> std::unique_ptr<Numeric> {
+        using T = NumericKindValue<K>;
+        if constexpr (isComplexKind(K)) {
+            return std::make_unique<NumericClass<K>>(T(n, 1));
+        } else if constexpr (isCharKind(K)) {
+            return std::make_unique<NumericClass<K>>(static_cast<T>(n == 0 ? 0 : 'A' + n));
+        } else if constexpr (IntegerValue<T>) {
+            return std::make_unique<NumericClass<K>>(extreme ? std::numeric_limits<T>::max() : static_cast<T>(n));
+        } else {
+            return std::make_unique<NumericClass<K>>(T(n));
+        }
+    }, "batch_check");
+}
+
+// Kind and exact text, so two values are the same only when they are bit for bit
+std::string describe(const Numeric& value)
+{
+    std::string text(value.kind() == NumericKind::BigInt ? 1000 : numericFormatBufferSize, '\0');
+    text.resize(value.formatTo(text.data(), text.size()));
+    return std::string(numericKindName(value.kind())) + " " + text;
+}
+
+struct Batch
+{
+    std::vector<std::unique_ptr<Numeric>> owners;
+    std::vector<const Numeric*> first;
+    std::vector<const Numeric*> second;
+
+    void add(std::unique_ptr<Numeric> lhs, std::unique_ptr<Numeric> rhs)
+    {
+        first.push_back(lhs.get());
+        second.push_back(rhs.get());
+        owners.push_back(std::move(lhs));
+        owners.push_back(std::move(rhs));
+    }
+};
+
+// Runs of one random pair of kinds; within a run some divisors are zero and some operands extreme
+Batch randomBatch(std::mt19937_64& random, std::size_t size)
+{
+    Batch batch;
+    while (batch.first.size() < size) {
+        const auto lhsKind = static_cast<NumericKind>(random() % numericKindCount);
+        const auto rhsKind = random() % 3 == 0 ? lhsKind : static_cast<NumericKind>(random() % numericKindCount);
+        const std::size_t run = 1 + random() % 40;
+        for (std::size_t i = 0; i < run && batch.first.size() < size; ++i) {
+            batch.add(make(lhsKind, static_cast<int>(1 + random() % 9), random() % 10 == 0),
+                      make(rhsKind, random() % 12 == 0 ? 0 : static_cast<int>(1 + random() % 9), random() % 10 == 0));
+        }
+    }
+    return batch;
+}
+
+bool matchesApply(NumericOp op, const Batch& batch, std::vector<std::unique_ptr<Numeric>>& out)
+{
+    NumericMask errors;
+    const std::size_t failures = Numeric::applyBatch(op, batch.first, batch.second, out, errors);
+    if (errors.size() != batch.first.size() || failures != errors.count()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < batch.first.size(); ++i) {
+        std::unique_ptr<Numeric> expected;
+        try {
+            expected = Numeric::apply(op, *batch.first[i], *batch.second[i]);
+        } catch (const std::runtime_error&) {
+        }
+        if (expected ? (errors.test(i) || !out[i] || describe(*out[i]) != describe(*expected)) : (!errors.test(i) || out[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool matchesCompare(NumericOp op, const Batch& batch)
+{
+    NumericMask result;
+    NumericMask errors;
+    const std::size_t failures = Numeric::compareBatch(op, batch.first, batch.second, result, errors);
+    if (result.size() != batch.first.size() || errors.size() != batch.first.size() || failures != errors.count()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < batch.first.size(); ++i) {
+        bool expected = false;
+        bool failed = false;
+        try {
+            expected = Numeric::compare(op, *batch.first[i], *batch.second[i]);
+        } catch (const std::runtime_error&) {
+            failed = true;
+        }
+        if (errors.test(i) != failed || (!failed && result.test(i) != expected)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    // Random runs of every kind under each overflow policy
+    std::mt19937_64 random(8);
+    for (const std::size_t size : {0, 1, 7, 500, 3000}) {
+        const Batch batch = randomBatch(random, size);
+        for (const NumericOverflow overflow : {NumericOverflow::Checked, NumericOverflow::Saturate, NumericOverflow::Wrap}) {
+            NumericOverflowScope scope(overflow);
+            const std::string name = " of " + std::to_string(size) + " under overflow " + std::to_string(static_cast<int>(overflow));
+            for (std::size_t op = 0; op < numericArithmeticOpCount; ++op) {
+                std::vector<std::unique_ptr<Numeric>> out(size);
+                check(matchesApply(static_cast<NumericOp>(op), batch, out), std::string(numericOpName(static_cast<NumericOp>(op))) + name);
+                check(matchesApply(static_cast<NumericOp>(op), batch, out), std::string(numericOpName(static_cast<NumericOp>(op))) + " reused" + name);
+            }
+            for (std::size_t op = numericArithmeticOpCount; op < numericOpCount; ++op) {
+                check(matchesCompare(static_cast<NumericOp>(op), batch), std::string(numericOpName(static_cast<NumericOp>(op))) + name);
+            }
+        }
+    }
+
+    // One run of int / int: the zero divisor and the overflow fail alone, the rest are computed in place
+    Batch ints;
+    for (int i = 0; i < 8; ++i) {
+        ints.add(Numeric::create(i == 5 ? std::numeric_limits<int>::min() : 100 + i), Numeric::create(i == 2 ? 0 : i == 5 ? -1 : 4));
+    }
+    std::vector<std::unique_ptr<Numeric>> out(8);
+    for (auto& slot : out) {
+        slot = Numeric::create(0);
+    }
+    std::vector<const Numeric*> reused;
+    for (const auto& slot : out) {
+        reused.push_back(slot.get());
+    }
+    NumericMask errors;
+    check(Numeric::applyBatch(NumericOp::Divide, ints.first, ints.second, out, errors) == 2 && errors.test(2) && errors.test(5) &&
+              !out[2] && !out[5],
+          "the zero divisor and the overflow are flagged");
+    bool othersOk = true;
+    for (int i = 0; i < 8; ++i) {
+        if (i != 2 && i != 5) {
+            othersOk &= !errors.test(i) && out[i].get() == reused[i] && out[i]->toString() == std::to_string((100 + i) / 4);
+        }
+    }
+    check(othersOk, "the other elements are computed into the objects already in out");
+
+    // An unsupported pair fails alone too
+    Batch chars;
+    chars.add(std::make_unique<charNumeric<char>>('a'), std::make_unique<charNumeric<char>>('b'));
+    chars.add(Numeric::create(6), Numeric::create(3));
+    std::vector<std::unique_ptr<Numeric>> product(2);
+    check(Numeric::applyBatch(NumericOp::Multiply, chars.first, chars.second, product, errors) == 1 && errors.test(0) && !product[0] &&
+              product[1]->toString() == "18",
+          "char * char fails without affecting its neighbour");
+
+    return checkResult();
+}
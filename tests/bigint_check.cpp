@@ -0,0 +1,131 @@
+#include "NumericBigInt.hpp"
+#include "NumericFormat.hpp"
+#include "check.hpp"
+
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+/**
+ * NumericBigInt multiply, divide and decimal conversion on both sides of every algorithm
+ * threshold: closed forms first, then random operands against the quadratic algorithms
+ * (every threshold at SIZE_MAX), and values longer than one format buffer written as text.
+ */
+namespace {
+
+std::mt19937_64 random(18);
+
+NumericBigInt powerOf2(std::size_t exponent)
+{
+    NumericBigInt power = 1;
+    for (; exponent >= 32; exponent -= 32) {
+        power *= NumericBigInt(std::uint64_t(1) << 32);
+    }
+    return power * NumericBigInt(std::uint64_t(1) << exponent);
+}
+
+// A random magnitude of exactly `limbs` limbs
+NumericBigInt randomOf(std::size_t limbs)
+{
+    NumericBigInt value;
+    for (std::size_t i = 0; i < limbs; ++i) {
+        const std::uint64_t limb = random() | (i == 0 ? std::uint64_t(1) << 63 : 0);
+        value = value * powerOf2(64) + NumericBigInt(limb);
+    }
+    return value;
+}
+
+std::string powerOf10Text(std::size_t exponent) { return "1" + std::string(exponent, '0'); }
+
+template <typename Body>
+bool throws(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main()
+{
+    auto checkAt = [](bool condition, const char* what, std::size_t size) {
+        check(condition, std::string(what) + " (" + std::to_string(size) + " limbs)");
+    };
+
+    const NumericBigIntThresholds fast = numericBigIntThresholds();
+    NumericBigIntThresholds quadratic;
+    quadratic.karatsuba = quadratic.toom3 = quadratic.division = quadratic.decimal = std::numeric_limits<std::size_t>::max();
+
+    std::vector<std::size_t> sizes = {1, 2, 3};
+    for (std::size_t threshold : {fast.karatsuba, fast.toom3, fast.division, fast.decimal, 2 * fast.division}) {
+        for (std::size_t size : {threshold - 1, threshold, threshold + 1}) {
+            sizes.push_back(size);
+        }
+    }
+
+    for (std::size_t size : sizes) {
+        // (2^64n - 1)^2 = 2^128n - 2^(64n + 1) + 1
+        const NumericBigInt ones = powerOf2(64 * size) - 1;
+        checkAt(ones * ones == powerOf2(128 * size) - powerOf2(64 * size + 1) + 1, "square of all ones", size);
+
+        // 10^k * 10^k = 10^2k, read and written as text; k gives about `size` limbs
+        const std::size_t digits = size * 64 * 3 / 10;
+        const NumericBigInt power = NumericBigInt::fromString(powerOf10Text(digits));
+        checkAt((power * power).toString() == powerOf10Text(2 * digits), "10^k squared as text", size);
+        checkAt((-power * power).toString() == "-" + powerOf10Text(2 * digits), "negative product as text", size);
+        checkAt(power / NumericBigInt::fromString(powerOf10Text(digits / 2)) == NumericBigInt::fromString(powerOf10Text(digits - digits / 2)),
+                "10^k / 10^j", size);
+
+        // (a * b + r) / b == a and % b == r, with the signs of truncating division
+        const NumericBigInt a = randomOf(size + 85);
+        const NumericBigInt b = randomOf(size);
+        const NumericBigInt r = b - 1;
+        NumericBigInt quotient, remainder;
+        NumericBigInt::divide(a * b + r, b, quotient, remainder);
+        checkAt(quotient == a && remainder == r, "(a * b + r) / b", size);
+        checkAt((-(a * b + r)) / b == -a && (-(a * b + r)) % b == -r, "negative dividend", size);
+        checkAt((a * b + r) / -b == -a && (a * b + r) % -b == r, "negative divisor", size);
+        checkAt((-(a * b + r)) / -b == a && (-(a * b + r)) % -b == -r, "both negative", size);
+        checkAt(b / a == 0 && b % a == b, "a smaller dividend", size);
+
+        // The threshold algorithms give the quadratic results
+        const NumericBigInt c = randomOf(size);
+        const NumericBigInt d = -randomOf(size + size / 3 + 1);
+        const NumericBigInt product = c * d;
+        const NumericBigInt dividend = product * c + d;
+        const NumericBigInt fastQuotient = dividend / c;
+        const NumericBigInt fastRemainder = dividend % c;
+        const std::string text = dividend.toString();
+        setNumericBigIntThresholds(quadratic);
+        checkAt(product == c * d, "multiply against schoolbook", size);
+        checkAt(fastQuotient == dividend / c && fastRemainder == dividend % c, "divide against algorithm D", size);
+        checkAt(text == dividend.toString(), "toString against the quadratic conversion", size);
+        setNumericBigIntThresholds(fast);
+        checkAt(NumericBigInt::fromString(text) == dividend, "fromString of toString", size);
+
+        // Zero
+        checkAt((c * 0).isZero() && !(-c * 0).isNegative() && (0 / c).isZero() && (c % c).isZero(), "zero results", size);
+        checkAt(throws([&] { return c / 0; }) && throws([&] { return c % 0; }), "division by zero throws", size);
+    }
+    checkAt(NumericBigInt().toString() == "0" && NumericBigInt::fromString("-0").toString() == "0", "zero as text", 0);
+    checkAt(NumericBigInt(std::numeric_limits<std::int64_t>::min()).toString() == "-9223372036854775808", "int64 min as text", 1);
+
+    // Values longer than numericFormatBufferSize keep every digit through NumericTextWriter
+    const std::string long200 = "-" + std::string(200, '7');
+    NumericColumn<NumericBigInt> column;
+    column.push_back(NumericBigInt::fromString(long200));
+    column.push_back(NumericBigInt(5));
+    NumericTextWriter lines;
+    lines.write(column);
+    checkAt(lines.view() == long200 + "\n5\n", "column of long values as text", 11);
+    NumericTextWriter csv(NumericTextFormat::Csv);
+    csv.writeRows(column, column);
+    checkAt(csv.view() == long200 + "," + long200 + "\n5,5\n", "rows of long values as text", 11);
+
+    return checkResult();
+}
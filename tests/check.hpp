@@ -0,0 +1,26 @@
+#ifndef __NUMERIC_CHECK_HPP__
+#define __NUMERIC_CHECK_HPP__
+
+#include <cstdio>
+#include <string>
+
+/**
+ * The one helper every tests/<name>_check.cpp shares: check() prints each failed
+ * condition, and main() returns checkResult() so ctest sees whether any failed.
+ */
+inline int checkFailures = 0;
+
+inline void check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::printf("FAILED: %s\n", what.c_str());
+        ++checkFailures;
+    }
+}
+
+inline int checkResult()
+{
+    return checkFailures == 0 ? 0 : 1;
+}
+
+#endif // __NUMERIC_CHECK_HPP__
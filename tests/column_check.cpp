@@ -0,0 +1,241 @@
+#include "NumericColumn.hpp"
+#include "check.hpp"
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/**
+ * NumericColumn operations at every forced NumericSimdLevel against Numeric::apply /
+ * Numeric::compare on the boxed elements: all ops, column and broadcast operands,
+ * lengths around every vector width, zero divisors and integer overflow under each
+ * NumericOverflow policy. A column throws exactly when some element throws, with one of
+ * their messages, and otherwise holds the same bits element by element.
+ */
+namespace {
+
+constexpr std::size_t lengths[] = {0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 63, 64, 65, 127, 129, 1000, 1031, 2053};
+
+enum class Values
+{
+    Small,      // no zero and no overflow
+    Edge,       // the type's extremes, no zero
+    Zeros       // the type's extremes and zeros
+};
+
+template <typename T>
+T randomValue(std::mt19937_64& random, Values values)
+{
+    const bool allowZero = values == Values::Zeros;
+    const bool edge = values != Values::Small;
+    if constexpr (IntegerValue<T>) {
+        using Limits = std::numeric_limits<T>;
+        const T picks[] = {Limits::min(), Limits::max(), static_cast<T>(Limits::min() + 1), static_cast<T>(Limits::max() - 1),
+                           static_cast<T>(-1), T(1), T(2)};
+        T value;
+        if (edge && random() % 4 == 0) {
+            value = picks[random() % std::size(picks)];
+        } else if (edge) {
+            value = static_cast<T>(random());
+        } else {
+            value = static_cast<T>(1 + random() % 60);
+            if (std::is_signed_v<T> && random() % 2) {
+                value = static_cast<T>(-value);
+            }
+        }
+        if (value == 0) {
+            value = 1;
+        }
+        return allowZero && random() % 8 == 0 ? T(0) : value;
+    } else if constexpr (isDecimalValue<T>) {
+        using Rep = typename T::rep_type;
+        Rep units = randomValue<std::int64_t>(random, values);
+        if constexpr (sizeof(Rep) > 8) {
+            if (edge && units != 0 && random() % 2) {
+                units = random() % 4 == 0 ? (units < 0 ? T::minUnits : T::maxUnits) : units * static_cast<Rep>(random() | 1);
+            }
+        }
+        return T::fromUnits(units);
+    } else if constexpr (numericKindOf<T> == NumericKind::Char || numericKindOf<T> == NumericKind::WChar ||
+                         numericKindOf<T> == NumericKind::Char16 || numericKindOf<T> == NumericKind::Char32) {
+        return static_cast<T>(allowZero && random() % 8 == 0 ? 0 : 1 + random() % 100);
+    } else if constexpr (isComplexKind(numericKindOf<T>)) {
+        using Part = typename T::value_type;
+        return T(randomValue<Part>(random, values), randomValue<Part>(random, values));
+    } else if constexpr (isHalfValue<T>) {
+        return T(randomValue<float>(random, values));
+    } else {
+        if (allowZero && random() % 8 == 0) {
+            return random() % 2 ? T(0) : -T(0);
+        }
+        const int exponent = edge ? static_cast<int>(random() % 200) - 100 : static_cast<int>(random() % 10) - 5;
+        const T value = std::ldexp(static_cast<T>(1 + random() % 1000000) / T(1000000), exponent);
+        return random() % 2 ? -value : value;
+    }
+}
+
+template <typename T>
+bool sameBits(const T& first, const T& second)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        // Not memcmp: long double has padding bytes
+        return (std::isnan(first) && std::isnan(second)) || (first == second && std::signbit(first) == std::signbit(second));
+    } else if constexpr (isComplexKind(numericKindOf<T>)) {
+        return sameBits(first.real(), second.real()) && sameBits(first.imag(), second.imag());
+    } else if constexpr (isHalfValue<T>) {
+        return sameBits(first.toFloat(), second.toFloat());
+    } else {
+        return first == second;
+    }
+}
+
+template <typename Body>
+std::string thrownMessage(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+// One op on one pair of columns (or a column and rhs[0] when `broadcast`), checked against the elements
+template <typename T>
+bool matchesScalar(NumericOp op, const NumericColumn<T>& lhs, const NumericColumn<T>& rhs, bool broadcast)
+{
+    constexpr NumericKind K = numericKindOf<T>;
+    const bool arithmetic = static_cast<std::size_t>(op) < numericArithmeticOpCount;
+    std::vector<std::unique_ptr<Numeric>> expected(lhs.size());
+    std::vector<bool> expectedBits(lhs.size());
+    std::set<std::string> errors;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        const auto first = lhs.at(i);
+        const auto second = rhs.at(broadcast ? 0 : i);
+        const std::string error = thrownMessage([&] {
+            if (arithmetic) {
+                expected[i] = Numeric::apply(op, *first, *second);
+            } else {
+                expectedBits[i] = Numeric::compare(op, *first, *second);
+            }
+        });
+        if (!error.empty()) {
+            errors.insert(error);
+        }
+    }
+
+    NumericColumn<T> out;
+    NumericMask mask;
+    const std::string error = thrownMessage([&] {
+        const auto run = [&](auto second) {
+            switch (op) {
+                case NumericOp::Sum:         out = lhs.sumOperation(second); break;
+                case NumericOp::Subtract:    out = lhs.subtractOperation(second); break;
+                case NumericOp::Multiply:    out = lhs.multiplyOperation(second); break;
+                case NumericOp::Divide:      out = lhs.divideOperation(second); break;
+                case NumericOp::LessThan:    mask = lhs.lessThanOperation(second); break;
+                case NumericOp::GreaterThan: mask = lhs.greaterThanOperation(second); break;
+                default:                     mask = lhs.equalOperation(second); break;
+            }
+        };
+        if (broadcast) {
+            run(rhs[0]);
+        } else {
+            run(rhs);
+        }
+    });
+    if (lhs.empty()) {
+        // Nothing to compute, but a pair of types the op rejects is still rejected
+        const auto sample = rhs.at(0);
+        return error.empty() || error == thrownMessage([&] { Numeric::apply(op, *sample, *sample); });
+    }
+    if (!errors.empty() || !error.empty()) {
+        // A column reports one error for all elements: one that some element throws
+        return errors.count(error) == 1;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        if (arithmetic ? (expected[i]->kind() != K || !sameBits(numericValueOf<K>(*expected[i]), out[i]))
+                       : mask.test(i) != expectedBits[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void checkColumns(const std::string& name, std::mt19937_64& random)
+{
+    for (const Values values : {Values::Small, Values::Edge, Values::Zeros}) {
+        for (const std::size_t length : lengths) {
+            NumericColumn<T> lhs;
+            NumericColumn<T> rhs;
+            for (std::size_t i = 0; i < length; ++i) {
+                lhs.push_back(randomValue<T>(random, values));
+                rhs.push_back(randomValue<T>(random, values));
+            }
+            if (rhs.empty()) {
+                rhs.push_back(T(randomValue<T>(random, Values::Small)));
+            }
+            for (const NumericOverflow overflow : {NumericOverflow::Checked, NumericOverflow::Saturate, NumericOverflow::Wrap}) {
+                NumericOverflowScope scope(overflow);
+                for (std::size_t op = 0; op < numericOpCount; ++op) {
+                    for (const bool broadcast : {false, true}) {
+                        if (!broadcast && rhs.size() != lhs.size()) {
+                            continue;
+                        }
+                        check(matchesScalar(static_cast<NumericOp>(op), lhs, rhs, broadcast),
+                              name + " op " + std::to_string(op) + " length " + std::to_string(length) + " values " +
+                                  std::to_string(static_cast<int>(values)) + " overflow " +
+                                  std::to_string(static_cast<int>(overflow)) + (broadcast ? " broadcast" : ""));
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    const NumericSimdLevel supported = numericSimdLevel();
+    for (const NumericSimdLevel level : {NumericSimdLevel::Scalar, NumericSimdLevel::Avx2, NumericSimdLevel::Avx512}) {
+        if (level > supported) {
+            continue;
+        }
+        setNumericSimdLevel(level);
+        check(numericSimdLevel() == level, "forced SIMD level");
+        const std::string at = " at level " + std::to_string(static_cast<int>(level));
+        std::mt19937_64 random(3);
+
+        checkColumns<int>("int" + at, random);
+        checkColumns<std::int8_t>("int8" + at, random);
+        checkColumns<std::int16_t>("int16" + at, random);
+        checkColumns<std::int64_t>("int64" + at, random);
+        checkColumns<std::uint8_t>("uint8" + at, random);
+        checkColumns<std::uint16_t>("uint16" + at, random);
+        checkColumns<std::uint32_t>("uint32" + at, random);
+        checkColumns<std::uint64_t>("uint64" + at, random);
+        checkColumns<float>("float" + at, random);
+        checkColumns<double>("double" + at, random);
+        checkColumns<long double>("long double" + at, random);
+        checkColumns<std::complex<float>>("complex float" + at, random);
+        checkColumns<std::complex<double>>("complex double" + at, random);
+        checkColumns<char>("char" + at, random);
+        checkColumns<char32_t>("char32" + at, random);
+        checkColumns<NumericDecimal2>("Decimal2" + at, random);
+        checkColumns<NumericDecimal6>("Decimal6" + at, random);
+        checkColumns<NumericDecimal18>("Decimal18" + at, random);
+        checkColumns<NumericFloat16>("float16" + at, random);
+        checkColumns<NumericBFloat16>("bfloat16" + at, random);
+    }
+    setNumericSimdLevel(supported);
+
+    return checkResult();
+}
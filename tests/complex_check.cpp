@@ -0,0 +1,134 @@
+#include "NumericComplex.hpp"
+#include "check.hpp"
+
+#include <bit>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * NumericComplexColumn in Strict mode against std::complex, bit for bit: multiply,
+ * divide, multiply-accumulate and magnitude of float and double columns over special
+ * operands (zeros, infinities, NaN, denormals, the extremes) and random ones of every
+ * magnitude. A build flag that lets the compiler contract a * b + c into an FMA in
+ * NumericComplex.cpp shows up here.
+ */
+namespace {
+
+// Same bits, or both NaN (the payload of a NaN result is not part of the promise)
+template <typename F>
+bool same(F first, F second)
+{
+    if (std::isnan(first) && std::isnan(second)) {
+        return true;
+    }
+    return std::bit_cast<std::conditional_t<sizeof(F) == 4, std::uint32_t, std::uint64_t>>(first) ==
+           std::bit_cast<std::conditional_t<sizeof(F) == 4, std::uint32_t, std::uint64_t>>(second);
+}
+
+template <typename F>
+bool same(std::complex<F> first, std::complex<F> second)
+{
+    return same(first.real(), second.real()) && same(first.imag(), second.imag());
+}
+
+template <typename F>
+std::vector<F> specialParts()
+{
+    using Limits = std::numeric_limits<F>;
+    std::vector<F> parts = {F(0), F(1), F(-2.5), F(3), Limits::infinity(), Limits::quiet_NaN(), Limits::denorm_min(),
+                            Limits::min(), Limits::max(), Limits::epsilon(), std::sqrt(Limits::max()), F(1) / std::sqrt(Limits::max())};
+    const std::size_t count = parts.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        parts.push_back(-parts[i]);
+    }
+    return parts;
+}
+
+template <typename F>
+F randomPart(std::mt19937_64& random)
+{
+    const int range = std::numeric_limits<F>::max_exponent - std::numeric_limits<F>::min_exponent;
+    const F significand = static_cast<F>(random() >> 11) / static_cast<F>(std::uint64_t(1) << 53);
+    const F value = std::ldexp(significand, static_cast<int>(random() % range) + std::numeric_limits<F>::min_exponent);
+    return random() & 1 ? -value : value;
+}
+
+template <typename F>
+void checkStrict(const std::string& name)
+{
+    // Every pair of special values, then random operands
+    const std::vector<F> parts = specialParts<F>();
+    std::vector<std::complex<F>> values;
+    for (const F re : parts) {
+        for (const F im : parts) {
+            values.emplace_back(re, im);
+        }
+    }
+    NumericComplexColumn<F> lhs;
+    NumericComplexColumn<F> rhs;
+    for (const std::complex<F> first : values) {
+        for (const std::complex<F> second : values) {
+            lhs.push_back(first);
+            rhs.push_back(second);
+        }
+    }
+    std::mt19937_64 random(15);
+    for (int i = 0; i < 100000; ++i) {
+        lhs.push_back({randomPart<F>(random), randomPart<F>(random)});
+        rhs.push_back({randomPart<F>(random), randomPart<F>(random)});
+    }
+
+    // A divisor with both parts zero throws, so the divide runs on the others
+    NumericComplexColumn<F> dividends;
+    NumericComplexColumn<F> divisors;
+    for (std::size_t i = 0; i < rhs.size(); ++i) {
+        if (rhs[i] != std::complex<F>(0, 0)) {
+            dividends.push_back(lhs[i]);
+            divisors.push_back(rhs[i]);
+        }
+    }
+
+    const NumericComplexColumn<F> product = lhs.multiplyOperation(rhs);
+    const NumericComplexColumn<F> quotient = dividends.divideOperation(divisors);
+    const NumericColumn<F> magnitude = lhs.magnitude();
+    NumericComplexColumn<F> accumulated = rhs;
+    accumulated.multiplyAccumulate(lhs, rhs);
+
+    int productErrors = 0, quotientErrors = 0, magnitudeErrors = 0, accumulateErrors = 0;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        productErrors += !same(product[i], lhs[i] * rhs[i]);
+        magnitudeErrors += !same(magnitude[i], std::abs(lhs[i]));
+        accumulateErrors += !same(accumulated[i], rhs[i] + lhs[i] * rhs[i]);
+    }
+    for (std::size_t i = 0; i < dividends.size(); ++i) {
+        quotientErrors += !same(quotient[i], dividends[i] / divisors[i]);
+    }
+    check(productErrors == 0, name + " multiply: " + std::to_string(productErrors) + " differ from std::complex");
+    check(quotientErrors == 0, name + " divide: " + std::to_string(quotientErrors) + " differ from std::complex");
+    check(magnitudeErrors == 0, name + " magnitude: " + std::to_string(magnitudeErrors) + " differ from std::abs");
+    check(accumulateErrors == 0, name + " multiplyAccumulate: " + std::to_string(accumulateErrors) + " differ from std::complex");
+
+    // One operand broadcast to the whole column
+    for (const std::complex<F> scalar : {values[3 * parts.size() + 2], std::complex<F>(randomPart<F>(random), randomPart<F>(random))}) {
+        const NumericComplexColumn<F> scaled = lhs.multiplyOperation(scalar);
+        const NumericComplexColumn<F> divided = lhs.divideOperation(scalar);
+        int errors = 0;
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            errors += !same(scaled[i], lhs[i] * scalar) + !same(divided[i], lhs[i] / scalar);
+        }
+        check(errors == 0, name + " multiply and divide by a scalar: " + std::to_string(errors) + " differ from std::complex");
+    }
+}
+
+} // namespace
+
+int main()
+{
+    checkStrict<float>("float");
+    checkStrict<double>("double");
+    return checkResult();
+}
@@ -0,0 +1,151 @@
+#include "NumericCompress.hpp"
+#include "NumericReduce.hpp"
+#include "check.hpp"
+
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Every encoding of NumericCompressedColumn over constant, sorted, random and
+ * extreme-value columns: the decoded rows keep their bits, and at(), the comparisons
+ * and sum / min / max on the encoded form match the same operations on the decoded column.
+ */
+namespace {
+
+template <typename T>
+bool sameBits(const T& first, const T& second)
+{
+    return std::memcmp(&first, &second, sizeof(T)) == 0;
+}
+
+bool sameMask(const NumericMask& first, const NumericMask& second)
+{
+    return first.size() == second.size() && std::memcmp(first.words(), second.words(), first.wordCount() * sizeof(std::uint64_t)) == 0;
+}
+
+// The result of body(), or the message it threw
+template <typename Body>
+std::string outcome(const Body& body)
+{
+    try {
+        const auto value = body();
+        char text[64];
+        std::memcpy(text, &value, sizeof(value));
+        return std::string(text, sizeof(value));
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+}
+
+template <typename T>
+void checkColumn(const NumericColumn<T>& column, const std::string& input)
+{
+    constexpr NumericEncoding encodings[] = {NumericEncoding::Plain,     NumericEncoding::Dictionary,       NumericEncoding::RunLength,
+                                             NumericEncoding::Delta,     NumericEncoding::FrameOfReference, NumericEncoding::Xor,
+                                             NumericEncoding::Automatic};
+    for (NumericEncoding encoding : encodings) {
+        if (!NumericCompressedColumn<T>::supports(encoding)) {
+            continue;
+        }
+        const std::string name = input + " " + numericEncodingName(encoding) + " " + std::to_string(column.size()) + " rows of " +
+                                 numericKindName(numericKindOf<T>);
+        const NumericCompressedColumn<T> compressed(column, encoding);
+        check(encoding == NumericEncoding::Automatic || compressed.encoding() == encoding, name + ": encoding");
+
+        const NumericColumn<T> decoded = compressed.decode();
+        bool roundTrip = decoded.size() == column.size();
+        for (std::size_t row = 0; roundTrip && row < column.size(); ++row) {
+            roundTrip = sameBits(decoded[row], column[row]) && sameBits(compressed.at(row), column[row]);
+        }
+        check(roundTrip, name + ": round trip and at()");
+        if (column.size() > 100) {
+            T middle[50];
+            compressed.decode(column.size() / 2 - 25, 50, middle);
+            check(std::memcmp(middle, decoded.data() + column.size() / 2 - 25, sizeof(middle)) == 0, name + ": decode of a range");
+        }
+        if (column.empty()) {
+            continue;
+        }
+
+        const T probes[] = {column[0], column[column.size() / 2], column[column.size() - 1], std::numeric_limits<T>::lowest(),
+                            std::numeric_limits<T>::max(), T(0), T(1)};
+        for (T probe : probes) {
+            check(sameMask(compressed.lessThanOperation(probe), decoded.lessThanOperation(probe)), name + ": less than");
+            check(sameMask(compressed.greaterThanOperation(probe), decoded.greaterThanOperation(probe)), name + ": greater than");
+            check(sameMask(compressed.equalOperation(probe), decoded.equalOperation(probe)), name + ": equal");
+        }
+        if constexpr (!charTemp<T>) {
+            check(sameBits(compressed.min(), numericMin(decoded)), name + ": min");
+            check(sameBits(compressed.max(), numericMax(decoded)), name + ": max");
+        }
+        if constexpr (IntegerValue<T>) {
+            check(outcome([&] { return compressed.sum(); }) == outcome([&] { return numericSum(decoded); }), name + ": sum");
+        }
+    }
+}
+
+template <typename T>
+void checkType(std::mt19937_64& random, const std::vector<T>& special)
+{
+    using Limits = std::numeric_limits<T>;
+    for (std::size_t rows : {std::size_t(0), std::size_t(1), std::size_t(1023), std::size_t(5000)}) {
+        NumericColumn<T> constant(rows, T(7));
+        checkColumn(constant, "constant");
+
+        NumericColumn<T> sorted(rows);
+        NumericColumn<T> randomValues(rows);
+        NumericColumn<T> extremes(rows);
+        NumericColumn<T> runs(rows);
+        for (std::size_t row = 0; row < rows; ++row) {
+            if constexpr (std::is_floating_point_v<T>) {
+                sorted[row] = static_cast<T>(row) * T(0.25) - T(100);
+                randomValues[row] = std::bit_cast<T>(static_cast<std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>(random()));
+            } else {
+                sorted[row] = static_cast<T>(Limits::lowest() / 2 + static_cast<T>(row % 100) + static_cast<T>(row / 100) * 3);
+                randomValues[row] = static_cast<T>(random());
+            }
+            extremes[row] = row % 3 == 0 ? Limits::lowest() : row % 3 == 1 ? Limits::max() : special[row % special.size()];
+            runs[row] = static_cast<T>(row / 300);
+        }
+        checkColumn(sorted, "sorted");
+        checkColumn(randomValues, "random");
+        checkColumn(extremes, "extreme");
+        checkColumn(runs, "runs");
+    }
+}
+
+void checkTypes()
+{
+    std::mt19937_64 random(23);
+    checkType<std::int8_t>(random, {0, -1, 1});
+    checkType<int>(random, {0, -1, 1});
+    checkType<std::int64_t>(random, {0, -1, 1});
+    checkType<std::uint16_t>(random, {0, 1});
+    checkType<std::uint64_t>(random, {0, 1});
+    checkType<char>(random, {'a', '\0'});
+    checkType<char32_t>(random, {U'a', U'\0'});
+
+    // Doubles keep -0.0 and the sign and payload of NaNs
+    const double nan = std::bit_cast<double>(std::uint64_t(0x7FF8000000000123));
+    const double negativeNaN = std::bit_cast<double>(std::uint64_t(0xFFF0000000000001));
+    checkType<double>(random, {-0.0, 0.0, nan, negativeNaN, std::numeric_limits<double>::infinity(), std::numeric_limits<double>::denorm_min()});
+    checkType<float>(random, {-0.0f, std::bit_cast<float>(0x7FC00001u), -std::numeric_limits<float>::infinity()});
+}
+
+} // namespace
+
+int main()
+{
+    // The scalar unpacking, then the gathers of each level the CPU has
+    for (NumericSimdLevel level : {NumericSimdLevel::Scalar, NumericSimdLevel::Avx2, NumericSimdLevel::Avx512}) {
+        setNumericSimdLevel(level);
+        if (numericSimdLevel() == level) {
+            checkTypes();
+        }
+    }
+    return checkResult();
+}
@@ -0,0 +1,200 @@
+#include "Numeric.hpp"
+#include "check.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+
+/**
+ * Floating-point values scaled to decimals (numericScaleFloating and the NumericDecimal
+ * constructors) against a reference that rounds the exact decimal expansion of the value,
+ * printed by printf: halfway values under every NumericRounding mode, values at the
+ * Decimal2/6/18 limits, and values the old multiply-in-long-double path rounded twice.
+ * The way back, decimal to float and double, is checked against strtof/strtod of the text.
+ */
+namespace {
+
+constexpr NumericRounding roundings[] = {NumericRounding::HalfEven, NumericRounding::HalfUp, NumericRounding::TowardZero,
+                                         NumericRounding::Floor, NumericRounding::Ceiling};
+
+std::string text(long double value)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.21Lg", value);
+    return buffer;
+}
+
+// |value| * 10^scale rounded as `rounding` says, from the exact digits; nothing when past 128 bits
+std::optional<NumericUInt128> reference(long double value, unsigned scale, NumericRounding rounding)
+{
+    if (!std::isfinite(value)) {
+        return std::nullopt;
+    }
+    static char digits[20000];
+    std::snprintf(digits, sizeof(digits), "%.1200Lf", std::fabs(value));
+    const std::string exact = digits;
+    const std::size_t point = exact.find('.');
+
+    NumericUInt128 magnitude = 0;
+    const std::string kept = exact.substr(0, point) + exact.substr(point + 1, scale);
+    for (const char digit : kept) {
+        if (magnitude > (~NumericUInt128(0) - 9) / 10) {
+            return std::nullopt;
+        }
+        magnitude = magnitude * 10 + static_cast<unsigned>(digit - '0');
+    }
+
+    // The dropped digits against one half: -1 below, 0 exactly half, 1 above; `inexact` unless all zero
+    const std::string dropped = exact.substr(point + 1 + scale);
+    const bool inexact = dropped.find_first_not_of('0') != std::string::npos;
+    int half = -1;
+    if (!dropped.empty() && dropped[0] >= '5') {
+        half = dropped[0] > '5' || dropped.find_first_not_of('0', 1) != std::string::npos ? 1 : 0;
+    }
+
+    const bool negative = value < 0;
+    bool away = false;
+    switch (rounding) {
+        case NumericRounding::HalfEven:   away = half > 0 || (half == 0 && (magnitude & 1) != 0); break;
+        case NumericRounding::HalfUp:     away = half >= 0; break;
+        case NumericRounding::TowardZero: away = false; break;
+        case NumericRounding::Floor:      away = negative && inexact; break;
+        case NumericRounding::Ceiling:    away = !negative && inexact; break;
+    }
+    if (away && magnitude == ~NumericUInt128(0)) {
+        return std::nullopt;
+    }
+    return magnitude + away;
+}
+
+void checkScale(long double value, unsigned scale)
+{
+    for (const NumericRounding rounding : roundings) {
+        const std::optional<NumericUInt128> expected = reference(value, scale, rounding);
+        NumericUInt128 magnitude = 0;
+        const bool fits = numericScaleFloating(value, scale, rounding, magnitude);
+        check(fits == expected.has_value() && (!fits || magnitude == *expected),
+              "numericScaleFloating " + text(value) + " scale " + std::to_string(scale) + " rounding " +
+                  std::to_string(static_cast<int>(rounding)));
+    }
+}
+
+// NumericDecimal(value): half-even, clamped to the limits, NaN as zero
+template <typename D, typename T>
+void checkConstructor(T value)
+{
+    typename D::rep_type units = 0;
+    if (value == value) {
+        const std::optional<NumericUInt128> magnitude = reference(value, D::scale, NumericRounding::HalfEven);
+        const bool negative = value < 0;
+        if (magnitude && *magnitude <= static_cast<NumericUInt128>(D::maxUnits) + negative) {
+            units = static_cast<typename D::rep_type>(negative ? NumericUInt128(0) - *magnitude : *magnitude);
+        } else {
+            units = negative ? D::minUnits : D::maxUnits;
+        }
+    }
+    check(D(value).units == units, "NumericDecimal<" + std::to_string(D::scale) + ">(" + text(value) + ")");
+}
+
+template <typename T>
+void checkAll(T value)
+{
+    checkConstructor<NumericDecimal2>(value);
+    checkConstructor<NumericDecimal6>(value);
+    checkConstructor<NumericDecimal18>(value);
+    for (const unsigned scale : {0u, 2u, 6u, 18u}) {
+        checkScale(value, scale);
+    }
+}
+
+// value * unit in long double, then rounded half-even: what the constructor did before
+template <typename D>
+NumericInt128 doubleRounded(long double value)
+{
+    return static_cast<NumericInt128>(std::nearbyint(value * static_cast<long double>(D::unit)));
+}
+
+// static_cast<float/double> of a decimal against the correctly rounded parse of its text;
+// true when the old divide in long double gives another double
+template <typename D>
+bool checkToFloating(typename D::rep_type units)
+{
+    const D value = D::fromUnits(units);
+    const std::string digits = value.toString();
+    const double expected = std::strtod(digits.c_str(), nullptr);
+    check(static_cast<double>(value) == expected, "double(NumericDecimal<" + std::to_string(D::scale) + "> " + digits + ")");
+    check(static_cast<float>(value) == std::strtof(digits.c_str(), nullptr), "float(NumericDecimal<" + std::to_string(D::scale) + "> " + digits + ")");
+    return static_cast<double>(static_cast<long double>(units) / static_cast<long double>(D::unit)) != expected;
+}
+
+} // namespace
+
+int main()
+{
+    // Halfway values: n + 1/2 units of every scale that binary holds exactly, both signs
+    for (const long double value : {0.5L, 1.5L, 2.5L, 3.5L, 0.125L, 0.375L, 0.625L, 0.875L, 1.125L, 0.0078125L, 0.0234375L,
+                                    0x1p-19L, 0x3p-19L, 0x1p-61L, 0x3p-61L, 0x5p-62L, 1e15L + 0.5L, 4503599627370495.5L}) {
+        checkAll(value);
+        checkAll(-value);
+        checkAll(static_cast<double>(value));
+        checkAll(static_cast<float>(-value));
+    }
+
+    // Just inside, at and past the limits of each scale
+    for (const long double limit : {9223372036854775807.0L / 100, 9223372036854775807.0L / 1000000, 170141183460469231731.687303715884105727L}) {
+        long double up = limit;
+        long double down = limit;
+        for (int step = 0; step < 4; ++step) {
+            for (const long double value : {up, down, -up, -down}) {
+                checkAll(value);
+                checkAll(static_cast<double>(value));
+            }
+            up = std::nextafter(up, std::numeric_limits<long double>::infinity());
+            down = std::nextafter(down, 0.0L);
+        }
+    }
+    for (const double value : {0.0, -0.0, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                               std::numeric_limits<double>::quiet_NaN(), 1e300, -1e300, 5e-324}) {
+        checkConstructor<NumericDecimal2>(value);
+        checkConstructor<NumericDecimal18>(value);
+    }
+
+    // Random magnitudes; count the values the long double multiply used to round twice
+    std::mt19937_64 random(19);
+    int doubleRoundedCases = 0;
+    for (int i = 0; i < 5000; ++i) {
+        const double value = std::ldexp(static_cast<double>(random() >> 11), static_cast<int>(random() % 120) - 110) * (random() & 1 ? -1 : 1);
+        checkAll(value);
+        checkAll(static_cast<float>(value));
+        checkAll(std::ldexp(static_cast<long double>(random()), static_cast<int>(random() % 100) - 90));
+        if (std::fabs(value) < 1e20 && doubleRounded<NumericDecimal18>(value) != NumericDecimal18(value).units) {
+            ++doubleRoundedCases;
+        }
+    }
+    check(doubleRoundedCases > 0, "some values round differently through a long double multiply");
+
+    // Decimal to double and float rounds once, from the exact quotient
+    int twiceRoundedCases = 0;
+    for (int i = 0; i < 200000; ++i) {
+        const std::int64_t narrow = static_cast<std::int64_t>(random() >> (random() % 64));
+        const NumericInt128 wide = (static_cast<NumericInt128>(narrow) << (random() % 63)) | static_cast<NumericInt128>(random() >> 1);
+        twiceRoundedCases += checkToFloating<NumericDecimal6>(random() & 1 ? -narrow : narrow);
+        twiceRoundedCases += checkToFloating<NumericDecimal18>(random() & 1 ? -wide : wide);
+        checkToFloating<NumericDecimal2>(narrow);
+    }
+    check(twiceRoundedCases > 0, "some decimals round differently through a long double divide");
+    check(static_cast<double>(NumericDecimal6::fromUnits(7296304526804397949)) == 7296304526804.397, "double(NumericDecimal6 7296304526804.397949)");
+    checkToFloating<NumericDecimal2>(0);
+    checkToFloating<NumericDecimal18>(NumericDecimal18::maxUnits);
+    checkToFloating<NumericDecimal18>(NumericDecimal18::minUnits);
+    checkToFloating<NumericDecimal6>(NumericDecimal6::minUnits);
+
+    check(NumericDecimal18(12.3).toString() == "12.300000000000000711", "NumericDecimal18(12.3)");
+    check(NumericDecimal2(0.125).toString() == "0.12" && NumericDecimal2(-0.375).toString() == "-0.38", "NumericDecimal2 ties to even");
+
+    return checkResult();
+}
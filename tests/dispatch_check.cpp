@@ -0,0 +1,66 @@
+#include "Numeric.hpp"
+#include "NumericColumn.hpp"
+#include "check.hpp"
+
+#include <memory>
+#include <stdexcept>
+
+// The scalar dispatch entry points reject an op of the other family instead of indexing past their table
+namespace {
+
+template <typename Body>
+bool rejects(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main()
+{
+    const auto a = Numeric::create(6);
+    const auto b = Numeric::create(2.5);
+    auto target = Numeric::create(6);
+
+    for (NumericOp op : {NumericOp::LessThan, NumericOp::GreaterThan, NumericOp::Equal, NumericOp::Count}) {
+        check(rejects([&] { Numeric::apply(op, *a, *b); }), "apply rejects a comparison");
+        check(rejects([&] { Numeric::applyAssign(op, *target, *b); }), "applyAssign rejects a comparison");
+    }
+    for (NumericOp op : {NumericOp::Sum, NumericOp::Subtract, NumericOp::Multiply, NumericOp::Divide, NumericOp::Count}) {
+        check(rejects([&] { Numeric::compare(op, *a, *b); }), "compare rejects an arithmetic op");
+    }
+    check(target->toString() == "6", "a rejected applyAssign leaves its target alone");
+
+    // An op past NumericOp::Count is rejected by every entry point, batch or scalar
+    const NumericOp beyond = static_cast<NumericOp>(static_cast<int>(NumericOp::Count) + 5);
+    const Numeric* firsts[] = {a.get()};
+    const Numeric* seconds[] = {b.get()};
+    std::unique_ptr<Numeric> out[1];
+    NumericMask result;
+    NumericMask errors;
+    check(rejects([&] { Numeric::apply(beyond, *a, *b); }), "apply rejects an op past Count");
+    check(rejects([&] { Numeric::compare(beyond, *a, *b); }), "compare rejects an op past Count");
+    check(rejects([&] { Numeric::applyBatch(beyond, firsts, seconds, out, errors); }), "applyBatch rejects an op past Count");
+    check(rejects([&] { Numeric::compareBatch(beyond, firsts, seconds, result, errors); }), "compareBatch rejects an op past Count");
+
+    // So does convertTo for a kind at or past NumericKind::Count
+    for (const int past : {0, 1, 200}) {
+        bool threw = false;
+        try {
+            a->convertTo(static_cast<NumericKind>(static_cast<int>(NumericKind::Count) + past));
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        check(threw, "convertTo rejects a kind past Count");
+    }
+
+    check(Numeric::apply(NumericOp::Sum, *a, *b)->toString() == Numeric::create(8.5)->toString(), "apply of an arithmetic op");
+    check(Numeric::compare(NumericOp::GreaterThan, *a, *b) && !Numeric::compare(NumericOp::Equal, *a, *b), "compare of a comparison");
+
+    return checkResult();
+}
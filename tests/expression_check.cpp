@@ -0,0 +1,181 @@
+#include "NumericExpression.hpp"
+#include "check.hpp"
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * numericEvaluate() against the same expression done step by step with Numeric::apply,
+ * element by element: mixed kinds, broadcast scalars and Numeric objects, division by
+ * zero (including the vectorized float divide path, which does not go through the
+ * kernel's early return) and integer overflow under each NumericOverflow policy. The
+ * results must be the same kind and the same bits, and an error must be the same
+ * message as the first element that fails step by step.
+ */
+namespace {
+
+template <typename T>
+bool same(const T& first, const T& second)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        return (std::isnan(first) && std::isnan(second)) || (first == second && std::signbit(first) == std::signbit(second));
+    } else if constexpr (isComplexKind(numericKindOf<T>)) {
+        return same(first.real(), second.real()) && same(first.imag(), second.imag());
+    } else {
+        return first == second;
+    }
+}
+
+template <typename Body>
+std::string thrownMessage(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+std::unique_ptr<Numeric> apply(NumericOp op, const std::unique_ptr<Numeric>& first, const std::unique_ptr<Numeric>& second)
+{
+    return Numeric::apply(op, *first, *second);
+}
+
+// build() makes the expression, chain(i) computes element i with Numeric::apply
+template <typename Build, typename Chain>
+bool matchesChain(const Build& build, const Chain& chain, std::size_t count)
+{
+    using T = typename decltype(build())::value_type;
+    constexpr NumericKind K = numericKindOf<T>;
+    std::vector<std::unique_ptr<Numeric>> expected;
+    std::string expectedError;
+    for (std::size_t i = 0; i < count && expectedError.empty(); ++i) {
+        expectedError = thrownMessage([&] { expected.push_back(chain(i)); });
+    }
+
+    NumericColumn<T> out;
+    const std::string error = thrownMessage([&] { out = numericEvaluate(build()); });
+    if (!expectedError.empty() || !error.empty()) {
+        return error == expectedError;
+    }
+    if (out.size() != count) {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        if (expected[i]->kind() != K || !same(numericValueOf<K>(*expected[i]), out[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double randomDouble(std::mt19937_64& random)
+{
+    const double value = std::ldexp(static_cast<double>(random() >> 11), static_cast<int>(random() % 80) - 93);
+    return random() & 1 ? -value : value;
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937_64 random(9);
+    for (const std::size_t count : {1, 5, 64, 333}) {
+        for (const bool zeros : {false, true}) {
+            NumericColumn<int> a;
+            NumericColumn<double> b;
+            NumericColumn<float> c;
+            NumericColumn<double> d;
+            NumericColumn<std::int64_t> e;
+            NumericColumn<std::uint8_t> f;
+            NumericColumn<std::complex<double>> g;
+            NumericColumn<NumericDecimal2> h;
+            for (std::size_t i = 0; i < count; ++i) {
+                const bool zero = zeros && random() % 16 == 0;
+                a.push_back(static_cast<int>(random() % 2001) - 1000);
+                b.push_back(randomDouble(random));
+                c.push_back(zero ? -0.0f : static_cast<float>(randomDouble(random)));
+                d.push_back(zero && random() % 2 ? 0.0 : randomDouble(random));
+                e.push_back(zero ? 0 : static_cast<std::int64_t>(random() % 100000) - 50000);
+                f.push_back(static_cast<std::uint8_t>(random()));
+                g.push_back({randomDouble(random), randomDouble(random)});
+                h.push_back(NumericDecimal2::fromUnits(static_cast<std::int64_t>(random() % 2000000) - 1000000));
+            }
+            const std::string name = " of " + std::to_string(count) + (zeros ? " with zero divisors" : "");
+
+            check(matchesChain([&] { return a * b + 2.5f / d; },
+                               [&](std::size_t i) {
+                                   return apply(NumericOp::Sum, apply(NumericOp::Multiply, a.at(i), b.at(i)),
+                                                apply(NumericOp::Divide, Numeric::create(2.5f), d.at(i)));
+                               },
+                               count),
+                  "int * double + float / double" + name);
+            check(matchesChain([&] { return b / c - d / b; },
+                               [&](std::size_t i) {
+                                   return apply(NumericOp::Subtract, apply(NumericOp::Divide, b.at(i), c.at(i)),
+                                                apply(NumericOp::Divide, d.at(i), b.at(i)));
+                               },
+                               count),
+                  "double / float - double / double" + name);
+            check(matchesChain([&] { return (e + a) / e * f; },
+                               [&](std::size_t i) {
+                                   return apply(NumericOp::Multiply, apply(NumericOp::Divide, apply(NumericOp::Sum, e.at(i), a.at(i)), e.at(i)),
+                                                f.at(i));
+                               },
+                               count),
+                  "(int64 + int) / int64 * uint8" + name);
+            check(matchesChain([&] { return numericOperand(IntNumeric(7)) / a * c; },
+                               [&](std::size_t i) {
+                                   return apply(NumericOp::Multiply, apply(NumericOp::Divide, Numeric::create(7), a.at(i)), c.at(i));
+                               },
+                               count),
+                  "IntNumeric / int * float" + name);
+            check(matchesChain([&] { return g * b / d + g; },
+                               [&](std::size_t i) {
+                                   return apply(NumericOp::Sum, apply(NumericOp::Divide, apply(NumericOp::Multiply, g.at(i), b.at(i)), d.at(i)),
+                                                g.at(i));
+                               },
+                               count),
+                  "complex * double / double + complex" + name);
+            check(matchesChain([&] { return h * h - h / e; },
+                               [&](std::size_t i) {
+                                   return apply(NumericOp::Subtract, apply(NumericOp::Multiply, h.at(i), h.at(i)),
+                                                apply(NumericOp::Divide, h.at(i), e.at(i)));
+                               },
+                               count),
+                  "Decimal2 * Decimal2 - Decimal2 / int64" + name);
+
+            // Integer overflow under each policy, read when the evaluation starts
+            NumericColumn<int> big(count, std::numeric_limits<int>::max() - 3);
+            for (const NumericOverflow overflow : {NumericOverflow::Checked, NumericOverflow::Saturate, NumericOverflow::Wrap}) {
+                NumericOverflowScope scope(overflow);
+                check(matchesChain([&] { return big + a * a; },
+                                   [&](std::size_t i) {
+                                       return apply(NumericOp::Sum, big.at(i), apply(NumericOp::Multiply, a.at(i), a.at(i)));
+                                   },
+                                   count),
+                      "int + int * int under overflow " + std::to_string(static_cast<int>(overflow)) + name);
+            }
+        }
+    }
+
+    // All-scalar expressions give one value; mismatched columns throw when the expression is built
+    const double scalar = numericEvaluate(numericOperand(IntNumeric(3)) / 2.0);
+    check(scalar == 1.5, "IntNumeric / double as a value");
+    check(thrownMessage([] { numericEvaluate(numericOperand(IntNumeric(3)) / 0.0); }) ==
+              thrownMessage([] { Numeric::apply(NumericOp::Divide, IntNumeric(3), FloatNumeric<double>(0.0)); }),
+          "a scalar division by zero throws the step-by-step message");
+    const NumericColumn<int> three(3, 1);
+    const NumericColumn<int> four(4, 1);
+    check(thrownMessage([&] { numericEvaluate(three + four); }) == "sumOperation: Column sizes do not match.",
+          "mismatched columns");
+
+    return checkResult();
+}
@@ -0,0 +1,173 @@
+#include "NumericFile.hpp"
+#include "check.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * NumericFileWriter -> NumericMappedFile round trip of every kind the format stores, and
+ * NumericMappedFile rejecting damaged headers: bad magic and version, a truncated file,
+ * a column past the end, a wrong element size, an unknown tag and an unterminated name.
+ */
+namespace {
+
+const std::string path = (std::filesystem::temp_directory_path() / "numeric_file_check.ncol").string();
+
+std::vector<char> readAll(const std::string& name)
+{
+    std::ifstream in(name, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void writeAll(const std::string& name, const std::vector<char>& bytes)
+{
+    std::ofstream out(name, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// True when mapping `bytes` throws a std::runtime_error whose message mentions `reason`
+bool rejects(const std::vector<char>& bytes, const std::string& reason)
+{
+    writeAll(path, bytes);
+    try {
+        NumericMappedFile file(path);
+    } catch (const std::runtime_error& error) {
+        return std::string(error.what()).find(reason) != std::string::npos;
+    }
+    return false;
+}
+
+// Offsets into the first column header, which starts at byte 64
+constexpr std::size_t typeAt = 64;
+constexpr std::size_t elementSizeAt = 68;
+constexpr std::size_t offsetAt = 80;
+constexpr std::size_t nameAt = 96;
+
+template <typename T>
+void put(std::vector<char>& bytes, std::size_t at, T value)
+{
+    std::memcpy(bytes.data() + at, &value, sizeof(value));
+}
+
+// Writes a column of random bytes of kind K and maps it back; false when K has no file tag
+template <NumericKind K>
+bool roundTrip(std::mt19937& random)
+{
+    using T = NumericKindValue<K>;
+    try {
+        numericFileTypeOf(K);
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+    // Stored bytes are copied as they are, so any bit pattern must come back
+    NumericColumn<T> column;
+    for (int i = 0; i < 100; ++i) {
+        unsigned char raw[sizeof(T)];
+        for (unsigned char& byte : raw) {
+            byte = static_cast<unsigned char>(random());
+        }
+        T value;
+        std::memcpy(&value, raw, sizeof(T));
+        column.push_back(value);
+    }
+    NumericFileWriter writer;
+    writer.add("empty", std::span<const T>());
+    writer.add("values", column);
+    writer.write(path);
+
+    NumericMappedFile file(path);
+    const std::span<const T> view = file.view<T>("values");
+    check(file.columnCount() == 2 && file.column(1).kind == K && view.size() == column.size() &&
+              std::memcmp(view.data(), column.data(), column.size() * sizeof(T)) == 0,
+          "round trip of kind " + std::to_string(static_cast<int>(K)));
+    check(file.view<T>(0).empty() && reinterpret_cast<std::uintptr_t>(view.data()) % numericFileAlignment == 0,
+          "empty and aligned columns of kind " + std::to_string(static_cast<int>(K)));
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    // Every storable kind: the mapped view holds the written bytes, under the written name.
+    // BigInt is skipped before instantiating: it has no file tag and its bytes are not its value.
+    std::mt19937 random(11);
+    int stored = 0;
+    for (std::size_t k = 0; k < numericKindCount; ++k) {
+        numericVisitKind(static_cast<NumericKind>(k), [&]<NumericKind K>() {
+            if constexpr (std::is_trivially_copyable_v<NumericKindValue<K>>) {
+                stored += roundTrip<K>(random);
+            }
+        }, "file_check");
+    }
+    check(stored == static_cast<int>(numericKindCount) - 4, "every kind but the long doubles, Decimal18 and BigInt is stored");
+
+    // One good file with one double column, then damaged copies of it
+    NumericColumn<double> values;
+    for (int i = 0; i < 20; ++i) {
+        values.push_back(i * 0.5);
+    }
+    NumericFileWriter writer;
+    writer.add("values", values);
+    writer.write(path);
+    const std::vector<char> good = readAll(path);
+    {
+        NumericMappedFile file(path);
+        check(file.find("values") == 0 && file.view<double>(0)[3] == 1.5, "the undamaged file maps");
+        bool wrongType = false;
+        try {
+            file.view<float>(0);
+        } catch (const std::runtime_error&) {
+            wrongType = true;
+        }
+        check(wrongType, "a view of another type throws");
+    }
+
+    std::vector<char> bytes = good;
+    bytes[0] = 'X';
+    check(rejects(bytes, "Not a Numeric column file"), "bad magic");
+
+    bytes = good;
+    put<std::uint32_t>(bytes, 8, numericFileVersion + 1);
+    check(rejects(bytes, "Unsupported file version"), "bad version");
+
+    bytes = good;
+    bytes.resize(bytes.size() - numericFileAlignment);
+    check(rejects(bytes, "File is truncated"), "truncated file");
+    check(rejects(std::vector<char>(good.begin(), good.begin() + 40), "Cannot map"), "file shorter than its header");
+
+    bytes = good;
+    put<std::uint64_t>(bytes, offsetAt, good.size() + numericFileAlignment);
+    check(rejects(bytes, "Column is out of bounds"), "column offset past the end");
+
+    bytes = good;
+    put<std::uint64_t>(bytes, offsetAt, 0);
+    check(rejects(bytes, "Column is out of bounds"), "column offset inside the headers");
+
+    bytes = good;
+    put<std::uint64_t>(bytes, offsetAt - 8, std::uint64_t(1) << 60);
+    check(rejects(bytes, "Column is out of bounds"), "column count past the end");
+
+    bytes = good;
+    put<std::uint32_t>(bytes, elementSizeAt, 4);
+    check(rejects(bytes, "Element size does not match"), "wrong element size");
+
+    bytes = good;
+    put<std::uint32_t>(bytes, typeAt, 999);
+    check(rejects(bytes, "Unsupported type"), "unknown type tag");
+
+    bytes = good;
+    std::memset(bytes.data() + nameAt, 'x', numericFileNameLength);
+    check(rejects(bytes, "Column name is not terminated"), "unterminated name");
+
+    std::filesystem::remove(path);
+    return checkResult();
+}
@@ -0,0 +1,169 @@
+#include "NumericFormat.hpp"
+#include "check.hpp"
+
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * numericFormatTo / Numeric::formatTo and NumericTextWriter: float and double text reads
+ * back to the same bits, every float16 and bfloat16 reads back with the fewest digits
+ * that can, the inf / nan / -0 / complex spellings, a buffer too small, and the Lines
+ * and Csv writer output, CSV quoting of character fields included.
+ */
+namespace {
+
+template <typename T>
+std::string format(const T& value)
+{
+    char buffer[numericFormatBufferSize];
+    return std::string(buffer, numericFormatTo(buffer, sizeof(buffer), value));
+}
+
+// Significant digits of the mantissa: no sign, no leading or trailing zeros
+std::size_t significantDigits(const std::string& text)
+{
+    std::string digits;
+    for (const char c : text.substr(0, text.find('e'))) {
+        if (c >= '0' && c <= '9') {
+            digits += c;
+        }
+    }
+    const std::size_t first = digits.find_first_not_of('0');
+    if (first == std::string::npos) {
+        return 1;
+    }
+    return digits.find_last_not_of('0') - first + 1;
+}
+
+// Every bit pattern of a 16-bit kind: the text reads back, and one digit fewer never does
+template <typename T>
+void checkHalf(const std::string& name)
+{
+    int wrong = 0;
+    int longer = 0;
+    for (std::uint32_t bits = 0; bits <= 0xFFFF; ++bits) {
+        const T value = T::fromBits(static_cast<std::uint16_t>(bits));
+        const std::string text = format(value);
+        float parsed = 0;
+        std::from_chars(text.data(), text.data() + text.size(), parsed);
+        if (std::isnan(value.toFloat())) {
+            wrong += text != (std::signbit(value.toFloat()) ? "-nan" : "nan");
+            continue;
+        }
+        wrong += T(parsed).bits != value.bits;
+        const std::size_t digits = significantDigits(text);
+        for (std::size_t precision = 1; precision < digits; ++precision) {
+            char buffer[32];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value.toFloat(), std::chars_format::general,
+                                              static_cast<int>(precision));
+            float shorter = 0;
+            std::from_chars(buffer, result.ptr, shorter);
+            longer += T(shorter).bits == value.bits;
+        }
+    }
+    check(wrong == 0, name + ": every value reads back");
+    check(longer == 0, name + ": no value has a shorter text that reads back");
+}
+
+template <typename F, typename Bits>
+void checkRoundTrip(const std::string& name, std::mt19937_64& random)
+{
+    int wrong = 0;
+    for (int i = 0; i < 200000; ++i) {
+        const F value = std::bit_cast<F>(static_cast<Bits>(random()));
+        if (std::isnan(value)) {
+            continue;
+        }
+        const std::string text = format(value);
+        F parsed = 0;
+        const auto result = std::from_chars(text.data(), text.data() + text.size(), parsed);
+        char shortest[64];
+        const auto expected = std::to_chars(shortest, shortest + sizeof(shortest), value);
+        wrong += result.ptr != text.data() + text.size() || std::bit_cast<Bits>(parsed) != std::bit_cast<Bits>(value) ||
+                 text != std::string(shortest, expected.ptr);
+    }
+    check(wrong == 0, name + ": random values read back from the shortest text");
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937_64 random(10);
+    checkRoundTrip<float, std::uint32_t>("float", random);
+    checkRoundTrip<double, std::uint64_t>("double", random);
+    checkHalf<NumericFloat16>("float16");
+    checkHalf<NumericBFloat16>("bfloat16");
+
+    // Spellings
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    check(format(inf) == "inf" && format(-inf) == "-inf" && format(nan) == "nan" && format(-0.0) == "-0" && format(0.1) == "0.1" &&
+              format(1e300) == "1e+300",
+          "double spellings");
+    check(format(std::numeric_limits<float>::infinity()) == "inf" && format(-0.0f) == "-0" && format(0.1f) == "0.1",
+          "float spellings");
+    check(format(NumericFloat16(-std::numeric_limits<float>::infinity())) == "-inf" && format(NumericFloat16(-0.0f)) == "-0" &&
+              format(NumericFloat16(0.1f)) == "0.1" && format(NumericFloat16(65504.0f)) == "65500" &&
+              format(NumericBFloat16(std::numeric_limits<float>::infinity())) == "inf",
+          "float16 and bfloat16 spellings");
+    check(format(std::complex<double>(1.5, -2)) == "(1.5 + -2i)" && format(std::complex<float>(-0.0f, inf)) == "(-0 + infi)" &&
+              format(std::complex<double>(nan, 0.1)) == "(nan + 0.1i)",
+          "complex spellings");
+    check(Numeric::create(std::complex<double>(0.1, 3))->toString() != format(std::complex<double>(0.1, 3)) &&
+              [] {
+                  char buffer[numericFormatBufferSize];
+                  const auto value = Numeric::create(std::complex<double>(0.1, 3));
+                  return std::string(buffer, value->formatTo(buffer, sizeof(buffer))) == "(0.1 + 3i)";
+              }(),
+          "formatTo keeps the digits toString() rounds away");
+    check(format(-42) == "-42" && format(std::numeric_limits<std::uint64_t>::max()) == "18446744073709551615" &&
+              format(NumericDecimal2::fromString("12.5")) == "12.50" && format(U'é') == "\xc3\xa9" &&
+              format(static_cast<char32_t>(0xD800)) == "\xef\xbf\xbd",
+          "integer, decimal and character spellings");
+    char small[4];
+    check(numericFormatTo(small, sizeof(small), 0.125) == 0 && numericFormatTo(small, sizeof(small), 0.25) == 4,
+          "a buffer too small writes nothing");
+
+    // Lines: one value per line, from objects and columns
+    NumericTextWriter lines;
+    std::vector<std::unique_ptr<Numeric>> values;
+    values.push_back(Numeric::create(3));
+    values.push_back(Numeric::create(0.1));
+    values.push_back(Numeric::create(NumericBigInt::fromString("-" + std::string(300, '7'))));
+    values.push_back(Numeric::create(std::complex<float>(1, 2)));
+    lines.write(values);
+    lines.write(NumericColumn<NumericBFloat16>{NumericBFloat16(1.5f), NumericBFloat16(-0.0f)});
+    lines.write(*Numeric::create(-inf));
+    const std::string expected = "3\n0.1\n-" + std::string(300, '7') + "\n(1 + 2i)\n1.5\n-0\n-inf\n";
+    check(lines.view() == expected, "Lines output");
+    std::ostringstream stream;
+    lines.flush(stream);
+    check(stream.str() == expected && lines.size() == 0, "flush writes the buffer and empties it");
+
+    // Csv: one record per write() or per row, character fields quoted when they must be
+    NumericTextWriter csv(NumericTextFormat::Csv);
+    csv.writeRows(NumericColumn<int>{1, 2, 3, 4}, NumericColumn<char>{'a', ',', '"', '\n'}, NumericColumn<double>{0.5, -0.0, inf, 1e-7});
+    csv.write(values);
+    charNumeric<char> comma(',');
+    csv.write(comma);
+    check(csv.view() == "1,a,0.5\n2,\",\",-0\n3,\"\"\"\",inf\n4,\"\n\",1e-07\n3,0.1,-" + std::string(300, '7') + ",(1 + 2i)\n\",\"\n",
+          "Csv output");
+    bool mismatch = false;
+    try {
+        csv.writeRows(NumericColumn<int>{1, 2}, NumericColumn<int>{1});
+    } catch (const std::runtime_error&) {
+        mismatch = true;
+    }
+    check(mismatch, "writeRows rejects columns of different sizes");
+
+    return checkResult();
+}
@@ -0,0 +1,155 @@
+#include "NumericExpression.hpp"
+#include "NumericFormula.hpp"
+#include "check.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+/**
+ * NumericFormula against the step-by-step virtual calls and numericEvaluate: results,
+ * precedence and associativity, common subexpressions, constant folding, the overflow
+ * policy (read by both when evaluation starts), and the error messages of bad text,
+ * unknown columns and division by zero.
+ */
+namespace {
+
+// The message body() throws, or "" when it does not
+template <typename Body>
+std::string errorOf(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+template <typename T>
+bool sameBits(const NumericColumn<T>& first, const NumericColumn<T>& second)
+{
+    return first.size() == second.size() && std::memcmp(first.data(), second.data(), first.size() * sizeof(T)) == 0;
+}
+
+using Row = std::function<std::unique_ptr<Numeric>(std::size_t)>;
+
+// Evaluates `text` and compares every row with `reference`, computed by the virtual *Operation methods
+template <typename T>
+void checkRows(const char* text, const NumericFormulaColumns& columns, std::size_t rows, const Row& reference)
+{
+    const NumericFormula formula(text, columns);
+    check(formula.resultKind() == numericKindOf<T>, std::string(text) + ": result kind");
+    const NumericColumn<T> out = formula.evaluate<T>(columns);
+    bool same = out.size() == rows;
+    for (std::size_t row = 0; same && row < rows; ++row) {
+        const T expected = numericValueOf<numericKindOf<T>>(*reference(row));
+        same = std::memcmp(&out[row], &expected, sizeof(T)) == 0;
+    }
+    check(same, std::string(text) + ": rows");
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937_64 random(25);
+    const std::size_t rows = 3000;   // not a multiple of chunkRows
+    NumericColumn<double> a(rows), b(rows), c(rows), d(rows);
+    NumericColumn<int> i(rows), j(rows);
+    NumericColumn<std::int8_t> s(rows);
+    NumericColumn<NumericDecimal2> m(rows);
+    for (std::size_t row = 0; row < rows; ++row) {
+        a[row] = static_cast<double>(random() % 1000) / 7;
+        b[row] = static_cast<double>(random() % 1000) / 3 - 100;
+        c[row] = static_cast<double>(1 + random() % 50);
+        d[row] = static_cast<double>(1 + random() % 9);
+        i[row] = static_cast<int>(random() % 2000) - 1000;
+        j[row] = static_cast<int>(1 + random() % 100);
+        s[row] = static_cast<std::int8_t>(random() % 10);
+        m[row] = NumericDecimal2::fromUnits(static_cast<std::int64_t>(random() % 100000));
+    }
+    NumericFormulaColumns columns;
+    columns.add("a", a);
+    columns.add("b", b);
+    columns.add("c", c);
+    columns.add("d", d);
+    columns.add("i", i);
+    columns.add("j", j);
+    columns.add("s", s);
+    columns.add("m", m);
+
+    // Against the virtual calls, row by row
+    checkRows<double>("a*b + c/d - 3", columns, rows, [&](std::size_t r) {
+        return a.at(r)->multiplyOperation(*b.at(r))->sumOperation(*c.at(r)->divideOperation(*d.at(r)))->subtractOperation(IntNumeric(3));
+    });
+    checkRows<double>("a - b - c", columns, rows, [&](std::size_t r) { return a.at(r)->subtractOperation(*b.at(r))->subtractOperation(*c.at(r)); });
+    checkRows<double>("a / d / d", columns, rows, [&](std::size_t r) { return a.at(r)->divideOperation(*d.at(r))->divideOperation(*d.at(r)); });
+    checkRows<double>("a - b * c + d", columns, rows, [&](std::size_t r) {
+        return a.at(r)->subtractOperation(*b.at(r)->multiplyOperation(*c.at(r)))->sumOperation(*d.at(r));
+    });
+    checkRows<double>("(a - b) * (c + d)", columns, rows, [&](std::size_t r) {
+        return a.at(r)->subtractOperation(*b.at(r))->multiplyOperation(*c.at(r)->sumOperation(*d.at(r)));
+    });
+    checkRows<int>("i / j * 3 + -i", columns, rows, [&](std::size_t r) {
+        const auto zero = i.at(r)->subtractOperation(*i.at(r));
+        return i.at(r)->divideOperation(*j.at(r))->multiplyOperation(IntNumeric(3))->sumOperation(*zero->subtractOperation(*i.at(r)));
+    });
+    checkRows<double>("i * 1.5 / j", columns, rows, [&](std::size_t r) {
+        return i.at(r)->multiplyOperation(FloatNumeric<double>(1.5))->divideOperation(*j.at(r));
+    });
+    checkRows<std::int8_t>("s + s * s", columns, rows, [&](std::size_t r) { return s.at(r)->sumOperation(*s.at(r)->multiplyOperation(*s.at(r))); });
+    checkRows<NumericDecimal2>("m * 2 + m / 3", columns, rows, [&](std::size_t r) {
+        return m.at(r)->multiplyOperation(IntNumeric(2))->sumOperation(*m.at(r)->divideOperation(IntNumeric(3)));
+    });
+
+    // Against numericEvaluate, and the common subexpression computed once
+    check(sameBits(NumericFormula("a*b + c/d - 3", columns).evaluate<double>(columns), numericEvaluate(a * b + c / d - 3)), "numericEvaluate");
+    check(sameBits(NumericFormula("a*b + a*b/c", columns).evaluate<double>(columns), numericEvaluate(a * b + a * b / c)), "numericEvaluate CSE");
+    check(NumericFormula("a*b + a*b/c", columns).instructionCount() == 3, "a*b is computed once");
+    check(NumericFormula("2 * 3 + a", columns).instructionCount() == 1, "constants are folded");
+
+    // Precedence and associativity on constants (one row)
+    const NumericFormulaColumns none;
+    const std::pair<const char*, int> constants[] = {{"2 + 3 * 4", 14}, {"(2 + 3) * 4", 20}, {"10 - 4 - 3", 3}, {"100 / 10 / 5", 2},
+                                                     {"2 - -3", 5},     {"-2 * 3", -6},      {"-(2 - 5) * 2", 6}, {"7 - 2 * 3 - 1", 0}};
+    for (const auto& [text, value] : constants) {
+        const NumericColumn<int> out = NumericFormula(text, none).evaluate<int>(none);
+        check(out.size() == 1 && out[0] == value, std::string(text) + ": precedence and associativity");
+    }
+    check(NumericFormula("3000000000", none).resultKind() == NumericKind::Int64 && NumericFormula("1.5", none).resultKind() == NumericKind::Double,
+          "literal kinds");
+
+    // Both read NumericOverflowScope when evaluation starts, not when built; s * s * s passes 127
+    const NumericFormula cube("s * s * s", columns);
+    const auto cubeExpression = s * s * s;
+    {
+        const NumericOverflowScope saturate(NumericOverflow::Saturate);
+        const NumericColumn<std::int8_t> saturated = cube.evaluate<std::int8_t>(columns);
+        check(sameBits(saturated, numericEvaluate(cubeExpression)) && *std::max_element(saturated.begin(), saturated.end()) == 127,
+              "overflow policy of evaluation");
+    }
+    const std::string overflow = errorOf([] { IntegerNumeric<std::int8_t>(100).multiplyOperation(IntegerNumeric<std::int8_t>(2)); });
+    check(errorOf([&] { cube.evaluate<std::int8_t>(columns); }) == overflow && errorOf([&] { numericEvaluate(cubeExpression); }) == overflow,
+          "overflow outside the scope");
+
+    // Errors
+    check(errorOf([&] { NumericFormula("a + q", columns); }) == "NumericFormula: Unknown column \"q\".", "unknown column");
+    check(errorOf([&] { NumericFormula("a +", columns); }) == "NumericFormula: Unexpected end of formula.", "unexpected end");
+    check(errorOf([&] { NumericFormula("a $ b", columns); }) == "NumericFormula: Unexpected '$' at offset 2.", "unexpected character");
+    check(errorOf([&] { NumericFormula("(a", columns); }) == "NumericFormula: Unexpected end of formula.", "unclosed parenthesis");
+    check(errorOf([&] { NumericFormula("a ) b", columns); }) == "NumericFormula: Unexpected ')' at offset 2.", "extra parenthesis");
+    const std::string divisionByZero = errorOf([] { IntNumeric(1).divideOperation(IntNumeric(0)); });
+    check(!divisionByZero.empty() && errorOf([&] { NumericFormula("1 / 0", none); }) == divisionByZero, "division by zero when folding");
+    check(errorOf([&] { NumericFormula("i / (j - j)", columns).evaluate<int>(columns); }) == divisionByZero, "division by zero per row");
+    check(errorOf([&] { NumericFormula("a", columns).evaluate<int>(columns); }).starts_with("NumericFormula: The formula gives double"), "wrong T");
+    NumericFormulaColumns shorter = columns;
+    NumericColumn<double> tenRows(10);
+    shorter.add("b", tenRows);
+    check(errorOf([&] { NumericFormula("a + b", columns).evaluate<double>(shorter); }) == "NumericFormula: Column sizes do not match.", "sizes");
+
+    return checkResult();
+}
@@ -0,0 +1,214 @@
+#include "Numeric.hpp"
+#include "check.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * 64-bit integers, long doubles, decimals and BigInts rounded to float16 and bfloat16
+ * against a brute-force nearest-even over every finite value of the format, in long double
+ * (which holds both exactly). The inputs are mostly next to the midpoints between
+ * neighbours, where rounding through float or double first lands on a false tie or on the
+ * wrong side.
+ */
+namespace {
+
+template <typename H>
+const std::vector<long double>& finiteValues()
+{
+    // Positive finite values in order of their bits, 0 first
+    static const std::vector<long double> values = [] {
+        std::vector<long double> all;
+        const std::uint32_t infinity = ((1u << H::exponentBits) - 1) << H::fractionBits;
+        for (std::uint32_t bits = 0; bits < infinity; ++bits) {
+            all.push_back(H::fromBits(static_cast<std::uint16_t>(bits)).toFloat());
+        }
+        return all;
+    }();
+    return values;
+}
+
+template <typename H>
+std::uint16_t reference(long double value)
+{
+    const std::vector<long double>& values = finiteValues<H>();
+    const long double magnitude = std::fabs(value);
+    const std::uint16_t sign = value < 0 ? 0x8000 : 0;
+
+    // Past the largest value by half a step of the next binade (2^(bias + 1)) is infinity
+    const long double overflow = (values.back() + std::ldexp(1.0L, 1 << (H::exponentBits - 1))) / 2;
+    if (magnitude >= overflow) {
+        return static_cast<std::uint16_t>(sign | values.size());
+    }
+    const std::size_t above = static_cast<std::size_t>(std::lower_bound(values.begin(), values.end(), magnitude) - values.begin());
+    if (above == values.size()) {
+        return static_cast<std::uint16_t>(sign | (values.size() - 1));
+    }
+    if (above == 0 || values[above] == magnitude) {
+        return static_cast<std::uint16_t>(sign | above);
+    }
+    const long double down = magnitude - values[above - 1];
+    const long double up = values[above] - magnitude;
+    const std::size_t nearest = up < down || (up == down && above % 2 == 0) ? above : above - 1;
+    return static_cast<std::uint16_t>(sign | nearest);
+}
+
+std::string hex(std::uint16_t bits)
+{
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "%04x", bits);
+    return buffer;
+}
+
+template <typename H, typename T>
+void checkValue(T value, int& throughDouble)
+{
+    const std::uint16_t expected = reference<H>(static_cast<long double>(value));
+    const std::uint16_t bits = H(value).bits;
+    check(bits == expected, std::string(H::exponentBits == 5 ? "float16" : "bfloat16") + "(" + std::to_string(value) + ") = " + hex(bits) +
+                                ", expected " + hex(expected));
+    throughDouble += H(static_cast<double>(value)).bits != expected || H(static_cast<float>(value)).bits != expected;
+}
+
+// Integers next to the midpoint between each pair of neighbours that are at least 2^(bits - 1) apart
+template <typename H, typename T>
+void checkMidpoints(int& throughDouble)
+{
+    const std::vector<long double>& values = finiteValues<H>();
+    for (std::size_t index = 1; index < values.size(); ++index) {
+        const long double midpoint = (values[index - 1] + values[index]) / 2;
+        if (midpoint != std::floor(midpoint) || midpoint >= std::ldexp(1.0L, std::numeric_limits<T>::digits)) {
+            continue;
+        }
+        const T middle = static_cast<T>(midpoint);
+        for (const T offset : {T(0), T(1), T(2), T(3), T(255), T(std::uint64_t(1) << 12)}) {
+            if (middle - offset < middle) {
+                checkValue<H>(static_cast<T>(middle - offset), throughDouble);
+            }
+            if (middle + offset > middle) {
+                checkValue<H>(static_cast<T>(middle + offset), throughDouble);
+            }
+            if constexpr (std::is_signed_v<T>) {
+                checkValue<H>(static_cast<T>(-middle - offset), throughDouble);
+            }
+        }
+    }
+}
+
+template <NumericKind K>
+std::uint16_t convertedBits(const Numeric& value)
+{
+    return numericValueOf<K>(*value.convertTo(K)).bits;
+}
+
+// Long doubles one step either side of every midpoint; double holds neither, only the midpoint
+template <typename H>
+void checkLongDoubleMidpoints(int& throughDouble)
+{
+    const std::vector<long double>& values = finiteValues<H>();
+    for (std::size_t index = 1; index < values.size(); ++index) {
+        const long double midpoint = (values[index - 1] + values[index]) / 2;
+        for (const long double value : {midpoint, std::nextafter(midpoint, 0.0L), std::nextafter(midpoint, 1.0L / 0.0L)}) {
+            checkValue<H>(value, throughDouble);
+            checkValue<H>(-value, throughDouble);
+        }
+    }
+}
+
+// Decimal18 values at and one unit either side of every midpoint it holds exactly
+template <typename H, NumericKind K>
+void checkDecimalMidpoints()
+{
+    const std::vector<long double>& values = finiteValues<H>();
+    for (std::size_t index = 1; index < values.size(); ++index) {
+        const long double midpoint = (values[index - 1] + values[index]) / 2;
+        const long double units = midpoint * static_cast<long double>(NumericDecimal18::unit);
+        if (units != std::floor(units) || units >= 9e18L) {
+            continue;
+        }
+        for (const int offset : {-1, 0, 1}) {
+            const long double near = offset == 0 ? midpoint : std::nextafter(midpoint, offset * (1.0L / 0.0L));
+            const std::uint16_t expected = reference<H>(near);
+            const auto decimal = Numeric::create(NumericDecimal18::fromUnits(static_cast<std::int64_t>(units) + offset));
+            check(convertedBits<K>(*decimal) == expected, decimal->toString() + " converted to " + (K == NumericKind::Float16 ? "Float16" : "BFloat16"));
+        }
+    }
+}
+
+// BigInts at and one either side of every integer midpoint from 2^60 up
+template <typename H, NumericKind K>
+void checkBigIntMidpoints()
+{
+    const std::vector<long double>& values = finiteValues<H>();
+    for (std::size_t index = 1; index < values.size(); ++index) {
+        const long double midpoint = (values[index - 1] + values[index]) / 2;
+        if (midpoint < 0x1p60L) {
+            continue;
+        }
+        for (const int offset : {-1, 0, 1}) {
+            const long double near = offset == 0 ? midpoint : std::nextafter(midpoint, offset * (1.0L / 0.0L));
+            const std::uint16_t expected = reference<H>(near);
+            const auto big = Numeric::create(NumericBigInt(midpoint) + NumericBigInt(offset));
+            check(convertedBits<K>(*big) == expected, big->toString() + " converted to " + (K == NumericKind::Float16 ? "Float16" : "BFloat16"));
+            const auto negative = Numeric::create(-(NumericBigInt(midpoint) + NumericBigInt(offset)));
+            check(convertedBits<K>(*negative) == (expected | 0x8000), negative->toString() + " converted");
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    int throughDouble = 0;
+    checkMidpoints<NumericFloat16, std::int64_t>(throughDouble);
+    checkMidpoints<NumericFloat16, std::uint64_t>(throughDouble);
+    checkMidpoints<NumericBFloat16, std::int64_t>(throughDouble);
+    checkMidpoints<NumericBFloat16, std::uint64_t>(throughDouble);
+    checkMidpoints<NumericBFloat16, int>(throughDouble);
+    check(throughDouble > 0, "some integers round differently through float or double");
+
+    std::mt19937_64 random(20);
+    for (int i = 0; i < 20000; ++i) {
+        const std::uint64_t bits = random() >> (random() % 64);
+        checkValue<NumericFloat16>(static_cast<std::int64_t>(bits) * (random() & 1 ? -1 : 1), throughDouble);
+        checkValue<NumericBFloat16>(static_cast<std::int64_t>(bits) * (random() & 1 ? -1 : 1), throughDouble);
+        checkValue<NumericBFloat16>(random(), throughDouble);
+    }
+    for (const std::int64_t value : {std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(), std::int64_t(0),
+                                     std::int64_t(65519), std::int64_t(65520), std::int64_t(-65520), std::int64_t(2049), std::int64_t(2051)}) {
+        checkValue<NumericFloat16>(value, throughDouble);
+        checkValue<NumericBFloat16>(value, throughDouble);
+    }
+    checkValue<NumericBFloat16>(std::numeric_limits<std::uint64_t>::max(), throughDouble);
+
+    // 2^60 + 2^52 + 1 is just above the midpoint; in double it is exactly the midpoint and rounds down to even
+    const std::int64_t aboveTie = (std::int64_t(1) << 60) + (std::int64_t(1) << 52) + 1;
+    check(NumericBFloat16(aboveTie).bits == 0x5d81 && NumericBFloat16(static_cast<double>(aboveTie)).bits == 0x5d80, "bfloat16(2^60 + 2^52 + 1)");
+    check(Numeric::create(aboveTie)->convertTo(NumericKind::BFloat16)->toString() == Numeric::create(NumericBFloat16::fromBits(0x5d81))->toString(),
+          "Int64 2^60 + 2^52 + 1 converted to BFloat16");
+
+    // One long double step off a midpoint is below double's precision
+    checkLongDoubleMidpoints<NumericFloat16>(throughDouble);
+    checkLongDoubleMidpoints<NumericBFloat16>(throughDouble);
+    check(NumericFloat16(1.0L + 0x1p-11L + 0x1p-60L).bits == 0x3c01, "float16(1 + 2^-11 + 2^-60)");
+    check(NumericBFloat16(1.0L + 0x1p-8L + 0x1p-60L).bits == 0x3f81, "bfloat16(1 + 2^-8 + 2^-60)");
+
+    // Decimals and BigInts round from their exact value, not from a long double or a double
+    checkDecimalMidpoints<NumericFloat16, NumericKind::Float16>();
+    checkDecimalMidpoints<NumericBFloat16, NumericKind::BFloat16>();
+    checkBigIntMidpoints<NumericBFloat16, NumericKind::BFloat16>();
+    const auto aboveHalfUlp = Numeric::create(NumericDecimal18::fromString("1.000488281250000001"));
+    check(convertedBits<NumericKind::Float16>(*aboveHalfUlp) == 0x3c01, "Decimal18 1.000488281250000001 converted to Float16");
+    const auto tieBig = Numeric::create(NumericBigInt::fromString("1272602360385370922596299702272"));        // 2^100 + 2^92
+    const auto aboveTieBig = Numeric::create(NumericBigInt::fromString("1272602360385370922596299702273"));
+    check(convertedBits<NumericKind::BFloat16>(*tieBig) == 0x7180 && convertedBits<NumericKind::BFloat16>(*aboveTieBig) == 0x7181,
+          "BigInt 2^100 + 2^92 (+ 1) converted to BFloat16");
+
+    return checkResult();
+}
@@ -0,0 +1,125 @@
+#include "NumericHash.hpp"
+#include "NumericReduce.hpp"
+#include "NumericSort.hpp"
+#include "check.hpp"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+// Cross-kind hashing and equality, NumericHashMap, and group-by with one and with many partitions
+int main()
+{
+    // One number in every kind that can hold it exactly: one hash, one value, no order between them
+    std::vector<std::unique_ptr<Numeric>> three;
+    three.push_back(Numeric::create(3));
+    three.push_back(Numeric::create(3.0));
+    three.push_back(Numeric::create(3.0f));
+    three.push_back(Numeric::create(std::uint64_t(3)));
+    three.push_back(Numeric::create(std::int8_t(3)));
+    three.push_back(Numeric::create(NumericDecimal2::fromUnits(300)));
+    three.push_back(Numeric::create(NumericDecimal18::fromUnits(3 * NumericDecimal18::unit)));
+    three.push_back(Numeric::create(NumericBigInt(3)));
+    three.push_back(Numeric::create(NumericFloat16(3)));
+    three.push_back(Numeric::create(std::complex<double>(3, 0)));
+    for (const auto& first : three) {
+        for (const auto& second : three) {
+            check(first->hash() == second->hash(), "equal values of different kinds hash alike");
+            check(numericSameValue(*first, *second), "equal values of different kinds are the same value");
+            check((numericSortOrder(*first, *second) == 0) == (first->kind() == second->kind()), "equal values order by kind only");
+        }
+    }
+
+    const std::unique_ptr<Numeric> others[] = {Numeric::create(3.5), Numeric::create(NumericDecimal2::fromUnits(301)),
+                                                Numeric::create(std::complex<double>(3, 1)), Numeric::create('3'),
+                                                Numeric::create(NumericBigInt::fromString("18446744073709551619"))};   // 2^64 + 3
+    for (const auto& other : others) {
+        check(!numericSameValue(*three[0], *other) && !numericSameValue(*other, *three[5]), "different values differ");
+    }
+    check(!numericSameValue(*Numeric::create(0.1), *Numeric::create(NumericDecimal2::fromUnits(10))), "double 0.1 is not decimal 0.10");
+    check(!numericSameValue(*Numeric::create(0.1f), *Numeric::create(0.1)), "float 0.1 is not double 0.1");
+    check(numericHash('A') == numericHash(U'A') && numericHash('A') != numericHash(65), "characters are keyed by code unit, apart from numbers");
+
+    // NaN and complex values
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    check(numericHash(nan) == numericHash(-nan) && numericSameValue(nan, -nan), "all NaNs are one key");
+    check(numericSameValue(*Numeric::create(nan), *Numeric::create(std::numeric_limits<float>::quiet_NaN())), "NaN of any kind");
+    check(!numericSameValue(*Numeric::create(nan), *Numeric::create(std::numeric_limits<double>::infinity())), "NaN is not inf");
+    check(numericHash(-0.0) == numericHash(0.0) && numericSameValue(*Numeric::create(-0.0), *Numeric::create(0)), "-0.0 is 0");
+    check(numericHash(std::complex<double>(1, 2)) == numericHash(std::complex<float>(1, 2)), "complex values hash by parts");
+    check(numericHash(std::complex<double>(1, 2)) != numericHash(std::complex<double>(2, 1)), "complex parts are not symmetric");
+    check(numericSameValue(*Numeric::create(std::complex<double>(nan, 1)), *Numeric::create(std::complex<float>(-nan, 1))),
+          "complex values with NaN parts");
+    check(numericSortOrder(*Numeric::create(nan), *Numeric::create(std::numeric_limits<double>::infinity())) > 0, "NaN sorts after +inf");
+
+    // Insertions through several rehashes, lookups, and clear
+    NumericHashMap<std::int64_t, std::int64_t> map;
+    const std::size_t initialCapacity = map.capacity();
+    for (std::int64_t key = -5000; key < 5000; ++key) {
+        check(map.insert(key).second, "a new key is inserted");
+        *map.find(key) = key * 2;
+    }
+    check(map.capacity() > initialCapacity && map.size() == 10000, "the map grows");
+    bool found = true;
+    for (std::int64_t key = -5000; key < 5000; ++key) {
+        const std::int64_t* value = map.find(key);
+        found = found && value && *value == key * 2 && !map.insert(key).second;
+    }
+    check(found, "every key survives the rehashes");
+    check(map.find(5000) == nullptr && map.size() == 10000, "a missing key is not found");
+    std::int64_t total = 0;
+    map.forEach([&](std::int64_t, std::int64_t value) { total += value; });
+    check(total == -10000, "forEach visits every entry once");
+    map.clear();
+    check(map.empty() && map.find(0) == nullptr && map.insert(0).second, "clear removes every key");
+
+    NumericHashMap<double, int> doubles;
+    ++doubles[0.0];
+    ++doubles[-0.0];
+    ++doubles[nan];
+    ++doubles[-nan];
+    check(doubles.size() == 2 && doubles[0.0] == 2 && doubles[nan] == 2, "-0.0 and NaN keys");
+
+    // Group-by: the same groups and aggregates with one thread and with partitions across four
+    std::mt19937_64 random(21);
+    const std::size_t rows = 300000;
+    NumericColumn<std::int64_t> keys(rows);
+    NumericColumn<double> values(rows);
+    for (std::size_t row = 0; row < rows; ++row) {
+        keys[row] = static_cast<std::int64_t>(random() % 5000) - 2500;
+        values[row] = static_cast<double>(random() % 1000) / 8;
+    }
+    NumericReduceOptions one;
+    one.threads = 1;
+    NumericReduceOptions four;
+    four.threads = 4;
+    const NumericGrouping single = numericGroupKeys(keys, one);
+    const NumericGrouping partitioned = numericGroupKeys(keys, four);
+    check(single.partitionBegin.size() == 2 && partitioned.partitionBegin.size() > 2, "one partition, then many");
+    check(single.firstRows == partitioned.firstRows, "groups are numbered by first appearance at any thread count");
+    const auto singleGroups = numericGroupBy(keys, values, one);
+    const auto partitionedGroups = numericGroupBy(keys, values, four);
+    bool same = singleGroups.size() == partitionedGroups.size() && singleGroups.size() == 5000;
+    std::size_t counted = 0;
+    for (std::size_t group = 0; same && group < singleGroups.size(); ++group) {
+        const auto& first = singleGroups[group];
+        const auto& second = partitionedGroups[group];
+        same = first.key == second.key && first.count == second.count && first.sum == second.sum && first.min == second.min &&
+               first.max == second.max;
+        counted += first.count;
+    }
+    check(same && counted == rows, "group-by gives the same result with one and with many partitions");
+
+    // Vector keys group across kinds
+    std::vector<std::unique_ptr<Numeric>> mixed;
+    mixed.push_back(Numeric::create(3));
+    mixed.push_back(Numeric::create(3.0));
+    mixed.push_back(Numeric::create(NumericDecimal2::fromUnits(300)));
+    mixed.push_back(Numeric::create(nan));
+    mixed.push_back(Numeric::create(-nan));
+    mixed.push_back(Numeric::create(std::complex<double>(3, 0)));
+    const NumericGrouping grouping = numericGroupKeys(mixed, one);
+    check(grouping.groupCount() == 2 && grouping.groups[5] == 0 && grouping.groups[4] == 1, "Numeric keys group across kinds");
+
+    return checkResult();
+}
@@ -0,0 +1,142 @@
+#include "NumericIndex.hpp"
+#include "check.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+/**
+ * numericRangeFilter over zone maps and NumericSortedIndex lookups against a linear scan
+ * that asks every row's Numeric object (greaterThanOperation / lessThanOperation /
+ * equalOperation), for inclusive and exclusive, open, empty and cross-kind ranges.
+ */
+namespace {
+
+// Rows of `column` the virtual comparisons put in `range`, or the message they throw
+template <typename T>
+std::vector<std::uint32_t> scan(const NumericColumn<T>& column, const NumericRange& range, std::string& error)
+{
+    std::vector<std::uint32_t> rows;
+    try {
+        for (std::size_t row = 0; row < column.size(); ++row) {
+            const auto value = column.at(row);
+            if (numericUnordered(column[row])) {
+                continue;
+            }
+            const bool aboveLow = !range.low || value->greaterThanOperation(*range.low) || (range.lowInclusive && value->equalOperation(*range.low));
+            const bool belowHigh = !range.high || value->lessThanOperation(*range.high) || (range.highInclusive && value->equalOperation(*range.high));
+            if (aboveLow && belowHigh) {
+                rows.push_back(static_cast<std::uint32_t>(row));
+            }
+        }
+    } catch (const std::runtime_error& thrown) {
+        error = thrown.what();
+    }
+    return rows;
+}
+
+template <typename T>
+void checkColumn(const NumericColumn<T>& column, const std::vector<std::unique_ptr<Numeric>>& bounds, const std::string& name)
+{
+    const NumericZoneMap<T> zones(column, 256);
+    const NumericSortedIndex<T> index(column);
+    std::vector<const Numeric*> sides = {nullptr};
+    for (const auto& bound : bounds) {
+        sides.push_back(bound.get());
+    }
+
+    for (const Numeric* low : sides) {
+        for (const Numeric* high : sides) {
+            for (int inclusive = 0; inclusive < 4; ++inclusive) {
+                const NumericRange range{low, high, (inclusive & 1) != 0, (inclusive & 2) != 0};
+                const std::string what = name + " (" + (low ? low->toString() : "open") + ", " + (high ? high->toString() : "open") + ") " +
+                                         std::to_string(inclusive);
+                std::string expectedError;
+                const std::vector<std::uint32_t> expected = scan(column, range, expectedError);
+
+                std::string error;
+                NumericMask mask;
+                std::vector<std::uint32_t> found;
+                try {
+                    mask = numericRangeFilter(column, zones, range);
+                    const auto rows = index.lookup(range);
+                    found.assign(rows.begin(), rows.end());
+                } catch (const std::runtime_error& thrown) {
+                    error = thrown.what();
+                }
+                check(error == expectedError, what + ": same error");
+                if (!error.empty()) {
+                    continue;
+                }
+
+                std::vector<std::uint32_t> filtered;
+                for (std::size_t row = 0; row < mask.size(); ++row) {
+                    if (mask.test(row)) {
+                        filtered.push_back(static_cast<std::uint32_t>(row));
+                    }
+                }
+                check(filtered == expected, what + ": zone map filter");
+                const bool ordered = std::is_sorted(found.begin(), found.end(), [&](std::uint32_t first, std::uint32_t second) {
+                    return numericOrderedBefore(column[first], column[second]);
+                });
+                std::sort(found.begin(), found.end());
+                check(ordered && found == expected, what + ": index lookup");
+            }
+        }
+        if (low) {
+            std::string error;
+            const std::vector<std::uint32_t> expected = scan(column, NumericRange{low, low, true, true}, error);
+            if (error.empty()) {
+                const auto rows = index.find(*low);
+                std::vector<std::uint32_t> found(rows.begin(), rows.end());
+                check(found == expected, name + " find " + low->toString());
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937_64 random(22);
+    const std::size_t rows = 3000;
+
+    std::vector<std::unique_ptr<Numeric>> bounds;
+    bounds.push_back(Numeric::create(3));
+    bounds.push_back(Numeric::create(-100));
+    bounds.push_back(Numeric::create(3.5));
+    bounds.push_back(Numeric::create(NumericDecimal2::fromUnits(350)));          // 3.50
+    bounds.push_back(Numeric::create(NumericDecimal2::fromUnits(-101)));         // -1.01
+    bounds.push_back(Numeric::create(NumericDecimal18::fromUnits(NumericDecimal18::unit * 100 + 1)));   // just above 100
+    bounds.push_back(Numeric::create(NumericBigInt::fromString("1180591620717411303424")));             // 2^70
+    bounds.push_back(Numeric::create(NumericBigInt::fromString("-1180591620717411303424")));
+    bounds.push_back(Numeric::create(std::int64_t(1) << 40));
+    bounds.push_back(Numeric::create(std::uint64_t(5)));
+    bounds.push_back(Numeric::create(std::int8_t(-128)));
+
+    NumericColumn<std::int8_t> bytes(rows);
+    NumericColumn<int> sorted(rows);
+    NumericColumn<std::int64_t> wide(rows);
+    NumericColumn<double> doubles(rows);
+    NumericColumn<NumericDecimal2> money(rows);
+    for (std::size_t row = 0; row < rows; ++row) {
+        bytes[row] = static_cast<std::int8_t>(random());
+        sorted[row] = static_cast<int>(row / 4) - 300;
+        wide[row] = static_cast<std::int64_t>(random() % 2000) - 1000 + (row % 7 == 0 ? std::int64_t(1) << 40 : 0);
+        doubles[row] = row % 50 == 0 ? std::numeric_limits<double>::quiet_NaN() : static_cast<double>(random() % 4000) / 8 - 250;
+        money[row] = NumericDecimal2::fromUnits(static_cast<std::int64_t>(random() % 40000) - 20000);
+    }
+
+    checkColumn(bytes, bounds, "int8");
+    checkColumn(sorted, bounds, "sorted int");
+    checkColumn(wide, bounds, "int64");
+    checkColumn(doubles, bounds, "double with NaN");
+    checkColumn(money, bounds, "decimal2");
+    checkColumn(NumericColumn<int>(), bounds, "empty column");
+
+    return checkResult();
+}
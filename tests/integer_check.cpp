@@ -0,0 +1,143 @@
+#include "Numeric.hpp"
+#include "check.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * Every pair of the 8-64 bit integer kinds, on values at and next to each type's limits:
+ * comparisons against the exact 128-bit order, and +, -, *, / against the exact 128-bit
+ * result range-checked into the result kind under each NumericOverflow policy.
+ */
+namespace {
+
+std::string toText(NumericInt128 value)
+{
+    const bool negative = value < 0;
+    NumericUInt128 magnitude = negative ? -static_cast<NumericUInt128>(value) : static_cast<NumericUInt128>(value);
+    std::string text;
+    do {
+        text.insert(text.begin(), static_cast<char>('0' + static_cast<int>(magnitude % 10)));
+        magnitude /= 10;
+    } while (magnitude != 0);
+    return negative ? "-" + text : text;
+}
+
+using Integers = std::tuple<std::int8_t, std::int16_t, int, std::int64_t, std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t>;
+
+template <typename T>
+std::vector<NumericInt128> samples()
+{
+    using limits = std::numeric_limits<T>;
+    std::vector<NumericInt128> values = {limits::min(), NumericInt128(limits::min()) + 1, 0, 1, 2, 7, NumericInt128(limits::max()) - 1, limits::max()};
+    if constexpr (std::is_signed_v<T>) {
+        values.insert(values.end(), {-1, -2, -7});
+    }
+    return values;
+}
+
+// The result kind of IntegerNumeric arithmetic: the wider type, the unsigned one at equal width
+template <typename A, typename B>
+using ResultOf = std::conditional_t<(sizeof(A) != sizeof(B)), std::conditional_t<(sizeof(A) > sizeof(B)), A, B>,
+                                    std::conditional_t<std::is_unsigned_v<B>, B, A>>;
+
+// Expected text of an exact result under `overflow`, or the message it throws; `bits` holds
+// the result's low 128 bits when `exact` itself does not fit (uint64 max * uint64 max)
+template <typename R>
+std::string expected(NumericInt128 exact, NumericOverflow overflow, const char* operation, NumericUInt128 bits)
+{
+    using limits = std::numeric_limits<R>;
+    if (exact >= NumericInt128(limits::min()) && exact <= NumericInt128(limits::max())) {
+        return toText(exact);
+    }
+    switch (overflow) {
+        case NumericOverflow::Wrap:
+            return toText(static_cast<R>(bits));
+        case NumericOverflow::Saturate:
+            return toText(exact < 0 ? NumericInt128(limits::min()) : NumericInt128(limits::max()));
+        default:
+            return std::string(operation) + ": Integer overflow.";
+    }
+}
+
+template <typename R>
+std::string expected(NumericInt128 exact, NumericOverflow overflow, const char* operation)
+{
+    return expected<R>(exact, overflow, operation, static_cast<NumericUInt128>(exact));
+}
+
+template <typename Call>
+std::string outcome(const Call& call)
+{
+    try {
+        return call()->toString();
+    } catch (const std::runtime_error& thrown) {
+        return thrown.what();
+    }
+}
+
+template <typename A, typename B>
+void checkPair()
+{
+    using R = ResultOf<A, B>;
+    for (const NumericInt128 x : samples<A>()) {
+        for (const NumericInt128 y : samples<B>()) {
+            const auto a = Numeric::create(static_cast<A>(x));
+            const auto b = Numeric::create(static_cast<B>(y));
+            const std::string what = std::string(numericKindName(a->kind())) + " " + toText(x) + " vs " + std::string(numericKindName(b->kind())) + " " + toText(y);
+
+            check(a->lessThanOperation(*b) == (x < y), what + ": <");
+            check(a->greaterThanOperation(*b) == (x > y), what + ": >");
+            check(a->equalOperation(*b) == (x == y), what + ": ==");
+
+            NumericInt128 product = 0;
+            if (__builtin_mul_overflow(x, y, &product)) {
+                product = static_cast<NumericInt128>(~NumericUInt128(0) >> 1);   // only two large uint64 values get here
+            }
+            const NumericUInt128 productBits = static_cast<NumericUInt128>(x) * static_cast<NumericUInt128>(y);
+
+            for (const NumericOverflow overflow : {NumericOverflow::Checked, NumericOverflow::Saturate, NumericOverflow::Wrap}) {
+                const NumericOverflowScope scope(overflow);
+                const std::string mode = " mode " + std::to_string(static_cast<int>(overflow));
+                check(outcome([&] { return a->sumOperation(*b); }) == expected<R>(x + y, overflow, "sumOperation"), what + ": +" + mode);
+                check(outcome([&] { return a->subtractOperation(*b); }) == expected<R>(x - y, overflow, "subtractOperation"), what + ": -" + mode);
+                check(outcome([&] { return a->multiplyOperation(*b); }) == expected<R>(product, overflow, "multiplyOperation", productBits), what + ": *" + mode);
+                const std::string quotient = y == 0 ? "divideOperation: Division by zero is not allowed." : expected<R>(x / y, overflow, "divideOperation");
+                check(outcome([&] { return a->divideOperation(*b); }) == quotient, what + ": /" + mode);
+            }
+        }
+    }
+}
+
+template <typename A, std::size_t... Index>
+void checkAgainstAll(std::index_sequence<Index...>)
+{
+    (checkPair<A, std::tuple_element_t<Index, Integers>>(), ...);
+}
+
+template <std::size_t... Index>
+void checkAll(std::index_sequence<Index...> indices)
+{
+    (checkAgainstAll<std::tuple_element_t<Index, Integers>>(indices), ...);
+}
+
+} // namespace
+
+int main()
+{
+    checkAll(std::make_index_sequence<std::tuple_size_v<Integers>>());
+
+    // The cases that used to go wrong
+    const auto uint64Max = Numeric::create(std::numeric_limits<std::uint64_t>::max());
+    const auto minusOne = Numeric::create(std::int64_t(-1));
+    check(uint64Max->greaterThanOperation(*minusOne) && minusOne->lessThanOperation(*uint64Max), "UInt64 max > Int64 -1");
+    check(!uint64Max->equalOperation(*minusOne), "UInt64 max != Int64 -1");
+    check(Numeric::create(std::int8_t(1))->lessThanOperation(*Numeric::create(std::int64_t(1000))), "int8 1 < int64 1000");
+    check(Numeric::create(-1)->sumOperation(*Numeric::create(std::uint32_t(5)))->toString() == "4", "-1 + uint32 5");
+    check(Numeric::create(std::int64_t(-1))->sumOperation(*uint64Max)->toString() == "18446744073709551614", "int64 -1 + UInt64 max");
+
+    return checkResult();
+}
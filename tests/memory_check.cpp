@@ -0,0 +1,137 @@
+#include "NumericMemory.hpp"
+#include "check.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * NumericArena and NumericPool ownership: scoped allocations come from the resource and
+ * go back to it after the scope ends, scopes nest, reset() throws under live objects,
+ * and destroying a resource under live objects aborts instead of leaving them dangling.
+ */
+namespace {
+
+template <typename Body>
+bool throwsRuntimeError(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+#ifndef _WIN32
+// True when `body`, run in a child process, ends with SIGABRT
+template <typename Body>
+bool aborts(const Body& body)
+{
+    const pid_t child = fork();
+    if (child == 0) {
+        body();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+}
+#endif
+
+} // namespace
+
+int main()
+{
+    // No scope: the global heap
+    check(currentNumericMemoryResource() == nullptr, "no resource outside a scope");
+    const auto heap = Numeric::create(1);
+
+    // Arena: objects outlive the scope, and reset() waits for all of them
+    NumericArena arena;
+    std::vector<std::unique_ptr<Numeric>> fromArena;
+    {
+        NumericAllocationScope scope(arena);
+        check(currentNumericMemoryResource() == &arena, "the scope routes to the arena");
+        auto total = Numeric::create(0);
+        for (int i = 1; i <= 100; ++i) {
+            total = total->sumOperation(*Numeric::create(i));
+        }
+        fromArena.push_back(std::move(total));
+        fromArena.push_back(Numeric::create(2.5));
+    }
+    check(currentNumericMemoryResource() == nullptr, "the scope ends");
+    check(arena.liveCount() == 2 && fromArena[0]->toString() == "5050", "arena objects stay alive after their scope");
+    check(arena.bytesUsed() > 0 && arena.chunkCount() == 1, "arena memory is used");
+    check(throwsRuntimeError([&] { arena.reset(); }), "reset() throws under live objects");
+    check(throwsRuntimeError([&] { arena.release(); }), "release() throws under live objects");
+    fromArena.clear();
+    check(arena.liveCount() == 0, "deleting after the scope returns the objects to the arena");
+    arena.reset();
+    check(arena.bytesUsed() == 0 && arena.chunkCount() == 1, "reset() rewinds and keeps the chunk");
+    arena.release();
+    check(arena.chunkCount() == 0, "release() frees the chunks");
+
+    // Pool: freed blocks are reused, scopes nest, large objects still count
+    NumericPool pool;
+    {
+        NumericAllocationScope outer(pool);
+        auto first = Numeric::create(7);
+        const void* address = first.get();
+        first.reset();
+        auto second = Numeric::create(8);
+        check(second.get() == address && pool.liveCount() == 1, "the pool recycles a freed block");
+        {
+            NumericArena inner;
+            {
+                NumericAllocationScope nested(inner);
+                check(currentNumericMemoryResource() == &inner, "nested scope");
+                auto temporary = Numeric::create(1.0);
+                check(inner.liveCount() == 1 && pool.liveCount() == 1, "the nested scope allocates from its own resource");
+            }
+            check(currentNumericMemoryResource() == &pool && inner.liveCount() == 0, "the nested scope restores the outer one");
+        }
+        auto big = Numeric::create(NumericBigInt::fromString(std::string(400, '9')));
+        check(pool.liveCount() == 2, "objects of every size are counted");
+    }
+    check(pool.liveCount() == 0, "every pool object was returned");
+    check(heap->toString() == "1", "the heap object is untouched");
+
+#ifndef _WIN32
+    // A resource destroyed under live objects aborts rather than leave their deletes dangling
+    check(aborts([] {
+              std::unique_ptr<Numeric> survivor;
+              {
+                  NumericArena doomed;
+                  NumericAllocationScope scope(doomed);
+                  survivor = Numeric::create(3);
+              }
+          }),
+          "destroying an arena under live objects aborts");
+    check(aborts([] {
+              std::unique_ptr<Numeric> survivor;
+              {
+                  NumericPool doomed;
+                  NumericAllocationScope scope(doomed);
+                  survivor = Numeric::create(3);
+              }
+          }),
+          "destroying a pool under live objects aborts");
+    check(!aborts([] {
+              NumericPool kept;
+              NumericAllocationScope scope(kept);
+              auto value = Numeric::create(3);
+              value.reset();
+          }),
+          "destroying an empty pool does not");
+#endif
+
+    return checkResult();
+}
@@ -0,0 +1,127 @@
+#include "NumericParse.hpp"
+#include "check.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * NumericTextParser type inference (int / int64 / uint64 / float / double, complex and
+ * quoted chars), and chunked input against whole input: a field cut at any byte of a
+ * chunk boundary must parse as if the input came in one piece.
+ */
+namespace {
+
+// Kind and text of each value, in input order
+std::string describe(const std::vector<NumericValue>& values)
+{
+    std::string text;
+    for (const NumericValue& value : values) {
+        text += std::to_string(static_cast<int>(value.kind())) + ":" + value.toString() + ";";
+    }
+    return text;
+}
+
+std::vector<NumericValue> parseWhole(const std::string& input, NumericParseOptions options = {})
+{
+    NumericTextParser parser(options);
+    std::vector<NumericValue> out;
+    parser.parse(input, out);
+    parser.finish(out);
+    return out;
+}
+
+// `input` in chunks of 1 to maxChunk bytes
+std::vector<NumericValue> parseChunked(const std::string& input, std::mt19937& random, std::size_t maxChunk, NumericParseOptions options = {})
+{
+    NumericTextParser parser(options);
+    std::vector<NumericValue> out;
+    for (std::size_t begin = 0; begin < input.size();) {
+        const std::size_t length = std::min<std::size_t>(1 + random() % maxChunk, input.size() - begin);
+        parser.parse(std::string_view(input).substr(begin, length), out);
+        begin += length;
+    }
+    parser.finish(out);
+    return out;
+}
+
+NumericKind kindOf(const std::string& field)
+{
+    const std::vector<NumericValue> values = parseWhole(field);
+    return values.size() == 1 ? values[0].kind() : NumericKind::Count;
+}
+
+} // namespace
+
+int main()
+{
+    // The narrowest type that holds each field
+    check(kindOf("42") == NumericKind::Int && kindOf("-7") == NumericKind::Int && kindOf("2147483647") == NumericKind::Int &&
+              kindOf("-2147483648") == NumericKind::Int,
+          "int");
+    check(kindOf("2147483648") == NumericKind::Int64 && kindOf("-9000000000") == NumericKind::Int64 &&
+              kindOf("9223372036854775807") == NumericKind::Int64,
+          "int64 outside the int range");
+    check(kindOf("9223372036854775808") == NumericKind::UInt64 && kindOf("18446744073709551615") == NumericKind::UInt64,
+          "uint64 above the int64 range");
+    check(kindOf("1.5") == NumericKind::Float && kindOf("1e10") == NumericKind::Float && kindOf("inf") == NumericKind::Float,
+          "float when float holds the value exactly");
+    check(kindOf("0.1") == NumericKind::Double && kindOf("1e300") == NumericKind::Double, "double otherwise");
+    check(kindOf("1+2i") == NumericKind::ComplexFloat && kindOf("-3.5i") == NumericKind::ComplexFloat &&
+              kindOf("(1.5 + -2i)") == NumericKind::ComplexFloat && kindOf("0.1+2i") == NumericKind::ComplexDouble,
+          "complex, float or double by the same rule per part");
+    check(kindOf("A") == NumericKind::Char && kindOf("\"\"\"\"") == NumericKind::Char && kindOf("\",\"") == NumericKind::Char,
+          "char, quoted when it is a quote or a delimiter");
+    check(kindOf("\xC3\xA9") == NumericKind::Char16 && kindOf("\xF0\x9F\x98\x80") == NumericKind::Char32, "one UTF-8 code point");
+
+    // Values land in the column of their type, in input order
+    NumericTextParser parser(NumericParseOptions{.narrowFloats = false});
+    NumericParsedColumns columns;
+    parser.parse(" 1, 2.5 ,\"\"\"\", 3\n-4, (1 + 2i), 18446744073709551615,\r\n,,0.1", columns);
+    parser.finish(columns);
+    check(columns.ints.size() == 3 && columns.ints[0] == 1 && columns.ints[1] == 3 && columns.ints[2] == -4, "int column");
+    check(columns.floats.size() == 0 && columns.doubles.size() == 2 && columns.doubles[0] == 2.5 && columns.doubles[1] == 0.1,
+          "narrowFloats off: every decimal is a double");
+    check(columns.chars.size() == 1 && columns.chars[0] == '"', "quoted quote");
+    check(columns.complexDoubles.size() == 1 && columns.complexDoubles[0] == std::complex<double>(1, 2), "complex column");
+    check(columns.uint64s.size() == 1 && columns.uint64s[0] == UINT64_MAX, "uint64 column");
+    check(parser.stats().fields == columns.size() && columns.size() == 8, "empty fields are skipped");
+
+    // Lines input: every line one field, quotes are plain characters
+    const std::vector<NumericValue> lines = parseWhole(",\n\"\n7\n", NumericParseOptions{.delimiter = '\n'});
+    check(describe(lines) == describe(parseWhole("\",\"\n\"\"\"\"\n7")), "Lines input keeps ',' and '\"' as chars");
+
+    // Invalid fields throw, or are counted with skipInvalid
+    bool threw = false;
+    try {
+        parseWhole("1,abc,2");
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    check(threw, "an invalid field throws");
+    NumericTextParser lenient(NumericParseOptions{.skipInvalid = true});
+    std::vector<NumericValue> kept;
+    lenient.parse("1,abc,2", kept);
+    lenient.finish(kept);
+    check(kept.size() == 2 && lenient.stats().invalid == 1, "skipInvalid counts the invalid field");
+
+    // A field cut at every byte of a chunk boundary parses as it does whole
+    const std::string input = "123456789, -2147483649 ,1.25e-3,(1.5 + -2i),\"\"\"\",\xC3\xA9,\xF0\x9F\x98\x80,18446744073709551615\r\n0.1,\",\",-3.5i";
+    const std::string whole = describe(parseWhole(input));
+    for (std::size_t cut = 0; cut <= input.size(); ++cut) {
+        NumericTextParser split;
+        std::vector<NumericValue> out;
+        split.parse(std::string_view(input).substr(0, cut), out);
+        split.parse(std::string_view(input).substr(cut), out);
+        split.finish(out);
+        check(describe(out) == whole, "input cut at byte " + std::to_string(cut));
+    }
+    std::mt19937 random(12);
+    for (int i = 0; i < 200; ++i) {
+        check(describe(parseChunked(input, random, 1 + i % 7)) == whole, "input in random chunks");
+    }
+
+    return checkResult();
+}
@@ -0,0 +1,146 @@
+#include "NumericReduce.hpp"
+#include "check.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+/**
+ * numericSum / Product / Min / Max / Mean: bit-identical results for any thread count at
+ * a fixed chunk size, Kahan summation against the plain sum on ill-conditioned input,
+ * empty inputs, and integer results under the three NumericOverflow policies.
+ */
+namespace {
+
+template <typename Body>
+bool throwsRuntimeError(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+template <typename Body>
+std::string thrownMessage(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+NumericReduceOptions withThreads(std::size_t threads, NumericSummation summation = NumericSummation::Plain)
+{
+    return NumericReduceOptions{threads, 4096, summation};
+}
+
+} // namespace
+
+int main()
+{
+    // One chunk size, any thread count, any run: the same bits
+    std::mt19937_64 random(14);
+    NumericColumn<double> doubles;
+    NumericColumn<float> floats;
+    std::vector<std::unique_ptr<Numeric>> boxed;
+    for (int i = 0; i < 300000; ++i) {
+        const double value = std::ldexp(static_cast<double>(random() >> 11), static_cast<int>(random() % 40) - 73) * (random() & 1 ? -1 : 1);
+        doubles.push_back(value);
+        floats.push_back(static_cast<float>(value));
+        if (i < 50000) {
+            boxed.push_back(Numeric::create(value));
+        }
+    }
+    for (const NumericSummation summation : {NumericSummation::Plain, NumericSummation::Kahan, NumericSummation::Pairwise}) {
+        const std::string name = "summation " + std::to_string(static_cast<int>(summation));
+        const std::uint64_t sum = std::bit_cast<std::uint64_t>(numericSum(doubles, withThreads(1, summation)));
+        const std::uint32_t floatSum = std::bit_cast<std::uint32_t>(numericSum(floats, withThreads(1, summation)));
+        const std::uint64_t mean = std::bit_cast<std::uint64_t>(numericMean(doubles, withThreads(1, summation)));
+        const std::string boxedSum = numericSum(boxed, withThreads(1, summation))->toString();
+        for (const std::size_t threads : {1, 2, 3, 8}) {
+            for (int run = 0; run < 3; ++run) {
+                check(std::bit_cast<std::uint64_t>(numericSum(doubles, withThreads(threads, summation))) == sum &&
+                          std::bit_cast<std::uint32_t>(numericSum(floats, withThreads(threads, summation))) == floatSum &&
+                          std::bit_cast<std::uint64_t>(numericMean(doubles, withThreads(threads, summation))) == mean,
+                      name + ": column sums and means with " + std::to_string(threads) + " threads");
+                check(numericSum(boxed, withThreads(threads, summation))->toString() == boxedSum,
+                      name + ": boxed sum with " + std::to_string(threads) + " threads");
+            }
+        }
+    }
+    const std::uint64_t product = std::bit_cast<std::uint64_t>(numericProduct(doubles, withThreads(1)));
+    check(std::bit_cast<std::uint64_t>(numericProduct(doubles, withThreads(8))) == product, "product with 8 threads");
+
+    // Kahan keeps what the plain sum loses: 1e8 + 1000 ones - 1e8 in float
+    NumericColumn<float> illConditioned;
+    illConditioned.push_back(1e8f);
+    for (int i = 0; i < 1000; ++i) {
+        illConditioned.push_back(1.0f);
+    }
+    illConditioned.push_back(-1e8f);
+    const float plain = numericSum(illConditioned, withThreads(1));
+    const float kahan = numericSum(illConditioned, withThreads(1, NumericSummation::Kahan));
+    check(kahan == 1000.0f && plain != 1000.0f, "Kahan sums 1e8 + 1000 ones - 1e8 exactly, the plain sum does not");
+    check(numericSum(illConditioned, withThreads(4, NumericSummation::Kahan)) == 1000.0f, "Kahan across chunks and threads");
+    long double exact = 0;
+    for (std::size_t i = 0; i < floats.size(); ++i) {
+        exact += floats[i];
+    }
+    check(std::fabs(numericSum(floats, withThreads(2, NumericSummation::Kahan)) - exact) <=
+              std::fabs(numericSum(floats, withThreads(2)) - exact),
+          "Kahan is at least as close as the plain sum on random floats");
+
+    // Empty input throws; an empty grouping has no groups
+    const NumericColumn<double> empty;
+    const std::vector<std::unique_ptr<Numeric>> none;
+    check(throwsRuntimeError([&] { numericSum(empty); }) && throwsRuntimeError([&] { numericMean(empty); }) &&
+              throwsRuntimeError([&] { numericMin(empty); }) && throwsRuntimeError([&] { numericProduct(empty); }),
+          "empty columns throw");
+    check(throwsRuntimeError([&] { numericSum(none); }) && throwsRuntimeError([&] { numericMax(none); }), "empty vectors throw");
+    check(numericGroupBy(NumericColumn<int>(), empty).empty(), "an empty group-by has no groups");
+
+    // Integer results under the overflow policy
+    NumericColumn<int> ints;
+    ints.push_back(std::numeric_limits<int>::max());
+    ints.push_back(1);
+    check(thrownMessage([&] { numericSum(ints); }) == "sumOperation: Integer overflow.", "checked sum overflow throws");
+    {
+        NumericOverflowScope wrap(NumericOverflow::Wrap);
+        check(numericSum(ints) == std::numeric_limits<int>::min(), "wrapped sum");
+    }
+    {
+        NumericOverflowScope saturate(NumericOverflow::Saturate);
+        check(numericSum(ints) == std::numeric_limits<int>::max(), "saturated sum");
+    }
+    ints.push_back(-1);
+    check(numericSum(ints) == std::numeric_limits<int>::max(), "an exact sum back in range does not overflow");
+
+    std::vector<std::unique_ptr<Numeric>> int64s;
+    int64s.push_back(Numeric::create(std::numeric_limits<std::int64_t>::max()));
+    int64s.push_back(Numeric::create(std::int64_t(2)));
+    check(thrownMessage([&] { numericProduct(int64s); }).find("Integer overflow") != std::string::npos, "checked product overflow throws");
+    {
+        NumericOverflowScope saturate(NumericOverflow::Saturate);
+        check(numericProduct(int64s)->toString() == Numeric::create(std::numeric_limits<std::int64_t>::max())->toString(),
+              "saturated product");
+    }
+
+    // Min, max and mean
+    check(numericMin(doubles, withThreads(3)) == *std::min_element(doubles.begin(), doubles.end()) &&
+              numericMax(doubles, withThreads(3)) == *std::max_element(doubles.begin(), doubles.end()),
+          "min and max of a column");
+    NumericColumn<int> small{1, 2, 3, 4};
+    check(numericMean(small) == 2.5, "the mean of an int column is a double");
+
+    return checkResult();
+}
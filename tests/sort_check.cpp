@@ -0,0 +1,55 @@
+#include "NumericReduce.hpp"
+#include "NumericSort.hpp"
+#include "check.hpp"
+
+// Values whose sort keys tie: BigInts that share their top 64 bits, Decimal18s that share their rounded 64 bits
+int main()
+{
+    const NumericBigInt big = NumericBigInt::fromString("1267650600228229401496703205376");   // 2^100
+    const NumericDecimal18 unit = NumericDecimal18::fromUnits(NumericInt128(1) << 70);
+    const NumericDecimal18 next = NumericDecimal18::fromUnits((NumericInt128(1) << 70) + 1);
+    check(numericSortKey(big + NumericBigInt(5)) == numericSortKey(big + NumericBigInt(1)), "BigInt keys tie");
+    check(numericSortKey(unit) == numericSortKey(next), "Decimal18 keys tie");
+
+    std::vector<std::unique_ptr<Numeric>> values;
+    values.push_back(Numeric::create(big + NumericBigInt(5)));
+    values.push_back(Numeric::create(next));
+    values.push_back(Numeric::create(big + NumericBigInt(1)));
+    values.push_back(Numeric::create(unit));
+    values.push_back(Numeric::create(big - NumericBigInt(1)));
+
+    check(numericMin(values)->toString() == Numeric::create(unit)->toString(), "numericMin");
+    check(numericMax(values)->toString() == Numeric::create(big + NumericBigInt(5))->toString(), "numericMax");
+    check(numericSortOrder(*values[0], *values[2]) > 0 && numericSortOrder(*values[2], *values[0]) < 0, "numericSortOrder");
+
+    numericSort(values);
+    const std::unique_ptr<Numeric> expected[] = {Numeric::create(unit), Numeric::create(next), Numeric::create(big - NumericBigInt(1)),
+                                                  Numeric::create(big + NumericBigInt(1)), Numeric::create(big + NumericBigInt(5))};
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        check(values[i]->toString() == expected[i]->toString(), "numericSort of values");
+    }
+
+    NumericColumn<NumericDecimal18> column;
+    for (int i = 5; i > 0; --i) {
+        column.push_back(NumericDecimal18::fromUnits((NumericInt128(1) << 70) + i));
+    }
+    numericSort(column);
+    for (std::size_t i = 1; i < column.size(); ++i) {
+        check(column[i - 1] < column[i], "numericSort of a Decimal18 column");
+    }
+
+    // A Decimal18 just below a BigInt beyond 64 bits: their keys may tie but never invert
+    const NumericBigInt above = NumericBigInt::fromString("147573952589676412943");
+    const NumericDecimal18 below = NumericDecimal18::fromString("147573952589676412942.9");
+    check(std::memcmp(numericSortKey(below).bytes.data(), numericSortKey(above).bytes.data(), NumericSortKey::kindByte) <= 0,
+          "Decimal18 key not above a larger BigInt's");
+    std::vector<std::unique_ptr<Numeric>> pair;
+    pair.push_back(Numeric::create(above));
+    pair.push_back(Numeric::create(below));
+    check(numericSortOrder(*pair[1], *pair[0]) < 0 && numericSortOrder(*pair[0], *pair[1]) > 0, "numericSortOrder of a Decimal18 and a BigInt");
+    check(numericMin(pair)->toString() == pair[1]->toString(), "numericMin of a Decimal18 and a BigInt");
+    numericSort(pair);
+    check(pair[0]->kind() == NumericKind::Decimal18 && pair[1]->kind() == NumericKind::BigInt, "numericSort of a Decimal18 and a BigInt");
+
+    return checkResult();
+}
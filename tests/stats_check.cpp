@@ -0,0 +1,151 @@
+#include "NumericColumn.hpp"
+#include "NumericStats.hpp"
+#include "check.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * NumericStats in the mode the library was built in. With NUMERIC_ENABLE_STATS every
+ * dispatch path is counted once per call (boxed, in place, widened, compared, batched,
+ * converted, each error), allocations and frees are counted, one call per sampling
+ * period is timed, operations of exited threads are kept and numericStatsReset()
+ * starts from zero. Without it every snapshot is zero. The latency buckets are checked
+ * in both modes.
+ */
+namespace {
+
+template <typename Body>
+bool throwsRuntimeError(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// Every counter, so a snapshot can be compared with zero
+std::uint64_t total(const NumericStatsSnapshot& snapshot)
+{
+    std::uint64_t sum = snapshot.allocations + snapshot.deallocations + snapshot.allocatedBytes;
+    for (const std::uint64_t count : snapshot.operations) {
+        sum += count;
+    }
+    for (const NumericLatencyHistogram& histogram : snapshot.latency) {
+        sum += histogram.count;
+    }
+    return sum;
+}
+
+// One call down each path
+void exercise()
+{
+    const IntNumeric three(3);
+    const IntNumeric zero(0);
+    const IntNumeric max(std::numeric_limits<int>::max());
+    const FloatNumeric<double> half(0.5);
+    Numeric::apply(NumericOp::Sum, three, three);
+    IntNumeric target(1);
+    Numeric::applyAssign(NumericOp::Sum, target, three);
+    Numeric::applyAssign(NumericOp::Sum, target, half);
+    Numeric::compare(NumericOp::LessThan, three, half);
+    throwsRuntimeError([&] { Numeric::apply(NumericOp::Divide, three, zero); });
+    throwsRuntimeError([&] { Numeric::apply(NumericOp::Sum, max, three); });
+    three.convertTo(NumericKind::Double);
+
+    const std::vector<const Numeric*> firsts = {&three, &three, &three, &three};
+    const std::vector<const Numeric*> seconds = {&three, &zero, &three, &three};
+    std::vector<std::unique_ptr<Numeric>> out(4);
+    NumericMask errors;
+    Numeric::applyBatch(NumericOp::Divide, firsts, seconds, out, errors);
+}
+
+} // namespace
+
+int main()
+{
+    // Bucket bounds: every latency lands in the first bucket whose bound reaches it
+    bool bucketsOk = true;
+    for (std::uint64_t ns : {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 100ull, 1000ull, 123456789ull, 1ull << 36, (1ull << 37) - 1}) {
+        const std::size_t bucket = numericLatencyBucket(ns);
+        bucketsOk &= bucket < numericLatencyBucketCount && numericLatencyBucketBound(bucket) >= ns &&
+                     (bucket == 0 || numericLatencyBucketBound(bucket - 1) < ns);
+    }
+    check(bucketsOk && numericLatencyBucket(std::numeric_limits<std::uint64_t>::max()) == numericLatencyBucketCount - 1,
+          "latency buckets");
+
+    if constexpr (!numericStatsEnabled) {
+        exercise();
+        check(total(numericStatsSnapshot()) == 0 && numericStatsSampling() == 0, "nothing is recorded without NUMERIC_STATS");
+        return checkResult();
+    }
+
+    numericStatsReset();
+    setNumericStatsSampling(0);
+    exercise();
+    NumericStatsSnapshot snapshot = numericStatsSnapshot();
+    constexpr NumericKind Int = NumericKind::Int;
+    constexpr NumericKind Double = NumericKind::Double;
+    check(snapshot.count(NumericOp::Sum, Int, Int, NumericPath::Boxed) == 1, "boxed");
+    check(snapshot.count(NumericOp::Sum, Int, Int, NumericPath::InPlace) == 1, "in place");
+    check(snapshot.count(NumericOp::Sum, Int, Double, NumericPath::Widened) == 1, "widened");
+    check(snapshot.count(NumericOp::LessThan, Int, Double, NumericPath::Compared) == 1, "compared");
+    check(snapshot.count(NumericOp::Divide, Int, Int, NumericPath::DivisionByZero) == 2, "division by zero, one call and one batch element");
+    check(snapshot.count(NumericOp::Sum, Int, Int, NumericPath::Overflow) == 1, "overflow");
+    check(snapshot.count(numericConvertStatsOp, Int, Double, NumericPath::Converted) == 1, "converted");
+    check(snapshot.count(NumericOp::Divide, Int, Int, NumericPath::Batched) == 3, "batched");
+    check(snapshot.count(NumericPath::Boxed) == 1 && snapshot.count(NumericPath::Batched) == 3, "totals by path");
+    check(snapshot.latencyOf(NumericOp::Sum).count == 0, "no call is timed with sampling off");
+
+    // Allocations: one per object built through Numeric::operator new, one free per delete
+    numericStatsReset();
+    {
+        auto value = Numeric::create(1);
+        auto other = Numeric::create(2.0);
+    }
+    snapshot = numericStatsSnapshot();
+    check(snapshot.allocations == 2 && snapshot.deallocations == 2 && snapshot.allocatedBytes >= 2 * sizeof(IntNumeric),
+          "allocations and frees");
+
+    // Sampling: with a period of 1 every call is timed. A period applies from a thread's next
+    // sample, and this one's countdown started with sampling off, so time the calls in a new thread
+    setNumericStatsSampling(1);
+    numericStatsReset();
+    std::thread([] {
+        const IntNumeric one(1);
+        for (int i = 0; i < 50; ++i) {
+            Numeric::apply(NumericOp::Sum, one, one);
+        }
+    }).join();
+    snapshot = numericStatsSnapshot();
+    const NumericLatencyHistogram& latency = snapshot.latencyOf(NumericOp::Sum);
+    check(latency.count == 50 && snapshot.count(NumericOp::Sum, Int, Int, NumericPath::Boxed) == 50, "every sampled call is timed once");
+    check(latency.percentile(0.5) <= latency.percentile(0.99) && latency.percentile(0.99) > 0 && latency.meanNanoseconds() > 0,
+          "percentiles of the timed calls");
+    setNumericStatsSampling(64);
+
+    // Another thread's counts survive its exit
+    numericStatsReset();
+    std::thread([] {
+        const IntNumeric two(2);
+        for (int i = 0; i < 10; ++i) {
+            Numeric::compare(NumericOp::Equal, two, two);
+        }
+    }).join();
+    snapshot = numericStatsSnapshot();
+    check(snapshot.count(NumericOp::Equal, Int, Int, NumericPath::Compared) == 10, "an exited thread is still counted");
+
+    const std::string text = numericStatsPrometheus(snapshot);
+    check(text.find("numeric_operations_total{op=\"equalOperation\",lhs=\"int\",rhs=\"int\",path=\"compared\"} 10\n") != std::string::npos,
+          "Prometheus series");
+
+    numericStatsReset();
+    check(total(numericStatsSnapshot()) == 0, "reset starts from zero");
+
+    return checkResult();
+}
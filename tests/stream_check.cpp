@@ -0,0 +1,142 @@
+#include "NumericStream.hpp"
+#include "check.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * numericThreaded and numericParallelMap: values come out in input order whatever order
+ * the workers finish in, an exception thrown by the source or by a worker reaches the
+ * consumer after the values before it, the threads run under the consumer's policies, and
+ * a pipeline destroyed part way stops its source and joins its threads.
+ */
+namespace {
+
+std::atomic<int> produced = 0;
+std::atomic<int> liveSources = 0;
+
+// Counts the source frames alive, so a destroyed pipeline can be seen to have dropped its source
+struct SourceGuard
+{
+    SourceGuard() { ++liveSources; }
+    ~SourceGuard() { --liveSources; }
+};
+
+// 0, 1, ... count - 1 (no end for count < 0), throwing before value `failAt` when it is reached
+NumericGenerator<int> counter(int count, int failAt = -1)
+{
+    const SourceGuard guard;
+    for (int value = 0; count < 0 || value < count; ++value) {
+        if (value == failAt) {
+            throw std::runtime_error("source failed");
+        }
+        ++produced;
+        co_yield value;
+    }
+}
+
+// The values the pipeline gives before it ends, and the message it ends with ("" when none)
+template <typename T>
+std::vector<T> drain(NumericGenerator<T> pipeline, std::string& error)
+{
+    std::vector<T> values;
+    error.clear();
+    try {
+        for (T& value : pipeline) {
+            values.push_back(std::move(value));
+        }
+    } catch (const std::runtime_error& thrown) {
+        error = thrown.what();
+    }
+    return values;
+}
+
+std::vector<int> firstOf(int count, int scale = 1)
+{
+    std::vector<int> values;
+    for (int value = 0; value < count; ++value) {
+        values.push_back(value * scale);
+    }
+    return values;
+}
+
+// Sleeps a few microseconds at random, so workers finish out of order
+void jitter()
+{
+    thread_local std::mt19937 random(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    std::this_thread::sleep_for(std::chrono::microseconds(random() % 50));
+}
+
+} // namespace
+
+int main()
+{
+    std::string error;
+
+    // Input order, with one queue slot and with more slots than values
+    for (const std::size_t capacity : {std::size_t(1), std::size_t(3), std::size_t(1000)}) {
+        check(drain(counter(500) | numericThreaded(capacity), error) == firstOf(500) && error.empty(), "numericThreaded keeps the order");
+        for (const std::size_t threads : {std::size_t(1), std::size_t(4), std::size_t(0)}) {
+            const auto twice = [](int value) {
+                jitter();
+                return 2 * value;
+            };
+            check(drain(counter(500) | numericThreaded(capacity) | numericParallelMap(twice, threads, capacity), error) == firstOf(500, 2) &&
+                      error.empty(),
+                  "numericParallelMap keeps the order (" + std::to_string(threads) + " threads, capacity " + std::to_string(capacity) + ")");
+        }
+    }
+    check(drain(counter(0) | numericThreaded() | numericParallelMap([](int value) { return value; }, 4), error).empty() && error.empty(),
+          "an empty input");
+
+    // A source that throws: every value before it, then its exception
+    check(drain(counter(-1, 100) | numericThreaded(2), error) == firstOf(100) && error == "source failed", "numericThreaded rethrows the source");
+    check(drain(counter(-1, 100) | numericParallelMap([](int value) { return value; }, 4, 3), error) == firstOf(100) && error == "source failed",
+          "numericParallelMap rethrows the source");
+
+    // A worker that throws: every result before it, then its exception
+    const auto failAt37 = [](int value) {
+        jitter();
+        if (value == 37) {
+            throw std::runtime_error("worker failed");
+        }
+        return value;
+    };
+    check(drain(counter(-1) | numericParallelMap(failAt37, 4, 8), error) == firstOf(37) && error == "worker failed",
+          "numericParallelMap rethrows a worker");
+    check(drain(counter(-1) | numericThreaded(2) | numericParallelMap(failAt37, 4, 8) | numericThreaded(2), error) == firstOf(37) &&
+              error == "worker failed",
+          "a worker's exception passes a later threaded stage");
+
+    // The threads run under the policies of the consumer
+    {
+        const NumericOverflowScope overflow(NumericOverflow::Wrap);
+        const NumericRoundingScope rounding(NumericRounding::Floor);
+        const auto policies = [](int) { return numericOverflowMode() == NumericOverflow::Wrap && numericRoundingMode() == NumericRounding::Floor; };
+        const std::vector<bool> seen = drain(counter(50) | numericThreaded() | numericParallelMap(policies, 4), error);
+        check(seen.size() == 50 && error.empty() && std::find(seen.begin(), seen.end(), false) == seen.end(), "policies reach the stage threads");
+    }
+
+    // Destroyed part way through: the source stops a few values ahead and every thread is joined
+    for (const int taken : {0, 1, 25}) {
+        produced = 0;
+        {
+            NumericGenerator<int> pipeline = counter(-1) | numericThreaded(2) | numericParallelMap(failAt37, 4, 3) | numericThreaded(2);
+            for (int count = 0; count < taken && pipeline.next(); ++count) {
+            }
+        }
+        check(liveSources == 0, "a destroyed pipeline drops its source (" + std::to_string(taken) + " values taken)");
+        const int reached = produced;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        check(produced == reached && produced <= taken + 32, "a destroyed pipeline stops its source (" + std::to_string(taken) + " values taken)");
+    }
+
+    return checkResult();
+}
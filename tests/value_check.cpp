@@ -0,0 +1,162 @@
+#include "NumericFormat.hpp"
+#include "NumericValue.hpp"
+#include "check.hpp"
+
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+/**
+ * NumericValue against the Numeric classes for every pair of kinds it holds: the same
+ * result kind and bits from the operators, the same error messages, the non-throwing
+ * apply() leaving its result alone on error, comparisons, fromNumeric / toNumeric round
+ * trips, and the kinds it does not hold rejected with "Unsupported conversion".
+ */
+namespace {
+
+// A Numeric of kind `kind` holding `n`, or the largest value of an integer kind when `extreme`
+std::unique_ptr<Numeric> make(NumericKind kind, int n, bool extreme = false)
+{
+    return numericVisitKind(kind, [&]<NumericKind K>() -> std::unique_ptr<Numeric> {
+        using T = NumericKindValue<K>;
+        if constexpr (isComplexKind(K)) {
+            return std::make_unique<NumericClass<K>>(T(n, 1));
+        } else if constexpr (isCharKind(K)) {
+            return std::make_unique<NumericClass<K>>(static_cast<T>(n == 0 ? 0 : 'A' + n));
+        } else if constexpr (IntegerValue<T>) {
+            return std::make_unique<NumericClass<K>>(extreme ? std::numeric_limits<T>::max() : static_cast<T>(n));
+        } else {
+            return std::make_unique<NumericClass<K>>(T(n));
+        }
+    }, "value_check");
+}
+
+// Kind and exact text, so two values are the same only when they are bit for bit
+std::string describe(const Numeric& value)
+{
+    std::string text(value.kind() == NumericKind::BigInt ? 1000 : numericFormatBufferSize, '\0');
+    text.resize(value.formatTo(text.data(), text.size()));
+    return std::string(numericKindName(value.kind())) + " " + text;
+}
+
+template <typename Body>
+std::string thrownMessage(const Body& body)
+{
+    try {
+        body();
+    } catch (const std::runtime_error& error) {
+        return error.what();
+    }
+    return "";
+}
+
+bool held(NumericKind kind)
+{
+    return thrownMessage([&] { NumericValue::fromNumeric(*make(kind, 1)); }).empty();
+}
+
+NumericValue operate(NumericOp op, const NumericValue& first, const NumericValue& second)
+{
+    switch (op) {
+        case NumericOp::Sum:      return first + second;
+        case NumericOp::Subtract: return first - second;
+        case NumericOp::Multiply: return first * second;
+        default:                  return first / second;
+    }
+}
+
+bool compared(NumericOp op, const NumericValue& first, const NumericValue& second)
+{
+    switch (op) {
+        case NumericOp::LessThan:    return first < second;
+        case NumericOp::GreaterThan: return first > second;
+        default:                     return first == second;
+    }
+}
+
+// One op on one pair, NumericValue against Numeric
+bool matchesNumeric(NumericOp op, const Numeric& first, const Numeric& second)
+{
+    const NumericValue a = NumericValue::fromNumeric(first);
+    const NumericValue b = NumericValue::fromNumeric(second);
+    if (static_cast<std::size_t>(op) >= numericArithmeticOpCount) {
+        bool expected = false;
+        const std::string expectedError = thrownMessage([&] { expected = Numeric::compare(op, first, second); });
+        bool actual = false;
+        const std::string error = thrownMessage([&] { actual = compared(op, a, b); });
+        return error == expectedError && actual == expected;
+    }
+
+    std::unique_ptr<Numeric> expected;
+    const std::string expectedError = thrownMessage([&] { expected = Numeric::apply(op, first, second); });
+    NumericValue actual;
+    const std::string error = thrownMessage([&] { actual = operate(op, a, b); });
+    if (!expectedError.empty() || !error.empty()) {
+        NumericValue untouched(42);
+        return error == expectedError && NumericValue::apply(op, a, b, untouched) != NumericError::None &&
+               untouched.kind() == NumericKind::Int && untouched.get<int>() == 42;
+    }
+    return actual.kind() == expected->kind() && describe(*actual.toNumeric()) == describe(*expected);
+}
+
+} // namespace
+
+int main()
+{
+    // Every pair of held kinds and every op, with ordinary values, zero divisors and overflow
+    int pairs = 0;
+    for (std::size_t first = 0; first < numericKindCount; ++first) {
+        const auto firstKind = static_cast<NumericKind>(first);
+        if (!held(firstKind)) {
+            check(thrownMessage([&] { NumericValue::fromNumeric(*make(firstKind, 1)); }) == "Unsupported conversion",
+                  std::string(numericKindName(firstKind)) + " is not held");
+            continue;
+        }
+        for (std::size_t second = 0; second < numericKindCount; ++second) {
+            const auto secondKind = static_cast<NumericKind>(second);
+            if (!held(secondKind)) {
+                continue;
+            }
+            ++pairs;
+            for (std::size_t op = 0; op < numericOpCount; ++op) {
+                for (const int n : {2, 0}) {
+                    for (const bool extreme : {false, true}) {
+                        check(matchesNumeric(static_cast<NumericOp>(op), *make(firstKind, 7, extreme), *make(secondKind, n)),
+                              std::string(numericKindName(firstKind)) + " " + numericOpName(static_cast<NumericOp>(op)) + " " +
+                                  numericKindName(secondKind) + " " + std::to_string(n) + (extreme ? " from the maximum" : ""));
+                    }
+                }
+            }
+        }
+    }
+    check(pairs == 16 * 16, "all 16 held kinds were paired");
+
+    // Round trips and the two ways of building one
+    for (std::size_t k = 0; k < numericKindCount; ++k) {
+        const auto kind = static_cast<NumericKind>(k);
+        if (held(kind)) {
+            const auto original = make(kind, 5);
+            check(describe(*NumericValue::fromNumeric(*original).toNumeric()) == describe(*original),
+                  std::string(numericKindName(kind)) + " round trip");
+        }
+    }
+    check(NumericValue('A').kind() == NumericKind::Char && NumericValue::create('A').kind() == NumericKind::Int &&
+              NumericValue::create(true).kind() == NumericKind::Int && NumericValue::create(std::int8_t(3)).kind() == NumericKind::Int8,
+          "the constructor keeps the type, create() dispatches like Numeric::create");
+    check(NumericValue().kind() == NumericKind::Int && NumericValue().get<int>() == 0, "the default is int 0");
+
+    // Overflow follows the thread's policy, like the classes
+    const NumericValue max(std::numeric_limits<int>::max());
+    {
+        NumericOverflowScope wrap(NumericOverflow::Wrap);
+        check((max + NumericValue(1)).get<int>() == std::numeric_limits<int>::min(), "wrapped overflow");
+    }
+    {
+        NumericOverflowScope saturate(NumericOverflow::Saturate);
+        check((max + NumericValue(1)).get<int>() == std::numeric_limits<int>::max(), "saturated overflow");
+    }
+    check(thrownMessage([&] { max + NumericValue(1); }) == "sumOperation: Integer overflow.", "checked overflow");
+
+    return checkResult();
+}